@@ -42,6 +42,7 @@ class Backup:
     pagecount: int
     remaining: int
     def step(self, npages: int = -1) -> bool: ...
+    def wait(self, timeout: Optional[float] = None) -> bool: ...
 
 class Blob:
     def __init__(self, ) -> None: ...
@@ -58,13 +59,22 @@ class Blob:
 
 class Connection:
     def __init__(self, filename: str, flags: int = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, vfs: Optional[str] = None, statementcachesize: int = 100): ...
+    def apply_changeset(self, changeset: Union[bytes, Callable[[int], bytes]], conflict: Optional[Callable[[int, Optional[str], int, Optional[tuple], Optional[tuple], Any], int]] = None, filter: Optional[Callable[[str], bool]] = None, flags: int = 0) -> None: ...
     def autovacuum_pages(self, callable: Optional[Callable[[str, int, int, int], int]]) -> None: ...
     def backup(self, databasename: str, sourceconnection: Connection, sourcedatabasename: str)  -> Backup: ...
+    def backup_async(self, databasename: str, sourceconnection: Connection, sourcedatabasename: str, pages_per_step: int = 256, max_bytes_per_sec: int = 0, progress: Optional[Callable[[int, int], None]] = None)  -> Backup: ...
     def blobopen(self, database: str, table: str, column: str, rowid: int, writeable: bool)  -> Blob: ...
+    def cache_stats(self, include_entries: bool = False) -> Dict[str, Any]: ...
     def changes(self) -> int: ...
     def close(self, force: bool = False) -> None: ...
     def collationneeded(self, callable: Optional[Callable[[Connection, str], None]]) -> None: ...
     def config(self, op: int, *args) -> int: ...
+    def create_batch_function(self, name: str, callable: Callable, numargs: int = -1, batch_size: int = 4096) -> None: ...
+    def create_data_table(self, name: str, data: Any, columns: Optional[Sequence[str]] = None) -> None: ...
+    def create_key_collation(self, name: str, key: Callable[[str], bytes], cache_size: int = 4096) -> None: ...
+    def create_native_collation(self, name: str, collation: str) -> None: ...
+    def create_table_function(self, name: str, generator: Callable, columns: Sequence[str], hidden_args: Sequence[str]) -> None: ...
+    def create_window_function(self, name: str, factory: Optional[Callable], numargs: int = -1) -> None: ...
     def createaggregatefunction(self, name: str, factory: Optional[Callable], numargs: int = -1) -> None: ...
     def createcollation(self, name: str, callback: Optional[Callable[[str, str], int]]) -> None: ...
     def createmodule(self, name: str, datasource: Any) -> None: ...
@@ -80,6 +90,7 @@ class Connection:
     def getautocommit(self) -> bool: ...
     def getexectrace(self) -> Optional[Callable]: ...
     def getrowtrace(self) -> Optional[Callable]: ...
+    def import_csv(self, source: Any, table: str, delimiter: str = ",", quote: Optional[str] = '"', header: bool = False, infer: bool = False, commit_rows: int = 0, progress: Optional[Callable[[int, int], None]] = None) -> int: ...
     def interrupt(self) -> None: ...
     def last_insert_rowid(self) -> int: ...
     def limit(self, id: int, newval: int = -1) -> int: ...
@@ -89,6 +100,8 @@ class Connection:
     def overloadfunction(self, name: str, nargs: int) -> None: ...
     def readonly(self, name: str) -> bool: ...
     def serialize(self, name: str) -> bytes: ...
+    def session(self, schema: str = "main") -> Session: ...
+    def set_changes_hook(self, callable: Optional[Callable[[Optional[bool], Any], None]], by_table: bool = False) -> None: ...
     def set_last_insert_rowid(self, rowid: int) -> None: ...
     def setauthorizer(self, callable: Optional[Callable]) -> None: ...
     def setbusyhandler(self, callable: Optional[Callable]) -> None: ...
@@ -114,7 +127,10 @@ class Cursor:
     description: tuple
     def execute(self, statements: str, bindings: Optional[Union[Sequence,Dict]] = None) -> Cursor: ...
     def executemany(self, statements: str, sequenceofbindings: Sequence[Union[Sequence,Dict]]) -> Cursor: ...
+    def executemany_columns(self, statements: str, columns: Sequence) -> Cursor: ...
     def fetchall(self) -> list: ...
+    def fetchmany(self, size: int = 1000) -> list: ...
+    def fetchmany_columns(self, size: int = 1000) -> Optional[Tuple[int, List[Tuple[Optional[type], Union[array, bytes, None], Optional[array], bytes]]]]: ...
     def fetchone(self) -> Optional[Any]: ...
     def getconnection(self) -> Connection: ...
     def getdescription(self) -> Tuple[Tuple[str, str], ...]: ...
@@ -124,6 +140,22 @@ class Cursor:
     def __next__(self: Cursor) -> Any: ...
     def setexectrace(self, callable: Optional[Callable]) -> None: ...
     def setrowtrace(self, callable: Optional[Callable]) -> None: ...
+    static_bindings: bool
+    def write_to(self, file: Any, format: str = "csv", header: bool = False, nullvalue: str = "", table: str = "table") -> int: ...
+
+class Session:
+    def __init__(self, ) -> None: ...
+    def attach(self, table: Optional[str] = None) -> None: ...
+    def changeset(self) -> bytes: ...
+    def changeset_stream(self, output: Callable[[bytes], None]) -> None: ...
+    def close(self, force: bool = False) -> None: ...
+    enabled: bool
+    def __enter__(self) -> Session: ...
+    def __exit__(self) -> Literal[False]: ...
+    indirect: bool
+    is_empty: bool
+    def patchset(self) -> bytes: ...
+    def patchset_stream(self, output: Callable[[bytes], None]) -> None: ...
 
 class URIFilename:
     def __init__(self, ) -> None: ...
@@ -132,22 +164,42 @@ class URIFilename:
     def uri_int(self, name: str, default: int) -> int: ...
     def uri_parameter(self, name: str) -> Optional[str]: ...
 
+class VFSArchive:
+    def __init__(self, name: str, archive: str, base: str = "", makedefault: bool = False, prefetch: Optional[Iterable[Tuple[str, int, int]]] = None, prefetch_threads: int = 4): ...
+    def hints(self) -> List[Tuple[str, int, int]]: ...
+    def prefetch_wait(self) -> None: ...
+    def unregister(self) -> None: ...
+
+class VFSCompressed:
+    def __init__(self, name: str, base: str = "", makedefault: bool = False, compress: Optional[Callable[[bytes], bytes]] = None, decompress: Optional[Callable[[bytes], bytes]] = None, chunk_size: int = 0, cache_chunks: int = 32): ...
+    def unregister(self) -> None: ...
+
 class VFSFile:
     def __init__(self, vfs: str, filename: Union[str,URIFilename], flags: List[int]): ...
     def excepthook(self, etype, evalue, etraceback): ...
     def xCheckReservedLock(self) -> bool: ...
     def xClose(self) -> None: ...
     def xDeviceCharacteristics(self) -> int: ...
+    def xFetch(self, offset: int, amount: int) -> Any: ...
     def xFileControl(self, op: int, ptr: int) -> bool: ...
     def xFileSize(self) -> int: ...
     def xLock(self, level: int) -> None: ...
     def xRead(self, amount: int, offset: int) -> bytes: ...
+    def xReadInto(self, buffer: Union[bytearray, array[Any], memoryview], offset: int) -> int: ...
     def xSectorSize(self) -> int: ...
     def xSync(self, flags: int) -> None: ...
     def xTruncate(self, newsize: int) -> None: ...
+    def xUnfetch(self, offset: int, buffer: Any) -> None: ...
     def xUnlock(self, level: int) -> None: ...
     def xWrite(self, data: bytes, offset: int) -> None: ...
 
+class VFSShim:
+    def __init__(self, name: str, base: str = "", makedefault: bool = False, readahead: int = 0, cache_pages: int = 0, coalesce: int = 0, write_behind: int = 0, sync_delay: float = 0.0): ...
+    def flush(self) -> None: ...
+    def reset_stats(self) -> None: ...
+    def stats(self) -> Dict[str, Union[int, float]]: ...
+    def unregister(self) -> None: ...
+
 class VFS:
     def __init__(self, name: str, base: Optional[str] = None, makedefault: bool = False, maxpathname: int = 1024): ...
     def excepthook(self, *args) -> Any: ...
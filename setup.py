@@ -478,7 +478,7 @@ class apsw_build_ext(beparent):
         if self.enable_all_extensions:
             exts = [
                 "fts4", "fts3", "fts3_parenthesis", "rtree", "stat4", "json1", "fts5", "rbu", "geopoly",
-                "math_functions"
+                "math_functions", "session"
             ]
             if find_in_path("icu-config"):
                 exts.append("icu")
@@ -548,6 +548,9 @@ class apsw_build_ext(beparent):
                     load_extension = True
                     continue
                 ext.define_macros.append(("SQLITE_ENABLE_" + e.upper(), 1))
+                # the session extension is built on the preupdate hook
+                if e.lower() == "session":
+                    ext.define_macros.append(("SQLITE_ENABLE_PREUPDATE_HOOK", 1))
                 if e.upper() == "ICU":
                     addicuinclib = True
                 else:
@@ -562,7 +565,7 @@ class apsw_build_ext(beparent):
                        "memsys" not in e.lower() and \
                        e.lower() not in ("fts4", "fts3", "rtree", "icu", "iotrace",
                                          "stat2", "stat3", "stat4", "dbstat_vtab",
-                                         "fts5", "json1", "rbu", "geopoly"):
+                                         "fts5", "json1", "rbu", "geopoly", "session"):
                     write("Unknown enable " + e, sys.stderr)
                     raise ValueError("Bad enable " + e)
 
@@ -71,6 +71,7 @@ API Reference
 /* system headers */
 #include <assert.h>
 #include <stdarg.h>
+#include <float.h>
 
 /* Get the version number */
 #include "apswversion.h"
@@ -83,6 +84,13 @@ API Reference
 #include <pythread.h>
 #include "structmember.h"
 
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#include <pthread.h>
+#endif
+
 #ifdef APSW_TESTFIXTURES
 /* Fault injection */
 #define APSW_FAULT_INJECT(faultName, good, bad) \
@@ -141,12 +149,26 @@ static PyObject *apswmodule;
 /* The statement cache */
 #include "statementcache.c"
 
+/* bulk csv import */
+#include "csvimport.c"
+
+/* native virtual table over in memory data */
+#include "datatable.c"
+
+/* collations implemented in C */
+#include "collations.c"
+
 /* connections */
 #include "connection.c"
 
 /* backup */
 #include "backup.c"
 
+/* sessions and changesets */
+#ifdef SQLITE_ENABLE_SESSION
+#include "session.c"
+#endif
+
 /* Zeroblob and blob */
 #include "blob.c"
 
@@ -1353,8 +1375,12 @@ PyInit_apsw(void)
     goto fail;
   }
 
-  if (PyType_Ready(&ConnectionType) < 0 || PyType_Ready(&APSWCursorType) < 0 || PyType_Ready(&ZeroBlobBindType) < 0 || PyType_Ready(&APSWBlobType) < 0 || PyType_Ready(&APSWVFSType) < 0 || PyType_Ready(&APSWVFSFileType) < 0 || PyType_Ready(&APSWURIFilenameType) < 0 || PyType_Ready(&FunctionCBInfoType) < 0 || PyType_Ready(&APSWBackupType) < 0)
+  if (PyType_Ready(&ConnectionType) < 0 || PyType_Ready(&APSWCursorType) < 0 || PyType_Ready(&ZeroBlobBindType) < 0 || PyType_Ready(&APSWBlobType) < 0 || PyType_Ready(&APSWVFSType) < 0 || PyType_Ready(&APSWVFSFileType) < 0 || PyType_Ready(&APSWURIFilenameType) < 0 || PyType_Ready(&APSWVFSShimType) < 0 || PyType_Ready(&APSWVFSCompressedType) < 0 || PyType_Ready(&APSWVFSArchiveType) < 0 || PyType_Ready(&FunctionCBInfoType) < 0 || PyType_Ready(&APSWBackupType) < 0)
     goto fail;
+#ifdef SQLITE_ENABLE_SESSION
+  if (PyType_Ready(&APSWSessionType) < 0)
+    goto fail;
+#endif
 
   m = apswmodule = PyModule_Create(&apswmoduledef);
 
@@ -1378,6 +1404,11 @@ PyInit_apsw(void)
   Py_INCREF(&APSWBackupType);
   PyModule_AddObject(m, "Backup", (PyObject *)&APSWBackupType);
 
+#ifdef SQLITE_ENABLE_SESSION
+  Py_INCREF(&APSWSessionType);
+  PyModule_AddObject(m, "Session", (PyObject *)&APSWSessionType);
+#endif
+
   Py_INCREF(&ZeroBlobBindType);
   PyModule_AddObject(m, "zeroblob", (PyObject *)&ZeroBlobBindType);
 
@@ -1385,6 +1416,12 @@ PyInit_apsw(void)
   PyModule_AddObject(m, "VFS", (PyObject *)&APSWVFSType);
   Py_INCREF(&APSWVFSFileType);
   PyModule_AddObject(m, "VFSFile", (PyObject *)&APSWVFSFileType);
+  Py_INCREF(&APSWVFSShimType);
+  PyModule_AddObject(m, "VFSShim", (PyObject *)&APSWVFSShimType);
+  Py_INCREF(&APSWVFSCompressedType);
+  PyModule_AddObject(m, "VFSCompressed", (PyObject *)&APSWVFSCompressedType);
+  Py_INCREF(&APSWVFSArchiveType);
+  PyModule_AddObject(m, "VFSArchive", (PyObject *)&APSWVFSArchiveType);
   Py_INCREF(&APSWURIFilenameType);
   PyModule_AddObject(m, "URIFilename", (PyObject *)&APSWURIFilenameType);
 
@@ -1916,7 +1953,29 @@ modules etc. For example::
         ADDINT(SQLITE_TXN_NONE),
         ADDINT(SQLITE_TXN_READ),
         ADDINT(SQLITE_TXN_WRITE),
-        END};
+        END,
+
+#ifdef SQLITE_ENABLE_SESSION
+        DICT("mapping_session_conflict"),
+        ADDINT(SQLITE_CHANGESET_DATA),
+        ADDINT(SQLITE_CHANGESET_NOTFOUND),
+        ADDINT(SQLITE_CHANGESET_CONFLICT),
+        ADDINT(SQLITE_CHANGESET_CONSTRAINT),
+        ADDINT(SQLITE_CHANGESET_FOREIGN_KEY),
+        END,
+
+        DICT("mapping_session_conflict_response"),
+        ADDINT(SQLITE_CHANGESET_OMIT),
+        ADDINT(SQLITE_CHANGESET_REPLACE),
+        ADDINT(SQLITE_CHANGESET_ABORT),
+        END,
+
+        DICT("mapping_session_changeset_apply_flags"),
+        ADDINT(SQLITE_CHANGESETAPPLY_NOSAVEPOINT),
+        ADDINT(SQLITE_CHANGESETAPPLY_INVERT),
+        END,
+#endif
+    };
 
     for (i = 0; i < sizeof(integers) / sizeof(integers[0]); i++)
     {
@@ -14,6 +14,19 @@ argcheck_Optional_Callable(PyObject *object, void *result)
     return 1;
 }
 
+static int
+argcheck_Callable(PyObject *object, void *result)
+{
+    PyObject **res = (PyObject **)result;
+    if (!PyCallable_Check(object))
+    {
+        PyErr_Format(PyExc_TypeError, "Function argument expected a Callable");
+        return 0;
+    }
+    *res = object;
+    return 1;
+}
+
 /* Standard PyArg_Parse considers anything truthy to be True such as
    non-empty strings, tuples etc.  This is a footgun for args eg:
 
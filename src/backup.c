@@ -49,6 +49,26 @@ round trip via SQL.  All pages are copied including free ones.
 
 The destination database is locked during the copy.  You will get a
 :exc:`ThreadingViolationError` if you attempt to use it.
+
+Background copying
+==================
+
+:meth:`Connection.backup_async` does the stepping in a background
+thread without holding the GIL.  Pages are copied in small steps so
+the source is only briefly locked each time, the rate can be limited,
+and the copying waits and retries when writers have the source
+busy::
+
+  b = db.backup_async("main", source, "main", max_bytes_per_sec=50_000_000,
+                      progress=lambda remaining, pagecount: print(remaining, pagecount))
+  # do other work ...
+  b.wait()
+  b.finish()
+
+SQLite restarts a backup from the beginning if the source is changed
+by a different connection, so if writers are continuously busy a
+backup may never complete.  Changes made through the source
+:class:`Connection` itself are copied without restarting.
 */
 
 /* we love us some macros */
@@ -76,6 +96,15 @@ struct APSWBackup
   PyObject *done;
   int inuse;
   PyObject *weakreflist;
+
+  /* background copying */
+  PyThread_type_lock worker; /* held while the worker thread is running */
+  volatile int stop;         /* worker should stop at the next step */
+  int pages_per_step;
+  sqlite3_int64 max_bytes_per_sec;
+  int page_size;
+  PyObject *progress;
+  PyObject *worker_type, *worker_value, *worker_tb; /* exception from worker */
 };
 
 typedef struct APSWBackup APSWBackup;
@@ -94,6 +123,28 @@ APSWBackup_init(APSWBackup *self, Connection *dest, Connection *source, sqlite3_
   Py_INCREF(self->done);
   self->inuse = 0;
   self->weakreflist = NULL;
+  self->worker = NULL;
+  self->stop = 0;
+  self->progress = NULL;
+  self->worker_type = self->worker_value = self->worker_tb = NULL;
+}
+
+/* waits up to timeout microseconds (-1 is forever) for the worker to
+   finish.  Returns true if it has */
+static int
+APSWBackup_wait_worker(APSWBackup *self, PY_TIMEOUT_T timeout)
+{
+  PyLockStatus status;
+
+  if (!self->worker)
+    return 1;
+  Py_BEGIN_ALLOW_THREADS
+      status = PyThread_acquire_lock_timed(self->worker, timeout, 0);
+  Py_END_ALLOW_THREADS;
+  if (status != PY_LOCK_ACQUIRED)
+    return 0;
+  PyThread_release_lock(self->worker);
+  return 1;
 }
 
 /* returns non-zero if it set an exception */
@@ -107,6 +158,38 @@ APSWBackup_close_internal(APSWBackup *self, int force)
   if (!self->backup)
     return 0;
 
+  if (self->worker)
+  {
+    self->stop = 1;
+    APSWBackup_wait_worker(self, -1);
+    PyThread_free_lock(self->worker);
+    self->worker = NULL;
+    Py_CLEAR(self->progress);
+    if (self->worker_type)
+    {
+      if (force == 2)
+      {
+        PyObject *etype, *eval, *etb;
+        PyErr_Fetch(&etype, &eval, &etb);
+        PyErr_Restore(self->worker_type, self->worker_value, self->worker_tb);
+        apsw_write_unraiseable(NULL);
+        PyErr_Restore(etype, eval, etb);
+      }
+      else if (force == 0)
+      {
+        PyErr_Restore(self->worker_type, self->worker_value, self->worker_tb);
+        setexc = 1;
+      }
+      else
+      {
+        Py_DECREF(self->worker_type);
+        Py_XDECREF(self->worker_value);
+        Py_XDECREF(self->worker_tb);
+      }
+      self->worker_type = self->worker_value = self->worker_tb = NULL;
+    }
+  }
+
   PYSQLITE_BACKUP_CALL(res = sqlite3_backup_finish(self->backup));
   if (res)
   {
@@ -186,6 +269,9 @@ APSWBackup_step(APSWBackup *self, PyObject *args, PyObject *kwds)
   CHECK_USE(NULL);
   CHECK_BACKUP_CLOSED(NULL);
 
+  if (self->worker)
+    return PyErr_Format(ExcThreadingViolation, "The backup is being done in the background");
+
   {
     static char *kwlist[] = {"npages", NULL};
     Backup_step_CHECK;
@@ -217,6 +303,215 @@ APSWBackup_step(APSWBackup *self, PyObject *args, PyObject *kwds)
   return self->done;
 }
 
+/* Runs in the background thread started by APSWBackup_start without
+   the GIL, which is only acquired to call the progress callback and
+   when finished. */
+static void
+APSWBackup_worker(void *arg)
+{
+  APSWBackup *self = (APSWBackup *)arg;
+  sqlite3 *db = self->dest->db;
+  PyGILState_STATE gilstate;
+  int res = SQLITE_OK, busywait = 0, remaining, pagecount, lastcopied = 0;
+  double owedms = 0;
+
+  while (!self->stop)
+  {
+    sqlite3_mutex_enter(sqlite3_db_mutex(db));
+    res = sqlite3_backup_step(self->backup, self->pages_per_step);
+    if (res != SQLITE_OK && res != SQLITE_DONE && res != SQLITE_BUSY && res != SQLITE_LOCKED)
+      apsw_set_errmsg(sqlite3_errmsg(db));
+    remaining = sqlite3_backup_remaining(self->backup);
+    pagecount = sqlite3_backup_pagecount(self->backup);
+    sqlite3_mutex_leave(sqlite3_db_mutex(db));
+
+    /* writers have the source locked so give them time */
+    if (res == SQLITE_BUSY || res == SQLITE_LOCKED)
+    {
+      busywait = busywait ? (busywait < 50 ? busywait * 2 : 100) : 1;
+      sqlite3_sleep(busywait);
+      res = SQLITE_OK;
+      continue;
+    }
+    busywait = 0;
+    if (res != SQLITE_OK && res != SQLITE_DONE)
+      break;
+
+    if (self->progress)
+    {
+      PyObject *retval;
+      gilstate = PyGILState_Ensure();
+      retval = PyObject_CallFunction(self->progress, "ii", remaining, pagecount);
+      if (!retval)
+      {
+        AddTraceBackHere(__FILE__, __LINE__, "backup.progress", "{s: i, s: i}", "remaining", remaining, "pagecount", pagecount);
+        PyErr_Fetch(&self->worker_type, &self->worker_value, &self->worker_tb);
+      }
+      Py_XDECREF(retval);
+      PyGILState_Release(gilstate);
+      if (!retval)
+        break;
+    }
+    if (res == SQLITE_DONE)
+      break;
+
+    /* sleep long enough that the rate copied so far is under the limit.
+       A restarted backup starts the count again.  The sleep is in short
+       slices so stopping doesn't have to wait for all of it */
+    if (self->max_bytes_per_sec > 0)
+    {
+      int copied = pagecount - remaining;
+      owedms += 1000.0 * (copied - ((copied >= lastcopied) ? lastcopied : 0)) * self->page_size / self->max_bytes_per_sec;
+      lastcopied = copied;
+      while (owedms >= 1 && !self->stop)
+      {
+        int slice = owedms < 20 ? (int)owedms : 20;
+        sqlite3_sleep(slice);
+        owedms -= slice;
+      }
+    }
+  }
+
+  gilstate = PyGILState_Ensure();
+  if (res == SQLITE_DONE && self->done != Py_True)
+  {
+    Py_CLEAR(self->done);
+    self->done = Py_True;
+    Py_INCREF(self->done);
+  }
+  if (res != SQLITE_OK && res != SQLITE_DONE && !self->worker_type)
+  {
+    make_exception(res, db);
+    PyErr_Fetch(&self->worker_type, &self->worker_value, &self->worker_tb);
+  }
+  PyThread_release_lock(self->worker);
+  /* could be the last reference */
+  Py_DECREF(self);
+  PyGILState_Release(gilstate);
+}
+
+/* Gets the page size of the schema which determines how many bytes a
+   step copies.  Called with the database mutex held */
+static int
+backup_page_size(sqlite3 *db, const char *schema, int *page_size)
+{
+  sqlite3_stmt *stmt = NULL;
+  char *sql;
+  int res;
+
+  sql = sqlite3_mprintf("pragma \"%w\".page_size", schema);
+  if (!sql)
+    return SQLITE_NOMEM;
+  res = sqlite3_prepare_v2(db, sql, -1, &stmt, NULL);
+  sqlite3_free(sql);
+  if (res == SQLITE_OK)
+    res = sqlite3_step(stmt);
+  if (res == SQLITE_ROW)
+  {
+    *page_size = sqlite3_column_int(stmt, 0);
+    res = SQLITE_OK;
+  }
+  sqlite3_finalize(stmt);
+  return res;
+}
+
+/* Starts copying in the background.  Returns -1 with exception set on
+   failure. */
+static int
+APSWBackup_start(APSWBackup *self, const char *sourcedatabasename, int pages_per_step, sqlite3_int64 max_bytes_per_sec, PyObject *progress)
+{
+  int res;
+
+  INUSE_CALL(_PYSQLITE_CALL_E(self->source->db, res = backup_page_size(self->source->db, sourcedatabasename, &self->page_size)));
+  SET_EXC(res, self->source->db);
+  if (res != SQLITE_OK)
+    return -1;
+
+  self->worker = PyThread_allocate_lock();
+  if (!self->worker)
+  {
+    PyErr_NoMemory();
+    return -1;
+  }
+  PyThread_acquire_lock(self->worker, WAIT_LOCK);
+  self->pages_per_step = pages_per_step;
+  self->max_bytes_per_sec = max_bytes_per_sec;
+  if (progress)
+  {
+    Py_INCREF(progress);
+    self->progress = progress;
+  }
+
+  /* the worker has a reference so the backup keeps going even if
+     nothing else does */
+  Py_INCREF(self);
+  if (PyThread_start_new_thread(APSWBackup_worker, self) == PYTHREAD_INVALID_THREAD_ID)
+  {
+    Py_DECREF(self);
+    PyThread_release_lock(self->worker);
+    PyThread_free_lock(self->worker);
+    self->worker = NULL;
+    Py_CLEAR(self->progress);
+    PyErr_Format(PyExc_RuntimeError, "Unable to start the backup thread");
+    return -1;
+  }
+  return 0;
+}
+
+/** .. method:: wait(timeout: Optional[float] = None) -> bool
+
+  Waits for copying started by :meth:`Connection.backup_async` to
+  finish, which is when all the pages are copied or there is an error.
+  Any exception from the copying, including from the progress
+  callback, is raised.
+
+  :param timeout: How many seconds to wait, or None to wait forever.
+  :returns: True if the copying has finished, False if the timeout
+     expired.  It is always True for backups not done in the
+     background.
+
+  You still need to call :meth:`~backup.finish` afterwards.
+*/
+static PyObject *
+APSWBackup_wait(APSWBackup *self, PyObject *args, PyObject *kwds)
+{
+  PyObject *timeout = Py_None;
+  PY_TIMEOUT_T microseconds = -1;
+
+  CHECK_USE(NULL);
+  CHECK_BACKUP_CLOSED(NULL);
+
+  {
+    static char *kwlist[] = {"timeout", NULL};
+    Backup_wait_CHECK;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|O:" Backup_wait_USAGE, kwlist, &timeout))
+      return NULL;
+  }
+  if (timeout != Py_None)
+  {
+    double seconds = PyFloat_AsDouble(timeout);
+    if (seconds == -1 && PyErr_Occurred())
+      return NULL;
+    if (seconds < 0)
+      return PyErr_Format(PyExc_ValueError, "timeout can't be negative");
+    microseconds = (seconds * 1e6 < PY_TIMEOUT_MAX) ? (PY_TIMEOUT_T)(seconds * 1e6) : PY_TIMEOUT_MAX;
+  }
+
+  if (!APSWBackup_wait_worker(self, microseconds))
+    Py_RETURN_FALSE;
+
+  if (self->worker_type)
+  {
+    /* raised every time, and by finish */
+    Py_INCREF(self->worker_type);
+    Py_XINCREF(self->worker_value);
+    Py_XINCREF(self->worker_tb);
+    PyErr_Restore(self->worker_type, self->worker_value, self->worker_tb);
+    return NULL;
+  }
+  Py_RETURN_TRUE;
+}
+
 /** .. method:: finish() -> None
 
   Completes the copy process.  If all pages have been copied then the
@@ -391,6 +686,8 @@ static PyMethodDef backup_methods[] = {
      Backup_finish_DOC},
     {"close", (PyCFunction)APSWBackup_close, METH_VARARGS | METH_KEYWORDS,
      Backup_close_DOC},
+    {"wait", (PyCFunction)APSWBackup_wait, METH_VARARGS | METH_KEYWORDS,
+     Backup_wait_DOC},
     {0, 0, 0, 0}};
 
 static PyTypeObject APSWBackupType =
@@ -0,0 +1,250 @@
+/*
+  Native collations used by Connection.create_native_collation
+
+  See the accompanying LICENSE file.
+*/
+
+/* These are called by SQLite without needing Python or the GIL.
+
+   Strings are UTF-8.  Most text is ASCII so the common prefix of the
+   two strings is skipped eight bytes at a time, which for casefold and
+   noaccent also lower cases the ASCII letters.  Only the remainder is
+   decoded and mapped a code point at a time.  */
+
+#include "collationtables.h"
+
+typedef sqlite3_uint64 collation_word;
+
+#define COLLATION_ONES ((collation_word)0x0101010101010101ULL)
+#define COLLATION_HIGHBITS (COLLATION_ONES * 0x80)
+
+static collation_word
+collation_load(const unsigned char *p)
+{
+  collation_word w;
+  memcpy(&w, p, sizeof(w));
+  return w;
+}
+
+/* lower cases A-Z in a word of ASCII bytes */
+static collation_word
+collation_ascii_lower(collation_word w)
+{
+  collation_word abovez = w + COLLATION_ONES * (0x80 - 'Z' - 1);
+  collation_word atleasta = w + COLLATION_ONES * (0x80 - 'A');
+
+  return w | (((atleasta & ~abovez) & COLLATION_HIGHBITS) >> 2);
+}
+
+/* how many bytes at the start of both are the same, optionally with
+   ASCII letters lower cased, a word at a time and stopping at any non
+   ASCII bytes when lower casing */
+static int
+collation_prefix(const unsigned char *one, const unsigned char *two, int len, int lower)
+{
+  int i = 0;
+
+  for (; i + (int)sizeof(collation_word) <= len; i += sizeof(collation_word))
+  {
+    collation_word w1 = collation_load(one + i), w2 = collation_load(two + i);
+
+    if (lower)
+    {
+      if ((w1 | w2) & COLLATION_HIGHBITS)
+        break;
+      w1 = collation_ascii_lower(w1);
+      w2 = collation_ascii_lower(w2);
+    }
+    if (w1 != w2)
+      break;
+  }
+  for (; i < len; i++)
+  {
+    unsigned char c1 = one[i], c2 = two[i];
+
+    if (lower)
+    {
+      if ((c1 | c2) & 0x80)
+        break;
+      c1 = (c1 >= 'A' && c1 <= 'Z') ? c1 + 32 : c1;
+      c2 = (c2 >= 'A' && c2 <= 'Z') ? c2 + 32 : c2;
+    }
+    if (c1 != c2)
+      break;
+  }
+  return i;
+}
+
+/* decodes a code point.  Invalid bytes are returned as themselves */
+static unsigned int
+collation_decode(const unsigned char **pp, const unsigned char *end)
+{
+  const unsigned char *p = *pp;
+  unsigned int c = *p++, extra, i;
+
+  if (c < 0xc0 || c >= 0xf8)
+    extra = 0;
+  else
+    extra = (c >= 0xf0) ? 3 : (c >= 0xe0) ? 2 : 1;
+  if (extra && p + extra <= end)
+  {
+    unsigned int cp = c & (0x3f >> extra);
+
+    for (i = 0; i < extra; i++)
+    {
+      if ((p[i] & 0xc0) != 0x80)
+        break;
+      cp = (cp << 6) | (p[i] & 0x3f);
+    }
+    if (i == extra)
+    {
+      c = cp;
+      p += extra;
+    }
+  }
+  *pp = p;
+  return c;
+}
+
+typedef struct
+{
+  const unsigned char *p, *end;
+  int noaccent;
+  unsigned int pending[APSW_COLLATION_MAXMAPPING];
+  int npending, ipending;
+} collation_stream;
+
+/* next mapped code point, or -1 at the end */
+static int
+collation_next(collation_stream *s)
+{
+  unsigned int c;
+  int lo, hi, mid;
+
+  while (s->ipending == s->npending)
+  {
+    if (s->p >= s->end)
+      return -1;
+    c = collation_decode(&s->p, s->end);
+    if (c < 0x80)
+      return (c >= 'A' && c <= 'Z') ? c + 32 : c;
+
+    lo = 0;
+    hi = sizeof(collation_entries) / sizeof(collation_entries[0]) - 1;
+    while (lo <= hi)
+    {
+      mid = (lo + hi) / 2;
+      if (collation_entries[mid].codepoint == c)
+        break;
+      if (collation_entries[mid].codepoint < c)
+        lo = mid + 1;
+      else
+        hi = mid - 1;
+    }
+    if (lo > hi)
+      return c;
+
+    s->ipending = 0;
+    s->npending = s->noaccent ? collation_entries[mid].noaccentlen : collation_entries[mid].casefoldlen;
+    memcpy(s->pending, collation_mappings + (s->noaccent ? collation_entries[mid].noaccent : collation_entries[mid].casefold),
+           s->npending * sizeof(unsigned int));
+  }
+  return s->pending[s->ipending++];
+}
+
+static int
+collation_fold(int noaccent, int len1, const unsigned char *one, int len2, const unsigned char *two)
+{
+  collation_stream s1, s2;
+  int prefix = collation_prefix(one, two, Py_MIN(len1, len2), 1), c1, c2;
+
+  memset(&s1, 0, sizeof(s1));
+  memset(&s2, 0, sizeof(s2));
+  s1.noaccent = s2.noaccent = noaccent;
+  s1.p = one + prefix;
+  s1.end = one + len1;
+  s2.p = two + prefix;
+  s2.end = two + len2;
+
+  do
+  {
+    c1 = collation_next(&s1);
+    c2 = collation_next(&s2);
+    if (c1 != c2)
+      return (c1 < c2) ? -1 : 1;
+  } while (c1 >= 0);
+  return 0;
+}
+
+static int
+collation_casefold_cb(void *Py_UNUSED(context), int len1, const void *one, int len2, const void *two)
+{
+  return collation_fold(0, len1, one, len2, two);
+}
+
+static int
+collation_noaccent_cb(void *Py_UNUSED(context), int len1, const void *one, int len2, const void *two)
+{
+  return collation_fold(1, len1, one, len2, two);
+}
+
+#define COLLATION_ISDIGIT(c) ((c) >= '0' && (c) <= '9')
+
+static int
+collation_natural_cb(void *Py_UNUSED(context), int len1, const void *vone, int len2, const void *vtwo)
+{
+  const unsigned char *one = vone, *two = vtwo;
+  int prefix = collation_prefix(one, two, Py_MIN(len1, len2), 0), i1, i2, res;
+
+  /* numbers are compared whole so start at any digits in the prefix */
+  while (prefix && COLLATION_ISDIGIT(one[prefix - 1]))
+    prefix--;
+
+  i1 = i2 = prefix;
+  while (i1 < len1 && i2 < len2)
+  {
+    if (COLLATION_ISDIGIT(one[i1]) && COLLATION_ISDIGIT(two[i2]))
+    {
+      int start1, start2, digits1, digits2;
+
+      /* leading zeroes don't count, then more digits is a bigger number */
+      while (i1 < len1 && one[i1] == '0')
+        i1++;
+      while (i2 < len2 && two[i2] == '0')
+        i2++;
+      for (start1 = i1; i1 < len1 && COLLATION_ISDIGIT(one[i1]); i1++)
+        ;
+      for (start2 = i2; i2 < len2 && COLLATION_ISDIGIT(two[i2]); i2++)
+        ;
+      digits1 = i1 - start1;
+      digits2 = i2 - start2;
+      if (digits1 != digits2)
+        return (digits1 < digits2) ? -1 : 1;
+      res = memcmp(one + start1, two + start2, digits1);
+      if (res)
+        return res;
+      continue;
+    }
+    if (one[i1] != two[i2])
+      return (one[i1] < two[i2]) ? -1 : 1;
+    i1++;
+    i2++;
+  }
+  if (i1 < len1 || i2 < len2)
+    return (i1 < len1) ? 1 : -1;
+
+  /* equal apart from leading zeroes, which are then tie breakers so
+     only identical strings are equal */
+  res = memcmp(one, two, Py_MIN(len1, len2));
+  return res ? res : (len1 - len2);
+}
+
+static const struct
+{
+  const char *name;
+  int (*xCompare)(void *, int, const void *, int, const void *);
+} native_collations[] = {
+    {"natural", collation_natural_cb},
+    {"casefold", collation_casefold_cb},
+    {"noaccent", collation_noaccent_cb},
+};
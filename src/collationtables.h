@@ -0,0 +1,3337 @@
+/* Generated by tools/gencollationtables.py from Unicode 14.0.0 - do not edit */
+
+/* most code points a code point maps to */
+#define APSW_COLLATION_MAXMAPPING 3
+
+static const unsigned int collation_mappings[] = {
+    0x3bc, 0xe0, 0x61, 0xe1, 0xe2, 0xe3, 0xe4, 0xe5,
+    0xe6, 0xe7, 0x63, 0xe8, 0x65, 0xe9, 0xea, 0xeb,
+    0xec, 0x69, 0xed, 0xee, 0xef, 0xf0, 0xf1, 0x6e,
+    0xf2, 0x6f, 0xf3, 0xf4, 0xf5, 0xf6, 0xf8, 0xf9,
+    0x75, 0xfa, 0xfb, 0xfc, 0xfd, 0x79, 0xfe, 0x73,
+    0x73, 0xff, 0x101, 0x103, 0x105, 0x107, 0x109, 0x10b,
+    0x10d, 0x10f, 0x64, 0x111, 0x113, 0x115, 0x117, 0x119,
+    0x11b, 0x11d, 0x67, 0x11f, 0x121, 0x123, 0x125, 0x68,
+    0x127, 0x129, 0x12b, 0x12d, 0x12f, 0x69, 0x307, 0x133,
+    0x135, 0x6a, 0x137, 0x6b, 0x13a, 0x6c, 0x13c, 0x13e,
+    0x140, 0x142, 0x144, 0x146, 0x148, 0x2bc, 0x6e, 0x14b,
+    0x14d, 0x14f, 0x151, 0x153, 0x155, 0x72, 0x157, 0x159,
+    0x15b, 0x73, 0x15d, 0x15f, 0x161, 0x163, 0x74, 0x165,
+    0x167, 0x169, 0x16b, 0x16d, 0x16f, 0x171, 0x173, 0x175,
+    0x77, 0x177, 0x17a, 0x7a, 0x17c, 0x17e, 0x253, 0x183,
+    0x185, 0x254, 0x188, 0x256, 0x257, 0x18c, 0x1dd, 0x259,
+    0x25b, 0x192, 0x260, 0x263, 0x269, 0x268, 0x199, 0x26f,
+    0x272, 0x275, 0x1a1, 0x1a3, 0x1a5, 0x280, 0x1a8, 0x283,
+    0x1ad, 0x288, 0x1b0, 0x28a, 0x28b, 0x1b4, 0x1b6, 0x292,
+    0x1b9, 0x1bd, 0x1c6, 0x1c9, 0x1cc, 0x1ce, 0x1d0, 0x1d2,
+    0x1d4, 0x1d6, 0x1d8, 0x1da, 0x1dc, 0x1df, 0x1e1, 0x1e3,
+    0x1e5, 0x1e7, 0x1e9, 0x1eb, 0x1ed, 0x1ef, 0x6a, 0x30c,
+    0x1f3, 0x1f5, 0x195, 0x1bf, 0x1f9, 0x1fb, 0x1fd, 0x1ff,
+    0x201, 0x203, 0x205, 0x207, 0x209, 0x20b, 0x20d, 0x20f,
+    0x211, 0x213, 0x215, 0x217, 0x219, 0x21b, 0x21d, 0x21f,
+    0x19e, 0x223, 0x225, 0x227, 0x229, 0x22b, 0x22d, 0x22f,
+    0x231, 0x233, 0x2c65, 0x23c, 0x19a, 0x2c66, 0x242, 0x180,
+    0x289, 0x28c, 0x247, 0x249, 0x24b, 0x24d, 0x24f, 0x300,
+    0x301, 0x302, 0x303, 0x304, 0x305, 0x306, 0x307, 0x308,
+    0x309, 0x30a, 0x30b, 0x30c, 0x30d, 0x30e, 0x30f, 0x310,
+    0x311, 0x312, 0x313, 0x314, 0x315, 0x316, 0x317, 0x318,
+    0x319, 0x31a, 0x31b, 0x31c, 0x31d, 0x31e, 0x31f, 0x320,
+    0x321, 0x322, 0x323, 0x324, 0x325, 0x326, 0x327, 0x328,
+    0x329, 0x32a, 0x32b, 0x32c, 0x32d, 0x32e, 0x32f, 0x330,
+    0x331, 0x332, 0x333, 0x334, 0x335, 0x336, 0x337, 0x338,
+    0x339, 0x33a, 0x33b, 0x33c, 0x33d, 0x33e, 0x33f, 0x340,
+    0x341, 0x342, 0x343, 0x344, 0x3b9, 0x346, 0x347, 0x348,
+    0x349, 0x34a, 0x34b, 0x34c, 0x34d, 0x34e, 0x350, 0x351,
+    0x352, 0x353, 0x354, 0x355, 0x356, 0x357, 0x358, 0x359,
+    0x35a, 0x35b, 0x35c, 0x35d, 0x35e, 0x35f, 0x360, 0x361,
+    0x362, 0x363, 0x364, 0x365, 0x366, 0x367, 0x368, 0x369,
+    0x36a, 0x36b, 0x36c, 0x36d, 0x36e, 0x36f, 0x371, 0x373,
+    0x377, 0x3f3, 0x385, 0xa8, 0x3ac, 0x3b1, 0x3ad, 0x3b5,
+    0x3ae, 0x3b7, 0x3af, 0x3cc, 0x3bf, 0x3cd, 0x3c5, 0x3ce,
+    0x3c9, 0x3b9, 0x308, 0x301, 0x3b2, 0x3b3, 0x3b4, 0x3b6,
+    0x3b8, 0x3ba, 0x3bb, 0x3bd, 0x3be, 0x3c0, 0x3c1, 0x3c3,
+    0x3c4, 0x3c6, 0x3c7, 0x3c8, 0x3ca, 0x3cb, 0x3c5, 0x308,
+    0x301, 0x3d7, 0x3d3, 0x3d2, 0x3d4, 0x3d9, 0x3db, 0x3dd,
+    0x3df, 0x3e1, 0x3e3, 0x3e5, 0x3e7, 0x3e9, 0x3eb, 0x3ed,
+    0x3ef, 0x3f8, 0x3f2, 0x3fb, 0x37b, 0x37c, 0x37d, 0x450,
+    0x435, 0x451, 0x452, 0x453, 0x433, 0x454, 0x455, 0x456,
+    0x457, 0x458, 0x459, 0x45a, 0x45b, 0x45c, 0x43a, 0x45d,
+    0x438, 0x45e, 0x443, 0x45f, 0x430, 0x431, 0x432, 0x434,
+    0x436, 0x437, 0x439, 0x43b, 0x43c, 0x43d, 0x43e, 0x43f,
+    0x440, 0x441, 0x442, 0x444, 0x445, 0x446, 0x447, 0x448,
+    0x449, 0x44a, 0x44b, 0x44c, 0x44d, 0x44e, 0x44f, 0x461,
+    0x463, 0x465, 0x467, 0x469, 0x46b, 0x46d, 0x46f, 0x471,
+    0x473, 0x475, 0x477, 0x479, 0x47b, 0x47d, 0x47f, 0x481,
+    0x483, 0x484, 0x485, 0x486, 0x487, 0x48b, 0x48d, 0x48f,
+    0x491, 0x493, 0x495, 0x497, 0x499, 0x49b, 0x49d, 0x49f,
+    0x4a1, 0x4a3, 0x4a5, 0x4a7, 0x4a9, 0x4ab, 0x4ad, 0x4af,
+    0x4b1, 0x4b3, 0x4b5, 0x4b7, 0x4b9, 0x4bb, 0x4bd, 0x4bf,
+    0x4cf, 0x4c2, 0x4c4, 0x4c6, 0x4c8, 0x4ca, 0x4cc, 0x4ce,
+    0x4d1, 0x4d3, 0x4d5, 0x4d7, 0x4d9, 0x4db, 0x4dd, 0x4df,
+    0x4e1, 0x4e3, 0x4e5, 0x4e7, 0x4e9, 0x4eb, 0x4ed, 0x4ef,
+    0x4f1, 0x4f3, 0x4f5, 0x4f7, 0x4f9, 0x4fb, 0x4fd, 0x4ff,
+    0x501, 0x503, 0x505, 0x507, 0x509, 0x50b, 0x50d, 0x50f,
+    0x511, 0x513, 0x515, 0x517, 0x519, 0x51b, 0x51d, 0x51f,
+    0x521, 0x523, 0x525, 0x527, 0x529, 0x52b, 0x52d, 0x52f,
+    0x561, 0x562, 0x563, 0x564, 0x565, 0x566, 0x567, 0x568,
+    0x569, 0x56a, 0x56b, 0x56c, 0x56d, 0x56e, 0x56f, 0x570,
+    0x571, 0x572, 0x573, 0x574, 0x575, 0x576, 0x577, 0x578,
+    0x579, 0x57a, 0x57b, 0x57c, 0x57d, 0x57e, 0x57f, 0x580,
+    0x581, 0x582, 0x583, 0x584, 0x585, 0x586, 0x565, 0x582,
+    0x591, 0x592, 0x593, 0x594, 0x595, 0x596, 0x597, 0x598,
+    0x599, 0x59a, 0x59b, 0x59c, 0x59d, 0x59e, 0x59f, 0x5a0,
+    0x5a1, 0x5a2, 0x5a3, 0x5a4, 0x5a5, 0x5a6, 0x5a7, 0x5a8,
+    0x5a9, 0x5aa, 0x5ab, 0x5ac, 0x5ad, 0x5ae, 0x5af, 0x5b0,
+    0x5b1, 0x5b2, 0x5b3, 0x5b4, 0x5b5, 0x5b6, 0x5b7, 0x5b8,
+    0x5b9, 0x5ba, 0x5bb, 0x5bc, 0x5bd, 0x5bf, 0x5c1, 0x5c2,
+    0x5c4, 0x5c5, 0x5c7, 0x610, 0x611, 0x612, 0x613, 0x614,
+    0x615, 0x616, 0x617, 0x618, 0x619, 0x61a, 0x622, 0x627,
+    0x623, 0x624, 0x648, 0x625, 0x626, 0x64a, 0x64b, 0x64c,
+    0x64d, 0x64e, 0x64f, 0x650, 0x651, 0x652, 0x653, 0x654,
+    0x655, 0x656, 0x657, 0x658, 0x659, 0x65a, 0x65b, 0x65c,
+    0x65d, 0x65e, 0x65f, 0x670, 0x6c0, 0x6d5, 0x6c2, 0x6c1,
+    0x6d3, 0x6d2, 0x6d6, 0x6d7, 0x6d8, 0x6d9, 0x6da, 0x6db,
+    0x6dc, 0x6df, 0x6e0, 0x6e1, 0x6e2, 0x6e3, 0x6e4, 0x6e7,
+    0x6e8, 0x6ea, 0x6eb, 0x6ec, 0x6ed, 0x711, 0x730, 0x731,
+    0x732, 0x733, 0x734, 0x735, 0x736, 0x737, 0x738, 0x739,
+    0x73a, 0x73b, 0x73c, 0x73d, 0x73e, 0x73f, 0x740, 0x741,
+    0x742, 0x743, 0x744, 0x745, 0x746, 0x747, 0x748, 0x749,
+    0x74a, 0x7eb, 0x7ec, 0x7ed, 0x7ee, 0x7ef, 0x7f0, 0x7f1,
+    0x7f2, 0x7f3, 0x7fd, 0x816, 0x817, 0x818, 0x819, 0x81b,
+    0x81c, 0x81d, 0x81e, 0x81f, 0x820, 0x821, 0x822, 0x823,
+    0x825, 0x826, 0x827, 0x829, 0x82a, 0x82b, 0x82c, 0x82d,
+    0x859, 0x85a, 0x85b, 0x898, 0x899, 0x89a, 0x89b, 0x89c,
+    0x89d, 0x89e, 0x89f, 0x8ca, 0x8cb, 0x8cc, 0x8cd, 0x8ce,
+    0x8cf, 0x8d0, 0x8d1, 0x8d2, 0x8d3, 0x8d4, 0x8d5, 0x8d6,
+    0x8d7, 0x8d8, 0x8d9, 0x8da, 0x8db, 0x8dc, 0x8dd, 0x8de,
+    0x8df, 0x8e0, 0x8e1, 0x8e3, 0x8e4, 0x8e5, 0x8e6, 0x8e7,
+    0x8e8, 0x8e9, 0x8ea, 0x8eb, 0x8ec, 0x8ed, 0x8ee, 0x8ef,
+    0x8f0, 0x8f1, 0x8f2, 0x8f3, 0x8f4, 0x8f5, 0x8f6, 0x8f7,
+    0x8f8, 0x8f9, 0x8fa, 0x8fb, 0x8fc, 0x8fd, 0x8fe, 0x8ff,
+    0x929, 0x928, 0x931, 0x930, 0x934, 0x933, 0x93c, 0x94d,
+    0x951, 0x952, 0x953, 0x954, 0x958, 0x915, 0x959, 0x916,
+    0x95a, 0x917, 0x95b, 0x91c, 0x95c, 0x921, 0x95d, 0x922,
+    0x95e, 0x92b, 0x95f, 0x92f, 0x9bc, 0x9cd, 0x9dc, 0x9a1,
+    0x9dd, 0x9a2, 0x9df, 0x9af, 0x9fe, 0xa33, 0xa32, 0xa36,
+    0xa38, 0xa3c, 0xa4d, 0xa59, 0xa16, 0xa5a, 0xa17, 0xa5b,
+    0xa1c, 0xa5e, 0xa2b, 0xabc, 0xacd, 0xb3c, 0xb4d, 0xb5c,
+    0xb21, 0xb5d, 0xb22, 0xbcd, 0xc3c, 0xc48, 0xc46, 0xc4d,
+    0xc55, 0xc56, 0xcbc, 0xccd, 0xd3b, 0xd3c, 0xd4d, 0xdca,
+    0xdda, 0xdd9, 0xddd, 0xddc, 0xe38, 0xe39, 0xe3a, 0xe48,
+    0xe49, 0xe4a, 0xe4b, 0xeb8, 0xeb9, 0xeba, 0xec8, 0xec9,
+    0xeca, 0xecb, 0xf18, 0xf19, 0xf35, 0xf37, 0xf39, 0xf71,
+    0xf72, 0xf73, 0xf74, 0xf75, 0xf76, 0xfb2, 0xf78, 0xfb3,
+    0xf7a, 0xf7b, 0xf7c, 0xf7d, 0xf80, 0xf81, 0xf82, 0xf83,
+    0xf84, 0xf86, 0xf87, 0xfc6, 0x1037, 0x1039, 0x103a, 0x108d,
+    0x2d00, 0x2d01, 0x2d02, 0x2d03, 0x2d04, 0x2d05, 0x2d06, 0x2d07,
+    0x2d08, 0x2d09, 0x2d0a, 0x2d0b, 0x2d0c, 0x2d0d, 0x2d0e, 0x2d0f,
+    0x2d10, 0x2d11, 0x2d12, 0x2d13, 0x2d14, 0x2d15, 0x2d16, 0x2d17,
+    0x2d18, 0x2d19, 0x2d1a, 0x2d1b, 0x2d1c, 0x2d1d, 0x2d1e, 0x2d1f,
+    0x2d20, 0x2d21, 0x2d22, 0x2d23, 0x2d24, 0x2d25, 0x2d27, 0x2d2d,
+    0x135d, 0x135e, 0x135f, 0x13f0, 0x13f1, 0x13f2, 0x13f3, 0x13f4,
+    0x13f5, 0x1714, 0x1715, 0x1734, 0x17d2, 0x17dd, 0x18a9, 0x1939,
+    0x193a, 0x193b, 0x1a17, 0x1a18, 0x1a60, 0x1a75, 0x1a76, 0x1a77,
+    0x1a78, 0x1a79, 0x1a7a, 0x1a7b, 0x1a7c, 0x1a7f, 0x1ab0, 0x1ab1,
+    0x1ab2, 0x1ab3, 0x1ab4, 0x1ab5, 0x1ab6, 0x1ab7, 0x1ab8, 0x1ab9,
+    0x1aba, 0x1abb, 0x1abc, 0x1abd, 0x1abf, 0x1ac0, 0x1ac1, 0x1ac2,
+    0x1ac3, 0x1ac4, 0x1ac5, 0x1ac6, 0x1ac7, 0x1ac8, 0x1ac9, 0x1aca,
+    0x1acb, 0x1acc, 0x1acd, 0x1ace, 0x1b34, 0x1b44, 0x1b6b, 0x1b6c,
+    0x1b6d, 0x1b6e, 0x1b6f, 0x1b70, 0x1b71, 0x1b72, 0x1b73, 0x1baa,
+    0x1bab, 0x1be6, 0x1bf2, 0x1bf3, 0x1c37, 0xa64b, 0x10d0, 0x10d1,
+    0x10d2, 0x10d3, 0x10d4, 0x10d5, 0x10d6, 0x10d7, 0x10d8, 0x10d9,
+    0x10da, 0x10db, 0x10dc, 0x10dd, 0x10de, 0x10df, 0x10e0, 0x10e1,
+    0x10e2, 0x10e3, 0x10e4, 0x10e5, 0x10e6, 0x10e7, 0x10e8, 0x10e9,
+    0x10ea, 0x10eb, 0x10ec, 0x10ed, 0x10ee, 0x10ef, 0x10f0, 0x10f1,
+    0x10f2, 0x10f3, 0x10f4, 0x10f5, 0x10f6, 0x10f7, 0x10f8, 0x10f9,
+    0x10fa, 0x10fd, 0x10fe, 0x10ff, 0x1cd0, 0x1cd1, 0x1cd2, 0x1cd4,
+    0x1cd5, 0x1cd6, 0x1cd7, 0x1cd8, 0x1cd9, 0x1cda, 0x1cdb, 0x1cdc,
+    0x1cdd, 0x1cde, 0x1cdf, 0x1ce0, 0x1ce2, 0x1ce3, 0x1ce4, 0x1ce5,
+    0x1ce6, 0x1ce7, 0x1ce8, 0x1ced, 0x1cf4, 0x1cf8, 0x1cf9, 0x1dc0,
+    0x1dc1, 0x1dc2, 0x1dc3, 0x1dc4, 0x1dc5, 0x1dc6, 0x1dc7, 0x1dc8,
+    0x1dc9, 0x1dca, 0x1dcb, 0x1dcc, 0x1dcd, 0x1dce, 0x1dcf, 0x1dd0,
+    0x1dd1, 0x1dd2, 0x1dd3, 0x1dd4, 0x1dd5, 0x1dd6, 0x1dd7, 0x1dd8,
+    0x1dd9, 0x1dda, 0x1ddb, 0x1ddc, 0x1ddd, 0x1dde, 0x1ddf, 0x1de0,
+    0x1de1, 0x1de2, 0x1de3, 0x1de4, 0x1de5, 0x1de6, 0x1de7, 0x1de8,
+    0x1de9, 0x1dea, 0x1deb, 0x1dec, 0x1ded, 0x1dee, 0x1def, 0x1df0,
+    0x1df1, 0x1df2, 0x1df3, 0x1df4, 0x1df5, 0x1df6, 0x1df7, 0x1df8,
+    0x1df9, 0x1dfa, 0x1dfb, 0x1dfc, 0x1dfd, 0x1dfe, 0x1dff, 0x1e01,
+    0x1e03, 0x62, 0x1e05, 0x1e07, 0x1e09, 0x1e0b, 0x1e0d, 0x1e0f,
+    0x1e11, 0x1e13, 0x1e15, 0x1e17, 0x1e19, 0x1e1b, 0x1e1d, 0x1e1f,
+    0x66, 0x1e21, 0x1e23, 0x1e25, 0x1e27, 0x1e29, 0x1e2b, 0x1e2d,
+    0x1e2f, 0x1e31, 0x1e33, 0x1e35, 0x1e37, 0x1e39, 0x1e3b, 0x1e3d,
+    0x1e3f, 0x6d, 0x1e41, 0x1e43, 0x1e45, 0x1e47, 0x1e49, 0x1e4b,
+    0x1e4d, 0x1e4f, 0x1e51, 0x1e53, 0x1e55, 0x70, 0x1e57, 0x1e59,
+    0x1e5b, 0x1e5d, 0x1e5f, 0x1e61, 0x1e63, 0x1e65, 0x1e67, 0x1e69,
+    0x1e6b, 0x1e6d, 0x1e6f, 0x1e71, 0x1e73, 0x1e75, 0x1e77, 0x1e79,
+    0x1e7b, 0x1e7d, 0x76, 0x1e7f, 0x1e81, 0x1e83, 0x1e85, 0x1e87,
+    0x1e89, 0x1e8b, 0x78, 0x1e8d, 0x1e8f, 0x1e91, 0x1e93, 0x1e95,
+    0x68, 0x331, 0x74, 0x308, 0x77, 0x30a, 0x79, 0x30a,
+    0x61, 0x2be, 0x1ea1, 0x1ea3, 0x1ea5, 0x1ea7, 0x1ea9, 0x1eab,
+    0x1ead, 0x1eaf, 0x1eb1, 0x1eb3, 0x1eb5, 0x1eb7, 0x1eb9, 0x1ebb,
+    0x1ebd, 0x1ebf, 0x1ec1, 0x1ec3, 0x1ec5, 0x1ec7, 0x1ec9, 0x1ecb,
+    0x1ecd, 0x1ecf, 0x1ed1, 0x1ed3, 0x1ed5, 0x1ed7, 0x1ed9, 0x1edb,
+    0x1edd, 0x1edf, 0x1ee1, 0x1ee3, 0x1ee5, 0x1ee7, 0x1ee9, 0x1eeb,
+    0x1eed, 0x1eef, 0x1ef1, 0x1ef3, 0x1ef5, 0x1ef7, 0x1ef9, 0x1efb,
+    0x1efd, 0x1eff, 0x1f00, 0x1f01, 0x1f02, 0x1f03, 0x1f04, 0x1f05,
+    0x1f06, 0x1f07, 0x1f10, 0x1f11, 0x1f12, 0x1f13, 0x1f14, 0x1f15,
+    0x1f20, 0x1f21, 0x1f22, 0x1f23, 0x1f24, 0x1f25, 0x1f26, 0x1f27,
+    0x1f30, 0x1f31, 0x1f32, 0x1f33, 0x1f34, 0x1f35, 0x1f36, 0x1f37,
+    0x1f40, 0x1f41, 0x1f42, 0x1f43, 0x1f44, 0x1f45, 0x3c5, 0x313,
+    0x1f51, 0x3c5, 0x313, 0x300, 0x1f53, 0x3c5, 0x313, 0x301,
+    0x1f55, 0x3c5, 0x313, 0x342, 0x1f57, 0x1f60, 0x1f61, 0x1f62,
+    0x1f63, 0x1f64, 0x1f65, 0x1f66, 0x1f67, 0x1f70, 0x1f71, 0x1f72,
+    0x1f73, 0x1f74, 0x1f75, 0x1f76, 0x1f77, 0x1f78, 0x1f79, 0x1f7a,
+    0x1f7b, 0x1f7c, 0x1f7d, 0x1f00, 0x3b9, 0x3b1, 0x3b9, 0x1f01,
+    0x3b9, 0x1f02, 0x3b9, 0x1f03, 0x3b9, 0x1f04, 0x3b9, 0x1f05,
+    0x3b9, 0x1f06, 0x3b9, 0x1f07, 0x3b9, 0x1f20, 0x3b9, 0x3b7,
+    0x3b9, 0x1f21, 0x3b9, 0x1f22, 0x3b9, 0x1f23, 0x3b9, 0x1f24,
+    0x3b9, 0x1f25, 0x3b9, 0x1f26, 0x3b9, 0x1f27, 0x3b9, 0x1f60,
+    0x3b9, 0x3c9, 0x3b9, 0x1f61, 0x3b9, 0x1f62, 0x3b9, 0x1f63,
+    0x3b9, 0x1f64, 0x3b9, 0x1f65, 0x3b9, 0x1f66, 0x3b9, 0x1f67,
+    0x3b9, 0x1fb0, 0x1fb1, 0x1f70, 0x3b9, 0x3ac, 0x3b9, 0x3b1,
+    0x342, 0x3b1, 0x342, 0x3b9, 0x1fc1, 0x1f74, 0x3b9, 0x3ae,
+    0x3b9, 0x3b7, 0x342, 0x3b7, 0x342, 0x3b9, 0x1fcd, 0x1fbf,
+    0x1fce, 0x1fcf, 0x1fd0, 0x1fd1, 0x3b9, 0x308, 0x300, 0x3b9,
+    0x342, 0x3b9, 0x308, 0x342, 0x1fdd, 0x1ffe, 0x1fde, 0x1fdf,
+    0x1fe0, 0x1fe1, 0x3c5, 0x308, 0x300, 0x3c1, 0x313, 0x1fe5,
+    0x3c5, 0x342, 0x3c5, 0x308, 0x342, 0x1fed, 0x1fee, 0x1f7c,
+    0x3b9, 0x3ce, 0x3b9, 0x3c9, 0x342, 0x3c9, 0x342, 0x3b9,
+    0x20d0, 0x20d1, 0x20d2, 0x20d3, 0x20d4, 0x20d5, 0x20d6, 0x20d7,
+    0x20d8, 0x20d9, 0x20da, 0x20db, 0x20dc, 0x20e1, 0x20e5, 0x20e6,
+    0x20e7, 0x20e8, 0x20e9, 0x20ea, 0x20eb, 0x20ec, 0x20ed, 0x20ee,
+    0x20ef, 0x20f0, 0x214e, 0x2170, 0x2171, 0x2172, 0x2173, 0x2174,
+    0x2175, 0x2176, 0x2177, 0x2178, 0x2179, 0x217a, 0x217b, 0x217c,
+    0x217d, 0x217e, 0x217f, 0x2184, 0x219a, 0x2190, 0x219b, 0x2192,
+    0x21ae, 0x2194, 0x21cd, 0x21d0, 0x21ce, 0x21d4, 0x21cf, 0x21d2,
+    0x2204, 0x2203, 0x2209, 0x2208, 0x220c, 0x220b, 0x2224, 0x2223,
+    0x2226, 0x2225, 0x2241, 0x223c, 0x2244, 0x2243, 0x2247, 0x2245,
+    0x2249, 0x2248, 0x2260, 0x3d, 0x2262, 0x2261, 0x226d, 0x224d,
+    0x226e, 0x3c, 0x226f, 0x3e, 0x2270, 0x2264, 0x2271, 0x2265,
+    0x2274, 0x2272, 0x2275, 0x2273, 0x2278, 0x2276, 0x2279, 0x2277,
+    0x2280, 0x227a, 0x2281, 0x227b, 0x2284, 0x2282, 0x2285, 0x2283,
+    0x2288, 0x2286, 0x2289, 0x2287, 0x22ac, 0x22a2, 0x22ad, 0x22a8,
+    0x22ae, 0x22a9, 0x22af, 0x22ab, 0x22e0, 0x227c, 0x22e1, 0x227d,
+    0x22e2, 0x2291, 0x22e3, 0x2292, 0x22ea, 0x22b2, 0x22eb, 0x22b3,
+    0x22ec, 0x22b4, 0x22ed, 0x22b5, 0x24d0, 0x24d1, 0x24d2, 0x24d3,
+    0x24d4, 0x24d5, 0x24d6, 0x24d7, 0x24d8, 0x24d9, 0x24da, 0x24db,
+    0x24dc, 0x24dd, 0x24de, 0x24df, 0x24e0, 0x24e1, 0x24e2, 0x24e3,
+    0x24e4, 0x24e5, 0x24e6, 0x24e7, 0x24e8, 0x24e9, 0x2adc, 0x2add,
+    0x2c30, 0x2c31, 0x2c32, 0x2c33, 0x2c34, 0x2c35, 0x2c36, 0x2c37,
+    0x2c38, 0x2c39, 0x2c3a, 0x2c3b, 0x2c3c, 0x2c3d, 0x2c3e, 0x2c3f,
+    0x2c40, 0x2c41, 0x2c42, 0x2c43, 0x2c44, 0x2c45, 0x2c46, 0x2c47,
+    0x2c48, 0x2c49, 0x2c4a, 0x2c4b, 0x2c4c, 0x2c4d, 0x2c4e, 0x2c4f,
+    0x2c50, 0x2c51, 0x2c52, 0x2c53, 0x2c54, 0x2c55, 0x2c56, 0x2c57,
+    0x2c58, 0x2c59, 0x2c5a, 0x2c5b, 0x2c5c, 0x2c5d, 0x2c5e, 0x2c5f,
+    0x2c61, 0x26b, 0x1d7d, 0x27d, 0x2c68, 0x2c6a, 0x2c6c, 0x251,
+    0x271, 0x250, 0x252, 0x2c73, 0x2c76, 0x23f, 0x240, 0x2c81,
+    0x2c83, 0x2c85, 0x2c87, 0x2c89, 0x2c8b, 0x2c8d, 0x2c8f, 0x2c91,
+    0x2c93, 0x2c95, 0x2c97, 0x2c99, 0x2c9b, 0x2c9d, 0x2c9f, 0x2ca1,
+    0x2ca3, 0x2ca5, 0x2ca7, 0x2ca9, 0x2cab, 0x2cad, 0x2caf, 0x2cb1,
+    0x2cb3, 0x2cb5, 0x2cb7, 0x2cb9, 0x2cbb, 0x2cbd, 0x2cbf, 0x2cc1,
+    0x2cc3, 0x2cc5, 0x2cc7, 0x2cc9, 0x2ccb, 0x2ccd, 0x2ccf, 0x2cd1,
+    0x2cd3, 0x2cd5, 0x2cd7, 0x2cd9, 0x2cdb, 0x2cdd, 0x2cdf, 0x2ce1,
+    0x2ce3, 0x2cec, 0x2cee, 0x2cef, 0x2cf0, 0x2cf1, 0x2cf3, 0x2d7f,
+    0x2de0, 0x2de1, 0x2de2, 0x2de3, 0x2de4, 0x2de5, 0x2de6, 0x2de7,
+    0x2de8, 0x2de9, 0x2dea, 0x2deb, 0x2dec, 0x2ded, 0x2dee, 0x2def,
+    0x2df0, 0x2df1, 0x2df2, 0x2df3, 0x2df4, 0x2df5, 0x2df6, 0x2df7,
+    0x2df8, 0x2df9, 0x2dfa, 0x2dfb, 0x2dfc, 0x2dfd, 0x2dfe, 0x2dff,
+    0x302a, 0x302b, 0x302c, 0x302d, 0x302e, 0x302f, 0x304c, 0x304b,
+    0x304e, 0x304d, 0x3050, 0x304f, 0x3052, 0x3051, 0x3054, 0x3053,
+    0x3056, 0x3055, 0x3058, 0x3057, 0x305a, 0x3059, 0x305c, 0x305b,
+    0x305e, 0x305d, 0x3060, 0x305f, 0x3062, 0x3061, 0x3065, 0x3064,
+    0x3067, 0x3066, 0x3069, 0x3068, 0x3070, 0x306f, 0x3071, 0x3073,
+    0x3072, 0x3074, 0x3076, 0x3075, 0x3077, 0x3079, 0x3078, 0x307a,
+    0x307c, 0x307b, 0x307d, 0x3094, 0x3046, 0x3099, 0x309a, 0x309e,
+    0x309d, 0x30ac, 0x30ab, 0x30ae, 0x30ad, 0x30b0, 0x30af, 0x30b2,
+    0x30b1, 0x30b4, 0x30b3, 0x30b6, 0x30b5, 0x30b8, 0x30b7, 0x30ba,
+    0x30b9, 0x30bc, 0x30bb, 0x30be, 0x30bd, 0x30c0, 0x30bf, 0x30c2,
+    0x30c1, 0x30c5, 0x30c4, 0x30c7, 0x30c6, 0x30c9, 0x30c8, 0x30d0,
+    0x30cf, 0x30d1, 0x30d3, 0x30d2, 0x30d4, 0x30d6, 0x30d5, 0x30d7,
+    0x30d9, 0x30d8, 0x30da, 0x30dc, 0x30db, 0x30dd, 0x30f4, 0x30a6,
+    0x30f7, 0x30ef, 0x30f8, 0x30f0, 0x30f9, 0x30f1, 0x30fa, 0x30f2,
+    0x30fe, 0x30fd, 0xa641, 0xa643, 0xa645, 0xa647, 0xa649, 0xa64d,
+    0xa64f, 0xa651, 0xa653, 0xa655, 0xa657, 0xa659, 0xa65b, 0xa65d,
+    0xa65f, 0xa661, 0xa663, 0xa665, 0xa667, 0xa669, 0xa66b, 0xa66d,
+    0xa66f, 0xa674, 0xa675, 0xa676, 0xa677, 0xa678, 0xa679, 0xa67a,
+    0xa67b, 0xa67c, 0xa67d, 0xa681, 0xa683, 0xa685, 0xa687, 0xa689,
+    0xa68b, 0xa68d, 0xa68f, 0xa691, 0xa693, 0xa695, 0xa697, 0xa699,
+    0xa69b, 0xa69e, 0xa69f, 0xa6f0, 0xa6f1, 0xa723, 0xa725, 0xa727,
+    0xa729, 0xa72b, 0xa72d, 0xa72f, 0xa733, 0xa735, 0xa737, 0xa739,
+    0xa73b, 0xa73d, 0xa73f, 0xa741, 0xa743, 0xa745, 0xa747, 0xa749,
+    0xa74b, 0xa74d, 0xa74f, 0xa751, 0xa753, 0xa755, 0xa757, 0xa759,
+    0xa75b, 0xa75d, 0xa75f, 0xa761, 0xa763, 0xa765, 0xa767, 0xa769,
+    0xa76b, 0xa76d, 0xa76f, 0xa77a, 0xa77c, 0x1d79, 0xa77f, 0xa781,
+    0xa783, 0xa785, 0xa787, 0xa78c, 0x265, 0xa791, 0xa793, 0xa797,
+    0xa799, 0xa79b, 0xa79d, 0xa79f, 0xa7a1, 0xa7a3, 0xa7a5, 0xa7a7,
+    0xa7a9, 0x266, 0x25c, 0x261, 0x26c, 0x26a, 0x29e, 0x287,
+    0x29d, 0xab53, 0xa7b5, 0xa7b7, 0xa7b9, 0xa7bb, 0xa7bd, 0xa7bf,
+    0xa7c1, 0xa7c3, 0xa794, 0x282, 0x1d8e, 0xa7c8, 0xa7ca, 0xa7d1,
+    0xa7d7, 0xa7d9, 0xa7f6, 0xa806, 0xa82c, 0xa8c4, 0xa8e0, 0xa8e1,
+    0xa8e2, 0xa8e3, 0xa8e4, 0xa8e5, 0xa8e6, 0xa8e7, 0xa8e8, 0xa8e9,
+    0xa8ea, 0xa8eb, 0xa8ec, 0xa8ed, 0xa8ee, 0xa8ef, 0xa8f0, 0xa8f1,
+    0xa92b, 0xa92c, 0xa92d, 0xa953, 0xa9b3, 0xa9c0, 0xaab0, 0xaab2,
+    0xaab3, 0xaab4, 0xaab7, 0xaab8, 0xaabe, 0xaabf, 0xaac1, 0xaaf6,
+    0x13a0, 0x13a1, 0x13a2, 0x13a3, 0x13a4, 0x13a5, 0x13a6, 0x13a7,
+    0x13a8, 0x13a9, 0x13aa, 0x13ab, 0x13ac, 0x13ad, 0x13ae, 0x13af,
+    0x13b0, 0x13b1, 0x13b2, 0x13b3, 0x13b4, 0x13b5, 0x13b6, 0x13b7,
+    0x13b8, 0x13b9, 0x13ba, 0x13bb, 0x13bc, 0x13bd, 0x13be, 0x13bf,
+    0x13c0, 0x13c1, 0x13c2, 0x13c3, 0x13c4, 0x13c5, 0x13c6, 0x13c7,
+    0x13c8, 0x13c9, 0x13ca, 0x13cb, 0x13cc, 0x13cd, 0x13ce, 0x13cf,
+    0x13d0, 0x13d1, 0x13d2, 0x13d3, 0x13d4, 0x13d5, 0x13d6, 0x13d7,
+    0x13d8, 0x13d9, 0x13da, 0x13db, 0x13dc, 0x13dd, 0x13de, 0x13df,
+    0x13e0, 0x13e1, 0x13e2, 0x13e3, 0x13e4, 0x13e5, 0x13e6, 0x13e7,
+    0x13e8, 0x13e9, 0x13ea, 0x13eb, 0x13ec, 0x13ed, 0x13ee, 0x13ef,
+    0xabed, 0x66, 0x66, 0x66, 0x69, 0x66, 0x6c, 0x66,
+    0x66, 0x69, 0x66, 0x66, 0x6c, 0x73, 0x74, 0x574,
+    0x576, 0x574, 0x565, 0x574, 0x56b, 0x57e, 0x576, 0x574,
+    0x56d, 0xfb1d, 0x5d9, 0xfb1e, 0xfb1f, 0x5f2, 0xfb2a, 0x5e9,
+    0xfb2b, 0xfb2c, 0xfb2d, 0xfb2e, 0x5d0, 0xfb2f, 0xfb30, 0xfb31,
+    0x5d1, 0xfb32, 0x5d2, 0xfb33, 0x5d3, 0xfb34, 0x5d4, 0xfb35,
+    0x5d5, 0xfb36, 0x5d6, 0xfb38, 0x5d8, 0xfb39, 0xfb3a, 0x5da,
+    0xfb3b, 0x5db, 0xfb3c, 0x5dc, 0xfb3e, 0x5de, 0xfb40, 0x5e0,
+    0xfb41, 0x5e1, 0xfb43, 0x5e3, 0xfb44, 0x5e4, 0xfb46, 0x5e6,
+    0xfb47, 0x5e7, 0xfb48, 0x5e8, 0xfb49, 0xfb4a, 0x5ea, 0xfb4b,
+    0xfb4c, 0xfb4d, 0xfb4e, 0xfe20, 0xfe21, 0xfe22, 0xfe23, 0xfe24,
+    0xfe25, 0xfe26, 0xfe27, 0xfe28, 0xfe29, 0xfe2a, 0xfe2b, 0xfe2c,
+    0xfe2d, 0xfe2e, 0xfe2f, 0xff41, 0xff42, 0xff43, 0xff44, 0xff45,
+    0xff46, 0xff47, 0xff48, 0xff49, 0xff4a, 0xff4b, 0xff4c, 0xff4d,
+    0xff4e, 0xff4f, 0xff50, 0xff51, 0xff52, 0xff53, 0xff54, 0xff55,
+    0xff56, 0xff57, 0xff58, 0xff59, 0xff5a, 0x101fd, 0x102e0, 0x10376,
+    0x10377, 0x10378, 0x10379, 0x1037a, 0x10428, 0x10429, 0x1042a, 0x1042b,
+    0x1042c, 0x1042d, 0x1042e, 0x1042f, 0x10430, 0x10431, 0x10432, 0x10433,
+    0x10434, 0x10435, 0x10436, 0x10437, 0x10438, 0x10439, 0x1043a, 0x1043b,
+    0x1043c, 0x1043d, 0x1043e, 0x1043f, 0x10440, 0x10441, 0x10442, 0x10443,
+    0x10444, 0x10445, 0x10446, 0x10447, 0x10448, 0x10449, 0x1044a, 0x1044b,
+    0x1044c, 0x1044d, 0x1044e, 0x1044f, 0x104d8, 0x104d9, 0x104da, 0x104db,
+    0x104dc, 0x104dd, 0x104de, 0x104df, 0x104e0, 0x104e1, 0x104e2, 0x104e3,
+    0x104e4, 0x104e5, 0x104e6, 0x104e7, 0x104e8, 0x104e9, 0x104ea, 0x104eb,
+    0x104ec, 0x104ed, 0x104ee, 0x104ef, 0x104f0, 0x104f1, 0x104f2, 0x104f3,
+    0x104f4, 0x104f5, 0x104f6, 0x104f7, 0x104f8, 0x104f9, 0x104fa, 0x104fb,
+    0x10597, 0x10598, 0x10599, 0x1059a, 0x1059b, 0x1059c, 0x1059d, 0x1059e,
+    0x1059f, 0x105a0, 0x105a1, 0x105a3, 0x105a4, 0x105a5, 0x105a6, 0x105a7,
+    0x105a8, 0x105a9, 0x105aa, 0x105ab, 0x105ac, 0x105ad, 0x105ae, 0x105af,
+    0x105b0, 0x105b1, 0x105b3, 0x105b4, 0x105b5, 0x105b6, 0x105b7, 0x105b8,
+    0x105b9, 0x105bb, 0x105bc, 0x10a0d, 0x10a0f, 0x10a38, 0x10a39, 0x10a3a,
+    0x10a3f, 0x10ae5, 0x10ae6, 0x10cc0, 0x10cc1, 0x10cc2, 0x10cc3, 0x10cc4,
+    0x10cc5, 0x10cc6, 0x10cc7, 0x10cc8, 0x10cc9, 0x10cca, 0x10ccb, 0x10ccc,
+    0x10ccd, 0x10cce, 0x10ccf, 0x10cd0, 0x10cd1, 0x10cd2, 0x10cd3, 0x10cd4,
+    0x10cd5, 0x10cd6, 0x10cd7, 0x10cd8, 0x10cd9, 0x10cda, 0x10cdb, 0x10cdc,
+    0x10cdd, 0x10cde, 0x10cdf, 0x10ce0, 0x10ce1, 0x10ce2, 0x10ce3, 0x10ce4,
+    0x10ce5, 0x10ce6, 0x10ce7, 0x10ce8, 0x10ce9, 0x10cea, 0x10ceb, 0x10cec,
+    0x10ced, 0x10cee, 0x10cef, 0x10cf0, 0x10cf1, 0x10cf2, 0x10d24, 0x10d25,
+    0x10d26, 0x10d27, 0x10eab, 0x10eac, 0x10f46, 0x10f47, 0x10f48, 0x10f49,
+    0x10f4a, 0x10f4b, 0x10f4c, 0x10f4d, 0x10f4e, 0x10f4f, 0x10f50, 0x10f82,
+    0x10f83, 0x10f84, 0x10f85, 0x11046, 0x11070, 0x1107f, 0x1109a, 0x11099,
+    0x1109c, 0x1109b, 0x110ab, 0x110a5, 0x110b9, 0x110ba, 0x11100, 0x11101,
+    0x11102, 0x11133, 0x11134, 0x11173, 0x111c0, 0x111ca, 0x11235, 0x11236,
+    0x112e9, 0x112ea, 0x1133b, 0x1133c, 0x1134d, 0x11366, 0x11367, 0x11368,
+    0x11369, 0x1136a, 0x1136b, 0x1136c, 0x11370, 0x11371, 0x11372, 0x11373,
+    0x11374, 0x11442, 0x11446, 0x1145e, 0x114c2, 0x114c3, 0x115bf, 0x115c0,
+    0x1163f, 0x116b6, 0x116b7, 0x1172b, 0x11839, 0x1183a, 0x118c0, 0x118c1,
+    0x118c2, 0x118c3, 0x118c4, 0x118c5, 0x118c6, 0x118c7, 0x118c8, 0x118c9,
+    0x118ca, 0x118cb, 0x118cc, 0x118cd, 0x118ce, 0x118cf, 0x118d0, 0x118d1,
+    0x118d2, 0x118d3, 0x118d4, 0x118d5, 0x118d6, 0x118d7, 0x118d8, 0x118d9,
+    0x118da, 0x118db, 0x118dc, 0x118dd, 0x118de, 0x118df, 0x1193d, 0x1193e,
+    0x11943, 0x119e0, 0x11a34, 0x11a47, 0x11a99, 0x11c3f, 0x11d42, 0x11d44,
+    0x11d45, 0x11d97, 0x16af0, 0x16af1, 0x16af2, 0x16af3, 0x16af4, 0x16b30,
+    0x16b31, 0x16b32, 0x16b33, 0x16b34, 0x16b35, 0x16b36, 0x16e60, 0x16e61,
+    0x16e62, 0x16e63, 0x16e64, 0x16e65, 0x16e66, 0x16e67, 0x16e68, 0x16e69,
+    0x16e6a, 0x16e6b, 0x16e6c, 0x16e6d, 0x16e6e, 0x16e6f, 0x16e70, 0x16e71,
+    0x16e72, 0x16e73, 0x16e74, 0x16e75, 0x16e76, 0x16e77, 0x16e78, 0x16e79,
+    0x16e7a, 0x16e7b, 0x16e7c, 0x16e7d, 0x16e7e, 0x16e7f, 0x16ff0, 0x16ff1,
+    0x1bc9e, 0x1d15e, 0x1d157, 0x1d15f, 0x1d158, 0x1d160, 0x1d161, 0x1d162,
+    0x1d163, 0x1d164, 0x1d165, 0x1d166, 0x1d167, 0x1d168, 0x1d169, 0x1d16d,
+    0x1d16e, 0x1d16f, 0x1d170, 0x1d171, 0x1d172, 0x1d17b, 0x1d17c, 0x1d17d,
+    0x1d17e, 0x1d17f, 0x1d180, 0x1d181, 0x1d182, 0x1d185, 0x1d186, 0x1d187,
+    0x1d188, 0x1d189, 0x1d18a, 0x1d18b, 0x1d1aa, 0x1d1ab, 0x1d1ac, 0x1d1ad,
+    0x1d1bb, 0x1d1b9, 0x1d1bc, 0x1d1ba, 0x1d1bd, 0x1d1be, 0x1d1bf, 0x1d1c0,
+    0x1d242, 0x1d243, 0x1d244, 0x1e000, 0x1e001, 0x1e002, 0x1e003, 0x1e004,
+    0x1e005, 0x1e006, 0x1e008, 0x1e009, 0x1e00a, 0x1e00b, 0x1e00c, 0x1e00d,
+    0x1e00e, 0x1e00f, 0x1e010, 0x1e011, 0x1e012, 0x1e013, 0x1e014, 0x1e015,
+    0x1e016, 0x1e017, 0x1e018, 0x1e01b, 0x1e01c, 0x1e01d, 0x1e01e, 0x1e01f,
+    0x1e020, 0x1e021, 0x1e023, 0x1e024, 0x1e026, 0x1e027, 0x1e028, 0x1e029,
+    0x1e02a, 0x1e130, 0x1e131, 0x1e132, 0x1e133, 0x1e134, 0x1e135, 0x1e136,
+    0x1e2ae, 0x1e2ec, 0x1e2ed, 0x1e2ee, 0x1e2ef, 0x1e8d0, 0x1e8d1, 0x1e8d2,
+    0x1e8d3, 0x1e8d4, 0x1e8d5, 0x1e8d6, 0x1e922, 0x1e923, 0x1e924, 0x1e925,
+    0x1e926, 0x1e927, 0x1e928, 0x1e929, 0x1e92a, 0x1e92b, 0x1e92c, 0x1e92d,
+    0x1e92e, 0x1e92f, 0x1e930, 0x1e931, 0x1e932, 0x1e933, 0x1e934, 0x1e935,
+    0x1e936, 0x1e937, 0x1e938, 0x1e939, 0x1e93a, 0x1e93b, 0x1e93c, 0x1e93d,
+    0x1e93e, 0x1e93f, 0x1e940, 0x1e941, 0x1e942, 0x1e943, 0x1e944, 0x1e945,
+    0x1e946, 0x1e947, 0x1e948, 0x1e949, 0x1e94a,
+};
+
+/* code points above 0x7f that casefold or noaccent change, in order */
+static const struct
+{
+  unsigned int codepoint;
+  unsigned short casefold, noaccent; /* offset in collation_mappings */
+  unsigned char casefoldlen, noaccentlen;
+} collation_entries[] = {
+    {0xb5, 0, 0, 1, 1},
+    {0xc0, 1, 2, 1, 1},
+    {0xc1, 3, 2, 1, 1},
+    {0xc2, 4, 2, 1, 1},
+    {0xc3, 5, 2, 1, 1},
+    {0xc4, 6, 2, 1, 1},
+    {0xc5, 7, 2, 1, 1},
+    {0xc6, 8, 8, 1, 1},
+    {0xc7, 9, 10, 1, 1},
+    {0xc8, 11, 12, 1, 1},
+    {0xc9, 13, 12, 1, 1},
+    {0xca, 14, 12, 1, 1},
+    {0xcb, 15, 12, 1, 1},
+    {0xcc, 16, 17, 1, 1},
+    {0xcd, 18, 17, 1, 1},
+    {0xce, 19, 17, 1, 1},
+    {0xcf, 20, 17, 1, 1},
+    {0xd0, 21, 21, 1, 1},
+    {0xd1, 22, 23, 1, 1},
+    {0xd2, 24, 25, 1, 1},
+    {0xd3, 26, 25, 1, 1},
+    {0xd4, 27, 25, 1, 1},
+    {0xd5, 28, 25, 1, 1},
+    {0xd6, 29, 25, 1, 1},
+    {0xd8, 30, 30, 1, 1},
+    {0xd9, 31, 32, 1, 1},
+    {0xda, 33, 32, 1, 1},
+    {0xdb, 34, 32, 1, 1},
+    {0xdc, 35, 32, 1, 1},
+    {0xdd, 36, 37, 1, 1},
+    {0xde, 38, 38, 1, 1},
+    {0xdf, 39, 39, 2, 2},
+    {0xe0, 1, 2, 1, 1},
+    {0xe1, 3, 2, 1, 1},
+    {0xe2, 4, 2, 1, 1},
+    {0xe3, 5, 2, 1, 1},
+    {0xe4, 6, 2, 1, 1},
+    {0xe5, 7, 2, 1, 1},
+    {0xe7, 9, 10, 1, 1},
+    {0xe8, 11, 12, 1, 1},
+    {0xe9, 13, 12, 1, 1},
+    {0xea, 14, 12, 1, 1},
+    {0xeb, 15, 12, 1, 1},
+    {0xec, 16, 17, 1, 1},
+    {0xed, 18, 17, 1, 1},
+    {0xee, 19, 17, 1, 1},
+    {0xef, 20, 17, 1, 1},
+    {0xf1, 22, 23, 1, 1},
+    {0xf2, 24, 25, 1, 1},
+    {0xf3, 26, 25, 1, 1},
+    {0xf4, 27, 25, 1, 1},
+    {0xf5, 28, 25, 1, 1},
+    {0xf6, 29, 25, 1, 1},
+    {0xf9, 31, 32, 1, 1},
+    {0xfa, 33, 32, 1, 1},
+    {0xfb, 34, 32, 1, 1},
+    {0xfc, 35, 32, 1, 1},
+    {0xfd, 36, 37, 1, 1},
+    {0xff, 41, 37, 1, 1},
+    {0x100, 42, 2, 1, 1},
+    {0x101, 42, 2, 1, 1},
+    {0x102, 43, 2, 1, 1},
+    {0x103, 43, 2, 1, 1},
+    {0x104, 44, 2, 1, 1},
+    {0x105, 44, 2, 1, 1},
+    {0x106, 45, 10, 1, 1},
+    {0x107, 45, 10, 1, 1},
+    {0x108, 46, 10, 1, 1},
+    {0x109, 46, 10, 1, 1},
+    {0x10a, 47, 10, 1, 1},
+    {0x10b, 47, 10, 1, 1},
+    {0x10c, 48, 10, 1, 1},
+    {0x10d, 48, 10, 1, 1},
+    {0x10e, 49, 50, 1, 1},
+    {0x10f, 49, 50, 1, 1},
+    {0x110, 51, 51, 1, 1},
+    {0x112, 52, 12, 1, 1},
+    {0x113, 52, 12, 1, 1},
+    {0x114, 53, 12, 1, 1},
+    {0x115, 53, 12, 1, 1},
+    {0x116, 54, 12, 1, 1},
+    {0x117, 54, 12, 1, 1},
+    {0x118, 55, 12, 1, 1},
+    {0x119, 55, 12, 1, 1},
+    {0x11a, 56, 12, 1, 1},
+    {0x11b, 56, 12, 1, 1},
+    {0x11c, 57, 58, 1, 1},
+    {0x11d, 57, 58, 1, 1},
+    {0x11e, 59, 58, 1, 1},
+    {0x11f, 59, 58, 1, 1},
+    {0x120, 60, 58, 1, 1},
+    {0x121, 60, 58, 1, 1},
+    {0x122, 61, 58, 1, 1},
+    {0x123, 61, 58, 1, 1},
+    {0x124, 62, 63, 1, 1},
+    {0x125, 62, 63, 1, 1},
+    {0x126, 64, 64, 1, 1},
+    {0x128, 65, 17, 1, 1},
+    {0x129, 65, 17, 1, 1},
+    {0x12a, 66, 17, 1, 1},
+    {0x12b, 66, 17, 1, 1},
+    {0x12c, 67, 17, 1, 1},
+    {0x12d, 67, 17, 1, 1},
+    {0x12e, 68, 17, 1, 1},
+    {0x12f, 68, 17, 1, 1},
+    {0x130, 69, 17, 2, 1},
+    {0x132, 71, 71, 1, 1},
+    {0x134, 72, 73, 1, 1},
+    {0x135, 72, 73, 1, 1},
+    {0x136, 74, 75, 1, 1},
+    {0x137, 74, 75, 1, 1},
+    {0x139, 76, 77, 1, 1},
+    {0x13a, 76, 77, 1, 1},
+    {0x13b, 78, 77, 1, 1},
+    {0x13c, 78, 77, 1, 1},
+    {0x13d, 79, 77, 1, 1},
+    {0x13e, 79, 77, 1, 1},
+    {0x13f, 80, 80, 1, 1},
+    {0x141, 81, 81, 1, 1},
+    {0x143, 82, 23, 1, 1},
+    {0x144, 82, 23, 1, 1},
+    {0x145, 83, 23, 1, 1},
+    {0x146, 83, 23, 1, 1},
+    {0x147, 84, 23, 1, 1},
+    {0x148, 84, 23, 1, 1},
+    {0x149, 85, 85, 2, 2},
+    {0x14a, 87, 87, 1, 1},
+    {0x14c, 88, 25, 1, 1},
+    {0x14d, 88, 25, 1, 1},
+    {0x14e, 89, 25, 1, 1},
+    {0x14f, 89, 25, 1, 1},
+    {0x150, 90, 25, 1, 1},
+    {0x151, 90, 25, 1, 1},
+    {0x152, 91, 91, 1, 1},
+    {0x154, 92, 93, 1, 1},
+    {0x155, 92, 93, 1, 1},
+    {0x156, 94, 93, 1, 1},
+    {0x157, 94, 93, 1, 1},
+    {0x158, 95, 93, 1, 1},
+    {0x159, 95, 93, 1, 1},
+    {0x15a, 96, 97, 1, 1},
+    {0x15b, 96, 97, 1, 1},
+    {0x15c, 98, 97, 1, 1},
+    {0x15d, 98, 97, 1, 1},
+    {0x15e, 99, 97, 1, 1},
+    {0x15f, 99, 97, 1, 1},
+    {0x160, 100, 97, 1, 1},
+    {0x161, 100, 97, 1, 1},
+    {0x162, 101, 102, 1, 1},
+    {0x163, 101, 102, 1, 1},
+    {0x164, 103, 102, 1, 1},
+    {0x165, 103, 102, 1, 1},
+    {0x166, 104, 104, 1, 1},
+    {0x168, 105, 32, 1, 1},
+    {0x169, 105, 32, 1, 1},
+    {0x16a, 106, 32, 1, 1},
+    {0x16b, 106, 32, 1, 1},
+    {0x16c, 107, 32, 1, 1},
+    {0x16d, 107, 32, 1, 1},
+    {0x16e, 108, 32, 1, 1},
+    {0x16f, 108, 32, 1, 1},
+    {0x170, 109, 32, 1, 1},
+    {0x171, 109, 32, 1, 1},
+    {0x172, 110, 32, 1, 1},
+    {0x173, 110, 32, 1, 1},
+    {0x174, 111, 112, 1, 1},
+    {0x175, 111, 112, 1, 1},
+    {0x176, 113, 37, 1, 1},
+    {0x177, 113, 37, 1, 1},
+    {0x178, 41, 37, 1, 1},
+    {0x179, 114, 115, 1, 1},
+    {0x17a, 114, 115, 1, 1},
+    {0x17b, 116, 115, 1, 1},
+    {0x17c, 116, 115, 1, 1},
+    {0x17d, 117, 115, 1, 1},
+    {0x17e, 117, 115, 1, 1},
+    {0x17f, 97, 97, 1, 1},
+    {0x181, 118, 118, 1, 1},
+    {0x182, 119, 119, 1, 1},
+    {0x184, 120, 120, 1, 1},
+    {0x186, 121, 121, 1, 1},
+    {0x187, 122, 122, 1, 1},
+    {0x189, 123, 123, 1, 1},
+    {0x18a, 124, 124, 1, 1},
+    {0x18b, 125, 125, 1, 1},
+    {0x18e, 126, 126, 1, 1},
+    {0x18f, 127, 127, 1, 1},
+    {0x190, 128, 128, 1, 1},
+    {0x191, 129, 129, 1, 1},
+    {0x193, 130, 130, 1, 1},
+    {0x194, 131, 131, 1, 1},
+    {0x196, 132, 132, 1, 1},
+    {0x197, 133, 133, 1, 1},
+    {0x198, 134, 134, 1, 1},
+    {0x19c, 135, 135, 1, 1},
+    {0x19d, 136, 136, 1, 1},
+    {0x19f, 137, 137, 1, 1},
+    {0x1a0, 138, 25, 1, 1},
+    {0x1a1, 138, 25, 1, 1},
+    {0x1a2, 139, 139, 1, 1},
+    {0x1a4, 140, 140, 1, 1},
+    {0x1a6, 141, 141, 1, 1},
+    {0x1a7, 142, 142, 1, 1},
+    {0x1a9, 143, 143, 1, 1},
+    {0x1ac, 144, 144, 1, 1},
+    {0x1ae, 145, 145, 1, 1},
+    {0x1af, 146, 32, 1, 1},
+    {0x1b0, 146, 32, 1, 1},
+    {0x1b1, 147, 147, 1, 1},
+    {0x1b2, 148, 148, 1, 1},
+    {0x1b3, 149, 149, 1, 1},
+    {0x1b5, 150, 150, 1, 1},
+    {0x1b7, 151, 151, 1, 1},
+    {0x1b8, 152, 152, 1, 1},
+    {0x1bc, 153, 153, 1, 1},
+    {0x1c4, 154, 154, 1, 1},
+    {0x1c5, 154, 154, 1, 1},
+    {0x1c7, 155, 155, 1, 1},
+    {0x1c8, 155, 155, 1, 1},
+    {0x1ca, 156, 156, 1, 1},
+    {0x1cb, 156, 156, 1, 1},
+    {0x1cd, 157, 2, 1, 1},
+    {0x1ce, 157, 2, 1, 1},
+    {0x1cf, 158, 17, 1, 1},
+    {0x1d0, 158, 17, 1, 1},
+    {0x1d1, 159, 25, 1, 1},
+    {0x1d2, 159, 25, 1, 1},
+    {0x1d3, 160, 32, 1, 1},
+    {0x1d4, 160, 32, 1, 1},
+    {0x1d5, 161, 32, 1, 1},
+    {0x1d6, 161, 32, 1, 1},
+    {0x1d7, 162, 32, 1, 1},
+    {0x1d8, 162, 32, 1, 1},
+    {0x1d9, 163, 32, 1, 1},
+    {0x1da, 163, 32, 1, 1},
+    {0x1db, 164, 32, 1, 1},
+    {0x1dc, 164, 32, 1, 1},
+    {0x1de, 165, 2, 1, 1},
+    {0x1df, 165, 2, 1, 1},
+    {0x1e0, 166, 2, 1, 1},
+    {0x1e1, 166, 2, 1, 1},
+    {0x1e2, 167, 8, 1, 1},
+    {0x1e3, 167, 8, 1, 1},
+    {0x1e4, 168, 168, 1, 1},
+    {0x1e6, 169, 58, 1, 1},
+    {0x1e7, 169, 58, 1, 1},
+    {0x1e8, 170, 75, 1, 1},
+    {0x1e9, 170, 75, 1, 1},
+    {0x1ea, 171, 25, 1, 1},
+    {0x1eb, 171, 25, 1, 1},
+    {0x1ec, 172, 25, 1, 1},
+    {0x1ed, 172, 25, 1, 1},
+    {0x1ee, 173, 151, 1, 1},
+    {0x1ef, 173, 151, 1, 1},
+    {0x1f0, 174, 73, 2, 1},
+    {0x1f1, 176, 176, 1, 1},
+    {0x1f2, 176, 176, 1, 1},
+    {0x1f4, 177, 58, 1, 1},
+    {0x1f5, 177, 58, 1, 1},
+    {0x1f6, 178, 178, 1, 1},
+    {0x1f7, 179, 179, 1, 1},
+    {0x1f8, 180, 23, 1, 1},
+    {0x1f9, 180, 23, 1, 1},
+    {0x1fa, 181, 2, 1, 1},
+    {0x1fb, 181, 2, 1, 1},
+    {0x1fc, 182, 8, 1, 1},
+    {0x1fd, 182, 8, 1, 1},
+    {0x1fe, 183, 30, 1, 1},
+    {0x1ff, 183, 30, 1, 1},
+    {0x200, 184, 2, 1, 1},
+    {0x201, 184, 2, 1, 1},
+    {0x202, 185, 2, 1, 1},
+    {0x203, 185, 2, 1, 1},
+    {0x204, 186, 12, 1, 1},
+    {0x205, 186, 12, 1, 1},
+    {0x206, 187, 12, 1, 1},
+    {0x207, 187, 12, 1, 1},
+    {0x208, 188, 17, 1, 1},
+    {0x209, 188, 17, 1, 1},
+    {0x20a, 189, 17, 1, 1},
+    {0x20b, 189, 17, 1, 1},
+    {0x20c, 190, 25, 1, 1},
+    {0x20d, 190, 25, 1, 1},
+    {0x20e, 191, 25, 1, 1},
+    {0x20f, 191, 25, 1, 1},
+    {0x210, 192, 93, 1, 1},
+    {0x211, 192, 93, 1, 1},
+    {0x212, 193, 93, 1, 1},
+    {0x213, 193, 93, 1, 1},
+    {0x214, 194, 32, 1, 1},
+    {0x215, 194, 32, 1, 1},
+    {0x216, 195, 32, 1, 1},
+    {0x217, 195, 32, 1, 1},
+    {0x218, 196, 97, 1, 1},
+    {0x219, 196, 97, 1, 1},
+    {0x21a, 197, 102, 1, 1},
+    {0x21b, 197, 102, 1, 1},
+    {0x21c, 198, 198, 1, 1},
+    {0x21e, 199, 63, 1, 1},
+    {0x21f, 199, 63, 1, 1},
+    {0x220, 200, 200, 1, 1},
+    {0x222, 201, 201, 1, 1},
+    {0x224, 202, 202, 1, 1},
+    {0x226, 203, 2, 1, 1},
+    {0x227, 203, 2, 1, 1},
+    {0x228, 204, 12, 1, 1},
+    {0x229, 204, 12, 1, 1},
+    {0x22a, 205, 25, 1, 1},
+    {0x22b, 205, 25, 1, 1},
+    {0x22c, 206, 25, 1, 1},
+    {0x22d, 206, 25, 1, 1},
+    {0x22e, 207, 25, 1, 1},
+    {0x22f, 207, 25, 1, 1},
+    {0x230, 208, 25, 1, 1},
+    {0x231, 208, 25, 1, 1},
+    {0x232, 209, 37, 1, 1},
+    {0x233, 209, 37, 1, 1},
+    {0x23a, 210, 210, 1, 1},
+    {0x23b, 211, 211, 1, 1},
+    {0x23d, 212, 212, 1, 1},
+    {0x23e, 213, 213, 1, 1},
+    {0x241, 214, 214, 1, 1},
+    {0x243, 215, 215, 1, 1},
+    {0x244, 216, 216, 1, 1},
+    {0x245, 217, 217, 1, 1},
+    {0x246, 218, 218, 1, 1},
+    {0x248, 219, 219, 1, 1},
+    {0x24a, 220, 220, 1, 1},
+    {0x24c, 221, 221, 1, 1},
+    {0x24e, 222, 222, 1, 1},
+    {0x300, 223, 224, 1, 0},
+    {0x301, 224, 224, 1, 0},
+    {0x302, 225, 224, 1, 0},
+    {0x303, 226, 224, 1, 0},
+    {0x304, 227, 224, 1, 0},
+    {0x305, 228, 224, 1, 0},
+    {0x306, 229, 224, 1, 0},
+    {0x307, 230, 224, 1, 0},
+    {0x308, 231, 224, 1, 0},
+    {0x309, 232, 224, 1, 0},
+    {0x30a, 233, 224, 1, 0},
+    {0x30b, 234, 224, 1, 0},
+    {0x30c, 235, 224, 1, 0},
+    {0x30d, 236, 224, 1, 0},
+    {0x30e, 237, 224, 1, 0},
+    {0x30f, 238, 224, 1, 0},
+    {0x310, 239, 224, 1, 0},
+    {0x311, 240, 224, 1, 0},
+    {0x312, 241, 224, 1, 0},
+    {0x313, 242, 224, 1, 0},
+    {0x314, 243, 224, 1, 0},
+    {0x315, 244, 224, 1, 0},
+    {0x316, 245, 224, 1, 0},
+    {0x317, 246, 224, 1, 0},
+    {0x318, 247, 224, 1, 0},
+    {0x319, 248, 224, 1, 0},
+    {0x31a, 249, 224, 1, 0},
+    {0x31b, 250, 224, 1, 0},
+    {0x31c, 251, 224, 1, 0},
+    {0x31d, 252, 224, 1, 0},
+    {0x31e, 253, 224, 1, 0},
+    {0x31f, 254, 224, 1, 0},
+    {0x320, 255, 224, 1, 0},
+    {0x321, 256, 224, 1, 0},
+    {0x322, 257, 224, 1, 0},
+    {0x323, 258, 224, 1, 0},
+    {0x324, 259, 224, 1, 0},
+    {0x325, 260, 224, 1, 0},
+    {0x326, 261, 224, 1, 0},
+    {0x327, 262, 224, 1, 0},
+    {0x328, 263, 224, 1, 0},
+    {0x329, 264, 224, 1, 0},
+    {0x32a, 265, 224, 1, 0},
+    {0x32b, 266, 224, 1, 0},
+    {0x32c, 267, 224, 1, 0},
+    {0x32d, 268, 224, 1, 0},
+    {0x32e, 269, 224, 1, 0},
+    {0x32f, 270, 224, 1, 0},
+    {0x330, 271, 224, 1, 0},
+    {0x331, 272, 224, 1, 0},
+    {0x332, 273, 224, 1, 0},
+    {0x333, 274, 224, 1, 0},
+    {0x334, 275, 224, 1, 0},
+    {0x335, 276, 224, 1, 0},
+    {0x336, 277, 224, 1, 0},
+    {0x337, 278, 224, 1, 0},
+    {0x338, 279, 224, 1, 0},
+    {0x339, 280, 224, 1, 0},
+    {0x33a, 281, 224, 1, 0},
+    {0x33b, 282, 224, 1, 0},
+    {0x33c, 283, 224, 1, 0},
+    {0x33d, 284, 224, 1, 0},
+    {0x33e, 285, 224, 1, 0},
+    {0x33f, 286, 224, 1, 0},
+    {0x340, 287, 224, 1, 0},
+    {0x341, 288, 224, 1, 0},
+    {0x342, 289, 224, 1, 0},
+    {0x343, 290, 224, 1, 0},
+    {0x344, 291, 224, 1, 0},
+    {0x345, 292, 292, 1, 1},
+    {0x346, 293, 224, 1, 0},
+    {0x347, 294, 224, 1, 0},
+    {0x348, 295, 224, 1, 0},
+    {0x349, 296, 224, 1, 0},
+    {0x34a, 297, 224, 1, 0},
+    {0x34b, 298, 224, 1, 0},
+    {0x34c, 299, 224, 1, 0},
+    {0x34d, 300, 224, 1, 0},
+    {0x34e, 301, 224, 1, 0},
+    {0x350, 302, 224, 1, 0},
+    {0x351, 303, 224, 1, 0},
+    {0x352, 304, 224, 1, 0},
+    {0x353, 305, 224, 1, 0},
+    {0x354, 306, 224, 1, 0},
+    {0x355, 307, 224, 1, 0},
+    {0x356, 308, 224, 1, 0},
+    {0x357, 309, 224, 1, 0},
+    {0x358, 310, 224, 1, 0},
+    {0x359, 311, 224, 1, 0},
+    {0x35a, 312, 224, 1, 0},
+    {0x35b, 313, 224, 1, 0},
+    {0x35c, 314, 224, 1, 0},
+    {0x35d, 315, 224, 1, 0},
+    {0x35e, 316, 224, 1, 0},
+    {0x35f, 317, 224, 1, 0},
+    {0x360, 318, 224, 1, 0},
+    {0x361, 319, 224, 1, 0},
+    {0x362, 320, 224, 1, 0},
+    {0x363, 321, 224, 1, 0},
+    {0x364, 322, 224, 1, 0},
+    {0x365, 323, 224, 1, 0},
+    {0x366, 324, 224, 1, 0},
+    {0x367, 325, 224, 1, 0},
+    {0x368, 326, 224, 1, 0},
+    {0x369, 327, 224, 1, 0},
+    {0x36a, 328, 224, 1, 0},
+    {0x36b, 329, 224, 1, 0},
+    {0x36c, 330, 224, 1, 0},
+    {0x36d, 331, 224, 1, 0},
+    {0x36e, 332, 224, 1, 0},
+    {0x36f, 333, 224, 1, 0},
+    {0x370, 334, 334, 1, 1},
+    {0x372, 335, 335, 1, 1},
+    {0x376, 336, 336, 1, 1},
+    {0x37f, 337, 337, 1, 1},
+    {0x385, 338, 339, 1, 1},
+    {0x386, 340, 341, 1, 1},
+    {0x388, 342, 343, 1, 1},
+    {0x389, 344, 345, 1, 1},
+    {0x38a, 346, 292, 1, 1},
+    {0x38c, 347, 348, 1, 1},
+    {0x38e, 349, 350, 1, 1},
+    {0x38f, 351, 352, 1, 1},
+    {0x390, 353, 292, 3, 1},
+    {0x391, 341, 341, 1, 1},
+    {0x392, 356, 356, 1, 1},
+    {0x393, 357, 357, 1, 1},
+    {0x394, 358, 358, 1, 1},
+    {0x395, 343, 343, 1, 1},
+    {0x396, 359, 359, 1, 1},
+    {0x397, 345, 345, 1, 1},
+    {0x398, 360, 360, 1, 1},
+    {0x399, 292, 292, 1, 1},
+    {0x39a, 361, 361, 1, 1},
+    {0x39b, 362, 362, 1, 1},
+    {0x39c, 0, 0, 1, 1},
+    {0x39d, 363, 363, 1, 1},
+    {0x39e, 364, 364, 1, 1},
+    {0x39f, 348, 348, 1, 1},
+    {0x3a0, 365, 365, 1, 1},
+    {0x3a1, 366, 366, 1, 1},
+    {0x3a3, 367, 367, 1, 1},
+    {0x3a4, 368, 368, 1, 1},
+    {0x3a5, 350, 350, 1, 1},
+    {0x3a6, 369, 369, 1, 1},
+    {0x3a7, 370, 370, 1, 1},
+    {0x3a8, 371, 371, 1, 1},
+    {0x3a9, 352, 352, 1, 1},
+    {0x3aa, 372, 292, 1, 1},
+    {0x3ab, 373, 350, 1, 1},
+    {0x3ac, 340, 341, 1, 1},
+    {0x3ad, 342, 343, 1, 1},
+    {0x3ae, 344, 345, 1, 1},
+    {0x3af, 346, 292, 1, 1},
+    {0x3b0, 374, 350, 3, 1},
+    {0x3c2, 367, 367, 1, 1},
+    {0x3ca, 372, 292, 1, 1},
+    {0x3cb, 373, 350, 1, 1},
+    {0x3cc, 347, 348, 1, 1},
+    {0x3cd, 349, 350, 1, 1},
+    {0x3ce, 351, 352, 1, 1},
+    {0x3cf, 377, 377, 1, 1},
+    {0x3d0, 356, 356, 1, 1},
+    {0x3d1, 360, 360, 1, 1},
+    {0x3d3, 378, 379, 1, 1},
+    {0x3d4, 380, 379, 1, 1},
+    {0x3d5, 369, 369, 1, 1},
+    {0x3d6, 365, 365, 1, 1},
+    {0x3d8, 381, 381, 1, 1},
+    {0x3da, 382, 382, 1, 1},
+    {0x3dc, 383, 383, 1, 1},
+    {0x3de, 384, 384, 1, 1},
+    {0x3e0, 385, 385, 1, 1},
+    {0x3e2, 386, 386, 1, 1},
+    {0x3e4, 387, 387, 1, 1},
+    {0x3e6, 388, 388, 1, 1},
+    {0x3e8, 389, 389, 1, 1},
+    {0x3ea, 390, 390, 1, 1},
+    {0x3ec, 391, 391, 1, 1},
+    {0x3ee, 392, 392, 1, 1},
+    {0x3f0, 361, 361, 1, 1},
+    {0x3f1, 366, 366, 1, 1},
+    {0x3f4, 360, 360, 1, 1},
+    {0x3f5, 343, 343, 1, 1},
+    {0x3f7, 393, 393, 1, 1},
+    {0x3f9, 394, 394, 1, 1},
+    {0x3fa, 395, 395, 1, 1},
+    {0x3fd, 396, 396, 1, 1},
+    {0x3fe, 397, 397, 1, 1},
+    {0x3ff, 398, 398, 1, 1},
+    {0x400, 399, 400, 1, 1},
+    {0x401, 401, 400, 1, 1},
+    {0x402, 402, 402, 1, 1},
+    {0x403, 403, 404, 1, 1},
+    {0x404, 405, 405, 1, 1},
+    {0x405, 406, 406, 1, 1},
+    {0x406, 407, 407, 1, 1},
+    {0x407, 408, 407, 1, 1},
+    {0x408, 409, 409, 1, 1},
+    {0x409, 410, 410, 1, 1},
+    {0x40a, 411, 411, 1, 1},
+    {0x40b, 412, 412, 1, 1},
+    {0x40c, 413, 414, 1, 1},
+    {0x40d, 415, 416, 1, 1},
+    {0x40e, 417, 418, 1, 1},
+    {0x40f, 419, 419, 1, 1},
+    {0x410, 420, 420, 1, 1},
+    {0x411, 421, 421, 1, 1},
+    {0x412, 422, 422, 1, 1},
+    {0x413, 404, 404, 1, 1},
+    {0x414, 423, 423, 1, 1},
+    {0x415, 400, 400, 1, 1},
+    {0x416, 424, 424, 1, 1},
+    {0x417, 425, 425, 1, 1},
+    {0x418, 416, 416, 1, 1},
+    {0x419, 426, 416, 1, 1},
+    {0x41a, 414, 414, 1, 1},
+    {0x41b, 427, 427, 1, 1},
+    {0x41c, 428, 428, 1, 1},
+    {0x41d, 429, 429, 1, 1},
+    {0x41e, 430, 430, 1, 1},
+    {0x41f, 431, 431, 1, 1},
+    {0x420, 432, 432, 1, 1},
+    {0x421, 433, 433, 1, 1},
+    {0x422, 434, 434, 1, 1},
+    {0x423, 418, 418, 1, 1},
+    {0x424, 435, 435, 1, 1},
+    {0x425, 436, 436, 1, 1},
+    {0x426, 437, 437, 1, 1},
+    {0x427, 438, 438, 1, 1},
+    {0x428, 439, 439, 1, 1},
+    {0x429, 440, 440, 1, 1},
+    {0x42a, 441, 441, 1, 1},
+    {0x42b, 442, 442, 1, 1},
+    {0x42c, 443, 443, 1, 1},
+    {0x42d, 444, 444, 1, 1},
+    {0x42e, 445, 445, 1, 1},
+    {0x42f, 446, 446, 1, 1},
+    {0x439, 426, 416, 1, 1},
+    {0x450, 399, 400, 1, 1},
+    {0x451, 401, 400, 1, 1},
+    {0x453, 403, 404, 1, 1},
+    {0x457, 408, 407, 1, 1},
+    {0x45c, 413, 414, 1, 1},
+    {0x45d, 415, 416, 1, 1},
+    {0x45e, 417, 418, 1, 1},
+    {0x460, 447, 447, 1, 1},
+    {0x462, 448, 448, 1, 1},
+    {0x464, 449, 449, 1, 1},
+    {0x466, 450, 450, 1, 1},
+    {0x468, 451, 451, 1, 1},
+    {0x46a, 452, 452, 1, 1},
+    {0x46c, 453, 453, 1, 1},
+    {0x46e, 454, 454, 1, 1},
+    {0x470, 455, 455, 1, 1},
+    {0x472, 456, 456, 1, 1},
+    {0x474, 457, 457, 1, 1},
+    {0x476, 458, 457, 1, 1},
+    {0x477, 458, 457, 1, 1},
+    {0x478, 459, 459, 1, 1},
+    {0x47a, 460, 460, 1, 1},
+    {0x47c, 461, 461, 1, 1},
+    {0x47e, 462, 462, 1, 1},
+    {0x480, 463, 463, 1, 1},
+    {0x483, 464, 224, 1, 0},
+    {0x484, 465, 224, 1, 0},
+    {0x485, 466, 224, 1, 0},
+    {0x486, 467, 224, 1, 0},
+    {0x487, 468, 224, 1, 0},
+    {0x48a, 469, 469, 1, 1},
+    {0x48c, 470, 470, 1, 1},
+    {0x48e, 471, 471, 1, 1},
+    {0x490, 472, 472, 1, 1},
+    {0x492, 473, 473, 1, 1},
+    {0x494, 474, 474, 1, 1},
+    {0x496, 475, 475, 1, 1},
+    {0x498, 476, 476, 1, 1},
+    {0x49a, 477, 477, 1, 1},
+    {0x49c, 478, 478, 1, 1},
+    {0x49e, 479, 479, 1, 1},
+    {0x4a0, 480, 480, 1, 1},
+    {0x4a2, 481, 481, 1, 1},
+    {0x4a4, 482, 482, 1, 1},
+    {0x4a6, 483, 483, 1, 1},
+    {0x4a8, 484, 484, 1, 1},
+    {0x4aa, 485, 485, 1, 1},
+    {0x4ac, 486, 486, 1, 1},
+    {0x4ae, 487, 487, 1, 1},
+    {0x4b0, 488, 488, 1, 1},
+    {0x4b2, 489, 489, 1, 1},
+    {0x4b4, 490, 490, 1, 1},
+    {0x4b6, 491, 491, 1, 1},
+    {0x4b8, 492, 492, 1, 1},
+    {0x4ba, 493, 493, 1, 1},
+    {0x4bc, 494, 494, 1, 1},
+    {0x4be, 495, 495, 1, 1},
+    {0x4c0, 496, 496, 1, 1},
+    {0x4c1, 497, 424, 1, 1},
+    {0x4c2, 497, 424, 1, 1},
+    {0x4c3, 498, 498, 1, 1},
+    {0x4c5, 499, 499, 1, 1},
+    {0x4c7, 500, 500, 1, 1},
+    {0x4c9, 501, 501, 1, 1},
+    {0x4cb, 502, 502, 1, 1},
+    {0x4cd, 503, 503, 1, 1},
+    {0x4d0, 504, 420, 1, 1},
+    {0x4d1, 504, 420, 1, 1},
+    {0x4d2, 505, 420, 1, 1},
+    {0x4d3, 505, 420, 1, 1},
+    {0x4d4, 506, 506, 1, 1},
+    {0x4d6, 507, 400, 1, 1},
+    {0x4d7, 507, 400, 1, 1},
+    {0x4d8, 508, 508, 1, 1},
+    {0x4da, 509, 508, 1, 1},
+    {0x4db, 509, 508, 1, 1},
+    {0x4dc, 510, 424, 1, 1},
+    {0x4dd, 510, 424, 1, 1},
+    {0x4de, 511, 425, 1, 1},
+    {0x4df, 511, 425, 1, 1},
+    {0x4e0, 512, 512, 1, 1},
+    {0x4e2, 513, 416, 1, 1},
+    {0x4e3, 513, 416, 1, 1},
+    {0x4e4, 514, 416, 1, 1},
+    {0x4e5, 514, 416, 1, 1},
+    {0x4e6, 515, 430, 1, 1},
+    {0x4e7, 515, 430, 1, 1},
+    {0x4e8, 516, 516, 1, 1},
+    {0x4ea, 517, 516, 1, 1},
+    {0x4eb, 517, 516, 1, 1},
+    {0x4ec, 518, 444, 1, 1},
+    {0x4ed, 518, 444, 1, 1},
+    {0x4ee, 519, 418, 1, 1},
+    {0x4ef, 519, 418, 1, 1},
+    {0x4f0, 520, 418, 1, 1},
+    {0x4f1, 520, 418, 1, 1},
+    {0x4f2, 521, 418, 1, 1},
+    {0x4f3, 521, 418, 1, 1},
+    {0x4f4, 522, 438, 1, 1},
+    {0x4f5, 522, 438, 1, 1},
+    {0x4f6, 523, 523, 1, 1},
+    {0x4f8, 524, 442, 1, 1},
+    {0x4f9, 524, 442, 1, 1},
+    {0x4fa, 525, 525, 1, 1},
+    {0x4fc, 526, 526, 1, 1},
+    {0x4fe, 527, 527, 1, 1},
+    {0x500, 528, 528, 1, 1},
+    {0x502, 529, 529, 1, 1},
+    {0x504, 530, 530, 1, 1},
+    {0x506, 531, 531, 1, 1},
+    {0x508, 532, 532, 1, 1},
+    {0x50a, 533, 533, 1, 1},
+    {0x50c, 534, 534, 1, 1},
+    {0x50e, 535, 535, 1, 1},
+    {0x510, 536, 536, 1, 1},
+    {0x512, 537, 537, 1, 1},
+    {0x514, 538, 538, 1, 1},
+    {0x516, 539, 539, 1, 1},
+    {0x518, 540, 540, 1, 1},
+    {0x51a, 541, 541, 1, 1},
+    {0x51c, 542, 542, 1, 1},
+    {0x51e, 543, 543, 1, 1},
+    {0x520, 544, 544, 1, 1},
+    {0x522, 545, 545, 1, 1},
+    {0x524, 546, 546, 1, 1},
+    {0x526, 547, 547, 1, 1},
+    {0x528, 548, 548, 1, 1},
+    {0x52a, 549, 549, 1, 1},
+    {0x52c, 550, 550, 1, 1},
+    {0x52e, 551, 551, 1, 1},
+    {0x531, 552, 552, 1, 1},
+    {0x532, 553, 553, 1, 1},
+    {0x533, 554, 554, 1, 1},
+    {0x534, 555, 555, 1, 1},
+    {0x535, 556, 556, 1, 1},
+    {0x536, 557, 557, 1, 1},
+    {0x537, 558, 558, 1, 1},
+    {0x538, 559, 559, 1, 1},
+    {0x539, 560, 560, 1, 1},
+    {0x53a, 561, 561, 1, 1},
+    {0x53b, 562, 562, 1, 1},
+    {0x53c, 563, 563, 1, 1},
+    {0x53d, 564, 564, 1, 1},
+    {0x53e, 565, 565, 1, 1},
+    {0x53f, 566, 566, 1, 1},
+    {0x540, 567, 567, 1, 1},
+    {0x541, 568, 568, 1, 1},
+    {0x542, 569, 569, 1, 1},
+    {0x543, 570, 570, 1, 1},
+    {0x544, 571, 571, 1, 1},
+    {0x545, 572, 572, 1, 1},
+    {0x546, 573, 573, 1, 1},
+    {0x547, 574, 574, 1, 1},
+    {0x548, 575, 575, 1, 1},
+    {0x549, 576, 576, 1, 1},
+    {0x54a, 577, 577, 1, 1},
+    {0x54b, 578, 578, 1, 1},
+    {0x54c, 579, 579, 1, 1},
+    {0x54d, 580, 580, 1, 1},
+    {0x54e, 581, 581, 1, 1},
+    {0x54f, 582, 582, 1, 1},
+    {0x550, 583, 583, 1, 1},
+    {0x551, 584, 584, 1, 1},
+    {0x552, 585, 585, 1, 1},
+    {0x553, 586, 586, 1, 1},
+    {0x554, 587, 587, 1, 1},
+    {0x555, 588, 588, 1, 1},
+    {0x556, 589, 589, 1, 1},
+    {0x587, 590, 590, 2, 2},
+    {0x591, 592, 224, 1, 0},
+    {0x592, 593, 224, 1, 0},
+    {0x593, 594, 224, 1, 0},
+    {0x594, 595, 224, 1, 0},
+    {0x595, 596, 224, 1, 0},
+    {0x596, 597, 224, 1, 0},
+    {0x597, 598, 224, 1, 0},
+    {0x598, 599, 224, 1, 0},
+    {0x599, 600, 224, 1, 0},
+    {0x59a, 601, 224, 1, 0},
+    {0x59b, 602, 224, 1, 0},
+    {0x59c, 603, 224, 1, 0},
+    {0x59d, 604, 224, 1, 0},
+    {0x59e, 605, 224, 1, 0},
+    {0x59f, 606, 224, 1, 0},
+    {0x5a0, 607, 224, 1, 0},
+    {0x5a1, 608, 224, 1, 0},
+    {0x5a2, 609, 224, 1, 0},
+    {0x5a3, 610, 224, 1, 0},
+    {0x5a4, 611, 224, 1, 0},
+    {0x5a5, 612, 224, 1, 0},
+    {0x5a6, 613, 224, 1, 0},
+    {0x5a7, 614, 224, 1, 0},
+    {0x5a8, 615, 224, 1, 0},
+    {0x5a9, 616, 224, 1, 0},
+    {0x5aa, 617, 224, 1, 0},
+    {0x5ab, 618, 224, 1, 0},
+    {0x5ac, 619, 224, 1, 0},
+    {0x5ad, 620, 224, 1, 0},
+    {0x5ae, 621, 224, 1, 0},
+    {0x5af, 622, 224, 1, 0},
+    {0x5b0, 623, 224, 1, 0},
+    {0x5b1, 624, 224, 1, 0},
+    {0x5b2, 625, 224, 1, 0},
+    {0x5b3, 626, 224, 1, 0},
+    {0x5b4, 627, 224, 1, 0},
+    {0x5b5, 628, 224, 1, 0},
+    {0x5b6, 629, 224, 1, 0},
+    {0x5b7, 630, 224, 1, 0},
+    {0x5b8, 631, 224, 1, 0},
+    {0x5b9, 632, 224, 1, 0},
+    {0x5ba, 633, 224, 1, 0},
+    {0x5bb, 634, 224, 1, 0},
+    {0x5bc, 635, 224, 1, 0},
+    {0x5bd, 636, 224, 1, 0},
+    {0x5bf, 637, 224, 1, 0},
+    {0x5c1, 638, 224, 1, 0},
+    {0x5c2, 639, 224, 1, 0},
+    {0x5c4, 640, 224, 1, 0},
+    {0x5c5, 641, 224, 1, 0},
+    {0x5c7, 642, 224, 1, 0},
+    {0x610, 643, 224, 1, 0},
+    {0x611, 644, 224, 1, 0},
+    {0x612, 645, 224, 1, 0},
+    {0x613, 646, 224, 1, 0},
+    {0x614, 647, 224, 1, 0},
+    {0x615, 648, 224, 1, 0},
+    {0x616, 649, 224, 1, 0},
+    {0x617, 650, 224, 1, 0},
+    {0x618, 651, 224, 1, 0},
+    {0x619, 652, 224, 1, 0},
+    {0x61a, 653, 224, 1, 0},
+    {0x622, 654, 655, 1, 1},
+    {0x623, 656, 655, 1, 1},
+    {0x624, 657, 658, 1, 1},
+    {0x625, 659, 655, 1, 1},
+    {0x626, 660, 661, 1, 1},
+    {0x64b, 662, 224, 1, 0},
+    {0x64c, 663, 224, 1, 0},
+    {0x64d, 664, 224, 1, 0},
+    {0x64e, 665, 224, 1, 0},
+    {0x64f, 666, 224, 1, 0},
+    {0x650, 667, 224, 1, 0},
+    {0x651, 668, 224, 1, 0},
+    {0x652, 669, 224, 1, 0},
+    {0x653, 670, 224, 1, 0},
+    {0x654, 671, 224, 1, 0},
+    {0x655, 672, 224, 1, 0},
+    {0x656, 673, 224, 1, 0},
+    {0x657, 674, 224, 1, 0},
+    {0x658, 675, 224, 1, 0},
+    {0x659, 676, 224, 1, 0},
+    {0x65a, 677, 224, 1, 0},
+    {0x65b, 678, 224, 1, 0},
+    {0x65c, 679, 224, 1, 0},
+    {0x65d, 680, 224, 1, 0},
+    {0x65e, 681, 224, 1, 0},
+    {0x65f, 682, 224, 1, 0},
+    {0x670, 683, 224, 1, 0},
+    {0x6c0, 684, 685, 1, 1},
+    {0x6c2, 686, 687, 1, 1},
+    {0x6d3, 688, 689, 1, 1},
+    {0x6d6, 690, 224, 1, 0},
+    {0x6d7, 691, 224, 1, 0},
+    {0x6d8, 692, 224, 1, 0},
+    {0x6d9, 693, 224, 1, 0},
+    {0x6da, 694, 224, 1, 0},
+    {0x6db, 695, 224, 1, 0},
+    {0x6dc, 696, 224, 1, 0},
+    {0x6df, 697, 224, 1, 0},
+    {0x6e0, 698, 224, 1, 0},
+    {0x6e1, 699, 224, 1, 0},
+    {0x6e2, 700, 224, 1, 0},
+    {0x6e3, 701, 224, 1, 0},
+    {0x6e4, 702, 224, 1, 0},
+    {0x6e7, 703, 224, 1, 0},
+    {0x6e8, 704, 224, 1, 0},
+    {0x6ea, 705, 224, 1, 0},
+    {0x6eb, 706, 224, 1, 0},
+    {0x6ec, 707, 224, 1, 0},
+    {0x6ed, 708, 224, 1, 0},
+    {0x711, 709, 224, 1, 0},
+    {0x730, 710, 224, 1, 0},
+    {0x731, 711, 224, 1, 0},
+    {0x732, 712, 224, 1, 0},
+    {0x733, 713, 224, 1, 0},
+    {0x734, 714, 224, 1, 0},
+    {0x735, 715, 224, 1, 0},
+    {0x736, 716, 224, 1, 0},
+    {0x737, 717, 224, 1, 0},
+    {0x738, 718, 224, 1, 0},
+    {0x739, 719, 224, 1, 0},
+    {0x73a, 720, 224, 1, 0},
+    {0x73b, 721, 224, 1, 0},
+    {0x73c, 722, 224, 1, 0},
+    {0x73d, 723, 224, 1, 0},
+    {0x73e, 724, 224, 1, 0},
+    {0x73f, 725, 224, 1, 0},
+    {0x740, 726, 224, 1, 0},
+    {0x741, 727, 224, 1, 0},
+    {0x742, 728, 224, 1, 0},
+    {0x743, 729, 224, 1, 0},
+    {0x744, 730, 224, 1, 0},
+    {0x745, 731, 224, 1, 0},
+    {0x746, 732, 224, 1, 0},
+    {0x747, 733, 224, 1, 0},
+    {0x748, 734, 224, 1, 0},
+    {0x749, 735, 224, 1, 0},
+    {0x74a, 736, 224, 1, 0},
+    {0x7eb, 737, 224, 1, 0},
+    {0x7ec, 738, 224, 1, 0},
+    {0x7ed, 739, 224, 1, 0},
+    {0x7ee, 740, 224, 1, 0},
+    {0x7ef, 741, 224, 1, 0},
+    {0x7f0, 742, 224, 1, 0},
+    {0x7f1, 743, 224, 1, 0},
+    {0x7f2, 744, 224, 1, 0},
+    {0x7f3, 745, 224, 1, 0},
+    {0x7fd, 746, 224, 1, 0},
+    {0x816, 747, 224, 1, 0},
+    {0x817, 748, 224, 1, 0},
+    {0x818, 749, 224, 1, 0},
+    {0x819, 750, 224, 1, 0},
+    {0x81b, 751, 224, 1, 0},
+    {0x81c, 752, 224, 1, 0},
+    {0x81d, 753, 224, 1, 0},
+    {0x81e, 754, 224, 1, 0},
+    {0x81f, 755, 224, 1, 0},
+    {0x820, 756, 224, 1, 0},
+    {0x821, 757, 224, 1, 0},
+    {0x822, 758, 224, 1, 0},
+    {0x823, 759, 224, 1, 0},
+    {0x825, 760, 224, 1, 0},
+    {0x826, 761, 224, 1, 0},
+    {0x827, 762, 224, 1, 0},
+    {0x829, 763, 224, 1, 0},
+    {0x82a, 764, 224, 1, 0},
+    {0x82b, 765, 224, 1, 0},
+    {0x82c, 766, 224, 1, 0},
+    {0x82d, 767, 224, 1, 0},
+    {0x859, 768, 224, 1, 0},
+    {0x85a, 769, 224, 1, 0},
+    {0x85b, 770, 224, 1, 0},
+    {0x898, 771, 224, 1, 0},
+    {0x899, 772, 224, 1, 0},
+    {0x89a, 773, 224, 1, 0},
+    {0x89b, 774, 224, 1, 0},
+    {0x89c, 775, 224, 1, 0},
+    {0x89d, 776, 224, 1, 0},
+    {0x89e, 777, 224, 1, 0},
+    {0x89f, 778, 224, 1, 0},
+    {0x8ca, 779, 224, 1, 0},
+    {0x8cb, 780, 224, 1, 0},
+    {0x8cc, 781, 224, 1, 0},
+    {0x8cd, 782, 224, 1, 0},
+    {0x8ce, 783, 224, 1, 0},
+    {0x8cf, 784, 224, 1, 0},
+    {0x8d0, 785, 224, 1, 0},
+    {0x8d1, 786, 224, 1, 0},
+    {0x8d2, 787, 224, 1, 0},
+    {0x8d3, 788, 224, 1, 0},
+    {0x8d4, 789, 224, 1, 0},
+    {0x8d5, 790, 224, 1, 0},
+    {0x8d6, 791, 224, 1, 0},
+    {0x8d7, 792, 224, 1, 0},
+    {0x8d8, 793, 224, 1, 0},
+    {0x8d9, 794, 224, 1, 0},
+    {0x8da, 795, 224, 1, 0},
+    {0x8db, 796, 224, 1, 0},
+    {0x8dc, 797, 224, 1, 0},
+    {0x8dd, 798, 224, 1, 0},
+    {0x8de, 799, 224, 1, 0},
+    {0x8df, 800, 224, 1, 0},
+    {0x8e0, 801, 224, 1, 0},
+    {0x8e1, 802, 224, 1, 0},
+    {0x8e3, 803, 224, 1, 0},
+    {0x8e4, 804, 224, 1, 0},
+    {0x8e5, 805, 224, 1, 0},
+    {0x8e6, 806, 224, 1, 0},
+    {0x8e7, 807, 224, 1, 0},
+    {0x8e8, 808, 224, 1, 0},
+    {0x8e9, 809, 224, 1, 0},
+    {0x8ea, 810, 224, 1, 0},
+    {0x8eb, 811, 224, 1, 0},
+    {0x8ec, 812, 224, 1, 0},
+    {0x8ed, 813, 224, 1, 0},
+    {0x8ee, 814, 224, 1, 0},
+    {0x8ef, 815, 224, 1, 0},
+    {0x8f0, 816, 224, 1, 0},
+    {0x8f1, 817, 224, 1, 0},
+    {0x8f2, 818, 224, 1, 0},
+    {0x8f3, 819, 224, 1, 0},
+    {0x8f4, 820, 224, 1, 0},
+    {0x8f5, 821, 224, 1, 0},
+    {0x8f6, 822, 224, 1, 0},
+    {0x8f7, 823, 224, 1, 0},
+    {0x8f8, 824, 224, 1, 0},
+    {0x8f9, 825, 224, 1, 0},
+    {0x8fa, 826, 224, 1, 0},
+    {0x8fb, 827, 224, 1, 0},
+    {0x8fc, 828, 224, 1, 0},
+    {0x8fd, 829, 224, 1, 0},
+    {0x8fe, 830, 224, 1, 0},
+    {0x8ff, 831, 224, 1, 0},
+    {0x929, 832, 833, 1, 1},
+    {0x931, 834, 835, 1, 1},
+    {0x934, 836, 837, 1, 1},
+    {0x93c, 838, 224, 1, 0},
+    {0x94d, 839, 224, 1, 0},
+    {0x951, 840, 224, 1, 0},
+    {0x952, 841, 224, 1, 0},
+    {0x953, 842, 224, 1, 0},
+    {0x954, 843, 224, 1, 0},
+    {0x958, 844, 845, 1, 1},
+    {0x959, 846, 847, 1, 1},
+    {0x95a, 848, 849, 1, 1},
+    {0x95b, 850, 851, 1, 1},
+    {0x95c, 852, 853, 1, 1},
+    {0x95d, 854, 855, 1, 1},
+    {0x95e, 856, 857, 1, 1},
+    {0x95f, 858, 859, 1, 1},
+    {0x9bc, 860, 224, 1, 0},
+    {0x9cd, 861, 224, 1, 0},
+    {0x9dc, 862, 863, 1, 1},
+    {0x9dd, 864, 865, 1, 1},
+    {0x9df, 866, 867, 1, 1},
+    {0x9fe, 868, 224, 1, 0},
+    {0xa33, 869, 870, 1, 1},
+    {0xa36, 871, 872, 1, 1},
+    {0xa3c, 873, 224, 1, 0},
+    {0xa4d, 874, 224, 1, 0},
+    {0xa59, 875, 876, 1, 1},
+    {0xa5a, 877, 878, 1, 1},
+    {0xa5b, 879, 880, 1, 1},
+    {0xa5e, 881, 882, 1, 1},
+    {0xabc, 883, 224, 1, 0},
+    {0xacd, 884, 224, 1, 0},
+    {0xb3c, 885, 224, 1, 0},
+    {0xb4d, 886, 224, 1, 0},
+    {0xb5c, 887, 888, 1, 1},
+    {0xb5d, 889, 890, 1, 1},
+    {0xbcd, 891, 224, 1, 0},
+    {0xc3c, 892, 224, 1, 0},
+    {0xc48, 893, 894, 1, 1},
+    {0xc4d, 895, 224, 1, 0},
+    {0xc55, 896, 224, 1, 0},
+    {0xc56, 897, 224, 1, 0},
+    {0xcbc, 898, 224, 1, 0},
+    {0xccd, 899, 224, 1, 0},
+    {0xd3b, 900, 224, 1, 0},
+    {0xd3c, 901, 224, 1, 0},
+    {0xd4d, 902, 224, 1, 0},
+    {0xdca, 903, 224, 1, 0},
+    {0xdda, 904, 905, 1, 1},
+    {0xddd, 906, 907, 1, 1},
+    {0xe38, 908, 224, 1, 0},
+    {0xe39, 909, 224, 1, 0},
+    {0xe3a, 910, 224, 1, 0},
+    {0xe48, 911, 224, 1, 0},
+    {0xe49, 912, 224, 1, 0},
+    {0xe4a, 913, 224, 1, 0},
+    {0xe4b, 914, 224, 1, 0},
+    {0xeb8, 915, 224, 1, 0},
+    {0xeb9, 916, 224, 1, 0},
+    {0xeba, 917, 224, 1, 0},
+    {0xec8, 918, 224, 1, 0},
+    {0xec9, 919, 224, 1, 0},
+    {0xeca, 920, 224, 1, 0},
+    {0xecb, 921, 224, 1, 0},
+    {0xf18, 922, 224, 1, 0},
+    {0xf19, 923, 224, 1, 0},
+    {0xf35, 924, 224, 1, 0},
+    {0xf37, 925, 224, 1, 0},
+    {0xf39, 926, 224, 1, 0},
+    {0xf71, 927, 224, 1, 0},
+    {0xf72, 928, 224, 1, 0},
+    {0xf73, 929, 224, 1, 0},
+    {0xf74, 930, 224, 1, 0},
+    {0xf75, 931, 224, 1, 0},
+    {0xf76, 932, 933, 1, 1},
+    {0xf78, 934, 935, 1, 1},
+    {0xf7a, 936, 224, 1, 0},
+    {0xf7b, 937, 224, 1, 0},
+    {0xf7c, 938, 224, 1, 0},
+    {0xf7d, 939, 224, 1, 0},
+    {0xf80, 940, 224, 1, 0},
+    {0xf81, 941, 224, 1, 0},
+    {0xf82, 942, 224, 1, 0},
+    {0xf83, 943, 224, 1, 0},
+    {0xf84, 944, 224, 1, 0},
+    {0xf86, 945, 224, 1, 0},
+    {0xf87, 946, 224, 1, 0},
+    {0xfc6, 947, 224, 1, 0},
+    {0x1037, 948, 224, 1, 0},
+    {0x1039, 949, 224, 1, 0},
+    {0x103a, 950, 224, 1, 0},
+    {0x108d, 951, 224, 1, 0},
+    {0x10a0, 952, 952, 1, 1},
+    {0x10a1, 953, 953, 1, 1},
+    {0x10a2, 954, 954, 1, 1},
+    {0x10a3, 955, 955, 1, 1},
+    {0x10a4, 956, 956, 1, 1},
+    {0x10a5, 957, 957, 1, 1},
+    {0x10a6, 958, 958, 1, 1},
+    {0x10a7, 959, 959, 1, 1},
+    {0x10a8, 960, 960, 1, 1},
+    {0x10a9, 961, 961, 1, 1},
+    {0x10aa, 962, 962, 1, 1},
+    {0x10ab, 963, 963, 1, 1},
+    {0x10ac, 964, 964, 1, 1},
+    {0x10ad, 965, 965, 1, 1},
+    {0x10ae, 966, 966, 1, 1},
+    {0x10af, 967, 967, 1, 1},
+    {0x10b0, 968, 968, 1, 1},
+    {0x10b1, 969, 969, 1, 1},
+    {0x10b2, 970, 970, 1, 1},
+    {0x10b3, 971, 971, 1, 1},
+    {0x10b4, 972, 972, 1, 1},
+    {0x10b5, 973, 973, 1, 1},
+    {0x10b6, 974, 974, 1, 1},
+    {0x10b7, 975, 975, 1, 1},
+    {0x10b8, 976, 976, 1, 1},
+    {0x10b9, 977, 977, 1, 1},
+    {0x10ba, 978, 978, 1, 1},
+    {0x10bb, 979, 979, 1, 1},
+    {0x10bc, 980, 980, 1, 1},
+    {0x10bd, 981, 981, 1, 1},
+    {0x10be, 982, 982, 1, 1},
+    {0x10bf, 983, 983, 1, 1},
+    {0x10c0, 984, 984, 1, 1},
+    {0x10c1, 985, 985, 1, 1},
+    {0x10c2, 986, 986, 1, 1},
+    {0x10c3, 987, 987, 1, 1},
+    {0x10c4, 988, 988, 1, 1},
+    {0x10c5, 989, 989, 1, 1},
+    {0x10c7, 990, 990, 1, 1},
+    {0x10cd, 991, 991, 1, 1},
+    {0x135d, 992, 224, 1, 0},
+    {0x135e, 993, 224, 1, 0},
+    {0x135f, 994, 224, 1, 0},
+    {0x13f8, 995, 995, 1, 1},
+    {0x13f9, 996, 996, 1, 1},
+    {0x13fa, 997, 997, 1, 1},
+    {0x13fb, 998, 998, 1, 1},
+    {0x13fc, 999, 999, 1, 1},
+    {0x13fd, 1000, 1000, 1, 1},
+    {0x1714, 1001, 224, 1, 0},
+    {0x1715, 1002, 224, 1, 0},
+    {0x1734, 1003, 224, 1, 0},
+    {0x17d2, 1004, 224, 1, 0},
+    {0x17dd, 1005, 224, 1, 0},
+    {0x18a9, 1006, 224, 1, 0},
+    {0x1939, 1007, 224, 1, 0},
+    {0x193a, 1008, 224, 1, 0},
+    {0x193b, 1009, 224, 1, 0},
+    {0x1a17, 1010, 224, 1, 0},
+    {0x1a18, 1011, 224, 1, 0},
+    {0x1a60, 1012, 224, 1, 0},
+    {0x1a75, 1013, 224, 1, 0},
+    {0x1a76, 1014, 224, 1, 0},
+    {0x1a77, 1015, 224, 1, 0},
+    {0x1a78, 1016, 224, 1, 0},
+    {0x1a79, 1017, 224, 1, 0},
+    {0x1a7a, 1018, 224, 1, 0},
+    {0x1a7b, 1019, 224, 1, 0},
+    {0x1a7c, 1020, 224, 1, 0},
+    {0x1a7f, 1021, 224, 1, 0},
+    {0x1ab0, 1022, 224, 1, 0},
+    {0x1ab1, 1023, 224, 1, 0},
+    {0x1ab2, 1024, 224, 1, 0},
+    {0x1ab3, 1025, 224, 1, 0},
+    {0x1ab4, 1026, 224, 1, 0},
+    {0x1ab5, 1027, 224, 1, 0},
+    {0x1ab6, 1028, 224, 1, 0},
+    {0x1ab7, 1029, 224, 1, 0},
+    {0x1ab8, 1030, 224, 1, 0},
+    {0x1ab9, 1031, 224, 1, 0},
+    {0x1aba, 1032, 224, 1, 0},
+    {0x1abb, 1033, 224, 1, 0},
+    {0x1abc, 1034, 224, 1, 0},
+    {0x1abd, 1035, 224, 1, 0},
+    {0x1abf, 1036, 224, 1, 0},
+    {0x1ac0, 1037, 224, 1, 0},
+    {0x1ac1, 1038, 224, 1, 0},
+    {0x1ac2, 1039, 224, 1, 0},
+    {0x1ac3, 1040, 224, 1, 0},
+    {0x1ac4, 1041, 224, 1, 0},
+    {0x1ac5, 1042, 224, 1, 0},
+    {0x1ac6, 1043, 224, 1, 0},
+    {0x1ac7, 1044, 224, 1, 0},
+    {0x1ac8, 1045, 224, 1, 0},
+    {0x1ac9, 1046, 224, 1, 0},
+    {0x1aca, 1047, 224, 1, 0},
+    {0x1acb, 1048, 224, 1, 0},
+    {0x1acc, 1049, 224, 1, 0},
+    {0x1acd, 1050, 224, 1, 0},
+    {0x1ace, 1051, 224, 1, 0},
+    {0x1b34, 1052, 224, 1, 0},
+    {0x1b44, 1053, 224, 1, 0},
+    {0x1b6b, 1054, 224, 1, 0},
+    {0x1b6c, 1055, 224, 1, 0},
+    {0x1b6d, 1056, 224, 1, 0},
+    {0x1b6e, 1057, 224, 1, 0},
+    {0x1b6f, 1058, 224, 1, 0},
+    {0x1b70, 1059, 224, 1, 0},
+    {0x1b71, 1060, 224, 1, 0},
+    {0x1b72, 1061, 224, 1, 0},
+    {0x1b73, 1062, 224, 1, 0},
+    {0x1baa, 1063, 224, 1, 0},
+    {0x1bab, 1064, 224, 1, 0},
+    {0x1be6, 1065, 224, 1, 0},
+    {0x1bf2, 1066, 224, 1, 0},
+    {0x1bf3, 1067, 224, 1, 0},
+    {0x1c37, 1068, 224, 1, 0},
+    {0x1c80, 422, 422, 1, 1},
+    {0x1c81, 423, 423, 1, 1},
+    {0x1c82, 430, 430, 1, 1},
+    {0x1c83, 433, 433, 1, 1},
+    {0x1c84, 434, 434, 1, 1},
+    {0x1c85, 434, 434, 1, 1},
+    {0x1c86, 441, 441, 1, 1},
+    {0x1c87, 448, 448, 1, 1},
+    {0x1c88, 1069, 1069, 1, 1},
+    {0x1c90, 1070, 1070, 1, 1},
+    {0x1c91, 1071, 1071, 1, 1},
+    {0x1c92, 1072, 1072, 1, 1},
+    {0x1c93, 1073, 1073, 1, 1},
+    {0x1c94, 1074, 1074, 1, 1},
+    {0x1c95, 1075, 1075, 1, 1},
+    {0x1c96, 1076, 1076, 1, 1},
+    {0x1c97, 1077, 1077, 1, 1},
+    {0x1c98, 1078, 1078, 1, 1},
+    {0x1c99, 1079, 1079, 1, 1},
+    {0x1c9a, 1080, 1080, 1, 1},
+    {0x1c9b, 1081, 1081, 1, 1},
+    {0x1c9c, 1082, 1082, 1, 1},
+    {0x1c9d, 1083, 1083, 1, 1},
+    {0x1c9e, 1084, 1084, 1, 1},
+    {0x1c9f, 1085, 1085, 1, 1},
+    {0x1ca0, 1086, 1086, 1, 1},
+    {0x1ca1, 1087, 1087, 1, 1},
+    {0x1ca2, 1088, 1088, 1, 1},
+    {0x1ca3, 1089, 1089, 1, 1},
+    {0x1ca4, 1090, 1090, 1, 1},
+    {0x1ca5, 1091, 1091, 1, 1},
+    {0x1ca6, 1092, 1092, 1, 1},
+    {0x1ca7, 1093, 1093, 1, 1},
+    {0x1ca8, 1094, 1094, 1, 1},
+    {0x1ca9, 1095, 1095, 1, 1},
+    {0x1caa, 1096, 1096, 1, 1},
+    {0x1cab, 1097, 1097, 1, 1},
+    {0x1cac, 1098, 1098, 1, 1},
+    {0x1cad, 1099, 1099, 1, 1},
+    {0x1cae, 1100, 1100, 1, 1},
+    {0x1caf, 1101, 1101, 1, 1},
+    {0x1cb0, 1102, 1102, 1, 1},
+    {0x1cb1, 1103, 1103, 1, 1},
+    {0x1cb2, 1104, 1104, 1, 1},
+    {0x1cb3, 1105, 1105, 1, 1},
+    {0x1cb4, 1106, 1106, 1, 1},
+    {0x1cb5, 1107, 1107, 1, 1},
+    {0x1cb6, 1108, 1108, 1, 1},
+    {0x1cb7, 1109, 1109, 1, 1},
+    {0x1cb8, 1110, 1110, 1, 1},
+    {0x1cb9, 1111, 1111, 1, 1},
+    {0x1cba, 1112, 1112, 1, 1},
+    {0x1cbd, 1113, 1113, 1, 1},
+    {0x1cbe, 1114, 1114, 1, 1},
+    {0x1cbf, 1115, 1115, 1, 1},
+    {0x1cd0, 1116, 224, 1, 0},
+    {0x1cd1, 1117, 224, 1, 0},
+    {0x1cd2, 1118, 224, 1, 0},
+    {0x1cd4, 1119, 224, 1, 0},
+    {0x1cd5, 1120, 224, 1, 0},
+    {0x1cd6, 1121, 224, 1, 0},
+    {0x1cd7, 1122, 224, 1, 0},
+    {0x1cd8, 1123, 224, 1, 0},
+    {0x1cd9, 1124, 224, 1, 0},
+    {0x1cda, 1125, 224, 1, 0},
+    {0x1cdb, 1126, 224, 1, 0},
+    {0x1cdc, 1127, 224, 1, 0},
+    {0x1cdd, 1128, 224, 1, 0},
+    {0x1cde, 1129, 224, 1, 0},
+    {0x1cdf, 1130, 224, 1, 0},
+    {0x1ce0, 1131, 224, 1, 0},
+    {0x1ce2, 1132, 224, 1, 0},
+    {0x1ce3, 1133, 224, 1, 0},
+    {0x1ce4, 1134, 224, 1, 0},
+    {0x1ce5, 1135, 224, 1, 0},
+    {0x1ce6, 1136, 224, 1, 0},
+    {0x1ce7, 1137, 224, 1, 0},
+    {0x1ce8, 1138, 224, 1, 0},
+    {0x1ced, 1139, 224, 1, 0},
+    {0x1cf4, 1140, 224, 1, 0},
+    {0x1cf8, 1141, 224, 1, 0},
+    {0x1cf9, 1142, 224, 1, 0},
+    {0x1dc0, 1143, 224, 1, 0},
+    {0x1dc1, 1144, 224, 1, 0},
+    {0x1dc2, 1145, 224, 1, 0},
+    {0x1dc3, 1146, 224, 1, 0},
+    {0x1dc4, 1147, 224, 1, 0},
+    {0x1dc5, 1148, 224, 1, 0},
+    {0x1dc6, 1149, 224, 1, 0},
+    {0x1dc7, 1150, 224, 1, 0},
+    {0x1dc8, 1151, 224, 1, 0},
+    {0x1dc9, 1152, 224, 1, 0},
+    {0x1dca, 1153, 224, 1, 0},
+    {0x1dcb, 1154, 224, 1, 0},
+    {0x1dcc, 1155, 224, 1, 0},
+    {0x1dcd, 1156, 224, 1, 0},
+    {0x1dce, 1157, 224, 1, 0},
+    {0x1dcf, 1158, 224, 1, 0},
+    {0x1dd0, 1159, 224, 1, 0},
+    {0x1dd1, 1160, 224, 1, 0},
+    {0x1dd2, 1161, 224, 1, 0},
+    {0x1dd3, 1162, 224, 1, 0},
+    {0x1dd4, 1163, 224, 1, 0},
+    {0x1dd5, 1164, 224, 1, 0},
+    {0x1dd6, 1165, 224, 1, 0},
+    {0x1dd7, 1166, 224, 1, 0},
+    {0x1dd8, 1167, 224, 1, 0},
+    {0x1dd9, 1168, 224, 1, 0},
+    {0x1dda, 1169, 224, 1, 0},
+    {0x1ddb, 1170, 224, 1, 0},
+    {0x1ddc, 1171, 224, 1, 0},
+    {0x1ddd, 1172, 224, 1, 0},
+    {0x1dde, 1173, 224, 1, 0},
+    {0x1ddf, 1174, 224, 1, 0},
+    {0x1de0, 1175, 224, 1, 0},
+    {0x1de1, 1176, 224, 1, 0},
+    {0x1de2, 1177, 224, 1, 0},
+    {0x1de3, 1178, 224, 1, 0},
+    {0x1de4, 1179, 224, 1, 0},
+    {0x1de5, 1180, 224, 1, 0},
+    {0x1de6, 1181, 224, 1, 0},
+    {0x1de7, 1182, 224, 1, 0},
+    {0x1de8, 1183, 224, 1, 0},
+    {0x1de9, 1184, 224, 1, 0},
+    {0x1dea, 1185, 224, 1, 0},
+    {0x1deb, 1186, 224, 1, 0},
+    {0x1dec, 1187, 224, 1, 0},
+    {0x1ded, 1188, 224, 1, 0},
+    {0x1dee, 1189, 224, 1, 0},
+    {0x1def, 1190, 224, 1, 0},
+    {0x1df0, 1191, 224, 1, 0},
+    {0x1df1, 1192, 224, 1, 0},
+    {0x1df2, 1193, 224, 1, 0},
+    {0x1df3, 1194, 224, 1, 0},
+    {0x1df4, 1195, 224, 1, 0},
+    {0x1df5, 1196, 224, 1, 0},
+    {0x1df6, 1197, 224, 1, 0},
+    {0x1df7, 1198, 224, 1, 0},
+    {0x1df8, 1199, 224, 1, 0},
+    {0x1df9, 1200, 224, 1, 0},
+    {0x1dfa, 1201, 224, 1, 0},
+    {0x1dfb, 1202, 224, 1, 0},
+    {0x1dfc, 1203, 224, 1, 0},
+    {0x1dfd, 1204, 224, 1, 0},
+    {0x1dfe, 1205, 224, 1, 0},
+    {0x1dff, 1206, 224, 1, 0},
+    {0x1e00, 1207, 2, 1, 1},
+    {0x1e01, 1207, 2, 1, 1},
+    {0x1e02, 1208, 1209, 1, 1},
+    {0x1e03, 1208, 1209, 1, 1},
+    {0x1e04, 1210, 1209, 1, 1},
+    {0x1e05, 1210, 1209, 1, 1},
+    {0x1e06, 1211, 1209, 1, 1},
+    {0x1e07, 1211, 1209, 1, 1},
+    {0x1e08, 1212, 10, 1, 1},
+    {0x1e09, 1212, 10, 1, 1},
+    {0x1e0a, 1213, 50, 1, 1},
+    {0x1e0b, 1213, 50, 1, 1},
+    {0x1e0c, 1214, 50, 1, 1},
+    {0x1e0d, 1214, 50, 1, 1},
+    {0x1e0e, 1215, 50, 1, 1},
+    {0x1e0f, 1215, 50, 1, 1},
+    {0x1e10, 1216, 50, 1, 1},
+    {0x1e11, 1216, 50, 1, 1},
+    {0x1e12, 1217, 50, 1, 1},
+    {0x1e13, 1217, 50, 1, 1},
+    {0x1e14, 1218, 12, 1, 1},
+    {0x1e15, 1218, 12, 1, 1},
+    {0x1e16, 1219, 12, 1, 1},
+    {0x1e17, 1219, 12, 1, 1},
+    {0x1e18, 1220, 12, 1, 1},
+    {0x1e19, 1220, 12, 1, 1},
+    {0x1e1a, 1221, 12, 1, 1},
+    {0x1e1b, 1221, 12, 1, 1},
+    {0x1e1c, 1222, 12, 1, 1},
+    {0x1e1d, 1222, 12, 1, 1},
+    {0x1e1e, 1223, 1224, 1, 1},
+    {0x1e1f, 1223, 1224, 1, 1},
+    {0x1e20, 1225, 58, 1, 1},
+    {0x1e21, 1225, 58, 1, 1},
+    {0x1e22, 1226, 63, 1, 1},
+    {0x1e23, 1226, 63, 1, 1},
+    {0x1e24, 1227, 63, 1, 1},
+    {0x1e25, 1227, 63, 1, 1},
+    {0x1e26, 1228, 63, 1, 1},
+    {0x1e27, 1228, 63, 1, 1},
+    {0x1e28, 1229, 63, 1, 1},
+    {0x1e29, 1229, 63, 1, 1},
+    {0x1e2a, 1230, 63, 1, 1},
+    {0x1e2b, 1230, 63, 1, 1},
+    {0x1e2c, 1231, 17, 1, 1},
+    {0x1e2d, 1231, 17, 1, 1},
+    {0x1e2e, 1232, 17, 1, 1},
+    {0x1e2f, 1232, 17, 1, 1},
+    {0x1e30, 1233, 75, 1, 1},
+    {0x1e31, 1233, 75, 1, 1},
+    {0x1e32, 1234, 75, 1, 1},
+    {0x1e33, 1234, 75, 1, 1},
+    {0x1e34, 1235, 75, 1, 1},
+    {0x1e35, 1235, 75, 1, 1},
+    {0x1e36, 1236, 77, 1, 1},
+    {0x1e37, 1236, 77, 1, 1},
+    {0x1e38, 1237, 77, 1, 1},
+    {0x1e39, 1237, 77, 1, 1},
+    {0x1e3a, 1238, 77, 1, 1},
+    {0x1e3b, 1238, 77, 1, 1},
+    {0x1e3c, 1239, 77, 1, 1},
+    {0x1e3d, 1239, 77, 1, 1},
+    {0x1e3e, 1240, 1241, 1, 1},
+    {0x1e3f, 1240, 1241, 1, 1},
+    {0x1e40, 1242, 1241, 1, 1},
+    {0x1e41, 1242, 1241, 1, 1},
+    {0x1e42, 1243, 1241, 1, 1},
+    {0x1e43, 1243, 1241, 1, 1},
+    {0x1e44, 1244, 23, 1, 1},
+    {0x1e45, 1244, 23, 1, 1},
+    {0x1e46, 1245, 23, 1, 1},
+    {0x1e47, 1245, 23, 1, 1},
+    {0x1e48, 1246, 23, 1, 1},
+    {0x1e49, 1246, 23, 1, 1},
+    {0x1e4a, 1247, 23, 1, 1},
+    {0x1e4b, 1247, 23, 1, 1},
+    {0x1e4c, 1248, 25, 1, 1},
+    {0x1e4d, 1248, 25, 1, 1},
+    {0x1e4e, 1249, 25, 1, 1},
+    {0x1e4f, 1249, 25, 1, 1},
+    {0x1e50, 1250, 25, 1, 1},
+    {0x1e51, 1250, 25, 1, 1},
+    {0x1e52, 1251, 25, 1, 1},
+    {0x1e53, 1251, 25, 1, 1},
+    {0x1e54, 1252, 1253, 1, 1},
+    {0x1e55, 1252, 1253, 1, 1},
+    {0x1e56, 1254, 1253, 1, 1},
+    {0x1e57, 1254, 1253, 1, 1},
+    {0x1e58, 1255, 93, 1, 1},
+    {0x1e59, 1255, 93, 1, 1},
+    {0x1e5a, 1256, 93, 1, 1},
+    {0x1e5b, 1256, 93, 1, 1},
+    {0x1e5c, 1257, 93, 1, 1},
+    {0x1e5d, 1257, 93, 1, 1},
+    {0x1e5e, 1258, 93, 1, 1},
+    {0x1e5f, 1258, 93, 1, 1},
+    {0x1e60, 1259, 97, 1, 1},
+    {0x1e61, 1259, 97, 1, 1},
+    {0x1e62, 1260, 97, 1, 1},
+    {0x1e63, 1260, 97, 1, 1},
+    {0x1e64, 1261, 97, 1, 1},
+    {0x1e65, 1261, 97, 1, 1},
+    {0x1e66, 1262, 97, 1, 1},
+    {0x1e67, 1262, 97, 1, 1},
+    {0x1e68, 1263, 97, 1, 1},
+    {0x1e69, 1263, 97, 1, 1},
+    {0x1e6a, 1264, 102, 1, 1},
+    {0x1e6b, 1264, 102, 1, 1},
+    {0x1e6c, 1265, 102, 1, 1},
+    {0x1e6d, 1265, 102, 1, 1},
+    {0x1e6e, 1266, 102, 1, 1},
+    {0x1e6f, 1266, 102, 1, 1},
+    {0x1e70, 1267, 102, 1, 1},
+    {0x1e71, 1267, 102, 1, 1},
+    {0x1e72, 1268, 32, 1, 1},
+    {0x1e73, 1268, 32, 1, 1},
+    {0x1e74, 1269, 32, 1, 1},
+    {0x1e75, 1269, 32, 1, 1},
+    {0x1e76, 1270, 32, 1, 1},
+    {0x1e77, 1270, 32, 1, 1},
+    {0x1e78, 1271, 32, 1, 1},
+    {0x1e79, 1271, 32, 1, 1},
+    {0x1e7a, 1272, 32, 1, 1},
+    {0x1e7b, 1272, 32, 1, 1},
+    {0x1e7c, 1273, 1274, 1, 1},
+    {0x1e7d, 1273, 1274, 1, 1},
+    {0x1e7e, 1275, 1274, 1, 1},
+    {0x1e7f, 1275, 1274, 1, 1},
+    {0x1e80, 1276, 112, 1, 1},
+    {0x1e81, 1276, 112, 1, 1},
+    {0x1e82, 1277, 112, 1, 1},
+    {0x1e83, 1277, 112, 1, 1},
+    {0x1e84, 1278, 112, 1, 1},
+    {0x1e85, 1278, 112, 1, 1},
+    {0x1e86, 1279, 112, 1, 1},
+    {0x1e87, 1279, 112, 1, 1},
+    {0x1e88, 1280, 112, 1, 1},
+    {0x1e89, 1280, 112, 1, 1},
+    {0x1e8a, 1281, 1282, 1, 1},
+    {0x1e8b, 1281, 1282, 1, 1},
+    {0x1e8c, 1283, 1282, 1, 1},
+    {0x1e8d, 1283, 1282, 1, 1},
+    {0x1e8e, 1284, 37, 1, 1},
+    {0x1e8f, 1284, 37, 1, 1},
+    {0x1e90, 1285, 115, 1, 1},
+    {0x1e91, 1285, 115, 1, 1},
+    {0x1e92, 1286, 115, 1, 1},
+    {0x1e93, 1286, 115, 1, 1},
+    {0x1e94, 1287, 115, 1, 1},
+    {0x1e95, 1287, 115, 1, 1},
+    {0x1e96, 1288, 63, 2, 1},
+    {0x1e97, 1290, 102, 2, 1},
+    {0x1e98, 1292, 112, 2, 1},
+    {0x1e99, 1294, 37, 2, 1},
+    {0x1e9a, 1296, 1296, 2, 2},
+    {0x1e9b, 1259, 97, 1, 1},
+    {0x1e9e, 39, 39, 2, 2},
+    {0x1ea0, 1298, 2, 1, 1},
+    {0x1ea1, 1298, 2, 1, 1},
+    {0x1ea2, 1299, 2, 1, 1},
+    {0x1ea3, 1299, 2, 1, 1},
+    {0x1ea4, 1300, 2, 1, 1},
+    {0x1ea5, 1300, 2, 1, 1},
+    {0x1ea6, 1301, 2, 1, 1},
+    {0x1ea7, 1301, 2, 1, 1},
+    {0x1ea8, 1302, 2, 1, 1},
+    {0x1ea9, 1302, 2, 1, 1},
+    {0x1eaa, 1303, 2, 1, 1},
+    {0x1eab, 1303, 2, 1, 1},
+    {0x1eac, 1304, 2, 1, 1},
+    {0x1ead, 1304, 2, 1, 1},
+    {0x1eae, 1305, 2, 1, 1},
+    {0x1eaf, 1305, 2, 1, 1},
+    {0x1eb0, 1306, 2, 1, 1},
+    {0x1eb1, 1306, 2, 1, 1},
+    {0x1eb2, 1307, 2, 1, 1},
+    {0x1eb3, 1307, 2, 1, 1},
+    {0x1eb4, 1308, 2, 1, 1},
+    {0x1eb5, 1308, 2, 1, 1},
+    {0x1eb6, 1309, 2, 1, 1},
+    {0x1eb7, 1309, 2, 1, 1},
+    {0x1eb8, 1310, 12, 1, 1},
+    {0x1eb9, 1310, 12, 1, 1},
+    {0x1eba, 1311, 12, 1, 1},
+    {0x1ebb, 1311, 12, 1, 1},
+    {0x1ebc, 1312, 12, 1, 1},
+    {0x1ebd, 1312, 12, 1, 1},
+    {0x1ebe, 1313, 12, 1, 1},
+    {0x1ebf, 1313, 12, 1, 1},
+    {0x1ec0, 1314, 12, 1, 1},
+    {0x1ec1, 1314, 12, 1, 1},
+    {0x1ec2, 1315, 12, 1, 1},
+    {0x1ec3, 1315, 12, 1, 1},
+    {0x1ec4, 1316, 12, 1, 1},
+    {0x1ec5, 1316, 12, 1, 1},
+    {0x1ec6, 1317, 12, 1, 1},
+    {0x1ec7, 1317, 12, 1, 1},
+    {0x1ec8, 1318, 17, 1, 1},
+    {0x1ec9, 1318, 17, 1, 1},
+    {0x1eca, 1319, 17, 1, 1},
+    {0x1ecb, 1319, 17, 1, 1},
+    {0x1ecc, 1320, 25, 1, 1},
+    {0x1ecd, 1320, 25, 1, 1},
+    {0x1ece, 1321, 25, 1, 1},
+    {0x1ecf, 1321, 25, 1, 1},
+    {0x1ed0, 1322, 25, 1, 1},
+    {0x1ed1, 1322, 25, 1, 1},
+    {0x1ed2, 1323, 25, 1, 1},
+    {0x1ed3, 1323, 25, 1, 1},
+    {0x1ed4, 1324, 25, 1, 1},
+    {0x1ed5, 1324, 25, 1, 1},
+    {0x1ed6, 1325, 25, 1, 1},
+    {0x1ed7, 1325, 25, 1, 1},
+    {0x1ed8, 1326, 25, 1, 1},
+    {0x1ed9, 1326, 25, 1, 1},
+    {0x1eda, 1327, 25, 1, 1},
+    {0x1edb, 1327, 25, 1, 1},
+    {0x1edc, 1328, 25, 1, 1},
+    {0x1edd, 1328, 25, 1, 1},
+    {0x1ede, 1329, 25, 1, 1},
+    {0x1edf, 1329, 25, 1, 1},
+    {0x1ee0, 1330, 25, 1, 1},
+    {0x1ee1, 1330, 25, 1, 1},
+    {0x1ee2, 1331, 25, 1, 1},
+    {0x1ee3, 1331, 25, 1, 1},
+    {0x1ee4, 1332, 32, 1, 1},
+    {0x1ee5, 1332, 32, 1, 1},
+    {0x1ee6, 1333, 32, 1, 1},
+    {0x1ee7, 1333, 32, 1, 1},
+    {0x1ee8, 1334, 32, 1, 1},
+    {0x1ee9, 1334, 32, 1, 1},
+    {0x1eea, 1335, 32, 1, 1},
+    {0x1eeb, 1335, 32, 1, 1},
+    {0x1eec, 1336, 32, 1, 1},
+    {0x1eed, 1336, 32, 1, 1},
+    {0x1eee, 1337, 32, 1, 1},
+    {0x1eef, 1337, 32, 1, 1},
+    {0x1ef0, 1338, 32, 1, 1},
+    {0x1ef1, 1338, 32, 1, 1},
+    {0x1ef2, 1339, 37, 1, 1},
+    {0x1ef3, 1339, 37, 1, 1},
+    {0x1ef4, 1340, 37, 1, 1},
+    {0x1ef5, 1340, 37, 1, 1},
+    {0x1ef6, 1341, 37, 1, 1},
+    {0x1ef7, 1341, 37, 1, 1},
+    {0x1ef8, 1342, 37, 1, 1},
+    {0x1ef9, 1342, 37, 1, 1},
+    {0x1efa, 1343, 1343, 1, 1},
+    {0x1efc, 1344, 1344, 1, 1},
+    {0x1efe, 1345, 1345, 1, 1},
+    {0x1f00, 1346, 341, 1, 1},
+    {0x1f01, 1347, 341, 1, 1},
+    {0x1f02, 1348, 341, 1, 1},
+    {0x1f03, 1349, 341, 1, 1},
+    {0x1f04, 1350, 341, 1, 1},
+    {0x1f05, 1351, 341, 1, 1},
+    {0x1f06, 1352, 341, 1, 1},
+    {0x1f07, 1353, 341, 1, 1},
+    {0x1f08, 1346, 341, 1, 1},
+    {0x1f09, 1347, 341, 1, 1},
+    {0x1f0a, 1348, 341, 1, 1},
+    {0x1f0b, 1349, 341, 1, 1},
+    {0x1f0c, 1350, 341, 1, 1},
+    {0x1f0d, 1351, 341, 1, 1},
+    {0x1f0e, 1352, 341, 1, 1},
+    {0x1f0f, 1353, 341, 1, 1},
+    {0x1f10, 1354, 343, 1, 1},
+    {0x1f11, 1355, 343, 1, 1},
+    {0x1f12, 1356, 343, 1, 1},
+    {0x1f13, 1357, 343, 1, 1},
+    {0x1f14, 1358, 343, 1, 1},
+    {0x1f15, 1359, 343, 1, 1},
+    {0x1f18, 1354, 343, 1, 1},
+    {0x1f19, 1355, 343, 1, 1},
+    {0x1f1a, 1356, 343, 1, 1},
+    {0x1f1b, 1357, 343, 1, 1},
+    {0x1f1c, 1358, 343, 1, 1},
+    {0x1f1d, 1359, 343, 1, 1},
+    {0x1f20, 1360, 345, 1, 1},
+    {0x1f21, 1361, 345, 1, 1},
+    {0x1f22, 1362, 345, 1, 1},
+    {0x1f23, 1363, 345, 1, 1},
+    {0x1f24, 1364, 345, 1, 1},
+    {0x1f25, 1365, 345, 1, 1},
+    {0x1f26, 1366, 345, 1, 1},
+    {0x1f27, 1367, 345, 1, 1},
+    {0x1f28, 1360, 345, 1, 1},
+    {0x1f29, 1361, 345, 1, 1},
+    {0x1f2a, 1362, 345, 1, 1},
+    {0x1f2b, 1363, 345, 1, 1},
+    {0x1f2c, 1364, 345, 1, 1},
+    {0x1f2d, 1365, 345, 1, 1},
+    {0x1f2e, 1366, 345, 1, 1},
+    {0x1f2f, 1367, 345, 1, 1},
+    {0x1f30, 1368, 292, 1, 1},
+    {0x1f31, 1369, 292, 1, 1},
+    {0x1f32, 1370, 292, 1, 1},
+    {0x1f33, 1371, 292, 1, 1},
+    {0x1f34, 1372, 292, 1, 1},
+    {0x1f35, 1373, 292, 1, 1},
+    {0x1f36, 1374, 292, 1, 1},
+    {0x1f37, 1375, 292, 1, 1},
+    {0x1f38, 1368, 292, 1, 1},
+    {0x1f39, 1369, 292, 1, 1},
+    {0x1f3a, 1370, 292, 1, 1},
+    {0x1f3b, 1371, 292, 1, 1},
+    {0x1f3c, 1372, 292, 1, 1},
+    {0x1f3d, 1373, 292, 1, 1},
+    {0x1f3e, 1374, 292, 1, 1},
+    {0x1f3f, 1375, 292, 1, 1},
+    {0x1f40, 1376, 348, 1, 1},
+    {0x1f41, 1377, 348, 1, 1},
+    {0x1f42, 1378, 348, 1, 1},
+    {0x1f43, 1379, 348, 1, 1},
+    {0x1f44, 1380, 348, 1, 1},
+    {0x1f45, 1381, 348, 1, 1},
+    {0x1f48, 1376, 348, 1, 1},
+    {0x1f49, 1377, 348, 1, 1},
+    {0x1f4a, 1378, 348, 1, 1},
+    {0x1f4b, 1379, 348, 1, 1},
+    {0x1f4c, 1380, 348, 1, 1},
+    {0x1f4d, 1381, 348, 1, 1},
+    {0x1f50, 1382, 350, 2, 1},
+    {0x1f51, 1384, 350, 1, 1},
+    {0x1f52, 1385, 350, 3, 1},
+    {0x1f53, 1388, 350, 1, 1},
+    {0x1f54, 1389, 350, 3, 1},
+    {0x1f55, 1392, 350, 1, 1},
+    {0x1f56, 1393, 350, 3, 1},
+    {0x1f57, 1396, 350, 1, 1},
+    {0x1f59, 1384, 350, 1, 1},
+    {0x1f5b, 1388, 350, 1, 1},
+    {0x1f5d, 1392, 350, 1, 1},
+    {0x1f5f, 1396, 350, 1, 1},
+    {0x1f60, 1397, 352, 1, 1},
+    {0x1f61, 1398, 352, 1, 1},
+    {0x1f62, 1399, 352, 1, 1},
+    {0x1f63, 1400, 352, 1, 1},
+    {0x1f64, 1401, 352, 1, 1},
+    {0x1f65, 1402, 352, 1, 1},
+    {0x1f66, 1403, 352, 1, 1},
+    {0x1f67, 1404, 352, 1, 1},
+    {0x1f68, 1397, 352, 1, 1},
+    {0x1f69, 1398, 352, 1, 1},
+    {0x1f6a, 1399, 352, 1, 1},
+    {0x1f6b, 1400, 352, 1, 1},
+    {0x1f6c, 1401, 352, 1, 1},
+    {0x1f6d, 1402, 352, 1, 1},
+    {0x1f6e, 1403, 352, 1, 1},
+    {0x1f6f, 1404, 352, 1, 1},
+    {0x1f70, 1405, 341, 1, 1},
+    {0x1f71, 1406, 341, 1, 1},
+    {0x1f72, 1407, 343, 1, 1},
+    {0x1f73, 1408, 343, 1, 1},
+    {0x1f74, 1409, 345, 1, 1},
+    {0x1f75, 1410, 345, 1, 1},
+    {0x1f76, 1411, 292, 1, 1},
+    {0x1f77, 1412, 292, 1, 1},
+    {0x1f78, 1413, 348, 1, 1},
+    {0x1f79, 1414, 348, 1, 1},
+    {0x1f7a, 1415, 350, 1, 1},
+    {0x1f7b, 1416, 350, 1, 1},
+    {0x1f7c, 1417, 352, 1, 1},
+    {0x1f7d, 1418, 352, 1, 1},
+    {0x1f80, 1419, 1421, 2, 2},
+    {0x1f81, 1423, 1421, 2, 2},
+    {0x1f82, 1425, 1421, 2, 2},
+    {0x1f83, 1427, 1421, 2, 2},
+    {0x1f84, 1429, 1421, 2, 2},
+    {0x1f85, 1431, 1421, 2, 2},
+    {0x1f86, 1433, 1421, 2, 2},
+    {0x1f87, 1435, 1421, 2, 2},
+    {0x1f88, 1419, 1421, 2, 2},
+    {0x1f89, 1423, 1421, 2, 2},
+    {0x1f8a, 1425, 1421, 2, 2},
+    {0x1f8b, 1427, 1421, 2, 2},
+    {0x1f8c, 1429, 1421, 2, 2},
+    {0x1f8d, 1431, 1421, 2, 2},
+    {0x1f8e, 1433, 1421, 2, 2},
+    {0x1f8f, 1435, 1421, 2, 2},
+    {0x1f90, 1437, 1439, 2, 2},
+    {0x1f91, 1441, 1439, 2, 2},
+    {0x1f92, 1443, 1439, 2, 2},
+    {0x1f93, 1445, 1439, 2, 2},
+    {0x1f94, 1447, 1439, 2, 2},
+    {0x1f95, 1449, 1439, 2, 2},
+    {0x1f96, 1451, 1439, 2, 2},
+    {0x1f97, 1453, 1439, 2, 2},
+    {0x1f98, 1437, 1439, 2, 2},
+    {0x1f99, 1441, 1439, 2, 2},
+    {0x1f9a, 1443, 1439, 2, 2},
+    {0x1f9b, 1445, 1439, 2, 2},
+    {0x1f9c, 1447, 1439, 2, 2},
+    {0x1f9d, 1449, 1439, 2, 2},
+    {0x1f9e, 1451, 1439, 2, 2},
+    {0x1f9f, 1453, 1439, 2, 2},
+    {0x1fa0, 1455, 1457, 2, 2},
+    {0x1fa1, 1459, 1457, 2, 2},
+    {0x1fa2, 1461, 1457, 2, 2},
+    {0x1fa3, 1463, 1457, 2, 2},
+    {0x1fa4, 1465, 1457, 2, 2},
+    {0x1fa5, 1467, 1457, 2, 2},
+    {0x1fa6, 1469, 1457, 2, 2},
+    {0x1fa7, 1471, 1457, 2, 2},
+    {0x1fa8, 1455, 1457, 2, 2},
+    {0x1fa9, 1459, 1457, 2, 2},
+    {0x1faa, 1461, 1457, 2, 2},
+    {0x1fab, 1463, 1457, 2, 2},
+    {0x1fac, 1465, 1457, 2, 2},
+    {0x1fad, 1467, 1457, 2, 2},
+    {0x1fae, 1469, 1457, 2, 2},
+    {0x1faf, 1471, 1457, 2, 2},
+    {0x1fb0, 1473, 341, 1, 1},
+    {0x1fb1, 1474, 341, 1, 1},
+    {0x1fb2, 1475, 1421, 2, 2},
+    {0x1fb3, 1421, 1421, 2, 2},
+    {0x1fb4, 1477, 1421, 2, 2},
+    {0x1fb6, 1479, 341, 2, 1},
+    {0x1fb7, 1481, 1421, 3, 2},
+    {0x1fb8, 1473, 341, 1, 1},
+    {0x1fb9, 1474, 341, 1, 1},
+    {0x1fba, 1405, 341, 1, 1},
+    {0x1fbb, 1406, 341, 1, 1},
+    {0x1fbc, 1421, 1421, 2, 2},
+    {0x1fbe, 292, 292, 1, 1},
+    {0x1fc1, 1484, 339, 1, 1},
+    {0x1fc2, 1485, 1439, 2, 2},
+    {0x1fc3, 1439, 1439, 2, 2},
+    {0x1fc4, 1487, 1439, 2, 2},
+    {0x1fc6, 1489, 345, 2, 1},
+    {0x1fc7, 1491, 1439, 3, 2},
+    {0x1fc8, 1407, 343, 1, 1},
+    {0x1fc9, 1408, 343, 1, 1},
+    {0x1fca, 1409, 345, 1, 1},
+    {0x1fcb, 1410, 345, 1, 1},
+    {0x1fcc, 1439, 1439, 2, 2},
+    {0x1fcd, 1494, 1495, 1, 1},
+    {0x1fce, 1496, 1495, 1, 1},
+    {0x1fcf, 1497, 1495, 1, 1},
+    {0x1fd0, 1498, 292, 1, 1},
+    {0x1fd1, 1499, 292, 1, 1},
+    {0x1fd2, 1500, 292, 3, 1},
+    {0x1fd3, 353, 292, 3, 1},
+    {0x1fd6, 1503, 292, 2, 1},
+    {0x1fd7, 1505, 292, 3, 1},
+    {0x1fd8, 1498, 292, 1, 1},
+    {0x1fd9, 1499, 292, 1, 1},
+    {0x1fda, 1411, 292, 1, 1},
+    {0x1fdb, 1412, 292, 1, 1},
+    {0x1fdd, 1508, 1509, 1, 1},
+    {0x1fde, 1510, 1509, 1, 1},
+    {0x1fdf, 1511, 1509, 1, 1},
+    {0x1fe0, 1512, 350, 1, 1},
+    {0x1fe1, 1513, 350, 1, 1},
+    {0x1fe2, 1514, 350, 3, 1},
+    {0x1fe3, 374, 350, 3, 1},
+    {0x1fe4, 1517, 366, 2, 1},
+    {0x1fe5, 1519, 366, 1, 1},
+    {0x1fe6, 1520, 350, 2, 1},
+    {0x1fe7, 1522, 350, 3, 1},
+    {0x1fe8, 1512, 350, 1, 1},
+    {0x1fe9, 1513, 350, 1, 1},
+    {0x1fea, 1415, 350, 1, 1},
+    {0x1feb, 1416, 350, 1, 1},
+    {0x1fec, 1519, 366, 1, 1},
+    {0x1fed, 1525, 339, 1, 1},
+    {0x1fee, 1526, 339, 1, 1},
+    {0x1ff2, 1527, 1457, 2, 2},
+    {0x1ff3, 1457, 1457, 2, 2},
+    {0x1ff4, 1529, 1457, 2, 2},
+    {0x1ff6, 1531, 352, 2, 1},
+    {0x1ff7, 1533, 1457, 3, 2},
+    {0x1ff8, 1413, 348, 1, 1},
+    {0x1ff9, 1414, 348, 1, 1},
+    {0x1ffa, 1417, 352, 1, 1},
+    {0x1ffb, 1418, 352, 1, 1},
+    {0x1ffc, 1457, 1457, 2, 2},
+    {0x20d0, 1536, 224, 1, 0},
+    {0x20d1, 1537, 224, 1, 0},
+    {0x20d2, 1538, 224, 1, 0},
+    {0x20d3, 1539, 224, 1, 0},
+    {0x20d4, 1540, 224, 1, 0},
+    {0x20d5, 1541, 224, 1, 0},
+    {0x20d6, 1542, 224, 1, 0},
+    {0x20d7, 1543, 224, 1, 0},
+    {0x20d8, 1544, 224, 1, 0},
+    {0x20d9, 1545, 224, 1, 0},
+    {0x20da, 1546, 224, 1, 0},
+    {0x20db, 1547, 224, 1, 0},
+    {0x20dc, 1548, 224, 1, 0},
+    {0x20e1, 1549, 224, 1, 0},
+    {0x20e5, 1550, 224, 1, 0},
+    {0x20e6, 1551, 224, 1, 0},
+    {0x20e7, 1552, 224, 1, 0},
+    {0x20e8, 1553, 224, 1, 0},
+    {0x20e9, 1554, 224, 1, 0},
+    {0x20ea, 1555, 224, 1, 0},
+    {0x20eb, 1556, 224, 1, 0},
+    {0x20ec, 1557, 224, 1, 0},
+    {0x20ed, 1558, 224, 1, 0},
+    {0x20ee, 1559, 224, 1, 0},
+    {0x20ef, 1560, 224, 1, 0},
+    {0x20f0, 1561, 224, 1, 0},
+    {0x2126, 352, 352, 1, 1},
+    {0x212a, 75, 75, 1, 1},
+    {0x212b, 7, 2, 1, 1},
+    {0x2132, 1562, 1562, 1, 1},
+    {0x2160, 1563, 1563, 1, 1},
+    {0x2161, 1564, 1564, 1, 1},
+    {0x2162, 1565, 1565, 1, 1},
+    {0x2163, 1566, 1566, 1, 1},
+    {0x2164, 1567, 1567, 1, 1},
+    {0x2165, 1568, 1568, 1, 1},
+    {0x2166, 1569, 1569, 1, 1},
+    {0x2167, 1570, 1570, 1, 1},
+    {0x2168, 1571, 1571, 1, 1},
+    {0x2169, 1572, 1572, 1, 1},
+    {0x216a, 1573, 1573, 1, 1},
+    {0x216b, 1574, 1574, 1, 1},
+    {0x216c, 1575, 1575, 1, 1},
+    {0x216d, 1576, 1576, 1, 1},
+    {0x216e, 1577, 1577, 1, 1},
+    {0x216f, 1578, 1578, 1, 1},
+    {0x2183, 1579, 1579, 1, 1},
+    {0x219a, 1580, 1581, 1, 1},
+    {0x219b, 1582, 1583, 1, 1},
+    {0x21ae, 1584, 1585, 1, 1},
+    {0x21cd, 1586, 1587, 1, 1},
+    {0x21ce, 1588, 1589, 1, 1},
+    {0x21cf, 1590, 1591, 1, 1},
+    {0x2204, 1592, 1593, 1, 1},
+    {0x2209, 1594, 1595, 1, 1},
+    {0x220c, 1596, 1597, 1, 1},
+    {0x2224, 1598, 1599, 1, 1},
+    {0x2226, 1600, 1601, 1, 1},
+    {0x2241, 1602, 1603, 1, 1},
+    {0x2244, 1604, 1605, 1, 1},
+    {0x2247, 1606, 1607, 1, 1},
+    {0x2249, 1608, 1609, 1, 1},
+    {0x2260, 1610, 1611, 1, 1},
+    {0x2262, 1612, 1613, 1, 1},
+    {0x226d, 1614, 1615, 1, 1},
+    {0x226e, 1616, 1617, 1, 1},
+    {0x226f, 1618, 1619, 1, 1},
+    {0x2270, 1620, 1621, 1, 1},
+    {0x2271, 1622, 1623, 1, 1},
+    {0x2274, 1624, 1625, 1, 1},
+    {0x2275, 1626, 1627, 1, 1},
+    {0x2278, 1628, 1629, 1, 1},
+    {0x2279, 1630, 1631, 1, 1},
+    {0x2280, 1632, 1633, 1, 1},
+    {0x2281, 1634, 1635, 1, 1},
+    {0x2284, 1636, 1637, 1, 1},
+    {0x2285, 1638, 1639, 1, 1},
+    {0x2288, 1640, 1641, 1, 1},
+    {0x2289, 1642, 1643, 1, 1},
+    {0x22ac, 1644, 1645, 1, 1},
+    {0x22ad, 1646, 1647, 1, 1},
+    {0x22ae, 1648, 1649, 1, 1},
+    {0x22af, 1650, 1651, 1, 1},
+    {0x22e0, 1652, 1653, 1, 1},
+    {0x22e1, 1654, 1655, 1, 1},
+    {0x22e2, 1656, 1657, 1, 1},
+    {0x22e3, 1658, 1659, 1, 1},
+    {0x22ea, 1660, 1661, 1, 1},
+    {0x22eb, 1662, 1663, 1, 1},
+    {0x22ec, 1664, 1665, 1, 1},
+    {0x22ed, 1666, 1667, 1, 1},
+    {0x24b6, 1668, 1668, 1, 1},
+    {0x24b7, 1669, 1669, 1, 1},
+    {0x24b8, 1670, 1670, 1, 1},
+    {0x24b9, 1671, 1671, 1, 1},
+    {0x24ba, 1672, 1672, 1, 1},
+    {0x24bb, 1673, 1673, 1, 1},
+    {0x24bc, 1674, 1674, 1, 1},
+    {0x24bd, 1675, 1675, 1, 1},
+    {0x24be, 1676, 1676, 1, 1},
+    {0x24bf, 1677, 1677, 1, 1},
+    {0x24c0, 1678, 1678, 1, 1},
+    {0x24c1, 1679, 1679, 1, 1},
+    {0x24c2, 1680, 1680, 1, 1},
+    {0x24c3, 1681, 1681, 1, 1},
+    {0x24c4, 1682, 1682, 1, 1},
+    {0x24c5, 1683, 1683, 1, 1},
+    {0x24c6, 1684, 1684, 1, 1},
+    {0x24c7, 1685, 1685, 1, 1},
+    {0x24c8, 1686, 1686, 1, 1},
+    {0x24c9, 1687, 1687, 1, 1},
+    {0x24ca, 1688, 1688, 1, 1},
+    {0x24cb, 1689, 1689, 1, 1},
+    {0x24cc, 1690, 1690, 1, 1},
+    {0x24cd, 1691, 1691, 1, 1},
+    {0x24ce, 1692, 1692, 1, 1},
+    {0x24cf, 1693, 1693, 1, 1},
+    {0x2adc, 1694, 1695, 1, 1},
+    {0x2c00, 1696, 1696, 1, 1},
+    {0x2c01, 1697, 1697, 1, 1},
+    {0x2c02, 1698, 1698, 1, 1},
+    {0x2c03, 1699, 1699, 1, 1},
+    {0x2c04, 1700, 1700, 1, 1},
+    {0x2c05, 1701, 1701, 1, 1},
+    {0x2c06, 1702, 1702, 1, 1},
+    {0x2c07, 1703, 1703, 1, 1},
+    {0x2c08, 1704, 1704, 1, 1},
+    {0x2c09, 1705, 1705, 1, 1},
+    {0x2c0a, 1706, 1706, 1, 1},
+    {0x2c0b, 1707, 1707, 1, 1},
+    {0x2c0c, 1708, 1708, 1, 1},
+    {0x2c0d, 1709, 1709, 1, 1},
+    {0x2c0e, 1710, 1710, 1, 1},
+    {0x2c0f, 1711, 1711, 1, 1},
+    {0x2c10, 1712, 1712, 1, 1},
+    {0x2c11, 1713, 1713, 1, 1},
+    {0x2c12, 1714, 1714, 1, 1},
+    {0x2c13, 1715, 1715, 1, 1},
+    {0x2c14, 1716, 1716, 1, 1},
+    {0x2c15, 1717, 1717, 1, 1},
+    {0x2c16, 1718, 1718, 1, 1},
+    {0x2c17, 1719, 1719, 1, 1},
+    {0x2c18, 1720, 1720, 1, 1},
+    {0x2c19, 1721, 1721, 1, 1},
+    {0x2c1a, 1722, 1722, 1, 1},
+    {0x2c1b, 1723, 1723, 1, 1},
+    {0x2c1c, 1724, 1724, 1, 1},
+    {0x2c1d, 1725, 1725, 1, 1},
+    {0x2c1e, 1726, 1726, 1, 1},
+    {0x2c1f, 1727, 1727, 1, 1},
+    {0x2c20, 1728, 1728, 1, 1},
+    {0x2c21, 1729, 1729, 1, 1},
+    {0x2c22, 1730, 1730, 1, 1},
+    {0x2c23, 1731, 1731, 1, 1},
+    {0x2c24, 1732, 1732, 1, 1},
+    {0x2c25, 1733, 1733, 1, 1},
+    {0x2c26, 1734, 1734, 1, 1},
+    {0x2c27, 1735, 1735, 1, 1},
+    {0x2c28, 1736, 1736, 1, 1},
+    {0x2c29, 1737, 1737, 1, 1},
+    {0x2c2a, 1738, 1738, 1, 1},
+    {0x2c2b, 1739, 1739, 1, 1},
+    {0x2c2c, 1740, 1740, 1, 1},
+    {0x2c2d, 1741, 1741, 1, 1},
+    {0x2c2e, 1742, 1742, 1, 1},
+    {0x2c2f, 1743, 1743, 1, 1},
+    {0x2c60, 1744, 1744, 1, 1},
+    {0x2c62, 1745, 1745, 1, 1},
+    {0x2c63, 1746, 1746, 1, 1},
+    {0x2c64, 1747, 1747, 1, 1},
+    {0x2c67, 1748, 1748, 1, 1},
+    {0x2c69, 1749, 1749, 1, 1},
+    {0x2c6b, 1750, 1750, 1, 1},
+    {0x2c6d, 1751, 1751, 1, 1},
+    {0x2c6e, 1752, 1752, 1, 1},
+    {0x2c6f, 1753, 1753, 1, 1},
+    {0x2c70, 1754, 1754, 1, 1},
+    {0x2c72, 1755, 1755, 1, 1},
+    {0x2c75, 1756, 1756, 1, 1},
+    {0x2c7e, 1757, 1757, 1, 1},
+    {0x2c7f, 1758, 1758, 1, 1},
+    {0x2c80, 1759, 1759, 1, 1},
+    {0x2c82, 1760, 1760, 1, 1},
+    {0x2c84, 1761, 1761, 1, 1},
+    {0x2c86, 1762, 1762, 1, 1},
+    {0x2c88, 1763, 1763, 1, 1},
+    {0x2c8a, 1764, 1764, 1, 1},
+    {0x2c8c, 1765, 1765, 1, 1},
+    {0x2c8e, 1766, 1766, 1, 1},
+    {0x2c90, 1767, 1767, 1, 1},
+    {0x2c92, 1768, 1768, 1, 1},
+    {0x2c94, 1769, 1769, 1, 1},
+    {0x2c96, 1770, 1770, 1, 1},
+    {0x2c98, 1771, 1771, 1, 1},
+    {0x2c9a, 1772, 1772, 1, 1},
+    {0x2c9c, 1773, 1773, 1, 1},
+    {0x2c9e, 1774, 1774, 1, 1},
+    {0x2ca0, 1775, 1775, 1, 1},
+    {0x2ca2, 1776, 1776, 1, 1},
+    {0x2ca4, 1777, 1777, 1, 1},
+    {0x2ca6, 1778, 1778, 1, 1},
+    {0x2ca8, 1779, 1779, 1, 1},
+    {0x2caa, 1780, 1780, 1, 1},
+    {0x2cac, 1781, 1781, 1, 1},
+    {0x2cae, 1782, 1782, 1, 1},
+    {0x2cb0, 1783, 1783, 1, 1},
+    {0x2cb2, 1784, 1784, 1, 1},
+    {0x2cb4, 1785, 1785, 1, 1},
+    {0x2cb6, 1786, 1786, 1, 1},
+    {0x2cb8, 1787, 1787, 1, 1},
+    {0x2cba, 1788, 1788, 1, 1},
+    {0x2cbc, 1789, 1789, 1, 1},
+    {0x2cbe, 1790, 1790, 1, 1},
+    {0x2cc0, 1791, 1791, 1, 1},
+    {0x2cc2, 1792, 1792, 1, 1},
+    {0x2cc4, 1793, 1793, 1, 1},
+    {0x2cc6, 1794, 1794, 1, 1},
+    {0x2cc8, 1795, 1795, 1, 1},
+    {0x2cca, 1796, 1796, 1, 1},
+    {0x2ccc, 1797, 1797, 1, 1},
+    {0x2cce, 1798, 1798, 1, 1},
+    {0x2cd0, 1799, 1799, 1, 1},
+    {0x2cd2, 1800, 1800, 1, 1},
+    {0x2cd4, 1801, 1801, 1, 1},
+    {0x2cd6, 1802, 1802, 1, 1},
+    {0x2cd8, 1803, 1803, 1, 1},
+    {0x2cda, 1804, 1804, 1, 1},
+    {0x2cdc, 1805, 1805, 1, 1},
+    {0x2cde, 1806, 1806, 1, 1},
+    {0x2ce0, 1807, 1807, 1, 1},
+    {0x2ce2, 1808, 1808, 1, 1},
+    {0x2ceb, 1809, 1809, 1, 1},
+    {0x2ced, 1810, 1810, 1, 1},
+    {0x2cef, 1811, 224, 1, 0},
+    {0x2cf0, 1812, 224, 1, 0},
+    {0x2cf1, 1813, 224, 1, 0},
+    {0x2cf2, 1814, 1814, 1, 1},
+    {0x2d7f, 1815, 224, 1, 0},
+    {0x2de0, 1816, 224, 1, 0},
+    {0x2de1, 1817, 224, 1, 0},
+    {0x2de2, 1818, 224, 1, 0},
+    {0x2de3, 1819, 224, 1, 0},
+    {0x2de4, 1820, 224, 1, 0},
+    {0x2de5, 1821, 224, 1, 0},
+    {0x2de6, 1822, 224, 1, 0},
+    {0x2de7, 1823, 224, 1, 0},
+    {0x2de8, 1824, 224, 1, 0},
+    {0x2de9, 1825, 224, 1, 0},
+    {0x2dea, 1826, 224, 1, 0},
+    {0x2deb, 1827, 224, 1, 0},
+    {0x2dec, 1828, 224, 1, 0},
+    {0x2ded, 1829, 224, 1, 0},
+    {0x2dee, 1830, 224, 1, 0},
+    {0x2def, 1831, 224, 1, 0},
+    {0x2df0, 1832, 224, 1, 0},
+    {0x2df1, 1833, 224, 1, 0},
+    {0x2df2, 1834, 224, 1, 0},
+    {0x2df3, 1835, 224, 1, 0},
+    {0x2df4, 1836, 224, 1, 0},
+    {0x2df5, 1837, 224, 1, 0},
+    {0x2df6, 1838, 224, 1, 0},
+    {0x2df7, 1839, 224, 1, 0},
+    {0x2df8, 1840, 224, 1, 0},
+    {0x2df9, 1841, 224, 1, 0},
+    {0x2dfa, 1842, 224, 1, 0},
+    {0x2dfb, 1843, 224, 1, 0},
+    {0x2dfc, 1844, 224, 1, 0},
+    {0x2dfd, 1845, 224, 1, 0},
+    {0x2dfe, 1846, 224, 1, 0},
+    {0x2dff, 1847, 224, 1, 0},
+    {0x302a, 1848, 224, 1, 0},
+    {0x302b, 1849, 224, 1, 0},
+    {0x302c, 1850, 224, 1, 0},
+    {0x302d, 1851, 224, 1, 0},
+    {0x302e, 1852, 224, 1, 0},
+    {0x302f, 1853, 224, 1, 0},
+    {0x304c, 1854, 1855, 1, 1},
+    {0x304e, 1856, 1857, 1, 1},
+    {0x3050, 1858, 1859, 1, 1},
+    {0x3052, 1860, 1861, 1, 1},
+    {0x3054, 1862, 1863, 1, 1},
+    {0x3056, 1864, 1865, 1, 1},
+    {0x3058, 1866, 1867, 1, 1},
+    {0x305a, 1868, 1869, 1, 1},
+    {0x305c, 1870, 1871, 1, 1},
+    {0x305e, 1872, 1873, 1, 1},
+    {0x3060, 1874, 1875, 1, 1},
+    {0x3062, 1876, 1877, 1, 1},
+    {0x3065, 1878, 1879, 1, 1},
+    {0x3067, 1880, 1881, 1, 1},
+    {0x3069, 1882, 1883, 1, 1},
+    {0x3070, 1884, 1885, 1, 1},
+    {0x3071, 1886, 1885, 1, 1},
+    {0x3073, 1887, 1888, 1, 1},
+    {0x3074, 1889, 1888, 1, 1},
+    {0x3076, 1890, 1891, 1, 1},
+    {0x3077, 1892, 1891, 1, 1},
+    {0x3079, 1893, 1894, 1, 1},
+    {0x307a, 1895, 1894, 1, 1},
+    {0x307c, 1896, 1897, 1, 1},
+    {0x307d, 1898, 1897, 1, 1},
+    {0x3094, 1899, 1900, 1, 1},
+    {0x3099, 1901, 224, 1, 0},
+    {0x309a, 1902, 224, 1, 0},
+    {0x309e, 1903, 1904, 1, 1},
+    {0x30ac, 1905, 1906, 1, 1},
+    {0x30ae, 1907, 1908, 1, 1},
+    {0x30b0, 1909, 1910, 1, 1},
+    {0x30b2, 1911, 1912, 1, 1},
+    {0x30b4, 1913, 1914, 1, 1},
+    {0x30b6, 1915, 1916, 1, 1},
+    {0x30b8, 1917, 1918, 1, 1},
+    {0x30ba, 1919, 1920, 1, 1},
+    {0x30bc, 1921, 1922, 1, 1},
+    {0x30be, 1923, 1924, 1, 1},
+    {0x30c0, 1925, 1926, 1, 1},
+    {0x30c2, 1927, 1928, 1, 1},
+    {0x30c5, 1929, 1930, 1, 1},
+    {0x30c7, 1931, 1932, 1, 1},
+    {0x30c9, 1933, 1934, 1, 1},
+    {0x30d0, 1935, 1936, 1, 1},
+    {0x30d1, 1937, 1936, 1, 1},
+    {0x30d3, 1938, 1939, 1, 1},
+    {0x30d4, 1940, 1939, 1, 1},
+    {0x30d6, 1941, 1942, 1, 1},
+    {0x30d7, 1943, 1942, 1, 1},
+    {0x30d9, 1944, 1945, 1, 1},
+    {0x30da, 1946, 1945, 1, 1},
+    {0x30dc, 1947, 1948, 1, 1},
+    {0x30dd, 1949, 1948, 1, 1},
+    {0x30f4, 1950, 1951, 1, 1},
+    {0x30f7, 1952, 1953, 1, 1},
+    {0x30f8, 1954, 1955, 1, 1},
+    {0x30f9, 1956, 1957, 1, 1},
+    {0x30fa, 1958, 1959, 1, 1},
+    {0x30fe, 1960, 1961, 1, 1},
+    {0xa640, 1962, 1962, 1, 1},
+    {0xa642, 1963, 1963, 1, 1},
+    {0xa644, 1964, 1964, 1, 1},
+    {0xa646, 1965, 1965, 1, 1},
+    {0xa648, 1966, 1966, 1, 1},
+    {0xa64a, 1069, 1069, 1, 1},
+    {0xa64c, 1967, 1967, 1, 1},
+    {0xa64e, 1968, 1968, 1, 1},
+    {0xa650, 1969, 1969, 1, 1},
+    {0xa652, 1970, 1970, 1, 1},
+    {0xa654, 1971, 1971, 1, 1},
+    {0xa656, 1972, 1972, 1, 1},
+    {0xa658, 1973, 1973, 1, 1},
+    {0xa65a, 1974, 1974, 1, 1},
+    {0xa65c, 1975, 1975, 1, 1},
+    {0xa65e, 1976, 1976, 1, 1},
+    {0xa660, 1977, 1977, 1, 1},
+    {0xa662, 1978, 1978, 1, 1},
+    {0xa664, 1979, 1979, 1, 1},
+    {0xa666, 1980, 1980, 1, 1},
+    {0xa668, 1981, 1981, 1, 1},
+    {0xa66a, 1982, 1982, 1, 1},
+    {0xa66c, 1983, 1983, 1, 1},
+    {0xa66f, 1984, 224, 1, 0},
+    {0xa674, 1985, 224, 1, 0},
+    {0xa675, 1986, 224, 1, 0},
+    {0xa676, 1987, 224, 1, 0},
+    {0xa677, 1988, 224, 1, 0},
+    {0xa678, 1989, 224, 1, 0},
+    {0xa679, 1990, 224, 1, 0},
+    {0xa67a, 1991, 224, 1, 0},
+    {0xa67b, 1992, 224, 1, 0},
+    {0xa67c, 1993, 224, 1, 0},
+    {0xa67d, 1994, 224, 1, 0},
+    {0xa680, 1995, 1995, 1, 1},
+    {0xa682, 1996, 1996, 1, 1},
+    {0xa684, 1997, 1997, 1, 1},
+    {0xa686, 1998, 1998, 1, 1},
+    {0xa688, 1999, 1999, 1, 1},
+    {0xa68a, 2000, 2000, 1, 1},
+    {0xa68c, 2001, 2001, 1, 1},
+    {0xa68e, 2002, 2002, 1, 1},
+    {0xa690, 2003, 2003, 1, 1},
+    {0xa692, 2004, 2004, 1, 1},
+    {0xa694, 2005, 2005, 1, 1},
+    {0xa696, 2006, 2006, 1, 1},
+    {0xa698, 2007, 2007, 1, 1},
+    {0xa69a, 2008, 2008, 1, 1},
+    {0xa69e, 2009, 224, 1, 0},
+    {0xa69f, 2010, 224, 1, 0},
+    {0xa6f0, 2011, 224, 1, 0},
+    {0xa6f1, 2012, 224, 1, 0},
+    {0xa722, 2013, 2013, 1, 1},
+    {0xa724, 2014, 2014, 1, 1},
+    {0xa726, 2015, 2015, 1, 1},
+    {0xa728, 2016, 2016, 1, 1},
+    {0xa72a, 2017, 2017, 1, 1},
+    {0xa72c, 2018, 2018, 1, 1},
+    {0xa72e, 2019, 2019, 1, 1},
+    {0xa732, 2020, 2020, 1, 1},
+    {0xa734, 2021, 2021, 1, 1},
+    {0xa736, 2022, 2022, 1, 1},
+    {0xa738, 2023, 2023, 1, 1},
+    {0xa73a, 2024, 2024, 1, 1},
+    {0xa73c, 2025, 2025, 1, 1},
+    {0xa73e, 2026, 2026, 1, 1},
+    {0xa740, 2027, 2027, 1, 1},
+    {0xa742, 2028, 2028, 1, 1},
+    {0xa744, 2029, 2029, 1, 1},
+    {0xa746, 2030, 2030, 1, 1},
+    {0xa748, 2031, 2031, 1, 1},
+    {0xa74a, 2032, 2032, 1, 1},
+    {0xa74c, 2033, 2033, 1, 1},
+    {0xa74e, 2034, 2034, 1, 1},
+    {0xa750, 2035, 2035, 1, 1},
+    {0xa752, 2036, 2036, 1, 1},
+    {0xa754, 2037, 2037, 1, 1},
+    {0xa756, 2038, 2038, 1, 1},
+    {0xa758, 2039, 2039, 1, 1},
+    {0xa75a, 2040, 2040, 1, 1},
+    {0xa75c, 2041, 2041, 1, 1},
+    {0xa75e, 2042, 2042, 1, 1},
+    {0xa760, 2043, 2043, 1, 1},
+    {0xa762, 2044, 2044, 1, 1},
+    {0xa764, 2045, 2045, 1, 1},
+    {0xa766, 2046, 2046, 1, 1},
+    {0xa768, 2047, 2047, 1, 1},
+    {0xa76a, 2048, 2048, 1, 1},
+    {0xa76c, 2049, 2049, 1, 1},
+    {0xa76e, 2050, 2050, 1, 1},
+    {0xa779, 2051, 2051, 1, 1},
+    {0xa77b, 2052, 2052, 1, 1},
+    {0xa77d, 2053, 2053, 1, 1},
+    {0xa77e, 2054, 2054, 1, 1},
+    {0xa780, 2055, 2055, 1, 1},
+    {0xa782, 2056, 2056, 1, 1},
+    {0xa784, 2057, 2057, 1, 1},
+    {0xa786, 2058, 2058, 1, 1},
+    {0xa78b, 2059, 2059, 1, 1},
+    {0xa78d, 2060, 2060, 1, 1},
+    {0xa790, 2061, 2061, 1, 1},
+    {0xa792, 2062, 2062, 1, 1},
+    {0xa796, 2063, 2063, 1, 1},
+    {0xa798, 2064, 2064, 1, 1},
+    {0xa79a, 2065, 2065, 1, 1},
+    {0xa79c, 2066, 2066, 1, 1},
+    {0xa79e, 2067, 2067, 1, 1},
+    {0xa7a0, 2068, 2068, 1, 1},
+    {0xa7a2, 2069, 2069, 1, 1},
+    {0xa7a4, 2070, 2070, 1, 1},
+    {0xa7a6, 2071, 2071, 1, 1},
+    {0xa7a8, 2072, 2072, 1, 1},
+    {0xa7aa, 2073, 2073, 1, 1},
+    {0xa7ab, 2074, 2074, 1, 1},
+    {0xa7ac, 2075, 2075, 1, 1},
+    {0xa7ad, 2076, 2076, 1, 1},
+    {0xa7ae, 2077, 2077, 1, 1},
+    {0xa7b0, 2078, 2078, 1, 1},
+    {0xa7b1, 2079, 2079, 1, 1},
+    {0xa7b2, 2080, 2080, 1, 1},
+    {0xa7b3, 2081, 2081, 1, 1},
+    {0xa7b4, 2082, 2082, 1, 1},
+    {0xa7b6, 2083, 2083, 1, 1},
+    {0xa7b8, 2084, 2084, 1, 1},
+    {0xa7ba, 2085, 2085, 1, 1},
+    {0xa7bc, 2086, 2086, 1, 1},
+    {0xa7be, 2087, 2087, 1, 1},
+    {0xa7c0, 2088, 2088, 1, 1},
+    {0xa7c2, 2089, 2089, 1, 1},
+    {0xa7c4, 2090, 2090, 1, 1},
+    {0xa7c5, 2091, 2091, 1, 1},
+    {0xa7c6, 2092, 2092, 1, 1},
+    {0xa7c7, 2093, 2093, 1, 1},
+    {0xa7c9, 2094, 2094, 1, 1},
+    {0xa7d0, 2095, 2095, 1, 1},
+    {0xa7d6, 2096, 2096, 1, 1},
+    {0xa7d8, 2097, 2097, 1, 1},
+    {0xa7f5, 2098, 2098, 1, 1},
+    {0xa806, 2099, 224, 1, 0},
+    {0xa82c, 2100, 224, 1, 0},
+    {0xa8c4, 2101, 224, 1, 0},
+    {0xa8e0, 2102, 224, 1, 0},
+    {0xa8e1, 2103, 224, 1, 0},
+    {0xa8e2, 2104, 224, 1, 0},
+    {0xa8e3, 2105, 224, 1, 0},
+    {0xa8e4, 2106, 224, 1, 0},
+    {0xa8e5, 2107, 224, 1, 0},
+    {0xa8e6, 2108, 224, 1, 0},
+    {0xa8e7, 2109, 224, 1, 0},
+    {0xa8e8, 2110, 224, 1, 0},
+    {0xa8e9, 2111, 224, 1, 0},
+    {0xa8ea, 2112, 224, 1, 0},
+    {0xa8eb, 2113, 224, 1, 0},
+    {0xa8ec, 2114, 224, 1, 0},
+    {0xa8ed, 2115, 224, 1, 0},
+    {0xa8ee, 2116, 224, 1, 0},
+    {0xa8ef, 2117, 224, 1, 0},
+    {0xa8f0, 2118, 224, 1, 0},
+    {0xa8f1, 2119, 224, 1, 0},
+    {0xa92b, 2120, 224, 1, 0},
+    {0xa92c, 2121, 224, 1, 0},
+    {0xa92d, 2122, 224, 1, 0},
+    {0xa953, 2123, 224, 1, 0},
+    {0xa9b3, 2124, 224, 1, 0},
+    {0xa9c0, 2125, 224, 1, 0},
+    {0xaab0, 2126, 224, 1, 0},
+    {0xaab2, 2127, 224, 1, 0},
+    {0xaab3, 2128, 224, 1, 0},
+    {0xaab4, 2129, 224, 1, 0},
+    {0xaab7, 2130, 224, 1, 0},
+    {0xaab8, 2131, 224, 1, 0},
+    {0xaabe, 2132, 224, 1, 0},
+    {0xaabf, 2133, 224, 1, 0},
+    {0xaac1, 2134, 224, 1, 0},
+    {0xaaf6, 2135, 224, 1, 0},
+    {0xab70, 2136, 2136, 1, 1},
+    {0xab71, 2137, 2137, 1, 1},
+    {0xab72, 2138, 2138, 1, 1},
+    {0xab73, 2139, 2139, 1, 1},
+    {0xab74, 2140, 2140, 1, 1},
+    {0xab75, 2141, 2141, 1, 1},
+    {0xab76, 2142, 2142, 1, 1},
+    {0xab77, 2143, 2143, 1, 1},
+    {0xab78, 2144, 2144, 1, 1},
+    {0xab79, 2145, 2145, 1, 1},
+    {0xab7a, 2146, 2146, 1, 1},
+    {0xab7b, 2147, 2147, 1, 1},
+    {0xab7c, 2148, 2148, 1, 1},
+    {0xab7d, 2149, 2149, 1, 1},
+    {0xab7e, 2150, 2150, 1, 1},
+    {0xab7f, 2151, 2151, 1, 1},
+    {0xab80, 2152, 2152, 1, 1},
+    {0xab81, 2153, 2153, 1, 1},
+    {0xab82, 2154, 2154, 1, 1},
+    {0xab83, 2155, 2155, 1, 1},
+    {0xab84, 2156, 2156, 1, 1},
+    {0xab85, 2157, 2157, 1, 1},
+    {0xab86, 2158, 2158, 1, 1},
+    {0xab87, 2159, 2159, 1, 1},
+    {0xab88, 2160, 2160, 1, 1},
+    {0xab89, 2161, 2161, 1, 1},
+    {0xab8a, 2162, 2162, 1, 1},
+    {0xab8b, 2163, 2163, 1, 1},
+    {0xab8c, 2164, 2164, 1, 1},
+    {0xab8d, 2165, 2165, 1, 1},
+    {0xab8e, 2166, 2166, 1, 1},
+    {0xab8f, 2167, 2167, 1, 1},
+    {0xab90, 2168, 2168, 1, 1},
+    {0xab91, 2169, 2169, 1, 1},
+    {0xab92, 2170, 2170, 1, 1},
+    {0xab93, 2171, 2171, 1, 1},
+    {0xab94, 2172, 2172, 1, 1},
+    {0xab95, 2173, 2173, 1, 1},
+    {0xab96, 2174, 2174, 1, 1},
+    {0xab97, 2175, 2175, 1, 1},
+    {0xab98, 2176, 2176, 1, 1},
+    {0xab99, 2177, 2177, 1, 1},
+    {0xab9a, 2178, 2178, 1, 1},
+    {0xab9b, 2179, 2179, 1, 1},
+    {0xab9c, 2180, 2180, 1, 1},
+    {0xab9d, 2181, 2181, 1, 1},
+    {0xab9e, 2182, 2182, 1, 1},
+    {0xab9f, 2183, 2183, 1, 1},
+    {0xaba0, 2184, 2184, 1, 1},
+    {0xaba1, 2185, 2185, 1, 1},
+    {0xaba2, 2186, 2186, 1, 1},
+    {0xaba3, 2187, 2187, 1, 1},
+    {0xaba4, 2188, 2188, 1, 1},
+    {0xaba5, 2189, 2189, 1, 1},
+    {0xaba6, 2190, 2190, 1, 1},
+    {0xaba7, 2191, 2191, 1, 1},
+    {0xaba8, 2192, 2192, 1, 1},
+    {0xaba9, 2193, 2193, 1, 1},
+    {0xabaa, 2194, 2194, 1, 1},
+    {0xabab, 2195, 2195, 1, 1},
+    {0xabac, 2196, 2196, 1, 1},
+    {0xabad, 2197, 2197, 1, 1},
+    {0xabae, 2198, 2198, 1, 1},
+    {0xabaf, 2199, 2199, 1, 1},
+    {0xabb0, 2200, 2200, 1, 1},
+    {0xabb1, 2201, 2201, 1, 1},
+    {0xabb2, 2202, 2202, 1, 1},
+    {0xabb3, 2203, 2203, 1, 1},
+    {0xabb4, 2204, 2204, 1, 1},
+    {0xabb5, 2205, 2205, 1, 1},
+    {0xabb6, 2206, 2206, 1, 1},
+    {0xabb7, 2207, 2207, 1, 1},
+    {0xabb8, 2208, 2208, 1, 1},
+    {0xabb9, 2209, 2209, 1, 1},
+    {0xabba, 2210, 2210, 1, 1},
+    {0xabbb, 2211, 2211, 1, 1},
+    {0xabbc, 2212, 2212, 1, 1},
+    {0xabbd, 2213, 2213, 1, 1},
+    {0xabbe, 2214, 2214, 1, 1},
+    {0xabbf, 2215, 2215, 1, 1},
+    {0xabed, 2216, 224, 1, 0},
+    {0xfb00, 2217, 2217, 2, 2},
+    {0xfb01, 2219, 2219, 2, 2},
+    {0xfb02, 2221, 2221, 2, 2},
+    {0xfb03, 2223, 2223, 3, 3},
+    {0xfb04, 2226, 2226, 3, 3},
+    {0xfb05, 2229, 2229, 2, 2},
+    {0xfb06, 2229, 2229, 2, 2},
+    {0xfb13, 2231, 2231, 2, 2},
+    {0xfb14, 2233, 2233, 2, 2},
+    {0xfb15, 2235, 2235, 2, 2},
+    {0xfb16, 2237, 2237, 2, 2},
+    {0xfb17, 2239, 2239, 2, 2},
+    {0xfb1d, 2241, 2242, 1, 1},
+    {0xfb1e, 2243, 224, 1, 0},
+    {0xfb1f, 2244, 2245, 1, 1},
+    {0xfb2a, 2246, 2247, 1, 1},
+    {0xfb2b, 2248, 2247, 1, 1},
+    {0xfb2c, 2249, 2247, 1, 1},
+    {0xfb2d, 2250, 2247, 1, 1},
+    {0xfb2e, 2251, 2252, 1, 1},
+    {0xfb2f, 2253, 2252, 1, 1},
+    {0xfb30, 2254, 2252, 1, 1},
+    {0xfb31, 2255, 2256, 1, 1},
+    {0xfb32, 2257, 2258, 1, 1},
+    {0xfb33, 2259, 2260, 1, 1},
+    {0xfb34, 2261, 2262, 1, 1},
+    {0xfb35, 2263, 2264, 1, 1},
+    {0xfb36, 2265, 2266, 1, 1},
+    {0xfb38, 2267, 2268, 1, 1},
+    {0xfb39, 2269, 2242, 1, 1},
+    {0xfb3a, 2270, 2271, 1, 1},
+    {0xfb3b, 2272, 2273, 1, 1},
+    {0xfb3c, 2274, 2275, 1, 1},
+    {0xfb3e, 2276, 2277, 1, 1},
+    {0xfb40, 2278, 2279, 1, 1},
+    {0xfb41, 2280, 2281, 1, 1},
+    {0xfb43, 2282, 2283, 1, 1},
+    {0xfb44, 2284, 2285, 1, 1},
+    {0xfb46, 2286, 2287, 1, 1},
+    {0xfb47, 2288, 2289, 1, 1},
+    {0xfb48, 2290, 2291, 1, 1},
+    {0xfb49, 2292, 2247, 1, 1},
+    {0xfb4a, 2293, 2294, 1, 1},
+    {0xfb4b, 2295, 2264, 1, 1},
+    {0xfb4c, 2296, 2256, 1, 1},
+    {0xfb4d, 2297, 2273, 1, 1},
+    {0xfb4e, 2298, 2285, 1, 1},
+    {0xfe20, 2299, 224, 1, 0},
+    {0xfe21, 2300, 224, 1, 0},
+    {0xfe22, 2301, 224, 1, 0},
+    {0xfe23, 2302, 224, 1, 0},
+    {0xfe24, 2303, 224, 1, 0},
+    {0xfe25, 2304, 224, 1, 0},
+    {0xfe26, 2305, 224, 1, 0},
+    {0xfe27, 2306, 224, 1, 0},
+    {0xfe28, 2307, 224, 1, 0},
+    {0xfe29, 2308, 224, 1, 0},
+    {0xfe2a, 2309, 224, 1, 0},
+    {0xfe2b, 2310, 224, 1, 0},
+    {0xfe2c, 2311, 224, 1, 0},
+    {0xfe2d, 2312, 224, 1, 0},
+    {0xfe2e, 2313, 224, 1, 0},
+    {0xfe2f, 2314, 224, 1, 0},
+    {0xff21, 2315, 2315, 1, 1},
+    {0xff22, 2316, 2316, 1, 1},
+    {0xff23, 2317, 2317, 1, 1},
+    {0xff24, 2318, 2318, 1, 1},
+    {0xff25, 2319, 2319, 1, 1},
+    {0xff26, 2320, 2320, 1, 1},
+    {0xff27, 2321, 2321, 1, 1},
+    {0xff28, 2322, 2322, 1, 1},
+    {0xff29, 2323, 2323, 1, 1},
+    {0xff2a, 2324, 2324, 1, 1},
+    {0xff2b, 2325, 2325, 1, 1},
+    {0xff2c, 2326, 2326, 1, 1},
+    {0xff2d, 2327, 2327, 1, 1},
+    {0xff2e, 2328, 2328, 1, 1},
+    {0xff2f, 2329, 2329, 1, 1},
+    {0xff30, 2330, 2330, 1, 1},
+    {0xff31, 2331, 2331, 1, 1},
+    {0xff32, 2332, 2332, 1, 1},
+    {0xff33, 2333, 2333, 1, 1},
+    {0xff34, 2334, 2334, 1, 1},
+    {0xff35, 2335, 2335, 1, 1},
+    {0xff36, 2336, 2336, 1, 1},
+    {0xff37, 2337, 2337, 1, 1},
+    {0xff38, 2338, 2338, 1, 1},
+    {0xff39, 2339, 2339, 1, 1},
+    {0xff3a, 2340, 2340, 1, 1},
+    {0x101fd, 2341, 224, 1, 0},
+    {0x102e0, 2342, 224, 1, 0},
+    {0x10376, 2343, 224, 1, 0},
+    {0x10377, 2344, 224, 1, 0},
+    {0x10378, 2345, 224, 1, 0},
+    {0x10379, 2346, 224, 1, 0},
+    {0x1037a, 2347, 224, 1, 0},
+    {0x10400, 2348, 2348, 1, 1},
+    {0x10401, 2349, 2349, 1, 1},
+    {0x10402, 2350, 2350, 1, 1},
+    {0x10403, 2351, 2351, 1, 1},
+    {0x10404, 2352, 2352, 1, 1},
+    {0x10405, 2353, 2353, 1, 1},
+    {0x10406, 2354, 2354, 1, 1},
+    {0x10407, 2355, 2355, 1, 1},
+    {0x10408, 2356, 2356, 1, 1},
+    {0x10409, 2357, 2357, 1, 1},
+    {0x1040a, 2358, 2358, 1, 1},
+    {0x1040b, 2359, 2359, 1, 1},
+    {0x1040c, 2360, 2360, 1, 1},
+    {0x1040d, 2361, 2361, 1, 1},
+    {0x1040e, 2362, 2362, 1, 1},
+    {0x1040f, 2363, 2363, 1, 1},
+    {0x10410, 2364, 2364, 1, 1},
+    {0x10411, 2365, 2365, 1, 1},
+    {0x10412, 2366, 2366, 1, 1},
+    {0x10413, 2367, 2367, 1, 1},
+    {0x10414, 2368, 2368, 1, 1},
+    {0x10415, 2369, 2369, 1, 1},
+    {0x10416, 2370, 2370, 1, 1},
+    {0x10417, 2371, 2371, 1, 1},
+    {0x10418, 2372, 2372, 1, 1},
+    {0x10419, 2373, 2373, 1, 1},
+    {0x1041a, 2374, 2374, 1, 1},
+    {0x1041b, 2375, 2375, 1, 1},
+    {0x1041c, 2376, 2376, 1, 1},
+    {0x1041d, 2377, 2377, 1, 1},
+    {0x1041e, 2378, 2378, 1, 1},
+    {0x1041f, 2379, 2379, 1, 1},
+    {0x10420, 2380, 2380, 1, 1},
+    {0x10421, 2381, 2381, 1, 1},
+    {0x10422, 2382, 2382, 1, 1},
+    {0x10423, 2383, 2383, 1, 1},
+    {0x10424, 2384, 2384, 1, 1},
+    {0x10425, 2385, 2385, 1, 1},
+    {0x10426, 2386, 2386, 1, 1},
+    {0x10427, 2387, 2387, 1, 1},
+    {0x104b0, 2388, 2388, 1, 1},
+    {0x104b1, 2389, 2389, 1, 1},
+    {0x104b2, 2390, 2390, 1, 1},
+    {0x104b3, 2391, 2391, 1, 1},
+    {0x104b4, 2392, 2392, 1, 1},
+    {0x104b5, 2393, 2393, 1, 1},
+    {0x104b6, 2394, 2394, 1, 1},
+    {0x104b7, 2395, 2395, 1, 1},
+    {0x104b8, 2396, 2396, 1, 1},
+    {0x104b9, 2397, 2397, 1, 1},
+    {0x104ba, 2398, 2398, 1, 1},
+    {0x104bb, 2399, 2399, 1, 1},
+    {0x104bc, 2400, 2400, 1, 1},
+    {0x104bd, 2401, 2401, 1, 1},
+    {0x104be, 2402, 2402, 1, 1},
+    {0x104bf, 2403, 2403, 1, 1},
+    {0x104c0, 2404, 2404, 1, 1},
+    {0x104c1, 2405, 2405, 1, 1},
+    {0x104c2, 2406, 2406, 1, 1},
+    {0x104c3, 2407, 2407, 1, 1},
+    {0x104c4, 2408, 2408, 1, 1},
+    {0x104c5, 2409, 2409, 1, 1},
+    {0x104c6, 2410, 2410, 1, 1},
+    {0x104c7, 2411, 2411, 1, 1},
+    {0x104c8, 2412, 2412, 1, 1},
+    {0x104c9, 2413, 2413, 1, 1},
+    {0x104ca, 2414, 2414, 1, 1},
+    {0x104cb, 2415, 2415, 1, 1},
+    {0x104cc, 2416, 2416, 1, 1},
+    {0x104cd, 2417, 2417, 1, 1},
+    {0x104ce, 2418, 2418, 1, 1},
+    {0x104cf, 2419, 2419, 1, 1},
+    {0x104d0, 2420, 2420, 1, 1},
+    {0x104d1, 2421, 2421, 1, 1},
+    {0x104d2, 2422, 2422, 1, 1},
+    {0x104d3, 2423, 2423, 1, 1},
+    {0x10570, 2424, 2424, 1, 1},
+    {0x10571, 2425, 2425, 1, 1},
+    {0x10572, 2426, 2426, 1, 1},
+    {0x10573, 2427, 2427, 1, 1},
+    {0x10574, 2428, 2428, 1, 1},
+    {0x10575, 2429, 2429, 1, 1},
+    {0x10576, 2430, 2430, 1, 1},
+    {0x10577, 2431, 2431, 1, 1},
+    {0x10578, 2432, 2432, 1, 1},
+    {0x10579, 2433, 2433, 1, 1},
+    {0x1057a, 2434, 2434, 1, 1},
+    {0x1057c, 2435, 2435, 1, 1},
+    {0x1057d, 2436, 2436, 1, 1},
+    {0x1057e, 2437, 2437, 1, 1},
+    {0x1057f, 2438, 2438, 1, 1},
+    {0x10580, 2439, 2439, 1, 1},
+    {0x10581, 2440, 2440, 1, 1},
+    {0x10582, 2441, 2441, 1, 1},
+    {0x10583, 2442, 2442, 1, 1},
+    {0x10584, 2443, 2443, 1, 1},
+    {0x10585, 2444, 2444, 1, 1},
+    {0x10586, 2445, 2445, 1, 1},
+    {0x10587, 2446, 2446, 1, 1},
+    {0x10588, 2447, 2447, 1, 1},
+    {0x10589, 2448, 2448, 1, 1},
+    {0x1058a, 2449, 2449, 1, 1},
+    {0x1058c, 2450, 2450, 1, 1},
+    {0x1058d, 2451, 2451, 1, 1},
+    {0x1058e, 2452, 2452, 1, 1},
+    {0x1058f, 2453, 2453, 1, 1},
+    {0x10590, 2454, 2454, 1, 1},
+    {0x10591, 2455, 2455, 1, 1},
+    {0x10592, 2456, 2456, 1, 1},
+    {0x10594, 2457, 2457, 1, 1},
+    {0x10595, 2458, 2458, 1, 1},
+    {0x10a0d, 2459, 224, 1, 0},
+    {0x10a0f, 2460, 224, 1, 0},
+    {0x10a38, 2461, 224, 1, 0},
+    {0x10a39, 2462, 224, 1, 0},
+    {0x10a3a, 2463, 224, 1, 0},
+    {0x10a3f, 2464, 224, 1, 0},
+    {0x10ae5, 2465, 224, 1, 0},
+    {0x10ae6, 2466, 224, 1, 0},
+    {0x10c80, 2467, 2467, 1, 1},
+    {0x10c81, 2468, 2468, 1, 1},
+    {0x10c82, 2469, 2469, 1, 1},
+    {0x10c83, 2470, 2470, 1, 1},
+    {0x10c84, 2471, 2471, 1, 1},
+    {0x10c85, 2472, 2472, 1, 1},
+    {0x10c86, 2473, 2473, 1, 1},
+    {0x10c87, 2474, 2474, 1, 1},
+    {0x10c88, 2475, 2475, 1, 1},
+    {0x10c89, 2476, 2476, 1, 1},
+    {0x10c8a, 2477, 2477, 1, 1},
+    {0x10c8b, 2478, 2478, 1, 1},
+    {0x10c8c, 2479, 2479, 1, 1},
+    {0x10c8d, 2480, 2480, 1, 1},
+    {0x10c8e, 2481, 2481, 1, 1},
+    {0x10c8f, 2482, 2482, 1, 1},
+    {0x10c90, 2483, 2483, 1, 1},
+    {0x10c91, 2484, 2484, 1, 1},
+    {0x10c92, 2485, 2485, 1, 1},
+    {0x10c93, 2486, 2486, 1, 1},
+    {0x10c94, 2487, 2487, 1, 1},
+    {0x10c95, 2488, 2488, 1, 1},
+    {0x10c96, 2489, 2489, 1, 1},
+    {0x10c97, 2490, 2490, 1, 1},
+    {0x10c98, 2491, 2491, 1, 1},
+    {0x10c99, 2492, 2492, 1, 1},
+    {0x10c9a, 2493, 2493, 1, 1},
+    {0x10c9b, 2494, 2494, 1, 1},
+    {0x10c9c, 2495, 2495, 1, 1},
+    {0x10c9d, 2496, 2496, 1, 1},
+    {0x10c9e, 2497, 2497, 1, 1},
+    {0x10c9f, 2498, 2498, 1, 1},
+    {0x10ca0, 2499, 2499, 1, 1},
+    {0x10ca1, 2500, 2500, 1, 1},
+    {0x10ca2, 2501, 2501, 1, 1},
+    {0x10ca3, 2502, 2502, 1, 1},
+    {0x10ca4, 2503, 2503, 1, 1},
+    {0x10ca5, 2504, 2504, 1, 1},
+    {0x10ca6, 2505, 2505, 1, 1},
+    {0x10ca7, 2506, 2506, 1, 1},
+    {0x10ca8, 2507, 2507, 1, 1},
+    {0x10ca9, 2508, 2508, 1, 1},
+    {0x10caa, 2509, 2509, 1, 1},
+    {0x10cab, 2510, 2510, 1, 1},
+    {0x10cac, 2511, 2511, 1, 1},
+    {0x10cad, 2512, 2512, 1, 1},
+    {0x10cae, 2513, 2513, 1, 1},
+    {0x10caf, 2514, 2514, 1, 1},
+    {0x10cb0, 2515, 2515, 1, 1},
+    {0x10cb1, 2516, 2516, 1, 1},
+    {0x10cb2, 2517, 2517, 1, 1},
+    {0x10d24, 2518, 224, 1, 0},
+    {0x10d25, 2519, 224, 1, 0},
+    {0x10d26, 2520, 224, 1, 0},
+    {0x10d27, 2521, 224, 1, 0},
+    {0x10eab, 2522, 224, 1, 0},
+    {0x10eac, 2523, 224, 1, 0},
+    {0x10f46, 2524, 224, 1, 0},
+    {0x10f47, 2525, 224, 1, 0},
+    {0x10f48, 2526, 224, 1, 0},
+    {0x10f49, 2527, 224, 1, 0},
+    {0x10f4a, 2528, 224, 1, 0},
+    {0x10f4b, 2529, 224, 1, 0},
+    {0x10f4c, 2530, 224, 1, 0},
+    {0x10f4d, 2531, 224, 1, 0},
+    {0x10f4e, 2532, 224, 1, 0},
+    {0x10f4f, 2533, 224, 1, 0},
+    {0x10f50, 2534, 224, 1, 0},
+    {0x10f82, 2535, 224, 1, 0},
+    {0x10f83, 2536, 224, 1, 0},
+    {0x10f84, 2537, 224, 1, 0},
+    {0x10f85, 2538, 224, 1, 0},
+    {0x11046, 2539, 224, 1, 0},
+    {0x11070, 2540, 224, 1, 0},
+    {0x1107f, 2541, 224, 1, 0},
+    {0x1109a, 2542, 2543, 1, 1},
+    {0x1109c, 2544, 2545, 1, 1},
+    {0x110ab, 2546, 2547, 1, 1},
+    {0x110b9, 2548, 224, 1, 0},
+    {0x110ba, 2549, 224, 1, 0},
+    {0x11100, 2550, 224, 1, 0},
+    {0x11101, 2551, 224, 1, 0},
+    {0x11102, 2552, 224, 1, 0},
+    {0x11133, 2553, 224, 1, 0},
+    {0x11134, 2554, 224, 1, 0},
+    {0x11173, 2555, 224, 1, 0},
+    {0x111c0, 2556, 224, 1, 0},
+    {0x111ca, 2557, 224, 1, 0},
+    {0x11235, 2558, 224, 1, 0},
+    {0x11236, 2559, 224, 1, 0},
+    {0x112e9, 2560, 224, 1, 0},
+    {0x112ea, 2561, 224, 1, 0},
+    {0x1133b, 2562, 224, 1, 0},
+    {0x1133c, 2563, 224, 1, 0},
+    {0x1134d, 2564, 224, 1, 0},
+    {0x11366, 2565, 224, 1, 0},
+    {0x11367, 2566, 224, 1, 0},
+    {0x11368, 2567, 224, 1, 0},
+    {0x11369, 2568, 224, 1, 0},
+    {0x1136a, 2569, 224, 1, 0},
+    {0x1136b, 2570, 224, 1, 0},
+    {0x1136c, 2571, 224, 1, 0},
+    {0x11370, 2572, 224, 1, 0},
+    {0x11371, 2573, 224, 1, 0},
+    {0x11372, 2574, 224, 1, 0},
+    {0x11373, 2575, 224, 1, 0},
+    {0x11374, 2576, 224, 1, 0},
+    {0x11442, 2577, 224, 1, 0},
+    {0x11446, 2578, 224, 1, 0},
+    {0x1145e, 2579, 224, 1, 0},
+    {0x114c2, 2580, 224, 1, 0},
+    {0x114c3, 2581, 224, 1, 0},
+    {0x115bf, 2582, 224, 1, 0},
+    {0x115c0, 2583, 224, 1, 0},
+    {0x1163f, 2584, 224, 1, 0},
+    {0x116b6, 2585, 224, 1, 0},
+    {0x116b7, 2586, 224, 1, 0},
+    {0x1172b, 2587, 224, 1, 0},
+    {0x11839, 2588, 224, 1, 0},
+    {0x1183a, 2589, 224, 1, 0},
+    {0x118a0, 2590, 2590, 1, 1},
+    {0x118a1, 2591, 2591, 1, 1},
+    {0x118a2, 2592, 2592, 1, 1},
+    {0x118a3, 2593, 2593, 1, 1},
+    {0x118a4, 2594, 2594, 1, 1},
+    {0x118a5, 2595, 2595, 1, 1},
+    {0x118a6, 2596, 2596, 1, 1},
+    {0x118a7, 2597, 2597, 1, 1},
+    {0x118a8, 2598, 2598, 1, 1},
+    {0x118a9, 2599, 2599, 1, 1},
+    {0x118aa, 2600, 2600, 1, 1},
+    {0x118ab, 2601, 2601, 1, 1},
+    {0x118ac, 2602, 2602, 1, 1},
+    {0x118ad, 2603, 2603, 1, 1},
+    {0x118ae, 2604, 2604, 1, 1},
+    {0x118af, 2605, 2605, 1, 1},
+    {0x118b0, 2606, 2606, 1, 1},
+    {0x118b1, 2607, 2607, 1, 1},
+    {0x118b2, 2608, 2608, 1, 1},
+    {0x118b3, 2609, 2609, 1, 1},
+    {0x118b4, 2610, 2610, 1, 1},
+    {0x118b5, 2611, 2611, 1, 1},
+    {0x118b6, 2612, 2612, 1, 1},
+    {0x118b7, 2613, 2613, 1, 1},
+    {0x118b8, 2614, 2614, 1, 1},
+    {0x118b9, 2615, 2615, 1, 1},
+    {0x118ba, 2616, 2616, 1, 1},
+    {0x118bb, 2617, 2617, 1, 1},
+    {0x118bc, 2618, 2618, 1, 1},
+    {0x118bd, 2619, 2619, 1, 1},
+    {0x118be, 2620, 2620, 1, 1},
+    {0x118bf, 2621, 2621, 1, 1},
+    {0x1193d, 2622, 224, 1, 0},
+    {0x1193e, 2623, 224, 1, 0},
+    {0x11943, 2624, 224, 1, 0},
+    {0x119e0, 2625, 224, 1, 0},
+    {0x11a34, 2626, 224, 1, 0},
+    {0x11a47, 2627, 224, 1, 0},
+    {0x11a99, 2628, 224, 1, 0},
+    {0x11c3f, 2629, 224, 1, 0},
+    {0x11d42, 2630, 224, 1, 0},
+    {0x11d44, 2631, 224, 1, 0},
+    {0x11d45, 2632, 224, 1, 0},
+    {0x11d97, 2633, 224, 1, 0},
+    {0x16af0, 2634, 224, 1, 0},
+    {0x16af1, 2635, 224, 1, 0},
+    {0x16af2, 2636, 224, 1, 0},
+    {0x16af3, 2637, 224, 1, 0},
+    {0x16af4, 2638, 224, 1, 0},
+    {0x16b30, 2639, 224, 1, 0},
+    {0x16b31, 2640, 224, 1, 0},
+    {0x16b32, 2641, 224, 1, 0},
+    {0x16b33, 2642, 224, 1, 0},
+    {0x16b34, 2643, 224, 1, 0},
+    {0x16b35, 2644, 224, 1, 0},
+    {0x16b36, 2645, 224, 1, 0},
+    {0x16e40, 2646, 2646, 1, 1},
+    {0x16e41, 2647, 2647, 1, 1},
+    {0x16e42, 2648, 2648, 1, 1},
+    {0x16e43, 2649, 2649, 1, 1},
+    {0x16e44, 2650, 2650, 1, 1},
+    {0x16e45, 2651, 2651, 1, 1},
+    {0x16e46, 2652, 2652, 1, 1},
+    {0x16e47, 2653, 2653, 1, 1},
+    {0x16e48, 2654, 2654, 1, 1},
+    {0x16e49, 2655, 2655, 1, 1},
+    {0x16e4a, 2656, 2656, 1, 1},
+    {0x16e4b, 2657, 2657, 1, 1},
+    {0x16e4c, 2658, 2658, 1, 1},
+    {0x16e4d, 2659, 2659, 1, 1},
+    {0x16e4e, 2660, 2660, 1, 1},
+    {0x16e4f, 2661, 2661, 1, 1},
+    {0x16e50, 2662, 2662, 1, 1},
+    {0x16e51, 2663, 2663, 1, 1},
+    {0x16e52, 2664, 2664, 1, 1},
+    {0x16e53, 2665, 2665, 1, 1},
+    {0x16e54, 2666, 2666, 1, 1},
+    {0x16e55, 2667, 2667, 1, 1},
+    {0x16e56, 2668, 2668, 1, 1},
+    {0x16e57, 2669, 2669, 1, 1},
+    {0x16e58, 2670, 2670, 1, 1},
+    {0x16e59, 2671, 2671, 1, 1},
+    {0x16e5a, 2672, 2672, 1, 1},
+    {0x16e5b, 2673, 2673, 1, 1},
+    {0x16e5c, 2674, 2674, 1, 1},
+    {0x16e5d, 2675, 2675, 1, 1},
+    {0x16e5e, 2676, 2676, 1, 1},
+    {0x16e5f, 2677, 2677, 1, 1},
+    {0x16ff0, 2678, 224, 1, 0},
+    {0x16ff1, 2679, 224, 1, 0},
+    {0x1bc9e, 2680, 224, 1, 0},
+    {0x1d15e, 2681, 2682, 1, 1},
+    {0x1d15f, 2683, 2684, 1, 1},
+    {0x1d160, 2685, 2684, 1, 1},
+    {0x1d161, 2686, 2684, 1, 1},
+    {0x1d162, 2687, 2684, 1, 1},
+    {0x1d163, 2688, 2684, 1, 1},
+    {0x1d164, 2689, 2684, 1, 1},
+    {0x1d165, 2690, 224, 1, 0},
+    {0x1d166, 2691, 224, 1, 0},
+    {0x1d167, 2692, 224, 1, 0},
+    {0x1d168, 2693, 224, 1, 0},
+    {0x1d169, 2694, 224, 1, 0},
+    {0x1d16d, 2695, 224, 1, 0},
+    {0x1d16e, 2696, 224, 1, 0},
+    {0x1d16f, 2697, 224, 1, 0},
+    {0x1d170, 2698, 224, 1, 0},
+    {0x1d171, 2699, 224, 1, 0},
+    {0x1d172, 2700, 224, 1, 0},
+    {0x1d17b, 2701, 224, 1, 0},
+    {0x1d17c, 2702, 224, 1, 0},
+    {0x1d17d, 2703, 224, 1, 0},
+    {0x1d17e, 2704, 224, 1, 0},
+    {0x1d17f, 2705, 224, 1, 0},
+    {0x1d180, 2706, 224, 1, 0},
+    {0x1d181, 2707, 224, 1, 0},
+    {0x1d182, 2708, 224, 1, 0},
+    {0x1d185, 2709, 224, 1, 0},
+    {0x1d186, 2710, 224, 1, 0},
+    {0x1d187, 2711, 224, 1, 0},
+    {0x1d188, 2712, 224, 1, 0},
+    {0x1d189, 2713, 224, 1, 0},
+    {0x1d18a, 2714, 224, 1, 0},
+    {0x1d18b, 2715, 224, 1, 0},
+    {0x1d1aa, 2716, 224, 1, 0},
+    {0x1d1ab, 2717, 224, 1, 0},
+    {0x1d1ac, 2718, 224, 1, 0},
+    {0x1d1ad, 2719, 224, 1, 0},
+    {0x1d1bb, 2720, 2721, 1, 1},
+    {0x1d1bc, 2722, 2723, 1, 1},
+    {0x1d1bd, 2724, 2721, 1, 1},
+    {0x1d1be, 2725, 2723, 1, 1},
+    {0x1d1bf, 2726, 2721, 1, 1},
+    {0x1d1c0, 2727, 2723, 1, 1},
+    {0x1d242, 2728, 224, 1, 0},
+    {0x1d243, 2729, 224, 1, 0},
+    {0x1d244, 2730, 224, 1, 0},
+    {0x1e000, 2731, 224, 1, 0},
+    {0x1e001, 2732, 224, 1, 0},
+    {0x1e002, 2733, 224, 1, 0},
+    {0x1e003, 2734, 224, 1, 0},
+    {0x1e004, 2735, 224, 1, 0},
+    {0x1e005, 2736, 224, 1, 0},
+    {0x1e006, 2737, 224, 1, 0},
+    {0x1e008, 2738, 224, 1, 0},
+    {0x1e009, 2739, 224, 1, 0},
+    {0x1e00a, 2740, 224, 1, 0},
+    {0x1e00b, 2741, 224, 1, 0},
+    {0x1e00c, 2742, 224, 1, 0},
+    {0x1e00d, 2743, 224, 1, 0},
+    {0x1e00e, 2744, 224, 1, 0},
+    {0x1e00f, 2745, 224, 1, 0},
+    {0x1e010, 2746, 224, 1, 0},
+    {0x1e011, 2747, 224, 1, 0},
+    {0x1e012, 2748, 224, 1, 0},
+    {0x1e013, 2749, 224, 1, 0},
+    {0x1e014, 2750, 224, 1, 0},
+    {0x1e015, 2751, 224, 1, 0},
+    {0x1e016, 2752, 224, 1, 0},
+    {0x1e017, 2753, 224, 1, 0},
+    {0x1e018, 2754, 224, 1, 0},
+    {0x1e01b, 2755, 224, 1, 0},
+    {0x1e01c, 2756, 224, 1, 0},
+    {0x1e01d, 2757, 224, 1, 0},
+    {0x1e01e, 2758, 224, 1, 0},
+    {0x1e01f, 2759, 224, 1, 0},
+    {0x1e020, 2760, 224, 1, 0},
+    {0x1e021, 2761, 224, 1, 0},
+    {0x1e023, 2762, 224, 1, 0},
+    {0x1e024, 2763, 224, 1, 0},
+    {0x1e026, 2764, 224, 1, 0},
+    {0x1e027, 2765, 224, 1, 0},
+    {0x1e028, 2766, 224, 1, 0},
+    {0x1e029, 2767, 224, 1, 0},
+    {0x1e02a, 2768, 224, 1, 0},
+    {0x1e130, 2769, 224, 1, 0},
+    {0x1e131, 2770, 224, 1, 0},
+    {0x1e132, 2771, 224, 1, 0},
+    {0x1e133, 2772, 224, 1, 0},
+    {0x1e134, 2773, 224, 1, 0},
+    {0x1e135, 2774, 224, 1, 0},
+    {0x1e136, 2775, 224, 1, 0},
+    {0x1e2ae, 2776, 224, 1, 0},
+    {0x1e2ec, 2777, 224, 1, 0},
+    {0x1e2ed, 2778, 224, 1, 0},
+    {0x1e2ee, 2779, 224, 1, 0},
+    {0x1e2ef, 2780, 224, 1, 0},
+    {0x1e8d0, 2781, 224, 1, 0},
+    {0x1e8d1, 2782, 224, 1, 0},
+    {0x1e8d2, 2783, 224, 1, 0},
+    {0x1e8d3, 2784, 224, 1, 0},
+    {0x1e8d4, 2785, 224, 1, 0},
+    {0x1e8d5, 2786, 224, 1, 0},
+    {0x1e8d6, 2787, 224, 1, 0},
+    {0x1e900, 2788, 2788, 1, 1},
+    {0x1e901, 2789, 2789, 1, 1},
+    {0x1e902, 2790, 2790, 1, 1},
+    {0x1e903, 2791, 2791, 1, 1},
+    {0x1e904, 2792, 2792, 1, 1},
+    {0x1e905, 2793, 2793, 1, 1},
+    {0x1e906, 2794, 2794, 1, 1},
+    {0x1e907, 2795, 2795, 1, 1},
+    {0x1e908, 2796, 2796, 1, 1},
+    {0x1e909, 2797, 2797, 1, 1},
+    {0x1e90a, 2798, 2798, 1, 1},
+    {0x1e90b, 2799, 2799, 1, 1},
+    {0x1e90c, 2800, 2800, 1, 1},
+    {0x1e90d, 2801, 2801, 1, 1},
+    {0x1e90e, 2802, 2802, 1, 1},
+    {0x1e90f, 2803, 2803, 1, 1},
+    {0x1e910, 2804, 2804, 1, 1},
+    {0x1e911, 2805, 2805, 1, 1},
+    {0x1e912, 2806, 2806, 1, 1},
+    {0x1e913, 2807, 2807, 1, 1},
+    {0x1e914, 2808, 2808, 1, 1},
+    {0x1e915, 2809, 2809, 1, 1},
+    {0x1e916, 2810, 2810, 1, 1},
+    {0x1e917, 2811, 2811, 1, 1},
+    {0x1e918, 2812, 2812, 1, 1},
+    {0x1e919, 2813, 2813, 1, 1},
+    {0x1e91a, 2814, 2814, 1, 1},
+    {0x1e91b, 2815, 2815, 1, 1},
+    {0x1e91c, 2816, 2816, 1, 1},
+    {0x1e91d, 2817, 2817, 1, 1},
+    {0x1e91e, 2818, 2818, 1, 1},
+    {0x1e91f, 2819, 2819, 1, 1},
+    {0x1e920, 2820, 2820, 1, 1},
+    {0x1e921, 2821, 2821, 1, 1},
+    {0x1e944, 2822, 224, 1, 0},
+    {0x1e945, 2823, 224, 1, 0},
+    {0x1e946, 2824, 224, 1, 0},
+    {0x1e947, 2825, 224, 1, 0},
+    {0x1e948, 2826, 224, 1, 0},
+    {0x1e949, 2827, 224, 1, 0},
+    {0x1e94a, 2828, 224, 1, 0},
+};
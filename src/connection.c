@@ -28,6 +28,8 @@ typedef struct FunctionCBInfo
   PyObject_HEAD const char *name; /* utf8 function name */
   PyObject *scalarfunc;           /* the function to call for stepping */
   PyObject *aggregatefactory;     /* factory for aggregate functions */
+  int windowfunction;             /* aggregatefactory also provides value and inverse */
+  int batchsize;                  /* most rows given to a batch function at once */
 } FunctionCBInfo;
 
 /* a particular aggregate function instance used as sqlite3_aggregate_context */
@@ -36,10 +38,56 @@ typedef struct _aggregatefunctioncontext
   PyObject *aggvalue;  /* the aggregation value passed as first parameter */
   PyObject *stepfunc;  /* step function */
   PyObject *finalfunc; /* final function */
+  PyObject *valuefunc;   /* window functions only */
+  PyObject *inversefunc; /* window functions only */
 } aggregatefunctioncontext;
 
+/* a batch function instance used as sqlite3_aggregate_context */
+typedef struct
+{
+  PyObject *columns;       /* list of each argument's values for the rows not yet discarded */
+  PyObject *results;       /* results so far, aligned with columns */
+  Py_ssize_t front;        /* rows in columns before this have left the frame */
+  Py_ssize_t nrows;        /* rows stepped */
+  Py_ssize_t nvalues;      /* values returned */
+  Py_ssize_t discarded;    /* rows removed from the start of columns and results */
+} batchfunctioncontext;
+
 /* CONNECTION TYPE */
 
+/* a row change recorded by set_changes_hook */
+typedef struct
+{
+  int op;   /* SQLITE_INSERT etc */
+  int name; /* index into names */
+  sqlite3_int64 rowid;
+} APSWChange;
+
+/* a running statement or a savepoint, and how many changes had been
+   recorded when it started */
+typedef struct
+{
+  sqlite3_stmt *stmt;
+  char *name; /* savepoint name */
+  size_t mark;
+} APSWChangesMark;
+
+typedef struct
+{
+  APSWChange *items;
+  size_t count, allocated;
+  char **names; /* database name and table name each null terminated */
+  int nnames;
+  int lastname;  /* most recently used index in names */
+  int nomem;     /* memory allocation failed so changes are incomplete */
+  int uncertain; /* a failed statement may have undone some changes */
+  sqlite3_stmt *suspect; /* ended after recording changes but none were counted */
+  APSWChangesMark *statements;
+  int nstatements, allocstatements;
+  APSWChangesMark *savepoints;
+  int nsavepoints;
+} APSWChanges;
+
 struct Connection
 {
   PyObject_HEAD
@@ -56,6 +104,9 @@ struct Connection
   PyObject *profile;
   PyObject *updatehook;
   PyObject *commithook;
+  PyObject *changeshook;
+  int changesbytable;
+  APSWChanges changes;
   PyObject *walhook;
   PyObject *progresshandler;
   PyObject *authorizer;
@@ -89,6 +140,15 @@ typedef struct _vtableinfo
              Connection* */
 } vtableinfo;
 
+/* a table valued function from create_table_function */
+typedef struct
+{
+  PyObject *generator;
+  int ncolumns; /* not including the hidden ones */
+  int nargs;
+  char *schema;
+} tablefunctioninfo;
+
 /* forward declarations */
 struct APSWBlob;
 static void APSWBlob_init(struct APSWBlob *self, Connection *connection, sqlite3_blob *blob);
@@ -96,13 +156,22 @@ static PyTypeObject APSWBlobType;
 
 struct APSWBackup;
 static void APSWBackup_init(struct APSWBackup *self, Connection *dest, Connection *source, sqlite3_backup *backup);
+static int APSWBackup_start(struct APSWBackup *self, const char *sourcedatabasename, int pages_per_step, sqlite3_int64 max_bytes_per_sec, PyObject *progress);
 static PyTypeObject APSWBackupType;
 
+#ifdef SQLITE_ENABLE_SESSION
+struct APSWSession;
+static void APSWSession_init(struct APSWSession *self, Connection *connection, sqlite3_session *session);
+static PyTypeObject APSWSessionType;
+#endif
+
 static PyTypeObject APSWCursorType;
 
 struct ZeroBlobBind;
 static PyTypeObject ZeroBlobBindType;
 
+static void changes_free(APSWChanges *changes);
+
 static void
 FunctionCBInfo_dealloc(FunctionCBInfo *self)
 {
@@ -130,6 +199,8 @@ Connection_internal_cleanup(Connection *self)
   Py_CLEAR(self->profile);
   Py_CLEAR(self->updatehook);
   Py_CLEAR(self->commithook);
+  Py_CLEAR(self->changeshook);
+  changes_free(&self->changes);
   Py_CLEAR(self->walhook);
   Py_CLEAR(self->progresshandler);
   Py_CLEAR(self->authorizer);
@@ -316,6 +387,9 @@ Connection_new(PyTypeObject *type, PyObject *Py_UNUSED(args), PyObject *Py_UNUSE
     self->profile = 0;
     self->updatehook = 0;
     self->commithook = 0;
+    self->changeshook = 0;
+    self->changesbytable = 0;
+    memset(&self->changes, 0, sizeof(self->changes));
     self->walhook = 0;
     self->progresshandler = 0;
     self->authorizer = 0;
@@ -669,6 +743,418 @@ finally:
   return result;
 }
 
+/** .. method:: backup_async(databasename: str, sourceconnection: Connection, sourcedatabasename: str, pages_per_step: int = 256, max_bytes_per_sec: int = 0, progress: Optional[Callable[[int, int], None]] = None)  -> Backup
+
+   Opens a :ref:`backup object <Backup>` the same as :meth:`backup`,
+   and then copies the pages in a background thread.  The GIL is not
+   held while copying.  See :ref:`Backup` for more details.
+
+   :param pages_per_step: How many pages are copied each step.  The
+     source is locked during each step, so smaller values let writers
+     in more often.
+   :param max_bytes_per_sec: Limits how fast pages are copied by
+     sleeping between steps.  Zero means no limit.
+   :param progress: Called after each step with the number of pages
+     remaining and the total number of pages.  It is called in the
+     background thread.  If it raises an exception then copying stops.
+
+   If the source is busy or locked then copying waits and tries again.
+   Use :meth:`backup.wait` to wait for completion and get any error,
+   and then :meth:`backup.finish` which stops copying if it hasn't
+   completed.
+
+   :rtype: :class:`backup`
+
+   -* sqlite3_backup_init sqlite3_backup_step sqlite3_backup_remaining sqlite3_backup_pagecount
+*/
+static PyObject *
+Connection_backup_async(Connection *self, PyObject *args, PyObject *kwds)
+{
+  const char *databasename = NULL, *sourcedatabasename = NULL;
+  Connection *sourceconnection = NULL;
+  int pages_per_step = 256;
+  long long max_bytes_per_sec = 0;
+  PyObject *progress = NULL, *backupargs, *backup;
+
+  CHECK_USE(NULL);
+  CHECK_CLOSED(self, NULL);
+
+  {
+    static char *kwlist[] = {"databasename", "sourceconnection", "sourcedatabasename", "pages_per_step", "max_bytes_per_sec", "progress", NULL};
+    Connection_backup_async_CHECK;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "sO!s|iLO&:" Connection_backup_async_USAGE, kwlist, &databasename, &ConnectionType, &sourceconnection, &sourcedatabasename, &pages_per_step, &max_bytes_per_sec, argcheck_Optional_Callable, &progress))
+      return NULL;
+  }
+  if (pages_per_step < 1)
+    return PyErr_Format(PyExc_ValueError, "pages_per_step must be at least one not %d", pages_per_step);
+  if (max_bytes_per_sec < 0)
+    return PyErr_Format(PyExc_ValueError, "max_bytes_per_sec can't be negative");
+
+  backupargs = Py_BuildValue("(sOs)", databasename, sourceconnection, sourcedatabasename);
+  if (!backupargs)
+    return NULL;
+  backup = Connection_backup(self, backupargs, NULL);
+  Py_DECREF(backupargs);
+  if (!backup)
+    return NULL;
+
+  if (APSWBackup_start((struct APSWBackup *)backup, sourcedatabasename, pages_per_step, max_bytes_per_sec, progress))
+  {
+    PyObject *etype, *eval, *etb, *res;
+    PyErr_Fetch(&etype, &eval, &etb);
+    res = PyObject_CallMethod(backup, "close", "O", Py_True);
+    Py_XDECREF(res);
+    Py_DECREF(backup);
+    PyErr_Restore(etype, eval, etb);
+    return NULL;
+  }
+  return backup;
+}
+
+#ifdef SQLITE_ENABLE_SESSION
+/** .. method:: session(schema: str = "main") -> Session
+
+  Starts a :ref:`session <session>` recording changes made to
+  *schema*, which you use to make changesets for applying to other
+  databases.  Call :meth:`Session.attach` to say which tables to
+  record.
+
+  :param schema: ``main``, ``temp`` or the name of an `attached
+    <https://sqlite.org/lang_attach.html>`_ database.
+
+  .. seealso::
+
+    * :meth:`~Connection.apply_changeset`
+
+  -* sqlite3session_create
+*/
+static PyObject *
+Connection_session(Connection *self, PyObject *args, PyObject *kwds)
+{
+  struct APSWSession *apswsession = 0;
+  sqlite3_session *session = 0;
+  const char *schema = "main";
+  int res;
+  PyObject *weakref;
+
+  CHECK_USE(NULL);
+  CHECK_CLOSED(self, NULL);
+
+  {
+    static char *kwlist[] = {"schema", NULL};
+    Connection_session_CHECK;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|s:" Connection_session_USAGE, kwlist, &schema))
+      return NULL;
+  }
+  PYSQLITE_CON_CALL(res = sqlite3session_create(self->db, schema, &session));
+
+  SET_EXC(res, self->db);
+  if (res != SQLITE_OK)
+    return NULL;
+
+  apswsession = PyObject_New(struct APSWSession, &APSWSessionType);
+  if (!apswsession)
+  {
+    PYSQLITE_CON_CALL(sqlite3session_delete(session));
+    return NULL;
+  }
+
+  APSWSession_init(apswsession, self, session);
+  weakref = PyWeakref_NewRef((PyObject *)apswsession, NULL);
+  PyList_Append(self->dependents, weakref);
+  Py_DECREF(weakref);
+  return (PyObject *)apswsession;
+}
+
+/* the callables given to apply_changeset */
+typedef struct
+{
+  PyObject *changeset; /* when streaming */
+  PyObject *conflict;
+  PyObject *filter;
+} changesetapplyinfo;
+
+/* Called by SQLite for more of a streamed changeset.  *len is how
+   much is wanted and is set to how much was provided, with zero
+   meaning the end */
+static int
+changeset_input_cb(void *context, void *data, int *len)
+{
+  PyGILState_STATE gilstate;
+  changesetapplyinfo *info = (changesetapplyinfo *)context;
+  PyObject *retval = NULL;
+  Py_buffer buffer;
+  int res = SQLITE_ERROR;
+
+  gilstate = PyGILState_Ensure();
+
+  if (PyErr_Occurred())
+    goto finally;
+
+  retval = PyObject_CallFunction(info->changeset, "(i)", *len);
+  if (!retval)
+  {
+    AddTraceBackHere(__FILE__, __LINE__, "Connection.apply_changeset.input", "{s: O, s: i}", "changeset", OBJ(info->changeset), "len", *len);
+    goto finally;
+  }
+  if (PyObject_GetBuffer(retval, &buffer, PyBUF_SIMPLE))
+    goto finally;
+  if (buffer.len > *len)
+    PyErr_Format(PyExc_ValueError, "changeset callable returned %zd bytes but only %d were asked for", buffer.len, *len);
+  else
+  {
+    memcpy(data, buffer.buf, buffer.len);
+    *len = (int)buffer.len;
+    res = SQLITE_OK;
+  }
+  PyBuffer_Release(&buffer);
+
+finally:
+  Py_XDECREF(retval);
+  PyGILState_Release(gilstate);
+  return res;
+}
+
+/* Called by SQLite to ask if changes to a table should be applied */
+static int
+changeset_filter_cb(void *context, const char *table)
+{
+  PyGILState_STATE gilstate;
+  changesetapplyinfo *info = (changesetapplyinfo *)context;
+  PyObject *retval = NULL;
+  int result = 0;
+
+  gilstate = PyGILState_Ensure();
+
+  if (PyErr_Occurred())
+    goto finally;
+
+  retval = PyObject_CallFunction(info->filter, "(s)", table);
+  if (!retval)
+  {
+    AddTraceBackHere(__FILE__, __LINE__, "Connection.apply_changeset.filter", "{s: s}", "table", table);
+    goto finally;
+  }
+  result = PyObject_IsTrue(retval);
+  if (result < 0)
+    result = 0;
+
+finally:
+  Py_XDECREF(retval);
+  PyGILState_Release(gilstate);
+  return result;
+}
+
+/* old, new or conflicting values of the change as a tuple.  Columns
+   not in the change are None */
+static PyObject *
+changeset_values(sqlite3_changeset_iter *iter, int ncols, int (*get)(sqlite3_changeset_iter *, int, sqlite3_value **))
+{
+  PyObject *values = PyTuple_New(ncols);
+  int i;
+
+  for (i = 0; values && i < ncols; i++)
+  {
+    sqlite3_value *value = NULL;
+    PyObject *item;
+
+    if (get(iter, i, &value) != SQLITE_OK)
+      value = NULL;
+    if (value)
+      item = convert_value_to_pyobject(value);
+    else
+    {
+      item = Py_None;
+      Py_INCREF(item);
+    }
+    if (!item)
+      Py_CLEAR(values);
+    else
+      PyTuple_SET_ITEM(values, i, item);
+  }
+  return values;
+}
+
+/* Called by SQLite when a change can't be applied as is.  Returns
+   what to do about it */
+static int
+changeset_conflict_cb(void *context, int conflict, sqlite3_changeset_iter *iter)
+{
+  PyGILState_STATE gilstate;
+  changesetapplyinfo *info = (changesetapplyinfo *)context;
+  PyObject *old = NULL, *new = NULL, *conflicting = NULL, *retval = NULL;
+  const char *table = NULL;
+  int result = SQLITE_CHANGESET_ABORT, ncols = 0, op = 0, indirect;
+
+  gilstate = PyGILState_Ensure();
+
+  if (PyErr_Occurred() || !info->conflict)
+    goto finally;
+
+  if (conflict == SQLITE_CHANGESET_FOREIGN_KEY)
+  {
+    /* not at a change - conflicting is how many foreign key
+       constraints are violated */
+    int count = 0;
+    sqlite3changeset_fk_conflicts(iter, &count);
+    conflicting = PyLong_FromLong(count);
+  }
+  else
+  {
+    sqlite3changeset_op(iter, &table, &ncols, &op, &indirect);
+    if (op != SQLITE_INSERT && !(old = changeset_values(iter, ncols, sqlite3changeset_old)))
+      goto finally;
+    if (op != SQLITE_DELETE && !(new = changeset_values(iter, ncols, sqlite3changeset_new)))
+      goto finally;
+    if (conflict == SQLITE_CHANGESET_DATA || conflict == SQLITE_CHANGESET_CONFLICT)
+      conflicting = changeset_values(iter, ncols, sqlite3changeset_conflict);
+    else
+    {
+      conflicting = Py_None;
+      Py_INCREF(conflicting);
+    }
+  }
+  if (!conflicting)
+    goto finally;
+
+  retval = PyObject_CallFunction(info->conflict, "(iziOOO)", conflict, table, op, OBJ(old), OBJ(new), conflicting);
+  if (!retval)
+  {
+    AddTraceBackHere(__FILE__, __LINE__, "Connection.apply_changeset.conflict", "{s: i, s: s, s: i}", "conflict", conflict, "table", table ? table : "", "op", op);
+    goto finally;
+  }
+  if (!PyLong_Check(retval))
+  {
+    PyErr_Format(PyExc_TypeError, "Conflict callback must return an int");
+    goto finally;
+  }
+  result = PyLong_AsLong(retval);
+  if (PyErr_Occurred() || (result != SQLITE_CHANGESET_OMIT && result != SQLITE_CHANGESET_REPLACE && result != SQLITE_CHANGESET_ABORT))
+  {
+    if (!PyErr_Occurred())
+      PyErr_Format(PyExc_ValueError, "Conflict callback returned %d which is not SQLITE_CHANGESET_OMIT, SQLITE_CHANGESET_REPLACE or SQLITE_CHANGESET_ABORT", result);
+    result = SQLITE_CHANGESET_ABORT;
+  }
+
+finally:
+  Py_XDECREF(old);
+  Py_XDECREF(new);
+  Py_XDECREF(conflicting);
+  Py_XDECREF(retval);
+  PyGILState_Release(gilstate);
+  return result;
+}
+
+/** .. method:: apply_changeset(changeset: Union[bytes, Callable[[int], bytes]], conflict: Optional[Callable[[int, Optional[str], int, Optional[tuple], Optional[tuple], Any], int]] = None, filter: Optional[Callable[[str], bool]] = None, flags: int = 0) -> None
+
+  Applies a changeset or patchset made by a :class:`Session`, usually
+  on another database.  All the changes are applied or none are.
+
+  :param changeset: The changeset as bytes (or anything supporting
+    the buffer protocol).  To avoid having it all in memory, supply a
+    callable instead that is called with the maximum number of bytes
+    wanted and returns up to that many, with empty meaning the end.
+    The read method of a file does exactly that.
+  :param conflict: Called when a change can't be applied as is, for
+    example because the row to update is missing or has different
+    values.  It is called with the :attr:`conflict type
+    <apsw.mapping_session_conflict>`, the table name, the operation
+    (``SQLITE_INSERT``, ``SQLITE_UPDATE`` or ``SQLITE_DELETE``), a tuple
+    of the old values (None for inserts), a tuple of the new values
+    (None for deletes), and a tuple of the conflicting row's values
+    for ``SQLITE_CHANGESET_DATA`` and ``SQLITE_CHANGESET_CONFLICT``
+    (else None).  Values not in the change are None in the tuples.  It
+    must return one of the :attr:`responses
+    <apsw.mapping_session_conflict_response>`.
+
+    ``SQLITE_CHANGESET_FOREIGN_KEY`` is given once at the end if
+    foreign key constraints would be violated, with a table of None,
+    operation of zero, and the number of violations instead of the
+    conflicting row.  Returning ``SQLITE_CHANGESET_OMIT`` keeps the
+    changes anyway.
+
+    If *conflict* is None then any conflict aborts.
+  :param filter: Called with each table name and returns if changes
+    to that table should be applied.  None applies all the tables.
+  :param flags: Zero or more :attr:`flags
+    <apsw.mapping_session_changeset_apply_flags>` or-ed together.
+
+  An exception in a callback aborts, so nothing is applied and the
+  exception is raised.  A :exc:`AbortError` is raised if *conflict*
+  returns ``SQLITE_CHANGESET_ABORT``.
+
+  -* sqlite3changeset_apply_v2 sqlite3changeset_apply_v2_strm
+*/
+static PyObject *
+Connection_apply_changeset(Connection *self, PyObject *args, PyObject *kwds)
+{
+  PyObject *changeset, *conflict = NULL, *filter = NULL;
+  changesetapplyinfo info;
+  Py_buffer buffer;
+  int flags = 0, res, applyres, savepoint;
+
+  CHECK_USE(NULL);
+  CHECK_CLOSED(self, NULL);
+
+  {
+    static char *kwlist[] = {"changeset", "conflict", "filter", "flags", NULL};
+    Connection_apply_changeset_CHECK;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|O&O&i:" Connection_apply_changeset_USAGE, kwlist, &changeset, argcheck_Optional_Callable, &conflict, argcheck_Optional_Callable, &filter, &flags))
+      return NULL;
+  }
+
+  info.changeset = PyCallable_Check(changeset) ? changeset : NULL;
+  info.conflict = conflict;
+  info.filter = filter;
+
+  if (!info.changeset && PyObject_GetBuffer(changeset, &buffer, PyBUF_SIMPLE))
+    return NULL;
+  if (!info.changeset && buffer.len > APSW_INT32_MAX)
+  {
+    PyBuffer_Release(&buffer);
+    return PyErr_Format(PyExc_ValueError, "changeset is too large");
+  }
+
+  /* SQLite can't be told to abort from the filter, so an exception
+     there is undone with our own savepoint */
+  savepoint = filter && !(flags & SQLITE_CHANGESETAPPLY_NOSAVEPOINT);
+  res = SQLITE_OK;
+  if (savepoint)
+    PYSQLITE_CON_CALL(res = sqlite3_exec(self->db, "SAVEPOINT apsw_apply_changeset", NULL, NULL, NULL));
+
+  if (res == SQLITE_OK)
+  {
+    if (info.changeset)
+      PYSQLITE_CON_CALL(res = sqlite3changeset_apply_v2_strm(self->db, changeset_input_cb, &info, filter ? changeset_filter_cb : NULL,
+                                                             changeset_conflict_cb, &info, NULL, NULL, flags));
+    else
+      PYSQLITE_CON_CALL(res = sqlite3changeset_apply_v2(self->db, (int)buffer.len, buffer.buf, filter ? changeset_filter_cb : NULL,
+                                                        changeset_conflict_cb, &info, NULL, NULL, flags));
+    applyres = res;
+    SET_EXC(res, self->db);
+
+    if (savepoint)
+    {
+      if (PyErr_Occurred())
+        PYSQLITE_CON_CALL(res = sqlite3_exec(self->db, "ROLLBACK TO apsw_apply_changeset; RELEASE apsw_apply_changeset", NULL, NULL, NULL));
+      else
+        PYSQLITE_CON_CALL(res = sqlite3_exec(self->db, "RELEASE apsw_apply_changeset", NULL, NULL, NULL));
+    }
+    if (applyres != SQLITE_OK)
+      res = applyres;
+  }
+
+  if (!info.changeset)
+    PyBuffer_Release(&buffer);
+
+  SET_EXC(res, self->db);
+  if (PyErr_Occurred())
+    return NULL;
+
+  Py_RETURN_NONE;
+}
+#endif
+
 /** .. method:: cursor() -> Cursor
 
   Creates a new :class:`Cursor` object on this database.
@@ -895,41 +1381,474 @@ Connection_limit(Connection *self, PyObject *args, PyObject *kwds)
   return PyLong_FromLong(res);
 }
 
+/* CHANGE CAPTURE
+
+   Changes are recorded by the update hook into a buffer without
+   needing the GIL, and given to Python at commit or rollback.  Each
+   distinct database and table name pair is stored once.
+
+   A trace callback notes how many changes had been recorded when each
+   statement and savepoint started.  ROLLBACK TO a savepoint truncates
+   the buffer back to that point.  A failed statement may or may not
+   have undone its changes depending on the conflict resolution.
+   SQLite doesn't tell the trace callback if the statement failed, so
+   a statement that ends with changes recorded but none counted is a
+   suspect, and if stepping it then returns an error the batch is
+   marked uncertain. */
+
 static void
-updatecb(void *context, int updatetype, char const *databasename, char const *tablename, sqlite3_int64 rowid)
+changes_savepoints_clear(APSWChanges *changes, int keep)
 {
-  /* The hook returns void. That makes it impossible for us to
-     abort immediately due to an error in the callback */
+  int i;
 
-  PyGILState_STATE gilstate;
-  PyObject *retval = NULL;
-  Connection *self = (Connection *)context;
+  for (i = keep; i < changes->nsavepoints; i++)
+    sqlite3_free(changes->savepoints[i].name);
+  changes->nsavepoints = keep;
+}
 
-  assert(self);
-  assert(self->updatehook);
-  assert(self->updatehook != Py_None);
+/* empties the buffer at the end of a transaction.  Statements can
+   still be running so they are kept. */
+static void
+changes_clear(APSWChanges *changes)
+{
+  int i;
 
-  gilstate = PyGILState_Ensure();
+  for (i = 0; i < changes->nnames; i++)
+    sqlite3_free(changes->names[i]);
+  sqlite3_free(changes->names);
+  sqlite3_free(changes->items);
+  changes->items = NULL;
+  changes->names = NULL;
+  changes->count = changes->allocated = 0;
+  changes->nnames = changes->lastname = 0;
+  changes->nomem = changes->uncertain = 0;
+  changes->suspect = NULL;
+  changes_savepoints_clear(changes, 0);
+  for (i = 0; i < changes->nstatements; i++)
+    changes->statements[i].mark = 0;
+}
 
-  if (PyErr_Occurred())
-    goto finally; /* abort hook due to outstanding exception */
+static void
+changes_free(APSWChanges *changes)
+{
+  changes_clear(changes);
+  sqlite3_free(changes->statements);
+  sqlite3_free(changes->savepoints);
+  memset(changes, 0, sizeof(APSWChanges));
+}
 
-  retval = PyObject_CallFunction(self->updatehook, "(iO&O&L)", updatetype, convertutf8string, databasename, convertutf8string, tablename, rowid);
+static void
+changes_record(APSWChanges *changes, int op, const char *databasename, const char *tablename, sqlite3_int64 rowid)
+{
+  int name = changes->lastname;
 
-finally:
-  Py_XDECREF(retval);
-  PyGILState_Release(gilstate);
-}
+  if (changes->nomem)
+    return;
 
-/** .. method:: setupdatehook(callable: Optional[Callable]) -> None
+  if (name >= changes->nnames || strcmp(tablename, changes->names[name] + strlen(changes->names[name]) + 1) || strcmp(databasename, changes->names[name]))
+  {
+    for (name = 0; name < changes->nnames; name++)
+      if (0 == strcmp(databasename, changes->names[name]) && 0 == strcmp(tablename, changes->names[name] + strlen(changes->names[name]) + 1))
+        break;
+    if (name == changes->nnames)
+    {
+      char **names = sqlite3_realloc64(changes->names, sizeof(char *) * (changes->nnames + 1));
+      size_t dblen = strlen(databasename) + 1, tablelen = strlen(tablename) + 1;
+
+      if (!names)
+        goto nomem;
+      changes->names = names;
+      names[name] = sqlite3_malloc64(dblen + tablelen);
+      if (!names[name])
+        goto nomem;
+      memcpy(names[name], databasename, dblen);
+      memcpy(names[name] + dblen, tablename, tablelen);
+      changes->nnames++;
+    }
+    changes->lastname = name;
+  }
 
-  Calls *callable* whenever a row is updated, deleted or inserted.  If
-  *callable* is :const:`None` then any existing update hook is
-  unregistered.  The update hook cannot make changes to the database while
-  the query is still executing, but can record them for later use or
-  apply them in a different connection.
+  if (changes->count == changes->allocated)
+  {
+    size_t allocated = changes->allocated ? changes->allocated * 2 : 256;
+    APSWChange *items = sqlite3_realloc64(changes->items, allocated * sizeof(APSWChange));
 
-  The update hook is called with 4 parameters:
+    if (!items)
+      goto nomem;
+    changes->items = items;
+    changes->allocated = allocated;
+  }
+  changes->items[changes->count].op = op;
+  changes->items[changes->count].name = name;
+  changes->items[changes->count].rowid = rowid;
+  changes->count++;
+  return;
+
+nomem:
+  changes->nomem = 1;
+}
+
+/* copies the next word or name from sql into token, skipping
+   whitespace and comments and removing quoting.  Returns where it
+   ended or NULL if there wasn't one or it didn't fit. */
+static const char *
+changes_token(const char *sql, char *token, size_t size)
+{
+  char quote = 0;
+  size_t len = 0;
+
+  for (;;)
+  {
+    while (*sql == ' ' || *sql == '\t' || *sql == '\n' || *sql == '\r' || *sql == '\f')
+      sql++;
+    if (sql[0] == '-' && sql[1] == '-')
+    {
+      sql = strchr(sql, '\n');
+      if (!sql)
+        return NULL;
+    }
+    else if (sql[0] == '/' && sql[1] == '*')
+    {
+      sql = strstr(sql + 2, "*/");
+      if (!sql)
+        return NULL;
+      sql += 2;
+    }
+    else
+      break;
+  }
+
+  if (*sql == '"' || *sql == '\'' || *sql == '`')
+    quote = *sql;
+  else if (*sql == '[')
+    quote = ']';
+
+  if (quote)
+  {
+    for (sql++; *sql; sql++)
+    {
+      if (*sql == quote)
+      {
+        if (quote == ']' || sql[1] != quote)
+          break;
+        sql++;
+      }
+      if (len + 1 == size)
+        return NULL;
+      token[len++] = *sql;
+    }
+    if (!*sql)
+      return NULL;
+    sql++;
+  }
+  else
+  {
+    while ((*sql >= 'a' && *sql <= 'z') || (*sql >= 'A' && *sql <= 'Z') || (*sql >= '0' && *sql <= '9') || *sql == '_' || *sql == '$' || (unsigned char)*sql >= 0x80)
+    {
+      if (len + 1 == size)
+        return NULL;
+      token[len++] = *sql++;
+    }
+    if (!len)
+      return NULL;
+  }
+  token[len] = 0;
+  return sql;
+}
+
+/* updates the savepoints if sql is SAVEPOINT, RELEASE or ROLLBACK TO */
+static void
+changes_savepoint(APSWChanges *changes, const char *sql)
+{
+  char word[16], *name = NULL;
+  size_t size;
+  int i, release = 0, rollbackto = 0;
+
+  /* the keywords are short so anything longer is some other statement */
+  sql = changes_token(sql, word, sizeof(word));
+  if (!sql)
+    return;
+  if (0 == sqlite3_stricmp(word, "RELEASE"))
+    release = 1;
+  else if (0 == sqlite3_stricmp(word, "ROLLBACK"))
+    rollbackto = 1;
+  else if (sqlite3_stricmp(word, "SAVEPOINT"))
+    return;
+
+  size = strlen(sql) + 1;
+  name = sqlite3_malloc64(size);
+  if (!name)
+  {
+    changes->nomem = 1;
+    return;
+  }
+
+  if (rollbackto)
+  {
+    /* ROLLBACK [TRANSACTION [name]] TO [SAVEPOINT] name */
+    for (i = 0; i < 3 && sql; i++)
+    {
+      sql = changes_token(sql, name, size);
+      if (sql && 0 == sqlite3_stricmp(name, "TO"))
+        break;
+    }
+    /* a plain ROLLBACK is handled by the rollback hook */
+    if (!sql || i == 3)
+      goto finally;
+  }
+  sql = changes_token(sql, name, size);
+  if (sql && (release || rollbackto) && 0 == sqlite3_stricmp(name, "SAVEPOINT"))
+    sql = changes_token(sql, name, size);
+
+  if (!sql)
+  {
+    /* not understood so the changes can't be trusted */
+    if (rollbackto)
+      changes->uncertain = 1;
+    goto finally;
+  }
+
+  if (!release && !rollbackto)
+  {
+    APSWChangesMark *savepoints = sqlite3_realloc64(changes->savepoints, sizeof(APSWChangesMark) * (changes->nsavepoints + 1));
+
+    if (!savepoints)
+    {
+      changes->nomem = 1;
+      goto finally;
+    }
+    changes->savepoints = savepoints;
+    savepoints[changes->nsavepoints].stmt = NULL;
+    savepoints[changes->nsavepoints].name = name;
+    savepoints[changes->nsavepoints].mark = changes->count;
+    changes->nsavepoints++;
+    return;
+  }
+
+  for (i = changes->nsavepoints - 1; i >= 0; i--)
+    if (0 == sqlite3_stricmp(changes->savepoints[i].name, name))
+      break;
+  if (i < 0)
+  {
+    /* started before recording did */
+    if (rollbackto)
+      changes->uncertain = 1;
+  }
+  else if (rollbackto)
+  {
+    if (changes->count > changes->savepoints[i].mark)
+      changes->count = changes->savepoints[i].mark;
+    /* the savepoint remains after rolling back to it */
+    changes_savepoints_clear(changes, i + 1);
+  }
+  else
+    changes_savepoints_clear(changes, i);
+
+finally:
+  sqlite3_free(name);
+}
+
+/* follows statements and savepoints.  Called without the GIL. */
+static int
+changes_tracecb(unsigned code, void *context, void *p, void *x)
+{
+  Connection *self = (Connection *)context;
+  APSWChanges *changes = &self->changes;
+  sqlite3_stmt *stmt = (sqlite3_stmt *)p;
+  int i;
+
+  for (i = 0; i < changes->nstatements; i++)
+    if (changes->statements[i].stmt == stmt)
+      break;
+
+  if (code == SQLITE_TRACE_STMT)
+  {
+    /* triggers are reported as the statement that fired them */
+    if (i < changes->nstatements)
+      return 0;
+    changes->suspect = NULL;
+    /* there can't be any savepoints outside of a transaction */
+    if (sqlite3_get_autocommit(self->db))
+      changes_savepoints_clear(changes, 0);
+    changes_savepoint(changes, (const char *)x);
+    if (changes->nstatements == changes->allocstatements)
+    {
+      int allocated = changes->allocstatements ? changes->allocstatements * 2 : 8;
+      APSWChangesMark *statements = sqlite3_realloc64(changes->statements, allocated * sizeof(APSWChangesMark));
+
+      if (!statements)
+      {
+        changes->nomem = 1;
+        return 0;
+      }
+      changes->statements = statements;
+      changes->allocstatements = allocated;
+    }
+    changes->statements[i].stmt = stmt;
+    changes->statements[i].name = NULL;
+    changes->statements[i].mark = changes->count;
+    changes->nstatements++;
+  }
+  else if (code == SQLITE_TRACE_PROFILE && i < changes->nstatements)
+  {
+    /* sqlite3_changes is zero when a statement's changes were undone,
+       but also when all its changes were made by triggers or the
+       statement was reset before finishing */
+    if (changes->count > changes->statements[i].mark && !sqlite3_get_autocommit(self->db) && 0 == sqlite3_changes64(self->db))
+      changes->suspect = stmt;
+    changes->statements[i] = changes->statements[--changes->nstatements];
+  }
+  return 0;
+}
+
+/* called with the result of stepping stmt, with the database mutex
+   held */
+static void
+changes_stepped(Connection *connection, sqlite3_stmt *stmt, int res)
+{
+  if (stmt && connection->changes.suspect == stmt)
+  {
+    if (res != SQLITE_OK && res != SQLITE_ROW && res != SQLITE_DONE)
+      connection->changes.uncertain = 1;
+    connection->changes.suspect = NULL;
+  }
+}
+
+/* makes the Python form of the changes */
+static PyObject *
+changes_topython(APSWChanges *changes, int bytable)
+{
+  PyObject *names = NULL, *result = NULL, *item = NULL;
+  int i;
+  size_t n;
+
+  names = PyTuple_New(changes->nnames);
+  if (!names)
+    goto error;
+  for (i = 0; i < changes->nnames; i++)
+  {
+    item = Py_BuildValue("(O&O&)", convertutf8string, changes->names[i], convertutf8string, changes->names[i] + strlen(changes->names[i]) + 1);
+    if (!item)
+      goto error;
+    PyTuple_SET_ITEM(names, i, item);
+  }
+
+  result = bytable ? PyDict_New() : PyList_New(changes->count);
+  if (!result)
+    goto error;
+  for (n = 0; n < changes->count; n++)
+  {
+    APSWChange *change = &changes->items[n];
+    PyObject *name = PyTuple_GET_ITEM(names, change->name);
+
+    if (bytable)
+    {
+      PyObject *list = PyDict_GetItem(result, name);
+
+      if (!list)
+      {
+        list = PyList_New(0);
+        if (!list || PyDict_SetItem(result, name, list))
+        {
+          Py_XDECREF(list);
+          goto error;
+        }
+        Py_DECREF(list);
+      }
+      item = Py_BuildValue("(iL)", change->op, change->rowid);
+      if (!item || PyList_Append(list, item))
+        goto error;
+      Py_CLEAR(item);
+    }
+    else
+    {
+      item = Py_BuildValue("(iOOL)", change->op, PyTuple_GET_ITEM(name, 0), PyTuple_GET_ITEM(name, 1), change->rowid);
+      if (!item)
+        goto error;
+      PyList_SET_ITEM(result, n, item);
+      item = NULL;
+    }
+  }
+  Py_DECREF(names);
+  return result;
+
+error:
+  Py_XDECREF(item);
+  Py_XDECREF(names);
+  Py_XDECREF(result);
+  return NULL;
+}
+
+/* gives the changes to the callable and empties the buffer.  Returns
+   -1 with an exception set on error.  Called with the GIL held. */
+static int
+changes_deliver(Connection *connection, int committed)
+{
+  PyObject *changes = NULL, *retval = NULL;
+  PyObject *status = committed ? (connection->changes.uncertain ? Py_None : Py_True) : Py_False;
+  int nomem = connection->changes.nomem;
+
+  if (connection->changes.count && !nomem)
+    changes = changes_topython(&connection->changes, connection->changesbytable);
+  changes_clear(&connection->changes);
+  if (nomem)
+    PyErr_NoMemory();
+  if (!changes)
+    return PyErr_Occurred() ? -1 : 0;
+
+  retval = PyObject_CallFunction(connection->changeshook, "(OO)", status, changes);
+  if (!retval)
+  {
+    AddTraceBackHere(__FILE__, __LINE__, "Connection.changeshook", "{s: O, s: O}", "committed", status, "changes", changes);
+    Py_DECREF(changes);
+    return -1;
+  }
+  Py_DECREF(changes);
+  Py_DECREF(retval);
+  return 0;
+}
+
+static void
+updatecb(void *context, int updatetype, char const *databasename, char const *tablename, sqlite3_int64 rowid)
+{
+  /* The hook returns void. That makes it impossible for us to
+     abort immediately due to an error in the callback */
+
+  PyGILState_STATE gilstate;
+  PyObject *retval = NULL;
+  Connection *self = (Connection *)context;
+
+  assert(self);
+  assert(self->updatehook || self->changeshook);
+  assert(self->updatehook != Py_None);
+
+  /* no GIL needed */
+  if (self->changeshook)
+    changes_record(&self->changes, updatetype, databasename, tablename, rowid);
+  if (!self->updatehook)
+    return;
+
+  gilstate = PyGILState_Ensure();
+
+  if (PyErr_Occurred())
+    goto finally; /* abort hook due to outstanding exception */
+
+  retval = PyObject_CallFunction(self->updatehook, "(iO&O&L)", updatetype, convertutf8string, databasename, convertutf8string, tablename, rowid);
+
+finally:
+  Py_XDECREF(retval);
+  PyGILState_Release(gilstate);
+}
+
+/** .. method:: setupdatehook(callable: Optional[Callable]) -> None
+
+  Calls *callable* whenever a row is updated, deleted or inserted.  If
+  *callable* is :const:`None` then any existing update hook is
+  unregistered.  The update hook cannot make changes to the database while
+  the query is still executing, but can record them for later use or
+  apply them in a different connection.
+
+  The update hook is called with 4 parameters:
 
     type (int)
       :const:`SQLITE_INSERT`, :const:`SQLITE_DELETE` or :const:`SQLITE_UPDATE`
@@ -963,7 +1882,9 @@ Connection_setupdatehook(Connection *self, PyObject *args, PyObject *kwds)
   }
   if (!callable)
   {
-    PYSQLITE_VOID_CALL(sqlite3_update_hook(self->db, NULL, NULL));
+    /* still needed for set_changes_hook */
+    if (!self->changeshook)
+      PYSQLITE_VOID_CALL(sqlite3_update_hook(self->db, NULL, NULL));
   }
   else
   {
@@ -988,7 +1909,7 @@ rollbackhookcb(void *context)
   Connection *self = (Connection *)context;
 
   assert(self);
-  assert(self->rollbackhook);
+  assert(self->rollbackhook || self->changeshook);
   assert(self->rollbackhook != Py_None);
 
   gilstate = PyGILState_Ensure();
@@ -996,9 +1917,21 @@ rollbackhookcb(void *context)
   APSW_FAULT_INJECT(RollbackHookExistingError, , PyErr_NoMemory());
 
   if (PyErr_Occurred())
+  {
+    changes_clear(&self->changes);
     goto finally; /* abort hook due to outstanding exception */
+  }
+
+  if (self->rollbackhook)
+    retval = PyObject_CallObject(self->rollbackhook, NULL);
 
-  retval = PyObject_CallObject(self->rollbackhook, NULL);
+  if (self->changeshook)
+  {
+    if (PyErr_Occurred())
+      changes_clear(&self->changes);
+    else
+      changes_deliver(self, 0);
+  }
 
 finally:
   Py_XDECREF(retval);
@@ -1031,7 +1964,9 @@ Connection_setrollbackhook(Connection *self, PyObject *args, PyObject *kwds)
 
   if (!callable)
   {
-    PYSQLITE_VOID_CALL(sqlite3_rollback_hook(self->db, NULL, NULL));
+    /* still needed for set_changes_hook */
+    if (!self->changeshook)
+      PYSQLITE_VOID_CALL(sqlite3_rollback_hook(self->db, NULL, NULL));
   }
   else
   {
@@ -1126,7 +2061,7 @@ commithookcb(void *context)
   Connection *self = (Connection *)context;
 
   assert(self);
-  assert(self->commithook);
+  assert(self->commithook || self->changeshook);
   assert(self->commithook != Py_None);
 
   gilstate = PyGILState_Ensure();
@@ -1136,18 +2071,29 @@ commithookcb(void *context)
   if (PyErr_Occurred())
     goto finally; /* abort hook due to outstanding exception */
 
-  retval = PyObject_CallObject(self->commithook, NULL);
+  if (self->commithook)
+  {
+    retval = PyObject_CallObject(self->commithook, NULL);
 
-  if (!retval)
-    goto finally; /* abort hook due to exeception */
+    if (!retval)
+      goto finally; /* abort hook due to exeception */
 
-  ok = PyObject_IsTrue(retval);
-  assert(ok == -1 || ok == 0 || ok == 1);
-  if (ok == -1)
-  {
-    ok = 1;
-    goto finally; /* abort due to exception in return value */
+    ok = PyObject_IsTrue(retval);
+    assert(ok == -1 || ok == 0 || ok == 1);
+    if (ok == -1)
+    {
+      ok = 1;
+      goto finally; /* abort due to exception in return value */
+    }
+    if (ok)
+      goto finally; /* the rollback hook gets the changes */
   }
+  else
+    ok = 0;
+
+  /* an exception turns the commit into a rollback */
+  if (self->changeshook && changes_deliver(self, 1))
+    ok = 1;
 
 finally:
   Py_XDECREF(retval);
@@ -1186,7 +2132,9 @@ Connection_setcommithook(Connection *self, PyObject *args, PyObject *kwds)
   }
   if (!callable)
   {
-    PYSQLITE_VOID_CALL(sqlite3_commit_hook(self->db, NULL, NULL));
+    /* still needed for set_changes_hook */
+    if (!self->changeshook)
+      PYSQLITE_VOID_CALL(sqlite3_commit_hook(self->db, NULL, NULL));
     goto finally;
   }
 
@@ -1202,6 +2150,107 @@ finally:
   Py_RETURN_NONE;
 }
 
+/* updatecb and changes_tracecb use changeshook and the buffer without
+   the GIL, so they are changed with the database mutex held.  Doesn't
+   use Python so can be called without the GIL. */
+static void
+changes_sethook(Connection *connection, PyObject *callable, int by_table)
+{
+  sqlite3 *db = connection->db;
+
+  sqlite3_mutex_enter(sqlite3_db_mutex(db));
+  connection->changeshook = callable;
+  connection->changesbytable = by_table;
+  if (callable)
+  {
+    sqlite3_update_hook(db, updatecb, connection);
+    sqlite3_commit_hook(db, commithookcb, connection);
+    sqlite3_rollback_hook(db, rollbackhookcb, connection);
+    sqlite3_trace_v2(db, SQLITE_TRACE_STMT | SQLITE_TRACE_PROFILE, changes_tracecb, connection);
+  }
+  else
+  {
+    /* leave any hooks set by the other methods */
+    if (!connection->updatehook)
+      sqlite3_update_hook(db, NULL, NULL);
+    if (!connection->commithook)
+      sqlite3_commit_hook(db, NULL, NULL);
+    if (!connection->rollbackhook)
+      sqlite3_rollback_hook(db, NULL, NULL);
+    sqlite3_trace_v2(db, 0, NULL, NULL);
+    changes_free(&connection->changes);
+  }
+  /* sqlite3_trace_v2 also turns off setprofile */
+  if (connection->profile)
+    sqlite3_profile(db, profilecb, connection);
+  sqlite3_mutex_leave(sqlite3_db_mutex(db));
+}
+
+/** .. method:: set_changes_hook(callable: Optional[Callable[[Optional[bool], Any], None]], by_table: bool = False) -> None
+
+  Records each row inserted, updated or deleted, giving them to
+  *callable* in one call when the transaction commits or rolls back.
+  Unlike :meth:`setupdatehook` which calls Python for every row, the
+  changes are recorded in C so a bulk ``DELETE`` or ``INSERT`` doesn't
+  make a Python call per row while holding the write lock.  Pass None
+  to stop recording.
+
+  *callable* is called with two parameters.  The first is True when
+  the transaction is about to commit and False when it rolled back.
+  It is None when the transaction is about to commit but a statement
+  in it failed after changing rows.  Depending on the `conflict
+  resolution <https://sqlite.org/lang_conflict.html>`__ those rows
+  may have been undone, so check them against the database.
+  The second is a list of ``(type, database name, table name, rowid)``
+  with the same values as :meth:`setupdatehook`, or when *by_table*
+  is True a dict with ``(database name, table name)`` as keys and
+  lists of ``(type, rowid)`` as values.  *callable* isn't called if
+  there were no changes.  An exception at commit turns the commit into
+  a rollback like :meth:`setcommithook`.
+
+  .. code-block:: python
+
+    def changes(committed, changes):
+        if committed is not False:
+            for (dbname, table), rows in changes.items():
+                invalidate_cache(table, [rowid for op, rowid in rows])
+
+    connection.set_changes_hook(changes, by_table=True)
+
+  This works alongside :meth:`setupdatehook`, :meth:`setcommithook`
+  and :meth:`setrollbackhook`, which are called first.  The same rows
+  are captured as the update hook sees, so ``WITHOUT ROWID`` tables
+  aren't included, nor is a ``DELETE`` without a ``WHERE`` clause which
+  SQLite does as a `truncate
+  <https://sqlite.org/lang_delete.html#the_truncate_optimization>`__.
+  Rows undone by ``ROLLBACK TO`` a savepoint are removed.  That
+  includes the savepoints used by :meth:`Connection.__enter__`.
+
+  -* sqlite3_update_hook sqlite3_commit_hook sqlite3_rollback_hook sqlite3_trace_v2
+*/
+static PyObject *
+Connection_set_changes_hook(Connection *self, PyObject *args, PyObject *kwds)
+{
+  PyObject *callable, *old;
+  int by_table = 0;
+  CHECK_USE(NULL);
+  CHECK_CLOSED(self, NULL);
+
+  {
+    static char *kwlist[] = {"callable", "by_table", NULL};
+    Connection_set_changes_hook_CHECK;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O&|O&:" Connection_set_changes_hook_USAGE, kwlist, argcheck_Optional_Callable, &callable, argcheck_bool, &by_table))
+      return NULL;
+  }
+
+  old = self->changeshook;
+  Py_XINCREF(callable);
+  PYSQLITE_VOID_CALL(changes_sethook(self, callable, by_table));
+  Py_XDECREF(old);
+
+  Py_RETURN_NONE;
+}
+
 static int
 walhookcb(void *context, sqlite3 *db, const char *dbname, int npages)
 {
@@ -2060,6 +3109,8 @@ allocfunccbinfo(void)
     res->name = 0;
     res->scalarfunc = 0;
     res->aggregatefactory = 0;
+    res->windowfunction = 0;
+    res->batchsize = 0;
   }
   return res;
 }
@@ -2256,13 +3307,27 @@ getaggregatefunctioncontext(sqlite3_context *context)
 
   if (!retval)
     return aggfc;
+  if (cbinfo->windowfunction)
+  {
+    /* tuple of 5 items: object, stepfunction, finalfunction, valuefunction and inversefunction */
+    if (!PyTuple_Check(retval) || PyTuple_GET_SIZE(retval) != 5)
+    {
+      PyErr_Format(PyExc_TypeError, "Window function factory should return 5 item tuple of (object, stepfunction, finalfunction, valuefunction, inversefunction)");
+      goto finally;
+    }
+    if (!PyCallable_Check(PyTuple_GET_ITEM(retval, 3)) || !PyCallable_Check(PyTuple_GET_ITEM(retval, 4)))
+    {
+      PyErr_Format(PyExc_TypeError, "value and inverse functions must be callable");
+      goto finally;
+    }
+  }
   /* it should have returned a tuple of 3 items: object, stepfunction and finalfunction */
-  if (!PyTuple_Check(retval))
+  else if (!PyTuple_Check(retval))
   {
     PyErr_Format(PyExc_TypeError, "Aggregate factory should return tuple of (object, stepfunction, finalfunction)");
     goto finally;
   }
-  if (PyTuple_GET_SIZE(retval) != 3)
+  else if (PyTuple_GET_SIZE(retval) != 3)
   {
     PyErr_Format(PyExc_TypeError, "Aggregate factory should return 3 item tuple of (object, stepfunction, finalfunction)");
     goto finally;
@@ -2291,6 +3356,14 @@ getaggregatefunctioncontext(sqlite3_context *context)
   Py_INCREF(aggfc->stepfunc);
   Py_INCREF(aggfc->finalfunc);
 
+  if (cbinfo->windowfunction)
+  {
+    aggfc->valuefunc = PyTuple_GET_ITEM(retval, 3);
+    aggfc->inversefunc = PyTuple_GET_ITEM(retval, 4);
+    Py_INCREF(aggfc->valuefunc);
+    Py_INCREF(aggfc->inversefunc);
+  }
+
   Py_DECREF(Py_None); /* we used this earlier as a sentinel */
 
 finally:
@@ -2389,6 +3462,8 @@ finally:
   Py_XDECREF(aggfc->aggvalue);
   Py_XDECREF(aggfc->stepfunc);
   Py_XDECREF(aggfc->finalfunc);
+  Py_XDECREF(aggfc->valuefunc);
+  Py_XDECREF(aggfc->inversefunc);
 
   if (PyErr_Occurred() && (err_type || err_value || err_traceback))
   {
@@ -2616,122 +3691,998 @@ finally:
   Py_RETURN_NONE;
 }
 
-/* USER DEFINED COLLATION CODE.*/
+/* WINDOW FUNCTIONS
 
-static int
-collation_cb(void *context,
-             int stringonelen, const void *stringonedata,
-             int stringtwolen, const void *stringtwodata)
+   These use the same context and step/final dispatch as aggregate
+   functions, with the factory also providing value and inverse.  */
+
+static void
+cbdispatch_value(sqlite3_context *context)
 {
   PyGILState_STATE gilstate;
-  PyObject *cbinfo = (PyObject *)context;
-  PyObject *pys1 = NULL, *pys2 = NULL, *retval = NULL;
-  int result = 0;
-
-  assert(cbinfo);
+  PyObject *retval = NULL;
+  aggregatefunctioncontext *aggfc = NULL;
 
   gilstate = PyGILState_Ensure();
 
   if (PyErr_Occurred())
-    goto finally; /* outstanding error */
+  {
+    sqlite3_result_error(context, "Prior Python Error in step function", -1);
+    goto finalfinally;
+  }
 
-  pys1 = PyUnicode_FromStringAndSize(stringonedata, stringonelen);
-  pys2 = PyUnicode_FromStringAndSize(stringtwodata, stringtwolen);
+  aggfc = getaggregatefunctioncontext(context);
 
-  if (!pys1 || !pys2)
-    goto finally; /* failed to allocate strings */
+  if (PyErr_Occurred())
+    goto finally;
 
-  retval = PyObject_CallFunction(cbinfo, "(OO)", pys1, pys2);
+  assert(aggfc && aggfc->valuefunc);
 
-  if (!retval)
-  {
-    AddTraceBackHere(__FILE__, __LINE__, "Collation_callback", "{s: O, s: O, s: O}", "callback", OBJ(cbinfo), "stringone", OBJ(pys1), "stringtwo", OBJ(pys2));
-    goto finally; /* execution failed */
+  retval = PyObject_CallFunctionObjArgs(aggfc->valuefunc, aggfc->aggvalue, NULL);
+  if (retval)
+    set_context_result(context, retval);
+  Py_XDECREF(retval);
+
+finally:
+  if (PyErr_Occurred())
+  {
+    char *errmsg = NULL;
+    FunctionCBInfo *cbinfo = (FunctionCBInfo *)sqlite3_user_data(context);
+    char *funname = sqlite3_mprintf("user-defined-window-value-%s", cbinfo->name);
+    sqlite3_result_error_code(context, MakeSqliteMsgFromPyException(&errmsg));
+    sqlite3_result_error(context, errmsg, -1);
+    AddTraceBackHere(__FILE__, __LINE__, funname, "{s: s}", "message", errmsg);
+    sqlite3_free(funname);
+    sqlite3_free(errmsg);
+  }
+finalfinally:
+  PyGILState_Release(gilstate);
+}
+
+/* like cbdispatch_step errors are left for the value or final
+   functions to report */
+static void
+cbdispatch_inverse(sqlite3_context *context, int argc, sqlite3_value **argv)
+{
+  PyGILState_STATE gilstate;
+  PyObject *pyargs;
+  PyObject *retval;
+  aggregatefunctioncontext *aggfc = NULL;
+
+  gilstate = PyGILState_Ensure();
+
+  if (PyErr_Occurred())
+    goto finalfinally;
+
+  aggfc = getaggregatefunctioncontext(context);
+
+  if (PyErr_Occurred())
+    goto finally;
+
+  assert(aggfc && aggfc->inversefunc);
+
+  pyargs = getfunctionargs(context, aggfc->aggvalue, argc, argv);
+  if (!pyargs)
+    goto finally;
+
+  retval = PyObject_CallObject(aggfc->inversefunc, pyargs);
+  Py_DECREF(pyargs);
+  Py_XDECREF(retval);
+
+finally:
+  if (PyErr_Occurred())
+  {
+    FunctionCBInfo *cbinfo = (FunctionCBInfo *)sqlite3_user_data(context);
+    char *funname = sqlite3_mprintf("user-defined-window-inverse-%s", cbinfo->name);
+    AddTraceBackHere(__FILE__, __LINE__, funname, "{s: i}", "NumberOfArguments", argc);
+    sqlite3_free(funname);
+  }
+finalfinally:
+  PyGILState_Release(gilstate);
+}
+
+/** .. method:: create_window_function(name: str, factory: Optional[Callable], numargs: int = -1) -> None
+
+  Registers a `window function
+  <https://sqlite.org/windowfunctions.html#user_defined_aggregate_window_functions>`__.
+  It can be used as an aggregate, or with ``OVER`` where rows are
+  added to and removed from the frame as it moves, instead of the
+  whole frame being aggregated again for every row.  A running total
+  over the last 1,000 rows is then one step and one inverse per row,
+  not 1,000 steps.
+
+  :param name: The string name of the function.  It should be less than 255 characters
+  :param factory: The function that will be called.  Use None to delete the function.
+  :param numargs: How many arguments the function takes, with -1 meaning any number
+
+  When a query starts, the *factory* will be called and must return a
+  tuple of 5 items.  The first three are the same as for
+  :meth:`~Connection.createaggregatefunction`:
+
+    a context object
+       This can be of any type
+
+    a step function
+       Called with the context object and the values of a row being
+       added to the frame.
+
+    a final function
+       Called with the context object at the end.  The value returned
+       is the result when used as an aggregate.
+
+    a value function
+       Called with the context object and returns the result for the
+       current frame.
+
+    an inverse function
+       Called with the context object and the values of a row leaving
+       the frame, which was earlier given to the step function.
+
+  .. code-block:: python
+
+    def moving_sum():
+        total = [0]
+
+        def step(ctx, x): ctx[0] += x
+        def inverse(ctx, x): ctx[0] -= x
+        def value(ctx): return ctx[0]
+
+        return total, step, value, value, inverse
+
+    connection.create_window_function("msum", moving_sum, 1)
+
+    connection.cursor().execute("""SELECT x, msum(x) OVER
+          (ORDER BY x ROWS BETWEEN 2 PRECEDING AND CURRENT ROW) FROM t""")
+
+  .. seealso::
+
+     * :meth:`~Connection.createaggregatefunction`
+
+  -* sqlite3_create_window_function
+*/
+static PyObject *
+Connection_create_window_function(Connection *self, PyObject *args, PyObject *kwds)
+{
+  int numargs = -1;
+  PyObject *factory;
+  const char *name = 0;
+  FunctionCBInfo *cbinfo;
+  int res;
+
+  CHECK_USE(NULL);
+  CHECK_CLOSED(self, NULL);
+
+  {
+    static char *kwlist[] = {"name", "factory", "numargs", NULL};
+    Connection_create_window_function_CHECK;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "sO&|i:" Connection_create_window_function_USAGE, kwlist, &name, argcheck_Optional_Callable, &factory, &numargs))
+      return NULL;
+  }
+
+  if (!factory)
+    cbinfo = 0;
+  else
+  {
+    cbinfo = allocfunccbinfo();
+    if (!cbinfo)
+      goto finally;
+
+    cbinfo->name = apsw_strdup(name);
+    cbinfo->aggregatefactory = factory;
+    cbinfo->windowfunction = 1;
+    Py_INCREF(factory);
+  }
+
+  PYSQLITE_CON_CALL(
+      res = sqlite3_create_window_function(self->db,
+                                           name,
+                                           numargs,
+                                           SQLITE_UTF8,
+                                           cbinfo,
+                                           cbinfo ? cbdispatch_step : NULL,
+                                           cbinfo ? cbdispatch_final : NULL,
+                                           cbinfo ? cbdispatch_value : NULL,
+                                           cbinfo ? cbdispatch_inverse : NULL,
+                                           apsw_free_func));
+
+  if (res)
+  {
+    /* Note: On error sqlite3_create_window_function calls the
+   destructor (apsw_free_func)! */
+    SET_EXC(res, self->db);
+    goto finally;
+  }
+
+finally:
+  if (PyErr_Occurred())
+    return NULL;
+  Py_RETURN_NONE;
+}
+
+/* BATCH FUNCTIONS
+
+   These are window functions used with a frame of the current row to
+   the end of the partition.  SQLite has to step every row of the
+   partition before asking for the first value, so the arguments are
+   accumulated and the Python function called with many rows at once.
+   Each value is for the oldest row still in the frame, and inverse
+   removes it.  */
+
+static batchfunctioncontext *
+getbatchfunctioncontext(sqlite3_context *context)
+{
+  return sqlite3_aggregate_context(context, sizeof(batchfunctioncontext));
+}
+
+#define BATCHFUNCTION_FRAME "OVER (ROWS BETWEEN CURRENT ROW AND UNBOUNDED FOLLOWING)"
+
+static void
+batchfunction_error(sqlite3_context *context, const char *which)
+{
+  char *errmsg = NULL;
+  char *funname;
+  FunctionCBInfo *cbinfo = (FunctionCBInfo *)sqlite3_user_data(context);
+
+  funname = sqlite3_mprintf("user-defined-batch-%s-%s", which, cbinfo->name);
+  sqlite3_result_error_code(context, MakeSqliteMsgFromPyException(&errmsg));
+  sqlite3_result_error(context, errmsg, -1);
+  AddTraceBackHere(__FILE__, __LINE__, funname, "{s: s}", "message", errmsg);
+  sqlite3_free(funname);
+  sqlite3_free(errmsg);
+}
+
+static void
+cbdispatch_batch_step(sqlite3_context *context, int argc, sqlite3_value **argv)
+{
+  PyGILState_STATE gilstate;
+  batchfunctioncontext *bfc;
+  PyObject *value;
+  int i;
+
+  gilstate = PyGILState_Ensure();
+
+  if (PyErr_Occurred())
+    goto finally;
+
+  bfc = getbatchfunctioncontext(context);
+  if (!bfc)
+  {
+    PyErr_NoMemory();
+    goto finally;
+  }
+  if (!bfc->columns)
+  {
+    bfc->columns = PyList_New(argc);
+    bfc->results = PyList_New(0);
+    if (!bfc->columns || !bfc->results)
+      goto finally;
+    for (i = 0; i < argc; i++)
+    {
+      value = PyList_New(0);
+      if (!value)
+        goto finally;
+      PyList_SET_ITEM(bfc->columns, i, value);
+    }
+  }
+  for (i = 0; i < argc; i++)
+  {
+    value = convert_value_to_pyobject(argv[i]);
+    if (!value)
+      goto finally;
+    if (PyList_Append(PyList_GET_ITEM(bfc->columns, i), value))
+    {
+      Py_DECREF(value);
+      goto finally;
+    }
+    Py_DECREF(value);
+  }
+  bfc->nrows++;
+
+finally:
+  /* errors are reported when a value is asked for */
+  PyGILState_Release(gilstate);
+}
+
+static void
+cbdispatch_batch_inverse(sqlite3_context *context, int Py_UNUSED(argc), sqlite3_value **Py_UNUSED(argv))
+{
+  PyGILState_STATE gilstate;
+  batchfunctioncontext *bfc = getbatchfunctioncontext(context);
+  Py_ssize_t i, ncolumns;
+
+  if (!bfc || !bfc->columns)
+    return;
+  bfc->front++;
+
+  /* discard rows that have left the frame once they are most of the list */
+  if (bfc->front < 1024 || bfc->front * 2 < bfc->nrows - bfc->discarded)
+    return;
+  gilstate = PyGILState_Ensure();
+  if (!PyErr_Occurred())
+  {
+    ncolumns = PyList_GET_SIZE(bfc->columns);
+    for (i = 0; i < ncolumns; i++)
+      PyList_SetSlice(PyList_GET_ITEM(bfc->columns, i), 0, bfc->front, NULL);
+    PyList_SetSlice(bfc->results, 0, Py_MIN(bfc->front, PyList_GET_SIZE(bfc->results)), NULL);
+    bfc->discarded += bfc->front;
+    bfc->front = 0;
+  }
+  PyGILState_Release(gilstate);
+}
+
+/* calls the Python function for rows starting at the first without a
+   result */
+static int
+batchfunction_call(FunctionCBInfo *cbinfo, batchfunctioncontext *bfc)
+{
+  Py_ssize_t start = PyList_GET_SIZE(bfc->results), end, i, ncolumns = PyList_GET_SIZE(bfc->columns), nitems;
+  PyObject *args = NULL, *retval = NULL, *seq = NULL, *item;
+  APSWDataColumn column;
+  int res = -1;
+
+  end = start + Py_MAX(cbinfo->batchsize, bfc->front + 1 - start);
+  end = Py_MIN(end, bfc->nrows - bfc->discarded);
+
+  args = PyTuple_New(ncolumns);
+  if (!args)
+    goto finally;
+  for (i = 0; i < ncolumns; i++)
+  {
+    item = PyList_GetSlice(PyList_GET_ITEM(bfc->columns, i), start, end);
+    if (!item)
+      goto finally;
+    PyTuple_SET_ITEM(args, i, item);
+  }
+
+  retval = PyObject_CallObject(cbinfo->scalarfunc, args);
+  if (!retval)
+    goto finally;
+
+  /* numeric buffers such as array.array or numpy are read directly */
+  memset(&column, 0, sizeof(column));
+  switch (datatable_buffer_column(retval, &column, &nitems))
+  {
+  case -1:
+    goto buffer_finally;
+  case 1:
+    if (nitems != end - start)
+      break;
+    for (i = 0; i < nitems; i++)
+    {
+      APSWDataTable table = {1, nitems, &column, NULL};
+      APSWDataValue value;
+
+      datatable_cell(&table, 0, i, &value);
+      item = (value.type == SQLITE_INTEGER) ? PyLong_FromLongLong(value.u.i) : PyFloat_FromDouble(value.u.d);
+      if (!item || PyList_Append(bfc->results, item))
+      {
+        Py_XDECREF(item);
+        goto buffer_finally;
+      }
+      Py_DECREF(item);
+    }
+    res = 0;
+    goto buffer_finally;
+  case 0:
+    seq = PySequence_Fast(retval, "Batch function must return a sequence of results");
+    if (!seq)
+      goto finally;
+    nitems = PySequence_Fast_GET_SIZE(seq);
+    if (nitems != end - start)
+      break;
+    for (i = 0; i < nitems; i++)
+      if (PyList_Append(bfc->results, PySequence_Fast_GET_ITEM(seq, i)))
+        goto finally;
+    res = 0;
+    goto finally;
+  }
+  PyErr_Format(PyExc_ValueError, "Batch function was given %zd rows but returned %zd results", end - start, nitems);
+
+buffer_finally:
+  if (column.buffer)
+  {
+    PyBuffer_Release(column.buffer);
+    PyMem_Free(column.buffer);
+  }
+finally:
+  Py_XDECREF(args);
+  Py_XDECREF(retval);
+  Py_XDECREF(seq);
+  return res;
+}
+
+static void
+cbdispatch_batch_value(sqlite3_context *context)
+{
+  PyGILState_STATE gilstate;
+  FunctionCBInfo *cbinfo = (FunctionCBInfo *)sqlite3_user_data(context);
+  batchfunctioncontext *bfc;
+
+  gilstate = PyGILState_Ensure();
+
+  if (PyErr_Occurred())
+    goto error;
+
+  bfc = getbatchfunctioncontext(context);
+  if (!bfc || !bfc->columns)
+  {
+    sqlite3_result_null(context);
+    goto finally;
+  }
+  if (bfc->front != bfc->nvalues - bfc->discarded)
+  {
+    PyErr_Format(PyExc_ValueError, "Batch function %s must be used with " BATCHFUNCTION_FRAME, cbinfo->name);
+    goto error;
+  }
+  bfc->nvalues++;
+
+  if (bfc->front >= PyList_GET_SIZE(bfc->results) && batchfunction_call(cbinfo, bfc))
+    goto error;
+  set_context_result(context, PyList_GET_ITEM(bfc->results, bfc->front));
+  if (!PyErr_Occurred())
+    goto finally;
+
+error:
+  batchfunction_error(context, "value");
+finally:
+  PyGILState_Release(gilstate);
+}
+
+static void
+cbdispatch_batch_final(sqlite3_context *context)
+{
+  PyGILState_STATE gilstate;
+  FunctionCBInfo *cbinfo = (FunctionCBInfo *)sqlite3_user_data(context);
+  batchfunctioncontext *bfc;
+
+  gilstate = PyGILState_Ensure();
+
+  bfc = getbatchfunctioncontext(context);
+  if (bfc)
+  {
+    /* used as an aggregate, or a frame that doesn't ask for a value
+       per row */
+    if (!PyErr_Occurred() && bfc->nvalues != bfc->nrows)
+      PyErr_Format(PyExc_ValueError, "Batch function %s must be used with " BATCHFUNCTION_FRAME, cbinfo->name);
+    Py_CLEAR(bfc->columns);
+    Py_CLEAR(bfc->results);
+  }
+  if (PyErr_Occurred())
+    batchfunction_error(context, "final");
+  else
+    sqlite3_result_null(context);
+
+  PyGILState_Release(gilstate);
+}
+
+/** .. method:: create_batch_function(name: str, callable: Callable, numargs: int = -1, batch_size: int = 4096) -> None
+
+  Registers a function that is called with many rows at once,
+  avoiding the overhead of calling Python for each row.  It is called
+  with a list of values for each argument, and must return a sequence
+  with a result for each row.  Numeric results can also be returned as
+  a buffer such as :class:`array.array` or a numpy array.
+
+  .. code-block:: python
+
+    def scale(xs, factors):
+        return [x * f for x, f in zip(xs, factors)]
+
+    connection.create_batch_function("scale", scale, 2)
+
+    for row in connection.cursor().execute("""
+          SELECT x, scale(x, f) OVER batch FROM big
+          WINDOW batch AS (ROWS BETWEEN CURRENT ROW AND UNBOUNDED FOLLOWING)"""):
+        ...
+
+  A scalar function has to return its result for each row before
+  SQLite will provide the next one, so the batch function is
+  implemented as a `window function
+  <https://sqlite.org/windowfunctions.html>`__ and must be used with
+  ``OVER (ROWS BETWEEN CURRENT ROW AND UNBOUNDED FOLLOWING)`` as
+  shown.  That requires SQLite to read all the rows (of each
+  partition) before returning the first, so this isn't suitable for
+  queries where you stop reading early.  Using any other frame, or
+  using it as an aggregate, is an error.
+
+  :param name: The string name of the function.  It should be less than 255 characters
+  :param callable: The function that will be called with the batches
+  :param numargs: How many arguments the function takes, with -1 meaning any number
+  :param batch_size: The most rows the callable is given at once
+
+  -* sqlite3_create_window_function
+*/
+static PyObject *
+Connection_create_batch_function(Connection *self, PyObject *args, PyObject *kwds)
+{
+  int numargs = -1, batch_size = 4096;
+  PyObject *callable = NULL;
+  const char *name = 0;
+  FunctionCBInfo *cbinfo;
+  int res;
+
+  CHECK_USE(NULL);
+  CHECK_CLOSED(self, NULL);
+
+  {
+    static char *kwlist[] = {"name", "callable", "numargs", "batch_size", NULL};
+    Connection_create_batch_function_CHECK;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "sO&|ii:" Connection_create_batch_function_USAGE, kwlist, &name, argcheck_Callable, &callable, &numargs, &batch_size))
+      return NULL;
+  }
+  if (batch_size < 1)
+    return PyErr_Format(PyExc_ValueError, "batch_size must be at least one");
+
+  cbinfo = allocfunccbinfo();
+  if (!cbinfo)
+    goto finally;
+  cbinfo->name = apsw_strdup(name);
+  cbinfo->scalarfunc = callable;
+  cbinfo->batchsize = batch_size;
+  Py_INCREF(callable);
+
+  PYSQLITE_CON_CALL(
+      res = sqlite3_create_window_function(self->db,
+                                           name,
+                                           numargs,
+                                           SQLITE_UTF8,
+                                           cbinfo,
+                                           cbdispatch_batch_step,
+                                           cbdispatch_batch_final,
+                                           cbdispatch_batch_value,
+                                           cbdispatch_batch_inverse,
+                                           apsw_free_func));
+  if (res)
+  {
+    /* Note: On error sqlite3_create_window_function calls the destructor (apsw_free_func)! */
+    SET_EXC(res, self->db);
+    goto finally;
+  }
+
+finally:
+  if (PyErr_Occurred())
+    return NULL;
+  Py_RETURN_NONE;
+}
+
+/* USER DEFINED COLLATION CODE.*/
+
+static int
+collation_cb(void *context,
+             int stringonelen, const void *stringonedata,
+             int stringtwolen, const void *stringtwodata)
+{
+  PyGILState_STATE gilstate;
+  PyObject *cbinfo = (PyObject *)context;
+  PyObject *pys1 = NULL, *pys2 = NULL, *retval = NULL;
+  int result = 0;
+
+  assert(cbinfo);
+
+  gilstate = PyGILState_Ensure();
+
+  if (PyErr_Occurred())
+    goto finally; /* outstanding error */
+
+  pys1 = PyUnicode_FromStringAndSize(stringonedata, stringonelen);
+  pys2 = PyUnicode_FromStringAndSize(stringtwodata, stringtwolen);
+
+  if (!pys1 || !pys2)
+    goto finally; /* failed to allocate strings */
+
+  retval = PyObject_CallFunction(cbinfo, "(OO)", pys1, pys2);
+
+  if (!retval)
+  {
+    AddTraceBackHere(__FILE__, __LINE__, "Collation_callback", "{s: O, s: O, s: O}", "callback", OBJ(cbinfo), "stringone", OBJ(pys1), "stringtwo", OBJ(pys2));
+    goto finally; /* execution failed */
+  }
+
+  if (PyLong_Check(retval))
+  {
+    result = PyLong_AsLong(retval);
+    goto haveval;
+  }
+
+  PyErr_Format(PyExc_TypeError, "Collation callback must return a number");
+  AddTraceBackHere(__FILE__, __LINE__, "collation callback", "{s: O, s: O}",
+                   "stringone", OBJ(pys1), "stringtwo", OBJ(pys2));
+
+haveval:
+  if (PyErr_Occurred())
+    result = 0;
+
+finally:
+  Py_XDECREF(pys1);
+  Py_XDECREF(pys2);
+  Py_XDECREF(retval);
+  PyGILState_Release(gilstate);
+  return result;
+}
+
+static void
+collation_destroy(void *context)
+{
+  PyGILState_STATE gilstate = PyGILState_Ensure();
+  Py_DECREF((PyObject *)context);
+  PyGILState_Release(gilstate);
+}
+
+/** .. method:: createcollation(name: str, callback: Optional[Callable[[str, str], int]]) -> None
+
+  You can control how SQLite sorts (termed `collation
+  <http://en.wikipedia.org/wiki/Collation>`_) when giving the
+  ``COLLATE`` term to a `SELECT
+  <https://sqlite.org/lang_select.html>`_.  For example your
+  collation could take into account locale or do numeric sorting.
+
+  The *callback* will be called with two items.  It should return -1
+  if the first is less then the second, 0 if they are equal, and 1 if
+  first is greater::
+
+     def mycollation(one, two):
+         if one < two:
+             return -1
+         if one == two:
+             return 0
+         if one > two:
+             return 1
+
+  Passing None as the callback will unregister the collation.
+
+  .. seealso::
+
+    * :ref:`Example <collation-example>`
+
+  -* sqlite3_create_collation_v2
+*/
+
+static PyObject *
+Connection_createcollation(Connection *self, PyObject *args, PyObject *kwds)
+{
+  PyObject *callback = NULL;
+  const char *name = 0;
+  int res;
+
+  CHECK_USE(NULL);
+  CHECK_CLOSED(self, NULL);
+
+  {
+    static char *kwlist[] = {"name", "callback", NULL};
+    Connection_createcollation_CHECK;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "sO&:" Connection_createcollation_USAGE, kwlist, &name, argcheck_Optional_Callable, &callback))
+      return NULL;
+  }
+
+  PYSQLITE_CON_CALL(
+      res = sqlite3_create_collation_v2(self->db,
+                                        name,
+                                        SQLITE_UTF8,
+                                        callback ? callback : NULL,
+                                        callback ? collation_cb : NULL,
+                                        callback ? collation_destroy : NULL));
+
+  if (res != SQLITE_OK)
+  {
+    SET_EXC(res, self->db);
+    return NULL;
+  }
+
+  if (callback)
+    Py_INCREF(callback);
+
+  Py_RETURN_NONE;
+}
+
+/* KEY COLLATIONS
+
+   Python provides a function returning a bytes sort key for each
+   string, and comparisons are memcmp of the keys.  Keys are kept in a
+   direct mapped cache indexed by a hash of the UTF-8 text, so a sort
+   mostly compares cached keys without the GIL.  SQLite holds the
+   database mutex while calling collations so the cache needs no
+   locking of its own. */
+
+typedef struct
+{
+  sqlite3_uint64 hash;
+  char *data; /* text followed by key, NULL if the slot is empty */
+  int textlen;
+  Py_ssize_t keylen;
+} keycollationentry;
+
+typedef struct
+{
+  PyObject *key;
+  sqlite3_uint64 mask; /* entries has mask + 1 slots */
+  keycollationentry *entries;
+} keycollation;
+
+static sqlite3_uint64
+keycollation_hash(const unsigned char *text, int len)
+{
+  /* FNV-1a */
+  sqlite3_uint64 hash = 14695981039346656037ULL;
+  int i;
+
+  for (i = 0; i < len; i++)
+  {
+    hash ^= text[i];
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+static keycollationentry *
+keycollation_find(keycollation *kc, sqlite3_uint64 hash, const void *text, int len)
+{
+  keycollationentry *entry = &kc->entries[hash & kc->mask];
+
+  if (entry->data && entry->hash == hash && entry->textlen == len && 0 == memcmp(entry->data, text, len))
+    return entry;
+  return NULL;
+}
+
+/* remembers a key, replacing whatever was in the slot.  Failing to
+   allocate only means it isn't cached */
+static void
+keycollation_store(keycollation *kc, sqlite3_uint64 hash, const void *text, int len, PyObject *key)
+{
+  keycollationentry *entry = &kc->entries[hash & kc->mask];
+  char *data = sqlite3_malloc64((sqlite3_uint64)len + PyBytes_GET_SIZE(key));
+
+  if (!data)
+    return;
+  memcpy(data, text, len);
+  memcpy(data + len, PyBytes_AS_STRING(key), PyBytes_GET_SIZE(key));
+  sqlite3_free(entry->data);
+  entry->hash = hash;
+  entry->data = data;
+  entry->textlen = len;
+  entry->keylen = PyBytes_GET_SIZE(key);
+}
+
+static int
+keycollation_compare(const char *key1, Py_ssize_t len1, const char *key2, Py_ssize_t len2)
+{
+  int res = memcmp(key1, key2, Py_MIN(len1, len2));
+
+  if (res)
+    return res;
+  return (len1 < len2) ? -1 : (len1 > len2);
+}
+
+/* gets the key for text as bytes from the cache or calling the key
+   function.  Returns a new reference or NULL with an exception */
+static PyObject *
+keycollation_getkey(keycollation *kc, keycollationentry *entry, const void *text, int len)
+{
+  PyObject *pytext = NULL, *key = NULL;
+
+  if (entry)
+    return PyBytes_FromStringAndSize(entry->data + entry->textlen, entry->keylen);
+
+  pytext = PyUnicode_FromStringAndSize(text, len);
+  if (pytext)
+    key = PyObject_CallFunctionObjArgs(kc->key, pytext, NULL);
+  if (key && !PyBytes_Check(key))
+  {
+    PyErr_Format(PyExc_TypeError, "Collation key function must return bytes not %s", Py_TYPE(key)->tp_name);
+    Py_CLEAR(key);
+  }
+  if (!key)
+    AddTraceBackHere(__FILE__, __LINE__, "keycollation_getkey", "{s: O, s: O}", "key", OBJ(kc->key), "text", OBJ(pytext));
+  Py_XDECREF(pytext);
+  return key;
+}
+
+static int
+keycollation_cb(void *context,
+                int stringonelen, const void *stringonedata,
+                int stringtwolen, const void *stringtwodata)
+{
+  PyGILState_STATE gilstate;
+  keycollation *kc = (keycollation *)context;
+  keycollationentry *entryone, *entrytwo;
+  sqlite3_uint64 hashone, hashtwo;
+  PyObject *keyone = NULL, *keytwo = NULL;
+  int result = 0;
+
+  if (stringonelen == stringtwolen && 0 == memcmp(stringonedata, stringtwodata, stringonelen))
+    return 0;
+
+  hashone = keycollation_hash(stringonedata, stringonelen);
+  hashtwo = keycollation_hash(stringtwodata, stringtwolen);
+  entryone = keycollation_find(kc, hashone, stringonedata, stringonelen);
+  entrytwo = keycollation_find(kc, hashtwo, stringtwodata, stringtwolen);
+  if (entryone && entrytwo)
+    return keycollation_compare(entryone->data + entryone->textlen, entryone->keylen,
+                                entrytwo->data + entrytwo->textlen, entrytwo->keylen);
+
+  gilstate = PyGILState_Ensure();
+
+  if (PyErr_Occurred())
+    goto finally; /* outstanding error */
+
+  /* both keys are held as bytes before updating the cache since the
+     key function could use this collation, and the two strings can
+     share a slot */
+  keyone = keycollation_getkey(kc, entryone, stringonedata, stringonelen);
+  if (!keyone)
+    goto finally;
+  keytwo = keycollation_getkey(kc, entrytwo, stringtwodata, stringtwolen);
+  if (!keytwo)
+    goto finally;
+
+  if (!entryone)
+    keycollation_store(kc, hashone, stringonedata, stringonelen, keyone);
+  if (!entrytwo)
+    keycollation_store(kc, hashtwo, stringtwodata, stringtwolen, keytwo);
+
+  result = keycollation_compare(PyBytes_AS_STRING(keyone), PyBytes_GET_SIZE(keyone),
+                                PyBytes_AS_STRING(keytwo), PyBytes_GET_SIZE(keytwo));
+
+finally:
+  Py_XDECREF(keyone);
+  Py_XDECREF(keytwo);
+  PyGILState_Release(gilstate);
+  return result;
+}
+
+static void
+keycollation_destroy(void *context)
+{
+  PyGILState_STATE gilstate;
+  keycollation *kc = (keycollation *)context;
+  sqlite3_uint64 i;
+
+  for (i = 0; i <= kc->mask; i++)
+    sqlite3_free(kc->entries[i].data);
+  sqlite3_free(kc->entries);
+
+  gilstate = PyGILState_Ensure();
+  Py_DECREF(kc->key);
+  PyGILState_Release(gilstate);
+  sqlite3_free(kc);
+}
+
+/** .. method:: create_key_collation(name: str, key: Callable[[str], bytes], cache_size: int = 4096) -> None
+
+  Registers a collation where *key* is called with a string and
+  returns bytes, with strings sorted by comparing their keys.  UTF-8
+  encoding preserves order so ``locale.strxfrm(s).encode("utf8")`` can
+  be used for locale aware sorting, as can ICU sort keys.
+
+  .. code-block:: python
+
+    connection.create_key_collation("fold", lambda s: s.casefold().encode("utf8"))
+
+  A :meth:`createcollation` callback is called with two new strings for
+  every comparison, which is many times per row when sorting.  The
+  keys are instead cached in C for up to *cache_size* recently seen
+  strings, and most comparisons don't need Python at all.  *key* must
+  return the same bytes each time it is given the same string.
+
+  Use :meth:`createcollation` with None to unregister.
+
+  -* sqlite3_create_collation_v2
+*/
+static PyObject *
+Connection_create_key_collation(Connection *self, PyObject *args, PyObject *kwds)
+{
+  PyObject *key = NULL;
+  const char *name = 0;
+  int cache_size = 4096, res;
+  keycollation *kc = NULL;
+
+  CHECK_USE(NULL);
+  CHECK_CLOSED(self, NULL);
+
+  {
+    static char *kwlist[] = {"name", "key", "cache_size", NULL};
+    Connection_create_key_collation_CHECK;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "sO&|i:" Connection_create_key_collation_USAGE, kwlist, &name, argcheck_Callable, &key, &cache_size))
+      return NULL;
   }
+  if (cache_size < 1)
+    return PyErr_Format(PyExc_ValueError, "cache_size must be at least one");
 
-  if (PyLong_Check(retval))
+  kc = sqlite3_malloc64(sizeof(keycollation));
+  if (!kc)
+    return PyErr_NoMemory();
+  kc->key = key;
+  /* rounded up to a power of two */
+  for (kc->mask = 1; kc->mask < (sqlite3_uint64)cache_size; kc->mask <<= 1)
+    ;
+  kc->entries = sqlite3_malloc64(kc->mask * sizeof(keycollationentry));
+  if (!kc->entries)
   {
-    result = PyLong_AsLong(retval);
-    goto haveval;
+    sqlite3_free(kc);
+    return PyErr_NoMemory();
   }
+  memset(kc->entries, 0, kc->mask * sizeof(keycollationentry));
+  kc->mask--;
+  Py_INCREF(key);
 
-  PyErr_Format(PyExc_TypeError, "Collation callback must return a number");
-  AddTraceBackHere(__FILE__, __LINE__, "collation callback", "{s: O, s: O}",
-                   "stringone", OBJ(pys1), "stringtwo", OBJ(pys2));
+  PYSQLITE_CON_CALL(
+      res = sqlite3_create_collation_v2(self->db,
+                                        name,
+                                        SQLITE_UTF8,
+                                        kc,
+                                        keycollation_cb,
+                                        keycollation_destroy));
 
-haveval:
-  if (PyErr_Occurred())
-    result = 0;
+  if (res != SQLITE_OK)
+  {
+    /* the destructor is not called on failure */
+    keycollation_destroy(kc);
+    SET_EXC(res, self->db);
+    return NULL;
+  }
 
-finally:
-  Py_XDECREF(pys1);
-  Py_XDECREF(pys2);
-  Py_XDECREF(retval);
-  PyGILState_Release(gilstate);
-  return result;
+  Py_RETURN_NONE;
 }
 
-static void
-collation_destroy(void *context)
-{
-  PyGILState_STATE gilstate = PyGILState_Ensure();
-  Py_DECREF((PyObject *)context);
-  PyGILState_Release(gilstate);
-}
+/** .. method:: create_native_collation(name: str, collation: str) -> None
 
-/** .. method:: createcollation(name: str, callback: Optional[Callable[[str, str], int]]) -> None
+  Registers one of the collations implemented in C as *name*.  They
+  don't call Python so they are far faster than
+  :meth:`createcollation` and can be used while other threads run
+  Python code.  *collation* is one of:
 
-  You can control how SQLite sorts (termed `collation
-  <http://en.wikipedia.org/wiki/Collation>`_) when giving the
-  ``COLLATE`` term to a `SELECT
-  <https://sqlite.org/lang_select.html>`_.  For example your
-  collation could take into account locale or do numeric sorting.
+    natural
+      Sequences of digits are compared as numbers so ``file9`` comes
+      before ``file10``, with leading zeroes ignored.  Everything else
+      is compared as is.
 
-  The *callback* will be called with two items.  It should return -1
-  if the first is less then the second, 0 if they are equal, and 1 if
-  first is greater::
+    casefold
+      Unicode full case folding so ``Straße``, ``STRASSE`` and
+      ``strasse`` are equal.
 
-     def mycollation(one, two):
-         if one < two:
-             return -1
-         if one == two:
-             return 0
-         if one > two:
-             return 1
+    noaccent
+      Case folding and accents removed so ``Élan`` and ``elan`` are
+      equal.  Combining marks are ignored.
 
-  Passing None as the callback will unregister the collation.
+  .. code-block:: python
 
-  .. seealso::
+    connection.create_native_collation("nocase", "casefold")
+    connection.cursor().execute("create table names(name collate nocase unique)")
 
-    * :ref:`Example <collation-example>`
+  The Unicode tables are generated by ``tools/gencollationtables.py``.
+  Use :meth:`createcollation` with None to unregister.
 
   -* sqlite3_create_collation_v2
 */
-
 static PyObject *
-Connection_createcollation(Connection *self, PyObject *args, PyObject *kwds)
+Connection_create_native_collation(Connection *self, PyObject *args, PyObject *kwds)
 {
-  PyObject *callback = NULL;
-  const char *name = 0;
+  const char *name = 0, *collation = 0;
+  size_t i;
   int res;
 
   CHECK_USE(NULL);
   CHECK_CLOSED(self, NULL);
 
   {
-    static char *kwlist[] = {"name", "callback", NULL};
-    Connection_createcollation_CHECK;
-    if (!PyArg_ParseTupleAndKeywords(args, kwds, "sO&:" Connection_createcollation_USAGE, kwlist, &name, argcheck_Optional_Callable, &callback))
+    static char *kwlist[] = {"name", "collation", NULL};
+    Connection_create_native_collation_CHECK;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "ss:" Connection_create_native_collation_USAGE, kwlist, &name, &collation))
       return NULL;
   }
 
+  for (i = 0; i < sizeof(native_collations) / sizeof(native_collations[0]); i++)
+    if (0 == strcmp(collation, native_collations[i].name))
+      break;
+  if (i == sizeof(native_collations) / sizeof(native_collations[0]))
+    return PyErr_Format(PyExc_ValueError, "Unknown native collation \"%s\"", collation);
+
   PYSQLITE_CON_CALL(
       res = sqlite3_create_collation_v2(self->db,
                                         name,
                                         SQLITE_UTF8,
-                                        callback ? callback : NULL,
-                                        callback ? collation_cb : NULL,
-                                        callback ? collation_destroy : NULL));
+                                        NULL,
+                                        native_collations[i].xCompare,
+                                        NULL));
 
   if (res != SQLITE_OK)
   {
@@ -2739,9 +4690,6 @@ Connection_createcollation(Connection *self, PyObject *args, PyObject *kwds)
     return NULL;
   }
 
-  if (callback)
-    Py_INCREF(callback);
-
   Py_RETURN_NONE;
 }
 
@@ -2979,6 +4927,214 @@ Connection_createmodule(Connection *self, PyObject *args, PyObject *kwds)
   Py_RETURN_NONE;
 }
 
+/** .. method:: create_data_table(name: str, data: Any, columns: Optional[Sequence[str]] = None) -> None
+
+    Makes in memory data available as a read only virtual table,
+    without having to implement :class:`VTTable` and
+    :class:`VTCursor`.  The table is eponymous, meaning it is used by
+    *name* directly without a ``CREATE VIRTUAL TABLE``, and is only in
+    the ``main`` schema.
+
+    .. code-block:: python
+
+      connection.create_data_table("points", {"x": array.array("d", xs), "y": array.array("d", ys)})
+      for row in connection.cursor().execute("select x, y from points where x > ? limit 10", (lower, )):
+          print(row)
+
+    Scanning the table, checking constraints, and providing values
+    happens in C without calling Python, so it is far quicker than a
+    virtual table written in Python.  Constraints using ``=``, ``<``,
+    ``<=``, ``>``, and ``>=`` are checked during the scan, and the scan
+    stops early for ``LIMIT`` when there are no other constraints.
+
+    The rowid is the row number starting at zero.  The columns have no
+    type affinity so values compare as described in `comparison
+    expressions <https://sqlite.org/datatype3.html#comparison_expressions>`__.
+    Calling this again with the same *name* replaces the data.
+
+    :param name: Table name
+    :param data: Either an iterable of rows, each being a sequence of
+        values, or a dict with column names as keys and each value being
+        a sequence of the column's values.  A dict value supporting the
+        buffer protocol of integers or floats (eg :class:`array.array`
+        or numpy arrays) is used in place, and the rest of the data is
+        copied.  Values must be None, int, float, str, or bytes.
+    :param columns: Column names when *data* is an iterable of rows.
+        If not supplied they are ``c0``, ``c1`` etc.
+
+    -* sqlite3_create_module_v2
+*/
+static PyObject *
+Connection_create_data_table(Connection *self, PyObject *args, PyObject *kwds)
+{
+  const char *name = NULL;
+  PyObject *data = NULL, *columns = NULL;
+  APSWDataTable *table;
+  int res;
+
+  CHECK_USE(NULL);
+  CHECK_CLOSED(self, NULL);
+
+  {
+    static char *kwlist[] = {"name", "data", "columns", NULL};
+    Connection_create_data_table_CHECK;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "sO|O:" Connection_create_data_table_USAGE, kwlist, &name, &data, &columns))
+      return NULL;
+  }
+
+  table = datatable_new(data, columns);
+  if (!table)
+    return NULL;
+
+  /* the destructor is called on failure */
+  PYSQLITE_CON_CALL(res = sqlite3_create_module_v2(self->db, name, &apsw_datatable_module, table, datatable_module_destroy));
+  SET_EXC(res, self->db);
+  if (res != SQLITE_OK)
+    return NULL;
+  /* cached statements would keep using any previous data */
+  statementcache_empty(self->stmtcache);
+
+  Py_RETURN_NONE;
+}
+
+static struct sqlite3_module apsw_tablefunction_module;
+static void tablefunction_free(void *context);
+
+/** .. method:: create_table_function(name: str, generator: Callable, columns: Sequence[str], hidden_args: Sequence[str]) -> None
+
+    Registers a `table valued function
+    <https://sqlite.org/vtab.html#tabfunc2>`__, without having to
+    implement the virtual table methods.  The function is called with
+    the arguments, and returns an iterable of rows.
+
+    .. code-block:: python
+
+      def split(text, sep=","):
+          return text.split(sep)
+
+      connection.create_table_function("split", split, ["part"], ["text", "sep"])
+      connection.cursor().execute("select part from split('a,b,c')")
+      connection.cursor().execute("select id, part from items, split(items.tags, ';')")
+
+    The arguments are supplied positionally in SQL, or as constraints
+    on the hidden columns (eg ``where sep=';'``).  The function is called
+    with the arguments up to the last one supplied, using None for any
+    missing before it, so Python default values apply to trailing ones.
+
+    Rows are taken from the iterable a batch at a time.  Each row is a
+    sequence of the column values, or when there is only one column
+    can be just the value.  The rowid is the row number starting at
+    zero.
+
+    :param name: The function name, used as the table name
+    :param generator: Called with the arguments, returning an iterable of rows
+    :param columns: Names of the columns in each row
+    :param hidden_args: Names of the arguments, which are also available
+        as hidden columns
+
+    -* sqlite3_create_module_v2
+*/
+static PyObject *
+Connection_create_table_function(Connection *self, PyObject *args, PyObject *kwds)
+{
+  const char *name = NULL;
+  PyObject *generator = NULL, *columns = NULL, *hidden_args = NULL, *names = NULL, *item;
+  tablefunctioninfo *tfi = NULL;
+  sqlite3_str *schema = NULL;
+  Py_ssize_t i;
+  int res;
+
+  CHECK_USE(NULL);
+  CHECK_CLOSED(self, NULL);
+
+  {
+    static char *kwlist[] = {"name", "generator", "columns", "hidden_args", NULL};
+    Connection_create_table_function_CHECK;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "sO&OO:" Connection_create_table_function_USAGE, kwlist, &name, argcheck_Callable, &generator, &columns, &hidden_args))
+      return NULL;
+  }
+
+  tfi = PyMem_Calloc(1, sizeof(tablefunctioninfo));
+  if (!tfi)
+  {
+    PyErr_NoMemory();
+    goto error;
+  }
+  tfi->generator = generator;
+  Py_INCREF(generator);
+
+  names = PySequence_List(columns);
+  if (names)
+  {
+    tfi->ncolumns = (int)PyList_GET_SIZE(names);
+    item = PySequence_List(hidden_args);
+    if (item)
+    {
+      tfi->nargs = (int)PyList_GET_SIZE(item);
+      if (PyList_SetSlice(names, tfi->ncolumns, tfi->ncolumns, item))
+        Py_CLEAR(names);
+      Py_DECREF(item);
+    }
+    else
+      Py_CLEAR(names);
+  }
+  if (!names)
+    goto error;
+  if (tfi->ncolumns < 1)
+  {
+    PyErr_Format(PyExc_ValueError, "There must be at least one column");
+    goto error;
+  }
+  /* they are tracked in a bitmap */
+  if (tfi->nargs > 30)
+  {
+    PyErr_Format(PyExc_ValueError, "There can't be more than 30 hidden args");
+    goto error;
+  }
+
+  schema = sqlite3_str_new(NULL);
+  sqlite3_str_appendall(schema, "create table x(");
+  for (i = 0; i < PyList_GET_SIZE(names); i++)
+  {
+    item = PyList_GET_ITEM(names, i);
+    if (!PyUnicode_Check(item))
+    {
+      PyErr_Format(PyExc_TypeError, "Column and argument names must be str not %s", Py_TYPE(item)->tp_name);
+      goto error;
+    }
+    sqlite3_str_appendf(schema, "%s\"%w\"%s", i ? "," : "", PyUnicode_AsUTF8(item), (i >= tfi->ncolumns) ? " HIDDEN" : "");
+  }
+  sqlite3_str_appendall(schema, ")");
+  if (PyErr_Occurred())
+    goto error;
+  if (sqlite3_str_errcode(schema))
+  {
+    PyErr_NoMemory();
+    goto error;
+  }
+  tfi->schema = sqlite3_str_finish(schema);
+  schema = NULL;
+  Py_CLEAR(names);
+
+  /* the destructor is called on failure */
+  PYSQLITE_CON_CALL(res = sqlite3_create_module_v2(self->db, name, &apsw_tablefunction_module, tfi, tablefunction_free));
+  SET_EXC(res, self->db);
+  if (res != SQLITE_OK)
+    return NULL;
+  /* cached statements would keep using any previous function */
+  statementcache_empty(self->stmtcache);
+
+  Py_RETURN_NONE;
+
+error:
+  if (schema)
+    sqlite3_free(sqlite3_str_finish(schema));
+  Py_XDECREF(names);
+  if (tfi)
+    tablefunction_free(tfi);
+  return NULL;
+}
+
 /** .. method:: overloadfunction(name: str, nargs: int) -> None
 
   Registers a placeholder function so that a virtual table can provide an implementation via
@@ -3509,6 +5665,312 @@ Connection_txn_state(Connection *self, PyObject *args, PyObject *kwds)
   return PyErr_Format(PyExc_ValueError, "unknown schema");
 }
 
+/** .. method:: cache_stats(include_entries: bool = False) -> Dict[str, Any]
+
+  Returns information about the :ref:`statement cache <statementcache>` as a dict.
+
+  .. list-table::
+    :widths: auto
+    :header-rows: 1
+
+    * - Key
+      - Explanation
+    * - size
+      - Maximum number of entries in the cache
+    * - count
+      - Number of entries currently in the cache
+    * - hits
+      - A query was found in the cache and did not need to be prepared
+    * - misses
+      - A query was not found in the cache so it had to be prepared
+    * - evictions
+      - An entry was removed from the cache to make room for a newer one
+    * - too_big
+      - The query text was too large to be worth caching
+    * - no_vdbe
+      - The query prepared to nothing (for example only comments) so could not be cached
+    * - no_cache
+      - The cache size is zero so caching is disabled
+    * - bytes
+      - Memory used by the cached statements and their query text
+
+  :param include_entries: If *True* then an additional key *entries* is a list
+     of dicts, one per cache entry, with *query* being the text, *has_more*
+     being *True* if the query text has more than one statement, and *uses* being
+     how many times the entry was found in the cache.  This is useful for seeing
+     which queries are causing the cache to churn.
+
+  -* sqlite3_stmt_status
+*/
+static PyObject *
+Connection_cache_stats(Connection *self, PyObject *args, PyObject *kwds)
+{
+  int include_entries = 0;
+  CHECK_USE(NULL);
+  CHECK_CLOSED(self, NULL);
+
+  {
+    static char *kwlist[] = {"include_entries", NULL};
+    Connection_cache_stats_CHECK;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|O&:" Connection_cache_stats_USAGE, kwlist, argcheck_bool, &include_entries))
+      return NULL;
+  }
+
+  return statementcache_stats(self->stmtcache, include_entries);
+}
+
+/** .. method:: import_csv(source: Any, table: str, delimiter: str = ",", quote: Optional[str] = '"', header: bool = False, infer: bool = False, commit_rows: int = 0, progress: Optional[Callable[[int, int], None]] = None) -> int
+
+  Imports separated values (eg CSV) into an existing table.  This is
+  far quicker than reading the values in Python and using
+  :meth:`Cursor.executemany` because the data is parsed and inserted
+  in C, a megabyte at a time with the GIL released.
+
+  Records end with ``\n``, ``\r\n``, or ``\r``, and blank lines are
+  skipped.  Each record must have the same number of fields as the
+  table has columns.  A field starting with *quote* continues until
+  the closing quote, can contain delimiters and line endings, and a
+  doubled quote inside it is a single quote.  The data must be UTF-8,
+  and a leading byte order mark is skipped.
+
+  If no transaction is active then the import is done inside ``BEGIN
+  IMMEDIATE`` which is committed at the end, or rolled back on error.
+  If a transaction is already active then the import happens within
+  it, *commit_rows* is ignored, and nothing is rolled back.
+
+  :param source: A filename, or an object with a *read* method returning
+     bytes or str such as a file opened in binary or text mode.
+  :param table: Name of the table to insert into.
+  :param delimiter: Single character between fields.  Use ``"\t"`` for tab separated
+     values.
+  :param quote: Single character used to quote fields, or *None* if fields are
+     never quoted.
+  :param header: If *True* the first record is skipped.
+  :param infer: If *False* all values are bound as text, and SQLite converts them
+     according to the `column affinity
+     <https://sqlite.org/datatype3.html#type_affinity>`__.  If *True* then
+     unquoted values that are exactly an integer or float are bound as that
+     type, and unquoted empty values are bound as null.  Values with
+     leading zeroes or plus signs (eg phone numbers) are kept as text.
+  :param commit_rows: If positive, commit after this many rows and start a new
+     transaction.  An error then only rolls back the rows since the last
+     commit.
+  :param progress: Called with the number of rows inserted and bytes read so far
+     after each chunk of data.  An exception aborts the import.
+
+  :returns: The number of rows inserted
+
+  -* sqlite3_prepare_v2 sqlite3_bind_text sqlite3_bind_int64 sqlite3_bind_double sqlite3_bind_null sqlite3_step sqlite3_reset sqlite3_exec
+*/
+static PyObject *
+Connection_import_csv(Connection *self, PyObject *args, PyObject *kwds)
+{
+  PyObject *source = NULL, *progress = NULL, *reader = NULL, *path = NULL, *chunk = NULL;
+  const char *table = NULL, *delimiter = ",", *quote = "\"";
+  int header = 0, infer = 0, commit_rows = 0, res = SQLITE_OK, transaction = 0;
+  sqlite3_int64 nextcommit, rows;
+  FILE *file = NULL;
+  sqlite3_stmt *stmt = NULL;
+  APSWCSVImport ci;
+
+  CHECK_USE(NULL);
+  CHECK_CLOSED(self, NULL);
+
+  {
+    static char *kwlist[] = {"source", "table", "delimiter", "quote", "header", "infer", "commit_rows", "progress", NULL};
+    Connection_import_csv_CHECK;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "Os|szO&O&iO&:" Connection_import_csv_USAGE, kwlist, &source, &table, &delimiter, &quote, argcheck_bool, &header, argcheck_bool, &infer, &commit_rows, argcheck_Optional_Callable, &progress))
+      return NULL;
+  }
+  if (strlen(delimiter) != 1 || *delimiter == '\r' || *delimiter == '\n')
+    return PyErr_Format(PyExc_ValueError, "delimiter must be a single character other than a line ending");
+  if (quote && (strlen(quote) != 1 || *quote == *delimiter || *quote == '\r' || *quote == '\n'))
+    return PyErr_Format(PyExc_ValueError, "quote must be a single character different from the delimiter and not a line ending");
+  if (commit_rows < 0)
+    return PyErr_Format(PyExc_ValueError, "commit_rows can't be negative");
+
+  csvimport_init(&ci, *delimiter, quote ? (unsigned char)*quote : -1, infer, header);
+
+  if (PyObject_HasAttrString(source, "read"))
+  {
+    reader = PyObject_GetAttrString(source, "read");
+    if (!reader)
+      goto error;
+  }
+  else
+  {
+    if (!PyUnicode_FSConverter(source, &path))
+      goto error;
+    Py_BEGIN_ALLOW_THREADS
+        file = fopen(PyBytes_AS_STRING(path), "rb");
+    Py_END_ALLOW_THREADS;
+    if (!file)
+    {
+      PyErr_SetFromErrnoWithFilenameObject(PyExc_OSError, source);
+      goto error;
+    }
+  }
+
+  PYSQLITE_CON_CALL(res = csvimport_prepare(&ci, self->db, table, &stmt));
+  if (res != SQLITE_OK)
+  {
+    SET_EXC(res, self->db);
+    goto error;
+  }
+  ci.fields = PyMem_Malloc(sizeof(APSWCSVField) * ci.ncols);
+  if (!ci.fields)
+  {
+    PyErr_NoMemory();
+    goto error;
+  }
+
+  if (sqlite3_get_autocommit(self->db))
+  {
+    PYSQLITE_CON_CALL(res = sqlite3_exec(self->db, "BEGIN IMMEDIATE", NULL, NULL, NULL));
+    SET_EXC(res, self->db);
+    if (res != SQLITE_OK)
+      goto error;
+    transaction = 1;
+  }
+  nextcommit = (transaction && commit_rows) ? commit_rows : 0;
+
+  do
+  {
+    if (file)
+    {
+      char *dest = csvimport_reserve(&ci, APSW_CSV_CHUNK);
+      size_t amount;
+      if (!dest)
+        goto error;
+      Py_BEGIN_ALLOW_THREADS
+          amount = fread(dest, 1, APSW_CSV_CHUNK, file);
+      Py_END_ALLOW_THREADS;
+      if (amount < APSW_CSV_CHUNK)
+      {
+        if (ferror(file))
+        {
+          PyErr_SetFromErrnoWithFilenameObject(PyExc_OSError, source);
+          goto error;
+        }
+        ci.eof = 1;
+      }
+      csvimport_appended(&ci, amount);
+    }
+    else
+    {
+      Py_buffer buffer;
+      char *dest;
+
+      INUSE_CALL(chunk = PyObject_CallFunction(reader, "i", APSW_CSV_CHUNK));
+      if (!chunk)
+        goto error;
+      if (PyUnicode_Check(chunk))
+      {
+        Py_ssize_t amount;
+        const char *data = PyUnicode_AsUTF8AndSize(chunk, &amount);
+        if (!data)
+          goto error;
+        dest = csvimport_reserve(&ci, amount);
+        if (!dest)
+          goto error;
+        memcpy(dest, data, amount);
+        csvimport_appended(&ci, amount);
+        ci.eof = !amount;
+      }
+      else if (PyObject_CheckBuffer(chunk))
+      {
+        if (PyObject_GetBuffer(chunk, &buffer, PyBUF_SIMPLE))
+          goto error;
+        dest = csvimport_reserve(&ci, buffer.len);
+        if (dest)
+        {
+          memcpy(dest, buffer.buf, buffer.len);
+          csvimport_appended(&ci, buffer.len);
+          ci.eof = !buffer.len;
+        }
+        PyBuffer_Release(&buffer);
+        if (!dest)
+          goto error;
+      }
+      else
+      {
+        PyErr_Format(PyExc_TypeError, "Expected read() to return bytes or str, not %s", Py_TYPE(chunk)->tp_name);
+        goto error;
+      }
+      Py_CLEAR(chunk);
+    }
+
+    for (;;)
+    {
+      PYSQLITE_CON_CALL(res = csvimport_run(&ci, stmt, nextcommit); changes_stepped(self, stmt, ci.stepped ? res : SQLITE_OK));
+      if (res != SQLITE_OK)
+        break;
+      PYSQLITE_CON_CALL(res = sqlite3_exec(self->db, "COMMIT; BEGIN IMMEDIATE", NULL, NULL, NULL));
+      if (res != SQLITE_OK)
+        break;
+      nextcommit += commit_rows;
+    }
+    if (res == -1)
+    {
+      PyErr_Format(PyExc_ValueError, "Record %lld has %d fields but table %s has %d columns", ci.records, ci.nfields, table, ci.ncols);
+      goto error;
+    }
+    if (res != SQLITE_DONE)
+    {
+      SET_EXC(res, self->db);
+      goto error;
+    }
+
+    if (progress)
+    {
+      PyObject *retval;
+      INUSE_CALL(retval = PyObject_CallFunction(progress, "LL", ci.rows, ci.bytes));
+      if (!retval)
+        goto error;
+      Py_DECREF(retval);
+    }
+  } while (!ci.eof);
+
+  PYSQLITE_CON_CALL(res = sqlite3_finalize(stmt));
+  stmt = NULL;
+  if (transaction)
+  {
+    PYSQLITE_CON_CALL(res = sqlite3_exec(self->db, "COMMIT", NULL, NULL, NULL));
+    SET_EXC(res, self->db);
+    if (res != SQLITE_OK)
+      goto error;
+    transaction = 0;
+  }
+
+  if (file)
+    fclose(file);
+  Py_XDECREF(reader);
+  Py_XDECREF(path);
+  rows = ci.rows;
+  csvimport_free(&ci);
+  return PyLong_FromLongLong(rows);
+
+error:
+  assert(PyErr_Occurred());
+  AddTraceBackHere(__FILE__, __LINE__, "Connection.import_csv", "{s: s, s: L, s: L}", "table", table, "record", ci.records, "rows", ci.rows);
+  if (stmt)
+    PYSQLITE_CON_CALL(res = sqlite3_finalize(stmt));
+  if (transaction)
+  {
+    PyObject *etype, *eval, *etb;
+    PyErr_Fetch(&etype, &eval, &etb);
+    PYSQLITE_CON_CALL(res = sqlite3_exec(self->db, "ROLLBACK", NULL, NULL, NULL));
+    PyErr_Restore(etype, eval, etb);
+  }
+  if (file)
+    fclose(file);
+  Py_XDECREF(chunk);
+  Py_XDECREF(reader);
+  Py_XDECREF(path);
+  csvimport_free(&ci);
+  return NULL;
+}
+
 /** .. attribute:: filename
   :type: str
 
@@ -3622,12 +6084,34 @@ static PyMethodDef Connection_methods[] = {
     {"loadextension", (PyCFunction)Connection_loadextension, METH_VARARGS | METH_KEYWORDS,
      Connection_loadextension_DOC},
 #endif
+    {"set_changes_hook", (PyCFunction)Connection_set_changes_hook, METH_VARARGS | METH_KEYWORDS,
+     Connection_set_changes_hook_DOC},
+    {"create_native_collation", (PyCFunction)Connection_create_native_collation, METH_VARARGS | METH_KEYWORDS,
+     Connection_create_native_collation_DOC},
+    {"create_key_collation", (PyCFunction)Connection_create_key_collation, METH_VARARGS | METH_KEYWORDS,
+     Connection_create_key_collation_DOC},
+    {"create_window_function", (PyCFunction)Connection_create_window_function, METH_VARARGS | METH_KEYWORDS,
+     Connection_create_window_function_DOC},
+    {"create_batch_function", (PyCFunction)Connection_create_batch_function, METH_VARARGS | METH_KEYWORDS,
+     Connection_create_batch_function_DOC},
     {"createmodule", (PyCFunction)Connection_createmodule, METH_VARARGS | METH_KEYWORDS,
      Connection_createmodule_DOC},
+    {"create_data_table", (PyCFunction)Connection_create_data_table, METH_VARARGS | METH_KEYWORDS,
+     Connection_create_data_table_DOC},
+    {"create_table_function", (PyCFunction)Connection_create_table_function, METH_VARARGS | METH_KEYWORDS,
+     Connection_create_table_function_DOC},
     {"overloadfunction", (PyCFunction)Connection_overloadfunction, METH_VARARGS | METH_KEYWORDS,
      Connection_overloadfunction_DOC},
     {"backup", (PyCFunction)Connection_backup, METH_VARARGS | METH_KEYWORDS,
      Connection_backup_DOC},
+    {"backup_async", (PyCFunction)Connection_backup_async, METH_VARARGS | METH_KEYWORDS,
+     Connection_backup_async_DOC},
+#ifdef SQLITE_ENABLE_SESSION
+    {"session", (PyCFunction)Connection_session, METH_VARARGS | METH_KEYWORDS,
+     Connection_session_DOC},
+    {"apply_changeset", (PyCFunction)Connection_apply_changeset, METH_VARARGS | METH_KEYWORDS,
+     Connection_apply_changeset_DOC},
+#endif
     {"filecontrol", (PyCFunction)Connection_filecontrol, METH_VARARGS | METH_KEYWORDS,
      Connection_filecontrol_DOC},
     {"sqlite3pointer", (PyCFunction)Connection_sqlite3pointer, METH_NOARGS,
@@ -3664,6 +6148,10 @@ static PyMethodDef Connection_methods[] = {
      Connection_deserialize_DOC},
     {"autovacuum_pages", (PyCFunction)Connection_autovacuum_pages, METH_VARARGS | METH_KEYWORDS,
      Connection_autovacuum_pages_DOC},
+    {"cache_stats", (PyCFunction)Connection_cache_stats, METH_VARARGS | METH_KEYWORDS,
+     Connection_cache_stats_DOC},
+    {"import_csv", (PyCFunction)Connection_import_csv, METH_VARARGS | METH_KEYWORDS,
+     Connection_import_csv_DOC},
     {0, 0, 0, 0} /* Sentinel */
 };
 
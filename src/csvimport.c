@@ -0,0 +1,422 @@
+/*
+  Bulk CSV import used by Connection.import_csv
+
+  See the accompanying LICENSE file.
+*/
+
+/* Data is appended to a buffer, and then all the complete records in
+   the buffer are tokenized, bound and stepped in one go with the GIL
+   released and the database mutex held.  A record that spans the end
+   of the buffer is moved to the front and completed by the next read.
+   Quoted fields are unescaped in place, and all text is bound with
+   SQLITE_STATIC because the buffer doesn't change while a record is
+   being stepped. */
+
+/* how much is read from the source at a time */
+#define APSW_CSV_CHUNK (1024 * 1024)
+
+typedef struct
+{
+  char *start; /* field contents including any quotes */
+  size_t len;
+  int quoted; /* first character is the quote */
+} APSWCSVField;
+
+typedef struct
+{
+  /* dialect */
+  char delimiter;
+  int quote; /* quote character, or -1 if quoting is not used */
+  int infer; /* unquoted numbers are bound as numbers, and unquoted empty as null */
+
+  /* data read so far */
+  char *buffer;
+  size_t size;         /* bytes of data in buffer */
+  size_t allocated;    /* always at least one more than size so fields can be terminated */
+  size_t offset;       /* where the next record starts */
+  int eof;             /* no more data will be appended */
+  int bomchecked;      /* a leading UTF-8 byte order mark has been looked for */
+  sqlite3_int64 bytes; /* total appended */
+
+  /* the current record */
+  int ncols;   /* columns in the table */
+  int nfields; /* fields in the record which can exceed ncols, but only ncols are kept */
+  APSWCSVField *fields;
+
+  sqlite3_int64 records; /* records seen including the header */
+  int skip;              /* records still to skip before inserting */
+  sqlite3_int64 rows;    /* rows inserted */
+  int stepped;           /* the last record got as far as sqlite3_step */
+} APSWCSVImport;
+
+static void
+csvimport_init(APSWCSVImport *ci, char delimiter, int quote, int infer, int skip)
+{
+  memset(ci, 0, sizeof(APSWCSVImport));
+  ci->delimiter = delimiter;
+  ci->quote = quote;
+  ci->infer = infer;
+  ci->skip = skip;
+}
+
+static void
+csvimport_free(APSWCSVImport *ci)
+{
+  PyMem_Free(ci->buffer);
+  PyMem_Free(ci->fields);
+  memset(ci, 0, sizeof(APSWCSVImport));
+}
+
+/* makes room for at least want more bytes of data, discarding records
+   already consumed.  Returns where to put the data, or NULL with
+   exception set */
+static char *
+csvimport_reserve(APSWCSVImport *ci, size_t want)
+{
+  if (ci->offset)
+  {
+    memmove(ci->buffer, ci->buffer + ci->offset, ci->size - ci->offset);
+    ci->size -= ci->offset;
+    ci->offset = 0;
+  }
+  if (ci->size + want + 1 > ci->allocated)
+  {
+    size_t allocated = ci->size + want + 1;
+    char *buffer = PyMem_Realloc(ci->buffer, allocated);
+    if (!buffer)
+    {
+      PyErr_NoMemory();
+      return NULL;
+    }
+    ci->buffer = buffer;
+    ci->allocated = allocated;
+  }
+  return ci->buffer + ci->size;
+}
+
+/* records that amount of data has been put where reserve said */
+static void
+csvimport_appended(APSWCSVImport *ci, size_t amount)
+{
+  ci->size += amount;
+  ci->bytes += amount;
+  assert(ci->size < ci->allocated);
+}
+
+/* finds the fields of the next record.  Returns 1 if there is a
+   complete record, or 0 if more data is needed (or there are no more
+   records at eof).  Blank lines are skipped. */
+static int
+csvimport_next(APSWCSVImport *ci)
+{
+  char *p, *end;
+  APSWCSVField field;
+
+  if (!ci->bomchecked)
+  {
+    if (ci->size - ci->offset < 3 && !ci->eof)
+      return 0;
+    if (ci->size - ci->offset >= 3 && 0 == memcmp(ci->buffer + ci->offset, "\xef\xbb\xbf", 3))
+      ci->offset += 3;
+    ci->bomchecked = 1;
+  }
+
+again:
+  p = ci->buffer + ci->offset;
+  end = ci->buffer + ci->size;
+  if (p == end)
+    return 0;
+
+  ci->nfields = 0;
+  for (;;)
+  {
+    field.start = p;
+    field.quoted = (ci->quote >= 0 && p < end && *p == (char)ci->quote);
+    if (field.quoted)
+    {
+      /* find the closing quote - doubled quotes are part of the value */
+      p++;
+      for (;;)
+      {
+        p = memchr(p, ci->quote, end - p);
+        if (!p)
+        {
+          if (!ci->eof)
+            return 0;
+          p = end;
+          break;
+        }
+        if (p + 1 == end && !ci->eof)
+          return 0;
+        if (p + 1 == end || p[1] != (char)ci->quote)
+        {
+          p++;
+          break;
+        }
+        p += 2;
+      }
+    }
+    /* anything else up to the delimiter or end of line is included as is */
+    while (p < end && *p != ci->delimiter && *p != '\n' && *p != '\r')
+      p++;
+
+    field.len = p - field.start;
+    if (ci->nfields < ci->ncols)
+      ci->fields[ci->nfields] = field;
+    ci->nfields++;
+
+    if (p == end)
+    {
+      if (!ci->eof)
+        return 0;
+      break;
+    }
+    if (*p == ci->delimiter)
+    {
+      p++;
+      continue;
+    }
+    /* end of line is \n, \r\n, or \r */
+    if (*p == '\r')
+    {
+      if (p + 1 == end && !ci->eof)
+        return 0;
+      p++;
+      if (p < end && *p == '\n')
+        p++;
+    }
+    else
+      p++;
+    break;
+  }
+
+  ci->offset = p - ci->buffer;
+  if (ci->nfields == 1 && ci->fields[0].len == 0)
+    goto again;
+  ci->records++;
+  return 1;
+}
+
+/* removes the quoting from a field in place */
+static void
+csvimport_unquote(APSWCSVImport *ci, APSWCSVField *field)
+{
+  char quote = (char)ci->quote;
+  const char *in = field->start + 1, *end = field->start + field->len;
+  char *out = field->start;
+  int inquotes = 1;
+
+  while (in < end)
+  {
+    if (inquotes && *in == quote)
+    {
+      if (in + 1 < end && in[1] == quote)
+      {
+        *out++ = quote;
+        in += 2;
+        continue;
+      }
+      inquotes = 0;
+      in++;
+      continue;
+    }
+    *out++ = *in++;
+  }
+  field->len = out - field->start;
+}
+
+/* works out if an unquoted field is exactly an integer or a float.
+   Leading zeroes and plus signs mean it is text so that values like
+   phone numbers and zip codes are kept as is.  Integers too large for
+   64 bits are also text so no precision is lost. */
+static int
+csvimport_classify(const char *s, size_t len, sqlite3_int64 *intval)
+{
+  const char *end = s + len;
+  int negative = 0, isfloat = 0;
+  sqlite3_uint64 val = 0;
+
+  if (s < end && *s == '-')
+  {
+    negative = 1;
+    s++;
+  }
+  if (s == end || *s < '0' || *s > '9')
+    return SQLITE_TEXT;
+  if (*s == '0' && s + 1 < end && s[1] >= '0' && s[1] <= '9')
+    return SQLITE_TEXT;
+
+  for (; s < end && *s >= '0' && *s <= '9'; s++)
+  {
+    if (val > (~(sqlite3_uint64)0 - (*s - '0')) / 10)
+      isfloat = -1; /* overflow */
+    val = val * 10 + (*s - '0');
+  }
+  if (s < end && *s == '.')
+  {
+    s++;
+    if (s == end || *s < '0' || *s > '9')
+      return SQLITE_TEXT;
+    while (s < end && *s >= '0' && *s <= '9')
+      s++;
+    isfloat = 1;
+  }
+  if (s < end && (*s == 'e' || *s == 'E'))
+  {
+    s++;
+    if (s < end && (*s == '-' || *s == '+'))
+      s++;
+    if (s == end || *s < '0' || *s > '9')
+      return SQLITE_TEXT;
+    while (s < end && *s >= '0' && *s <= '9')
+      s++;
+    isfloat = 1;
+  }
+  if (s != end || isfloat < 0)
+    return SQLITE_TEXT;
+  if (isfloat)
+    return SQLITE_FLOAT;
+
+  if (negative)
+  {
+    if (val > (sqlite3_uint64)1 << 63)
+      return SQLITE_TEXT;
+    *intval = (sqlite3_int64)(0 - val);
+  }
+  else
+  {
+    if (val > ((sqlite3_uint64)1 << 63) - 1)
+      return SQLITE_TEXT;
+    *intval = (sqlite3_int64)val;
+  }
+  return SQLITE_INTEGER;
+}
+
+/* binds the fields of the current record */
+static int
+csvimport_bind(APSWCSVImport *ci, sqlite3_stmt *stmt)
+{
+  int i, res = SQLITE_OK;
+  sqlite3_int64 intval = 0;
+
+  for (i = 0; i < ci->ncols && res == SQLITE_OK; i++)
+  {
+    APSWCSVField *field = &ci->fields[i];
+
+    if (field->quoted)
+      csvimport_unquote(ci, field);
+    if (field->len > APSW_INT32_MAX)
+      return SQLITE_TOOBIG;
+    if (!field->quoted && ci->infer)
+    {
+      if (!field->len)
+      {
+        res = sqlite3_bind_null(stmt, i + 1);
+        continue;
+      }
+      switch (csvimport_classify(field->start, field->len, &intval))
+      {
+      case SQLITE_INTEGER:
+        res = sqlite3_bind_int64(stmt, i + 1, intval);
+        continue;
+      case SQLITE_FLOAT:
+        /* the record is complete so the delimiter can be overwritten */
+        field->start[field->len] = 0;
+        res = sqlite3_bind_double(stmt, i + 1, strtod(field->start, NULL));
+        continue;
+      }
+    }
+    res = sqlite3_bind_text(stmt, i + 1, field->start, (int)field->len, SQLITE_STATIC);
+  }
+  return res;
+}
+
+/* Works out how many columns table has and prepares the insert for it.
+   Called with the database mutex held. */
+static int
+csvimport_prepare(APSWCSVImport *ci, sqlite3 *db, const char *table, sqlite3_stmt **pstmt)
+{
+  sqlite3_stmt *stmt = NULL;
+  char *sql = NULL, *params = NULL;
+  int res, i;
+
+  res = sqlite3_prepare_v2(db, "select count(*) from pragma_table_info(?)", -1, &stmt, NULL);
+  if (res == SQLITE_OK)
+    res = sqlite3_bind_text(stmt, 1, table, -1, SQLITE_STATIC);
+  if (res == SQLITE_OK)
+    res = sqlite3_step(stmt);
+  if (res == SQLITE_ROW)
+  {
+    ci->ncols = sqlite3_column_int(stmt, 0);
+    res = SQLITE_OK;
+  }
+  sqlite3_finalize(stmt);
+  if (res != SQLITE_OK)
+    return res;
+
+  if (!ci->ncols)
+  {
+    /* gets SQLite to give the usual no such table error */
+    sql = sqlite3_mprintf("select * from \"%w\"", table);
+    if (!sql)
+      return SQLITE_NOMEM;
+    res = sqlite3_prepare_v2(db, sql, -1, &stmt, NULL);
+    sqlite3_free(sql);
+    sqlite3_finalize(stmt);
+    return (res == SQLITE_OK) ? SQLITE_ERROR : res;
+  }
+
+  params = sqlite3_malloc64((sqlite3_uint64)ci->ncols * 2);
+  if (!params)
+    return SQLITE_NOMEM;
+  for (i = 0; i < ci->ncols; i++)
+  {
+    params[i * 2] = '?';
+    params[i * 2 + 1] = ',';
+  }
+  params[ci->ncols * 2 - 1] = 0;
+
+  sql = sqlite3_mprintf("insert into \"%w\" values(%s)", table, params);
+  sqlite3_free(params);
+  if (!sql)
+    return SQLITE_NOMEM;
+  res = sqlite3_prepare_v2(db, sql, -1, pstmt, NULL);
+  sqlite3_free(sql);
+  return res;
+}
+
+/* Inserts all the complete records in the buffer.  Called with the
+   database mutex held.  Stops early with SQLITE_OK once rows reaches
+   untilrows (if positive).  Returns SQLITE_DONE when more data is
+   needed, -1 if a record has the wrong number of fields, or the error
+   from binding or stepping with stepped set for the latter. */
+static int
+csvimport_run(APSWCSVImport *ci, sqlite3_stmt *stmt, sqlite3_int64 untilrows)
+{
+  int res;
+
+  while (untilrows <= 0 || ci->rows < untilrows)
+  {
+    if (!csvimport_next(ci))
+      return SQLITE_DONE;
+    if (ci->skip)
+    {
+      ci->skip--;
+      continue;
+    }
+    ci->stepped = 0;
+    if (ci->nfields != ci->ncols)
+      return -1;
+    res = csvimport_bind(ci, stmt);
+    if (res == SQLITE_OK)
+    {
+      ci->stepped = 1;
+      res = sqlite3_step(stmt);
+    }
+    sqlite3_reset(stmt);
+    if (res != SQLITE_DONE)
+      return res;
+    ci->rows++;
+  }
+  return SQLITE_OK;
+}
@@ -154,6 +154,10 @@ struct APSWCursor
   PyObject *weakreflist;
 
   PyObject *description_cache[2];
+
+  /* bind text and blobs without copying them */
+  int static_bindings;
+  PyObject *static_held; /* list of objects bound with SQLITE_STATIC until the statement is reset */
 };
 
 typedef struct APSWCursor APSWCursor;
@@ -188,6 +192,8 @@ resetcursor(APSWCursor *self, int force)
       SET_EXC(res, self->connection->db);
     self->statement = 0;
   }
+  /* the statement is reset so the memory it pointed to is no longer used */
+  Py_CLEAR(self->static_held);
 
   Py_CLEAR(self->bindings);
   self->bindingsoffset = -1;
@@ -309,6 +315,8 @@ APSWCursor_new(PyTypeObject *type, PyObject *Py_UNUSED(args), PyObject *Py_UNUSE
     self->weakreflist = NULL;
     self->description_cache[0] = 0;
     self->description_cache[1] = 0;
+    self->static_bindings = 0;
+    self->static_held = 0;
   }
 
   return (PyObject *)self;
@@ -341,6 +349,7 @@ APSWCursor_tp_traverse(APSWCursor *self, visitproc visit, void *arg)
   Py_VISIT(self->connection);
   Py_VISIT(self->exectrace);
   Py_VISIT(self->rowtrace);
+  Py_VISIT(self->static_held);
   return 0;
 }
 
@@ -486,6 +495,66 @@ static PyObject *APSWCursor_getdescription_dbapi(APSWCursor *self)
   return APSWCursor_internal_getdescription(self, 1);
 }
 
+/** .. attribute:: static_bindings
+    :type: bool
+
+    By default SQLite makes its own copy of string and blob bindings.
+    When this is True the copy is skipped - a reference to each string
+    is kept and buffers (eg bytearray) stay exported until the
+    statement is reset, which happens when it completes, on the next
+    :meth:`execute` or :meth:`executemany` round, or on :meth:`close`.
+    While exported a buffer can't be resized, so appending to a bound
+    bytearray gives :exc:`BufferError` until then.
+
+    This is worth turning on when binding large strings or blobs.
+    :meth:`executemany` of a single statement without result rows
+    already avoids the copy.
+
+    -* sqlite3_bind_text sqlite3_bind_blob
+*/
+static PyObject *
+APSWCursor_get_static_bindings(APSWCursor *self)
+{
+  CHECK_USE(NULL);
+  CHECK_CURSOR_CLOSED(NULL);
+
+  return PyBool_FromLong(self->static_bindings);
+}
+
+static int
+APSWCursor_set_static_bindings(APSWCursor *self, PyObject *value)
+{
+  int v;
+
+  CHECK_USE(-1);
+  CHECK_CURSOR_CLOSED(-1);
+
+  if (!value)
+  {
+    PyErr_Format(PyExc_TypeError, "Can't delete static_bindings");
+    return -1;
+  }
+  v = PyObject_IsTrue(value);
+  if (v < 0)
+    return -1;
+  self->static_bindings = v;
+  return 0;
+}
+
+/* keeps obj alive until the statement is reset so that its memory can be
+   bound with SQLITE_STATIC.  Returns -1 with exception set on failure */
+static int
+APSWCursor_holdstatic(APSWCursor *self, PyObject *obj)
+{
+  if (!self->static_held)
+  {
+    self->static_held = PyList_New(0);
+    if (!self->static_held)
+      return -1;
+  }
+  return PyList_Append(self->static_held, obj);
+}
+
 /* internal function - returns SQLite error code (ie SQLITE_OK if all is well) */
 static int
 APSWCursor_dobinding(APSWCursor *self, int arg, PyObject *obj)
@@ -523,6 +592,13 @@ APSWCursor_dobinding(APSWCursor *self, int arg, PyObject *obj)
       {
         SET_EXC(SQLITE_TOOBIG, NULL);
       }
+      else if (self->static_bindings)
+      {
+        /* the utf8 lives as long as the object */
+        if (APSWCursor_holdstatic(self, obj))
+          return -1;
+        PYSQLITE_CUR_CALL(res = sqlite3_bind_text(self->statement->vdbestatement, arg, strdata, strbytes, SQLITE_STATIC));
+      }
       else
         PYSQLITE_CUR_CALL(res = sqlite3_bind_text(self->statement->vdbestatement, arg, strdata, strbytes, SQLITE_TRANSIENT));
     }
@@ -532,6 +608,47 @@ APSWCursor_dobinding(APSWCursor *self, int arg, PyObject *obj)
       return -1;
     }
   }
+  else if (PyObject_CheckBuffer(obj) && self->static_bindings)
+  {
+    /* bytes are immutable so a reference is sufficient, while anything
+       else stays exported via a memoryview until the statement is reset */
+    PyObject *held;
+    const void *data;
+    Py_ssize_t len;
+
+    if (PyBytes_CheckExact(obj))
+    {
+      held = obj;
+      Py_INCREF(held);
+      data = PyBytes_AS_STRING(obj);
+      len = PyBytes_GET_SIZE(obj);
+    }
+    else
+    {
+      held = PyMemoryView_FromObject(obj);
+      if (!held)
+        return -1;
+      if (!PyBuffer_IsContiguous(PyMemoryView_GET_BUFFER(held), 'C'))
+      {
+        Py_DECREF(held);
+        PyErr_Format(PyExc_BufferError, "Binding argument #%d is not a contiguous buffer", (int)(arg + self->bindingsoffset));
+        return -1;
+      }
+      data = PyMemoryView_GET_BUFFER(held)->buf;
+      len = PyMemoryView_GET_BUFFER(held)->len;
+    }
+    if (len > APSW_INT32_MAX)
+    {
+      Py_DECREF(held);
+      SET_EXC(SQLITE_TOOBIG, NULL);
+      return -1;
+    }
+    res = APSWCursor_holdstatic(self, held);
+    Py_DECREF(held);
+    if (res)
+      return -1;
+    PYSQLITE_CUR_CALL(res = sqlite3_bind_blob(self->statement->vdbestatement, arg, data, len, SQLITE_STATIC));
+  }
   else if (PyObject_CheckBuffer(obj))
   {
     int asrb;
@@ -744,17 +861,22 @@ APSWCursor_dorowtrace(APSWCursor *self, PyObject *retval)
   return PyObject_CallFunction(rowtrace, "OO", self, retval);
 }
 
-/* Returns a borrowed reference to self if all is ok, else NULL on error */
+/* Returns a borrowed reference to self if all is ok, else NULL on error.  res
+   is the result of an sqlite3_step already done by the caller, or -1 to step
+   here */
 static PyObject *
-APSWCursor_step(APSWCursor *self)
+APSWCursor_dostep(APSWCursor *self, int res)
 {
-  int res;
   int savedbindingsoffset = 0; /* initialised to stop stupid compiler from whining */
 
   for (;;)
   {
-    assert(!PyErr_Occurred());
-    PYSQLITE_CUR_CALL(res = (self->statement->vdbestatement) ? (sqlite3_step(self->statement->vdbestatement)) : (SQLITE_DONE));
+    if (res == -1)
+    {
+      assert(!PyErr_Occurred());
+      PYSQLITE_CUR_CALL(res = (self->statement->vdbestatement) ? (sqlite3_step(self->statement->vdbestatement)) : (SQLITE_DONE);
+                        changes_stepped(self->connection, self->statement->vdbestatement, res));
+    }
 
     switch (res & 0xff)
     {
@@ -820,6 +942,7 @@ APSWCursor_step(APSWCursor *self)
       /* we need to clear just completed and restart original executemany statement */
       INUSE_CALL(statementcache_finalize(self->connection->stmtcache, self->statement));
       self->statement = NULL;
+      Py_CLEAR(self->static_held);
       /* don't need bindings from last round if emiter.next() */
       Py_CLEAR(self->bindings);
       self->bindingsoffset = 0;
@@ -850,6 +973,8 @@ APSWCursor_step(APSWCursor *self)
       /* next sql statement */
       INUSE_CALL(res = statementcache_next(self->connection->stmtcache, &self->statement));
       SET_EXC(res, self->connection->db);
+      /* the previous statement has been finalized */
+      Py_CLEAR(self->static_held);
     }
 
     if (res != SQLITE_OK)
@@ -884,6 +1009,7 @@ APSWCursor_step(APSWCursor *self)
     }
     assert(self->status == C_DONE);
     self->status = C_BEGIN;
+    res = -1;
   }
 
   /* you can't actually get here */
@@ -891,6 +1017,348 @@ APSWCursor_step(APSWCursor *self)
   return NULL;
 }
 
+static PyObject *
+APSWCursor_step(APSWCursor *self)
+{
+  return APSWCursor_dostep(self, -1);
+}
+
+/* ROW BATCHES
+
+   Rather than stepping one row at a time with the GIL and database
+   mutex released and acquired for each, a batch of rows is copied out
+   of the statement in one go and Python objects are then made from
+   the batch in a single pass.  Text and blob contents are copied into
+   an arena with the cells recording offset and length.
+
+   Everything in a batch is allocated with the PyMem_Raw functions
+   since filling happens with the GIL released. */
+
+typedef struct
+{
+  int type; /* SQLITE_INTEGER etc */
+  union
+  {
+    sqlite3_int64 i;
+    double d;
+    struct
+    {
+      size_t offset;
+      size_t len;
+    } b;
+  } v;
+} APSWBatchCell;
+
+typedef struct
+{
+  int ncols;            /* columns in each row */
+  int nrows;            /* rows currently in the batch */
+  int maxrows;          /* stop filling at this many rows */
+  int coerce;           /* convert values to the type of the first non-null value in their column */
+  int nomem;            /* memory allocation failed while filling */
+  int onestatement;     /* return when a statement finishes even if no rows were copied */
+  int finished;         /* a statement finished during the fill */
+  int *coltypes;        /* when coercing, the type of each column (SQLITE_NULL until known) */
+  APSWBatchCell *cells; /* nrows * ncols */
+  size_t cells_size;    /* how many cells are allocated */
+  char *arena;          /* text and blob contents */
+  size_t arena_used;
+  size_t arena_size;
+} APSWRowBatch;
+
+static void
+rowbatch_init(APSWRowBatch *batch, int maxrows, int coerce)
+{
+  memset(batch, 0, sizeof(APSWRowBatch));
+  batch->maxrows = maxrows;
+  batch->coerce = coerce;
+}
+
+static void
+rowbatch_free(APSWRowBatch *batch)
+{
+  PyMem_RawFree(batch->coltypes);
+  PyMem_RawFree(batch->cells);
+  PyMem_RawFree(batch->arena);
+  batch->coltypes = NULL;
+  batch->cells = NULL;
+  batch->arena = NULL;
+}
+
+/* empties the batch ready for rows with ncols columns.  Returns -1 with exception set on failure */
+static int
+rowbatch_reset(APSWRowBatch *batch, int ncols)
+{
+  int i;
+
+  batch->nrows = 0;
+  batch->nomem = 0;
+  batch->arena_used = 0;
+  if (batch->coerce && ncols > batch->ncols)
+  {
+    int *coltypes = PyMem_RawRealloc(batch->coltypes, sizeof(int) * ncols);
+    if (!coltypes)
+    {
+      PyErr_NoMemory();
+      return -1;
+    }
+    batch->coltypes = coltypes;
+  }
+  batch->ncols = ncols;
+  for (i = 0; batch->coerce && i < ncols; i++)
+    batch->coltypes[i] = SQLITE_NULL;
+  return 0;
+}
+
+/* copies the current row of stmt into the batch.  Called with the GIL
+   released and the database mutex held.  Returns -1 if memory could not be
+   allocated */
+static int
+rowbatch_add_row(APSWRowBatch *batch, sqlite3_stmt *stmt)
+{
+  APSWBatchCell *cell;
+  size_t needed = (size_t)(batch->nrows + 1) * batch->ncols;
+  int i;
+
+  if (needed > batch->cells_size)
+  {
+    size_t size = batch->cells_size ? batch->cells_size * 2 : (size_t)batch->ncols * 64;
+    APSWBatchCell *cells;
+    while (size < needed)
+      size *= 2;
+    cells = PyMem_RawRealloc(batch->cells, size * sizeof(APSWBatchCell));
+    if (!cells)
+      return -1;
+    batch->cells = cells;
+    batch->cells_size = size;
+  }
+
+  cell = batch->cells + (size_t)batch->nrows * batch->ncols;
+  for (i = 0; i < batch->ncols; i++, cell++)
+  {
+    int type = sqlite3_column_type(stmt, i);
+
+    if (batch->coerce && type != SQLITE_NULL)
+    {
+      /* SQLite does the conversion when asked for the column as a different type */
+      if (batch->coltypes[i] == SQLITE_NULL)
+        batch->coltypes[i] = type;
+      else
+        type = batch->coltypes[i];
+    }
+    cell->type = type;
+
+    switch (type)
+    {
+    case SQLITE_INTEGER:
+      cell->v.i = sqlite3_column_int64(stmt, i);
+      break;
+    case SQLITE_FLOAT:
+      cell->v.d = sqlite3_column_double(stmt, i);
+      break;
+    case SQLITE_TEXT:
+    case SQLITE_BLOB:
+    {
+      const void *data = (type == SQLITE_TEXT) ? (const void *)sqlite3_column_text(stmt, i) : sqlite3_column_blob(stmt, i);
+      size_t len = sqlite3_column_bytes(stmt, i);
+
+      if (batch->arena_used + len > batch->arena_size)
+      {
+        size_t size = batch->arena_size ? batch->arena_size * 2 : 4096;
+        char *arena;
+        while (size < batch->arena_used + len)
+          size *= 2;
+        arena = PyMem_RawRealloc(batch->arena, size);
+        if (!arena)
+          return -1;
+        batch->arena = arena;
+        batch->arena_size = size;
+      }
+      if (len)
+        memcpy(batch->arena + batch->arena_used, data, len);
+      cell->v.b.offset = batch->arena_used;
+      cell->v.b.len = len;
+      batch->arena_used += len;
+      break;
+    }
+    default:
+      break;
+    }
+  }
+  batch->nrows++;
+  return 0;
+}
+
+/* steps stmt copying rows into the batch until it is full or there are no
+   more rows.  pending is non-zero if a row is already available.  Called
+   with the GIL released and the database mutex held.  Returns the last
+   result of sqlite3_step (SQLITE_ROW if the batch was filled with all rows
+   consumed).  If memory runs out then nomem is set in the batch and the
+   current row remains available. */
+static int
+rowbatch_fill(APSWRowBatch *batch, sqlite3_stmt *stmt, int pending)
+{
+  int res = SQLITE_ROW;
+
+  while (batch->nrows < batch->maxrows)
+  {
+    if (!pending)
+    {
+      res = stmt ? sqlite3_step(stmt) : SQLITE_DONE;
+      if (res != SQLITE_ROW)
+        break;
+    }
+    pending = 0;
+    if (rowbatch_add_row(batch, stmt))
+    {
+      batch->nomem = 1;
+      break;
+    }
+  }
+  return res;
+}
+
+/* Fills the batch with rows from the current statement.  Returns 0 on
+   success with the batch empty if there are no more rows, else -1 with an
+   exception set. The batch only ever contains rows from one statement. */
+static int
+APSWCursor_fillbatch(APSWCursor *self, APSWRowBatch *batch)
+{
+  int res, pending;
+
+  batch->finished = 0;
+  while (self->status != C_DONE)
+  {
+    if (rowbatch_reset(batch, sqlite3_column_count(self->statement->vdbestatement)))
+      return -1;
+
+    pending = (self->status == C_ROW);
+    self->status = C_BEGIN;
+    assert(!PyErr_Occurred());
+    PYSQLITE_CUR_CALL(res = rowbatch_fill(batch, self->statement->vdbestatement, pending);
+                      changes_stepped(self->connection, self->statement->vdbestatement, res));
+
+    if (batch->nomem)
+    {
+      /* the row that could not be copied is still available */
+      self->status = C_ROW;
+      if (batch->nrows)
+        return 0;
+      PyErr_NoMemory();
+      return -1;
+    }
+
+    if (res == SQLITE_ROW)
+      return PyErr_Occurred() ? -1 : 0;
+
+    /* statement finished or failed */
+    if (!APSWCursor_dostep(self, res))
+      return -1;
+    batch->finished = 1;
+
+    /* rows so far are from the finished statement so return them before
+       any from the next */
+    if (batch->nrows || batch->onestatement)
+      return 0;
+  }
+  return 0;
+}
+
+/* how many rows are stepped per GIL release when fetching all rows */
+#define APSW_FETCH_BATCH_ROWS 256
+
+/* Converts a batch cell to PyObject.  Returns a new reference. */
+static PyObject *
+rowbatch_cell_to_pyobject(APSWRowBatch *batch, APSWBatchCell *cell)
+{
+  switch (cell->type)
+  {
+  case SQLITE_INTEGER:
+    return PyLong_FromLongLong(cell->v.i);
+  case SQLITE_FLOAT:
+    return PyFloat_FromDouble(cell->v.d);
+  case SQLITE_TEXT:
+    return PyUnicode_FromStringAndSize(cell->v.b.len ? batch->arena + cell->v.b.offset : "", cell->v.b.len);
+  case SQLITE_BLOB:
+    return PyBytes_FromStringAndSize(cell->v.b.len ? batch->arena + cell->v.b.offset : "", cell->v.b.len);
+  case SQLITE_NULL:
+    Py_RETURN_NONE;
+  default:
+    return PyErr_Format(APSWException, "Unknown sqlite column type %d!", cell->type);
+  }
+}
+
+static PyObject *APSWCursor_next(APSWCursor *self);
+
+/* Appends up to size rows (all remaining if size is negative) to list.
+   Returns -1 with an exception set on error */
+static int
+APSWCursor_fetchrows(APSWCursor *self, PyObject *list, Py_ssize_t size)
+{
+  APSWRowBatch batch;
+  Py_ssize_t fetched = 0;
+  int row, col;
+
+  /* row tracers can look at the cursor so they have to be called while
+     the statement is still on the row */
+  if (ROWTRACE)
+  {
+    while (size < 0 || fetched < size)
+    {
+      PyObject *item = APSWCursor_next(self);
+      if (!item)
+        return PyErr_Occurred() ? -1 : 0;
+      if (PyList_Append(list, item))
+      {
+        Py_DECREF(item);
+        return -1;
+      }
+      Py_DECREF(item);
+      fetched++;
+    }
+    return 0;
+  }
+
+  rowbatch_init(&batch, 0, 0);
+  while (self->status != C_DONE && (size < 0 || fetched < size))
+  {
+    batch.maxrows = (size < 0) ? APSW_FETCH_BATCH_ROWS : (int)Py_MIN(size - fetched, INT_MAX);
+    if (APSWCursor_fillbatch(self, &batch))
+      goto error;
+
+    for (row = 0; row < batch.nrows; row++)
+    {
+      APSWBatchCell *cell = batch.cells + (size_t)row * batch.ncols;
+      PyObject *tuple = PyTuple_New(batch.ncols);
+      if (!tuple)
+        goto error;
+      for (col = 0; col < batch.ncols; col++, cell++)
+      {
+        PyObject *item = rowbatch_cell_to_pyobject(&batch, cell);
+        if (!item)
+        {
+          Py_DECREF(tuple);
+          goto error;
+        }
+        PyTuple_SET_ITEM(tuple, col, item);
+      }
+      if (PyList_Append(list, tuple))
+      {
+        Py_DECREF(tuple);
+        goto error;
+      }
+      Py_DECREF(tuple);
+    }
+    fetched += batch.nrows;
+  }
+  rowbatch_free(&batch);
+  return 0;
+
+error:
+  rowbatch_free(&batch);
+  return -1;
+}
+
 /** .. method:: execute(statements: str, bindings: Optional[Union[Sequence,Dict]] = None) -> Cursor
 
     Executes the statements using the supplied bindings.  Execution
@@ -1026,62 +1494,416 @@ APSWCursor_execute(APSWCursor *self, PyObject *args, PyObject *kwds)
   return retval;
 }
 
-/** .. method:: executemany(statements: str, sequenceofbindings: Sequence[Union[Sequence,Dict]]) -> Cursor
-
-  This method is for when you want to execute the same statements over
-  a sequence of bindings.  Conceptually it does this::
+/* BIND BATCHES
 
-    for binding in sequenceofbindings:
-        cursor.execute(statements, binding)
+   executemany normally goes through the iterator and binds each value
+   with a separate GIL release, then steps.  When the statement is a
+   single statement without result rows and there is no exec tracer, a
+   chunk of rows is instead converted to C values with the GIL held,
+   and then all the rows in the chunk are bound and stepped with one
+   GIL release.  References are held to text objects and buffers are
+   kept acquired until the chunk has run, so values are bound with
+   SQLITE_STATIC and are not copied. */
 
-  Example::
+/* how many rows are bound and stepped per GIL release */
+#define APSW_BIND_BATCH_ROWS 256
 
-    rows=(  (1, 7),
-            (2, 23),
-            (4, 92),
-            (12, 12) )
+/* a cell type in addition to the SQLITE_ ones */
+#define APSW_BIND_ZEROBLOB 0x100
 
-    cursor.executemany("insert into nums values(?,?)", rows)
+typedef struct
+{
+  int type; /* SQLITE_NULL etc or APSW_BIND_ZEROBLOB */
+  union
+  {
+    sqlite3_int64 i;
+    double d;
+    struct
+    {
+      const void *data;
+      Py_ssize_t len;
+    } b;
+  } v;
+} APSWBindCell;
 
-  The return is the cursor itself which acts as an iterator.  Your
-  statements can return data.  See :meth:`~Cursor.execute` for more
-  information.
-*/
+typedef struct
+{
+  int nargs;            /* bindings per row */
+  int nrows;            /* rows currently in batch */
+  int maxrows;          /* rows space is allocated for */
+  APSWBindCell *cells;  /* nrows * nargs */
+  PyObject **objects;   /* text objects we hold a reference to */
+  int nobjects;
+  Py_buffer *buffers;   /* acquired buffers */
+  int nbuffers;
+} APSWBindBatch;
+
+/* returns -1 with exception set on failure */
+static int
+bindbatch_init(APSWBindBatch *bb, int nargs)
+{
+  size_t ncells = (size_t)APSW_BIND_BATCH_ROWS * (nargs ? nargs : 1);
+
+  memset(bb, 0, sizeof(APSWBindBatch));
+  bb->nargs = nargs;
+  bb->maxrows = APSW_BIND_BATCH_ROWS;
+  bb->cells = PyMem_Malloc(sizeof(APSWBindCell) * ncells);
+  bb->objects = PyMem_Malloc(sizeof(PyObject *) * ncells);
+  bb->buffers = PyMem_Malloc(sizeof(Py_buffer) * ncells);
+  if (!bb->cells || !bb->objects || !bb->buffers)
+  {
+    PyErr_NoMemory();
+    return -1;
+  }
+  return 0;
+}
 
-static PyObject *
-APSWCursor_executemany(APSWCursor *self, PyObject *args, PyObject *kwds)
+/* releases references and buffers down to the supplied counts */
+static void
+bindbatch_release(APSWBindBatch *bb, int nobjects, int nbuffers)
 {
-  int res;
-  PyObject *retval = NULL;
-  PyObject *sequenceofbindings = NULL;
-  PyObject *next = NULL;
-  PyObject *statements = NULL;
-  int savedbindingsoffset = -1;
+  while (bb->nobjects > nobjects)
+    Py_DECREF(bb->objects[--bb->nobjects]);
+  while (bb->nbuffers > nbuffers)
+    PyBuffer_Release(&bb->buffers[--bb->nbuffers]);
+}
 
-  CHECK_USE(NULL);
-  CHECK_CURSOR_CLOSED(NULL);
+static void
+bindbatch_free(APSWBindBatch *bb)
+{
+  if (bb->objects && bb->buffers)
+    bindbatch_release(bb, 0, 0);
+  PyMem_Free(bb->cells);
+  PyMem_Free(bb->objects);
+  PyMem_Free(bb->buffers);
+  memset(bb, 0, sizeof(APSWBindBatch));
+}
 
-  res = resetcursor(self, /* force= */ 0);
-  if (res != SQLITE_OK)
+/* converts obj for binding argument number arg.  Returns -1 with exception
+   set on failure.  DUPLICATE(ish) code: this follows APSWCursor_dobinding
+   so if you fix anything here then do it there as well. */
+static int
+bindbatch_set_value(APSWBindBatch *bb, APSWBindCell *cell, PyObject *obj, int arg)
+{
+  if (obj == Py_None)
+    cell->type = SQLITE_NULL;
+  else if (PyLong_Check(obj))
   {
-    assert(PyErr_Occurred());
-    return NULL;
+    cell->type = SQLITE_INTEGER;
+    cell->v.i = PyLong_AsLongLong(obj);
+    if (cell->v.i == -1 && PyErr_Occurred())
+      return -1;
   }
-
-  assert(!self->bindings);
-  assert(!self->emiter);
-  assert(!self->emoriginalquery);
-  assert(self->status == C_DONE);
+  else if (PyFloat_Check(obj))
   {
-    static char *kwlist[] = {"statements", "sequenceofbindings", NULL};
-    Cursor_executemany_CHECK;
-    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O!O:" Cursor_executemany_USAGE, kwlist, &PyUnicode_Type, &statements, &sequenceofbindings))
-      return NULL;
+    cell->type = SQLITE_FLOAT;
+    cell->v.d = PyFloat_AS_DOUBLE(obj);
   }
-  self->emiter = PyObject_GetIter(sequenceofbindings);
-  if (!self->emiter)
-    return PyErr_Format(PyExc_TypeError, "2nd parameter must be iterable");
-
+  else if (PyUnicode_Check(obj))
+  {
+    cell->type = SQLITE_TEXT;
+    cell->v.b.data = PyUnicode_AsUTF8AndSize(obj, &cell->v.b.len);
+    if (!cell->v.b.data)
+      return -1;
+    if (cell->v.b.len > APSW_INT32_MAX)
+    {
+      SET_EXC(SQLITE_TOOBIG, NULL);
+      return -1;
+    }
+    /* the utf8 lives as long as the object */
+    Py_INCREF(obj);
+    bb->objects[bb->nobjects++] = obj;
+  }
+  else if (PyObject_CheckBuffer(obj))
+  {
+    Py_buffer *buffer = &bb->buffers[bb->nbuffers];
+    if (PyObject_GetBuffer(obj, buffer, PyBUF_SIMPLE))
+      return -1;
+    bb->nbuffers++;
+    if (buffer->len > APSW_INT32_MAX)
+    {
+      SET_EXC(SQLITE_TOOBIG, NULL);
+      return -1;
+    }
+    cell->type = SQLITE_BLOB;
+    cell->v.b.data = buffer->buf;
+    cell->v.b.len = buffer->len;
+  }
+  else if (PyObject_TypeCheck(obj, &ZeroBlobBindType) == 1)
+  {
+    cell->type = APSW_BIND_ZEROBLOB;
+    cell->v.i = ((ZeroBlobBind *)obj)->blobsize;
+  }
+  else
+  {
+    PyErr_Format(PyExc_TypeError, "Bad binding argument type supplied - argument #%d: type %s", arg, Py_TYPE(obj)->tp_name);
+    return -1;
+  }
+  return 0;
+}
+
+/* binds and steps each row in the batch.  Called with the GIL released and
+   the database mutex held.  Returns SQLITE_DONE if all rows ran, else the
+   error code with *failedrow set, and *stepped set if the error came from
+   sqlite3_step rather than binding. */
+static int
+bindbatch_run(APSWBindBatch *bb, sqlite3_stmt *stmt, int *failedrow, int *stepped)
+{
+  APSWBindCell *cell = bb->cells;
+  int row, arg, res = SQLITE_DONE;
+
+  for (row = 0; row < bb->nrows; row++)
+  {
+    *failedrow = row;
+    *stepped = 0;
+    for (arg = 1; arg <= bb->nargs; arg++, cell++)
+    {
+      switch (cell->type)
+      {
+      case SQLITE_INTEGER:
+        res = sqlite3_bind_int64(stmt, arg, cell->v.i);
+        break;
+      case SQLITE_FLOAT:
+        res = sqlite3_bind_double(stmt, arg, cell->v.d);
+        break;
+      case SQLITE_TEXT:
+        res = sqlite3_bind_text(stmt, arg, cell->v.b.data, (int)cell->v.b.len, SQLITE_STATIC);
+        break;
+      case SQLITE_BLOB:
+        res = sqlite3_bind_blob(stmt, arg, cell->v.b.data, (int)cell->v.b.len, SQLITE_STATIC);
+        break;
+      case APSW_BIND_ZEROBLOB:
+        res = sqlite3_bind_zeroblob(stmt, arg, (int)cell->v.i);
+        break;
+      default:
+        res = sqlite3_bind_null(stmt, arg);
+        break;
+      }
+      if (res != SQLITE_OK)
+        return res;
+    }
+    *stepped = 1;
+    res = sqlite3_step(stmt);
+    if (res != SQLITE_DONE)
+      return res;
+    sqlite3_reset(stmt);
+  }
+  return SQLITE_DONE;
+}
+
+/* Runs the rows in the batch and then empties it.  Returns -1 with
+   exception set on failure */
+static int
+APSWCursor_runbindbatch(APSWCursor *self, APSWBindBatch *bb)
+{
+  int res, failedrow = 0, stepped = 0;
+
+  assert(!PyErr_Occurred());
+  PYSQLITE_CUR_CALL(res = bindbatch_run(bb, self->statement->vdbestatement, &failedrow, &stepped);
+                    changes_stepped(self->connection, self->statement->vdbestatement, stepped ? res : SQLITE_OK));
+  bb->nrows = 0;
+  bindbatch_release(bb, 0, 0);
+
+  if (res == SQLITE_DONE && !PyErr_Occurred())
+    return 0;
+
+  assert(res != SQLITE_ROW);
+  if (res == SQLITE_DONE || stepped)
+  {
+    /* the normal step error handling gets the error code and finalizes */
+    APSWCursor_dostep(self, res);
+    return -1;
+  }
+  SET_EXC(res, self->connection->db);
+  return -1;
+}
+
+/* adds a row of bindings (dict or sequence) to the batch.  names is
+   filled in the first time a dict is seen.  Returns -1 with exception set
+   on failure in which case nothing is added */
+static int
+APSWCursor_bindbatch_add_row(APSWCursor *self, APSWBindBatch *bb, PyObject *row, PyObject **names)
+{
+  APSWBindCell *cells = bb->cells + (size_t)bb->nrows * bb->nargs;
+  int res = SQLITE_OK, arg, nobjects = bb->nobjects, nbuffers = bb->nbuffers;
+  PyObject *seq = NULL;
+
+  if (PyDict_Check(row))
+  {
+    for (arg = 1; arg <= bb->nargs; arg++)
+    {
+      PyObject *obj;
+      if (!names[arg - 1])
+      {
+        const char *key;
+        PYSQLITE_CUR_CALL(key = sqlite3_bind_parameter_name(self->statement->vdbestatement, arg));
+        if (!key)
+        {
+          PyErr_Format(ExcBindings, "Binding %d has no name, but you supplied a dict (which only has names).", arg - 1);
+          goto error;
+        }
+        assert(*key == ':' || *key == '$');
+        key++; /* first char is a colon or dollar which we skip */
+        names[arg - 1] = PyUnicode_DecodeUTF8(key, strlen(key), NULL);
+        if (!names[arg - 1])
+          goto error;
+      }
+      obj = PyDict_GetItem(row, names[arg - 1]);
+      /* missing keys are null - the same as the statement being reprepared */
+      if (!obj)
+        cells[arg - 1].type = SQLITE_NULL;
+      else if (bindbatch_set_value(bb, &cells[arg - 1], obj, arg))
+        goto error;
+    }
+  }
+  else
+  {
+    seq = PySequence_Fast(row, "You must supply a dict or a sequence");
+    if (!seq)
+      goto error;
+    if (PySequence_Fast_GET_SIZE(seq) != bb->nargs)
+    {
+      PyErr_Format(ExcBindings, "Incorrect number of bindings supplied.  The current statement uses %d and there are %d supplied.  Current offset is %d",
+                   bb->nargs, (int)PySequence_Fast_GET_SIZE(seq), 0);
+      goto error;
+    }
+    for (arg = 1; arg <= bb->nargs; arg++)
+      if (bindbatch_set_value(bb, &cells[arg - 1], PySequence_Fast_GET_ITEM(seq, arg - 1), arg))
+        goto error;
+    Py_DECREF(seq);
+  }
+  bb->nrows++;
+  return 0;
+
+error:
+  Py_XDECREF(seq);
+  bindbatch_release(bb, nobjects, nbuffers);
+  return -1;
+}
+
+/* executemany for a single statement with no result rows and no exec
+   tracer.  self->bindings is the first row and the rest come from
+   self->emiter.  Returns -1 with exception set on failure */
+static int
+APSWCursor_executemany_batched(APSWCursor *self)
+{
+  APSWBindBatch bb;
+  PyObject **names = NULL, *row = NULL;
+  PyObject *etype = NULL, *evalue = NULL, *etb = NULL;
+  int nargs, i, res = -1;
+
+  nargs = sqlite3_bind_parameter_count(self->statement->vdbestatement);
+  if (bindbatch_init(&bb, nargs))
+    goto finally;
+  names = PyMem_Calloc(nargs ? nargs : 1, sizeof(PyObject *));
+  if (!names)
+  {
+    PyErr_NoMemory();
+    goto finally;
+  }
+
+  row = self->bindings;
+  self->bindings = NULL;
+
+  while (row)
+  {
+    if (APSWCursor_bindbatch_add_row(self, &bb, row, names))
+      Py_CLEAR(row);
+    else
+    {
+      Py_DECREF(row);
+      INUSE_CALL(row = PyIter_Next(self->emiter));
+    }
+
+    if (row && bb.nrows < bb.maxrows)
+      continue;
+
+    /* rows before a failure are still run, with their errors taking priority */
+    if (PyErr_Occurred())
+      PyErr_Fetch(&etype, &evalue, &etb);
+    if (bb.nrows && APSWCursor_runbindbatch(self, &bb))
+      goto finally;
+    if (etype || evalue)
+    {
+      PyErr_Restore(etype, evalue, etb);
+      etype = evalue = etb = NULL;
+      goto finally;
+    }
+  }
+
+  res = resetcursor(self, 0);
+  assert(res == SQLITE_OK || PyErr_Occurred());
+  res = (res == SQLITE_OK) ? 0 : -1;
+
+finally:
+  Py_XDECREF(row);
+  Py_XDECREF(etype);
+  Py_XDECREF(evalue);
+  Py_XDECREF(etb);
+  for (i = 0; names && i < nargs; i++)
+    Py_XDECREF(names[i]);
+  PyMem_Free(names);
+  bindbatch_free(&bb);
+  self->status = C_DONE;
+  return res;
+}
+
+/** .. method:: executemany(statements: str, sequenceofbindings: Sequence[Union[Sequence,Dict]]) -> Cursor
+
+  This method is for when you want to execute the same statements over
+  a sequence of bindings.  Conceptually it does this::
+
+    for binding in sequenceofbindings:
+        cursor.execute(statements, binding)
+
+  Example::
+
+    rows=(  (1, 7),
+            (2, 23),
+            (4, 92),
+            (12, 12) )
+
+    cursor.executemany("insert into nums values(?,?)", rows)
+
+  The return is the cursor itself which acts as an iterator.  Your
+  statements can return data.  See :meth:`~Cursor.execute` for more
+  information.
+*/
+
+static PyObject *
+APSWCursor_executemany(APSWCursor *self, PyObject *args, PyObject *kwds)
+{
+  int res;
+  PyObject *retval = NULL;
+  PyObject *sequenceofbindings = NULL;
+  PyObject *next = NULL;
+  PyObject *statements = NULL;
+  int savedbindingsoffset = -1;
+
+  CHECK_USE(NULL);
+  CHECK_CURSOR_CLOSED(NULL);
+
+  res = resetcursor(self, /* force= */ 0);
+  if (res != SQLITE_OK)
+  {
+    assert(PyErr_Occurred());
+    return NULL;
+  }
+
+  assert(!self->bindings);
+  assert(!self->emiter);
+  assert(!self->emoriginalquery);
+  assert(self->status == C_DONE);
+  {
+    static char *kwlist[] = {"statements", "sequenceofbindings", NULL};
+    Cursor_executemany_CHECK;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O!O:" Cursor_executemany_USAGE, kwlist, &PyUnicode_Type, &statements, &sequenceofbindings))
+      return NULL;
+  }
+  self->emiter = PyObject_GetIter(sequenceofbindings);
+  if (!self->emiter)
+    return PyErr_Format(PyExc_TypeError, "2nd parameter must be iterable");
+
   INUSE_CALL(next = PyIter_Next(self->emiter));
   if (!next && PyErr_Occurred())
     return NULL;
@@ -1118,6 +1940,18 @@ APSWCursor_executemany(APSWCursor *self, PyObject *args, PyObject *kwds)
   self->emoriginalquery = statements;
   Py_INCREF(self->emoriginalquery);
 
+  /* a single statement that doesn't return rows can be done in batches */
+  if (!EXECTRACE && !statementcache_hasmore(self->statement) && self->statement->vdbestatement && !sqlite3_column_count(self->statement->vdbestatement))
+  {
+    if (APSWCursor_executemany_batched(self))
+    {
+      assert(PyErr_Occurred());
+      return NULL;
+    }
+    Py_INCREF(self);
+    return (PyObject *)self;
+  }
+
   self->bindingsoffset = 0;
   savedbindingsoffset = 0;
 
@@ -1148,105 +1982,401 @@ APSWCursor_executemany(APSWCursor *self, PyObject *args, PyObject *kwds)
   return retval;
 }
 
-/** .. method:: close(force: bool = False) -> None
-
-  It is very unlikely you will need to call this method.  It exists
-  because older versions of SQLite required all Connection/Cursor
-  activity to be confined to the same thread.  That is no longer the
-  case.  Cursors are automatically garbage collected and when there
-  are none left will allow the connection to be garbage collected if
-  it has no other references.
-
-  A cursor is open if there are remaining statements to execute (if
-  your query included multiple statements), or if you called
-  :meth:`~Cursor.executemany` and not all of the *sequenceofbindings*
-  have been used yet.
+/* a column for executemany_columns */
+typedef struct
+{
+  PyObject *seq;    /* PySequence_Fast of values, or NULL if a buffer */
+  Py_buffer buffer; /* numeric values */
+  char format;      /* struct module format character for buffer */
+} APSWBindColumn;
 
-  :param force: If False then you will get exceptions if there is
-   remaining work to do be in the Cursor such as more statements to
-   execute, more data from the executemany binding sequence etc. If
-   force is True then all remaining work and state information will be
-   silently discarded.
+/* gets a value from a numeric buffer column.  Returns -1 with exception set
+   on failure */
+static int
+bindcolumn_value(APSWBindColumn *column, Py_ssize_t row, APSWBindCell *cell)
+{
+  const char *item = (const char *)column->buffer.buf + row * column->buffer.itemsize;
+  unsigned long long u = 0;
 
-*/
+  cell->type = SQLITE_INTEGER;
+  switch (column->format)
+  {
+#define COLVAL(fmt, ctype, field) \
+  case fmt:                       \
+  {                               \
+    ctype v;                      \
+    memcpy(&v, item, sizeof(v));  \
+    field = v;                    \
+    break;                        \
+  }
+    COLVAL('b', signed char, cell->v.i)
+    COLVAL('B', unsigned char, cell->v.i)
+    COLVAL('h', short, cell->v.i)
+    COLVAL('H', unsigned short, cell->v.i)
+    COLVAL('i', int, cell->v.i)
+    COLVAL('I', unsigned int, cell->v.i)
+    COLVAL('l', long, cell->v.i)
+    COLVAL('q', long long, cell->v.i)
+    COLVAL('n', Py_ssize_t, cell->v.i)
+    COLVAL('?', _Bool, cell->v.i)
+    COLVAL('L', unsigned long, u)
+    COLVAL('Q', unsigned long long, u)
+    COLVAL('N', size_t, u)
+  case 'f':
+  {
+    float v;
+    memcpy(&v, item, sizeof(v));
+    cell->type = SQLITE_FLOAT;
+    cell->v.d = v;
+    break;
+  }
+  case 'd':
+    cell->type = SQLITE_FLOAT;
+    memcpy(&cell->v.d, item, sizeof(double));
+    break;
+#undef COLVAL
+  }
+  if (column->format == 'L' || column->format == 'Q' || column->format == 'N')
+  {
+    if (u > (unsigned long long)LLONG_MAX)
+    {
+      PyErr_Format(PyExc_OverflowError, "Value %llu in row %zd is too large for a 64 bit signed integer", u, row);
+      return -1;
+    }
+    cell->v.i = (sqlite3_int64)u;
+  }
+  return 0;
+}
 
+/* converts a cell from a numeric buffer column to a Python object */
 static PyObject *
-APSWCursor_close(APSWCursor *self, PyObject *args, PyObject *kwds)
+bindcell_to_pyobject(APSWBindCell *cell)
 {
-  int force = 0;
+  if (cell->type == SQLITE_FLOAT)
+    return PyFloat_FromDouble(cell->v.d);
+  return PyLong_FromLongLong(cell->v.i);
+}
 
-  CHECK_USE(NULL);
-  if (!self->connection)
-    Py_RETURN_NONE;
+/** .. method:: executemany_columns(statements: str, columns: Sequence) -> Cursor
 
-  {
-    static char *kwlist[] = {"force", NULL};
-    Cursor_close_CHECK;
-    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|O&:" Cursor_close_USAGE, kwlist, argcheck_bool, &force))
-      return NULL;
-  }
-  APSWCursor_close_internal(self, !!force);
+  Like :meth:`~Cursor.executemany` except the bindings are supplied
+  by column rather than by row.  This is useful when the data is
+  already in columnar form such as from numpy or arrow.
 
-  if (PyErr_Occurred())
-    return NULL;
+  Each member of *columns* supplies the values for the corresponding
+  binding.  It can be an object supporting the buffer protocol
+  containing integers or floats (any of the struct module formats
+  ``bBhHiIlLqQnN?fd`` in native byte order) such as
+  :class:`array.array`, a numpy array, or a :class:`memoryview`.
+  Values are read directly from the buffer.  Note that this means
+  :class:`bytes` is treated as a column of small integers.  Otherwise
+  the member is a sequence of values.  All the columns must be the same
+  length.
 
-  Py_RETURN_NONE;
-}
+  Rows are bound and stepped in batches with the GIL released once per
+  batch when the statements are a single statement that doesn't return
+  rows and there is no :ref:`exec tracer <executiontracer>`.  In other
+  cases this behaves exactly like :meth:`~Cursor.executemany` with the
+  corresponding rows.
 
-/** .. method:: __next__(self: Cursor) -> Any
+  .. code-block:: python
 
-    Cursors are iterators
+    cursor.executemany_columns("insert into readings values(?, ?, ?)",
+           (timestamps_array, values_array, ["a", "b", "c", ...]))
+
+  -* sqlite3_bind_int64 sqlite3_bind_double sqlite3_bind_text sqlite3_bind_blob sqlite3_bind_null sqlite3_step sqlite3_reset
 */
 static PyObject *
-APSWCursor_next(APSWCursor *self)
+APSWCursor_executemany_columns(APSWCursor *self, PyObject *args, PyObject *kwds)
 {
-  PyObject *retval;
-  PyObject *item;
-  int numcols = -1;
-  int i;
+  PyObject *statements = NULL, *columns = NULL, *seq = NULL, *rows = NULL, *res = NULL;
+  APSWBindColumn *cols = NULL;
+  APSWBindBatch bb;
+  Py_ssize_t ncols = 0, nrows = -1, i, row;
+  int sc_res;
 
   CHECK_USE(NULL);
   CHECK_CURSOR_CLOSED(NULL);
 
-again:
-  if (self->status == C_BEGIN)
-    if (!APSWCursor_step(self))
-    {
-      assert(PyErr_Occurred());
-      return NULL;
-    }
-  if (self->status == C_DONE)
-    return NULL;
-
-  assert(self->status == C_ROW);
-
-  self->status = C_BEGIN;
-
-  /* return the row of data */
-  numcols = sqlite3_data_count(self->statement->vdbestatement);
-  retval = PyTuple_New(numcols);
-  if (!retval)
-    goto error;
+  memset(&bb, 0, sizeof(bb));
 
-  for (i = 0; i < numcols; i++)
+  sc_res = resetcursor(self, /* force= */ 0);
+  if (sc_res != SQLITE_OK)
   {
-    INUSE_CALL(item = convert_column_to_pyobject(self->statement->vdbestatement, i));
-    if (!item)
-      goto error;
-    PyTuple_SET_ITEM(retval, i, item);
+    assert(PyErr_Occurred());
+    return NULL;
   }
-  if (ROWTRACE)
+
   {
-    PyObject *r2 = APSWCursor_dorowtrace(self, retval);
-    Py_DECREF(retval);
-    if (!r2)
+    static char *kwlist[] = {"statements", "columns", NULL};
+    Cursor_executemany_columns_CHECK;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O!O:" Cursor_executemany_columns_USAGE, kwlist, &PyUnicode_Type, &statements, &columns))
       return NULL;
-    if (r2 == Py_None)
-    {
-      Py_DECREF(r2);
-      goto again;
-    }
-    return r2;
+  }
+
+  seq = PySequence_Fast(columns, "You must supply a sequence of columns");
+  if (!seq)
+    return NULL;
+  ncols = PySequence_Fast_GET_SIZE(seq);
+  cols = PyMem_Calloc(ncols ? ncols : 1, sizeof(APSWBindColumn));
+  if (!cols)
+  {
+    PyErr_NoMemory();
+    goto finally;
+  }
+
+  for (i = 0; i < ncols; i++)
+  {
+    PyObject *column = PySequence_Fast_GET_ITEM(seq, i);
+    Py_ssize_t len;
+
+    if (PyObject_CheckBuffer(column))
+    {
+      const char *format;
+      if (PyObject_GetBuffer(column, &cols[i].buffer, PyBUF_FORMAT | PyBUF_C_CONTIGUOUS))
+        goto finally;
+      cols[i].format = 1; /* marks buffer as acquired */
+      format = cols[i].buffer.format ? cols[i].buffer.format : "B";
+      if (*format == '@')
+        format++;
+      if (cols[i].buffer.ndim > 1 || strlen(format) != 1 || !strchr("bBhHiIlLqQnN?fd", *format))
+      {
+        PyErr_Format(PyExc_TypeError, "Column %zd buffer must be one dimensional with a native integer or float format, not '%s'", i, cols[i].buffer.format);
+        goto finally;
+      }
+      cols[i].format = *format;
+      len = cols[i].buffer.len / cols[i].buffer.itemsize;
+    }
+    else
+    {
+      cols[i].seq = PySequence_Fast(column, "Each column must be a sequence or support the buffer protocol");
+      if (!cols[i].seq)
+        goto finally;
+      len = PySequence_Fast_GET_SIZE(cols[i].seq);
+    }
+    if (nrows >= 0 && len != nrows)
+    {
+      PyErr_Format(PyExc_ValueError, "All columns must be the same length.  Column 0 has %zd items while column %zd has %zd", nrows, i, len);
+      goto finally;
+    }
+    nrows = len;
+  }
+
+  INUSE_CALL(self->statement = statementcache_prepare(self->connection->stmtcache, statements));
+  if (!self->statement)
+  {
+    AddTraceBackHere(__FILE__, __LINE__, "APSWCursor_executemany_columns.sqlite3_prepare", "{s: O, s: O}",
+                     "Connection", self->connection,
+                     "statements", OBJ(statements));
+    goto finally;
+  }
+
+  if (!EXECTRACE && !statementcache_hasmore(self->statement) && self->statement->vdbestatement && !sqlite3_column_count(self->statement->vdbestatement))
+  {
+    int nargs = sqlite3_bind_parameter_count(self->statement->vdbestatement);
+    if (nargs != ncols)
+    {
+      PyErr_Format(ExcBindings, "Incorrect number of bindings supplied.  The current statement uses %d and there are %d supplied.  Current offset is %d",
+                   nargs, (int)ncols, 0);
+      goto finally;
+    }
+    if (bindbatch_init(&bb, nargs))
+      goto finally;
+    for (row = 0; row < nrows; row++)
+    {
+      APSWBindCell *cells = bb.cells + (size_t)bb.nrows * bb.nargs;
+      int nobjects = bb.nobjects, nbuffers = bb.nbuffers, failed = 0;
+
+      for (i = 0; i < ncols && !failed; i++)
+        failed = cols[i].seq ? bindbatch_set_value(&bb, &cells[i], PySequence_Fast_GET_ITEM(cols[i].seq, row), (int)i + 1)
+                             : bindcolumn_value(&cols[i], row, &cells[i]);
+      if (failed)
+      {
+        PyObject *etype, *evalue, *etb;
+        bindbatch_release(&bb, nobjects, nbuffers);
+        /* rows before the failure are still run */
+        PyErr_Fetch(&etype, &evalue, &etb);
+        if (bb.nrows && APSWCursor_runbindbatch(self, &bb))
+        {
+          Py_XDECREF(etype);
+          Py_XDECREF(evalue);
+          Py_XDECREF(etb);
+        }
+        else
+          PyErr_Restore(etype, evalue, etb);
+        self->status = C_DONE;
+        goto finally;
+      }
+      bb.nrows++;
+      if (bb.nrows == bb.maxrows || row + 1 == nrows)
+        if (APSWCursor_runbindbatch(self, &bb))
+        {
+          self->status = C_DONE;
+          goto finally;
+        }
+    }
+    if (resetcursor(self, 0) == SQLITE_OK)
+    {
+      Py_INCREF(self);
+      res = (PyObject *)self;
+    }
+    goto finally;
+  }
+
+  /* not suitable for batching so make rows for executemany */
+  INUSE_CALL(statementcache_finalize(self->connection->stmtcache, self->statement));
+  self->statement = NULL;
+
+  rows = PyList_New(nrows > 0 ? nrows : 0);
+  if (!rows)
+    goto finally;
+  for (row = 0; row < nrows; row++)
+  {
+    PyObject *tuple = PyTuple_New(ncols);
+    if (!tuple)
+      goto finally;
+    PyList_SET_ITEM(rows, row, tuple);
+    for (i = 0; i < ncols; i++)
+    {
+      PyObject *item;
+      if (cols[i].seq)
+      {
+        item = PySequence_Fast_GET_ITEM(cols[i].seq, row);
+        Py_INCREF(item);
+      }
+      else
+      {
+        APSWBindCell cell;
+        item = bindcolumn_value(&cols[i], row, &cell) ? NULL : bindcell_to_pyobject(&cell);
+        if (!item)
+          goto finally;
+      }
+      PyTuple_SET_ITEM(tuple, i, item);
+    }
+  }
+  {
+    PyObject *emargs = Py_BuildValue("(OO)", statements, rows);
+    if (emargs)
+    {
+      res = APSWCursor_executemany(self, emargs, NULL);
+      Py_DECREF(emargs);
+    }
+  }
+
+finally:
+  if (bb.cells)
+    bindbatch_free(&bb);
+  for (i = 0; cols && i < ncols; i++)
+  {
+    Py_XDECREF(cols[i].seq);
+    if (!cols[i].seq && cols[i].format)
+      PyBuffer_Release(&cols[i].buffer);
+  }
+  PyMem_Free(cols);
+  Py_XDECREF(seq);
+  Py_XDECREF(rows);
+  return res;
+}
+
+/** .. method:: close(force: bool = False) -> None
+
+  It is very unlikely you will need to call this method.  It exists
+  because older versions of SQLite required all Connection/Cursor
+  activity to be confined to the same thread.  That is no longer the
+  case.  Cursors are automatically garbage collected and when there
+  are none left will allow the connection to be garbage collected if
+  it has no other references.
+
+  A cursor is open if there are remaining statements to execute (if
+  your query included multiple statements), or if you called
+  :meth:`~Cursor.executemany` and not all of the *sequenceofbindings*
+  have been used yet.
+
+  :param force: If False then you will get exceptions if there is
+   remaining work to do be in the Cursor such as more statements to
+   execute, more data from the executemany binding sequence etc. If
+   force is True then all remaining work and state information will be
+   silently discarded.
+
+*/
+
+static PyObject *
+APSWCursor_close(APSWCursor *self, PyObject *args, PyObject *kwds)
+{
+  int force = 0;
+
+  CHECK_USE(NULL);
+  if (!self->connection)
+    Py_RETURN_NONE;
+
+  {
+    static char *kwlist[] = {"force", NULL};
+    Cursor_close_CHECK;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|O&:" Cursor_close_USAGE, kwlist, argcheck_bool, &force))
+      return NULL;
+  }
+  APSWCursor_close_internal(self, !!force);
+
+  if (PyErr_Occurred())
+    return NULL;
+
+  Py_RETURN_NONE;
+}
+
+/** .. method:: __next__(self: Cursor) -> Any
+
+    Cursors are iterators
+*/
+static PyObject *
+APSWCursor_next(APSWCursor *self)
+{
+  PyObject *retval;
+  PyObject *item;
+  int numcols = -1;
+  int i;
+
+  CHECK_USE(NULL);
+  CHECK_CURSOR_CLOSED(NULL);
+
+again:
+  if (self->status == C_BEGIN)
+    if (!APSWCursor_step(self))
+    {
+      assert(PyErr_Occurred());
+      return NULL;
+    }
+  if (self->status == C_DONE)
+    return NULL;
+
+  assert(self->status == C_ROW);
+
+  self->status = C_BEGIN;
+
+  /* return the row of data */
+  numcols = sqlite3_data_count(self->statement->vdbestatement);
+  retval = PyTuple_New(numcols);
+  if (!retval)
+    goto error;
+
+  for (i = 0; i < numcols; i++)
+  {
+    INUSE_CALL(item = convert_column_to_pyobject(self->statement->vdbestatement, i));
+    if (!item)
+      goto error;
+    PyTuple_SET_ITEM(retval, i, item);
+  }
+  if (ROWTRACE)
+  {
+    PyObject *r2 = APSWCursor_dorowtrace(self, retval);
+    Py_DECREF(retval);
+    if (!r2)
+      return NULL;
+    if (r2 == Py_None)
+    {
+      Py_DECREF(r2);
+      goto again;
+    }
+    return r2;
   }
   return retval;
 error:
@@ -1409,15 +2539,60 @@ APSWCursor_getconnection(APSWCursor *self)
 /** .. method:: fetchall() -> list
 
   Returns all remaining result rows as a list.  This method is defined
-  in DBAPI.  It is a longer way of doing ``list(cursor)``.
+  in DBAPI.  It gives the same result as ``list(cursor)`` but rows
+  are obtained from SQLite in batches as described in
+  :meth:`~Cursor.fetchmany`.
 */
 static PyObject *
 APSWCursor_fetchall(APSWCursor *self)
 {
+  PyObject *res;
+
   CHECK_USE(NULL);
   CHECK_CURSOR_CLOSED(NULL);
 
-  return PySequence_List((PyObject *)self);
+  res = PyList_New(0);
+  if (res && APSWCursor_fetchrows(self, res, -1))
+    Py_CLEAR(res);
+  return res;
+}
+
+/** .. method:: fetchmany(size: int = 1000) -> list
+
+  Returns up to *size* rows as a list, with an empty list meaning there
+  are no more rows.  This method is defined in DBAPI.
+
+  All the rows are obtained from SQLite with the GIL released once,
+  rather than releasing and reacquiring it for every row, and then the
+  Python objects are made in one pass.  This considerably reduces
+  overhead, especially when other threads are also running Python code.
+  If there is a :ref:`row tracer <rowtracer>` then rows are obtained
+  one at a time since the tracer can examine the cursor.
+
+  -* sqlite3_step
+*/
+static PyObject *
+APSWCursor_fetchmany(APSWCursor *self, PyObject *args, PyObject *kwds)
+{
+  int size = 1000;
+  PyObject *res;
+
+  CHECK_USE(NULL);
+  CHECK_CURSOR_CLOSED(NULL);
+
+  {
+    static char *kwlist[] = {"size", NULL};
+    Cursor_fetchmany_CHECK;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|i:" Cursor_fetchmany_USAGE, kwlist, &size))
+      return NULL;
+  }
+  if (size < 1)
+    return PyErr_Format(PyExc_ValueError, "size must be at least 1");
+
+  res = PyList_New(0);
+  if (res && APSWCursor_fetchrows(self, res, size))
+    Py_CLEAR(res);
+  return res;
 }
 
 /** .. method:: fetchone() -> Optional[Any]
@@ -1441,11 +2616,940 @@ APSWCursor_fetchone(APSWCursor *self)
   return res;
 }
 
+/* makes an array.array of typecode from the bytes, which is consumed */
+static PyObject *
+apsw_make_array(const char *typecode, PyObject *bytes)
+{
+  static PyObject *array_type = NULL;
+  PyObject *res = NULL, *tmp = NULL;
+
+  if (!bytes)
+    return NULL;
+
+  if (!array_type)
+  {
+    PyObject *module = PyImport_ImportModule("array");
+    if (module)
+    {
+      array_type = PyObject_GetAttrString(module, "array");
+      Py_DECREF(module);
+    }
+    if (!array_type)
+      goto finally;
+  }
+
+  res = PyObject_CallFunction(array_type, "s", typecode);
+  if (!res)
+    goto finally;
+  tmp = PyObject_CallMethod(res, "frombytes", "O", bytes);
+  if (!tmp)
+    Py_CLEAR(res);
+
+finally:
+  Py_XDECREF(tmp);
+  Py_DECREF(bytes);
+  return res;
+}
+
+/* makes the column tuple for fetchmany_columns */
+static PyObject *
+rowbatch_column(APSWRowBatch *batch, int col)
+{
+  PyObject *nulls = NULL, *values = NULL, *offsets = NULL, *type = Py_None;
+  APSWBatchCell *cell;
+  unsigned char *nullbits;
+  int row;
+
+  nulls = PyBytes_FromStringAndSize(NULL, (batch->nrows + 7) / 8);
+  if (!nulls)
+    goto error;
+  nullbits = (unsigned char *)PyBytes_AS_STRING(nulls);
+  memset(nullbits, 0, PyBytes_GET_SIZE(nulls));
+  for (row = 0, cell = batch->cells + col; row < batch->nrows; row++, cell += batch->ncols)
+    if (cell->type == SQLITE_NULL)
+      nullbits[row / 8] |= 1 << (row % 8);
+
+  switch (batch->coltypes[col])
+  {
+  case SQLITE_INTEGER:
+  case SQLITE_FLOAT:
+  {
+    int isint = batch->coltypes[col] == SQLITE_INTEGER;
+    char *dest;
+
+    type = isint ? (PyObject *)&PyLong_Type : (PyObject *)&PyFloat_Type;
+    values = PyBytes_FromStringAndSize(NULL, (Py_ssize_t)batch->nrows * 8);
+    if (!values)
+      goto error;
+    dest = PyBytes_AS_STRING(values);
+    for (row = 0, cell = batch->cells + col; row < batch->nrows; row++, cell += batch->ncols, dest += 8)
+    {
+      if (cell->type == SQLITE_NULL)
+        memset(dest, 0, 8);
+      else if (isint)
+        memcpy(dest, &cell->v.i, 8);
+      else
+        memcpy(dest, &cell->v.d, 8);
+    }
+    values = apsw_make_array(isint ? "q" : "d", values);
+    if (!values)
+      goto error;
+    break;
+  }
+
+  case SQLITE_TEXT:
+  case SQLITE_BLOB:
+  {
+    size_t total = 0;
+    long long offset;
+    char *dest;
+
+    type = (batch->coltypes[col] == SQLITE_TEXT) ? (PyObject *)&PyUnicode_Type : (PyObject *)&PyBytes_Type;
+    for (row = 0, cell = batch->cells + col; row < batch->nrows; row++, cell += batch->ncols)
+      if (cell->type != SQLITE_NULL)
+        total += cell->v.b.len;
+
+    values = PyBytes_FromStringAndSize(NULL, total);
+    offsets = PyBytes_FromStringAndSize(NULL, ((Py_ssize_t)batch->nrows + 1) * sizeof(long long));
+    if (!values || !offsets)
+      goto error;
+    dest = PyBytes_AS_STRING(values);
+    offset = 0;
+    memcpy(PyBytes_AS_STRING(offsets), &offset, sizeof(offset));
+    for (row = 0, cell = batch->cells + col; row < batch->nrows; row++, cell += batch->ncols)
+    {
+      if (cell->type != SQLITE_NULL && cell->v.b.len)
+      {
+        memcpy(dest + offset, batch->arena + cell->v.b.offset, cell->v.b.len);
+        offset += cell->v.b.len;
+      }
+      memcpy(PyBytes_AS_STRING(offsets) + (row + 1) * sizeof(offset), &offset, sizeof(offset));
+    }
+    offsets = apsw_make_array("q", offsets);
+    if (!offsets)
+      goto error;
+    break;
+  }
+
+  default:
+    /* all values were null */
+    break;
+  }
+
+  if (!values)
+  {
+    Py_INCREF(Py_None);
+    values = Py_None;
+  }
+  if (!offsets)
+  {
+    Py_INCREF(Py_None);
+    offsets = Py_None;
+  }
+  return Py_BuildValue("(ONNN)", type, values, offsets, nulls);
+
+error:
+  Py_XDECREF(nulls);
+  Py_XDECREF(values);
+  Py_XDECREF(offsets);
+  return NULL;
+}
+
+/** .. method:: fetchmany_columns(size: int = 1000) -> Optional[Tuple[int, List[Tuple[Optional[type], Union[array, bytes, None], Optional[array], bytes]]]]
+
+  Returns up to *size* rows organised by column rather than by row,
+  or None if there are no more rows.  This avoids creating a Python
+  object per value.  The values are copied once from SQLite into each
+  column's buffers, which libraries such as numpy or arrow can then
+  wrap with the buffer protocol.  The rows are obtained from SQLite
+  with the GIL released for the whole batch.
+
+  The return is a tuple of the number of rows and a list with an entry
+  per column.  Each entry is a tuple of:
+
+  * The Python type of the column (*int*, *float*, *str*, *bytes*) or
+    None if all values in the batch are null.  The type comes from the
+    first non-null value in the column, and SQLite's rules are used to
+    convert later values of other types.
+  * The values.  For int and float this is an :class:`array.array` of
+    typecode ``q`` and ``d`` respectively with zero used for nulls.
+    For str (UTF-8 encoded) and bytes this is a bytes with all the
+    values concatenated.
+  * For str and bytes an :class:`array.array` of typecode ``q`` with
+    one more entry than there are rows.  The value for row *i* is at
+    ``values[offsets[i]:offsets[i+1]]``.  None for other types.
+  * A bitmap as bytes where bit *i* (least significant bit first) is
+    set if row *i* is null.
+
+  A batch only contains rows from one statement when multiple
+  statements were executed.  Row tracers are not called.  If getting a
+  row fails part way through a batch then the exception is raised and
+  the rows already fetched for that batch are lost, as with
+  :meth:`fetchmany`.
+
+  .. code-block:: python
+
+    cursor.execute("select id, price, name from items")
+    while (batch := cursor.fetchmany_columns(10000)) is not None:
+        nrows, columns = batch
+        prices = numpy.frombuffer(columns[1][1], dtype=numpy.float64)
+
+  -* sqlite3_step sqlite3_column_type sqlite3_column_int64 sqlite3_column_double sqlite3_column_text sqlite3_column_blob sqlite3_column_bytes
+*/
+static PyObject *
+APSWCursor_fetchmany_columns(APSWCursor *self, PyObject *args, PyObject *kwds)
+{
+  int size = 1000, col;
+  APSWRowBatch batch;
+  PyObject *columns = NULL, *column;
+
+  CHECK_USE(NULL);
+  CHECK_CURSOR_CLOSED(NULL);
+
+  {
+    static char *kwlist[] = {"size", NULL};
+    Cursor_fetchmany_columns_CHECK;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|i:" Cursor_fetchmany_columns_USAGE, kwlist, &size))
+      return NULL;
+  }
+  if (size < 1)
+    return PyErr_Format(PyExc_ValueError, "size must be at least 1");
+
+  rowbatch_init(&batch, size, 1);
+  if (APSWCursor_fillbatch(self, &batch))
+    goto error;
+
+  if (!batch.nrows)
+  {
+    rowbatch_free(&batch);
+    Py_RETURN_NONE;
+  }
+
+  columns = PyList_New(batch.ncols);
+  if (!columns)
+    goto error;
+  for (col = 0; col < batch.ncols; col++)
+  {
+    column = rowbatch_column(&batch, col);
+    if (!column)
+      goto error;
+    PyList_SET_ITEM(columns, col, column);
+  }
+
+  rowbatch_free(&batch);
+  return Py_BuildValue("(iN)", batch.nrows, columns);
+
+error:
+  rowbatch_free(&batch);
+  Py_XDECREF(columns);
+  return NULL;
+}
+
+/* OUTPUT WRITER
+
+   write_to formats rows from batches straight into a buffer which is
+   written to the file in large pieces, so no Python objects are made
+   for rows or values.  Formatting doesn't use any Python APIs so it is
+   done with the GIL released. */
+
+/* the buffer is written out once it reaches this size */
+#define APSW_WRITE_CHUNK (64 * 1024)
+
+enum
+{
+  APSW_WRITE_CSV,
+  APSW_WRITE_TSV,
+  APSW_WRITE_JSONL,
+  APSW_WRITE_SQL
+};
+
+typedef struct
+{
+  char *data;
+  size_t len;
+  size_t size;
+} APSWOutBuf;
+
+/* makes space for amount more bytes.  Returns where to put them, or
+   NULL if memory could not be allocated.  No exception is set as this
+   is called without the GIL */
+static char *
+outbuf_reserve(APSWOutBuf *ob, size_t amount)
+{
+  if (ob->len + amount > ob->size)
+  {
+    size_t size = ob->size ? ob->size : APSW_WRITE_CHUNK;
+    char *data;
+    while (size < ob->len + amount)
+      size *= 2;
+    data = PyMem_RawRealloc(ob->data, size);
+    if (!data)
+      return NULL;
+    ob->data = data;
+    ob->size = size;
+  }
+  return ob->data + ob->len;
+}
+
+static int
+outbuf_add(APSWOutBuf *ob, const char *data, size_t len)
+{
+  char *dest = outbuf_reserve(ob, len);
+  if (!dest)
+    return -1;
+  if (len)
+    memcpy(dest, data, len);
+  ob->len += len;
+  return 0;
+}
+
+static int
+outbuf_add_str(APSWOutBuf *ob, const char *str)
+{
+  return outbuf_add(ob, str, strlen(str));
+}
+
+static int
+outbuf_add_int64(APSWOutBuf *ob, sqlite3_int64 v)
+{
+  char buffer[32];
+  return outbuf_add(ob, buffer, PyOS_snprintf(buffer, sizeof(buffer), "%lld", v));
+}
+
+/* Floats are formatted the same way as Python's repr - the fewest
+   digits that read back as the same value, in exponent form if very
+   large or small.  Infinity uses a literal that parses back to
+   infinity for SQL and JSON.  (SQLite never returns NaN.) */
+static int
+outbuf_add_double(APSWOutBuf *ob, double d, int format)
+{
+  static const double powers[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15};
+  char buffer[40], digits[24], *p, *dest;
+  int precision, ndigits = 0, decpt, exponent, i;
+  unsigned long long m;
+  double a = fabs(d);
+
+  if (Py_IS_INFINITY(d))
+  {
+    if (format == APSW_WRITE_CSV || format == APSW_WRITE_TSV)
+      return outbuf_add_str(ob, (d < 0) ? "-inf" : "inf");
+    return outbuf_add_str(ob, (d < 0) ? "-1e999" : "1e999");
+  }
+  if (d == 0)
+    return outbuf_add_str(ob, (copysign(1.0, d) < 0) ? "-0.0" : "0.0");
+
+  /* Most values are short decimals.  If some number of decimal places
+     gives an integer of at most 15 digits that divides back exactly
+     then that is the shortest form, and it is found far quicker than
+     with printf */
+  for (i = 0; a >= 1e-4 && i < 16 && a * powers[i] < 1e15; i++)
+  {
+    double m = floor(a * powers[i] + 0.5);
+    if (m / powers[i] == a)
+    {
+      ndigits = PyOS_snprintf(digits, sizeof(digits), "%lld", (long long)m);
+      dest = outbuf_reserve(ob, ndigits + i + 4);
+      if (!dest)
+        return -1;
+      if (d < 0)
+        *dest++ = '-';
+      if (i >= ndigits)
+      {
+        *dest++ = '0';
+        *dest++ = '.';
+        memset(dest, '0', i - ndigits);
+        dest += i - ndigits;
+        memcpy(dest, digits, ndigits);
+        dest += ndigits;
+      }
+      else
+      {
+        memcpy(dest, digits, ndigits - i);
+        dest += ndigits - i;
+        *dest++ = '.';
+        if (i)
+        {
+          memcpy(dest, digits + ndigits - i, i);
+          dest += i;
+        }
+        else
+          *dest++ = '0';
+      }
+      ob->len = dest - ob->data;
+      return 0;
+    }
+  }
+
+  /* Anything that reads back the same with 15 significant digits has
+     its shortest form in the correctly rounded 15 digits, so only
+     doubles needing more are tried with 16 and then 17.  Subnormals
+     have less precision so all lengths are tried.  The correctly
+     rounded digits can be on the wrong side of d while the next value
+     in the last digit on the other side still reads back as d, which
+     is then the shortest form like repr gives. */
+  for (precision = (a < DBL_MIN) ? 0 : 14;; precision++)
+  {
+    double r;
+
+    PyOS_snprintf(buffer, sizeof(buffer), "%.*e", precision, a);
+    /* buffer is d.ddde[+-]xx with the locale's decimal point */
+    for (m = 0, p = buffer; *p != 'e'; p++)
+      if (*p >= '0' && *p <= '9')
+        m = m * 10 + (*p - '0');
+    exponent = atoi(p + 1) - precision;
+    /* 17 significant digits always read back the same */
+    r = strtod(buffer, NULL);
+    if (precision == 16 || r == a)
+      break;
+    PyOS_snprintf(buffer, sizeof(buffer), "%llue%d", (r > a) ? m - 1 : m + 1, exponent);
+    if (strtod(buffer, NULL) == a)
+    {
+      m = (r > a) ? m - 1 : m + 1;
+      break;
+    }
+  }
+
+  ndigits = PyOS_snprintf(digits, sizeof(digits), "%llu", m);
+  decpt = exponent + ndigits;
+  while (ndigits > 1 && digits[ndigits - 1] == '0')
+    ndigits--;
+
+  dest = outbuf_reserve(ob, ndigits + 25);
+  if (!dest)
+    return -1;
+  if (d < 0)
+    *dest++ = '-';
+  if (decpt > 16 || decpt < -3)
+  {
+    *dest++ = digits[0];
+    if (ndigits > 1)
+    {
+      *dest++ = '.';
+      memcpy(dest, digits + 1, ndigits - 1);
+      dest += ndigits - 1;
+    }
+    dest += PyOS_snprintf(dest, 8, "e%c%02d", (decpt > 0) ? '+' : '-', abs(decpt - 1));
+  }
+  else if (decpt <= 0)
+  {
+    *dest++ = '0';
+    *dest++ = '.';
+    for (i = decpt; i < 0; i++)
+      *dest++ = '0';
+    memcpy(dest, digits, ndigits);
+    dest += ndigits;
+  }
+  else
+  {
+    for (i = 0; i < decpt || i < ndigits; i++)
+    {
+      if (i == decpt)
+        *dest++ = '.';
+      *dest++ = (i < ndigits) ? digits[i] : '0';
+    }
+    if (decpt >= ndigits)
+    {
+      *dest++ = '.';
+      *dest++ = '0';
+    }
+  }
+  ob->len = dest - ob->data;
+  return 0;
+}
+
+/* the value is quoted if it contains the delimiter, a quote or line
+   ending.  An empty value is quoted when it is the only one in the row
+   as the line would otherwise be blank */
+static int
+outbuf_add_csv(APSWOutBuf *ob, const char *data, size_t len, char delimiter, int quoteempty)
+{
+  size_t i, quotes = 0;
+  int needquote = (quoteempty && !len);
+  char *dest;
+
+  for (i = 0; i < len; i++)
+  {
+    if (data[i] == '"')
+      quotes++;
+    else if (data[i] == delimiter || data[i] == '\r' || data[i] == '\n')
+      needquote = 1;
+  }
+  if (!needquote && !quotes)
+    return outbuf_add(ob, data, len);
+
+  dest = outbuf_reserve(ob, len + quotes + 2);
+  if (!dest)
+    return -1;
+  *dest++ = '"';
+  for (i = 0; i < len; i++)
+  {
+    if (data[i] == '"')
+      *dest++ = '"';
+    *dest++ = data[i];
+  }
+  *dest++ = '"';
+  ob->len = dest - ob->data;
+  return 0;
+}
+
+static int
+outbuf_add_json_string(APSWOutBuf *ob, const char *data, size_t len)
+{
+  static const char hexdigits[] = "0123456789abcdef";
+  /* worst case is every byte being a \u escape */
+  char *dest = outbuf_reserve(ob, len * 6 + 2);
+  size_t i;
+
+  if (!dest)
+    return -1;
+  *dest++ = '"';
+  for (i = 0; i < len; i++)
+  {
+    unsigned char c = (unsigned char)data[i];
+    switch (c)
+    {
+    case '"':
+    case '\\':
+      *dest++ = '\\';
+      *dest++ = c;
+      break;
+    case '\n':
+      *dest++ = '\\';
+      *dest++ = 'n';
+      break;
+    case '\r':
+      *dest++ = '\\';
+      *dest++ = 'r';
+      break;
+    case '\t':
+      *dest++ = '\\';
+      *dest++ = 't';
+      break;
+    default:
+      if (c < 0x20)
+      {
+        memcpy(dest, "\\u00", 4);
+        dest += 4;
+        *dest++ = hexdigits[c >> 4];
+        *dest++ = hexdigits[c & 15];
+      }
+      else
+        *dest++ = c;
+    }
+  }
+  *dest++ = '"';
+  ob->len = dest - ob->data;
+  return 0;
+}
+
+static int
+outbuf_add_base64(APSWOutBuf *ob, const unsigned char *data, size_t len)
+{
+  static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  char *dest = outbuf_reserve(ob, (len + 2) / 3 * 4 + 2);
+  size_t i;
+
+  if (!dest)
+    return -1;
+  *dest++ = '"';
+  for (i = 0; i + 2 < len; i += 3)
+  {
+    *dest++ = alphabet[data[i] >> 2];
+    *dest++ = alphabet[((data[i] & 3) << 4) | (data[i + 1] >> 4)];
+    *dest++ = alphabet[((data[i + 1] & 15) << 2) | (data[i + 2] >> 6)];
+    *dest++ = alphabet[data[i + 2] & 63];
+  }
+  if (i < len)
+  {
+    *dest++ = alphabet[data[i] >> 2];
+    if (i + 1 < len)
+    {
+      *dest++ = alphabet[((data[i] & 3) << 4) | (data[i + 1] >> 4)];
+      *dest++ = alphabet[(data[i + 1] & 15) << 2];
+    }
+    else
+    {
+      *dest++ = alphabet[(data[i] & 3) << 4];
+      *dest++ = '=';
+    }
+    *dest++ = '=';
+  }
+  *dest++ = '"';
+  ob->len = dest - ob->data;
+  return 0;
+}
+
+/* same as apsw.format_sql_value */
+static int
+outbuf_add_sql_text(APSWOutBuf *ob, const char *data, size_t len)
+{
+  size_t i, start = 0;
+
+  if (outbuf_add(ob, "'", 1))
+    return -1;
+  for (i = 0; i < len; i++)
+  {
+    if (data[i] != '\'' && data[i] != 0)
+      continue;
+    if (outbuf_add(ob, data + start, i - start) || outbuf_add_str(ob, data[i] ? "''" : "'||X'00'||'"))
+      return -1;
+    start = i + 1;
+  }
+  if (outbuf_add(ob, data + start, len - start))
+    return -1;
+  return outbuf_add(ob, "'", 1);
+}
+
+static int
+outbuf_add_sql_blob(APSWOutBuf *ob, const unsigned char *data, size_t len)
+{
+  static const char hexdigits[] = "0123456789ABCDEF";
+  char *dest = outbuf_reserve(ob, len * 2 + 3);
+  size_t i;
+
+  if (!dest)
+    return -1;
+  *dest++ = 'X';
+  *dest++ = '\'';
+  for (i = 0; i < len; i++)
+  {
+    *dest++ = hexdigits[data[i] >> 4];
+    *dest++ = hexdigits[data[i] & 15];
+  }
+  *dest++ = '\'';
+  ob->len = dest - ob->data;
+  return 0;
+}
+
+/* appends one value from the batch in the format */
+static int
+outbuf_add_cell(APSWOutBuf *ob, APSWRowBatch *batch, APSWBatchCell *cell, int format, const char *nullvalue)
+{
+  const char *data = (cell->type == SQLITE_TEXT || cell->type == SQLITE_BLOB) ? batch->arena + cell->v.b.offset : NULL;
+  char delimiter = (format == APSW_WRITE_TSV) ? '\t' : ',';
+
+  switch (cell->type)
+  {
+  case SQLITE_INTEGER:
+    return outbuf_add_int64(ob, cell->v.i);
+  case SQLITE_FLOAT:
+    return outbuf_add_double(ob, cell->v.d, format);
+  default:
+    assert(cell->type == SQLITE_NULL);
+    if (format == APSW_WRITE_JSONL)
+      return outbuf_add_str(ob, "null");
+    if (format == APSW_WRITE_SQL)
+      return outbuf_add_str(ob, "NULL");
+    return outbuf_add_csv(ob, nullvalue, strlen(nullvalue), delimiter, batch->ncols == 1);
+  case SQLITE_TEXT:
+    if (format == APSW_WRITE_JSONL)
+      return outbuf_add_json_string(ob, data, cell->v.b.len);
+    if (format == APSW_WRITE_SQL)
+      return outbuf_add_sql_text(ob, data, cell->v.b.len);
+    return outbuf_add_csv(ob, data, cell->v.b.len, delimiter, batch->ncols == 1);
+  case SQLITE_BLOB:
+    if (format == APSW_WRITE_JSONL)
+      return outbuf_add_base64(ob, (const unsigned char *)data, cell->v.b.len);
+    if (format == APSW_WRITE_SQL)
+      return outbuf_add_sql_blob(ob, (const unsigned char *)data, cell->v.b.len);
+    return outbuf_add_csv(ob, data, cell->v.b.len, delimiter, batch->ncols == 1);
+  }
+}
+
+/* appends all the rows in the batch.  Called without the GIL.  Returns
+   -1 if memory could not be allocated */
+static int
+outbuf_add_rows(APSWOutBuf *ob, APSWRowBatch *batch, int format, const char *nullvalue, const char *table, APSWOutBuf *names, Py_ssize_t *prefixes)
+{
+  int row, col, res;
+
+  for (row = 0; row < batch->nrows; row++)
+  {
+    APSWBatchCell *cell = batch->cells + (size_t)row * batch->ncols;
+
+    if (format == APSW_WRITE_SQL && (outbuf_add_str(ob, "INSERT INTO ") || outbuf_add_str(ob, table) || outbuf_add_str(ob, " VALUES(")))
+      return -1;
+    for (col = 0; col < batch->ncols; col++, cell++)
+    {
+      switch (format)
+      {
+      case APSW_WRITE_JSONL:
+        res = outbuf_add(ob, names->data + prefixes[col], prefixes[col + 1] - prefixes[col]);
+        break;
+      case APSW_WRITE_TSV:
+        res = col ? outbuf_add(ob, "\t", 1) : 0;
+        break;
+      default:
+        res = col ? outbuf_add(ob, ",", 1) : 0;
+      }
+      if (res || outbuf_add_cell(ob, batch, cell, format, nullvalue))
+        return -1;
+    }
+    switch (format)
+    {
+    case APSW_WRITE_JSONL:
+      res = outbuf_add_str(ob, batch->ncols ? "}\n" : "{}\n");
+      break;
+    case APSW_WRITE_SQL:
+      res = outbuf_add_str(ob, ");\n");
+      break;
+    default:
+      res = outbuf_add(ob, "\n", 1);
+    }
+    if (res)
+      return -1;
+  }
+  return 0;
+}
+
+/* Writes the buffer contents to the file and empties it.  The first
+   write is bytes, and if the file rejects that with TypeError then it
+   is text from then on (*text set).  The buffer is also emptied if
+   write fails so the same data is never given to it twice. */
+static int
+outbuf_flush(APSWOutBuf *ob, PyObject *write, int *text)
+{
+  PyObject *chunk, *retval = NULL;
+
+  if (!ob->len)
+    return 0;
+  for (;;)
+  {
+    chunk = (*text > 0) ? PyUnicode_DecodeUTF8(ob->data, ob->len, "replace") : PyBytes_FromStringAndSize(ob->data, ob->len);
+    if (!chunk)
+      return -1;
+    retval = PyObject_CallFunctionObjArgs(write, chunk, NULL);
+    Py_DECREF(chunk);
+    if (!retval && *text < 0 && PyErr_ExceptionMatches(PyExc_TypeError))
+    {
+      PyErr_Clear();
+      *text = 1;
+      continue;
+    }
+    break;
+  }
+  if (!retval)
+  {
+    ob->len = 0;
+    return -1;
+  }
+  Py_DECREF(retval);
+  if (*text < 0)
+    *text = 0;
+  ob->len = 0;
+  return 0;
+}
+
+/* Makes the text put before each value in a row - the header for csv
+   and tsv, and the keys for jsonl.  prefixes gets ncols + 1 offsets
+   into names. Returns -1 with exception set on failure */
+static int
+APSWCursor_write_names(APSWCursor *self, int format, APSWOutBuf *names, Py_ssize_t **prefixes)
+{
+  PyObject *description = APSWCursor_internal_getdescription(self, 0);
+  Py_ssize_t ncols, i, *offsets;
+
+  if (!description)
+    return -1;
+  ncols = PyTuple_GET_SIZE(description);
+  offsets = PyMem_Realloc(*prefixes, sizeof(Py_ssize_t) * (ncols + 1));
+  if (!offsets)
+  {
+    Py_DECREF(description);
+    PyErr_NoMemory();
+    return -1;
+  }
+  *prefixes = offsets;
+  names->len = 0;
+
+  for (i = 0; i < ncols; i++)
+  {
+    Py_ssize_t len;
+    const char *name = PyUnicode_AsUTF8AndSize(PyTuple_GET_ITEM(PyTuple_GET_ITEM(description, i), 0), &len);
+    int res;
+
+    offsets[i] = names->len;
+    if (!name)
+      goto error;
+    switch (format)
+    {
+    case APSW_WRITE_CSV:
+    case APSW_WRITE_TSV:
+      res = (i && outbuf_add(names, (format == APSW_WRITE_TSV) ? "\t" : ",", 1)) || outbuf_add_csv(names, name, len, (format == APSW_WRITE_TSV) ? '\t' : ',', ncols == 1);
+      break;
+    case APSW_WRITE_JSONL:
+      res = outbuf_add_str(names, i ? ", " : "{") || outbuf_add_json_string(names, name, len) || outbuf_add_str(names, ": ");
+      break;
+    default:
+      res = 0;
+    }
+    if (res)
+    {
+      PyErr_NoMemory();
+      goto error;
+    }
+  }
+  offsets[ncols] = names->len;
+  Py_DECREF(description);
+  return 0;
+
+error:
+  Py_DECREF(description);
+  return -1;
+}
+
+/** .. method:: write_to(file: Any, format: str = "csv", header: bool = False, nullvalue: str = "", table: str = "table") -> int
+
+  Writes all the remaining rows to *file* without making Python objects
+  for the rows or values, which is considerably faster than fetching
+  rows and formatting them in Python.  Rows are written from the
+  current position until all the statements are complete.
+
+  :param file: Object with a *write* method such as a file.  Bytes
+     are written in large pieces, or str if *write* raises
+     :exc:`TypeError` for bytes.
+  :param format: One of the following
+
+     .. list-table::
+       :widths: auto
+       :header-rows: 1
+
+       * - Format
+         - Output
+       * - csv
+         - Values separated by commas, quoted with double quotes if they
+           contain a comma, double quote, or line ending.  Lines end with ``\n``.
+       * - tsv
+         - Same as csv but with tabs instead of commas
+       * - jsonl
+         - One JSON object per line with the column names as keys.  Blobs
+           are base64 encoded strings.
+       * - sql
+         - An ``INSERT INTO`` *table* ``VALUES(...);`` statement per row
+  :param header: For csv and tsv, output the column names before the
+     rows of each statement.
+  :param nullvalue: What nulls are written as in csv and tsv.
+  :param table: The table name for sql format.  It is used as is, so
+     quote it if needed.
+
+  :returns: The number of rows written
+
+  Text and blobs are written as their bytes for csv and tsv.  Floats
+  are formatted the same as :func:`repr`.  The row tracer is not
+  called.  If an error happens then the rows before it are written
+  before the exception is raised.
+
+  -* sqlite3_step sqlite3_column_type sqlite3_column_int64 sqlite3_column_double sqlite3_column_text sqlite3_column_blob sqlite3_column_bytes
+*/
+static PyObject *
+APSWCursor_write_to(APSWCursor *self, PyObject *args, PyObject *kwds)
+{
+  PyObject *file = NULL, *write = NULL;
+  const char *format = "csv", *nullvalue = "", *table = "table";
+  int header = 0, fmt, newstatement = 1, wantheader = 0, text = -1, failed, res;
+  sqlite3_int64 written = 0;
+  Py_ssize_t *prefixes = NULL;
+  APSWOutBuf out = {0}, names = {0};
+  APSWRowBatch batch;
+
+  CHECK_USE(NULL);
+  CHECK_CURSOR_CLOSED(NULL);
+
+  {
+    static char *kwlist[] = {"file", "format", "header", "nullvalue", "table", NULL};
+    Cursor_write_to_CHECK;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|sO&ss:" Cursor_write_to_USAGE, kwlist, &file, &format, argcheck_bool, &header, &nullvalue, &table))
+      return NULL;
+  }
+  if (0 == strcmp(format, "csv"))
+    fmt = APSW_WRITE_CSV;
+  else if (0 == strcmp(format, "tsv"))
+    fmt = APSW_WRITE_TSV;
+  else if (0 == strcmp(format, "jsonl"))
+    fmt = APSW_WRITE_JSONL;
+  else if (0 == strcmp(format, "sql"))
+    fmt = APSW_WRITE_SQL;
+  else
+    return PyErr_Format(PyExc_ValueError, "Unknown format \"%s\" - expected csv, tsv, jsonl, or sql", format);
+
+  write = PyObject_GetAttrString(file, "write");
+  if (!write)
+    return NULL;
+
+  rowbatch_init(&batch, APSW_FETCH_BATCH_ROWS, 0);
+  batch.onestatement = 1;
+
+  while (self->status != C_DONE)
+  {
+    if (newstatement)
+    {
+      if (fmt != APSW_WRITE_SQL && APSWCursor_write_names(self, fmt, &names, &prefixes))
+        goto error;
+      wantheader = header && fmt != APSW_WRITE_JSONL && fmt != APSW_WRITE_SQL;
+      newstatement = 0;
+    }
+
+    /* rows copied before a failure are still written */
+    failed = APSWCursor_fillbatch(self, &batch);
+
+    if (batch.nrows && wantheader)
+    {
+      if (outbuf_add(&out, names.data, names.len) || outbuf_add(&out, "\n", 1))
+        goto nomem;
+      wantheader = 0;
+    }
+
+    INUSE_CALL(_PYSQLITE_CALL_V(res = outbuf_add_rows(&out, &batch, fmt, nullvalue, table, &names, prefixes)));
+    if (res)
+      goto nomem;
+    if (failed)
+      goto error;
+    written += batch.nrows;
+
+    if (out.len >= APSW_WRITE_CHUNK && outbuf_flush(&out, write, &text))
+      goto error;
+    if (batch.finished)
+      newstatement = 1;
+  }
+
+  if (outbuf_flush(&out, write, &text))
+    goto error;
+
+  rowbatch_free(&batch);
+  PyMem_RawFree(out.data);
+  PyMem_RawFree(names.data);
+  PyMem_Free(prefixes);
+  Py_DECREF(write);
+  return PyLong_FromLongLong(written);
+
+nomem:
+  if (!PyErr_Occurred())
+    PyErr_NoMemory();
+error:
+  /* rows already consumed are still written */
+  if (out.len)
+  {
+    PyObject *etype, *eval, *etb;
+    PyErr_Fetch(&etype, &eval, &etb);
+    if (outbuf_flush(&out, write, &text))
+      apsw_write_unraiseable(NULL);
+    PyErr_Restore(etype, eval, etb);
+  }
+  rowbatch_free(&batch);
+  PyMem_RawFree(out.data);
+  PyMem_RawFree(names.data);
+  PyMem_Free(prefixes);
+  Py_DECREF(write);
+  return NULL;
+}
+
 static PyMethodDef APSWCursor_methods[] = {
     {"execute", (PyCFunction)APSWCursor_execute, METH_VARARGS | METH_KEYWORDS,
      Cursor_execute_DOC},
     {"executemany", (PyCFunction)APSWCursor_executemany, METH_VARARGS | METH_KEYWORDS,
      Cursor_executemany_DOC},
+    {"executemany_columns", (PyCFunction)APSWCursor_executemany_columns, METH_VARARGS | METH_KEYWORDS,
+     Cursor_executemany_columns_DOC},
     {"setexectrace", (PyCFunction)APSWCursor_setexectrace, METH_VARARGS | METH_KEYWORDS,
      Cursor_setexectrace_DOC},
     {"setrowtrace", (PyCFunction)APSWCursor_setrowtrace, METH_VARARGS | METH_KEYWORDS,
@@ -1464,11 +3568,18 @@ static PyMethodDef APSWCursor_methods[] = {
      Cursor_fetchall_DOC},
     {"fetchone", (PyCFunction)APSWCursor_fetchone, METH_NOARGS,
      Cursor_fetchone_DOC},
+    {"fetchmany", (PyCFunction)APSWCursor_fetchmany, METH_VARARGS | METH_KEYWORDS,
+     Cursor_fetchmany_DOC},
+    {"fetchmany_columns", (PyCFunction)APSWCursor_fetchmany_columns, METH_VARARGS | METH_KEYWORDS,
+     Cursor_fetchmany_columns_DOC},
+    {"write_to", (PyCFunction)APSWCursor_write_to, METH_VARARGS | METH_KEYWORDS,
+     Cursor_write_to_DOC},
     {0, 0, 0, 0} /* Sentinel */
 };
 
 static PyGetSetDef APSWCursor_getset[] = {
     {"description", (getter)APSWCursor_getdescription_dbapi, NULL, Cursor_description_DOC, NULL},
+    {"static_bindings", (getter)APSWCursor_get_static_bindings, (setter)APSWCursor_set_static_bindings, Cursor_static_bindings_DOC, NULL},
     {NULL, NULL, NULL, NULL, NULL}};
 
 static PyTypeObject APSWCursorType = {
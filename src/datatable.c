@@ -0,0 +1,936 @@
+/*
+  Native virtual table over in memory data used by Connection.create_data_table
+
+  See the accompanying LICENSE file.
+*/
+
+/* The data is converted to C values when registered, except for
+   columns supplied as buffers (eg array.array or numpy) which are read
+   in place.  Scans, constraint checking and returning values then
+   happen entirely in C without needing the GIL.  The table is
+   eponymous only, so it is used by its name without a create virtual
+   table statement.
+
+   The rowid is the row number starting at zero.  Constraints of
+   =, <, <=, >, >= are checked here using SQLite's rules for values
+   without affinity, with rowid constraints narrowing the range of rows
+   scanned.  When every constraint is handled, LIMIT and OFFSET are
+   used to stop the scan early. */
+
+typedef struct
+{
+  int type; /* SQLITE_INTEGER etc */
+  int len;  /* of text or blob */
+  union
+  {
+    sqlite3_int64 i;
+    double d;
+    char *p; /* text is also null terminated */
+  } u;
+} APSWDataValue;
+
+typedef struct
+{
+  APSWDataValue *values; /* used when buffer is not */
+  Py_buffer *buffer;
+  char format; /* struct module format code of buffer items */
+} APSWDataColumn;
+
+typedef struct
+{
+  int ncolumns;
+  sqlite3_int64 nrows;
+  APSWDataColumn *columns;
+  char *schema; /* the create table statement */
+} APSWDataTable;
+
+typedef struct
+{
+  sqlite3_vtab used_by_sqlite; /* I don't touch this */
+  APSWDataTable *table;
+} apsw_datatable_vtab;
+
+typedef struct
+{
+  int column; /* -1 for rowid */
+  int op;     /* SQLITE_INDEX_CONSTRAINT_EQ etc */
+  APSWDataValue value;
+} APSWDataConstraint;
+
+typedef struct
+{
+  sqlite3_vtab_cursor used_by_sqlite; /* I don't touch this */
+  APSWDataTable *table;
+  sqlite3_int64 row, end; /* current and one past the last row to scan */
+  sqlite3_int64 limit;    /* rows that can still be returned, negative for no limit */
+  APSWDataConstraint *constraints;
+  int nconstraints;
+} apsw_datatable_cursor;
+
+static void
+datatable_value_free(APSWDataValue *value)
+{
+  if (value->type == SQLITE_TEXT || value->type == SQLITE_BLOB)
+    PyMem_RawFree(value->u.p);
+  value->type = SQLITE_NULL;
+}
+
+/* release needs the GIL because of the buffers */
+static void
+datatable_free(APSWDataTable *table)
+{
+  int i;
+  sqlite3_int64 row;
+
+  if (!table)
+    return;
+  for (i = 0; table->columns && i < table->ncolumns; i++)
+  {
+    APSWDataColumn *column = &table->columns[i];
+    if (column->buffer)
+    {
+      PyBuffer_Release(column->buffer);
+      PyMem_Free(column->buffer);
+    }
+    if (column->values)
+    {
+      for (row = 0; row < table->nrows; row++)
+        datatable_value_free(&column->values[row]);
+      PyMem_RawFree(column->values);
+    }
+  }
+  PyMem_Free(table->columns);
+  sqlite3_free(table->schema);
+  PyMem_Free(table);
+}
+
+static void
+datatable_module_destroy(void *context)
+{
+  PyGILState_STATE gilstate = PyGILState_Ensure();
+  datatable_free((APSWDataTable *)context);
+  PyGILState_Release(gilstate);
+}
+
+/* the items of buffers are converted to these */
+static const char *datatable_buffer_formats = "bBhHiIlLqQnNfd";
+
+/* converts a python value, returning -1 with an exception on failure */
+static int
+datatable_value_from_python(PyObject *obj, APSWDataValue *value)
+{
+  value->type = SQLITE_NULL;
+  if (obj == Py_None)
+    return 0;
+  if (PyLong_Check(obj))
+  {
+    value->u.i = PyLong_AsLongLong(obj);
+    if (value->u.i == -1 && PyErr_Occurred())
+      return -1;
+    value->type = SQLITE_INTEGER;
+    return 0;
+  }
+  if (PyFloat_Check(obj))
+  {
+    value->u.d = PyFloat_AS_DOUBLE(obj);
+    value->type = SQLITE_FLOAT;
+    return 0;
+  }
+  if (PyUnicode_Check(obj) || PyObject_CheckBuffer(obj))
+  {
+    const char *data;
+    Py_ssize_t len;
+    Py_buffer buffer;
+    int istext = PyUnicode_Check(obj);
+
+    if (istext)
+      data = PyUnicode_AsUTF8AndSize(obj, &len);
+    else
+    {
+      if (PyObject_GetBuffer(obj, &buffer, PyBUF_SIMPLE))
+        return -1;
+      data = buffer.buf;
+      len = buffer.len;
+    }
+    if (data && len > APSW_INT32_MAX)
+    {
+      SET_EXC(SQLITE_TOOBIG, NULL);
+      data = NULL;
+    }
+    if (data)
+    {
+      value->u.p = PyMem_RawMalloc(len + 1);
+      if (value->u.p)
+      {
+        memcpy(value->u.p, data, len);
+        value->u.p[len] = 0;
+        value->len = (int)len;
+        value->type = istext ? SQLITE_TEXT : SQLITE_BLOB;
+      }
+      else
+        PyErr_NoMemory();
+    }
+    if (!istext)
+      PyBuffer_Release(&buffer);
+    return (value->type == SQLITE_NULL) ? -1 : 0;
+  }
+  PyErr_Format(PyExc_TypeError, "Value of type %s is not supported in a data table", Py_TYPE(obj)->tp_name);
+  return -1;
+}
+
+static void
+datatable_value_from_sqlite(sqlite3_value *sqvalue, APSWDataValue *value)
+{
+  value->type = sqlite3_value_type(sqvalue);
+  switch (value->type)
+  {
+  case SQLITE_INTEGER:
+    value->u.i = sqlite3_value_int64(sqvalue);
+    break;
+  case SQLITE_FLOAT:
+    value->u.d = sqlite3_value_double(sqvalue);
+    break;
+  case SQLITE_TEXT:
+  case SQLITE_BLOB:
+  {
+    const void *data = (value->type == SQLITE_TEXT) ? (const void *)sqlite3_value_text(sqvalue) : sqlite3_value_blob(sqvalue);
+    value->len = sqlite3_value_bytes(sqvalue);
+    value->u.p = PyMem_RawMalloc(value->len + 1);
+    if (!value->u.p)
+    {
+      /* compares as nothing matching */
+      value->type = SQLITE_NULL;
+      break;
+    }
+    if (value->len)
+      memcpy(value->u.p, data, value->len);
+    value->u.p[value->len] = 0;
+    break;
+  }
+  }
+}
+
+/* Makes a column from a buffer, returning 0 if obj doesn't have a
+   suitable one, 1 on success, and -1 with an exception set on
+   failure */
+static int
+datatable_buffer_column(PyObject *obj, APSWDataColumn *column, Py_ssize_t *nitems)
+{
+  Py_buffer *buffer;
+  const char *format;
+
+  /* these are values, not arrays */
+  if (PyUnicode_Check(obj) || PyBytes_Check(obj) || PyByteArray_Check(obj) || !PyObject_CheckBuffer(obj))
+    return 0;
+
+  buffer = PyMem_Calloc(1, sizeof(Py_buffer));
+  if (!buffer)
+  {
+    PyErr_NoMemory();
+    return -1;
+  }
+  if (PyObject_GetBuffer(obj, buffer, PyBUF_FORMAT | PyBUF_ND))
+  {
+    PyMem_Free(buffer);
+    return -1;
+  }
+  column->buffer = buffer;
+
+  format = buffer->format ? buffer->format : "B";
+  if (*format == '@')
+    format++;
+  if (buffer->ndim > 1 || strlen(format) != 1 || !strchr(datatable_buffer_formats, *format))
+  {
+    PyErr_Format(PyExc_ValueError, "Buffer with format \"%s\" and %d dimensions is not supported in a data table", buffer->format ? buffer->format : "B", buffer->ndim);
+    return -1;
+  }
+  column->format = *format;
+  *nitems = buffer->len / buffer->itemsize;
+  return 1;
+}
+
+/* gets a cell.  text and blob point into the table */
+static void
+datatable_cell(APSWDataTable *table, int ncolumn, sqlite3_int64 row, APSWDataValue *value)
+{
+  APSWDataColumn *column;
+  const char *item;
+
+  if (ncolumn < 0)
+  {
+    value->type = SQLITE_INTEGER;
+    value->u.i = row;
+    return;
+  }
+  column = &table->columns[ncolumn];
+  if (!column->buffer)
+  {
+    *value = column->values[row];
+    return;
+  }
+
+  item = (const char *)column->buffer->buf + row * column->buffer->itemsize;
+  value->type = SQLITE_INTEGER;
+  value->u.i = 0;
+#define DT_ITEM(code, ctype)        \
+  case code:                        \
+    value->u.i = *(ctype *)item; \
+    break
+
+  switch (column->format)
+  {
+    DT_ITEM('b', signed char);
+    DT_ITEM('B', unsigned char);
+    DT_ITEM('h', short);
+    DT_ITEM('H', unsigned short);
+    DT_ITEM('i', int);
+    DT_ITEM('I', unsigned int);
+    DT_ITEM('l', long);
+    DT_ITEM('q', long long);
+    DT_ITEM('n', Py_ssize_t);
+  case 'L':
+  case 'Q':
+  case 'N':
+  {
+    unsigned long long u = (column->format == 'L') ? *(unsigned long *)item : (column->format == 'N') ? *(size_t *)item : *(unsigned long long *)item;
+    if (u > (unsigned long long)APSW_INT64_MAX)
+    {
+      value->type = SQLITE_FLOAT;
+      value->u.d = (double)u;
+    }
+    else
+      value->u.i = (sqlite3_int64)u;
+    break;
+  }
+  case 'f':
+    value->type = SQLITE_FLOAT;
+    value->u.d = *(float *)item;
+    break;
+  case 'd':
+    value->type = SQLITE_FLOAT;
+    value->u.d = *(double *)item;
+    break;
+  }
+#undef DT_ITEM
+}
+
+/* same as SQLite's comparison of an integer with a real */
+static int
+datatable_intfloat_compare(sqlite3_int64 i, double r)
+{
+  sqlite3_int64 y;
+  double s;
+
+  if (r < -9223372036854775808.0)
+    return 1;
+  if (r >= 9223372036854775808.0)
+    return -1;
+  y = (sqlite3_int64)r;
+  if (i < y)
+    return -1;
+  if (i > y)
+    return 1;
+  s = (double)i;
+  return (s < r) ? -1 : (s > r) ? 1 : 0;
+}
+
+/* compares two values neither of which is null, with numbers before
+   text before blobs, and text compared as binary */
+static int
+datatable_compare(const APSWDataValue *a, const APSWDataValue *b)
+{
+  int aclass = (a->type == SQLITE_FLOAT) ? SQLITE_INTEGER : a->type,
+      bclass = (b->type == SQLITE_FLOAT) ? SQLITE_INTEGER : b->type;
+
+  if (aclass != bclass)
+    return (aclass == SQLITE_INTEGER || (aclass == SQLITE_TEXT && bclass == SQLITE_BLOB)) ? -1 : 1;
+
+  if (aclass == SQLITE_INTEGER)
+  {
+    if (a->type == SQLITE_INTEGER && b->type == SQLITE_INTEGER)
+      return (a->u.i < b->u.i) ? -1 : (a->u.i > b->u.i) ? 1 : 0;
+    if (a->type == SQLITE_FLOAT && b->type == SQLITE_FLOAT)
+      return (a->u.d < b->u.d) ? -1 : (a->u.d > b->u.d) ? 1 : 0;
+    if (a->type == SQLITE_INTEGER)
+      return datatable_intfloat_compare(a->u.i, b->u.d);
+    return -datatable_intfloat_compare(b->u.i, a->u.d);
+  }
+  else
+  {
+    int res = memcmp(a->u.p, b->u.p, (a->len < b->len) ? a->len : b->len);
+    return res ? res : (a->len - b->len);
+  }
+}
+
+static int
+datatable_row_matches(apsw_datatable_cursor *cursor)
+{
+  APSWDataValue cell;
+  int i, res;
+
+  for (i = 0; i < cursor->nconstraints; i++)
+  {
+    APSWDataConstraint *constraint = &cursor->constraints[i];
+
+    if (constraint->value.type == SQLITE_NULL)
+      return 0;
+    datatable_cell(cursor->table, constraint->column, cursor->row, &cell);
+    if (cell.type == SQLITE_NULL)
+      return 0;
+    res = datatable_compare(&cell, &constraint->value);
+    switch (constraint->op)
+    {
+    case SQLITE_INDEX_CONSTRAINT_EQ:
+      res = (res == 0);
+      break;
+    case SQLITE_INDEX_CONSTRAINT_GT:
+      res = (res > 0);
+      break;
+    case SQLITE_INDEX_CONSTRAINT_GE:
+      res = (res >= 0);
+      break;
+    case SQLITE_INDEX_CONSTRAINT_LT:
+      res = (res < 0);
+      break;
+    case SQLITE_INDEX_CONSTRAINT_LE:
+      res = (res <= 0);
+      break;
+    }
+    if (!res)
+      return 0;
+  }
+  return 1;
+}
+
+/* moves forward from the current row to the first that matches */
+static void
+datatable_advance(apsw_datatable_cursor *cursor)
+{
+  if (cursor->limit == 0)
+  {
+    cursor->row = cursor->end;
+    return;
+  }
+  while (cursor->row < cursor->end && !datatable_row_matches(cursor))
+    cursor->row++;
+  if (cursor->row < cursor->end && cursor->limit > 0)
+    cursor->limit--;
+}
+
+static int
+datatable_xConnect(sqlite3 *db, void *pAux, int Py_UNUSED(argc), const char *const *Py_UNUSED(argv), sqlite3_vtab **ppVtab, char **Py_UNUSED(pzErr))
+{
+  APSWDataTable *table = (APSWDataTable *)pAux;
+  apsw_datatable_vtab *vtab;
+  int res;
+
+  res = sqlite3_declare_vtab(db, table->schema);
+  if (res != SQLITE_OK)
+    return res;
+  vtab = sqlite3_malloc(sizeof(apsw_datatable_vtab));
+  if (!vtab)
+    return SQLITE_NOMEM;
+  memset(vtab, 0, sizeof(apsw_datatable_vtab));
+  vtab->table = table;
+  *ppVtab = (sqlite3_vtab *)vtab;
+  return SQLITE_OK;
+}
+
+static int
+datatable_xDisconnect(sqlite3_vtab *pVtab)
+{
+  sqlite3_free(pVtab);
+  return SQLITE_OK;
+}
+
+static int
+datatable_xBestIndex(sqlite3_vtab *pVtab, sqlite3_index_info *info)
+{
+  APSWDataTable *table = ((apsw_datatable_vtab *)pVtab)->table;
+  int i, nargs = 0, allhandled = 1, limit = -1, offset = -1, unique = 0;
+  double rows = (double)table->nrows;
+  sqlite3_str *idxstr = sqlite3_str_new(NULL);
+
+  for (i = 0; i < info->nConstraint; i++)
+  {
+    const struct sqlite3_index_constraint *constraint = &info->aConstraint[i];
+    const char *collation;
+
+    switch (constraint->op)
+    {
+    case SQLITE_INDEX_CONSTRAINT_LIMIT:
+      limit = i;
+      continue;
+    case SQLITE_INDEX_CONSTRAINT_OFFSET:
+      offset = i;
+      continue;
+    case SQLITE_INDEX_CONSTRAINT_EQ:
+    case SQLITE_INDEX_CONSTRAINT_GT:
+    case SQLITE_INDEX_CONSTRAINT_GE:
+    case SQLITE_INDEX_CONSTRAINT_LT:
+    case SQLITE_INDEX_CONSTRAINT_LE:
+      collation = sqlite3_vtab_collation(info, i);
+      if (constraint->usable && (!collation || 0 == sqlite3_stricmp(collation, "BINARY")))
+        break;
+      /* fallthrough */
+    default:
+      allhandled = 0;
+      continue;
+    }
+
+    info->aConstraintUsage[i].argvIndex = ++nargs;
+    info->aConstraintUsage[i].omit = 1;
+    sqlite3_str_appendf(idxstr, "%d:%d ", constraint->iColumn, constraint->op);
+    if (constraint->op == SQLITE_INDEX_CONSTRAINT_EQ && constraint->iColumn < 0)
+    {
+      info->idxFlags |= SQLITE_INDEX_SCAN_UNIQUE;
+      unique = 1;
+      rows = 1;
+    }
+    else
+      rows /= (constraint->op == SQLITE_INDEX_CONSTRAINT_EQ) ? 10 : 3;
+  }
+
+  /* rows come out in rowid order */
+  if (info->nOrderBy == 1 && info->aOrderBy[0].iColumn < 0 && !info->aOrderBy[0].desc)
+    info->orderByConsumed = 1;
+
+  /* the scan can only stop early if nothing else is filtering rows and
+     SQLite isn't going to sort them afterwards */
+  if (allhandled && limit >= 0 && (info->nOrderBy == 0 || info->orderByConsumed))
+  {
+    info->aConstraintUsage[limit].argvIndex = ++nargs;
+    sqlite3_str_appendf(idxstr, "%d:%d ", -2, SQLITE_INDEX_CONSTRAINT_LIMIT);
+    if (offset >= 0)
+    {
+      info->aConstraintUsage[offset].argvIndex = ++nargs;
+      sqlite3_str_appendf(idxstr, "%d:%d ", -2, SQLITE_INDEX_CONSTRAINT_OFFSET);
+    }
+  }
+
+  if (sqlite3_str_errcode(idxstr))
+  {
+    sqlite3_free(sqlite3_str_finish(idxstr));
+    return SQLITE_NOMEM;
+  }
+  info->idxStr = sqlite3_str_finish(idxstr);
+  info->needToFreeIdxStr = 1;
+  if (unique)
+    info->estimatedCost = 1 + rows;
+  else
+    /* scanning is much cheaper than for SQLite to check the rows */
+    info->estimatedCost = 1 + table->nrows / 4.0 + rows;
+  info->estimatedRows = (sqlite3_int64)(rows < 1 ? 1 : rows);
+  return SQLITE_OK;
+}
+
+static int
+datatable_xOpen(sqlite3_vtab *pVtab, sqlite3_vtab_cursor **ppCursor)
+{
+  apsw_datatable_cursor *cursor = sqlite3_malloc(sizeof(apsw_datatable_cursor));
+  if (!cursor)
+    return SQLITE_NOMEM;
+  memset(cursor, 0, sizeof(apsw_datatable_cursor));
+  cursor->table = ((apsw_datatable_vtab *)pVtab)->table;
+  *ppCursor = (sqlite3_vtab_cursor *)cursor;
+  return SQLITE_OK;
+}
+
+static void
+datatable_cursor_clear(apsw_datatable_cursor *cursor)
+{
+  int i;
+  for (i = 0; i < cursor->nconstraints; i++)
+    datatable_value_free(&cursor->constraints[i].value);
+  sqlite3_free(cursor->constraints);
+  cursor->constraints = NULL;
+  cursor->nconstraints = 0;
+}
+
+static int
+datatable_xClose(sqlite3_vtab_cursor *pCursor)
+{
+  datatable_cursor_clear((apsw_datatable_cursor *)pCursor);
+  sqlite3_free(pCursor);
+  return SQLITE_OK;
+}
+
+static int
+datatable_xFilter(sqlite3_vtab_cursor *pCursor, int Py_UNUSED(idxNum), const char *idxStr, int argc, sqlite3_value **argv)
+{
+  apsw_datatable_cursor *cursor = (apsw_datatable_cursor *)pCursor;
+  sqlite3_int64 offset = 0;
+  int i, column, op;
+  char *next;
+
+  datatable_cursor_clear(cursor);
+  cursor->row = 0;
+  cursor->end = cursor->table->nrows;
+  cursor->limit = -1;
+  if (argc)
+  {
+    cursor->constraints = sqlite3_malloc64(sizeof(APSWDataConstraint) * argc);
+    if (!cursor->constraints)
+      return SQLITE_NOMEM;
+  }
+
+  for (i = 0; i < argc; i++)
+  {
+    column = (int)strtol(idxStr, &next, 10);
+    op = (int)strtol(next + 1, &next, 10);
+    idxStr = next + 1;
+
+    if (op == SQLITE_INDEX_CONSTRAINT_LIMIT || op == SQLITE_INDEX_CONSTRAINT_OFFSET)
+    {
+      if (sqlite3_value_type(argv[i]) == SQLITE_INTEGER)
+      {
+        if (op == SQLITE_INDEX_CONSTRAINT_LIMIT)
+          cursor->limit = sqlite3_value_int64(argv[i]);
+        else if (sqlite3_value_int64(argv[i]) > 0)
+          offset = sqlite3_value_int64(argv[i]);
+      }
+      continue;
+    }
+
+    if (column < 0 && sqlite3_value_type(argv[i]) == SQLITE_INTEGER)
+    {
+      /* narrow the rows scanned */
+      sqlite3_int64 rowid = sqlite3_value_int64(argv[i]);
+      sqlite3_int64 start = cursor->row, end = cursor->end;
+      switch (op)
+      {
+      case SQLITE_INDEX_CONSTRAINT_EQ:
+        start = rowid;
+        end = (rowid < APSW_INT64_MAX) ? rowid + 1 : rowid;
+        break;
+      case SQLITE_INDEX_CONSTRAINT_GT:
+        start = (rowid < APSW_INT64_MAX) ? rowid + 1 : rowid;
+        break;
+      case SQLITE_INDEX_CONSTRAINT_GE:
+        start = rowid;
+        break;
+      case SQLITE_INDEX_CONSTRAINT_LT:
+        end = rowid;
+        break;
+      case SQLITE_INDEX_CONSTRAINT_LE:
+        end = (rowid < APSW_INT64_MAX) ? rowid + 1 : rowid;
+        break;
+      }
+      if (start > cursor->row)
+        cursor->row = start;
+      if (end < cursor->end)
+        cursor->end = end;
+      if (cursor->row > cursor->end)
+        cursor->row = cursor->end;
+      continue;
+    }
+
+    cursor->constraints[cursor->nconstraints].column = column;
+    cursor->constraints[cursor->nconstraints].op = op;
+    datatable_value_from_sqlite(argv[i], &cursor->constraints[cursor->nconstraints].value);
+    cursor->nconstraints++;
+  }
+
+  /* SQLite skips the offset rows itself */
+  if (cursor->limit >= 0 && offset)
+    cursor->limit = (cursor->limit > APSW_INT64_MAX - offset) ? -1 : cursor->limit + offset;
+
+  datatable_advance(cursor);
+  return SQLITE_OK;
+}
+
+static int
+datatable_xNext(sqlite3_vtab_cursor *pCursor)
+{
+  apsw_datatable_cursor *cursor = (apsw_datatable_cursor *)pCursor;
+  cursor->row++;
+  datatable_advance(cursor);
+  return SQLITE_OK;
+}
+
+static int
+datatable_xEof(sqlite3_vtab_cursor *pCursor)
+{
+  apsw_datatable_cursor *cursor = (apsw_datatable_cursor *)pCursor;
+  return cursor->row >= cursor->end;
+}
+
+static int
+datatable_xColumn(sqlite3_vtab_cursor *pCursor, sqlite3_context *context, int ncolumn)
+{
+  apsw_datatable_cursor *cursor = (apsw_datatable_cursor *)pCursor;
+  APSWDataValue cell;
+
+  datatable_cell(cursor->table, ncolumn, cursor->row, &cell);
+  switch (cell.type)
+  {
+  case SQLITE_NULL:
+    sqlite3_result_null(context);
+    break;
+  case SQLITE_INTEGER:
+    sqlite3_result_int64(context, cell.u.i);
+    break;
+  case SQLITE_FLOAT:
+    sqlite3_result_double(context, cell.u.d);
+    break;
+  /* the table outlives any statement using it */
+  case SQLITE_TEXT:
+    sqlite3_result_text(context, cell.u.p, cell.len, SQLITE_STATIC);
+    break;
+  case SQLITE_BLOB:
+    sqlite3_result_blob(context, cell.u.p, cell.len, SQLITE_STATIC);
+    break;
+  }
+  return SQLITE_OK;
+}
+
+static int
+datatable_xRowid(sqlite3_vtab_cursor *pCursor, sqlite3_int64 *pRowid)
+{
+  *pRowid = ((apsw_datatable_cursor *)pCursor)->row;
+  return SQLITE_OK;
+}
+
+static struct sqlite3_module apsw_datatable_module =
+    {
+        2,                     /* version */
+        0,                     /* create - eponymous only */
+        datatable_xConnect,    /* connect */
+        datatable_xBestIndex,  /* best index */
+        datatable_xDisconnect, /* disconnect */
+        0,                     /* destroy */
+        datatable_xOpen,       /* open */
+        datatable_xClose,      /* close */
+        datatable_xFilter,     /* filter */
+        datatable_xNext,       /* next */
+        datatable_xEof,        /* eof */
+        datatable_xColumn,     /* column */
+        datatable_xRowid,      /* rowid */
+        0,                     /* update */
+        0,                     /* begin */
+        0,                     /* sync */
+        0,                     /* commit */
+        0,                     /* rollback */
+        0,                     /* find function */
+        0,                     /* rename */
+        0,                     /* savepoint */
+        0,                     /* release */
+        0,                     /* rollback to */
+};
+
+/* converts the data supplied to create_data_table, returning NULL
+   with an exception set on failure */
+static APSWDataTable *
+datatable_new(PyObject *data, PyObject *columns)
+{
+  APSWDataTable *table = NULL;
+  PyObject *names = NULL, *rows = NULL, *row = NULL, *item;
+  sqlite3_str *schema = NULL;
+  Py_ssize_t i, j, nitems, allocated = 0;
+
+  table = PyMem_Calloc(1, sizeof(APSWDataTable));
+  if (!table)
+  {
+    PyErr_NoMemory();
+    goto error;
+  }
+
+  if (PyDict_Check(data))
+  {
+    PyObject *key, *value;
+    Py_ssize_t pos = 0;
+
+    if (columns && columns != Py_None)
+    {
+      PyErr_Format(PyExc_ValueError, "columns can't be supplied when data is a dict");
+      goto error;
+    }
+    names = PyDict_Keys(data);
+    if (!names)
+      goto error;
+    table->ncolumns = (int)PyList_GET_SIZE(names);
+    table->columns = PyMem_Calloc(table->ncolumns ? table->ncolumns : 1, sizeof(APSWDataColumn));
+    if (!table->columns)
+    {
+      PyErr_NoMemory();
+      goto error;
+    }
+    table->nrows = -1;
+    for (i = 0; PyDict_Next(data, &pos, &key, &value); i++)
+    {
+      APSWDataColumn *column = &table->columns[i];
+      int res = datatable_buffer_column(value, column, &nitems);
+
+      if (res < 0)
+        goto error;
+      if (!res)
+      {
+        PyObject *seq = PySequence_Fast(value, "Each value of a dict for a data table must be a sequence or buffer");
+        if (!seq)
+          goto error;
+        nitems = PySequence_Fast_GET_SIZE(seq);
+        column->values = PyMem_RawCalloc(nitems ? nitems : 1, sizeof(APSWDataValue));
+        if (!column->values)
+        {
+          Py_DECREF(seq);
+          PyErr_NoMemory();
+          goto error;
+        }
+        for (j = 0; j < nitems; j++)
+          if (datatable_value_from_python(PySequence_Fast_GET_ITEM(seq, j), &column->values[j]))
+          {
+            /* table->nrows isn't known yet, so free what was done here */
+            while (j--)
+              datatable_value_free(&column->values[j]);
+            PyMem_RawFree(column->values);
+            column->values = NULL;
+            Py_DECREF(seq);
+            goto error;
+          }
+        Py_DECREF(seq);
+      }
+      if (table->nrows >= 0 && nitems != table->nrows)
+      {
+        if (column->values)
+        {
+          for (j = 0; j < nitems; j++)
+            datatable_value_free(&column->values[j]);
+          PyMem_RawFree(column->values);
+          column->values = NULL;
+        }
+        PyErr_Format(PyExc_ValueError, "Column %R has %zd items but the previous ones have %lld", key, nitems, table->nrows);
+        goto error;
+      }
+      table->nrows = nitems;
+    }
+    if (table->nrows < 0)
+      table->nrows = 0;
+  }
+  else
+  {
+    rows = PyObject_GetIter(data);
+    if (!rows)
+      goto error;
+    if (columns && columns != Py_None)
+    {
+      names = PySequence_List(columns);
+      if (!names)
+        goto error;
+      table->ncolumns = (int)PyList_GET_SIZE(names);
+    }
+    else
+      table->ncolumns = -1;
+
+    while ((row = PyIter_Next(rows)))
+    {
+      PyObject *seq = PySequence_Fast(row, "Each row of a data table must be a sequence");
+      if (!seq)
+        goto error;
+      Py_DECREF(row);
+      row = seq;
+
+      if (table->ncolumns < 0)
+        table->ncolumns = (int)PySequence_Fast_GET_SIZE(row);
+      if (PySequence_Fast_GET_SIZE(row) != table->ncolumns)
+      {
+        PyErr_Format(PyExc_ValueError, "Row %lld has %zd values but there are %d columns", table->nrows, PySequence_Fast_GET_SIZE(row), table->ncolumns);
+        goto error;
+      }
+      if (!table->columns)
+      {
+        table->columns = PyMem_Calloc(table->ncolumns ? table->ncolumns : 1, sizeof(APSWDataColumn));
+        if (!table->columns)
+        {
+          PyErr_NoMemory();
+          goto error;
+        }
+      }
+      if (table->nrows == allocated)
+      {
+        Py_ssize_t newallocated = allocated ? allocated * 2 : 256;
+        for (j = 0; j < table->ncolumns; j++)
+        {
+          APSWDataValue *values = PyMem_RawRealloc(table->columns[j].values, newallocated * sizeof(APSWDataValue));
+          if (!values)
+          {
+            PyErr_NoMemory();
+            goto error;
+          }
+          table->columns[j].values = values;
+        }
+        allocated = newallocated;
+      }
+      for (j = 0; j < table->ncolumns; j++)
+        table->columns[j].values[table->nrows].type = SQLITE_NULL;
+      table->nrows++;
+      for (j = 0; j < table->ncolumns; j++)
+        if (datatable_value_from_python(PySequence_Fast_GET_ITEM(row, j), &table->columns[j].values[table->nrows - 1]))
+          goto error;
+      Py_CLEAR(row);
+    }
+    if (PyErr_Occurred())
+      goto error;
+    if (table->ncolumns < 0)
+    {
+      PyErr_Format(PyExc_ValueError, "columns must be supplied when there are no rows");
+      goto error;
+    }
+    if (!table->columns)
+    {
+      table->columns = PyMem_Calloc(table->ncolumns ? table->ncolumns : 1, sizeof(APSWDataColumn));
+      if (!table->columns)
+      {
+        PyErr_NoMemory();
+        goto error;
+      }
+    }
+  }
+
+  if (table->ncolumns < 1)
+  {
+    PyErr_Format(PyExc_ValueError, "A data table must have at least one column");
+    goto error;
+  }
+
+  schema = sqlite3_str_new(NULL);
+  sqlite3_str_appendall(schema, "create table x(");
+  for (i = 0; i < table->ncolumns; i++)
+  {
+    if (names)
+    {
+      item = PyList_GET_ITEM(names, i);
+      if (!PyUnicode_Check(item))
+      {
+        PyErr_Format(PyExc_TypeError, "Column names must be str not %s", Py_TYPE(item)->tp_name);
+        goto error;
+      }
+      sqlite3_str_appendf(schema, "%s\"%w\"", i ? "," : "", PyUnicode_AsUTF8(item));
+    }
+    else
+      sqlite3_str_appendf(schema, "%sc%d", i ? "," : "", (int)i);
+  }
+  sqlite3_str_appendall(schema, ")");
+  if (PyErr_Occurred())
+    goto error;
+  if (sqlite3_str_errcode(schema))
+  {
+    PyErr_NoMemory();
+    goto error;
+  }
+  table->schema = sqlite3_str_finish(schema);
+  schema = NULL;
+
+  Py_XDECREF(names);
+  Py_XDECREF(rows);
+  return table;
+
+error:
+  assert(PyErr_Occurred());
+  if (schema)
+    sqlite3_free(sqlite3_str_finish(schema));
+  Py_XDECREF(names);
+  Py_XDECREF(rows);
+  Py_XDECREF(row);
+  datatable_free(table);
+  return NULL;
+}
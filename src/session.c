@@ -0,0 +1,545 @@
+/*
+  Another Python Sqlite Wrapper
+
+  Wrap SQLite session extension
+
+  See the accompanying LICENSE file.
+*/
+
+/**
+
+.. _session:
+
+Sessions and changesets
+***********************
+
+The `session extension <https://sqlite.org/sessionintro.html>`__
+records changes made to tables, and turns them into a *changeset*
+(or the more compact *patchset*).  A changeset can be applied to
+another database with the same schema, which is how you do
+incremental replication - only the rows that changed are sent and
+not the whole database.
+
+Call :meth:`Connection.session` to start recording, and
+:meth:`Connection.apply_changeset` on the other database::
+
+  session = source.session()
+  session.attach()    # all tables
+  source.cursor().execute("update items set price=price*1.1 where category='tools'")
+
+  changes = session.changeset()
+  session.close()
+
+  replica.apply_changeset(changes)
+
+Conflicts such as the row on the replica having been changed as well
+are given to a callback which decides what to do.
+
+Large changesets don't have to be entirely in memory.
+:meth:`Session.changeset_stream` gives the changeset to a callable a
+piece at a time (such as the write method of a file), and
+:meth:`Connection.apply_changeset` can read one a piece at a time from
+a callable (such as the read method of a file).
+
+SQLite must have been compiled with ``SQLITE_ENABLE_SESSION`` and
+``SQLITE_ENABLE_PREUPDATE_HOOK``, and APSW with ``--enable=session``.
+If it wasn't then :class:`Session` won't exist.
+
+Important details
+=================
+
+Only tables with an explicit PRIMARY KEY are recorded.  Changes
+recorded are the net effect - a row inserted and then deleted is not
+in the changeset at all.
+
+The changeset is worked out from the database when you ask for it,
+using the primary keys of the changed rows, so ask before the
+:class:`Connection` closes.
+
+*/
+
+/* we love us some macros */
+#define CHECK_SESSION_CLOSED(e)                                                                \
+  do                                                                                           \
+  {                                                                                            \
+    if (!self->session)                                                                        \
+    {                                                                                          \
+      PyErr_Format(ExcConnectionClosed, "The session has been closed");                        \
+      return e;                                                                                \
+    }                                                                                          \
+  } while (0)
+
+/** .. class:: Session
+
+  You create a session by calling :meth:`Connection.session`.
+*/
+
+struct APSWSession
+{
+  PyObject_HEAD
+      Connection *connection;
+  sqlite3_session *session;
+  int inuse;
+  PyObject *weakreflist;
+};
+
+typedef struct APSWSession APSWSession;
+
+static void
+APSWSession_init(APSWSession *self, Connection *connection, sqlite3_session *session)
+{
+  Py_INCREF(connection);
+  self->connection = connection;
+  self->session = session;
+  self->inuse = 0;
+  self->weakreflist = NULL;
+}
+
+static void
+APSWSession_close_internal(APSWSession *self)
+{
+  if (self->session)
+  {
+    int res = SQLITE_OK;
+    PYSQLITE_SESSION_CALL(sqlite3session_delete(self->session));
+    self->session = 0;
+  }
+
+  if (self->connection)
+    Connection_remove_dependent(self->connection, (PyObject *)self);
+
+  Py_CLEAR(self->connection);
+}
+
+static void
+APSWSession_dealloc(APSWSession *self)
+{
+  APSW_CLEAR_WEAKREFS;
+
+  APSWSession_close_internal(self);
+
+  Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+/** .. method:: attach(table: Optional[str] = None) -> None
+
+  Starts recording changes to *table*, or to all tables in the
+  database including ones created later if you pass None.  Tables
+  without a PRIMARY KEY are ignored.
+
+  -* sqlite3session_attach
+*/
+static PyObject *
+APSWSession_attach(APSWSession *self, PyObject *args, PyObject *kwds)
+{
+  const char *table = NULL;
+  int res;
+
+  CHECK_USE(NULL);
+  CHECK_SESSION_CLOSED(NULL);
+
+  {
+    static char *kwlist[] = {"table", NULL};
+    Session_attach_CHECK;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|z:" Session_attach_USAGE, kwlist, &table))
+      return NULL;
+  }
+  PYSQLITE_SESSION_CALL(res = sqlite3session_attach(self->session, table));
+  SET_EXC(res, self->connection->db);
+  if (res != SQLITE_OK)
+    return NULL;
+
+  Py_RETURN_NONE;
+}
+
+/* Called by SQLite without the GIL with each piece of a streamed
+   changeset or patchset */
+static int
+session_output_cb(void *context, const void *data, int len)
+{
+  PyGILState_STATE gilstate;
+  PyObject *output = (PyObject *)context, *bytes = NULL, *retval = NULL;
+  int res = SQLITE_ERROR;
+
+  gilstate = PyGILState_Ensure();
+
+  if (PyErr_Occurred())
+    goto finally;
+
+  bytes = PyBytes_FromStringAndSize(data, len);
+  if (!bytes)
+    goto finally;
+
+  retval = PyObject_CallFunction(output, "(O)", bytes);
+  if (!retval)
+  {
+    AddTraceBackHere(__FILE__, __LINE__, "Session.output", "{s: O, s: i}", "output", OBJ(output), "len", len);
+    goto finally;
+  }
+  res = SQLITE_OK;
+
+finally:
+  Py_XDECREF(bytes);
+  Py_XDECREF(retval);
+  PyGILState_Release(gilstate);
+  return res;
+}
+
+/* Gets the changeset or patchset, either returned as bytes or given
+   to output a piece at a time */
+static PyObject *
+APSWSession_output(APSWSession *self, int patchset, PyObject *output)
+{
+  void *data = NULL;
+  int res, len = 0;
+  PyObject *result;
+
+  if (output)
+  {
+    if (patchset)
+      PYSQLITE_SESSION_CALL(res = sqlite3session_patchset_strm(self->session, session_output_cb, output));
+    else
+      PYSQLITE_SESSION_CALL(res = sqlite3session_changeset_strm(self->session, session_output_cb, output));
+  }
+  else
+  {
+    if (patchset)
+      PYSQLITE_SESSION_CALL(res = sqlite3session_patchset(self->session, &len, &data));
+    else
+      PYSQLITE_SESSION_CALL(res = sqlite3session_changeset(self->session, &len, &data));
+  }
+
+  SET_EXC(res, self->connection->db);
+  if (PyErr_Occurred())
+  {
+    sqlite3_free(data);
+    return NULL;
+  }
+
+  if (output)
+    Py_RETURN_NONE;
+
+  result = PyBytes_FromStringAndSize(data, len);
+  sqlite3_free(data);
+  return result;
+}
+
+/** .. method:: changeset() -> bytes
+
+  Returns the changes recorded so far as a changeset.  It has the
+  old and new values of changed rows, so it can be inverted and
+  conflicts can be detected when it is applied.
+
+  .. seealso::
+
+    * :meth:`Connection.apply_changeset`
+    * :meth:`~Session.changeset_stream`
+
+  -* sqlite3session_changeset
+*/
+static PyObject *
+APSWSession_changeset(APSWSession *self)
+{
+  CHECK_USE(NULL);
+  CHECK_SESSION_CLOSED(NULL);
+
+  return APSWSession_output(self, 0, NULL);
+}
+
+/** .. method:: patchset() -> bytes
+
+  Returns the changes recorded so far as a patchset.  This is
+  smaller than a :meth:`~Session.changeset` because only the primary
+  key of deleted rows and the new values of updated columns are
+  included, but that means fewer conflicts can be detected when it is
+  applied.
+
+  -* sqlite3session_patchset
+*/
+static PyObject *
+APSWSession_patchset(APSWSession *self)
+{
+  CHECK_USE(NULL);
+  CHECK_SESSION_CLOSED(NULL);
+
+  return APSWSession_output(self, 1, NULL);
+}
+
+/** .. method:: changeset_stream(output: Callable[[bytes], None]) -> None
+
+  Produces the same changeset as :meth:`~Session.changeset` but
+  calls *output* with it a piece at a time, so the whole changeset is
+  never in memory.  For example you can pass the write method of a
+  file.  An exception in *output* stops the changeset being produced.
+
+  -* sqlite3session_changeset_strm
+*/
+static PyObject *
+APSWSession_changeset_stream(APSWSession *self, PyObject *args, PyObject *kwds)
+{
+  PyObject *output;
+
+  CHECK_USE(NULL);
+  CHECK_SESSION_CLOSED(NULL);
+
+  {
+    static char *kwlist[] = {"output", NULL};
+    Session_changeset_stream_CHECK;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O&:" Session_changeset_stream_USAGE, kwlist, argcheck_Callable, &output))
+      return NULL;
+  }
+  return APSWSession_output(self, 0, output);
+}
+
+/** .. method:: patchset_stream(output: Callable[[bytes], None]) -> None
+
+  Produces the same patchset as :meth:`~Session.patchset` but calls
+  *output* with it a piece at a time.
+
+  -* sqlite3session_patchset_strm
+*/
+static PyObject *
+APSWSession_patchset_stream(APSWSession *self, PyObject *args, PyObject *kwds)
+{
+  PyObject *output;
+
+  CHECK_USE(NULL);
+  CHECK_SESSION_CLOSED(NULL);
+
+  {
+    static char *kwlist[] = {"output", NULL};
+    Session_patchset_stream_CHECK;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O&:" Session_patchset_stream_USAGE, kwlist, argcheck_Callable, &output))
+      return NULL;
+  }
+  return APSWSession_output(self, 1, output);
+}
+
+/** .. method:: close(force: bool = False) -> None
+
+  Stops recording and frees the session.  It is safe to call this
+  method multiple times.  Sessions are closed when their
+  :class:`Connection` is closed.
+
+  :param force: Accepted for the same api as other APSW objects
+    such as :meth:`Blob.close`.  Closing a session can't fail.
+
+  -* sqlite3session_delete
+*/
+static PyObject *
+APSWSession_close(APSWSession *self, PyObject *args, PyObject *kwds)
+{
+  int force = 0;
+
+  CHECK_USE(NULL);
+
+  {
+    static char *kwlist[] = {"force", NULL};
+    Session_close_CHECK;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|O&:" Session_close_USAGE, kwlist, argcheck_bool, &force))
+      return NULL;
+  }
+  APSWSession_close_internal(self);
+
+  Py_RETURN_NONE;
+}
+
+/** .. method:: __enter__() -> Session
+
+  You can use the session as a `context manager
+  <http://docs.python.org/reference/datamodel.html#with-statement-context-managers>`_
+  as defined in :pep:`0343`.  The :meth:`~Session.__exit__` method
+  ensures the session is :meth:`closed <Session.close>`.
+*/
+static PyObject *
+APSWSession_enter(APSWSession *self)
+{
+  CHECK_USE(NULL);
+  CHECK_SESSION_CLOSED(NULL);
+
+  Py_INCREF(self);
+  return (PyObject *)self;
+}
+
+/** .. method:: __exit__() -> Literal[False]
+
+  Implements context manager in conjunction with
+  :meth:`~Session.__enter__` ensuring the session is :meth:`closed
+  <Session.close>`.
+*/
+static PyObject *
+APSWSession_exit(APSWSession *self, PyObject *Py_UNUSED(args))
+{
+  CHECK_USE(NULL);
+
+  APSWSession_close_internal(self);
+
+  Py_RETURN_FALSE;
+}
+
+/** .. attribute:: enabled
+  :type: bool
+
+  Changes are only recorded while the session is enabled, which it
+  is when created.
+
+  -* sqlite3session_enable
+*/
+static PyObject *
+APSWSession_get_enabled(APSWSession *self, void *Py_UNUSED(ignored))
+{
+  int res = SQLITE_OK, enabled;
+
+  CHECK_USE(NULL);
+  CHECK_SESSION_CLOSED(NULL);
+
+  PYSQLITE_SESSION_CALL(enabled = sqlite3session_enable(self->session, -1));
+  return PyBool_FromLong(enabled);
+}
+
+static int
+APSWSession_set_enabled(APSWSession *self, PyObject *value, void *Py_UNUSED(ignored))
+{
+  int res = SQLITE_OK, enabled;
+
+  CHECK_USE(-1);
+  CHECK_SESSION_CLOSED(-1);
+
+  enabled = PyObject_IsTrue(value);
+  if (enabled < 0)
+    return -1;
+  PYSQLITE_SESSION_CALL(sqlite3session_enable(self->session, enabled));
+  return 0;
+}
+
+/** .. attribute:: indirect
+  :type: bool
+
+  Changes recorded while this is True are marked as indirect in the
+  changeset, which is how changes made by triggers and foreign key
+  actions are usually told apart from the direct ones.  Applying a
+  changeset treats both the same.
+
+  -* sqlite3session_indirect
+*/
+static PyObject *
+APSWSession_get_indirect(APSWSession *self, void *Py_UNUSED(ignored))
+{
+  int res = SQLITE_OK, indirect;
+
+  CHECK_USE(NULL);
+  CHECK_SESSION_CLOSED(NULL);
+
+  PYSQLITE_SESSION_CALL(indirect = sqlite3session_indirect(self->session, -1));
+  return PyBool_FromLong(indirect);
+}
+
+static int
+APSWSession_set_indirect(APSWSession *self, PyObject *value, void *Py_UNUSED(ignored))
+{
+  int res = SQLITE_OK, indirect;
+
+  CHECK_USE(-1);
+  CHECK_SESSION_CLOSED(-1);
+
+  indirect = PyObject_IsTrue(value);
+  if (indirect < 0)
+    return -1;
+  PYSQLITE_SESSION_CALL(sqlite3session_indirect(self->session, indirect));
+  return 0;
+}
+
+/** .. attribute:: is_empty
+  :type: bool
+
+  Read only.  True if no changes have been recorded.
+
+  -* sqlite3session_isempty
+*/
+static PyObject *
+APSWSession_get_is_empty(APSWSession *self, void *Py_UNUSED(ignored))
+{
+  int res = SQLITE_OK, empty;
+
+  CHECK_USE(NULL);
+  CHECK_SESSION_CLOSED(NULL);
+
+  PYSQLITE_SESSION_CALL(empty = sqlite3session_isempty(self->session));
+  return PyBool_FromLong(empty);
+}
+
+static PyGetSetDef session_getset[] = {
+    /* name getter setter doc closure */
+    {"enabled", (getter)APSWSession_get_enabled, (setter)APSWSession_set_enabled, Session_enabled_DOC, NULL},
+    {"indirect", (getter)APSWSession_get_indirect, (setter)APSWSession_set_indirect, Session_indirect_DOC, NULL},
+    {"is_empty", (getter)APSWSession_get_is_empty, NULL, Session_is_empty_DOC, NULL},
+    {0, 0, 0, 0, 0}};
+
+static PyMethodDef session_methods[] = {
+    {"__enter__", (PyCFunction)APSWSession_enter, METH_NOARGS,
+     Session_enter_DOC},
+    {"__exit__", (PyCFunction)APSWSession_exit, METH_VARARGS,
+     Session_exit_DOC},
+    {"attach", (PyCFunction)APSWSession_attach, METH_VARARGS | METH_KEYWORDS,
+     Session_attach_DOC},
+    {"changeset", (PyCFunction)APSWSession_changeset, METH_NOARGS,
+     Session_changeset_DOC},
+    {"patchset", (PyCFunction)APSWSession_patchset, METH_NOARGS,
+     Session_patchset_DOC},
+    {"changeset_stream", (PyCFunction)APSWSession_changeset_stream, METH_VARARGS | METH_KEYWORDS,
+     Session_changeset_stream_DOC},
+    {"patchset_stream", (PyCFunction)APSWSession_patchset_stream, METH_VARARGS | METH_KEYWORDS,
+     Session_patchset_stream_DOC},
+    {"close", (PyCFunction)APSWSession_close, METH_VARARGS | METH_KEYWORDS,
+     Session_close_DOC},
+    {0, 0, 0, 0}};
+
+static PyTypeObject APSWSessionType =
+    {
+        PyVarObject_HEAD_INIT(NULL, 0) "apsw.Session",                          /*tp_name*/
+        sizeof(APSWSession),                                                    /*tp_basicsize*/
+        0,                                                                      /*tp_itemsize*/
+        (destructor)APSWSession_dealloc,                                        /*tp_dealloc*/
+        0,                                                                      /*tp_print*/
+        0,                                                                      /*tp_getattr*/
+        0,                                                                      /*tp_setattr*/
+        0,                                                                      /*tp_compare*/
+        0,                                                                      /*tp_repr*/
+        0,                                                                      /*tp_as_number*/
+        0,                                                                      /*tp_as_sequence*/
+        0,                                                                      /*tp_as_mapping*/
+        0,                                                                      /*tp_hash */
+        0,                                                                      /*tp_call*/
+        0,                                                                      /*tp_str*/
+        0,                                                                      /*tp_getattro*/
+        0,                                                                      /*tp_setattro*/
+        0,                                                                      /*tp_as_buffer*/
+        Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE | Py_TPFLAGS_HAVE_VERSION_TAG, /*tp_flags*/
+        Session_init_DOC,                                                       /* tp_doc */
+        0,                                                                      /* tp_traverse */
+        0,                                                                      /* tp_clear */
+        0,                                                                      /* tp_richcompare */
+        offsetof(APSWSession, weakreflist),                                     /* tp_weaklistoffset */
+        0,                                                                      /* tp_iter */
+        0,                                                                      /* tp_iternext */
+        session_methods,                                                        /* tp_methods */
+        0,                                                                      /* tp_members */
+        session_getset,                                                         /* tp_getset */
+        0,                                                                      /* tp_base */
+        0,                                                                      /* tp_dict */
+        0,                                                                      /* tp_descr_get */
+        0,                                                                      /* tp_descr_set */
+        0,                                                                      /* tp_dictoffset */
+        0,                                                                      /* tp_init */
+        0,                                                                      /* tp_alloc */
+        0,                                                                      /* tp_new */
+        0,                                                                      /* tp_free */
+        0,                                                                      /* tp_is_gc */
+        0,                                                                      /* tp_bases */
+        0,                                                                      /* tp_mro */
+        0,                                                                      /* tp_cache */
+        0,                                                                      /* tp_subclasses */
+        0,                                                                      /* tp_weaklist */
+        0,                                                                      /* tp_del */
+        PyType_TRAILER
+};
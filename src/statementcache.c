@@ -23,11 +23,20 @@
 
    This second implementation is simpler and allows having multiple
    entries for the same query.  The primary data structure is an array
-   of hash values.  Finding an entry is a linear search (fast on
-   modern cpus).  Entries are removed while in use. When finished they
+   of hash values.  Entries are removed while in use. When finished they
    are placed back in a circular order, which then evicts the oldest
    entry.
 
+   Finding an entry was originally a linear search of the hash array
+   which is fast on modern cpus for the default size of 100, but
+   dominates when the cache has thousands of entries.  An open
+   addressed (linear probing) index over the hash array is now also
+   maintained.  Each index element is the position in the arrays plus
+   one, with zero meaning unused.  The index is always at least twice
+   the number of entries so probe sequences are short, and removal
+   uses backward shifting so no tombstones are needed.  Multiple
+   entries for the same query simply occupy multiple index elements.
+
    A copy of the query has to be kept around for doing equality
    comparisons when looking in the cache.  But sqlite also keeps a
    copy of the query, so we try to use that if possible.
@@ -42,16 +51,27 @@ typedef struct APSWStatement
   Py_ssize_t query_size;       /* how many bytes of utf8 constitute the first query
                                   (the utf8 could have more than one) */
   Py_hash_t hash;              /* hash of all of utf8 */
+  sqlite3_uint64 uses;         /* how many times this has been found in the cache */
 } APSWStatement;
 
 typedef struct StatementCache
 {
   Py_hash_t *hashes;      /* array of hash values */
   APSWStatement **caches; /* corresponding statements */
+  unsigned *index;        /* open addressed index into hashes/caches (position+1, zero is unused) */
+  unsigned index_mask;    /* number of index elements minus one (always a power of two) */
   sqlite3 *db;            /* db to work against */
   unsigned highest_used;  /* largest entry we have used - no point scanning beyond */
   unsigned maxentries;    /* maximum number of entries */
   unsigned next_eviction; /* which entry is evicted next */
+  /* statistics - see Connection.cache_stats.  64 bit so they don't
+     wrap on long lived connections */
+  sqlite3_uint64 hits;      /* found in cache */
+  sqlite3_uint64 misses;    /* not found in cache so prepared */
+  sqlite3_uint64 evictions; /* entries removed to make room */
+  sqlite3_uint64 too_big;   /* query text too large to cache */
+  sqlite3_uint64 no_vdbe;   /* prepared to nothing (eg comments) so not cached */
+  sqlite3_uint64 no_cache;  /* cache is disabled (zero size) */
 } StatementCache;
 
 /* we don't bother caching larger than this many bytes */
@@ -88,6 +108,63 @@ statementcache_hasmore(APSWStatement *statement)
   return statement ? (statement->query_size != statement->utf8_size) : 0;
 }
 
+/* where probing for hash starts in the index */
+static unsigned
+statementcache_index_home(StatementCache *sc, Py_hash_t hash)
+{
+  size_t h = (size_t)hash;
+  return (unsigned)(h ^ (h >> 16)) & sc->index_mask;
+}
+
+/* adds the entry at position i of hashes/caches to the index */
+static void
+statementcache_index_add(StatementCache *sc, unsigned i)
+{
+  unsigned pos = statementcache_index_home(sc, sc->hashes[i]);
+
+  while (sc->index[pos])
+    pos = (pos + 1) & sc->index_mask;
+  sc->index[pos] = i + 1;
+}
+
+/* removes index element pos, shifting back any following elements
+   that would otherwise become unreachable */
+static void
+statementcache_index_remove(StatementCache *sc, unsigned pos)
+{
+  unsigned next = pos;
+
+  for (;;)
+  {
+    unsigned home;
+
+    next = (next + 1) & sc->index_mask;
+    if (!sc->index[next])
+      break;
+    home = statementcache_index_home(sc, sc->hashes[sc->index[next] - 1]);
+    /* can the element at next stay where it is? (home cyclically in (pos, next]) */
+    if ((pos <= next) ? (pos < home && home <= next) : (pos < home || home <= next))
+      continue;
+    sc->index[pos] = sc->index[next];
+    pos = next;
+  }
+  sc->index[pos] = 0;
+}
+
+/* returns the index element for the entry at position i of hashes/caches */
+static unsigned
+statementcache_index_find(StatementCache *sc, unsigned i)
+{
+  unsigned pos = statementcache_index_home(sc, sc->hashes[i]);
+
+  while (sc->index[pos] != i + 1)
+  {
+    assert(sc->index[pos]);
+    pos = (pos + 1) & sc->index_mask;
+  }
+  return pos;
+}
+
 /* completely done with this statement */
 static int
 statementcache_finalize(StatementCache *sc, APSWStatement *statement)
@@ -106,9 +183,12 @@ statementcache_finalize(StatementCache *sc, APSWStatement *statement)
     {
       assert(sc->hashes[sc->next_eviction] != SC_SENTINEL_HASH);
       evictee = sc->caches[sc->next_eviction];
+      sc->evictions++;
+      statementcache_index_remove(sc, statementcache_index_find(sc, sc->next_eviction));
     }
     sc->hashes[sc->next_eviction] = statement->hash;
     sc->caches[sc->next_eviction] = statement;
+    statementcache_index_add(sc, sc->next_eviction);
     sc->highest_used = Py_MAX(sc->highest_used, sc->next_eviction);
     sc->next_eviction++;
     if (sc->next_eviction == sc->maxentries)
@@ -136,20 +216,24 @@ statementcache_prepare_internal(StatementCache *sc, const char *utf8, Py_ssize_t
   *statement_out = NULL;
   if (sc->maxentries && utf8size < SC_MAX_ITEM_SIZE)
   {
-    unsigned i;
+    unsigned pos, i;
 #ifdef PYPY_VERSION
     hash = utf8size;
 #else
     hash = _Py_HashBytes(utf8, utf8size);
 #endif
-    for (i = 0; i <= sc->highest_used; i++)
+    for (pos = statementcache_index_home(sc, hash); sc->index[pos]; pos = (pos + 1) & sc->index_mask)
     {
+      i = sc->index[pos] - 1;
       if (sc->hashes[i] == hash && sc->caches[i]->utf8_size == utf8size && 0 == memcmp(utf8, sc->caches[i]->utf8, utf8size))
       {
         /* cache hit */
+        statementcache_index_remove(sc, pos);
         sc->hashes[i] = SC_SENTINEL_HASH;
         statement = sc->caches[i];
         sc->caches[i] = NULL;
+        statement->uses++;
+        sc->hits++;
         APSW_FAULT_INJECT(SCClearBindingsFails,
                           PYSQLITE_SC_CALL(res = sqlite3_clear_bindings(statement->vdbestatement)),
                           res = SQLITE_NOMEM);
@@ -164,7 +248,12 @@ statementcache_prepare_internal(StatementCache *sc, const char *utf8, Py_ssize_t
         return res;
       }
     }
+    sc->misses++;
   }
+  else if (!sc->maxentries)
+    sc->no_cache++;
+  else
+    sc->too_big++;
   /* cache miss */
 
   /* Undocumented stuff alert:  if the size passed to sqlite3_prepare
@@ -194,7 +283,11 @@ statementcache_prepare_internal(StatementCache *sc, const char *utf8, Py_ssize_t
   /* comments and some pragmas result in no vdbe, which we shouldn't
      cache either */
   if (!vdbestatement)
+  {
+    if (hash != SC_SENTINEL_HASH)
+      sc->no_vdbe++;
     hash = SC_SENTINEL_HASH;
+  }
 
 #if SC_STATEMENT_RECYCLE_BIN_ENTRIES > 0
   if (apsw_sc_recycle_bin_next)
@@ -216,6 +309,7 @@ statementcache_prepare_internal(StatementCache *sc, const char *utf8, Py_ssize_t
   statement->vdbestatement = vdbestatement;
   statement->query_size = tail - utf8;
   statement->utf8_size = utf8size;
+  statement->uses = 0;
 
   if (!statementcache_hasmore(statement))
   {
@@ -299,10 +393,33 @@ statementcache_free(StatementCache *sc)
         }
     }
     PyMem_Free(sc->caches);
+    PyMem_Free(sc->index);
     PyMem_Free(sc);
   }
 }
 
+/* discards the statements not in use, which is needed when what they
+   were prepared against is replaced without SQLite expiring them (eg
+   virtual table modules) */
+static void
+statementcache_empty(StatementCache *sc)
+{
+  unsigned i;
+
+  if (!sc || !sc->maxentries)
+    return;
+  for (i = 0; i <= sc->highest_used; i++)
+    if (sc->caches[i])
+    {
+      statementcache_free_statement(sc, sc->caches[i]);
+      sc->caches[i] = NULL;
+      sc->hashes[i] = SC_SENTINEL_HASH;
+    }
+  memset(sc->index, 0, (sc->index_mask + 1) * sizeof(unsigned));
+  sc->highest_used = 0;
+  sc->next_eviction = 0;
+}
+
 static StatementCache *
 statementcache_init(sqlite3 *db, unsigned size)
 {
@@ -310,20 +427,29 @@ statementcache_init(sqlite3 *db, unsigned size)
   APSW_FAULT_INJECT(StatementCacheAllocFails, res = (StatementCache *)PyMem_Malloc(sizeof(StatementCache)), res = NULL);
   if (res)
   {
+    unsigned indexsize = 1;
+
+    /* keep the index at most half full */
+    while (indexsize < 2 * size)
+      indexsize *= 2;
+
     res->hashes = size ? PyMem_Calloc(size, sizeof(Py_hash_t)) : 0;
     res->caches = size ? PyMem_Calloc(size, sizeof(APSWStatement *)) : 0;
+    res->index = size ? PyMem_Calloc(indexsize, sizeof(unsigned)) : 0;
+    res->index_mask = indexsize - 1;
     res->highest_used = 0;
     res->maxentries = size;
     res->next_eviction = 0;
     res->db = db;
+    res->hits = res->misses = res->evictions = res->too_big = res->no_vdbe = res->no_cache = 0;
     if (res->hashes)
     {
       unsigned i;
-      for (i = 0; i <= res->highest_used; i++)
+      for (i = 0; i < size; i++)
         res->hashes[i] = SC_SENTINEL_HASH;
     }
   }
-  if (!res || (size && !res->hashes) || (size && !res->caches))
+  if (!res || (size && !res->hashes) || (size && !res->caches) || (size && !res->index))
   {
     statementcache_free(res);
     res = NULL;
@@ -332,6 +458,70 @@ statementcache_init(sqlite3 *db, unsigned size)
   return res;
 }
 
+/* how many statements are cached and the memory they use.  Called
+   with the db mutex held */
+static long long
+statementcache_bytes(StatementCache *sc, unsigned *count)
+{
+  long long bytes = 0;
+  unsigned i;
+
+  *count = 0;
+  for (i = 0; sc->maxentries && i <= sc->highest_used; i++)
+    if (sc->caches[i])
+    {
+      bytes += sqlite3_stmt_status(sc->caches[i]->vdbestatement, SQLITE_STMTSTATUS_MEMUSED, 0) + sc->caches[i]->utf8_size;
+      (*count)++;
+    }
+  return bytes;
+}
+
+/* returns a dict of statistics, optionally including details of each entry */
+static PyObject *
+statementcache_stats(StatementCache *sc, int include_entries)
+{
+  PyObject *result = NULL, *entries = NULL, *entry = NULL;
+  unsigned i, count = 0;
+  long long bytes = 0;
+  int res = SQLITE_OK;
+
+  PYSQLITE_SC_CALL(bytes = statementcache_bytes(sc, &count));
+
+  result = Py_BuildValue("{s: I, s: I, s: K, s: K, s: K, s: K, s: K, s: K, s: L}",
+                         "size", sc->maxentries, "count", count, "hits", sc->hits, "misses", sc->misses,
+                         "evictions", sc->evictions, "too_big", sc->too_big, "no_vdbe", sc->no_vdbe,
+                         "no_cache", sc->no_cache, "bytes", bytes);
+  if (!result || !include_entries)
+    return result;
+
+  entries = PyList_New(0);
+  if (!entries)
+    goto error;
+
+  for (i = 0; sc->maxentries && i <= sc->highest_used; i++)
+    if (sc->caches[i])
+    {
+      APSWStatement *statement = sc->caches[i];
+      entry = Py_BuildValue("{s: s#, s: O, s: K}", "query", statement->utf8, statement->utf8_size,
+                            "has_more", statementcache_hasmore(statement) ? Py_True : Py_False,
+                            "uses", statement->uses);
+      if (!entry || PyList_Append(entries, entry))
+        goto error;
+      Py_CLEAR(entry);
+    }
+
+  if (PyDict_SetItemString(result, "entries", entries))
+    goto error;
+  Py_DECREF(entries);
+  return result;
+
+error:
+  Py_XDECREF(entry);
+  Py_XDECREF(entries);
+  Py_DECREF(result);
+  return NULL;
+}
+
 #ifdef APSW_TESTFIXTURES
 static void
 statementcache_fini(void)
@@ -83,9 +83,13 @@
 /* call from backup code */
 #define PYSQLITE_BACKUP_CALL(y) INUSE_CALL(_PYSQLITE_CALL_E(self->dest->db, y))
 
+/* call from session code - same as blob */
+#define PYSQLITE_SESSION_CALL PYSQLITE_BLOB_CALL
+
 /* used to decide if we will use int (4 bytes) or long long (8 bytes) */
 #define APSW_INT32_MIN (-2147483647 - 1)
 #define APSW_INT32_MAX 2147483647
+#define APSW_INT64_MAX 9223372036854775807LL
 
 /*
    The default Python PyErr_WriteUnraiseable is almost useless.  It
@@ -218,6 +218,18 @@ typedef struct /* inherits */
 {
   const struct sqlite3_io_methods *pMethods; /* structure sqlite needs */
   PyObject *file;
+  /* pMethods points here when some methods go straight to the base
+     file because the Python file object doesn't override them */
+  struct sqlite3_io_methods methods;
+  unsigned int version_tag; /* of the Python file object type when methods was filled in */
+  int readinto;             /* the Python file object provides its own xReadInto */
+  /* buffers returned by the Python xFetch that SQLite hasn't unfetched yet */
+  struct
+  {
+    sqlite3_int64 offset;
+    Py_buffer view;
+  } * fetches;
+  int nfetches, allocfetches;
 } APSWSQLite3File;
 
 /* this is only used if there is inheritance */
@@ -242,6 +254,11 @@ static PyTypeObject APSWURIFilenameType;
 
 static const struct sqlite3_io_methods apsw_io_methods_v1;
 static const struct sqlite3_io_methods apsw_io_methods_v2;
+static const struct sqlite3_io_methods apsw_io_methods_v3;
+static int apswvfsfile_inherits(PyObject *file, const char *name, PyCFunction impl);
+static PyObject *apswvfsfilepy_xFetch(APSWVFSFile *self, PyObject *args, PyObject *kwds);
+static void apswvfsfile_set_passthrough(APSWSQLite3File *apswfile, PyObject *file);
+static const struct sqlite3_io_methods *apswvfsfile_refresh_passthrough(APSWSQLite3File *apswfile);
 
 typedef struct
 {
@@ -549,13 +566,17 @@ apswvfs_xOpen(sqlite3_vfs *vfs, const char *zName, sqlite3_file *file, int infla
   /* If we are inheriting from another file object, and that file
      object supports version 2 io_methods (Shm* family of functions)
      then we need to allocate an io_methods dupe of our own and fill
-     in their shm methods. */
+     in their shm methods.  Version 3 (memory mapping) is also used if
+     the base file does it, or the Python file has its own xFetch. */
   if (PyObject_IsInstance(pyresult, (PyObject *)&APSWVFSFileType))
   {
     APSWVFSFile *f = (APSWVFSFile *)pyresult;
     if (!f->base || !f->base->pMethods || !f->base->pMethods->xShmMap)
       goto version1;
-    apswfile->pMethods = &apsw_io_methods_v2;
+    if ((f->base->pMethods->iVersion >= 3 && f->base->pMethods->xFetch) || !apswvfsfile_inherits(pyresult, "xFetch", (PyCFunction)apswvfsfilepy_xFetch))
+      apswfile->pMethods = &apsw_io_methods_v3;
+    else
+      apswfile->pMethods = &apsw_io_methods_v2;
   }
   else
   {
@@ -563,6 +584,10 @@ apswvfs_xOpen(sqlite3_vfs *vfs, const char *zName, sqlite3_file *file, int infla
     apswfile->pMethods = &apsw_io_methods_v1;
   }
 
+  apswfile->fetches = NULL;
+  apswfile->nfetches = apswfile->allocfetches = 0;
+  apswvfsfile_set_passthrough(apswfile, pyresult);
+
   apswfile->file = pyresult;
   pyresult = NULL;
   result = SQLITE_OK;
@@ -1954,6 +1979,53 @@ finally:
   return res;
 }
 
+/* reads via xReadInto with a memoryview directly over SQLite's buffer */
+static int
+apswvfsfile_readinto(APSWSQLite3File *apswfile, void *bufout, int amount, sqlite3_int64 offset)
+{
+  int result = SQLITE_ERROR;
+  long nread = -1;
+  PyObject *view = NULL, *pyresult = NULL, *released = NULL;
+
+  view = PyMemoryView_FromMemory(bufout, amount, PyBUF_WRITE);
+  if (!view)
+    goto finally;
+
+  pyresult = Call_PythonMethodV(apswfile->file, "xReadInto", 1, "(OL)", view, offset);
+  /* the memory belongs to SQLite so the view must not outlive this call */
+  released = PyObject_CallMethod(view, "release", NULL);
+  if (!pyresult || !released)
+    goto finally;
+
+  if (!PyLong_Check(pyresult))
+    PyErr_Format(PyExc_TypeError, "xReadInto should return an int");
+  else
+    nread = PyLong_AsLong(pyresult);
+  if (!PyErr_Occurred() && (nread < 0 || nread > amount))
+    PyErr_Format(PyExc_ValueError, "xReadInto should return the number of bytes read, between zero and the buffer length");
+  if (PyErr_Occurred())
+    goto finally;
+
+  if (nread < amount)
+  {
+    result = SQLITE_IOERR_SHORT_READ;
+    memset((char *)bufout + nread, 0, amount - nread);
+  }
+  else
+    result = SQLITE_OK;
+
+finally:
+  if (PyErr_Occurred())
+  {
+    result = MakeSqliteMsgFromPyException(NULL);
+    AddTraceBackHere(__FILE__, __LINE__, "apswvfsfile_readinto", "{s: i, s: L, s: O}", "amount", amount, "offset", offset, "result", OBJ(pyresult));
+  }
+  Py_XDECREF(released);
+  Py_XDECREF(pyresult);
+  Py_XDECREF(view);
+  return result;
+}
+
 static int
 apswvfsfile_xRead(sqlite3_file *file, void *bufout, int amount, sqlite3_int64 offset)
 {
@@ -1964,6 +2036,14 @@ apswvfsfile_xRead(sqlite3_file *file, void *bufout, int amount, sqlite3_int64 of
 
   FILEPREAMBLE;
 
+  if (Py_TYPE(apswfile->file)->tp_version_tag != apswfile->version_tag)
+    apswvfsfile_refresh_passthrough(apswfile);
+  if (apswfile->readinto)
+  {
+    result = apswvfsfile_readinto(apswfile, bufout, amount, offset);
+    goto finally;
+  }
+
   pybuf = Call_PythonMethodV(apswfile->file, "xRead", 1, "(iL)", amount, offset);
   if (!pybuf)
   {
@@ -2017,6 +2097,9 @@ finally:
     remaining data. Except for empty files SQLite considers short
     reads to be a fatal error.
 
+    If you provide :meth:`xReadInto` then it is used instead of this
+    method.
+
     :param amount: Number of bytes to read
     :param offset: Where to start reading. This number may be 64 bit once the database is larger than 2GB.
 */
@@ -2064,6 +2147,71 @@ apswvfsfilepy_xRead(APSWVFSFile *self, PyObject *args, PyObject *kwds)
   return NULL;
 }
 
+/** .. method:: xReadInto(buffer: Union[bytearray, array[Any], memoryview], offset: int) -> int
+
+    Read into *buffer* starting at *offset*, returning how many bytes
+    were read.  If your class provides this method then SQLite's reads
+    come here instead of :meth:`xRead`, with *buffer* being a writable
+    memoryview directly over SQLite's own memory.  Filling it in place
+    avoids allocating a bytes object for every read, and the copy
+    from it.  Returning less than the length of the buffer is a short
+    read, which SQLite only expects at the end of the file.
+
+    The memoryview is released when you return, so you must not keep
+    it.  The default implementation reads from the file you inherit
+    from, so you can call it and then adjust the data in place.
+
+    :param buffer: A writable buffer like object of the size to read
+    :param offset: Where to start reading. This number may be 64 bit once the database is larger than 2GB.
+*/
+static PyObject *
+apswvfsfilepy_xReadInto(APSWVFSFile *self, PyObject *args, PyObject *kwds)
+{
+  sqlite3_int64 offset;
+  int res;
+  Py_ssize_t amount;
+  PyObject *buffer = NULL;
+  Py_buffer py3buffer;
+
+  CHECKVFSFILEPY;
+  VFSFILENOTIMPLEMENTED(xRead, 1);
+
+  {
+    static char *kwlist[] = {"buffer", "offset", NULL};
+    VFSFile_xReadInto_CHECK;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "OL:" VFSFile_xReadInto_USAGE, kwlist, &buffer, &offset))
+      return NULL;
+  }
+
+  if (PyObject_GetBuffer(buffer, &py3buffer, PyBUF_WRITABLE | PyBUF_SIMPLE))
+    return NULL;
+
+  amount = py3buffer.len;
+  if (amount > APSW_INT32_MAX)
+  {
+    PyBuffer_Release(&py3buffer);
+    return PyErr_Format(PyExc_ValueError, "buffer is too large");
+  }
+
+  res = self->base->pMethods->xRead(self->base, py3buffer.buf, (int)amount, offset);
+
+  if (res == SQLITE_IOERR_SHORT_READ)
+  {
+    /* as for xRead we have to look for the first non-trailing null
+       byte to know how much was read */
+    while (amount && ((char *)py3buffer.buf)[amount - 1] == 0)
+      amount--;
+    res = SQLITE_OK;
+  }
+  PyBuffer_Release(&py3buffer);
+
+  if (res == SQLITE_OK)
+    return PyLong_FromSsize_t(amount);
+
+  SET_EXC(res, NULL);
+  return NULL;
+}
+
 static int
 apswvfsfile_xWrite(sqlite3_file *file, const void *buffer, int amount, sqlite3_int64 offset)
 {
@@ -2635,6 +2783,201 @@ apswvfsfilepy_xFileControl(APSWVFSFile *self, PyObject *args, PyObject *kwds)
   return NULL;
 }
 
+static int
+apswvfsfile_xFetch(sqlite3_file *file, sqlite3_int64 offset, int amount, void **pp)
+{
+  int result = SQLITE_OK;
+  PyObject *pyresult = NULL;
+  Py_buffer view;
+  FILEPREAMBLE;
+
+  *pp = NULL;
+
+  /* An inherited xFetch maps the base file, which is only right if
+     the base file is also what xRead reads */
+  if (apswvfsfile_inherits(apswfile->file, "xFetch", (PyCFunction)apswvfsfilepy_xFetch))
+  {
+    APSWVFSFile *f = (APSWVFSFile *)apswfile->file;
+    if (apswfile->readinto || !apswvfsfile_inherits(apswfile->file, "xRead", (PyCFunction)apswvfsfilepy_xRead) || !f->base || f->base->pMethods->iVersion < 3 || !f->base->pMethods->xFetch)
+      goto finally;
+  }
+
+  pyresult = Call_PythonMethodV(apswfile->file, "xFetch", 1, "(Li)", offset, amount);
+  if (!pyresult || pyresult == Py_None)
+    goto finally;
+
+  if (PyObject_GetBuffer(pyresult, &view, PyBUF_SIMPLE))
+    goto finally;
+  if (view.len < amount)
+  {
+    PyBuffer_Release(&view);
+    PyErr_Format(PyExc_ValueError, "xFetch returned %zd bytes but %d were asked for", view.len, amount);
+    goto finally;
+  }
+
+  if (apswfile->nfetches == apswfile->allocfetches)
+  {
+    void *fetches = PyMem_Realloc(apswfile->fetches, sizeof(apswfile->fetches[0]) * (apswfile->allocfetches + 8));
+    if (!fetches)
+    {
+      PyBuffer_Release(&view);
+      PyErr_NoMemory();
+      goto finally;
+    }
+    apswfile->fetches = fetches;
+    apswfile->allocfetches += 8;
+  }
+  apswfile->fetches[apswfile->nfetches].offset = offset;
+  apswfile->fetches[apswfile->nfetches].view = view;
+  apswfile->nfetches++;
+  *pp = view.buf;
+
+finally:
+  if (PyErr_Occurred())
+  {
+    result = MakeSqliteMsgFromPyException(NULL);
+    AddTraceBackHere(__FILE__, __LINE__, "apswvfsfile_xFetch", "{s: L, s: i, s: O}", "offset", offset, "amount", amount, "result", OBJ(pyresult));
+  }
+  Py_XDECREF(pyresult);
+  FILEPOSTAMBLE;
+  return result;
+}
+
+/** .. method:: xFetch(offset: int, amount: int) -> Any
+
+    Return memory containing *amount* bytes of the file starting at
+    *offset*, which SQLite reads pages from directly instead of calling
+    :meth:`xRead`.  It is only used if the `mmap_size pragma
+    <https://sqlite.org/pragma.html#pragma_mmap_size>`__ is set.  You
+    can return any object supporting the buffer protocol such as
+    :class:`mmap.mmap` or :class:`memoryview`, or None if the memory
+    isn't available in which case SQLite uses :meth:`xRead`.
+
+    The contents must not change until :meth:`xUnfetch` is called for
+    it.  The default implementation returns a :class:`memoryview` of
+    the memory mapped by the file you inherit from (or None), which
+    is only valid until then.  If you don't override this, nor
+    :meth:`xRead`, then SQLite goes directly to the inherited file
+    without calling Python.
+
+    :param offset: Where the memory starts in the file.  This number may be 64 bit once the database is larger than 2GB.
+    :param amount: How many bytes are needed
+*/
+static PyObject *
+apswvfsfilepy_xFetch(APSWVFSFile *self, PyObject *args, PyObject *kwds)
+{
+  sqlite3_int64 offset;
+  int amount, res;
+  void *p = NULL;
+
+  CHECKVFSFILEPY;
+  VFSFILENOTIMPLEMENTED(xFetch, 3);
+
+  {
+    static char *kwlist[] = {"offset", "amount", NULL};
+    VFSFile_xFetch_CHECK;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "Li:" VFSFile_xFetch_USAGE, kwlist, &offset, &amount))
+      return NULL;
+  }
+
+  res = self->base->pMethods->xFetch(self->base, offset, amount, &p);
+  if (res != SQLITE_OK)
+  {
+    SET_EXC(res, NULL);
+    return NULL;
+  }
+  if (!p)
+    Py_RETURN_NONE;
+  return PyMemoryView_FromMemory(p, amount, PyBUF_READ);
+}
+
+static int
+apswvfsfile_xUnfetch(sqlite3_file *file, sqlite3_int64 offset, void *p)
+{
+  int result = SQLITE_OK, i;
+  PyObject *pyresult = NULL;
+  FILEPREAMBLE;
+
+  for (i = 0; p && i < apswfile->nfetches; i++)
+    if (apswfile->fetches[i].view.buf == p)
+      break;
+
+  if (p && i == apswfile->nfetches)
+  {
+    /* it came directly from the base file */
+    APSWVFSFile *f = (APSWVFSFile *)apswfile->file;
+    if (PyObject_TypeCheck(apswfile->file, &APSWVFSFileType) && f->base)
+      result = f->base->pMethods->xUnfetch(f->base, offset, p);
+    goto finally;
+  }
+
+  pyresult = Call_PythonMethodV(apswfile->file, "xUnfetch", 1, "(LO)", offset, p ? apswfile->fetches[i].view.obj : Py_None);
+  if (p)
+  {
+    PyBuffer_Release(&apswfile->fetches[i].view);
+    apswfile->fetches[i] = apswfile->fetches[--apswfile->nfetches];
+  }
+  if (PyErr_Occurred())
+  {
+    result = MakeSqliteMsgFromPyException(NULL);
+    AddTraceBackHere(__FILE__, __LINE__, "apswvfsfile_xUnfetch", "{s: L, s: O}", "offset", offset, "result", OBJ(pyresult));
+  }
+
+finally:
+  Py_XDECREF(pyresult);
+  FILEPOSTAMBLE;
+  return result;
+}
+
+/** .. method:: xUnfetch(offset: int, buffer: Any) -> None
+
+    SQLite has finished with memory returned by :meth:`xFetch`, which
+    is passed as *buffer*.  If *buffer* is None then SQLite is
+    suggesting that any memory mapping be discarded, which it does for
+    example when the file is about to be truncated.
+
+    The default implementation gives the memory back to the file you
+    inherit from, so you should override this if your :meth:`xFetch`
+    returns memory from anywhere else.
+
+    :param offset: The offset *buffer* was fetched for
+    :param buffer: What :meth:`xFetch` returned, or None
+*/
+static PyObject *
+apswvfsfilepy_xUnfetch(APSWVFSFile *self, PyObject *args, PyObject *kwds)
+{
+  sqlite3_int64 offset;
+  PyObject *buffer = NULL;
+  Py_buffer view;
+  int res;
+
+  CHECKVFSFILEPY;
+  VFSFILENOTIMPLEMENTED(xUnfetch, 3);
+
+  {
+    static char *kwlist[] = {"offset", "buffer", NULL};
+    VFSFile_xUnfetch_CHECK;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "LO:" VFSFile_xUnfetch_USAGE, kwlist, &offset, &buffer))
+      return NULL;
+  }
+
+  if (buffer == Py_None)
+    res = self->base->pMethods->xUnfetch(self->base, offset, NULL);
+  else
+  {
+    if (PyObject_GetBuffer(buffer, &view, PyBUF_SIMPLE))
+      return NULL;
+    res = self->base->pMethods->xUnfetch(self->base, offset, view.buf);
+    PyBuffer_Release(&view);
+  }
+
+  if (res == SQLITE_OK)
+    Py_RETURN_NONE;
+
+  SET_EXC(res, NULL);
+  return NULL;
+}
+
 static int
 apswvfsfile_xClose(sqlite3_file *file)
 {
@@ -2651,6 +2994,13 @@ apswvfsfile_xClose(sqlite3_file *file)
   if (PyErr_Occurred())
     AddTraceBackHere(__FILE__, __LINE__, "apswvfsfile.xClose", NULL);
 
+  /* SQLite unfetches everything before closing so this is only in case */
+  while (apswfile->nfetches)
+    PyBuffer_Release(&apswfile->fetches[--apswfile->nfetches].view);
+  PyMem_Free(apswfile->fetches);
+  apswfile->fetches = NULL;
+  apswfile->allocfetches = 0;
+
   Py_XDECREF(apswfile->file);
   apswfile->file = NULL;
   Py_XDECREF(pyresult);
@@ -2723,82 +3073,315 @@ apswproxyxShmUnmap(sqlite3_file *file, int deleteFlag)
   return f->base->pMethods->xShmUnmap(f->base, deleteFlag);
 }
 
-static const struct sqlite3_io_methods apsw_io_methods_v1 =
-    {
-        1,                                  /* version */
-        apswvfsfile_xClose,                 /* close */
-        apswvfsfile_xRead,                  /* read */
-        apswvfsfile_xWrite,                 /* write */
-        apswvfsfile_xTruncate,              /* truncate */
-        apswvfsfile_xSync,                  /* sync */
-        apswvfsfile_xFileSize,              /* filesize */
-        apswvfsfile_xLock,                  /* lock */
-        apswvfsfile_xUnlock,                /* unlock */
-        apswvfsfile_xCheckReservedLock,     /* checkreservedlock */
-        apswvfsfile_xFileControl,           /* filecontrol */
-        apswvfsfile_xSectorSize,            /* sectorsize */
-        apswvfsfile_xDeviceCharacteristics, /* device characteristics */
-        0,                                  /* shmmap */
-        0,                                  /* shmlock */
-        0,                                  /* shmbarrier */
-        0                                   /* shmunmap */
-};
+/* These are used for the methods a Python file object inherits from
+   VFSFile without overriding, so SQLite calls the base file directly
+   without needing the GIL or going through Python.  If the class of
+   the file object has been changed since then the methods are worked
+   out again. */
+#define APSWPROXYSTALE (Py_TYPE(f)->tp_version_tag != apswfile->version_tag)
 
-static const struct sqlite3_io_methods apsw_io_methods_v2 =
-    {
-        2,                                  /* version */
-        apswvfsfile_xClose,                 /* close */
-        apswvfsfile_xRead,                  /* read */
-        apswvfsfile_xWrite,                 /* write */
-        apswvfsfile_xTruncate,              /* truncate */
-        apswvfsfile_xSync,                  /* sync */
-        apswvfsfile_xFileSize,              /* filesize */
-        apswvfsfile_xLock,                  /* lock */
-        apswvfsfile_xUnlock,                /* unlock */
-        apswvfsfile_xCheckReservedLock,     /* checkreservedlock */
-        apswvfsfile_xFileControl,           /* filecontrol */
-        apswvfsfile_xSectorSize,            /* sectorsize */
-        apswvfsfile_xDeviceCharacteristics, /* device characteristics */
-        apswproxyxShmMap,                   /* shmmap */
-        apswproxyxShmLock,                  /* shmlock */
-        apswproxyxShmBarrier,               /* shmbarrier */
-        apswproxyxShmUnmap                  /* shmunmap */
-};
+static int
+apswproxyxRead(sqlite3_file *file, void *bufout, int amount, sqlite3_int64 offset)
+{
+  APSWPROXYBASE;
+  if (APSWPROXYSTALE)
+    return apswvfsfile_refresh_passthrough(apswfile)->xRead(file, bufout, amount, offset);
+  return f->base->pMethods->xRead(f->base, bufout, amount, offset);
+}
 
-static PyMethodDef APSWVFSFile_methods[] = {
-    {"xRead", (PyCFunction)apswvfsfilepy_xRead, METH_VARARGS | METH_KEYWORDS, VFSFile_xRead_DOC},
-    {"xUnlock", (PyCFunction)apswvfsfilepy_xUnlock, METH_VARARGS | METH_KEYWORDS, VFSFile_xUnlock_DOC},
-    {"xLock", (PyCFunction)apswvfsfilepy_xLock, METH_VARARGS | METH_KEYWORDS, VFSFile_xLock_DOC},
-    {"xClose", (PyCFunction)apswvfsfilepy_xClose, METH_NOARGS, VFSFile_xClose_DOC},
-    {"xSectorSize", (PyCFunction)apswvfsfilepy_xSectorSize, METH_NOARGS, VFSFile_xSectorSize_DOC},
-    {"xFileSize", (PyCFunction)apswvfsfilepy_xFileSize, METH_NOARGS, VFSFile_xFileSize_DOC},
-    {"xDeviceCharacteristics", (PyCFunction)apswvfsfilepy_xDeviceCharacteristics, METH_NOARGS, VFSFile_xDeviceCharacteristics_DOC},
-    {"xCheckReservedLock", (PyCFunction)apswvfsfilepy_xCheckReservedLock, METH_NOARGS, VFSFile_xCheckReservedLock_DOC},
-    {"xWrite", (PyCFunction)apswvfsfilepy_xWrite, METH_VARARGS | METH_KEYWORDS, VFSFile_xWrite_DOC},
-    {"xSync", (PyCFunction)apswvfsfilepy_xSync, METH_VARARGS | METH_KEYWORDS, VFSFile_xSync_DOC},
-    {"xTruncate", (PyCFunction)apswvfsfilepy_xTruncate, METH_VARARGS | METH_KEYWORDS, VFSFile_xTruncate_DOC},
-    {"xFileControl", (PyCFunction)apswvfsfilepy_xFileControl, METH_VARARGS | METH_KEYWORDS, VFSFile_xFileControl_DOC},
-    {"excepthook", (PyCFunction)apswvfs_excepthook, METH_VARARGS, VFSFile_excepthook_DOC},
-    /* Sentinel */
-    {0, 0, 0, 0}};
+static int
+apswproxyxWrite(sqlite3_file *file, const void *buffer, int amount, sqlite3_int64 offset)
+{
+  APSWPROXYBASE;
+  if (APSWPROXYSTALE)
+    return apswvfsfile_refresh_passthrough(apswfile)->xWrite(file, buffer, amount, offset);
+  return f->base->pMethods->xWrite(f->base, buffer, amount, offset);
+}
 
-static PyTypeObject APSWVFSFileType =
-    {
-        PyVarObject_HEAD_INIT(NULL, 0) "apsw.VFSFile",                          /*tp_name*/
-        sizeof(APSWVFSFile),                                                    /*tp_basicsize*/
-        0,                                                                      /*tp_itemsize*/
-        (destructor)APSWVFSFile_dealloc,                                        /*tp_dealloc*/
-        0,                                                                      /*tp_print*/
-        0,                                                                      /*tp_getattr*/
-        0,                                                                      /*tp_setattr*/
-        0,                                                                      /*tp_compare*/
-        0,                                                                      /*tp_repr*/
-        0,                                                                      /*tp_as_number*/
-        0,                                                                      /*tp_as_sequence*/
-        0,                                                                      /*tp_as_mapping*/
-        0,                                                                      /*tp_hash */
-        0,                                                                      /*tp_call*/
-        0,                                                                      /*tp_str*/
+static int
+apswproxyxTruncate(sqlite3_file *file, sqlite3_int64 size)
+{
+  APSWPROXYBASE;
+  if (APSWPROXYSTALE)
+    return apswvfsfile_refresh_passthrough(apswfile)->xTruncate(file, size);
+  return f->base->pMethods->xTruncate(f->base, size);
+}
+
+static int
+apswproxyxSync(sqlite3_file *file, int flags)
+{
+  APSWPROXYBASE;
+  if (APSWPROXYSTALE)
+    return apswvfsfile_refresh_passthrough(apswfile)->xSync(file, flags);
+  return f->base->pMethods->xSync(f->base, flags);
+}
+
+static int
+apswproxyxFileSize(sqlite3_file *file, sqlite3_int64 *pSize)
+{
+  APSWPROXYBASE;
+  if (APSWPROXYSTALE)
+    return apswvfsfile_refresh_passthrough(apswfile)->xFileSize(file, pSize);
+  return f->base->pMethods->xFileSize(f->base, pSize);
+}
+
+static int
+apswproxyxLock(sqlite3_file *file, int flag)
+{
+  APSWPROXYBASE;
+  if (APSWPROXYSTALE)
+    return apswvfsfile_refresh_passthrough(apswfile)->xLock(file, flag);
+  return f->base->pMethods->xLock(f->base, flag);
+}
+
+static int
+apswproxyxUnlock(sqlite3_file *file, int flag)
+{
+  APSWPROXYBASE;
+  if (APSWPROXYSTALE)
+    return apswvfsfile_refresh_passthrough(apswfile)->xUnlock(file, flag);
+  return f->base->pMethods->xUnlock(f->base, flag);
+}
+
+static int
+apswproxyxCheckReservedLock(sqlite3_file *file, int *pResOut)
+{
+  APSWPROXYBASE;
+  if (APSWPROXYSTALE)
+    return apswvfsfile_refresh_passthrough(apswfile)->xCheckReservedLock(file, pResOut);
+  return f->base->pMethods->xCheckReservedLock(f->base, pResOut);
+}
+
+static int
+apswproxyxFileControl(sqlite3_file *file, int op, void *pArg)
+{
+  APSWPROXYBASE;
+  if (APSWPROXYSTALE)
+    return apswvfsfile_refresh_passthrough(apswfile)->xFileControl(file, op, pArg);
+  return f->base->pMethods->xFileControl(f->base, op, pArg);
+}
+
+static int
+apswproxyxSectorSize(sqlite3_file *file)
+{
+  APSWPROXYBASE;
+  if (APSWPROXYSTALE)
+    return apswvfsfile_refresh_passthrough(apswfile)->xSectorSize(file);
+  return f->base->pMethods->xSectorSize(f->base);
+}
+
+static int
+apswproxyxDeviceCharacteristics(sqlite3_file *file)
+{
+  APSWPROXYBASE;
+  if (APSWPROXYSTALE)
+    return apswvfsfile_refresh_passthrough(apswfile)->xDeviceCharacteristics(file);
+  return f->base->pMethods->xDeviceCharacteristics(f->base);
+}
+
+static int
+apswproxyxFetch(sqlite3_file *file, sqlite3_int64 offset, int amount, void **pp)
+{
+  APSWPROXYBASE;
+  if (APSWPROXYSTALE)
+    return apswvfsfile_refresh_passthrough(apswfile)->xFetch(file, offset, amount, pp);
+  return f->base->pMethods->xFetch(f->base, offset, amount, pp);
+}
+
+static int
+apswproxyxUnfetch(sqlite3_file *file, sqlite3_int64 offset, void *p)
+{
+  APSWPROXYBASE;
+  /* anything still fetched through Python has to be given back there */
+  if (apswfile->nfetches)
+    return apswvfsfile_xUnfetch(file, offset, p);
+  return f->base->pMethods->xUnfetch(f->base, offset, p);
+}
+
+/* returns true if attribute name of file is the VFSFile method
+   implemented by impl, rather than something from a subclass or the
+   instance */
+static int
+apswvfsfile_inherits(PyObject *file, const char *name, PyCFunction impl)
+{
+  int res;
+  PyObject *meth = PyObject_GetAttrString(file, name);
+
+  res = meth && PyCFunction_Check(meth) && PyCFunction_GET_FUNCTION(meth) == impl && PyCFunction_GET_SELF(meth) == file;
+  Py_XDECREF(meth);
+  PyErr_Clear();
+  return res;
+}
+
+/* Python file objects only opt in to the methods they override.  The
+   rest are called directly on the base file.  Changes to the class are
+   noticed via its version tag, but methods set on the instance itself
+   are only looked for when the file is opened. */
+static void
+apswvfsfile_set_passthrough(APSWSQLite3File *apswfile, PyObject *file)
+{
+  int proxied = 0, isvfsfile;
+
+  apswfile->methods = *apswfile->pMethods;
+  isvfsfile = PyObject_IsInstance(file, (PyObject *)&APSWVFSFileType) == 1 && ((APSWVFSFile *)file)->base;
+  apswfile->readinto = PyObject_HasAttrString(file, "xReadInto") && !apswvfsfile_inherits(file, "xReadInto", (PyCFunction)apswvfsfilepy_xReadInto);
+  PyErr_Clear();
+
+#define PASSTHROUGH(meth)                                                                \
+  if (isvfsfile && apswvfsfile_inherits(file, #meth, (PyCFunction)apswvfsfilepy_##meth)) \
+  {                                                                                      \
+    apswfile->methods.meth = apswproxy##meth;                                            \
+    proxied = 1;                                                                         \
+  }
+
+  if (!apswfile->readinto)
+    PASSTHROUGH(xRead);
+  PASSTHROUGH(xWrite);
+  PASSTHROUGH(xTruncate);
+  PASSTHROUGH(xSync);
+  PASSTHROUGH(xFileSize);
+  PASSTHROUGH(xLock);
+  PASSTHROUGH(xUnlock);
+  PASSTHROUGH(xCheckReservedLock);
+  PASSTHROUGH(xFileControl);
+  PASSTHROUGH(xSectorSize);
+  PASSTHROUGH(xDeviceCharacteristics);
+#undef PASSTHROUGH
+
+  /* mapped memory is read instead of calling xRead so the base file
+     can only provide it when xRead also goes there */
+  if (isvfsfile && apswfile->methods.iVersion >= 3 && apswfile->methods.xRead == apswproxyxRead && ((APSWVFSFile *)file)->base->pMethods->iVersion >= 3 && ((APSWVFSFile *)file)->base->pMethods->xFetch && apswvfsfile_inherits(file, "xFetch", (PyCFunction)apswvfsfilepy_xFetch) && apswvfsfile_inherits(file, "xUnfetch", (PyCFunction)apswvfsfilepy_xUnfetch))
+  {
+    apswfile->methods.xFetch = apswproxyxFetch;
+    apswfile->methods.xUnfetch = apswproxyxUnfetch;
+  }
+
+  /* without a version tag changes to the class can't be detected */
+  apswfile->version_tag = Py_TYPE(file)->tp_version_tag;
+  if (proxied && apswfile->version_tag)
+    apswfile->pMethods = &apswfile->methods;
+}
+
+static const struct sqlite3_io_methods *
+apswvfsfile_refresh_passthrough(APSWSQLite3File *apswfile)
+{
+  PyObject *etype, *eval, *etb;
+  PyGILState_STATE gilstate;
+
+  gilstate = PyGILState_Ensure();
+  PyErr_Fetch(&etype, &eval, &etb);
+  if (apswfile->methods.iVersion >= 3)
+    apswfile->pMethods = &apsw_io_methods_v3;
+  else
+    apswfile->pMethods = (apswfile->methods.iVersion >= 2) ? &apsw_io_methods_v2 : &apsw_io_methods_v1;
+  apswvfsfile_set_passthrough(apswfile, apswfile->file);
+  PyErr_Restore(etype, eval, etb);
+  PyGILState_Release(gilstate);
+  return apswfile->pMethods;
+}
+
+static const struct sqlite3_io_methods apsw_io_methods_v1 =
+    {
+        1,                                  /* version */
+        apswvfsfile_xClose,                 /* close */
+        apswvfsfile_xRead,                  /* read */
+        apswvfsfile_xWrite,                 /* write */
+        apswvfsfile_xTruncate,              /* truncate */
+        apswvfsfile_xSync,                  /* sync */
+        apswvfsfile_xFileSize,              /* filesize */
+        apswvfsfile_xLock,                  /* lock */
+        apswvfsfile_xUnlock,                /* unlock */
+        apswvfsfile_xCheckReservedLock,     /* checkreservedlock */
+        apswvfsfile_xFileControl,           /* filecontrol */
+        apswvfsfile_xSectorSize,            /* sectorsize */
+        apswvfsfile_xDeviceCharacteristics, /* device characteristics */
+        0,                                  /* shmmap */
+        0,                                  /* shmlock */
+        0,                                  /* shmbarrier */
+        0                                   /* shmunmap */
+};
+
+static const struct sqlite3_io_methods apsw_io_methods_v2 =
+    {
+        2,                                  /* version */
+        apswvfsfile_xClose,                 /* close */
+        apswvfsfile_xRead,                  /* read */
+        apswvfsfile_xWrite,                 /* write */
+        apswvfsfile_xTruncate,              /* truncate */
+        apswvfsfile_xSync,                  /* sync */
+        apswvfsfile_xFileSize,              /* filesize */
+        apswvfsfile_xLock,                  /* lock */
+        apswvfsfile_xUnlock,                /* unlock */
+        apswvfsfile_xCheckReservedLock,     /* checkreservedlock */
+        apswvfsfile_xFileControl,           /* filecontrol */
+        apswvfsfile_xSectorSize,            /* sectorsize */
+        apswvfsfile_xDeviceCharacteristics, /* device characteristics */
+        apswproxyxShmMap,                   /* shmmap */
+        apswproxyxShmLock,                  /* shmlock */
+        apswproxyxShmBarrier,               /* shmbarrier */
+        apswproxyxShmUnmap                  /* shmunmap */
+};
+
+static const struct sqlite3_io_methods apsw_io_methods_v3 =
+    {
+        3,                                  /* version */
+        apswvfsfile_xClose,                 /* close */
+        apswvfsfile_xRead,                  /* read */
+        apswvfsfile_xWrite,                 /* write */
+        apswvfsfile_xTruncate,              /* truncate */
+        apswvfsfile_xSync,                  /* sync */
+        apswvfsfile_xFileSize,              /* filesize */
+        apswvfsfile_xLock,                  /* lock */
+        apswvfsfile_xUnlock,                /* unlock */
+        apswvfsfile_xCheckReservedLock,     /* checkreservedlock */
+        apswvfsfile_xFileControl,           /* filecontrol */
+        apswvfsfile_xSectorSize,            /* sectorsize */
+        apswvfsfile_xDeviceCharacteristics, /* device characteristics */
+        apswproxyxShmMap,                   /* shmmap */
+        apswproxyxShmLock,                  /* shmlock */
+        apswproxyxShmBarrier,               /* shmbarrier */
+        apswproxyxShmUnmap,                 /* shmunmap */
+        apswvfsfile_xFetch,                 /* fetch */
+        apswvfsfile_xUnfetch                /* unfetch */
+};
+
+static PyMethodDef APSWVFSFile_methods[] = {
+    {"xRead", (PyCFunction)apswvfsfilepy_xRead, METH_VARARGS | METH_KEYWORDS, VFSFile_xRead_DOC},
+    {"xReadInto", (PyCFunction)apswvfsfilepy_xReadInto, METH_VARARGS | METH_KEYWORDS, VFSFile_xReadInto_DOC},
+    {"xFetch", (PyCFunction)apswvfsfilepy_xFetch, METH_VARARGS | METH_KEYWORDS, VFSFile_xFetch_DOC},
+    {"xUnfetch", (PyCFunction)apswvfsfilepy_xUnfetch, METH_VARARGS | METH_KEYWORDS, VFSFile_xUnfetch_DOC},
+    {"xUnlock", (PyCFunction)apswvfsfilepy_xUnlock, METH_VARARGS | METH_KEYWORDS, VFSFile_xUnlock_DOC},
+    {"xLock", (PyCFunction)apswvfsfilepy_xLock, METH_VARARGS | METH_KEYWORDS, VFSFile_xLock_DOC},
+    {"xClose", (PyCFunction)apswvfsfilepy_xClose, METH_NOARGS, VFSFile_xClose_DOC},
+    {"xSectorSize", (PyCFunction)apswvfsfilepy_xSectorSize, METH_NOARGS, VFSFile_xSectorSize_DOC},
+    {"xFileSize", (PyCFunction)apswvfsfilepy_xFileSize, METH_NOARGS, VFSFile_xFileSize_DOC},
+    {"xDeviceCharacteristics", (PyCFunction)apswvfsfilepy_xDeviceCharacteristics, METH_NOARGS, VFSFile_xDeviceCharacteristics_DOC},
+    {"xCheckReservedLock", (PyCFunction)apswvfsfilepy_xCheckReservedLock, METH_NOARGS, VFSFile_xCheckReservedLock_DOC},
+    {"xWrite", (PyCFunction)apswvfsfilepy_xWrite, METH_VARARGS | METH_KEYWORDS, VFSFile_xWrite_DOC},
+    {"xSync", (PyCFunction)apswvfsfilepy_xSync, METH_VARARGS | METH_KEYWORDS, VFSFile_xSync_DOC},
+    {"xTruncate", (PyCFunction)apswvfsfilepy_xTruncate, METH_VARARGS | METH_KEYWORDS, VFSFile_xTruncate_DOC},
+    {"xFileControl", (PyCFunction)apswvfsfilepy_xFileControl, METH_VARARGS | METH_KEYWORDS, VFSFile_xFileControl_DOC},
+    {"excepthook", (PyCFunction)apswvfs_excepthook, METH_VARARGS, VFSFile_excepthook_DOC},
+    /* Sentinel */
+    {0, 0, 0, 0}};
+
+static PyTypeObject APSWVFSFileType =
+    {
+        PyVarObject_HEAD_INIT(NULL, 0) "apsw.VFSFile",                          /*tp_name*/
+        sizeof(APSWVFSFile),                                                    /*tp_basicsize*/
+        0,                                                                      /*tp_itemsize*/
+        (destructor)APSWVFSFile_dealloc,                                        /*tp_dealloc*/
+        0,                                                                      /*tp_print*/
+        0,                                                                      /*tp_getattr*/
+        0,                                                                      /*tp_setattr*/
+        0,                                                                      /*tp_compare*/
+        0,                                                                      /*tp_repr*/
+        0,                                                                      /*tp_as_number*/
+        0,                                                                      /*tp_as_sequence*/
+        0,                                                                      /*tp_as_mapping*/
+        0,                                                                      /*tp_hash */
+        0,                                                                      /*tp_call*/
+        0,                                                                      /*tp_str*/
         0,                                                                      /*tp_getattro*/
         0,                                                                      /*tp_setattro*/
         0,                                                                      /*tp_as_buffer*/
@@ -2986,3 +3569,4128 @@ static PyTypeObject APSWURIFilenameType =
         0,                                                                      /* tp_del */
         PyType_TRAILER
 };
+
+/** .. class:: VFSShim
+
+    A VFS implemented in C that sits on top of another VFS, adding
+    statistics and optionally read ahead, a page cache and write
+    coalescing.  Because no Python code is run, file operations go
+    through a shim at close to the speed of the VFS underneath.  A
+    shim is registered by name, so shims can be stacked on top of each
+    other, and a :class:`VFS` written in Python can use one as its
+    base.
+
+    .. code-block:: python
+
+      # count and time everything the default vfs does, with a
+      # 2,000 page cache shared by all connections to the same file
+      shim = apsw.VFSShim("cached", cache_pages=2000)
+      db = apsw.Connection("file.db", vfs="cached")
+      ...
+      print(shim.stats())
+
+    The read ahead, page cache, and write coalescing are only of
+    benefit when SQLite's own cache can't be used effectively, such
+    as many short lived connections, or a slow underlying VFS.
+
+    Read ahead
+      When a read is just after the previous one then *readahead*
+      bytes are read from the underlying file in one go, and
+      following reads are satisfied from that.  It is discarded
+      whenever the file could have been changed by others.
+
+    Page cache
+      Database pages are kept in a cache shared between all
+      connections to the same database through the shim, which
+      survives between transactions.  When a transaction starts, the
+      same header fields SQLite uses to tell if the database was
+      changed by another connection are checked, and the cache
+      discarded if so.  The cache is not used for databases in
+      :ref:`WAL mode <wal>`.
+
+    Write coalescing
+      Consecutive writes to a file are gathered into a buffer of up to
+      *coalesce* bytes, and written in one go.  The buffer is written
+      before the file is synced, read from where the data is pending,
+      locked, unlocked, truncated, or any other operation is done on
+      it.  WAL files, and databases in WAL mode are not coalesced.
+
+      Data that is still in the buffer is lost if the process
+      crashes.  With ``PRAGMA synchronous=OFF``, a crash can leave the
+      database corrupt just as a power failure could.
+
+    Write behind
+      Writes are queued, up to *write_behind* bytes, and made by a
+      background thread while SQLite carries on.  Syncs go through the
+      same queue so everything happens in the order SQLite asked for.
+      Anything that needs the file to be current such as reading what
+      is queued, locking and unlocking waits for the queue.
+
+      With *sync_delay* of zero a sync still waits until the data is
+      on storage, so durability is the same as without the shim.
+      Otherwise syncs return immediately, and are done within
+      *sync_delay* seconds.  Syncs of the same file during that time,
+      typically commits from many connections to a database in
+      :ref:`WAL mode <wal>`, are combined into one.  A sync is always
+      done before any other file is written, so a power failure can
+      lose the most recent transactions but not corrupt the database.
+      Errors from deferred syncs are returned by the next operation on
+      the file.  Use :meth:`flush` to wait until everything queued is
+      durable.
+
+*/
+
+/* Write behind needs to wait for the worker which SQLite mutexes
+   can't do */
+#ifdef _WIN32
+typedef SRWLOCK apswshim_lock;
+typedef CONDITION_VARIABLE apswshim_cond;
+#define SHIMLOCK_INIT(l) InitializeSRWLock(l)
+#define SHIMLOCK_FREE(l)
+#define SHIMLOCK_ENTER(l) AcquireSRWLockExclusive(l)
+#define SHIMLOCK_LEAVE(l) ReleaseSRWLockExclusive(l)
+#define SHIMCOND_INIT(c) InitializeConditionVariable(c)
+#define SHIMCOND_FREE(c)
+#define SHIMCOND_SIGNAL(c) WakeConditionVariable(c)
+#define SHIMCOND_BROADCAST(c) WakeAllConditionVariable(c)
+#define SHIMCOND_WAIT(c, l) SleepConditionVariableSRW(c, l, INFINITE, 0)
+#else
+typedef pthread_mutex_t apswshim_lock;
+typedef pthread_cond_t apswshim_cond;
+#define SHIMLOCK_INIT(l) pthread_mutex_init(l, NULL)
+#define SHIMLOCK_FREE(l) pthread_mutex_destroy(l)
+#define SHIMLOCK_ENTER(l) pthread_mutex_lock(l)
+#define SHIMLOCK_LEAVE(l) pthread_mutex_unlock(l)
+#define SHIMCOND_INIT(c) pthread_cond_init(c, NULL)
+#define SHIMCOND_FREE(c) pthread_cond_destroy(c)
+#define SHIMCOND_SIGNAL(c) pthread_cond_signal(c)
+#define SHIMCOND_BROADCAST(c) pthread_cond_broadcast(c)
+#define SHIMCOND_WAIT(c, l) pthread_cond_wait(c, l)
+#endif
+
+/* The shim state is separate from the Python object, because open
+   files and SQLite still need the sqlite3_vfs after the Python object
+   has gone.  It is freed when the last reference goes. */
+
+typedef struct
+{
+  sqlite3_int64 calls, bytes, ns, maxns;
+} APSWShimTiming;
+
+typedef struct
+{
+  sqlite3_int64 opens, cache_hits, cache_misses, readahead_hits, base_reads, base_writes;
+  APSWShimTiming read, write, sync;
+} APSWShimStats;
+
+typedef struct
+{
+  sqlite3_int64 queued_writes, queue_max, queue_waits, sync_requests, sync_batches, sync_batch_max, background_errors;
+  APSWShimTiming sync_latency; /* from the request until done */
+} APSWShimWBStats;
+
+struct APSWShimOp;
+
+typedef struct APSWShimPage
+{
+  sqlite3_int64 offset;
+  struct APSWShimPage *hashnext;      /* next in the same hash bucket */
+  struct APSWShimPage *newer, *older; /* recency order */
+  /* page data follows */
+} APSWShimPage;
+
+#define SHIMPAGEDATA(page) ((unsigned char *)((page) + 1))
+
+typedef struct APSWShimCache
+{
+  struct APSWShimCache *next; /* other caches of the same shim */
+  char *filename;
+  int refs; /* open files using this cache */
+  int pagesize;
+  int npages;
+  unsigned nbuckets; /* power of two */
+  APSWShimPage **buckets;
+  APSWShimPage *newest, *oldest;
+  /* database header bytes 16 to 39 which include the file change
+     counter and the journal mode, matching the cached pages */
+  unsigned char header[24];
+  int header_valid;
+} APSWShimCache;
+
+typedef struct
+{
+  sqlite3_vfs vfs; /* what sqlite uses with pAppData pointing back here */
+  sqlite3_vfs *basevfs;
+  sqlite3_mutex *mutex; /* protects all the following, and the caches */
+  int refs;             /* Python object and open files */
+  int readahead, cache_pages, coalesce;
+  APSWShimCache *caches;
+  APSWShimStats stats;
+
+  /* write behind */
+  int write_behind;         /* most bytes of writes queued, zero if not used */
+  sqlite3_int64 sync_delay; /* nanoseconds a sync can wait to be combined with others */
+  apswshim_lock wblock;     /* protects the following, and the queue members of files */
+  apswshim_cond wbwork;     /* signalled when there is something for the worker */
+  apswshim_cond wbdone;     /* broadcast when the worker has done something */
+  struct APSWShimOp *head, *tail;
+  struct APSWShimOp *batch; /* syncs of the same file to do in one go, newest first */
+  sqlite3_int64 batch_started;
+  sqlite3_int64 queued;         /* bytes of writes in the queue */
+  sqlite3_int64 seq, doneseq;   /* last operation queued, and taken by the worker */
+  int urgent;                   /* callers waiting on the batch */
+  int worker;                   /* worker thread is running */
+  int stop;                     /* worker should exit once idle */
+  APSWShimWBStats wbstats;
+} APSWShim;
+
+typedef struct /* inherits */
+{
+  const struct sqlite3_io_methods *pMethods;
+  APSWShim *shim;
+  sqlite3_file *real; /* base file which is allocated after this structure */
+  int openflags;
+  int lock;
+  int shm; /* the xShm methods have been used, so the database is in wal mode */
+
+  /* page cache */
+  APSWShimCache *cache;
+  int cacheable; /* a shared lock is held, and the cache was checked to be current */
+
+  /* read ahead */
+  char *ra;
+  sqlite3_int64 ra_offset;
+  int ra_len;
+  sqlite3_int64 lastend; /* offset just after the last read */
+
+  /* write coalescing */
+  char *wbuf;
+  sqlite3_int64 w_offset;
+  int w_len;
+
+  /* counted without the mutex and added to the shim stats on the next
+     timing */
+  sqlite3_int64 readahead_hits, base_reads, base_writes;
+
+  /* write behind */
+  const char *name; /* syncs are only combined for files with the same name */
+  int synced;       /* the first sync has been done directly */
+  int pending;      /* operations in the queue, protected by wblock */
+  int wberror;      /* from a queued operation and not returned yet, protected by wblock */
+} APSWShimFile;
+
+typedef struct APSWShimOp
+{
+  struct APSWShimOp *next;
+  APSWShimFile *file;
+  sqlite3_int64 offset;
+  int amount;           /* data follows, or -1 for a sync */
+  int flags;            /* of the sync */
+  int waiting;          /* the caller waits for the sync and frees this */
+  int done, result;     /* the sync has been done */
+  sqlite3_int64 seq;    /* order queued */
+  sqlite3_int64 queued; /* time queued */
+} APSWShimOp;
+
+#define SHIMOPDATA(op) ((char *)((op) + 1))
+
+#define SHIMFILESIZE ((int)((sizeof(APSWShimFile) + 7) & ~(size_t)7))
+
+typedef struct
+{
+  PyObject_HEAD
+      APSWShim *shim;
+  int registered;
+} APSWVFSShim;
+
+static PyTypeObject APSWVFSShimType;
+
+/* monotonic clock in nanoseconds */
+static sqlite3_int64
+apswshim_now(void)
+{
+#ifdef _WIN32
+  static LARGE_INTEGER frequency;
+  LARGE_INTEGER now;
+  if (!frequency.QuadPart)
+    QueryPerformanceFrequency(&frequency);
+  QueryPerformanceCounter(&now);
+  return (sqlite3_int64)(now.QuadPart * (1000000000.0 / frequency.QuadPart));
+#else
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (sqlite3_int64)ts.tv_sec * 1000000000 + ts.tv_nsec;
+#endif
+}
+
+/* adds an operation that started at start to the stats */
+static void
+apswshim_record(APSWShimFile *f, APSWShimTiming *timing, sqlite3_int64 start, sqlite3_int64 bytes)
+{
+  sqlite3_int64 elapsed = timing ? apswshim_now() - start : 0;
+  APSWShim *shim = f->shim;
+
+  sqlite3_mutex_enter(shim->mutex);
+  if (timing)
+  {
+    timing->calls++;
+    timing->bytes += bytes;
+    timing->ns += elapsed;
+    if (elapsed > timing->maxns)
+      timing->maxns = elapsed;
+  }
+  shim->stats.readahead_hits += f->readahead_hits;
+  shim->stats.base_reads += f->base_reads;
+  shim->stats.base_writes += f->base_writes;
+  sqlite3_mutex_leave(shim->mutex);
+  f->readahead_hits = f->base_reads = f->base_writes = 0;
+}
+
+static void
+apswshim_release(APSWShim *shim)
+{
+  int last;
+
+  sqlite3_mutex_enter(shim->mutex);
+  last = (0 == --shim->refs);
+  sqlite3_mutex_leave(shim->mutex);
+  if (!last)
+    return;
+  assert(!shim->caches);
+  if (shim->write_behind)
+  {
+    SHIMLOCK_ENTER(&shim->wblock);
+    assert(!shim->head && !shim->batch);
+    shim->stop = 1;
+    SHIMCOND_SIGNAL(&shim->wbwork);
+    while (shim->worker)
+      SHIMCOND_WAIT(&shim->wbdone, &shim->wblock);
+    SHIMLOCK_LEAVE(&shim->wblock);
+    SHIMCOND_FREE(&shim->wbwork);
+    SHIMCOND_FREE(&shim->wbdone);
+    SHIMLOCK_FREE(&shim->wblock);
+  }
+  sqlite3_mutex_free(shim->mutex);
+  sqlite3_free(shim);
+}
+
+/* Page cache.  All these are called with the shim mutex held. */
+
+static void
+apswshim_cache_clear(APSWShimCache *cache)
+{
+  APSWShimPage *page = cache->newest, *next;
+
+  while (page)
+  {
+    next = page->older;
+    sqlite3_free(page);
+    page = next;
+  }
+  cache->newest = cache->oldest = NULL;
+  cache->npages = 0;
+  if (cache->buckets)
+    memset(cache->buckets, 0, sizeof(APSWShimPage *) * cache->nbuckets);
+}
+
+static APSWShimPage **
+apswshim_cache_bucket(APSWShimCache *cache, sqlite3_int64 offset)
+{
+  return &cache->buckets[(unsigned)(offset / cache->pagesize) & (cache->nbuckets - 1)];
+}
+
+static void
+apswshim_cache_unlink(APSWShimCache *cache, APSWShimPage *page)
+{
+  if (page->newer)
+    page->newer->older = page->older;
+  else
+    cache->newest = page->older;
+  if (page->older)
+    page->older->newer = page->newer;
+  else
+    cache->oldest = page->newer;
+}
+
+static void
+apswshim_cache_make_newest(APSWShimCache *cache, APSWShimPage *page)
+{
+  page->newer = NULL;
+  page->older = cache->newest;
+  if (cache->newest)
+    cache->newest->newer = page;
+  cache->newest = page;
+  if (!cache->oldest)
+    cache->oldest = page;
+}
+
+static void
+apswshim_cache_remove(APSWShimCache *cache, APSWShimPage *page)
+{
+  APSWShimPage **pp = apswshim_cache_bucket(cache, page->offset);
+
+  while (*pp != page)
+    pp = &(*pp)->hashnext;
+  *pp = page->hashnext;
+  apswshim_cache_unlink(cache, page);
+  cache->npages--;
+  sqlite3_free(page);
+}
+
+static APSWShimPage *
+apswshim_cache_find(APSWShimCache *cache, sqlite3_int64 offset)
+{
+  APSWShimPage *page;
+
+  if (!cache->pagesize)
+    return NULL;
+  for (page = *apswshim_cache_bucket(cache, offset); page; page = page->hashnext)
+    if (page->offset == offset)
+      return page;
+  return NULL;
+}
+
+/* copies the data for a read out of the cache if it is all present in
+   one page */
+static int
+apswshim_cache_read(APSWShimFile *f, void *buffer, int amount, sqlite3_int64 offset)
+{
+  APSWShimCache *cache = f->cache;
+  APSWShimPage *page = NULL;
+  sqlite3_int64 pageoffset;
+
+  sqlite3_mutex_enter(f->shim->mutex);
+  if (cache->pagesize)
+  {
+    pageoffset = offset - offset % cache->pagesize;
+    if (offset + amount <= pageoffset + cache->pagesize)
+      page = apswshim_cache_find(cache, pageoffset);
+  }
+  if (page)
+  {
+    memcpy(buffer, SHIMPAGEDATA(page) + (offset - pageoffset), amount);
+    apswshim_cache_unlink(cache, page);
+    apswshim_cache_make_newest(cache, page);
+    f->shim->stats.cache_hits++;
+  }
+  else
+    f->shim->stats.cache_misses++;
+  sqlite3_mutex_leave(f->shim->mutex);
+  return page != NULL;
+}
+
+/* adds a whole page to the cache, evicting the oldest if full.  The
+   first aligned power of two sized access gives the page size, and a
+   different one (eg after a vacuum changing the page size) starts
+   again. */
+static void
+apswshim_cache_add(APSWShimFile *f, const void *buffer, int amount, sqlite3_int64 offset)
+{
+  APSWShimCache *cache = f->cache;
+  APSWShimPage *page, **bucket;
+  int max_pages = f->shim->cache_pages;
+
+  if (amount < 512 || (amount & (amount - 1)) || offset % amount)
+    return;
+
+  if (amount != cache->pagesize)
+  {
+    apswshim_cache_clear(cache);
+    cache->pagesize = amount;
+  }
+
+  page = apswshim_cache_find(cache, offset);
+  if (page)
+    apswshim_cache_unlink(cache, page);
+  else
+  {
+    if (cache->npages >= max_pages)
+    {
+      page = cache->oldest;
+      bucket = apswshim_cache_bucket(cache, page->offset);
+      while (*bucket != page)
+        bucket = &(*bucket)->hashnext;
+      *bucket = page->hashnext;
+      apswshim_cache_unlink(cache, page);
+    }
+    else
+    {
+      page = sqlite3_malloc64(sizeof(APSWShimPage) + amount);
+      if (!page)
+        return;
+      cache->npages++;
+    }
+    page->offset = offset;
+    bucket = apswshim_cache_bucket(cache, offset);
+    page->hashnext = *bucket;
+    *bucket = page;
+  }
+  memcpy(SHIMPAGEDATA(page), buffer, amount);
+  apswshim_cache_make_newest(cache, page);
+}
+
+/* keeps cached pages and header up to date with a write */
+static void
+apswshim_cache_write(APSWShimFile *f, const void *buffer, int amount, sqlite3_int64 offset)
+{
+  APSWShimCache *cache = f->cache;
+  APSWShimPage *page;
+  sqlite3_int64 pageoffset, start, end;
+
+  sqlite3_mutex_enter(f->shim->mutex);
+
+  if (offset < 40 && offset + amount > 16)
+  {
+    start = (offset > 16) ? offset : 16;
+    end = (offset + amount < 40) ? offset + amount : 40;
+    memcpy(cache->header + (start - 16), (const char *)buffer + (start - offset), end - start);
+    if (start > 16 || end < 40)
+      cache->header_valid = 0;
+    else
+      cache->header_valid = 1;
+  }
+
+  if (cache->pagesize)
+  {
+    for (pageoffset = offset - offset % cache->pagesize; pageoffset < offset + amount; pageoffset += cache->pagesize)
+    {
+      page = apswshim_cache_find(cache, pageoffset);
+      if (!page)
+        continue;
+      start = (offset > pageoffset) ? offset : pageoffset;
+      end = (offset + amount < pageoffset + cache->pagesize) ? offset + amount : pageoffset + cache->pagesize;
+      memcpy(SHIMPAGEDATA(page) + (start - pageoffset), (const char *)buffer + (start - offset), end - start);
+    }
+  }
+
+  if (f->cacheable)
+    apswshim_cache_add(f, buffer, amount, offset);
+
+  sqlite3_mutex_leave(f->shim->mutex);
+}
+
+static void
+apswshim_cache_truncate(APSWShimFile *f, sqlite3_int64 size)
+{
+  APSWShimCache *cache = f->cache;
+  APSWShimPage *page, *older;
+
+  sqlite3_mutex_enter(f->shim->mutex);
+  for (page = cache->newest; page; page = older)
+  {
+    older = page->older;
+    if (page->offset + cache->pagesize > size)
+      apswshim_cache_remove(cache, page);
+  }
+  if (size < 40)
+    cache->header_valid = 0;
+  sqlite3_mutex_leave(f->shim->mutex);
+}
+
+/* A shared lock has been acquired.  The header fields are compared
+   with those matching the cache to see if another connection has
+   changed the database, in the same way SQLite checks if its own
+   cache is still valid. */
+static void
+apswshim_cache_validate(APSWShimFile *f)
+{
+  APSWShimCache *cache = f->cache;
+  unsigned char header[24];
+  int res;
+
+  res = f->real->pMethods->xRead(f->real, header, sizeof(header), 16);
+  f->base_reads++;
+
+  sqlite3_mutex_enter(f->shim->mutex);
+  if (res != SQLITE_OK)
+  {
+    /* new empty database */
+    apswshim_cache_clear(cache);
+    cache->header_valid = 0;
+    f->cacheable = !f->shm;
+  }
+  else if (f->shm || header[2] == 2 || header[3] == 2)
+  {
+    /* wal mode */
+    apswshim_cache_clear(cache);
+    cache->header_valid = 0;
+    f->cacheable = 0;
+  }
+  else
+  {
+    if (!cache->header_valid || memcmp(header, cache->header, sizeof(header)))
+    {
+      apswshim_cache_clear(cache);
+      memcpy(cache->header, header, sizeof(header));
+      cache->header_valid = 1;
+    }
+    f->cacheable = 1;
+  }
+  sqlite3_mutex_leave(f->shim->mutex);
+}
+
+static APSWShimCache *
+apswshim_cache_acquire(APSWShim *shim, const char *filename)
+{
+  APSWShimCache *cache;
+  size_t len = strlen(filename);
+
+  sqlite3_mutex_enter(shim->mutex);
+  for (cache = shim->caches; cache; cache = cache->next)
+    if (0 == strcmp(cache->filename, filename))
+      break;
+  if (!cache)
+  {
+    cache = sqlite3_malloc64(sizeof(APSWShimCache) + len + 1);
+    if (cache)
+    {
+      memset(cache, 0, sizeof(APSWShimCache));
+      cache->filename = (char *)(cache + 1);
+      memcpy(cache->filename, filename, len + 1);
+      for (cache->nbuckets = 16; cache->nbuckets < (unsigned)shim->cache_pages; cache->nbuckets *= 2)
+        ;
+      cache->buckets = sqlite3_malloc64(sizeof(APSWShimPage *) * cache->nbuckets);
+      if (!cache->buckets)
+      {
+        sqlite3_free(cache);
+        cache = NULL;
+      }
+      else
+      {
+        memset(cache->buckets, 0, sizeof(APSWShimPage *) * cache->nbuckets);
+        cache->next = shim->caches;
+        shim->caches = cache;
+      }
+    }
+  }
+  if (cache)
+    cache->refs++;
+  sqlite3_mutex_leave(shim->mutex);
+  return cache;
+}
+
+static void
+apswshim_cache_release(APSWShim *shim, APSWShimCache *cache)
+{
+  APSWShimCache **pc;
+
+  sqlite3_mutex_enter(shim->mutex);
+  if (0 == --cache->refs)
+  {
+    for (pc = &shim->caches; *pc != cache; pc = &(*pc)->next)
+      ;
+    *pc = cache->next;
+    apswshim_cache_clear(cache);
+    sqlite3_free(cache->buckets);
+    sqlite3_free(cache);
+  }
+  sqlite3_mutex_leave(shim->mutex);
+}
+
+/* Write behind.  Writes and syncs are queued in order for a worker
+   thread.  A sync waits in the batch while the worker carries on with
+   later writes to the same file, with later syncs of that file joining
+   the batch.  Anything for another file does the batch first, which
+   keeps the ordering SQLite relies on between files such as the
+   journal being synced before the database is written.  All these are
+   called with wblock held. */
+
+/* waits on cond for up to ns nanoseconds */
+static void
+apswshim_timedwait(apswshim_cond *cond, apswshim_lock *lock, sqlite3_int64 ns)
+{
+#ifdef _WIN32
+  SleepConditionVariableSRW(cond, lock, (DWORD)(ns / 1000000 + 1), 0);
+#else
+  struct timespec ts;
+  clock_gettime(CLOCK_REALTIME, &ts);
+  ns += ts.tv_nsec;
+  ts.tv_sec += (time_t)(ns / 1000000000);
+  ts.tv_nsec = (long)(ns % 1000000000);
+  pthread_cond_timedwait(cond, lock, &ts);
+#endif
+}
+
+/* adds op to the queue, waiting for room if necessary */
+static void
+apswshim_wb_enqueue(APSWShim *shim, APSWShimOp *op)
+{
+  if (op->amount > 0)
+  {
+    if (shim->queued && shim->queued + op->amount > shim->write_behind)
+    {
+      shim->wbstats.queue_waits++;
+      while (shim->queued && shim->queued + op->amount > shim->write_behind)
+        SHIMCOND_WAIT(&shim->wbdone, &shim->wblock);
+    }
+    shim->queued += op->amount;
+    if (shim->queued > shim->wbstats.queue_max)
+      shim->wbstats.queue_max = shim->queued;
+    shim->wbstats.queued_writes++;
+  }
+  else
+    shim->wbstats.sync_requests++;
+
+  op->file->pending++;
+  op->seq = ++shim->seq;
+  op->next = NULL;
+  if (shim->tail)
+    shim->tail->next = op;
+  else
+    shim->head = op;
+  shim->tail = op;
+  SHIMCOND_SIGNAL(&shim->wbwork);
+}
+
+/* is there a sync in the batch for f (any file if NULL) queued no
+   later than seq */
+static int
+apswshim_wb_inbatch(APSWShim *shim, APSWShimFile *f, sqlite3_int64 seq)
+{
+  APSWShimOp *op;
+
+  for (op = shim->batch; op; op = op->next)
+    if ((!f || op->file == f) && op->seq <= seq)
+      return 1;
+  return 0;
+}
+
+static int
+apswshim_wb_samefile(APSWShimFile *a, APSWShimFile *b)
+{
+  return a == b || (a->name && b->name && 0 == strcmp(a->name, b->name));
+}
+
+/* Does all the syncs in the batch with one sync of the most recent
+   file, using the strongest flags requested */
+static void
+apswshim_wb_runbatch(APSWShim *shim)
+{
+  APSWShimOp *op, *next;
+  int res, flags = 0, dataonly = SQLITE_SYNC_DATAONLY;
+  sqlite3_int64 count = 0, now, elapsed;
+  sqlite3_file *real = shim->batch->file->real;
+
+  for (op = shim->batch; op; op = op->next)
+  {
+    if ((op->flags & 0x0f) > flags)
+      flags = op->flags & 0x0f;
+    dataonly &= op->flags;
+  }
+
+  SHIMLOCK_LEAVE(&shim->wblock);
+  res = real->pMethods->xSync(real, flags | dataonly);
+  now = apswshim_now();
+  SHIMLOCK_ENTER(&shim->wblock);
+
+  for (op = shim->batch; op; op = next)
+  {
+    next = op->next;
+    count++;
+    elapsed = now - op->queued;
+    shim->wbstats.sync_latency.calls++;
+    shim->wbstats.sync_latency.ns += elapsed;
+    if (elapsed > shim->wbstats.sync_latency.maxns)
+      shim->wbstats.sync_latency.maxns = elapsed;
+    if (op->waiting)
+    {
+      op->result = res;
+      op->done = 1;
+      continue;
+    }
+    if (res != SQLITE_OK)
+    {
+      shim->wbstats.background_errors++;
+      if (!op->file->wberror)
+        op->file->wberror = res;
+    }
+    sqlite3_free(op);
+  }
+  shim->batch = NULL;
+  shim->wbstats.sync_batches++;
+  if (count > shim->wbstats.sync_batch_max)
+    shim->wbstats.sync_batch_max = count;
+  SHIMCOND_BROADCAST(&shim->wbdone);
+}
+
+static void
+apswshim_wb_worker(void *arg)
+{
+  APSWShim *shim = (APSWShim *)arg;
+  APSWShimOp *op;
+  APSWShimFile *f;
+  int res;
+
+  SHIMLOCK_ENTER(&shim->wblock);
+  for (;;)
+  {
+    op = shim->head;
+    if (op && shim->batch && !apswshim_wb_samefile(op->file, shim->batch->file))
+    {
+      apswshim_wb_runbatch(shim);
+      continue;
+    }
+    if (op)
+    {
+      f = op->file;
+      shim->head = op->next;
+      if (!shim->head)
+        shim->tail = NULL;
+      shim->doneseq = op->seq;
+      if (op->amount < 0)
+      {
+        if (!shim->batch)
+          shim->batch_started = op->queued;
+        op->next = shim->batch;
+        shim->batch = op;
+      }
+      else
+      {
+        SHIMLOCK_LEAVE(&shim->wblock);
+        res = f->real->pMethods->xWrite(f->real, SHIMOPDATA(op), op->amount, op->offset);
+        sqlite3_mutex_enter(shim->mutex);
+        shim->stats.base_writes++;
+        sqlite3_mutex_leave(shim->mutex);
+        SHIMLOCK_ENTER(&shim->wblock);
+        if (res != SQLITE_OK)
+        {
+          shim->wbstats.background_errors++;
+          if (!f->wberror)
+            f->wberror = res;
+        }
+        shim->queued -= op->amount;
+        sqlite3_free(op);
+      }
+      f->pending--;
+      SHIMCOND_BROADCAST(&shim->wbdone);
+      continue;
+    }
+    if (shim->batch)
+    {
+      sqlite3_int64 wait = shim->batch_started + shim->sync_delay - apswshim_now();
+      if (wait <= 0 || shim->urgent || shim->stop || shim->batch->waiting)
+        apswshim_wb_runbatch(shim);
+      else
+        apswshim_timedwait(&shim->wbwork, &shim->wblock, wait);
+      continue;
+    }
+    if (shim->stop)
+      break;
+    SHIMCOND_WAIT(&shim->wbwork, &shim->wblock);
+  }
+  shim->worker = 0;
+  SHIMCOND_BROADCAST(&shim->wbdone);
+  SHIMLOCK_LEAVE(&shim->wblock);
+}
+
+/* Called without wblock.  Waits until everything f has queued has
+   been done, or everything queued so far by anyone if f is NULL.  If
+   durable then syncs requested must have been done too.  Returns any
+   error from the queued operations of f. */
+static int
+apswshim_wb_wait(APSWShim *shim, APSWShimFile *f, int durable)
+{
+  sqlite3_int64 seq;
+  int res = SQLITE_OK;
+
+  if (!shim->write_behind)
+    return SQLITE_OK;
+
+  SHIMLOCK_ENTER(&shim->wblock);
+  seq = shim->seq;
+  if (durable)
+  {
+    shim->urgent++;
+    SHIMCOND_SIGNAL(&shim->wbwork);
+  }
+  while ((f ? f->pending > 0 : shim->doneseq < seq) || (durable && apswshim_wb_inbatch(shim, f, seq)))
+    SHIMCOND_WAIT(&shim->wbdone, &shim->wblock);
+  if (durable)
+    shim->urgent--;
+  if (f)
+  {
+    res = f->wberror;
+    f->wberror = 0;
+  }
+  SHIMLOCK_LEAVE(&shim->wblock);
+  return res;
+}
+
+/* writes to the real file, queueing if write behind is used */
+static int
+apswshim_write_real(APSWShimFile *f, const void *buffer, int amount, sqlite3_int64 offset)
+{
+  APSWShim *shim = f->shim;
+  APSWShimOp *op;
+  int res;
+
+  if (shim->write_behind)
+  {
+    op = sqlite3_malloc64(sizeof(APSWShimOp) + amount);
+    if (op)
+    {
+      memset(op, 0, sizeof(APSWShimOp));
+      op->file = f;
+      op->offset = offset;
+      op->amount = amount;
+      op->queued = apswshim_now();
+      memcpy(SHIMOPDATA(op), buffer, amount);
+      SHIMLOCK_ENTER(&shim->wblock);
+      apswshim_wb_enqueue(shim, op);
+      res = f->wberror;
+      f->wberror = 0;
+      SHIMLOCK_LEAVE(&shim->wblock);
+      return res;
+    }
+    /* out of memory so write directly once everything before is done */
+    res = apswshim_wb_wait(shim, NULL, 1);
+    if (res == SQLITE_OK)
+      res = apswshim_wb_wait(shim, f, 0);
+    if (res != SQLITE_OK)
+      return res;
+  }
+  f->base_writes++;
+  return f->real->pMethods->xWrite(f->real, buffer, amount, offset);
+}
+
+static int
+apswshim_sync_real(APSWShimFile *f, int flags)
+{
+  APSWShim *shim = f->shim;
+  APSWShimOp *op = NULL;
+  int res, waiting;
+
+  /* The first sync of each file is done directly because it can also
+     sync the directory the file was created in */
+  if (shim->write_behind && f->synced && f->name)
+    op = sqlite3_malloc64(sizeof(APSWShimOp));
+  if (!op)
+  {
+    res = apswshim_wb_wait(shim, f, 0);
+    if (res == SQLITE_OK)
+      res = f->real->pMethods->xSync(f->real, flags);
+    f->synced = 1;
+    return res;
+  }
+
+  memset(op, 0, sizeof(APSWShimOp));
+  op->file = f;
+  op->amount = -1;
+  op->flags = flags;
+  op->queued = apswshim_now();
+  op->waiting = waiting = (shim->sync_delay == 0);
+  SHIMLOCK_ENTER(&shim->wblock);
+  apswshim_wb_enqueue(shim, op);
+  while (waiting && !op->done)
+    SHIMCOND_WAIT(&shim->wbdone, &shim->wblock);
+  res = waiting ? op->result : SQLITE_OK;
+  if (res == SQLITE_OK)
+    res = f->wberror;
+  f->wberror = 0;
+  SHIMLOCK_LEAVE(&shim->wblock);
+  if (waiting)
+    sqlite3_free(op);
+  return res;
+}
+
+/* io methods */
+
+#define SHIMFILE                            \
+  APSWShimFile *f = (APSWShimFile *)file; \
+  sqlite3_file *real = f->real;
+
+/* writes out any coalesced data */
+static int
+apswshim_flush(APSWShimFile *f)
+{
+  int res;
+
+  if (!f->w_len)
+    return SQLITE_OK;
+  res = apswshim_write_real(f, f->wbuf, f->w_len, f->w_offset);
+  f->w_len = 0;
+  return res;
+}
+
+/* makes sure everything written so far is in the real file */
+static int
+apswshim_settle(APSWShimFile *f)
+{
+  int res = apswshim_flush(f), res2;
+
+  res2 = apswshim_wb_wait(f->shim, f, 0);
+  return (res == SQLITE_OK) ? res2 : res;
+}
+
+static int
+apswshim_xClose(sqlite3_file *file)
+{
+  int res, res2;
+  SHIMFILE;
+
+  res = apswshim_flush(f);
+  /* queued syncs need the real file */
+  res2 = apswshim_wb_wait(f->shim, f, 1);
+  if (res == SQLITE_OK)
+    res = res2;
+  res2 = real->pMethods->xClose(real);
+  if (res == SQLITE_OK)
+    res = res2;
+  if (f->cache)
+    apswshim_cache_release(f->shim, f->cache);
+  sqlite3_free(f->ra);
+  sqlite3_free(f->wbuf);
+  apswshim_record(f, NULL, 0, 0);
+  apswshim_release(f->shim);
+  f->pMethods = NULL;
+  return res;
+}
+
+static int
+apswshim_xRead(sqlite3_file *file, void *buffer, int amount, sqlite3_int64 offset)
+{
+  int res = SQLITE_OK;
+  sqlite3_int64 start = apswshim_now(), size;
+  SHIMFILE;
+
+  if (f->w_len && offset < f->w_offset + f->w_len && offset + amount > f->w_offset)
+  {
+    res = apswshim_flush(f);
+    if (res != SQLITE_OK)
+      goto finally;
+  }
+  if (f->shim->write_behind)
+  {
+    res = apswshim_wb_wait(f->shim, f, 0);
+    if (res != SQLITE_OK)
+      goto finally;
+  }
+
+  if (f->cacheable && apswshim_cache_read(f, buffer, amount, offset))
+    goto finally;
+
+  if (f->ra_len && offset >= f->ra_offset && offset + amount <= f->ra_offset + f->ra_len)
+  {
+    memcpy(buffer, f->ra + (offset - f->ra_offset), amount);
+    f->readahead_hits++;
+  }
+  else
+  {
+    int len = 0;
+
+    if (f->shim->readahead > amount && offset == f->lastend && !(f->openflags & SQLITE_OPEN_WAL) && SQLITE_OK == real->pMethods->xFileSize(real, &size) && size - offset > amount)
+      len = (size - offset < f->shim->readahead) ? (int)(size - offset) : f->shim->readahead;
+    f->ra_len = 0;
+    if (len && !f->ra)
+      f->ra = sqlite3_malloc64(f->shim->readahead);
+    if (len && f->ra)
+    {
+      res = real->pMethods->xRead(real, f->ra, len, offset);
+      f->base_reads++;
+      if (res == SQLITE_OK)
+      {
+        f->ra_offset = offset;
+        f->ra_len = len;
+        memcpy(buffer, f->ra, amount);
+      }
+    }
+    if (!f->ra_len)
+    {
+      res = real->pMethods->xRead(real, buffer, amount, offset);
+      f->base_reads++;
+    }
+  }
+
+  if (res == SQLITE_OK && f->cacheable)
+  {
+    sqlite3_mutex_enter(f->shim->mutex);
+    apswshim_cache_add(f, buffer, amount, offset);
+    sqlite3_mutex_leave(f->shim->mutex);
+  }
+
+finally:
+  f->lastend = offset + amount;
+  apswshim_record(f, &f->shim->stats.read, start, amount);
+  return res;
+}
+
+static int
+apswshim_xWrite(sqlite3_file *file, const void *buffer, int amount, sqlite3_int64 offset)
+{
+  int res = SQLITE_OK;
+  sqlite3_int64 start = apswshim_now();
+  APSWShimFile *f = (APSWShimFile *)file;
+
+  f->ra_len = 0;
+  if (f->cache)
+    apswshim_cache_write(f, buffer, amount, offset);
+
+  if (f->w_len && offset == f->w_offset + f->w_len && f->w_len + amount <= f->shim->coalesce)
+  {
+    memcpy(f->wbuf + f->w_len, buffer, amount);
+    f->w_len += amount;
+    goto finally;
+  }
+
+  res = apswshim_flush(f);
+  if (res != SQLITE_OK)
+    goto finally;
+
+  if (amount < f->shim->coalesce && !f->shm && !(f->openflags & SQLITE_OPEN_WAL))
+  {
+    if (!f->wbuf)
+      f->wbuf = sqlite3_malloc64(f->shim->coalesce);
+    if (f->wbuf)
+    {
+      memcpy(f->wbuf, buffer, amount);
+      f->w_offset = offset;
+      f->w_len = amount;
+      goto finally;
+    }
+  }
+
+  res = apswshim_write_real(f, buffer, amount, offset);
+
+finally:
+  apswshim_record(f, &f->shim->stats.write, start, amount);
+  return res;
+}
+
+static int
+apswshim_xTruncate(sqlite3_file *file, sqlite3_int64 size)
+{
+  int res;
+  SHIMFILE;
+
+  /* truncating is like writing so pending syncs of other files have
+     to be done first */
+  res = apswshim_settle(f);
+  if (res == SQLITE_OK)
+    res = apswshim_wb_wait(f->shim, NULL, 1);
+  f->ra_len = 0;
+  if (f->cache)
+    apswshim_cache_truncate(f, size);
+  if (res == SQLITE_OK)
+    res = real->pMethods->xTruncate(real, size);
+  return res;
+}
+
+static int
+apswshim_xSync(sqlite3_file *file, int flags)
+{
+  int res;
+  sqlite3_int64 start = apswshim_now();
+  APSWShimFile *f = (APSWShimFile *)file;
+
+  res = apswshim_flush(f);
+  if (res == SQLITE_OK)
+    res = apswshim_sync_real(f, flags);
+  apswshim_record(f, &f->shim->stats.sync, start, 0);
+  return res;
+}
+
+static int
+apswshim_xFileSize(sqlite3_file *file, sqlite3_int64 *pSize)
+{
+  int res;
+  SHIMFILE;
+
+  res = apswshim_settle(f);
+  if (res == SQLITE_OK)
+    res = real->pMethods->xFileSize(real, pSize);
+  return res;
+}
+
+static int
+apswshim_xLock(sqlite3_file *file, int level)
+{
+  int res;
+  SHIMFILE;
+
+  res = apswshim_settle(f);
+  if (res == SQLITE_OK)
+    res = real->pMethods->xLock(real, level);
+  if (res == SQLITE_OK)
+  {
+    if (f->cache && f->lock == SQLITE_LOCK_NONE && level >= SQLITE_LOCK_SHARED)
+      apswshim_cache_validate(f);
+    f->lock = level;
+  }
+  return res;
+}
+
+static int
+apswshim_xUnlock(sqlite3_file *file, int level)
+{
+  int res;
+  SHIMFILE;
+
+  res = apswshim_settle(f);
+  if (level == SQLITE_LOCK_NONE)
+  {
+    /* others can now change the file */
+    f->cacheable = 0;
+    f->ra_len = 0;
+  }
+  if (res == SQLITE_OK)
+    res = real->pMethods->xUnlock(real, level);
+  if (res == SQLITE_OK)
+    f->lock = level;
+  return res;
+}
+
+static int
+apswshim_xCheckReservedLock(sqlite3_file *file, int *pResOut)
+{
+  SHIMFILE;
+  return real->pMethods->xCheckReservedLock(real, pResOut);
+}
+
+static int
+apswshim_xFileControl(sqlite3_file *file, int op, void *pArg)
+{
+  int res;
+  SHIMFILE;
+
+  res = apswshim_settle(f);
+  if (res == SQLITE_OK)
+    res = real->pMethods->xFileControl(real, op, pArg);
+  return res;
+}
+
+static int
+apswshim_xSectorSize(sqlite3_file *file)
+{
+  SHIMFILE;
+  return real->pMethods->xSectorSize(real);
+}
+
+static int
+apswshim_xDeviceCharacteristics(sqlite3_file *file)
+{
+  SHIMFILE;
+  return real->pMethods->xDeviceCharacteristics(real);
+}
+
+static int
+apswshim_xShmMap(sqlite3_file *file, int iPage, int pgsz, int isWrite, void volatile **pp)
+{
+  int res;
+  SHIMFILE;
+
+  /* the database is now in wal mode */
+  res = apswshim_settle(f);
+  f->shm = 1;
+  if (f->cache && f->cacheable)
+  {
+    sqlite3_mutex_enter(f->shim->mutex);
+    apswshim_cache_clear(f->cache);
+    f->cache->header_valid = 0;
+    sqlite3_mutex_leave(f->shim->mutex);
+  }
+  f->cacheable = 0;
+  if (res == SQLITE_OK)
+    res = real->pMethods->xShmMap(real, iPage, pgsz, isWrite, pp);
+  return res;
+}
+
+static int
+apswshim_xShmLock(sqlite3_file *file, int offset, int n, int flags)
+{
+  SHIMFILE;
+
+  /* a wal transaction is starting or ending, so a checkpoint could
+     have changed the database file */
+  f->ra_len = 0;
+  /* others must be able to read the wal once it is unlocked.  The wal
+     is a different file so everything queued is waited for. */
+  if (flags & SQLITE_SHM_UNLOCK)
+    apswshim_wb_wait(f->shim, NULL, 0);
+  return real->pMethods->xShmLock(real, offset, n, flags);
+}
+
+static void
+apswshim_xShmBarrier(sqlite3_file *file)
+{
+  SHIMFILE;
+  /* the wal index header is about to say the new frames are there */
+  apswshim_wb_wait(f->shim, NULL, 0);
+  real->pMethods->xShmBarrier(real);
+}
+
+static int
+apswshim_xShmUnmap(sqlite3_file *file, int deleteFlag)
+{
+  SHIMFILE;
+  return real->pMethods->xShmUnmap(real, deleteFlag);
+}
+
+static int
+apswshim_xFetch(sqlite3_file *file, sqlite3_int64 offset, int amount, void **pp)
+{
+  int res;
+  SHIMFILE;
+
+  res = apswshim_settle(f);
+  if (res == SQLITE_OK)
+    res = real->pMethods->xFetch(real, offset, amount, pp);
+  return res;
+}
+
+static int
+apswshim_xUnfetch(sqlite3_file *file, sqlite3_int64 offset, void *p)
+{
+  SHIMFILE;
+  return real->pMethods->xUnfetch(real, offset, p);
+}
+
+/* the version used matches the base file */
+static const struct sqlite3_io_methods apswshim_io_methods[3] = {
+    {1, apswshim_xClose, apswshim_xRead, apswshim_xWrite, apswshim_xTruncate, apswshim_xSync, apswshim_xFileSize,
+     apswshim_xLock, apswshim_xUnlock, apswshim_xCheckReservedLock, apswshim_xFileControl, apswshim_xSectorSize,
+     apswshim_xDeviceCharacteristics, 0, 0, 0, 0, 0, 0},
+    {2, apswshim_xClose, apswshim_xRead, apswshim_xWrite, apswshim_xTruncate, apswshim_xSync, apswshim_xFileSize,
+     apswshim_xLock, apswshim_xUnlock, apswshim_xCheckReservedLock, apswshim_xFileControl, apswshim_xSectorSize,
+     apswshim_xDeviceCharacteristics, apswshim_xShmMap, apswshim_xShmLock, apswshim_xShmBarrier, apswshim_xShmUnmap,
+     0, 0},
+    {3, apswshim_xClose, apswshim_xRead, apswshim_xWrite, apswshim_xTruncate, apswshim_xSync, apswshim_xFileSize,
+     apswshim_xLock, apswshim_xUnlock, apswshim_xCheckReservedLock, apswshim_xFileControl, apswshim_xSectorSize,
+     apswshim_xDeviceCharacteristics, apswshim_xShmMap, apswshim_xShmLock, apswshim_xShmBarrier, apswshim_xShmUnmap,
+     apswshim_xFetch, apswshim_xUnfetch},
+};
+
+/* vfs methods */
+
+/* APSWShim and APSWComp both start with this, so the vfs methods that
+   only call the base are shared */
+typedef struct
+{
+  sqlite3_vfs vfs;
+  sqlite3_vfs *basevfs;
+} APSWVFSLayer;
+
+#define SHIMBASE (((APSWVFSLayer *)(vfs->pAppData))->basevfs)
+
+static int
+apswshimvfs_xOpen(sqlite3_vfs *vfs, const char *zName, sqlite3_file *file, int flags, int *pOutFlags)
+{
+  APSWShim *shim = (APSWShim *)(vfs->pAppData);
+  APSWShimFile *f = (APSWShimFile *)file;
+  int res, version;
+
+  memset(f, 0, sizeof(APSWShimFile));
+  f->shim = shim;
+  f->real = (sqlite3_file *)((char *)f + SHIMFILESIZE);
+  f->openflags = flags;
+  f->name = zName;
+
+  res = shim->basevfs->xOpen(shim->basevfs, zName, f->real, flags, pOutFlags);
+  /* sqlite will call xClose if pMethods is set even if the open failed */
+  if (!f->real->pMethods)
+    return res;
+
+  version = f->real->pMethods->iVersion;
+  if (version >= 3 && f->real->pMethods->xShmMap && f->real->pMethods->xFetch)
+    version = 3;
+  else if (version >= 2 && f->real->pMethods->xShmMap)
+    version = 2;
+  else
+    version = 1;
+  f->pMethods = &apswshim_io_methods[version - 1];
+
+  if (shim->cache_pages && zName && (flags & SQLITE_OPEN_MAIN_DB))
+    f->cache = apswshim_cache_acquire(shim, zName);
+
+  sqlite3_mutex_enter(shim->mutex);
+  shim->refs++;
+  shim->stats.opens++;
+  sqlite3_mutex_leave(shim->mutex);
+  return res;
+}
+
+static int
+apswshimvfs_xDelete(sqlite3_vfs *vfs, const char *zName, int syncDir)
+{
+  /* eg a journal must not go before the database is synced */
+  apswshim_wb_wait((APSWShim *)(vfs->pAppData), NULL, 1);
+  return SHIMBASE->xDelete(SHIMBASE, zName, syncDir);
+}
+
+static int
+apswshimvfs_xAccess(sqlite3_vfs *vfs, const char *zName, int flags, int *pResOut)
+{
+  return SHIMBASE->xAccess(SHIMBASE, zName, flags, pResOut);
+}
+
+static int
+apswshimvfs_xFullPathname(sqlite3_vfs *vfs, const char *zName, int nOut, char *zOut)
+{
+  return SHIMBASE->xFullPathname(SHIMBASE, zName, nOut, zOut);
+}
+
+static void *
+apswshimvfs_xDlOpen(sqlite3_vfs *vfs, const char *zFilename)
+{
+  return SHIMBASE->xDlOpen(SHIMBASE, zFilename);
+}
+
+static void
+apswshimvfs_xDlError(sqlite3_vfs *vfs, int nByte, char *zErrMsg)
+{
+  SHIMBASE->xDlError(SHIMBASE, nByte, zErrMsg);
+}
+
+static void (*apswshimvfs_xDlSym(sqlite3_vfs *vfs, void *handle, const char *zSymbol))(void)
+{
+  return SHIMBASE->xDlSym(SHIMBASE, handle, zSymbol);
+}
+
+static void
+apswshimvfs_xDlClose(sqlite3_vfs *vfs, void *handle)
+{
+  SHIMBASE->xDlClose(SHIMBASE, handle);
+}
+
+static int
+apswshimvfs_xRandomness(sqlite3_vfs *vfs, int nByte, char *zOut)
+{
+  return SHIMBASE->xRandomness(SHIMBASE, nByte, zOut);
+}
+
+static int
+apswshimvfs_xSleep(sqlite3_vfs *vfs, int microseconds)
+{
+  return SHIMBASE->xSleep(SHIMBASE, microseconds);
+}
+
+static int
+apswshimvfs_xCurrentTime(sqlite3_vfs *vfs, double *julian)
+{
+  return SHIMBASE->xCurrentTime(SHIMBASE, julian);
+}
+
+static int
+apswshimvfs_xGetLastError(sqlite3_vfs *vfs, int nByte, char *zErrMsg)
+{
+  return SHIMBASE->xGetLastError(SHIMBASE, nByte, zErrMsg);
+}
+
+static int
+apswshimvfs_xCurrentTimeInt64(sqlite3_vfs *vfs, sqlite3_int64 *pTime)
+{
+  return SHIMBASE->xCurrentTimeInt64(SHIMBASE, pTime);
+}
+
+static int
+apswshimvfs_xSetSystemCall(sqlite3_vfs *vfs, const char *zName, sqlite3_syscall_ptr call)
+{
+  return SHIMBASE->xSetSystemCall(SHIMBASE, zName, call);
+}
+
+static sqlite3_syscall_ptr
+apswshimvfs_xGetSystemCall(sqlite3_vfs *vfs, const char *zName)
+{
+  return SHIMBASE->xGetSystemCall(SHIMBASE, zName);
+}
+
+static const char *
+apswshimvfs_xNextSystemCall(sqlite3_vfs *vfs, const char *zName)
+{
+  return SHIMBASE->xNextSystemCall(SHIMBASE, zName);
+}
+
+/* fills in a vfs on top of basevfs with methods that call the base,
+   which can then be overridden */
+static void
+apswshim_init_vfs(sqlite3_vfs *vfs, sqlite3_vfs *basevfs, int szfile, const char *name, void *appdata)
+{
+  vfs->iVersion = (basevfs->iVersion < 3) ? basevfs->iVersion : 3;
+  vfs->szOsFile = szfile + basevfs->szOsFile;
+  vfs->mxPathname = basevfs->mxPathname;
+  vfs->zName = name;
+  vfs->pAppData = appdata;
+
+#define METHOD(meth, version)                            \
+  if (basevfs->iVersion >= version && basevfs->x##meth) \
+    vfs->x##meth = apswshimvfs_x##meth;
+
+  METHOD(Open, 1);
+  METHOD(Delete, 1);
+  METHOD(Access, 1);
+  METHOD(FullPathname, 1);
+  METHOD(DlOpen, 1);
+  METHOD(DlError, 1);
+  METHOD(DlSym, 1);
+  METHOD(DlClose, 1);
+  METHOD(Randomness, 1);
+  METHOD(Sleep, 1);
+  METHOD(CurrentTime, 1);
+  METHOD(GetLastError, 1);
+  METHOD(CurrentTimeInt64, 2);
+  METHOD(SetSystemCall, 3);
+  METHOD(GetSystemCall, 3);
+  METHOD(NextSystemCall, 3);
+#undef METHOD
+}
+
+/** .. method:: __init__(name: str, base: str = "", makedefault: bool = False, readahead: int = 0, cache_pages: int = 0, coalesce: int = 0, write_behind: int = 0, sync_delay: float = 0.0)
+
+    :param name: The name to register this shim under.  If the name
+        already exists then this shim will replace the prior one of the
+        same name.
+    :param base: Name of the vfs to add the behaviour on top of.  Use
+        an empty string for the default vfs.
+    :param makedefault: If true then this shim will be registered as
+        the default, and will be used by any opens that don't specify a
+        vfs.
+    :param readahead: How many bytes to read ahead when reads are
+        sequential.  Zero turns it off.  64kb is a good value to try.
+    :param cache_pages: How many pages to keep in the cache of each
+        database file.  Zero turns it off.
+    :param coalesce: Maximum size in bytes of consecutive writes that
+        are gathered together.  Zero turns it off.
+    :param write_behind: Maximum bytes of writes queued for the
+        background thread.  Zero turns it off.  A few megabytes is
+        plenty.
+    :param sync_delay: Seconds a sync can be put off for so it can be
+        combined with others.  Zero means syncs are durable when they
+        return.  Requires *write_behind*.
+
+    :raises ValueError: If the *base* vfs is not registered, one of
+        the sizes is negative, or *sync_delay* is used without
+        *write_behind*.
+
+    -* sqlite3_vfs_register sqlite3_vfs_find
+*/
+static int
+APSWVFSShim_init(APSWVFSShim *self, PyObject *args, PyObject *kwds)
+{
+  const char *name = NULL, *base = "";
+  int makedefault = 0, readahead = 0, cache_pages = 0, coalesce = 0, write_behind = 0, res;
+  double sync_delay = 0.0;
+  sqlite3_vfs *basevfs;
+  APSWShim *shim;
+  size_t namelen;
+
+  {
+    static char *kwlist[] = {"name", "base", "makedefault", "readahead", "cache_pages", "coalesce", "write_behind", "sync_delay", NULL};
+    VFSShim_init_CHECK;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "s|sO&iiiid:" VFSShim_init_USAGE, kwlist, &name, &base, argcheck_bool, &makedefault, &readahead, &cache_pages, &coalesce, &write_behind, &sync_delay))
+      return -1;
+  }
+
+  if (self->shim)
+  {
+    PyErr_Format(PyExc_RuntimeError, "VFSShim is already initialized");
+    return -1;
+  }
+
+  if (readahead < 0 || cache_pages < 0 || coalesce < 0 || write_behind < 0 || !(sync_delay >= 0))
+  {
+    PyErr_Format(PyExc_ValueError, "readahead, cache_pages, coalesce, write_behind, and sync_delay can't be negative");
+    return -1;
+  }
+
+  if (sync_delay > 0 && !write_behind)
+  {
+    PyErr_Format(PyExc_ValueError, "sync_delay requires write_behind");
+    return -1;
+  }
+
+  basevfs = sqlite3_vfs_find(strlen(base) ? base : NULL);
+  if (!basevfs)
+  {
+    PyErr_Format(PyExc_ValueError, "Base vfs named \"%s\" not found", strlen(base) ? base : "<default>");
+    return -1;
+  }
+
+  namelen = strlen(name);
+  shim = sqlite3_malloc64(sizeof(APSWShim) + namelen + 1);
+  if (!shim)
+  {
+    PyErr_NoMemory();
+    return -1;
+  }
+  memset(shim, 0, sizeof(APSWShim));
+  memcpy((char *)(shim + 1), name, namelen + 1);
+  shim->mutex = sqlite3_mutex_alloc(SQLITE_MUTEX_FAST);
+  shim->basevfs = basevfs;
+  shim->refs = 1;
+  shim->readahead = readahead;
+  shim->cache_pages = cache_pages;
+  shim->coalesce = coalesce;
+  shim->write_behind = write_behind;
+  shim->sync_delay = (sqlite3_int64)(sync_delay * 1e9);
+
+  apswshim_init_vfs(&shim->vfs, basevfs, SHIMFILESIZE, (const char *)(shim + 1), shim);
+
+  if (write_behind)
+  {
+    SHIMLOCK_INIT(&shim->wblock);
+    SHIMCOND_INIT(&shim->wbwork);
+    SHIMCOND_INIT(&shim->wbdone);
+    shim->worker = 1;
+    if (PyThread_start_new_thread(apswshim_wb_worker, shim) == PYTHREAD_INVALID_THREAD_ID)
+    {
+      shim->worker = 0;
+      PyErr_Format(PyExc_RuntimeError, "Unable to start the write behind thread");
+      apswshim_release(shim);
+      return -1;
+    }
+  }
+
+  res = sqlite3_vfs_register(&shim->vfs, makedefault);
+  if (res != SQLITE_OK)
+  {
+    SET_EXC(res, NULL);
+    apswshim_release(shim);
+    return -1;
+  }
+  self->shim = shim;
+  self->registered = 1;
+  return 0;
+}
+
+static PyObject *
+APSWVFSShim_new(PyTypeObject *type, PyObject *Py_UNUSED(args), PyObject *Py_UNUSED(kwds))
+{
+  APSWVFSShim *self;
+  self = (APSWVFSShim *)type->tp_alloc(type, 0);
+  if (self)
+  {
+    self->shim = NULL;
+    self->registered = 0;
+  }
+  return (PyObject *)self;
+}
+
+/** .. method:: unregister() -> None
+
+   Unregisters the shim making it unavailable to future database
+   opens.  Databases already open continue to work.  It is
+   automatically unregistered when the :class:`VFSShim` is garbage
+   collected.  It is safe to call this routine multiple times.
+
+   -* sqlite3_vfs_unregister
+*/
+static PyObject *
+APSWVFSShim_unregister(APSWVFSShim *self)
+{
+  if (self->registered)
+  {
+    sqlite3_vfs_unregister(&self->shim->vfs);
+    self->registered = 0;
+  }
+  Py_RETURN_NONE;
+}
+
+static void
+APSWVFSShim_dealloc(APSWVFSShim *self)
+{
+  if (self->shim)
+  {
+    if (self->registered)
+      sqlite3_vfs_unregister(&self->shim->vfs);
+    apswshim_release(self->shim);
+    self->shim = NULL;
+  }
+  Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+/** .. method:: stats() -> Dict[str, Union[int, float]]
+
+  Returns a dict of statistics about all files opened through the
+  shim.  Times are in seconds.
+
+  .. list-table::
+    :widths: auto
+    :header-rows: 1
+
+    * - Key
+      - Explanation
+    * - opens
+      - Files opened
+    * - reads / writes / syncs
+      - Number of calls SQLite made
+    * - read_bytes / write_bytes
+      - Bytes SQLite read and wrote
+    * - read_time / write_time / sync_time
+      - Total time taken by the calls
+    * - read_max / write_max / sync_max
+      - The longest time taken by one call
+    * - cache_hits
+      - Reads satisfied from the page cache
+    * - cache_misses
+      - Reads that could use the page cache but weren't found in it
+    * - readahead_hits
+      - Reads satisfied from data read ahead
+    * - base_reads / base_writes
+      - Reads and writes done on the underlying vfs.  Compare these
+        with *reads* and *writes* to see how effective the read ahead,
+        cache and coalescing are.
+    * - queued_writes
+      - Writes that went through the write behind queue
+    * - queue_max
+      - The most bytes there have been in the queue
+    * - queue_waits
+      - How often a write had to wait for room in the queue
+    * - sync_requests
+      - Syncs that went through the queue
+    * - sync_batches / sync_batch_max
+      - Syncs of the underlying vfs done for them, and the most
+        requests done by one sync
+    * - sync_latency / sync_latency_max
+      - Total and longest time from a sync being requested until it
+        was done
+    * - background_errors
+      - Queued writes and syncs that failed
+*/
+static PyObject *
+APSWVFSShim_stats(APSWVFSShim *self)
+{
+  APSWShimStats stats;
+  APSWShimWBStats wbstats;
+
+  if (!self->shim)
+    return PyErr_Format(PyExc_ValueError, "VFSShim has not been initialized");
+
+  sqlite3_mutex_enter(self->shim->mutex);
+  stats = self->shim->stats;
+  sqlite3_mutex_leave(self->shim->mutex);
+  memset(&wbstats, 0, sizeof(wbstats));
+  if (self->shim->write_behind)
+  {
+    SHIMLOCK_ENTER(&self->shim->wblock);
+    wbstats = self->shim->wbstats;
+    SHIMLOCK_LEAVE(&self->shim->wblock);
+  }
+
+  return Py_BuildValue("{s: L, s: L, s: d, s: d, s: L, s: L, s: d, s: d, s: L, s: d, s: d, s: L, s: L, s: L, s: L, s: L, s: L,"
+                       " s: L, s: L, s: L, s: L, s: L, s: L, s: d, s: d, s: L}",
+                       "reads", stats.read.calls, "read_bytes", stats.read.bytes,
+                       "read_time", stats.read.ns / 1e9, "read_max", stats.read.maxns / 1e9,
+                       "writes", stats.write.calls, "write_bytes", stats.write.bytes,
+                       "write_time", stats.write.ns / 1e9, "write_max", stats.write.maxns / 1e9,
+                       "syncs", stats.sync.calls, "sync_time", stats.sync.ns / 1e9, "sync_max", stats.sync.maxns / 1e9,
+                       "opens", stats.opens, "cache_hits", stats.cache_hits, "cache_misses", stats.cache_misses,
+                       "readahead_hits", stats.readahead_hits, "base_reads", stats.base_reads,
+                       "base_writes", stats.base_writes,
+                       "queued_writes", wbstats.queued_writes, "queue_max", wbstats.queue_max,
+                       "queue_waits", wbstats.queue_waits, "sync_requests", wbstats.sync_requests,
+                       "sync_batches", wbstats.sync_batches, "sync_batch_max", wbstats.sync_batch_max,
+                       "sync_latency", wbstats.sync_latency.ns / 1e9, "sync_latency_max", wbstats.sync_latency.maxns / 1e9,
+                       "background_errors", wbstats.background_errors);
+}
+
+/** .. method:: reset_stats() -> None
+
+  Sets all the :meth:`statistics <VFSShim.stats>` back to zero.
+*/
+static PyObject *
+APSWVFSShim_reset_stats(APSWVFSShim *self)
+{
+  if (!self->shim)
+    return PyErr_Format(PyExc_ValueError, "VFSShim has not been initialized");
+
+  sqlite3_mutex_enter(self->shim->mutex);
+  memset(&self->shim->stats, 0, sizeof(self->shim->stats));
+  sqlite3_mutex_leave(self->shim->mutex);
+  if (self->shim->write_behind)
+  {
+    SHIMLOCK_ENTER(&self->shim->wblock);
+    memset(&self->shim->wbstats, 0, sizeof(self->shim->wbstats));
+    SHIMLOCK_LEAVE(&self->shim->wblock);
+  }
+  Py_RETURN_NONE;
+}
+
+/** .. method:: flush() -> None
+
+  Waits until all the writes queued by *write_behind* have been made,
+  and the syncs requested so far have been done.  Returns immediately
+  if write behind isn't used.
+*/
+static PyObject *
+APSWVFSShim_flush(APSWVFSShim *self)
+{
+  if (!self->shim)
+    return PyErr_Format(PyExc_ValueError, "VFSShim has not been initialized");
+
+  Py_BEGIN_ALLOW_THREADS
+      apswshim_wb_wait(self->shim, NULL, 1);
+  Py_END_ALLOW_THREADS;
+  Py_RETURN_NONE;
+}
+
+static PyMethodDef APSWVFSShim_methods[] = {
+    {"stats", (PyCFunction)APSWVFSShim_stats, METH_NOARGS, VFSShim_stats_DOC},
+    {"reset_stats", (PyCFunction)APSWVFSShim_reset_stats, METH_NOARGS, VFSShim_reset_stats_DOC},
+    {"flush", (PyCFunction)APSWVFSShim_flush, METH_NOARGS, VFSShim_flush_DOC},
+    {"unregister", (PyCFunction)APSWVFSShim_unregister, METH_NOARGS, VFSShim_unregister_DOC},
+    /* Sentinel */
+    {0, 0, 0, 0}};
+
+static PyTypeObject APSWVFSShimType =
+    {
+        PyVarObject_HEAD_INIT(NULL, 0) "apsw.VFSShim",                          /*tp_name*/
+        sizeof(APSWVFSShim),                                                    /*tp_basicsize*/
+        0,                                                                      /*tp_itemsize*/
+        (destructor)APSWVFSShim_dealloc,                                        /*tp_dealloc*/
+        0,                                                                      /*tp_print*/
+        0,                                                                      /*tp_getattr*/
+        0,                                                                      /*tp_setattr*/
+        0,                                                                      /*tp_compare*/
+        0,                                                                      /*tp_repr*/
+        0,                                                                      /*tp_as_number*/
+        0,                                                                      /*tp_as_sequence*/
+        0,                                                                      /*tp_as_mapping*/
+        0,                                                                      /*tp_hash */
+        0,                                                                      /*tp_call*/
+        0,                                                                      /*tp_str*/
+        0,                                                                      /*tp_getattro*/
+        0,                                                                      /*tp_setattro*/
+        0,                                                                      /*tp_as_buffer*/
+        Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE | Py_TPFLAGS_HAVE_VERSION_TAG, /*tp_flags*/
+        VFSShim_init_DOC,                                                       /* tp_doc */
+        0,                                                                      /* tp_traverse */
+        0,                                                                      /* tp_clear */
+        0,                                                                      /* tp_richcompare */
+        0,                                                                      /* tp_weaklistoffset */
+        0,                                                                      /* tp_iter */
+        0,                                                                      /* tp_iternext */
+        APSWVFSShim_methods,                                                    /* tp_methods */
+        0,                                                                      /* tp_members */
+        0,                                                                      /* tp_getset */
+        0,                                                                      /* tp_base */
+        0,                                                                      /* tp_dict */
+        0,                                                                      /* tp_descr_get */
+        0,                                                                      /* tp_descr_set */
+        0,                                                                      /* tp_dictoffset */
+        (initproc)APSWVFSShim_init,                                             /* tp_init */
+        0,                                                                      /* tp_alloc */
+        APSWVFSShim_new,                                                        /* tp_new */
+        0,                                                                      /* tp_free */
+        0,                                                                      /* tp_is_gc */
+        0,                                                                      /* tp_bases */
+        0,                                                                      /* tp_mro */
+        0,                                                                      /* tp_cache */
+        0,                                                                      /* tp_subclasses */
+        0,                                                                      /* tp_weaklist */
+        0,                                                                      /* tp_del */
+        PyType_TRAILER
+};
+
+/** .. class:: VFSCompressed
+
+    A VFS implemented in C that sits on top of another VFS, storing
+    database files compressed.  It is intended for databases that are
+    mostly read and compress well, such as archives and reference
+    data.  Each chunk of the database (by default a page) is
+    compressed separately, so a read only needs to decompress the
+    chunks it covers, and each open database keeps a small cache of
+    decompressed chunks.  Like :class:`VFSShim` it is registered by
+    name, so a :class:`VFS` written in Python can use one as its base.
+
+    .. code-block:: python
+
+      apsw.VFSCompressed("compressed")
+      archive = apsw.Connection("archive.db", vfs="compressed")
+      # copy an existing database in
+      with archive.backup("main", apsw.Connection("file.db"), "main") as b:
+          b.step()
+
+    Chunks are compressed by calling *compress* and *decompress*,
+    which default to :func:`zlib.compress` and :func:`zlib.decompress`.
+    Any pair of functions taking and returning bytes can be used, such
+    as those from the zstandard and lz4 packages.  They are called
+    with the GIL held.
+
+    Only main database files are compressed.  Journals and other files
+    are handled by the base vfs as is, and existing databases that are
+    not compressed are opened directly with the base vfs.  There are
+    no shared memory methods, so :ref:`WAL mode <wal>` can only be used
+    with ``PRAGMA locking_mode=EXCLUSIVE``.
+
+    Changes are written to space not used by the last commit, and
+    become part of the file in one step when SQLite syncs the database
+    (or unlocks it if syncs are turned off).  A crash leaves the file
+    as of the last commit, which SQLite's journal then rolls back as
+    usual.  Space no longer used is reused, and the file is truncated
+    when there is none at the end.
+
+    File format
+      All integers are big endian.  There are two 64 byte headers, at
+      offset 0 and 512, with the valid one with the highest generation
+      being current.  Each commit writes the other one.
+
+      .. list-table::
+        :widths: auto
+        :header-rows: 1
+
+        * - Offset
+          - Size
+          - Contents
+        * - 0
+          - 16
+          - ``APSW compressed`` followed by a zero byte
+        * - 16
+          - 4
+          - Format version which is 1
+        * - 20
+          - 4
+          - Chunk size
+        * - 24
+          - 8
+          - Generation, increased by each commit
+        * - 32
+          - 8
+          - Size of the uncompressed database
+        * - 40
+          - 8
+          - Offset of the directory, zero if empty
+        * - 48
+          - 12
+          - Zero
+        * - 60
+          - 4
+          - 32 bit FNV-1a hash of the preceding 60 bytes
+
+      The directory has an 8 byte offset for each index block, or zero
+      if all its entries are zero.  An index block has 256 entries each
+      of an 8 byte offset and 4 byte length, being where the chunk is
+      stored and how long it is.  A length the same as the chunk size
+      means the chunk is stored without compression, and an offset of
+      zero means the chunk is all zeroes.  Space after the headers is
+      allocated in multiples of 512 bytes.
+*/
+
+#define COMP_MAGIC "APSW compressed" /* including the terminating null is 16 bytes */
+#define COMP_HEADER 64               /* bytes in a header */
+#define COMP_SLOT 512                /* the second header is at this offset */
+#define COMP_START 1024              /* where the data can start */
+#define COMP_UNIT 512                /* space is allocated in multiples of this */
+#define COMP_PERBLOCK 256            /* entries in an index block */
+#define COMP_ENTRY 12                /* bytes for an entry */
+#define COMP_BLOCKSIZE (COMP_PERBLOCK * COMP_ENTRY)
+
+#define COMP_ROUND(n) (((n) + COMP_UNIT - 1) & ~(sqlite3_int64)(COMP_UNIT - 1))
+
+typedef struct
+{
+  sqlite3_vfs vfs; /* what sqlite uses with pAppData pointing back here */
+  sqlite3_vfs *basevfs;
+  sqlite3_mutex *mutex; /* protects refs */
+  int refs;             /* Python object and open files */
+  int chunk_size;       /* zero to use the page size */
+  int cache_chunks;
+  PyObject *compress, *decompress;
+} APSWComp;
+
+typedef struct
+{
+  sqlite3_int64 offset; /* zero if the chunk is all zeroes */
+  int length;
+} APSWCompEntry;
+
+typedef struct
+{
+  sqlite3_int64 offset, length;
+} APSWCompExtent;
+
+typedef struct
+{
+  APSWCompExtent *extents;
+  int count, allocated;
+} APSWCompExtents;
+
+typedef struct
+{
+  sqlite3_int64 chunk; /* -1 if not in use */
+  sqlite3_int64 used;  /* when last used for least recently used eviction */
+  int dirty;
+  unsigned char *data;
+} APSWCompCached;
+
+typedef struct /* inherits */
+{
+  const struct sqlite3_io_methods *pMethods;
+  APSWComp *comp;
+  sqlite3_file *real; /* base file which is allocated after this structure */
+  int lock;
+
+  /* what the in memory state was loaded from */
+  int loaded;
+  sqlite3_int64 generation;
+  int slot;
+
+  int chunk_size; /* zero until the first write to an empty file */
+  sqlite3_int64 size;
+  int changed; /* since the last commit */
+
+  /* index */
+  APSWCompEntry *index;
+  sqlite3_int64 *blocks; /* offset of each index block */
+  unsigned char *blockdirty;
+  sqlite3_int64 allocated; /* entries in index */
+  sqlite3_int64 diroffset, dirlength;
+
+  /* space */
+  APSWCompExtents free;    /* sorted, and not used by the last commit */
+  APSWCompExtents pending; /* used by the last commit, so free after the next */
+  sqlite3_int64 end;       /* of the used space */
+
+  /* decompressed chunks */
+  APSWCompCached *cache;
+  int ncache, ndirty;
+  sqlite3_int64 usecounter;
+  unsigned char *buffer; /* chunk_size bytes of compressed data */
+} APSWCompFile;
+
+#define COMPFILESIZE ((int)((sizeof(APSWCompFile) + 7) & ~(size_t)7))
+
+#define COMPNCHUNKS(f) (((f)->size + (f)->chunk_size - 1) / (f)->chunk_size)
+#define COMPNBLOCKS(f) ((COMPNCHUNKS(f) + COMP_PERBLOCK - 1) / COMP_PERBLOCK)
+
+typedef struct
+{
+  PyObject_HEAD
+      APSWComp *comp;
+  int registered;
+} APSWVFSCompressed;
+
+static PyTypeObject APSWVFSCompressedType;
+
+static void
+apswcomp_release(APSWComp *comp)
+{
+  int last;
+
+  sqlite3_mutex_enter(comp->mutex);
+  last = (0 == --comp->refs);
+  sqlite3_mutex_leave(comp->mutex);
+  if (!last)
+    return;
+  {
+    PyGILState_STATE gilstate = PyGILState_Ensure();
+    Py_XDECREF(comp->compress);
+    Py_XDECREF(comp->decompress);
+    PyGILState_Release(gilstate);
+  }
+  sqlite3_mutex_free(comp->mutex);
+  sqlite3_free(comp);
+}
+
+static unsigned
+apswcomp_get32(const unsigned char *p)
+{
+  return ((unsigned)p[0] << 24) | ((unsigned)p[1] << 16) | ((unsigned)p[2] << 8) | p[3];
+}
+
+static sqlite3_int64
+apswcomp_get64(const unsigned char *p)
+{
+  return (sqlite3_int64)(((sqlite3_uint64)apswcomp_get32(p) << 32) | apswcomp_get32(p + 4));
+}
+
+static void
+apswcomp_put32(unsigned char *p, unsigned v)
+{
+  p[0] = (unsigned char)(v >> 24);
+  p[1] = (unsigned char)(v >> 16);
+  p[2] = (unsigned char)(v >> 8);
+  p[3] = (unsigned char)v;
+}
+
+static void
+apswcomp_put64(unsigned char *p, sqlite3_int64 v)
+{
+  apswcomp_put32(p, (unsigned)((sqlite3_uint64)v >> 32));
+  apswcomp_put32(p + 4, (unsigned)v);
+}
+
+static unsigned
+apswcomp_checksum(const unsigned char *p, int len)
+{
+  unsigned hash = 2166136261u;
+
+  while (len--)
+    hash = (hash ^ *p++) * 16777619u;
+  return hash;
+}
+
+/* Calls compress or decompress with len bytes of data.  The result is
+   copied to out if it is no more than outsize bytes, and *outlen set
+   to its length either way.  Returns errcode if there was an
+   exception, which is reported as unraisable. */
+static int
+apswcomp_transform(PyObject *callable, const char *name, int errcode, const void *data, int len, void *out, int outsize, sqlite3_int64 *outlen)
+{
+  PyGILState_STATE gilstate = PyGILState_Ensure();
+  PyObject *input = NULL, *result = NULL;
+  Py_buffer view;
+  int res = SQLITE_OK;
+
+  input = PyBytes_FromStringAndSize(data, len);
+  if (input)
+    result = PyObject_CallFunctionObjArgs(callable, input, NULL);
+  if (result && 0 == PyObject_GetBuffer(result, &view, PyBUF_SIMPLE))
+  {
+    *outlen = view.len;
+    if (view.len <= outsize)
+      memcpy(out, view.buf, view.len);
+    PyBuffer_Release(&view);
+  }
+  if (PyErr_Occurred())
+  {
+    AddTraceBackHere(__FILE__, __LINE__, name, "{s: i, s: O}", "length", len, "result", OBJ(result));
+    apsw_write_unraiseable(NULL);
+    res = errcode;
+  }
+  Py_XDECREF(input);
+  Py_XDECREF(result);
+  PyGILState_Release(gilstate);
+  return res;
+}
+
+/* Space management */
+
+static int
+apswcomp_extents_insert(APSWCompExtents *x, int at, sqlite3_int64 offset, sqlite3_int64 length)
+{
+  if (x->count == x->allocated)
+  {
+    int allocated = x->allocated ? x->allocated * 2 : 16;
+    APSWCompExtent *extents = sqlite3_realloc64(x->extents, sizeof(APSWCompExtent) * allocated);
+    if (!extents)
+      return SQLITE_NOMEM;
+    x->extents = extents;
+    x->allocated = allocated;
+  }
+  memmove(x->extents + at + 1, x->extents + at, sizeof(APSWCompExtent) * (x->count - at));
+  x->extents[at].offset = offset;
+  x->extents[at].length = length;
+  x->count++;
+  return SQLITE_OK;
+}
+
+static void
+apswcomp_extents_remove(APSWCompExtents *x, int at)
+{
+  x->count--;
+  memmove(x->extents + at, x->extents + at + 1, sizeof(APSWCompExtent) * (x->count - at));
+}
+
+/* adds to the free list, merging with neighbours */
+static int
+apswcomp_free_add(APSWCompFile *f, sqlite3_int64 offset, sqlite3_int64 length)
+{
+  APSWCompExtents *x = &f->free;
+  int lo = 0, hi = x->count;
+
+  while (lo < hi)
+  {
+    int mid = (lo + hi) / 2;
+    if (x->extents[mid].offset < offset)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  if (lo > 0 && x->extents[lo - 1].offset + x->extents[lo - 1].length == offset)
+  {
+    x->extents[lo - 1].length += length;
+    if (lo < x->count && x->extents[lo - 1].offset + x->extents[lo - 1].length == x->extents[lo].offset)
+    {
+      x->extents[lo - 1].length += x->extents[lo].length;
+      apswcomp_extents_remove(x, lo);
+    }
+    return SQLITE_OK;
+  }
+  if (lo < x->count && offset + length == x->extents[lo].offset)
+  {
+    x->extents[lo].offset = offset;
+    x->extents[lo].length += length;
+    return SQLITE_OK;
+  }
+  return apswcomp_extents_insert(x, lo, offset, length);
+}
+
+/* finds space for length bytes, first fit */
+static sqlite3_int64
+apswcomp_alloc(APSWCompFile *f, sqlite3_int64 length)
+{
+  sqlite3_int64 offset;
+  int i;
+
+  length = COMP_ROUND(length);
+  for (i = 0; i < f->free.count; i++)
+  {
+    APSWCompExtent *e = &f->free.extents[i];
+    if (e->length >= length)
+    {
+      offset = e->offset;
+      e->offset += length;
+      e->length -= length;
+      if (!e->length)
+        apswcomp_extents_remove(&f->free, i);
+      return offset;
+    }
+  }
+  offset = f->end;
+  f->end += length;
+  return offset;
+}
+
+/* space that can be reused once the next commit is done */
+static int
+apswcomp_unused(APSWCompFile *f, sqlite3_int64 offset, sqlite3_int64 length)
+{
+  if (!offset)
+    return SQLITE_OK;
+  return apswcomp_extents_insert(&f->pending, f->pending.count, offset, COMP_ROUND(length));
+}
+
+/* makes room in the index for nchunks */
+static int
+apswcomp_grow(APSWCompFile *f, sqlite3_int64 nchunks)
+{
+  sqlite3_int64 allocated = f->allocated ? f->allocated : COMP_PERBLOCK, nblocks, oldblocks = f->allocated / COMP_PERBLOCK;
+  void *p;
+
+  if (nchunks <= f->allocated)
+    return SQLITE_OK;
+  while (allocated < nchunks)
+    allocated *= 2;
+  nblocks = allocated / COMP_PERBLOCK;
+
+  p = sqlite3_realloc64(f->index, sizeof(APSWCompEntry) * allocated);
+  if (!p)
+    return SQLITE_NOMEM;
+  f->index = p;
+  memset(f->index + f->allocated, 0, sizeof(APSWCompEntry) * (allocated - f->allocated));
+  p = sqlite3_realloc64(f->blocks, sizeof(sqlite3_int64) * nblocks);
+  if (!p)
+    return SQLITE_NOMEM;
+  f->blocks = p;
+  memset(f->blocks + oldblocks, 0, sizeof(sqlite3_int64) * (nblocks - oldblocks));
+  p = sqlite3_realloc64(f->blockdirty, nblocks);
+  if (!p)
+    return SQLITE_NOMEM;
+  f->blockdirty = p;
+  memset(f->blockdirty + oldblocks, 0, nblocks - oldblocks);
+  f->allocated = allocated;
+  return SQLITE_OK;
+}
+
+/* Chunks */
+
+static int
+apswcomp_readchunk(APSWCompFile *f, sqlite3_int64 chunk, unsigned char *data)
+{
+  APSWCompEntry *entry = f->index + chunk;
+  sqlite3_int64 outlen = 0;
+  int res;
+
+  if (chunk >= f->allocated || !entry->offset)
+  {
+    memset(data, 0, f->chunk_size);
+    return SQLITE_OK;
+  }
+  if (entry->length == f->chunk_size)
+    res = f->real->pMethods->xRead(f->real, data, f->chunk_size, entry->offset);
+  else
+    res = f->real->pMethods->xRead(f->real, f->buffer, entry->length, entry->offset);
+  if (res == SQLITE_IOERR_SHORT_READ)
+    return SQLITE_CORRUPT;
+  if (res != SQLITE_OK || entry->length == f->chunk_size)
+    return res;
+
+  res = apswcomp_transform(f->comp->decompress, "VFSCompressed.decompress", SQLITE_IOERR_READ, f->buffer, entry->length, data, f->chunk_size, &outlen);
+  if (res == SQLITE_OK && outlen != f->chunk_size)
+    res = SQLITE_CORRUPT;
+  return res;
+}
+
+static int
+apswcomp_writechunk(APSWCompFile *f, APSWCompCached *cached)
+{
+  APSWCompEntry *entry = f->index + cached->chunk;
+  sqlite3_int64 outlen = 0, offset;
+  int res;
+
+  res = apswcomp_transform(f->comp->compress, "VFSCompressed.compress", SQLITE_IOERR_WRITE, cached->data, f->chunk_size, f->buffer, f->chunk_size - 1, &outlen);
+  if (res != SQLITE_OK)
+    return res;
+  /* store as is if it didn't get smaller */
+  if (outlen >= f->chunk_size)
+    outlen = f->chunk_size;
+  else if (!outlen)
+    return SQLITE_IOERR_WRITE;
+
+  offset = apswcomp_alloc(f, outlen);
+  res = f->real->pMethods->xWrite(f->real, (outlen == f->chunk_size) ? cached->data : f->buffer, (int)outlen, offset);
+  if (res == SQLITE_OK)
+    res = apswcomp_unused(f, entry->offset, entry->length);
+  if (res != SQLITE_OK)
+  {
+    apswcomp_unused(f, offset, outlen);
+    return res;
+  }
+  entry->offset = offset;
+  entry->length = (int)outlen;
+  f->blockdirty[cached->chunk / COMP_PERBLOCK] = 1;
+  cached->dirty = 0;
+  f->ndirty--;
+  return SQLITE_OK;
+}
+
+static int
+apswcomp_writedirty(APSWCompFile *f)
+{
+  int i, res;
+
+  for (i = 0; i < f->ncache && f->ndirty; i++)
+    if (f->cache[i].dirty)
+    {
+      res = apswcomp_writechunk(f, &f->cache[i]);
+      if (res != SQLITE_OK)
+        return res;
+    }
+  return SQLITE_OK;
+}
+
+/* gets the chunk from the cache, reading it in unless it will all be
+   overwritten */
+static int
+apswcomp_chunk(APSWCompFile *f, sqlite3_int64 chunk, int overwrite, APSWCompCached **pcached)
+{
+  APSWCompCached *cached = NULL;
+  int i, res;
+
+  for (i = 0; i < f->ncache; i++)
+  {
+    if (f->cache[i].chunk == chunk)
+    {
+      cached = &f->cache[i];
+      cached->used = ++f->usecounter;
+      *pcached = cached;
+      return SQLITE_OK;
+    }
+    if (f->cache[i].chunk < 0)
+      cached = &f->cache[i];
+  }
+
+  /* dirty chunks don't count against the cache size */
+  if (!cached && f->ncache - f->ndirty >= f->comp->cache_chunks)
+    for (i = 0; i < f->ncache; i++)
+      if (!f->cache[i].dirty && (!cached || f->cache[i].used < cached->used))
+        cached = &f->cache[i];
+
+  if (!cached)
+  {
+    unsigned char *data = sqlite3_malloc64(f->chunk_size);
+    APSWCompCached *cache = data ? sqlite3_realloc64(f->cache, sizeof(APSWCompCached) * (f->ncache + 1)) : NULL;
+    if (!cache)
+    {
+      sqlite3_free(data);
+      return SQLITE_NOMEM;
+    }
+    f->cache = cache;
+    cached = &f->cache[f->ncache++];
+    cached->data = data;
+    cached->dirty = 0;
+  }
+
+  cached->chunk = -1;
+  if (!overwrite)
+  {
+    res = apswcomp_readchunk(f, chunk, cached->data);
+    if (res != SQLITE_OK)
+      return res;
+  }
+  cached->chunk = chunk;
+  cached->used = ++f->usecounter;
+  *pcached = cached;
+  return SQLITE_OK;
+}
+
+/* forgets everything in memory */
+static void
+apswcomp_reset(APSWCompFile *f)
+{
+  int i;
+
+  for (i = 0; i < f->ncache; i++)
+    sqlite3_free(f->cache[i].data);
+  sqlite3_free(f->cache);
+  f->cache = NULL;
+  f->ncache = f->ndirty = 0;
+  sqlite3_free(f->buffer);
+  f->buffer = NULL;
+  if (f->allocated)
+  {
+    memset(f->index, 0, sizeof(APSWCompEntry) * f->allocated);
+    memset(f->blocks, 0, sizeof(sqlite3_int64) * (f->allocated / COMP_PERBLOCK));
+    memset(f->blockdirty, 0, f->allocated / COMP_PERBLOCK);
+  }
+  f->free.count = f->pending.count = 0;
+  f->loaded = f->changed = 0;
+  f->chunk_size = 0;
+  f->size = f->diroffset = f->dirlength = f->generation = 0;
+  f->end = COMP_START;
+}
+
+static int
+apswcomp_setchunksize(APSWCompFile *f, int chunk_size)
+{
+  f->chunk_size = chunk_size;
+  f->buffer = sqlite3_malloc64(chunk_size);
+  return f->buffer ? SQLITE_OK : SQLITE_NOMEM;
+}
+
+static int
+apswcomp_compareextent(const void *a, const void *b)
+{
+  sqlite3_int64 x = ((const APSWCompExtent *)a)->offset, y = ((const APSWCompExtent *)b)->offset;
+  return (x < y) ? -1 : (x > y);
+}
+
+/* Reads the index from the current header if it has changed since it
+   was last loaded.  Called with no uncommitted changes. */
+static int
+apswcomp_load(APSWCompFile *f)
+{
+  unsigned char header[COMP_START], *h, *p = NULL;
+  sqlite3_file *real = f->real;
+  sqlite3_int64 generation = 0, nchunks, nblocks, i, j;
+  APSWCompExtents used = {NULL, 0, 0};
+  int res, slot, best = -1, chunk_size;
+
+  assert(!f->changed);
+  memset(header, 0, sizeof(header));
+  res = real->pMethods->xRead(real, header, sizeof(header), 0);
+  if (res != SQLITE_OK && res != SQLITE_IOERR_SHORT_READ)
+    return res;
+
+  for (slot = 0; slot < 2; slot++)
+  {
+    h = header + slot * COMP_SLOT;
+    if (0 == memcmp(h, COMP_MAGIC, sizeof(COMP_MAGIC)) && apswcomp_get32(h + 60) == apswcomp_checksum(h, 60) && (best < 0 || apswcomp_get64(h + 24) > generation))
+    {
+      best = slot;
+      generation = apswcomp_get64(h + 24);
+    }
+  }
+  if (best < 0)
+  {
+    /* nothing has been committed yet */
+    for (i = 0; i < (sqlite3_int64)sizeof(header); i++)
+      if (header[i])
+        return SQLITE_CORRUPT;
+  }
+  else if (f->loaded && generation == f->generation)
+    return SQLITE_OK;
+
+  apswcomp_reset(f);
+  if (best < 0)
+  {
+    f->slot = 1;
+    f->loaded = 1;
+    return SQLITE_OK;
+  }
+
+  h = header + best * COMP_SLOT;
+  chunk_size = (int)apswcomp_get32(h + 20);
+  if (apswcomp_get32(h + 16) != 1 || chunk_size < 512 || chunk_size > 65536 || (chunk_size & (chunk_size - 1)))
+    return SQLITE_CORRUPT;
+  res = apswcomp_setchunksize(f, chunk_size);
+  if (res != SQLITE_OK)
+    goto finally;
+  f->size = apswcomp_get64(h + 32);
+  f->diroffset = apswcomp_get64(h + 40);
+  if (f->size < 0 || (COMPNBLOCKS(f) && !f->diroffset))
+  {
+    res = SQLITE_CORRUPT;
+    goto finally;
+  }
+  nchunks = COMPNCHUNKS(f);
+  nblocks = COMPNBLOCKS(f);
+  res = apswcomp_grow(f, nchunks);
+  if (res != SQLITE_OK)
+    goto finally;
+
+  res = apswcomp_extents_insert(&used, 0, 0, COMP_START);
+  if (nblocks && res == SQLITE_OK)
+  {
+    p = sqlite3_malloc64((nblocks * 8 > COMP_BLOCKSIZE) ? nblocks * 8 : COMP_BLOCKSIZE);
+    if (!p)
+      res = SQLITE_NOMEM;
+    if (res == SQLITE_OK)
+      res = real->pMethods->xRead(real, p, (int)(nblocks * 8), f->diroffset);
+    if (res == SQLITE_OK)
+      res = apswcomp_extents_insert(&used, used.count, f->diroffset, COMP_ROUND(nblocks * 8));
+    f->dirlength = nblocks * 8;
+    for (i = 0; i < nblocks && res == SQLITE_OK; i++)
+      f->blocks[i] = apswcomp_get64(p + i * 8);
+    for (i = 0; i < nblocks && res == SQLITE_OK; i++)
+    {
+      if (!f->blocks[i])
+        continue;
+      res = real->pMethods->xRead(real, p, COMP_BLOCKSIZE, f->blocks[i]);
+      if (res == SQLITE_OK)
+        res = apswcomp_extents_insert(&used, used.count, f->blocks[i], COMP_BLOCKSIZE);
+      for (j = 0; j < COMP_PERBLOCK && i * COMP_PERBLOCK + j < nchunks && res == SQLITE_OK; j++)
+      {
+        APSWCompEntry *entry = f->index + i * COMP_PERBLOCK + j;
+        entry->offset = apswcomp_get64(p + j * COMP_ENTRY);
+        entry->length = (int)apswcomp_get32(p + j * COMP_ENTRY + 8);
+        if (!entry->offset)
+          continue;
+        if (entry->length < 1 || entry->length > chunk_size)
+          res = SQLITE_CORRUPT;
+        else
+          res = apswcomp_extents_insert(&used, used.count, entry->offset, COMP_ROUND(entry->length));
+      }
+    }
+  }
+  if (res == SQLITE_IOERR_SHORT_READ)
+    res = SQLITE_CORRUPT;
+  if (res != SQLITE_OK)
+    goto finally;
+
+  /* everything not used is free */
+  qsort(used.extents, used.count, sizeof(APSWCompExtent), apswcomp_compareextent);
+  for (i = 1; i < used.count && res == SQLITE_OK; i++)
+  {
+    sqlite3_int64 prevend = used.extents[i - 1].offset + used.extents[i - 1].length;
+    if (used.extents[i].offset < prevend)
+      res = SQLITE_CORRUPT;
+    else if (used.extents[i].offset > prevend)
+      res = apswcomp_extents_insert(&f->free, f->free.count, prevend, used.extents[i].offset - prevend);
+  }
+  if (res != SQLITE_OK)
+    goto finally;
+  f->end = used.extents[used.count - 1].offset + used.extents[used.count - 1].length;
+  f->generation = generation;
+  f->slot = best;
+  f->loaded = 1;
+
+finally:
+  sqlite3_free(used.extents);
+  sqlite3_free(p);
+  if (res != SQLITE_OK)
+    apswcomp_reset(f);
+  return res;
+}
+
+/* Makes everything written so far part of the file.  The new index
+   and directory go in unused space, and then the other header slot is
+   written. */
+static int
+apswcomp_commit(APSWCompFile *f, int dosync, int syncflags)
+{
+  sqlite3_file *real = f->real;
+  unsigned char *p = NULL;
+  sqlite3_int64 nblocks, b, offset;
+  int res, i;
+
+  if (!f->changed)
+    return dosync ? real->pMethods->xSync(real, syncflags) : SQLITE_OK;
+
+  res = apswcomp_writedirty(f);
+  if (res != SQLITE_OK)
+    return res;
+
+  nblocks = COMPNBLOCKS(f);
+  p = sqlite3_malloc64((nblocks * 8 > COMP_BLOCKSIZE) ? nblocks * 8 : COMP_BLOCKSIZE);
+  if (!p)
+    return SQLITE_NOMEM;
+
+  for (b = 0; b < nblocks && res == SQLITE_OK; b++)
+  {
+    int empty = 1;
+
+    if (!f->blockdirty[b])
+      continue;
+    for (i = 0; i < COMP_PERBLOCK; i++)
+    {
+      APSWCompEntry *entry = f->index + b * COMP_PERBLOCK + i;
+      apswcomp_put64(p + i * COMP_ENTRY, entry->offset);
+      apswcomp_put32(p + i * COMP_ENTRY + 8, entry->offset ? (unsigned)entry->length : 0);
+      if (entry->offset)
+        empty = 0;
+    }
+    offset = empty ? 0 : apswcomp_alloc(f, COMP_BLOCKSIZE);
+    if (offset)
+      res = real->pMethods->xWrite(real, p, COMP_BLOCKSIZE, offset);
+    if (res == SQLITE_OK)
+      res = apswcomp_unused(f, f->blocks[b], COMP_BLOCKSIZE);
+    if (res != SQLITE_OK)
+    {
+      apswcomp_unused(f, offset, COMP_BLOCKSIZE);
+      break;
+    }
+    f->blocks[b] = offset;
+    f->blockdirty[b] = 0;
+  }
+
+  if (res == SQLITE_OK)
+  {
+    for (b = 0; b < nblocks; b++)
+      apswcomp_put64(p + b * 8, f->blocks[b]);
+    offset = nblocks ? apswcomp_alloc(f, nblocks * 8) : 0;
+    if (offset)
+      res = real->pMethods->xWrite(real, p, (int)(nblocks * 8), offset);
+    if (res == SQLITE_OK)
+      res = apswcomp_unused(f, f->diroffset, f->dirlength);
+    if (res == SQLITE_OK)
+    {
+      f->diroffset = offset;
+      f->dirlength = nblocks * 8;
+    }
+    else
+      apswcomp_unused(f, offset, nblocks * 8);
+  }
+
+  if (res == SQLITE_OK && dosync)
+    res = real->pMethods->xSync(real, syncflags);
+
+  if (res == SQLITE_OK)
+  {
+    memset(p, 0, COMP_HEADER);
+    memcpy(p, COMP_MAGIC, sizeof(COMP_MAGIC));
+    apswcomp_put32(p + 16, 1);
+    apswcomp_put32(p + 20, (unsigned)f->chunk_size);
+    apswcomp_put64(p + 24, f->generation + 1);
+    apswcomp_put64(p + 32, f->size);
+    apswcomp_put64(p + 40, f->diroffset);
+    apswcomp_put32(p + 60, apswcomp_checksum(p, 60));
+    res = real->pMethods->xWrite(real, p, COMP_HEADER, (1 - f->slot) * COMP_SLOT);
+  }
+  if (res == SQLITE_OK && dosync)
+    res = real->pMethods->xSync(real, syncflags);
+  sqlite3_free(p);
+  if (res != SQLITE_OK)
+    return res;
+
+  f->generation++;
+  f->slot = 1 - f->slot;
+  f->changed = 0;
+
+  /* what the previous commit used can now be reused */
+  for (i = 0; i < f->pending.count && res == SQLITE_OK; i++)
+    res = apswcomp_free_add(f, f->pending.extents[i].offset, f->pending.extents[i].length);
+  f->pending.count = 0;
+  if (res == SQLITE_OK && f->free.count && f->free.extents[f->free.count - 1].offset + f->free.extents[f->free.count - 1].length == f->end)
+  {
+    f->end = f->free.extents[--f->free.count].offset;
+    res = real->pMethods->xTruncate(real, f->end);
+  }
+  return res;
+}
+
+/* io methods */
+
+#define COMPFILE                            \
+  APSWCompFile *f = (APSWCompFile *)file; \
+  sqlite3_file *real = f->real;
+
+static int
+apswcomp_xClose(sqlite3_file *file)
+{
+  int res = SQLITE_OK, res2;
+  COMPFILE;
+
+  if (f->changed)
+    res = apswcomp_commit(f, 0, 0);
+  apswcomp_reset(f);
+  sqlite3_free(f->index);
+  sqlite3_free(f->blocks);
+  sqlite3_free(f->blockdirty);
+  sqlite3_free(f->free.extents);
+  sqlite3_free(f->pending.extents);
+  res2 = real->pMethods->xClose(real);
+  apswcomp_release(f->comp);
+  return (res == SQLITE_OK) ? res2 : res;
+}
+
+static int
+apswcomp_xRead(sqlite3_file *file, void *buffer, int amount, sqlite3_int64 offset)
+{
+  unsigned char *out = buffer;
+  APSWCompCached *cached;
+  int res = SQLITE_OK;
+  COMPFILE;
+
+  (void)real;
+  if (!f->loaded)
+  {
+    res = apswcomp_load(f);
+    if (res != SQLITE_OK)
+      return res;
+  }
+
+  while (amount > 0 && offset < f->size)
+  {
+    sqlite3_int64 chunk = offset / f->chunk_size;
+    int within = (int)(offset % f->chunk_size), len = f->chunk_size - within;
+
+    if (len > amount)
+      len = amount;
+    if (len > f->size - offset)
+      len = (int)(f->size - offset);
+    res = apswcomp_chunk(f, chunk, 0, &cached);
+    if (res != SQLITE_OK)
+      return res;
+    memcpy(out, cached->data + within, len);
+    out += len;
+    offset += len;
+    amount -= len;
+  }
+  if (amount > 0)
+  {
+    memset(out, 0, amount);
+    return SQLITE_IOERR_SHORT_READ;
+  }
+  return SQLITE_OK;
+}
+
+static int
+apswcomp_xWrite(sqlite3_file *file, const void *buffer, int amount, sqlite3_int64 offset)
+{
+  const unsigned char *in = buffer;
+  APSWCompCached *cached;
+  int res = SQLITE_OK;
+  COMPFILE;
+
+  (void)real;
+  if (!f->loaded)
+  {
+    res = apswcomp_load(f);
+    if (res != SQLITE_OK)
+      return res;
+  }
+
+  if (!f->chunk_size)
+  {
+    /* use the page size from the database header */
+    int chunk_size = f->comp->chunk_size;
+
+    if (!chunk_size && offset == 0 && amount >= 18)
+    {
+      chunk_size = (in[16] << 8) | in[17];
+      if (chunk_size == 1)
+        chunk_size = 65536;
+      if (chunk_size < 512 || chunk_size > 65536 || (chunk_size & (chunk_size - 1)))
+        chunk_size = 0;
+    }
+    res = apswcomp_setchunksize(f, chunk_size ? chunk_size : 4096);
+    if (res != SQLITE_OK)
+      return res;
+  }
+
+  if (offset + amount > f->size)
+  {
+    res = apswcomp_grow(f, (offset + amount + f->chunk_size - 1) / f->chunk_size);
+    if (res != SQLITE_OK)
+      return res;
+  }
+
+  while (amount > 0)
+  {
+    sqlite3_int64 chunk = offset / f->chunk_size;
+    int within = (int)(offset % f->chunk_size), len = f->chunk_size - within;
+
+    if (len > amount)
+      len = amount;
+    /* a chunk entirely past the end doesn't need reading */
+    res = apswcomp_chunk(f, chunk, len == f->chunk_size || chunk * f->chunk_size >= f->size, &cached);
+    if (res != SQLITE_OK)
+      return res;
+    if (chunk * f->chunk_size >= f->size && len != f->chunk_size)
+      memset(cached->data, 0, f->chunk_size);
+    memcpy(cached->data + within, in, len);
+    if (!cached->dirty)
+    {
+      cached->dirty = 1;
+      f->ndirty++;
+    }
+    f->changed = 1;
+    in += len;
+    offset += len;
+    amount -= len;
+    if (offset > f->size)
+      f->size = offset;
+  }
+
+  if (f->ndirty > f->comp->cache_chunks)
+    res = apswcomp_writedirty(f);
+  return res;
+}
+
+static int
+apswcomp_xTruncate(sqlite3_file *file, sqlite3_int64 size)
+{
+  sqlite3_int64 nchunks, nblocks, i;
+  APSWCompCached *cached;
+  int res = SQLITE_OK;
+  COMPFILE;
+
+  (void)real;
+  if (!f->loaded)
+  {
+    res = apswcomp_load(f);
+    if (res != SQLITE_OK)
+      return res;
+  }
+  if (size == f->size)
+    return SQLITE_OK;
+  if (size > f->size)
+  {
+    /* the tail of the last chunk is already zeroes */
+    if (!f->chunk_size)
+      res = apswcomp_setchunksize(f, f->comp->chunk_size ? f->comp->chunk_size : 4096);
+    if (res == SQLITE_OK)
+      res = apswcomp_grow(f, (size + f->chunk_size - 1) / f->chunk_size);
+    if (res == SQLITE_OK)
+    {
+      f->size = size;
+      f->changed = 1;
+    }
+    return res;
+  }
+
+  nchunks = (size + f->chunk_size - 1) / f->chunk_size;
+  nblocks = (nchunks + COMP_PERBLOCK - 1) / COMP_PERBLOCK;
+
+  for (i = 0; i < f->ncache; i++)
+    if (f->cache[i].chunk >= nchunks)
+    {
+      if (f->cache[i].dirty)
+        f->ndirty--;
+      f->cache[i].dirty = 0;
+      f->cache[i].chunk = -1;
+    }
+  for (i = nchunks; i < COMPNCHUNKS(f) && res == SQLITE_OK; i++)
+  {
+    res = apswcomp_unused(f, f->index[i].offset, f->index[i].length);
+    memset(f->index + i, 0, sizeof(APSWCompEntry));
+    f->blockdirty[i / COMP_PERBLOCK] = 1;
+  }
+  for (i = nblocks; i < COMPNBLOCKS(f) && res == SQLITE_OK; i++)
+  {
+    res = apswcomp_unused(f, f->blocks[i], COMP_BLOCKSIZE);
+    f->blocks[i] = 0;
+    f->blockdirty[i] = 0;
+  }
+  if (res != SQLITE_OK)
+    return res;
+
+  /* the rest of the last chunk must read as zeroes if the file grows
+     again */
+  if (size % f->chunk_size)
+  {
+    res = apswcomp_chunk(f, size / f->chunk_size, 0, &cached);
+    if (res != SQLITE_OK)
+      return res;
+    memset(cached->data + size % f->chunk_size, 0, f->chunk_size - size % f->chunk_size);
+    if (!cached->dirty)
+    {
+      cached->dirty = 1;
+      f->ndirty++;
+    }
+  }
+  f->size = size;
+  f->changed = 1;
+  return SQLITE_OK;
+}
+
+static int
+apswcomp_xSync(sqlite3_file *file, int flags)
+{
+  COMPFILE;
+  (void)real;
+  return apswcomp_commit(f, 1, flags);
+}
+
+static int
+apswcomp_xFileSize(sqlite3_file *file, sqlite3_int64 *pSize)
+{
+  int res;
+  COMPFILE;
+
+  (void)real;
+  if (!f->loaded)
+  {
+    res = apswcomp_load(f);
+    if (res != SQLITE_OK)
+      return res;
+  }
+  *pSize = f->size;
+  return SQLITE_OK;
+}
+
+static int
+apswcomp_xLock(sqlite3_file *file, int level)
+{
+  int res;
+  COMPFILE;
+
+  res = real->pMethods->xLock(real, level);
+  if (res != SQLITE_OK)
+    return res;
+  /* another connection could have committed since we last looked */
+  if (f->lock == SQLITE_LOCK_NONE)
+  {
+    res = apswcomp_load(f);
+    if (res != SQLITE_OK)
+    {
+      real->pMethods->xUnlock(real, SQLITE_LOCK_NONE);
+      return res;
+    }
+  }
+  f->lock = level;
+  return SQLITE_OK;
+}
+
+static int
+apswcomp_xUnlock(sqlite3_file *file, int level)
+{
+  int res = SQLITE_OK, res2;
+  COMPFILE;
+
+  /* there are no syncs with synchronous=OFF */
+  if (level <= SQLITE_LOCK_SHARED && f->changed)
+  {
+    res = apswcomp_commit(f, 0, 0);
+    if (res != SQLITE_OK)
+      apswcomp_reset(f);
+  }
+  res2 = real->pMethods->xUnlock(real, level);
+  if (res2 == SQLITE_OK)
+    f->lock = level;
+  return (res == SQLITE_OK) ? res2 : res;
+}
+
+static int
+apswcomp_xCheckReservedLock(sqlite3_file *file, int *pResOut)
+{
+  COMPFILE;
+  (void)f;
+  return real->pMethods->xCheckReservedLock(real, pResOut);
+}
+
+static int
+apswcomp_xFileControl(sqlite3_file *file, int op, void *pArg)
+{
+  COMPFILE;
+  (void)f;
+  /* these are about the size of the underlying file */
+  if (op == SQLITE_FCNTL_SIZE_HINT || op == SQLITE_FCNTL_CHUNK_SIZE)
+    return SQLITE_NOTFOUND;
+  return real->pMethods->xFileControl(real, op, pArg);
+}
+
+static int
+apswcomp_xSectorSize(sqlite3_file *file)
+{
+  COMPFILE;
+  (void)f;
+  return real->pMethods->xSectorSize(real);
+}
+
+static int
+apswcomp_xDeviceCharacteristics(sqlite3_file *file)
+{
+  COMPFILE;
+  (void)f;
+  /* writes are never in place so atomic and sequential writes of the
+     underlying file don't help */
+  return real->pMethods->xDeviceCharacteristics(real) & (SQLITE_IOCAP_POWERSAFE_OVERWRITE | SQLITE_IOCAP_UNDELETABLE_WHEN_OPEN | SQLITE_IOCAP_IMMUTABLE);
+}
+
+static const struct sqlite3_io_methods apswcomp_io_methods = {
+    1, apswcomp_xClose, apswcomp_xRead, apswcomp_xWrite, apswcomp_xTruncate, apswcomp_xSync, apswcomp_xFileSize,
+    apswcomp_xLock, apswcomp_xUnlock, apswcomp_xCheckReservedLock, apswcomp_xFileControl, apswcomp_xSectorSize,
+    apswcomp_xDeviceCharacteristics, 0, 0, 0, 0, 0, 0};
+
+/* vfs methods */
+
+static int
+apswcompvfs_xOpen(sqlite3_vfs *vfs, const char *zName, sqlite3_file *file, int flags, int *pOutFlags)
+{
+  APSWComp *comp = (APSWComp *)(vfs->pAppData);
+  APSWCompFile *f = (APSWCompFile *)file;
+  unsigned char header[COMP_SLOT + sizeof(COMP_MAGIC)];
+  sqlite3_int64 size = 0;
+  int res;
+
+  /* everything else is opened by the base directly in the space
+     sqlite provided */
+  if (!(flags & SQLITE_OPEN_MAIN_DB))
+    return SHIMBASE->xOpen(SHIMBASE, zName, file, flags, pOutFlags);
+
+  memset(f, 0, sizeof(APSWCompFile));
+  f->comp = comp;
+  f->real = (sqlite3_file *)((char *)f + COMPFILESIZE);
+  f->end = COMP_START;
+
+  res = SHIMBASE->xOpen(SHIMBASE, zName, f->real, flags, pOutFlags);
+  if (!f->real->pMethods)
+    return res;
+  if (res == SQLITE_OK)
+    res = f->real->pMethods->xFileSize(f->real, &size);
+  if (res == SQLITE_OK && size)
+  {
+    memset(header, 0, sizeof(header));
+    res = f->real->pMethods->xRead(f->real, header, sizeof(header), 0);
+    if (res == SQLITE_IOERR_SHORT_READ)
+      res = SQLITE_OK;
+    if (res == SQLITE_OK && memcmp(header, COMP_MAGIC, sizeof(COMP_MAGIC)) && memcmp(header + COMP_SLOT, COMP_MAGIC, sizeof(COMP_MAGIC)))
+    {
+      /* not compressed */
+      f->real->pMethods->xClose(f->real);
+      return SHIMBASE->xOpen(SHIMBASE, zName, file, flags, pOutFlags);
+    }
+  }
+  if (res != SQLITE_OK)
+  {
+    f->real->pMethods->xClose(f->real);
+    return res;
+  }
+
+  f->pMethods = &apswcomp_io_methods;
+  sqlite3_mutex_enter(comp->mutex);
+  comp->refs++;
+  sqlite3_mutex_leave(comp->mutex);
+  return SQLITE_OK;
+}
+
+static int
+apswcompvfs_xDelete(sqlite3_vfs *vfs, const char *zName, int syncDir)
+{
+  return SHIMBASE->xDelete(SHIMBASE, zName, syncDir);
+}
+
+/** .. method:: __init__(name: str, base: str = "", makedefault: bool = False, compress: Optional[Callable[[bytes], bytes]] = None, decompress: Optional[Callable[[bytes], bytes]] = None, chunk_size: int = 0, cache_chunks: int = 32)
+
+    :param name: The name to register this vfs under.  If the name
+        already exists then this vfs will replace the prior one of the
+        same name.
+    :param base: Name of the vfs to store the files with.  Use an
+        empty string for the default vfs.
+    :param makedefault: If true then this vfs will be registered as
+        the default, and will be used by any opens that don't specify a
+        vfs.
+    :param compress: Called with the bytes of a chunk, returning them
+        compressed.  Defaults to :func:`zlib.compress`.
+    :param decompress: Called with what *compress* returned, returning
+        the original bytes.  Defaults to :func:`zlib.decompress`.
+    :param chunk_size: How many bytes of the database are compressed
+        together, which is fixed when a file is created.  Zero uses
+        the page size.  Larger chunks compress better, but more has to
+        be decompressed for each read.
+    :param cache_chunks: How many decompressed chunks are kept for each
+        open database.
+
+    :raises ValueError: If the *base* vfs is not registered,
+        *chunk_size* is not zero or a power of two between 512 and
+        65536, or *cache_chunks* is less than one.
+
+    -* sqlite3_vfs_register sqlite3_vfs_find
+*/
+static int
+APSWVFSCompressed_init(APSWVFSCompressed *self, PyObject *args, PyObject *kwds)
+{
+  const char *name = NULL, *base = "";
+  int makedefault = 0, chunk_size = 0, cache_chunks = 32, res;
+  PyObject *compress = NULL, *decompress = NULL, *zlib = NULL;
+  sqlite3_vfs *basevfs;
+  APSWComp *comp;
+  size_t namelen;
+
+  {
+    static char *kwlist[] = {"name", "base", "makedefault", "compress", "decompress", "chunk_size", "cache_chunks", NULL};
+    VFSCompressed_init_CHECK;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "s|sO&O&O&ii:" VFSCompressed_init_USAGE, kwlist, &name, &base, argcheck_bool, &makedefault, argcheck_Optional_Callable, &compress, argcheck_Optional_Callable, &decompress, &chunk_size, &cache_chunks))
+      return -1;
+  }
+
+  if (self->comp)
+  {
+    PyErr_Format(PyExc_RuntimeError, "VFSCompressed is already initialized");
+    return -1;
+  }
+
+  if (chunk_size && (chunk_size < 512 || chunk_size > 65536 || (chunk_size & (chunk_size - 1))))
+  {
+    PyErr_Format(PyExc_ValueError, "chunk_size must be zero or a power of two between 512 and 65536");
+    return -1;
+  }
+
+  if (cache_chunks < 1)
+  {
+    PyErr_Format(PyExc_ValueError, "cache_chunks must be at least one");
+    return -1;
+  }
+
+  basevfs = sqlite3_vfs_find(strlen(base) ? base : NULL);
+  if (!basevfs)
+  {
+    PyErr_Format(PyExc_ValueError, "Base vfs named \"%s\" not found", strlen(base) ? base : "<default>");
+    return -1;
+  }
+
+  if (!compress || !decompress)
+  {
+    zlib = PyImport_ImportModule("zlib");
+    if (!zlib)
+      return -1;
+  }
+  if (compress)
+    Py_INCREF(compress);
+  else
+    compress = PyObject_GetAttrString(zlib, "compress");
+  if (decompress)
+    Py_INCREF(decompress);
+  else if (compress)
+    decompress = PyObject_GetAttrString(zlib, "decompress");
+  Py_XDECREF(zlib);
+  if (!compress || !decompress)
+    goto error;
+
+  namelen = strlen(name);
+  comp = sqlite3_malloc64(sizeof(APSWComp) + namelen + 1);
+  if (!comp)
+  {
+    PyErr_NoMemory();
+    goto error;
+  }
+  memset(comp, 0, sizeof(APSWComp));
+  memcpy((char *)(comp + 1), name, namelen + 1);
+  comp->mutex = sqlite3_mutex_alloc(SQLITE_MUTEX_FAST);
+  comp->basevfs = basevfs;
+  comp->refs = 1;
+  comp->chunk_size = chunk_size;
+  comp->cache_chunks = cache_chunks;
+  comp->compress = compress;
+  comp->decompress = decompress;
+
+  apswshim_init_vfs(&comp->vfs, basevfs, COMPFILESIZE, (const char *)(comp + 1), comp);
+  comp->vfs.xOpen = apswcompvfs_xOpen;
+  comp->vfs.xDelete = apswcompvfs_xDelete;
+
+  res = sqlite3_vfs_register(&comp->vfs, makedefault);
+  if (res != SQLITE_OK)
+  {
+    SET_EXC(res, NULL);
+    apswcomp_release(comp);
+    return -1;
+  }
+  self->comp = comp;
+  self->registered = 1;
+  return 0;
+
+error:
+  Py_XDECREF(compress);
+  Py_XDECREF(decompress);
+  return -1;
+}
+
+static PyObject *
+APSWVFSCompressed_new(PyTypeObject *type, PyObject *Py_UNUSED(args), PyObject *Py_UNUSED(kwds))
+{
+  APSWVFSCompressed *self;
+  self = (APSWVFSCompressed *)type->tp_alloc(type, 0);
+  if (self)
+  {
+    self->comp = NULL;
+    self->registered = 0;
+  }
+  return (PyObject *)self;
+}
+
+/** .. method:: unregister() -> None
+
+   Unregisters the vfs making it unavailable to future database
+   opens.  Databases already open continue to work.  It is
+   automatically unregistered when the :class:`VFSCompressed` is
+   garbage collected.  It is safe to call this routine multiple
+   times.
+
+   -* sqlite3_vfs_unregister
+*/
+static PyObject *
+APSWVFSCompressed_unregister(APSWVFSCompressed *self)
+{
+  if (self->registered)
+  {
+    sqlite3_vfs_unregister(&self->comp->vfs);
+    self->registered = 0;
+  }
+  Py_RETURN_NONE;
+}
+
+static void
+APSWVFSCompressed_dealloc(APSWVFSCompressed *self)
+{
+  if (self->comp)
+  {
+    if (self->registered)
+      sqlite3_vfs_unregister(&self->comp->vfs);
+    apswcomp_release(self->comp);
+    self->comp = NULL;
+  }
+  Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static PyMethodDef APSWVFSCompressed_methods[] = {
+    {"unregister", (PyCFunction)APSWVFSCompressed_unregister, METH_NOARGS, VFSCompressed_unregister_DOC},
+    /* Sentinel */
+    {0, 0, 0, 0}};
+
+static PyTypeObject APSWVFSCompressedType =
+    {
+        PyVarObject_HEAD_INIT(NULL, 0) "apsw.VFSCompressed",                    /*tp_name*/
+        sizeof(APSWVFSCompressed),                                              /*tp_basicsize*/
+        0,                                                                      /*tp_itemsize*/
+        (destructor)APSWVFSCompressed_dealloc,                                  /*tp_dealloc*/
+        0,                                                                      /*tp_print*/
+        0,                                                                      /*tp_getattr*/
+        0,                                                                      /*tp_setattr*/
+        0,                                                                      /*tp_compare*/
+        0,                                                                      /*tp_repr*/
+        0,                                                                      /*tp_as_number*/
+        0,                                                                      /*tp_as_sequence*/
+        0,                                                                      /*tp_as_mapping*/
+        0,                                                                      /*tp_hash */
+        0,                                                                      /*tp_call*/
+        0,                                                                      /*tp_str*/
+        0,                                                                      /*tp_getattro*/
+        0,                                                                      /*tp_setattro*/
+        0,                                                                      /*tp_as_buffer*/
+        Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE | Py_TPFLAGS_HAVE_VERSION_TAG, /*tp_flags*/
+        VFSCompressed_init_DOC,                                                 /* tp_doc */
+        0,                                                                      /* tp_traverse */
+        0,                                                                      /* tp_clear */
+        0,                                                                      /* tp_richcompare */
+        0,                                                                      /* tp_weaklistoffset */
+        0,                                                                      /* tp_iter */
+        0,                                                                      /* tp_iternext */
+        APSWVFSCompressed_methods,                                              /* tp_methods */
+        0,                                                                      /* tp_members */
+        0,                                                                      /* tp_getset */
+        0,                                                                      /* tp_base */
+        0,                                                                      /* tp_dict */
+        0,                                                                      /* tp_descr_get */
+        0,                                                                      /* tp_descr_set */
+        0,                                                                      /* tp_dictoffset */
+        (initproc)APSWVFSCompressed_init,                                       /* tp_init */
+        0,                                                                      /* tp_alloc */
+        APSWVFSCompressed_new,                                                  /* tp_new */
+        0,                                                                      /* tp_free */
+        0,                                                                      /* tp_is_gc */
+        0,                                                                      /* tp_bases */
+        0,                                                                      /* tp_mro */
+        0,                                                                      /* tp_cache */
+        0,                                                                      /* tp_subclasses */
+        0,                                                                      /* tp_weaklist */
+        0,                                                                      /* tp_del */
+        PyType_TRAILER
+};
+
+/** .. class:: VFSArchive
+
+    A read only VFS implemented in C that serves databases straight
+    from a single immutable archive file, such as reference data
+    shipped to many machines.  The archive is either a zip file whose
+    members are stored without compression (``zipfile.ZIP_STORED``),
+    each of which is a database, or any other file which is then
+    served as one database named by the archive's filename without
+    the directory.  Databases are opened by their member name, and
+    reads go directly to the archive through the *base* vfs.
+
+    .. code-block:: python
+
+      with zipfile.ZipFile("reference.zip", "w", zipfile.ZIP_STORED) as zf:
+          zf.write("places.db")
+          zf.write("names.db")
+
+      archive = apsw.VFSArchive("reference", "reference.zip")
+      db = apsw.Connection("places.db", vfs="reference",
+                           flags=apsw.SQLITE_OPEN_READONLY)
+
+    Because the archive is immutable there is no locking, and no
+    journals are looked for.  Temporary files SQLite needs are created
+    by the base vfs as usual.  Like :class:`VFSShim` it is registered
+    by name, so a :class:`VFS` written in Python can use one as its
+    base.
+
+    Prefetch
+      The parts of the archive read are recorded, in the order they
+      were first read, and available from :meth:`hints`.  Save them
+      (eg with :mod:`json`) and supply them as *prefetch* on a later
+      run, and *prefetch_threads* background threads read those parts
+      of the archive in parallel while queries run.  This gets them
+      into the operating system cache sooner than SQLite would read
+      them one at a time, reducing the latency of the first queries.
+*/
+
+#define ARCH_HINT_BLOCK 4096            /* granularity hints are recorded at */
+#define ARCH_PREFETCH_READ (256 * 1024) /* most read in one go by prefetch */
+
+typedef struct
+{
+  char *name;
+  sqlite3_int64 offset, size; /* of the database within the archive */
+  unsigned char *touched;     /* bitmap of hint blocks that have been read */
+} APSWArchiveMember;
+
+typedef struct
+{
+  int member;
+  sqlite3_int64 offset, length;
+} APSWArchiveRange;
+
+typedef struct
+{
+  sqlite3_vfs vfs; /* what sqlite uses with pAppData pointing back here */
+  sqlite3_vfs *basevfs;
+  sqlite3_mutex *mutex; /* protects refs and the hints */
+  int refs;             /* Python object and open files */
+  char *path;           /* full pathname of the archive */
+  APSWArchiveMember *members;
+  int nmembers;
+
+  /* what has been read in first read order, with consecutive reads
+     merged */
+  APSWArchiveRange *hints;
+  int nhints, allochints;
+
+  /* prefetch */
+  apswshim_lock pflock; /* protects the following */
+  apswshim_cond pfdone; /* broadcast when a thread exits */
+  APSWArchiveRange *prefetch;
+  int nprefetch, nextprefetch;
+  int threads; /* running */
+  int stop;
+} APSWArchive;
+
+typedef struct /* inherits */
+{
+  const struct sqlite3_io_methods *pMethods;
+  APSWArchive *arch;
+  sqlite3_file *real; /* the archive opened by the base, allocated after this structure */
+  int member;
+} APSWArchiveFile;
+
+#define ARCHFILESIZE ((int)((sizeof(APSWArchiveFile) + 7) & ~(size_t)7))
+
+typedef struct
+{
+  PyObject_HEAD
+      APSWArchive *arch;
+  int registered;
+} APSWVFSArchive;
+
+static PyTypeObject APSWVFSArchiveType;
+
+static void
+apswarch_release(APSWArchive *arch)
+{
+  int last, i;
+
+  sqlite3_mutex_enter(arch->mutex);
+  last = (0 == --arch->refs);
+  sqlite3_mutex_leave(arch->mutex);
+  if (!last)
+    return;
+
+  SHIMLOCK_ENTER(&arch->pflock);
+  arch->stop = 1;
+  while (arch->threads)
+    SHIMCOND_WAIT(&arch->pfdone, &arch->pflock);
+  SHIMLOCK_LEAVE(&arch->pflock);
+  SHIMCOND_FREE(&arch->pfdone);
+  SHIMLOCK_FREE(&arch->pflock);
+
+  for (i = 0; i < arch->nmembers; i++)
+  {
+    sqlite3_free(arch->members[i].name);
+    sqlite3_free(arch->members[i].touched);
+  }
+  sqlite3_free(arch->members);
+  sqlite3_free(arch->hints);
+  sqlite3_free(arch->prefetch);
+  sqlite3_free(arch->path);
+  sqlite3_mutex_free(arch->mutex);
+  sqlite3_free(arch);
+}
+
+static int
+apswarch_find(APSWArchive *arch, const char *name)
+{
+  int i;
+
+  for (i = 0; name && i < arch->nmembers; i++)
+    if (0 == strcmp(name, arch->members[i].name))
+      return i;
+  return -1;
+}
+
+/* opens the archive with the base vfs into newly allocated memory */
+static int
+apswarch_open(APSWArchive *arch, sqlite3_file **pfile)
+{
+  sqlite3_file *file = sqlite3_malloc64(arch->basevfs->szOsFile);
+  int res, outflags = 0;
+
+  *pfile = NULL;
+  if (!file)
+    return SQLITE_NOMEM;
+  memset(file, 0, arch->basevfs->szOsFile);
+  res = arch->basevfs->xOpen(arch->basevfs, arch->path, file, SQLITE_OPEN_READONLY | SQLITE_OPEN_MAIN_DB, &outflags);
+  if (res != SQLITE_OK)
+  {
+    if (file->pMethods)
+      file->pMethods->xClose(file);
+    sqlite3_free(file);
+    return res;
+  }
+  *pfile = file;
+  return SQLITE_OK;
+}
+
+static void
+apswarch_close(sqlite3_file *file)
+{
+  if (file)
+  {
+    file->pMethods->xClose(file);
+    sqlite3_free(file);
+  }
+}
+
+static void
+apswarch_prefetch_worker(void *arg)
+{
+  APSWArchive *arch = (APSWArchive *)arg;
+  sqlite3_file *file = NULL;
+  char *buffer = sqlite3_malloc64(ARCH_PREFETCH_READ);
+  APSWArchiveRange range;
+  int res;
+
+  res = buffer ? apswarch_open(arch, &file) : SQLITE_NOMEM;
+
+  SHIMLOCK_ENTER(&arch->pflock);
+  while (res == SQLITE_OK && !arch->stop && arch->nextprefetch < arch->nprefetch)
+  {
+    range = arch->prefetch[arch->nextprefetch++];
+    SHIMLOCK_LEAVE(&arch->pflock);
+
+    range.offset += arch->members[range.member].offset;
+    while (res == SQLITE_OK && range.length > 0 && !arch->stop)
+    {
+      int amount = (range.length > ARCH_PREFETCH_READ) ? ARCH_PREFETCH_READ : (int)range.length;
+      /* only getting it into the os cache */
+      res = file->pMethods->xRead(file, buffer, amount, range.offset);
+      range.offset += amount;
+      range.length -= amount;
+    }
+
+    SHIMLOCK_ENTER(&arch->pflock);
+  }
+  if (--arch->threads == 0)
+    arch->nextprefetch = arch->nprefetch;
+  SHIMCOND_BROADCAST(&arch->pfdone);
+  SHIMLOCK_LEAVE(&arch->pflock);
+
+  apswarch_close(file);
+  sqlite3_free(buffer);
+}
+
+/* notes the hint blocks in the read that haven't been read before */
+static void
+apswarch_record(APSWArchive *arch, int member, sqlite3_int64 offset, int amount)
+{
+  APSWArchiveMember *m = &arch->members[member];
+  sqlite3_int64 block, last = (offset + amount - 1) / ARCH_HINT_BLOCK;
+
+  sqlite3_mutex_enter(arch->mutex);
+  for (block = offset / ARCH_HINT_BLOCK; block <= last; block++)
+  {
+    APSWArchiveRange *prev = arch->nhints ? &arch->hints[arch->nhints - 1] : NULL;
+
+    if (m->touched[block / 8] & (1 << (block % 8)))
+      continue;
+    m->touched[block / 8] |= 1 << (block % 8);
+    if (prev && prev->member == member && prev->offset + prev->length == block * ARCH_HINT_BLOCK)
+    {
+      prev->length += ARCH_HINT_BLOCK;
+      continue;
+    }
+    if (arch->nhints == arch->allochints)
+    {
+      int allochints = arch->allochints ? arch->allochints * 2 : 64;
+      APSWArchiveRange *hints = sqlite3_realloc64(arch->hints, sizeof(APSWArchiveRange) * allochints);
+      if (!hints)
+        break;
+      arch->hints = hints;
+      arch->allochints = allochints;
+    }
+    arch->hints[arch->nhints].member = member;
+    arch->hints[arch->nhints].offset = block * ARCH_HINT_BLOCK;
+    arch->hints[arch->nhints].length = ARCH_HINT_BLOCK;
+    arch->nhints++;
+  }
+  sqlite3_mutex_leave(arch->mutex);
+}
+
+/* io methods */
+
+#define ARCHFILE                                  \
+  APSWArchiveFile *f = (APSWArchiveFile *)file; \
+  sqlite3_file *real = f->real;
+
+static int
+apswarch_xClose(sqlite3_file *file)
+{
+  int res;
+  ARCHFILE;
+
+  res = real->pMethods->xClose(real);
+  apswarch_release(f->arch);
+  return res;
+}
+
+static int
+apswarch_xRead(sqlite3_file *file, void *buffer, int amount, sqlite3_int64 offset)
+{
+  APSWArchiveMember *m;
+  int available, res = SQLITE_OK;
+  ARCHFILE;
+
+  m = &f->arch->members[f->member];
+  available = (offset >= m->size) ? 0 : (offset + amount > m->size) ? (int)(m->size - offset) : amount;
+  if (available)
+  {
+    apswarch_record(f->arch, f->member, offset, available);
+    res = real->pMethods->xRead(real, buffer, available, m->offset + offset);
+  }
+  if (res == SQLITE_OK && available < amount)
+  {
+    memset((char *)buffer + available, 0, amount - available);
+    res = SQLITE_IOERR_SHORT_READ;
+  }
+  return res;
+}
+
+static int
+apswarch_xWrite(sqlite3_file *Py_UNUSED(file), const void *Py_UNUSED(buffer), int Py_UNUSED(amount), sqlite3_int64 Py_UNUSED(offset))
+{
+  return SQLITE_READONLY;
+}
+
+static int
+apswarch_xTruncate(sqlite3_file *Py_UNUSED(file), sqlite3_int64 Py_UNUSED(size))
+{
+  return SQLITE_READONLY;
+}
+
+static int
+apswarch_xSync(sqlite3_file *Py_UNUSED(file), int Py_UNUSED(flags))
+{
+  return SQLITE_OK;
+}
+
+static int
+apswarch_xFileSize(sqlite3_file *file, sqlite3_int64 *pSize)
+{
+  ARCHFILE;
+  (void)real;
+  *pSize = f->arch->members[f->member].size;
+  return SQLITE_OK;
+}
+
+/* immutable so there is no locking */
+static int
+apswarch_xLock(sqlite3_file *Py_UNUSED(file), int Py_UNUSED(level))
+{
+  return SQLITE_OK;
+}
+
+static int
+apswarch_xCheckReservedLock(sqlite3_file *Py_UNUSED(file), int *pResOut)
+{
+  *pResOut = 0;
+  return SQLITE_OK;
+}
+
+static int
+apswarch_xFileControl(sqlite3_file *Py_UNUSED(file), int Py_UNUSED(op), void *Py_UNUSED(pArg))
+{
+  return SQLITE_NOTFOUND;
+}
+
+static int
+apswarch_xSectorSize(sqlite3_file *file)
+{
+  ARCHFILE;
+  (void)f;
+  return real->pMethods->xSectorSize(real);
+}
+
+static int
+apswarch_xDeviceCharacteristics(sqlite3_file *Py_UNUSED(file))
+{
+  return SQLITE_IOCAP_IMMUTABLE;
+}
+
+static const struct sqlite3_io_methods apswarch_io_methods = {
+    1, apswarch_xClose, apswarch_xRead, apswarch_xWrite, apswarch_xTruncate, apswarch_xSync, apswarch_xFileSize,
+    apswarch_xLock, apswarch_xLock, apswarch_xCheckReservedLock, apswarch_xFileControl, apswarch_xSectorSize,
+    apswarch_xDeviceCharacteristics, 0, 0, 0, 0, 0, 0};
+
+/* vfs methods.  Member names are used as is, with everything else
+   going to the base. */
+
+static int
+apswarchvfs_xOpen(sqlite3_vfs *vfs, const char *zName, sqlite3_file *file, int flags, int *pOutFlags)
+{
+  APSWArchive *arch = (APSWArchive *)(vfs->pAppData);
+  APSWArchiveFile *f = (APSWArchiveFile *)file;
+  int member, res;
+
+  if (!(flags & SQLITE_OPEN_MAIN_DB))
+    return SHIMBASE->xOpen(SHIMBASE, zName, file, flags, pOutFlags);
+
+  member = apswarch_find(arch, zName);
+  if (member < 0)
+    return SQLITE_CANTOPEN;
+
+  memset(f, 0, sizeof(APSWArchiveFile));
+  f->arch = arch;
+  f->real = (sqlite3_file *)((char *)f + ARCHFILESIZE);
+  f->member = member;
+  res = SHIMBASE->xOpen(SHIMBASE, arch->path, f->real, SQLITE_OPEN_READONLY | SQLITE_OPEN_MAIN_DB, NULL);
+  if (!f->real->pMethods)
+    return res;
+  if (res != SQLITE_OK)
+  {
+    f->real->pMethods->xClose(f->real);
+    return res;
+  }
+
+  if (pOutFlags)
+    *pOutFlags = (flags & ~(SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE)) | SQLITE_OPEN_READONLY;
+  f->pMethods = &apswarch_io_methods;
+  sqlite3_mutex_enter(arch->mutex);
+  arch->refs++;
+  sqlite3_mutex_leave(arch->mutex);
+  return SQLITE_OK;
+}
+
+static int
+apswarchvfs_xDelete(sqlite3_vfs *vfs, const char *zName, int syncDir)
+{
+  if (apswarch_find((APSWArchive *)(vfs->pAppData), zName) >= 0)
+    return SQLITE_READONLY;
+  return SHIMBASE->xDelete(SHIMBASE, zName, syncDir);
+}
+
+static int
+apswarchvfs_xAccess(sqlite3_vfs *vfs, const char *zName, int flags, int *pResOut)
+{
+  if (apswarch_find((APSWArchive *)(vfs->pAppData), zName) >= 0)
+  {
+    *pResOut = (flags != SQLITE_ACCESS_READWRITE);
+    return SQLITE_OK;
+  }
+  return SHIMBASE->xAccess(SHIMBASE, zName, flags, pResOut);
+}
+
+static int
+apswarchvfs_xFullPathname(sqlite3_vfs *vfs, const char *zName, int nOut, char *zOut)
+{
+  if (apswarch_find((APSWArchive *)(vfs->pAppData), zName) >= 0)
+  {
+    if ((int)strlen(zName) >= nOut)
+      return SQLITE_CANTOPEN;
+    strcpy(zOut, zName);
+    return SQLITE_OK;
+  }
+  return SHIMBASE->xFullPathname(SHIMBASE, zName, nOut, zOut);
+}
+
+/* adds a member, returning -1 with an exception set on failure */
+static int
+apswarch_add_member(APSWArchive *arch, const char *name, sqlite3_int64 offset, sqlite3_int64 size)
+{
+  APSWArchiveMember *members, *m;
+
+  if (apswarch_find(arch, name) >= 0)
+  {
+    PyErr_Format(PyExc_ValueError, "Archive member \"%s\" is present more than once", name);
+    return -1;
+  }
+  members = sqlite3_realloc64(arch->members, sizeof(APSWArchiveMember) * (arch->nmembers + 1));
+  if (!members)
+    goto nomem;
+  arch->members = members;
+  m = &arch->members[arch->nmembers];
+  memset(m, 0, sizeof(APSWArchiveMember));
+  arch->nmembers++;
+  m->offset = offset;
+  m->size = size;
+  m->name = sqlite3_mprintf("%s", name);
+  m->touched = sqlite3_malloc64(size / ARCH_HINT_BLOCK / 8 + 1);
+  if (!m->name || !m->touched)
+    goto nomem;
+  memset(m->touched, 0, size / ARCH_HINT_BLOCK / 8 + 1);
+  return 0;
+
+nomem:
+  PyErr_NoMemory();
+  return -1;
+}
+
+/* Finds the members using the zipfile module, with the data offset
+   coming from each local header.  Returns 0 if the archive isn't a
+   zip file, 1 if it is, and -1 with an exception set on failure. */
+static int
+apswarch_zip_members(APSWArchive *arch, const char *archive, sqlite3_file *file)
+{
+  PyObject *zipfile = NULL, *iszip = NULL, *zf = NULL, *infolist = NULL, *info = NULL, *closed = NULL;
+  unsigned char local[30];
+  Py_ssize_t i;
+  int res = -1, sqres;
+
+  zipfile = PyImport_ImportModule("zipfile");
+  if (zipfile)
+    iszip = PyObject_CallMethod(zipfile, "is_zipfile", "s", archive);
+  if (!iszip)
+    goto finally;
+  if (!PyObject_IsTrue(iszip))
+  {
+    res = 0;
+    goto finally;
+  }
+
+  zf = PyObject_CallMethod(zipfile, "ZipFile", "s", archive);
+  if (zf)
+    infolist = PyObject_CallMethod(zf, "infolist", NULL);
+  if (!infolist)
+    goto finally;
+  closed = PyObject_CallMethod(zf, "close", NULL);
+  if (!closed || !PyList_Check(infolist))
+    goto finally;
+
+  for (i = 0; i < PyList_GET_SIZE(infolist); i++)
+  {
+    PyObject *filename, *compress_type, *header_offset, *file_size;
+    const char *name;
+    sqlite3_int64 offset, size;
+
+    info = PyList_GET_ITEM(infolist, i);
+    filename = PyObject_GetAttrString(info, "filename");
+    compress_type = PyObject_GetAttrString(info, "compress_type");
+    header_offset = PyObject_GetAttrString(info, "header_offset");
+    file_size = PyObject_GetAttrString(info, "file_size");
+    name = (filename && PyUnicode_Check(filename)) ? PyUnicode_AsUTF8(filename) : NULL;
+    offset = header_offset ? PyLong_AsLongLong(header_offset) : -1;
+    size = file_size ? PyLong_AsLongLong(file_size) : -1;
+    if (!PyErr_Occurred() && compress_type && PyLong_AsLong(compress_type) != 0)
+      PyErr_Format(PyExc_ValueError, "Archive member \"%s\" is compressed", name ? name : "");
+    Py_XDECREF(compress_type);
+    Py_XDECREF(header_offset);
+    Py_XDECREF(file_size);
+    if (!PyErr_Occurred() && name && (name[0] == 0 || name[strlen(name) - 1] == '/'))
+    {
+      /* directory entry */
+      Py_XDECREF(filename);
+      continue;
+    }
+    if (PyErr_Occurred() || !name)
+    {
+      Py_XDECREF(filename);
+      goto finally;
+    }
+
+    sqres = file->pMethods->xRead(file, local, sizeof(local), offset);
+    if (sqres != SQLITE_OK || memcmp(local, "PK\003\004", 4))
+    {
+      PyErr_Format(PyExc_ValueError, "Archive member \"%s\" local header is invalid", name);
+      Py_DECREF(filename);
+      goto finally;
+    }
+    offset += sizeof(local) + (local[26] | (local[27] << 8)) + (local[28] | (local[29] << 8));
+    sqres = apswarch_add_member(arch, name, offset, size);
+    Py_DECREF(filename);
+    if (sqres)
+      goto finally;
+  }
+  res = 1;
+
+finally:
+  Py_XDECREF(zipfile);
+  Py_XDECREF(iszip);
+  Py_XDECREF(zf);
+  Py_XDECREF(infolist);
+  Py_XDECREF(closed);
+  return res;
+}
+
+/* adds the ranges to prefetch.  Ones for members not in the archive
+   are ignored as they could be from a different version. */
+static int
+apswarch_add_prefetch(APSWArchive *arch, PyObject *prefetch)
+{
+  PyObject *iterator = NULL, *item = NULL, *tuple = NULL;
+  const char *name;
+  sqlite3_int64 offset, length;
+  int member;
+
+  iterator = PyObject_GetIter(prefetch);
+  if (!iterator)
+    return -1;
+  while ((item = PyIter_Next(iterator)))
+  {
+    tuple = PySequence_Tuple(item);
+    if (!tuple || !PyArg_ParseTuple(tuple, "sLL", &name, &offset, &length))
+      goto error;
+    member = apswarch_find(arch, name);
+    if (member >= 0 && offset >= 0 && offset < arch->members[member].size && length > 0)
+    {
+      APSWArchiveRange *ranges = sqlite3_realloc64(arch->prefetch, sizeof(APSWArchiveRange) * (arch->nprefetch + 1));
+      if (!ranges)
+      {
+        PyErr_NoMemory();
+        goto error;
+      }
+      arch->prefetch = ranges;
+      arch->prefetch[arch->nprefetch].member = member;
+      arch->prefetch[arch->nprefetch].offset = offset;
+      arch->prefetch[arch->nprefetch].length = (length > arch->members[member].size - offset) ? arch->members[member].size - offset : length;
+      arch->nprefetch++;
+    }
+    Py_CLEAR(tuple);
+    Py_CLEAR(item);
+  }
+  Py_DECREF(iterator);
+  return PyErr_Occurred() ? -1 : 0;
+
+error:
+  Py_XDECREF(tuple);
+  Py_XDECREF(item);
+  Py_DECREF(iterator);
+  return -1;
+}
+
+/** .. method:: __init__(name: str, archive: str, base: str = "", makedefault: bool = False, prefetch: Optional[Iterable[Tuple[str, int, int]]] = None, prefetch_threads: int = 4)
+
+    :param name: The name to register this vfs under.  If the name
+        already exists then this vfs will replace the prior one of the
+        same name.
+    :param archive: Filename of the archive.
+    :param base: Name of the vfs to read the archive with, and to
+        create temporary files.  Use an empty string for the default
+        vfs.
+    :param makedefault: If true then this vfs will be registered as
+        the default, and will be used by any opens that don't specify a
+        vfs.
+    :param prefetch: What to read in the background, usually from
+        :meth:`hints` on a previous run.  Each item is the member name,
+        offset, and length.
+    :param prefetch_threads: How many threads read *prefetch* in
+        parallel.
+
+    :raises ValueError: If the *base* vfs is not registered, a zip
+        member is compressed, or *prefetch_threads* is less than one.
+
+    -* sqlite3_vfs_register sqlite3_vfs_find
+*/
+static int
+APSWVFSArchive_init(APSWVFSArchive *self, PyObject *args, PyObject *kwds)
+{
+  const char *name = NULL, *archive = NULL, *base = "", *filename;
+  int makedefault = 0, prefetch_threads = 4, res, iszip;
+  PyObject *prefetch = NULL;
+  sqlite3_vfs *basevfs;
+  sqlite3_file *file = NULL;
+  sqlite3_int64 size = 0;
+  APSWArchive *arch;
+  size_t namelen;
+
+  {
+    static char *kwlist[] = {"name", "archive", "base", "makedefault", "prefetch", "prefetch_threads", NULL};
+    VFSArchive_init_CHECK;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "ss|sO&Oi:" VFSArchive_init_USAGE, kwlist, &name, &archive, &base, argcheck_bool, &makedefault, &prefetch, &prefetch_threads))
+      return -1;
+  }
+
+  if (self->arch)
+  {
+    PyErr_Format(PyExc_RuntimeError, "VFSArchive is already initialized");
+    return -1;
+  }
+
+  if (prefetch_threads < 1)
+  {
+    PyErr_Format(PyExc_ValueError, "prefetch_threads must be at least one");
+    return -1;
+  }
+
+  basevfs = sqlite3_vfs_find(strlen(base) ? base : NULL);
+  if (!basevfs)
+  {
+    PyErr_Format(PyExc_ValueError, "Base vfs named \"%s\" not found", strlen(base) ? base : "<default>");
+    return -1;
+  }
+
+  namelen = strlen(name);
+  arch = sqlite3_malloc64(sizeof(APSWArchive) + namelen + 1);
+  if (!arch)
+  {
+    PyErr_NoMemory();
+    return -1;
+  }
+  memset(arch, 0, sizeof(APSWArchive));
+  memcpy((char *)(arch + 1), name, namelen + 1);
+  arch->mutex = sqlite3_mutex_alloc(SQLITE_MUTEX_FAST);
+  arch->basevfs = basevfs;
+  arch->refs = 1;
+  SHIMLOCK_INIT(&arch->pflock);
+  SHIMCOND_INIT(&arch->pfdone);
+
+  arch->path = sqlite3_malloc64(basevfs->mxPathname + 1);
+  if (!arch->path)
+  {
+    PyErr_NoMemory();
+    goto error;
+  }
+  res = basevfs->xFullPathname(basevfs, archive, basevfs->mxPathname + 1, arch->path);
+  if (res == SQLITE_OK)
+    res = apswarch_open(arch, &file);
+  if (res == SQLITE_OK)
+    res = file->pMethods->xFileSize(file, &size);
+  if (res != SQLITE_OK)
+  {
+    SET_EXC(res, NULL);
+    goto error;
+  }
+
+  iszip = apswarch_zip_members(arch, archive, file);
+  if (iszip < 0)
+    goto error;
+  if (!iszip)
+  {
+    filename = strrchr(archive, '/');
+#ifdef _WIN32
+    if (strrchr(archive, '\\') > filename)
+      filename = strrchr(archive, '\\');
+#endif
+    if (apswarch_add_member(arch, filename ? filename + 1 : archive, 0, size))
+      goto error;
+  }
+  apswarch_close(file);
+  file = NULL;
+
+  if (prefetch && prefetch != Py_None && apswarch_add_prefetch(arch, prefetch))
+    goto error;
+
+  apswshim_init_vfs(&arch->vfs, basevfs, ARCHFILESIZE, (const char *)(arch + 1), arch);
+  arch->vfs.xOpen = apswarchvfs_xOpen;
+  arch->vfs.xDelete = apswarchvfs_xDelete;
+  arch->vfs.xAccess = apswarchvfs_xAccess;
+  arch->vfs.xFullPathname = apswarchvfs_xFullPathname;
+
+  while (arch->threads < prefetch_threads && arch->threads < arch->nprefetch)
+  {
+    SHIMLOCK_ENTER(&arch->pflock);
+    arch->threads++;
+    SHIMLOCK_LEAVE(&arch->pflock);
+    if (PyThread_start_new_thread(apswarch_prefetch_worker, arch) == PYTHREAD_INVALID_THREAD_ID)
+    {
+      SHIMLOCK_ENTER(&arch->pflock);
+      arch->threads--;
+      SHIMLOCK_LEAVE(&arch->pflock);
+      PyErr_Format(PyExc_RuntimeError, "Unable to start the prefetch thread");
+      goto error;
+    }
+  }
+
+  res = sqlite3_vfs_register(&arch->vfs, makedefault);
+  if (res != SQLITE_OK)
+  {
+    SET_EXC(res, NULL);
+    goto error;
+  }
+  self->arch = arch;
+  self->registered = 1;
+  return 0;
+
+error:
+  apswarch_close(file);
+  apswarch_release(arch);
+  return -1;
+}
+
+static PyObject *
+APSWVFSArchive_new(PyTypeObject *type, PyObject *Py_UNUSED(args), PyObject *Py_UNUSED(kwds))
+{
+  APSWVFSArchive *self;
+  self = (APSWVFSArchive *)type->tp_alloc(type, 0);
+  if (self)
+  {
+    self->arch = NULL;
+    self->registered = 0;
+  }
+  return (PyObject *)self;
+}
+
+/** .. method:: unregister() -> None
+
+   Unregisters the vfs making it unavailable to future database
+   opens.  Databases already open continue to work.  It is
+   automatically unregistered when the :class:`VFSArchive` is
+   garbage collected.  It is safe to call this routine multiple
+   times.
+
+   -* sqlite3_vfs_unregister
+*/
+static PyObject *
+APSWVFSArchive_unregister(APSWVFSArchive *self)
+{
+  if (self->registered)
+  {
+    sqlite3_vfs_unregister(&self->arch->vfs);
+    self->registered = 0;
+  }
+  Py_RETURN_NONE;
+}
+
+static void
+APSWVFSArchive_dealloc(APSWVFSArchive *self)
+{
+  if (self->arch)
+  {
+    if (self->registered)
+      sqlite3_vfs_unregister(&self->arch->vfs);
+    Py_BEGIN_ALLOW_THREADS
+        apswarch_release(self->arch);
+    Py_END_ALLOW_THREADS;
+    self->arch = NULL;
+  }
+  Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+/** .. method:: hints() -> List[Tuple[str, int, int]]
+
+  Returns the member name, offset, and length of what has been read
+  from the archive so far, in the order it was first read.  Pass it as
+  *prefetch* on a future run.
+*/
+static PyObject *
+APSWVFSArchive_hints(APSWVFSArchive *self)
+{
+  PyObject *result = NULL, *item;
+  APSWArchive *arch = self->arch;
+  int i;
+
+  if (!arch)
+    return PyErr_Format(PyExc_ValueError, "VFSArchive has not been initialized");
+
+  result = PyList_New(0);
+  sqlite3_mutex_enter(arch->mutex);
+  for (i = 0; result && i < arch->nhints; i++)
+  {
+    APSWArchiveRange *range = &arch->hints[i];
+    sqlite3_int64 length = range->length;
+
+    if (range->offset + length > arch->members[range->member].size)
+      length = arch->members[range->member].size - range->offset;
+    item = Py_BuildValue("(sLL)", arch->members[range->member].name, range->offset, length);
+    if (!item || PyList_Append(result, item))
+      Py_CLEAR(result);
+    Py_XDECREF(item);
+  }
+  sqlite3_mutex_leave(arch->mutex);
+  return result;
+}
+
+/** .. method:: prefetch_wait() -> None
+
+  Waits until the prefetch threads have finished.
+*/
+static PyObject *
+APSWVFSArchive_prefetch_wait(APSWVFSArchive *self)
+{
+  if (!self->arch)
+    return PyErr_Format(PyExc_ValueError, "VFSArchive has not been initialized");
+
+  Py_BEGIN_ALLOW_THREADS
+  {
+    SHIMLOCK_ENTER(&self->arch->pflock);
+    while (self->arch->threads)
+      SHIMCOND_WAIT(&self->arch->pfdone, &self->arch->pflock);
+    SHIMLOCK_LEAVE(&self->arch->pflock);
+  }
+  Py_END_ALLOW_THREADS;
+  Py_RETURN_NONE;
+}
+
+static PyMethodDef APSWVFSArchive_methods[] = {
+    {"hints", (PyCFunction)APSWVFSArchive_hints, METH_NOARGS, VFSArchive_hints_DOC},
+    {"prefetch_wait", (PyCFunction)APSWVFSArchive_prefetch_wait, METH_NOARGS, VFSArchive_prefetch_wait_DOC},
+    {"unregister", (PyCFunction)APSWVFSArchive_unregister, METH_NOARGS, VFSArchive_unregister_DOC},
+    /* Sentinel */
+    {0, 0, 0, 0}};
+
+static PyTypeObject APSWVFSArchiveType =
+    {
+        PyVarObject_HEAD_INIT(NULL, 0) "apsw.VFSArchive",                       /*tp_name*/
+        sizeof(APSWVFSArchive),                                                 /*tp_basicsize*/
+        0,                                                                      /*tp_itemsize*/
+        (destructor)APSWVFSArchive_dealloc,                                     /*tp_dealloc*/
+        0,                                                                      /*tp_print*/
+        0,                                                                      /*tp_getattr*/
+        0,                                                                      /*tp_setattr*/
+        0,                                                                      /*tp_compare*/
+        0,                                                                      /*tp_repr*/
+        0,                                                                      /*tp_as_number*/
+        0,                                                                      /*tp_as_sequence*/
+        0,                                                                      /*tp_as_mapping*/
+        0,                                                                      /*tp_hash */
+        0,                                                                      /*tp_call*/
+        0,                                                                      /*tp_str*/
+        0,                                                                      /*tp_getattro*/
+        0,                                                                      /*tp_setattro*/
+        0,                                                                      /*tp_as_buffer*/
+        Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE | Py_TPFLAGS_HAVE_VERSION_TAG, /*tp_flags*/
+        VFSArchive_init_DOC,                                                    /* tp_doc */
+        0,                                                                      /* tp_traverse */
+        0,                                                                      /* tp_clear */
+        0,                                                                      /* tp_richcompare */
+        0,                                                                      /* tp_weaklistoffset */
+        0,                                                                      /* tp_iter */
+        0,                                                                      /* tp_iternext */
+        APSWVFSArchive_methods,                                                 /* tp_methods */
+        0,                                                                      /* tp_members */
+        0,                                                                      /* tp_getset */
+        0,                                                                      /* tp_base */
+        0,                                                                      /* tp_dict */
+        0,                                                                      /* tp_descr_get */
+        0,                                                                      /* tp_descr_set */
+        0,                                                                      /* tp_dictoffset */
+        (initproc)APSWVFSArchive_init,                                          /* tp_init */
+        0,                                                                      /* tp_alloc */
+        APSWVFSArchive_new,                                                     /* tp_new */
+        0,                                                                      /* tp_free */
+        0,                                                                      /* tp_is_gc */
+        0,                                                                      /* tp_bases */
+        0,                                                                      /* tp_mro */
+        0,                                                                      /* tp_cache */
+        0,                                                                      /* tp_subclasses */
+        0,                                                                      /* tp_weaklist */
+        0,                                                                      /* tp_del */
+        PyType_TRAILER
+};
@@ -922,6 +922,10 @@ typedef struct
 {
   sqlite3_vtab_cursor used_by_sqlite; /* I don't touch this */
   PyObject *cursor;                   /* Object implementing cursor */
+  int batched;                        /* cursor implements NextRows */
+  PyObject *rows;                     /* current batch from NextRows as a fast sequence */
+  Py_ssize_t rowindex;                /* position in rows */
+  PyObject *row;                      /* rows[rowindex] as a fast sequence, NULL at eof */
 } apsw_vtable_cursor;
 
 static int
@@ -944,6 +948,7 @@ apswvtabOpen(sqlite3_vtab *pVtab, sqlite3_vtab_cursor **ppCursor)
   memset(avc, 0, sizeof(apsw_vtable_cursor));
 
   avc->cursor = res;
+  avc->batched = PyObject_HasAttrString(res, "NextRows");
   res = NULL;
   *ppCursor = (sqlite3_vtab_cursor *)avc;
   goto finally;
@@ -1236,11 +1241,58 @@ finally:
   There may be many cursors simultaneously so each one needs to keep
   track of where it is.
 
+  A cursor providing :meth:`~VTCursor.NextRows` returns many rows at
+  a time, and doesn't need :meth:`~VTCursor.Eof`,
+  :meth:`~VTCursor.Next`, :meth:`~VTCursor.Column`, or
+  :meth:`~VTCursor.Rowid` which are answered from the rows instead.
+  This is considerably quicker for tables with many rows or columns.
+
   .. seealso::
 
      :ref:`Virtual table structure <vtablestructure>`
 */
 
+/* makes row the current row of the batch, or NULL at the end of the
+   batch */
+static int
+apswvtab_setrow(apsw_vtable_cursor *avc)
+{
+  Py_CLEAR(avc->row);
+  if (!avc->rows || avc->rowindex >= PySequence_Fast_GET_SIZE(avc->rows))
+    return 0;
+  avc->row = PySequence_Fast(PySequence_Fast_GET_ITEM(avc->rows, avc->rowindex), "Each row from NextRows must be a sequence");
+  if (!avc->row)
+    return -1;
+  if (PySequence_Fast_GET_SIZE(avc->row) < 1)
+  {
+    Py_CLEAR(avc->row);
+    PyErr_Format(PyExc_ValueError, "Each row from NextRows must start with the rowid");
+    return -1;
+  }
+  return 0;
+}
+
+/* replaces the batch with the next one from NextRows */
+static int
+apswvtab_nextrows(apsw_vtable_cursor *avc)
+{
+  PyObject *res;
+
+  Py_CLEAR(avc->row);
+  Py_CLEAR(avc->rows);
+  avc->rowindex = 0;
+
+  res = Call_PythonMethod(avc->cursor, "NextRows", 1, NULL);
+  if (!res)
+    return -1;
+  if (res != Py_None)
+    avc->rows = PySequence_Fast(res, "NextRows must return a sequence of rows");
+  Py_DECREF(res);
+  if (PyErr_Occurred())
+    return -1;
+  return apswvtab_setrow(avc);
+}
+
 /** .. method:: Filter(indexnum, indexname, constraintargs)
 
   This method is always called first to initialize an iteration to the
@@ -1275,6 +1327,8 @@ apswvtabFilter(sqlite3_vtab_cursor *pCursor, int idxNum, const char *idxStr,
   }
 
   res = Call_PythonMethodV(cursor, "Filter", 1, "(iO&O)", idxNum, convertutf8string, idxStr, argv);
+  if (res && ((apsw_vtable_cursor *)pCursor)->batched && apswvtab_nextrows((apsw_vtable_cursor *)pCursor))
+    goto pyexception;
   if (res)
     goto finally; /* result is ignored */
 
@@ -1319,6 +1373,12 @@ apswvtabEof(sqlite3_vtab_cursor *pCursor)
 
   cursor = ((apsw_vtable_cursor *)pCursor)->cursor;
 
+  if (((apsw_vtable_cursor *)pCursor)->batched)
+  {
+    sqliteres = !((apsw_vtable_cursor *)pCursor)->row;
+    goto finally;
+  }
+
   res = Call_PythonMethod(cursor, "Eof", 1, NULL);
   if (!res)
     goto pyexception;
@@ -1361,7 +1421,21 @@ apswvtabColumn(sqlite3_vtab_cursor *pCursor, sqlite3_context *result, int ncolum
 
   cursor = ((apsw_vtable_cursor *)pCursor)->cursor;
 
-  res = Call_PythonMethodV(cursor, "Column", 1, "(i)", ncolumn);
+  if (((apsw_vtable_cursor *)pCursor)->batched)
+  {
+    PyObject *row = ((apsw_vtable_cursor *)pCursor)->row;
+
+    /* rowid is first so it lines up with column -1 */
+    if (!row || ncolumn + 1 >= PySequence_Fast_GET_SIZE(row))
+    {
+      PyErr_Format(PyExc_IndexError, "Row from NextRows doesn't have column %d", ncolumn);
+      goto pyexception;
+    }
+    res = PySequence_Fast_GET_ITEM(row, ncolumn + 1);
+    Py_INCREF(res);
+  }
+  else
+    res = Call_PythonMethodV(cursor, "Column", 1, "(i)", ncolumn);
   if (!res)
     goto pyexception;
 
@@ -1403,9 +1477,20 @@ apswvtabNext(sqlite3_vtab_cursor *pCursor)
 
   cursor = ((apsw_vtable_cursor *)pCursor)->cursor;
 
-  res = Call_PythonMethod(cursor, "Next", 1, NULL);
-  if (res)
-    goto finally;
+  if (((apsw_vtable_cursor *)pCursor)->batched)
+  {
+    apsw_vtable_cursor *avc = (apsw_vtable_cursor *)pCursor;
+
+    avc->rowindex++;
+    if (0 == ((avc->rowindex < PySequence_Fast_GET_SIZE(avc->rows)) ? apswvtab_setrow(avc) : apswvtab_nextrows(avc)))
+      goto finally;
+  }
+  else
+  {
+    res = Call_PythonMethod(cursor, "Next", 1, NULL);
+    if (res)
+      goto finally;
+  }
 
   /* pyexception:  we had an exception in python code */
   assert(PyErr_Occurred());
@@ -1419,6 +1504,24 @@ finally:
   return sqliteres;
 }
 
+/** .. method:: NextRows() -> Optional[Sequence[Sequence]]
+
+  Optional alternative to :meth:`~VTCursor.Eof`,
+  :meth:`~VTCursor.Next`, :meth:`~VTCursor.Column` and
+  :meth:`~VTCursor.Rowid`.  It is called after
+  :meth:`~VTCursor.Filter`, and again each time the rows it returned
+  have been used.  Return a batch of rows, each being the rowid
+  followed by the column values.  Return None or an empty sequence
+  when there are no more rows.
+
+  .. code-block:: python
+
+    def NextRows(self):
+        batch = self.data[self.pos:self.pos + 256]
+        self.pos += len(batch)
+        return [(rowid, *values) for rowid, values in batch]
+*/
+
 /** .. method:: Close()
 
   This is the destructor for the cursor. Note that you must
@@ -1438,6 +1541,8 @@ apswvtabClose(sqlite3_vtab_cursor *pCursor)
   cursor = ((apsw_vtable_cursor *)pCursor)->cursor;
 
   res = Call_PythonMethod(cursor, "Close", 1, NULL);
+  Py_XDECREF(((apsw_vtable_cursor *)pCursor)->row);
+  Py_XDECREF(((apsw_vtable_cursor *)pCursor)->rows);
   PyMem_Free(pCursor); /* always free */
   if (res)
     goto finally;
@@ -1470,7 +1575,13 @@ apswvtabRowid(sqlite3_vtab_cursor *pCursor, sqlite3_int64 *pRowid)
 
   cursor = ((apsw_vtable_cursor *)pCursor)->cursor;
 
-  res = Call_PythonMethod(cursor, "Rowid", 1, NULL);
+  if (((apsw_vtable_cursor *)pCursor)->batched && ((apsw_vtable_cursor *)pCursor)->row)
+  {
+    res = PySequence_Fast_GET_ITEM(((apsw_vtable_cursor *)pCursor)->row, 0);
+    Py_INCREF(res);
+  }
+  else
+    res = Call_PythonMethod(cursor, "Rowid", 1, NULL);
   if (!res)
     goto pyexception;
 
@@ -1519,6 +1630,308 @@ static struct sqlite3_module apsw_vtable_module =
         apswvtabFindFunction,
         apswvtabRename};
 
+/* Table valued functions from Connection.create_table_function.  The
+   module is eponymous only with the function arguments as hidden
+   columns.  Rows are pulled from the Python iterator a batch at a
+   time, so only xColumn needs the GIL for most rows. */
+
+#define TABLEFUNCTION_BATCH 256
+
+typedef struct
+{
+  sqlite3_vtab used_by_sqlite; /* I don't touch this */
+  tablefunctioninfo *tfi;
+} apsw_tablefunction_vtab;
+
+typedef struct
+{
+  sqlite3_vtab_cursor used_by_sqlite; /* I don't touch this */
+  tablefunctioninfo *tfi;
+  PyObject *args;     /* tuple of hidden column values, shorter if not all supplied */
+  PyObject *iterator; /* NULL once exhausted */
+  PyObject *rows[TABLEFUNCTION_BATCH];
+  int nrows, index;
+  sqlite3_int64 rowid;
+} apsw_tablefunction_cursor;
+
+static void
+tablefunction_free(void *context)
+{
+  tablefunctioninfo *tfi = (tablefunctioninfo *)context;
+  PyGILState_STATE gilstate = PyGILState_Ensure();
+
+  Py_XDECREF(tfi->generator);
+  sqlite3_free(tfi->schema);
+  PyMem_Free(tfi);
+
+  PyGILState_Release(gilstate);
+}
+
+static int
+tablefunctionConnect(sqlite3 *db, void *pAux, int Py_UNUSED(argc), const char *const *Py_UNUSED(argv), sqlite3_vtab **ppVtab, char **Py_UNUSED(pzErr))
+{
+  tablefunctioninfo *tfi = (tablefunctioninfo *)pAux;
+  apsw_tablefunction_vtab *vtab;
+  int res;
+
+  res = sqlite3_declare_vtab(db, tfi->schema);
+  if (res != SQLITE_OK)
+    return res;
+  vtab = sqlite3_malloc64(sizeof(apsw_tablefunction_vtab));
+  if (!vtab)
+    return SQLITE_NOMEM;
+  memset(vtab, 0, sizeof(apsw_tablefunction_vtab));
+  vtab->tfi = tfi;
+  *ppVtab = (sqlite3_vtab *)vtab;
+  return SQLITE_OK;
+}
+
+static int
+tablefunctionDisconnect(sqlite3_vtab *pVtab)
+{
+  sqlite3_free(pVtab);
+  return SQLITE_OK;
+}
+
+/* The arguments are equality constraints on the hidden columns.
+   idxNum is a bitmap of the ones supplied, which are passed to Filter
+   in order. */
+static int
+tablefunctionBestIndex(sqlite3_vtab *pVtab, sqlite3_index_info *info)
+{
+  tablefunctioninfo *tfi = ((apsw_tablefunction_vtab *)pVtab)->tfi;
+  int i, arg, nargs = 0, unusable = 0, which[32] = {0};
+
+  for (i = 0; i < info->nConstraint; i++)
+  {
+    arg = info->aConstraint[i].iColumn - tfi->ncolumns;
+    if (arg < 0 || info->aConstraint[i].op != SQLITE_INDEX_CONSTRAINT_EQ)
+      continue;
+    if (!info->aConstraint[i].usable)
+    {
+      unusable |= 1 << arg;
+      continue;
+    }
+    if (!(info->idxNum & (1 << arg)))
+    {
+      info->idxNum |= 1 << arg;
+      which[arg] = i + 1;
+    }
+  }
+  /* a plan where the argument value isn't available can't be used */
+  if (unusable & ~info->idxNum)
+    return SQLITE_CONSTRAINT;
+
+  for (arg = 0; arg < tfi->nargs; arg++)
+    if (which[arg])
+    {
+      info->aConstraintUsage[which[arg] - 1].argvIndex = ++nargs;
+      info->aConstraintUsage[which[arg] - 1].omit = 1;
+    }
+  info->estimatedCost = 1000;
+  info->estimatedRows = 1000;
+  return SQLITE_OK;
+}
+
+static int
+tablefunctionOpen(sqlite3_vtab *pVtab, sqlite3_vtab_cursor **ppCursor)
+{
+  apsw_tablefunction_cursor *cursor = sqlite3_malloc64(sizeof(apsw_tablefunction_cursor));
+  if (!cursor)
+    return SQLITE_NOMEM;
+  memset(cursor, 0, sizeof(apsw_tablefunction_cursor));
+  cursor->tfi = ((apsw_tablefunction_vtab *)pVtab)->tfi;
+  *ppCursor = (sqlite3_vtab_cursor *)cursor;
+  return SQLITE_OK;
+}
+
+/* called with the GIL held */
+static void
+tablefunction_clear(apsw_tablefunction_cursor *cursor)
+{
+  while (cursor->nrows)
+    Py_DECREF(cursor->rows[--cursor->nrows]);
+  cursor->index = 0;
+  Py_CLEAR(cursor->iterator);
+  Py_CLEAR(cursor->args);
+}
+
+/* gets the next batch of rows, called with the GIL held.  Returns -1
+   with an exception set on error */
+static int
+tablefunction_fill(apsw_tablefunction_cursor *cursor)
+{
+  PyObject *item, *row;
+
+  while (cursor->nrows)
+    Py_DECREF(cursor->rows[--cursor->nrows]);
+  cursor->index = 0;
+
+  while (cursor->iterator && cursor->nrows < TABLEFUNCTION_BATCH)
+  {
+    item = PyIter_Next(cursor->iterator);
+    if (!item)
+    {
+      Py_CLEAR(cursor->iterator);
+      return PyErr_Occurred() ? -1 : 0;
+    }
+    /* a single column can be given as just the value */
+    if (cursor->tfi->ncolumns == 1 && !PyTuple_Check(item))
+      row = PyTuple_Pack(1, item);
+    else
+      row = PySequence_Tuple(item);
+    Py_DECREF(item);
+    if (!row)
+      return -1;
+    if (PyTuple_GET_SIZE(row) != cursor->tfi->ncolumns)
+    {
+      PyErr_Format(PyExc_ValueError, "Table function row has %zd values but there are %d columns", PyTuple_GET_SIZE(row), cursor->tfi->ncolumns);
+      Py_DECREF(row);
+      return -1;
+    }
+    cursor->rows[cursor->nrows++] = row;
+  }
+  return 0;
+}
+
+static int
+tablefunctionFilter(sqlite3_vtab_cursor *pCursor, int idxNum, const char *Py_UNUSED(idxStr), int argc, sqlite3_value **argv)
+{
+  apsw_tablefunction_cursor *cursor = (apsw_tablefunction_cursor *)pCursor;
+  PyObject *result = NULL, *value;
+  PyGILState_STATE gilstate;
+  int sqliteres = SQLITE_OK, arg, nargs = 0, used = 0;
+
+  gilstate = PyGILState_Ensure();
+
+  tablefunction_clear(cursor);
+  cursor->rowid = 0;
+
+  /* arguments up to the last supplied one, with None for any missing */
+  for (arg = 0; arg < cursor->tfi->nargs; arg++)
+    if (idxNum & (1 << arg))
+      nargs = arg + 1;
+  cursor->args = PyTuple_New(nargs);
+  if (!cursor->args)
+    goto pyexception;
+  for (arg = 0; arg < nargs; arg++)
+  {
+    if ((idxNum & (1 << arg)) && used < argc)
+      value = convert_value_to_pyobject(argv[used++]);
+    else
+    {
+      value = Py_None;
+      Py_INCREF(value);
+    }
+    if (!value)
+      goto pyexception;
+    PyTuple_SET_ITEM(cursor->args, arg, value);
+  }
+
+  result = PyObject_CallObject(cursor->tfi->generator, cursor->args);
+  if (!result)
+    goto pyexception;
+  cursor->iterator = PyObject_GetIter(result);
+  if (!cursor->iterator || tablefunction_fill(cursor))
+    goto pyexception;
+  goto finally;
+
+pyexception: /* we had an exception in python code */
+  assert(PyErr_Occurred());
+  sqliteres = MakeSqliteMsgFromPyException(&(pCursor->pVtab->zErrMsg));
+  AddTraceBackHere(__FILE__, __LINE__, "TableFunction.xFilter", "{s: O, s: O}", "generator", cursor->tfi->generator, "args", OBJ(cursor->args));
+
+finally:
+  Py_XDECREF(result);
+  PyGILState_Release(gilstate);
+  return sqliteres;
+}
+
+static int
+tablefunctionNext(sqlite3_vtab_cursor *pCursor)
+{
+  apsw_tablefunction_cursor *cursor = (apsw_tablefunction_cursor *)pCursor;
+  PyGILState_STATE gilstate;
+  int sqliteres = SQLITE_OK;
+
+  cursor->rowid++;
+  if (++cursor->index < cursor->nrows)
+    return SQLITE_OK;
+
+  gilstate = PyGILState_Ensure();
+  if (tablefunction_fill(cursor))
+  {
+    sqliteres = MakeSqliteMsgFromPyException(&(pCursor->pVtab->zErrMsg));
+    AddTraceBackHere(__FILE__, __LINE__, "TableFunction.xNext", "{s: O, s: O}", "generator", cursor->tfi->generator, "args", OBJ(cursor->args));
+  }
+  PyGILState_Release(gilstate);
+  return sqliteres;
+}
+
+static int
+tablefunctionEof(sqlite3_vtab_cursor *pCursor)
+{
+  apsw_tablefunction_cursor *cursor = (apsw_tablefunction_cursor *)pCursor;
+  return cursor->index >= cursor->nrows;
+}
+
+static int
+tablefunctionColumn(sqlite3_vtab_cursor *pCursor, sqlite3_context *result, int ncolumn)
+{
+  apsw_tablefunction_cursor *cursor = (apsw_tablefunction_cursor *)pCursor;
+  PyGILState_STATE gilstate;
+  int sqliteres = SQLITE_OK, arg = ncolumn - cursor->tfi->ncolumns;
+
+  gilstate = PyGILState_Ensure();
+  if (arg < 0)
+    set_context_result(result, PyTuple_GET_ITEM(cursor->rows[cursor->index], ncolumn));
+  else if (arg < PyTuple_GET_SIZE(cursor->args))
+    set_context_result(result, PyTuple_GET_ITEM(cursor->args, arg));
+  else
+    sqlite3_result_null(result);
+  if (PyErr_Occurred())
+  {
+    sqliteres = MakeSqliteMsgFromPyException(&(pCursor->pVtab->zErrMsg));
+    AddTraceBackHere(__FILE__, __LINE__, "TableFunction.xColumn", "{s: O, s: i}", "generator", cursor->tfi->generator, "column", ncolumn);
+  }
+  PyGILState_Release(gilstate);
+  return sqliteres;
+}
+
+static int
+tablefunctionRowid(sqlite3_vtab_cursor *pCursor, sqlite3_int64 *pRowid)
+{
+  *pRowid = ((apsw_tablefunction_cursor *)pCursor)->rowid;
+  return SQLITE_OK;
+}
+
+static int
+tablefunctionClose(sqlite3_vtab_cursor *pCursor)
+{
+  PyGILState_STATE gilstate = PyGILState_Ensure();
+  tablefunction_clear((apsw_tablefunction_cursor *)pCursor);
+  PyGILState_Release(gilstate);
+  sqlite3_free(pCursor);
+  return SQLITE_OK;
+}
+
+static struct sqlite3_module apsw_tablefunction_module =
+    {
+        1, /* version */
+        0, /* create - eponymous only */
+        tablefunctionConnect,
+        tablefunctionBestIndex,
+        tablefunctionDisconnect,
+        0, /* destroy */
+        tablefunctionOpen,
+        tablefunctionClose,
+        tablefunctionFilter,
+        tablefunctionNext,
+        tablefunctionEof,
+        tablefunctionColumn,
+        tablefunctionRowid,
+        0, 0, 0, 0, 0, 0, 0};
+
 /**
 
 Troubleshooting virtual tables
@@ -56,6 +56,8 @@ def write_whole_file(name, mode, data, *, encoding=None):
 
 import unittest
 import math
+import array
+import io
 import random
 import time
 import threading
@@ -634,6 +636,147 @@ class APSW(unittest.TestCase):
         for i, v in enumerate(c.execute("select * from xxset order by x")):
             self.assertEqual(v, result[i])
 
+    def testExecutemanyBatched(self):
+        "Check executemany binding and stepping rows in batches"
+        db = apsw.Connection(":memory:")
+        c = db.cursor()
+        c.execute("create table foo(x,y,z)")
+        zb = apsw.zeroblob(7)
+        rows = [(i, i / 3, "\u1234%d" % i if i % 2 else b"\x01\x02" * i) for i in range(2000)]
+        rows.append((None, array.array("i", [1, 2]), zb))
+        c.executemany("insert into foo values(?,?,?)", rows)
+        self.assertEqual(rows[:-1], c.execute("select * from foo where x is not null order by x").fetchall())
+        self.assertEqual([(None, array.array("i", [1, 2]).tobytes(), b"\0" * 7)],
+                         c.execute("select * from foo where x is null").fetchall())
+        c.execute("delete from foo")
+        # lists, dicts with missing keys being null, and iterators of them mixed
+        def gen():
+            for i in range(1000):
+                yield [i, i, i] if i % 3 else {"x": i, "z": "z"}
+
+        c.executemany("insert into foo values(:x, :y, :z)", gen())
+        self.assertEqual([(3, None, "z"), (4, 4, 4)], c.execute("select * from foo where x in (3,4) order by x").fetchall())
+        self.assertEqual(1000, c.execute("select count(*) from foo").fetchall()[0][0])
+        c.execute("delete from foo")
+        # errors part way through run the rows before the error
+        for bad, exc in ((self, TypeError), (2**70, OverflowError), ([1, 2], apsw.BindingsError),
+                         ({"x": 3}, apsw.BindingsError)):
+            c.execute("delete from foo")
+            data = [(i, i, i) for i in range(700)]
+            data.append(bad if isinstance(bad, (list, dict)) else (1, bad, 3))
+            data.extend(data[:10])
+            self.assertRaises(exc, c.executemany, "insert into foo values(?,?,?)", data)
+            self.assertEqual(700, c.execute("select count(*) from foo").fetchall()[0][0])
+
+        def bad_iter():
+            for i in range(600):
+                yield (i, i, i)
+            1 / 0
+
+        c.execute("delete from foo")
+        self.assertRaises(ZeroDivisionError, c.executemany, "insert into foo values(?,?,?)", bad_iter())
+        self.assertEqual(600, c.execute("select count(*) from foo").fetchall()[0][0])
+        # sqlite errors stop at the failing row
+        c.execute("create table uniq(x unique)")
+        self.assertRaises(apsw.ConstraintError, c.executemany, "insert into uniq values(?)",
+                          [(i % 300, ) for i in range(1000)])
+        self.assertEqual(300, c.execute("select count(*) from uniq").fetchall()[0][0])
+
+        def func(x):
+            if x == 400:
+                1 / 0
+            return x
+
+        db.createscalarfunction("func", func)
+        self.assertRaises(ZeroDivisionError, c.executemany, "insert into uniq values(func(?))",
+                          [(i, ) for i in range(300, 1000)])
+        self.assertEqual(400, c.execute("select count(*) from uniq").fetchall()[0][0])
+        # cursor is reusable afterwards
+        self.assertEqual([(1, )], c.execute("select 1").fetchall())
+        # exec tracer still sees every row
+        seen = []
+        c.setexectrace(lambda cur, sql, bindings: seen.append(bindings) or True)
+        c.executemany("insert into uniq values(?)", [(i, ) for i in range(1000, 1010)])
+        self.assertEqual([(i, ) for i in range(1000, 1010)], seen)
+        c.setexectrace(None)
+
+    def testExecutemanyColumns(self):
+        "Check executemany_columns"
+        db = apsw.Connection(":memory:")
+        c = db.cursor()
+        c.execute("create table foo(x,y,z)")
+        self.assertRaises(TypeError, c.executemany_columns, "insert into foo values(?,?,?)", 3)
+        self.assertRaises(ValueError, c.executemany_columns, "insert into foo values(?,?,?)", ([1], [2, 3], [4]))
+        self.assertRaises(apsw.BindingsError, c.executemany_columns, "insert into foo values(?,?,?)", ([1], [2]))
+        self.assertRaises(TypeError, c.executemany_columns, "insert into foo values(?,?,?)",
+                          ([1], [2], memoryview(b"ab").cast("c")))
+        self.assertRaises(TypeError, c.executemany_columns, "insert into foo values(?,?,?)",
+                          ([1], [2], memoryview(array.array("q", [1, 2])).cast("B").cast("q", (1, 2))))
+        n = 1000
+        c.executemany_columns("insert into foo values(?,?,?)",
+                              (array.array("q", range(n)), array.array("f", [i / 2 for i in range(n)]),
+                               ["t%d" % i if i % 3 else None for i in range(n)]))
+        self.assertEqual([(i, i / 2, "t%d" % i if i % 3 else None) for i in range(n)],
+                         c.execute("select * from foo order by x").fetchall())
+        for code in "bBhHiIlLqQ":
+            c.execute("delete from foo")
+            c.executemany_columns("insert into foo values(?,?,?)",
+                                  (array.array(code, [1, 2, 3]), memoryview(b"\x00\x01\x02"), ["a", "b", "c"]))
+            self.assertEqual([(1, 0, "a"), (2, 1, "b"), (3, 2, "c")], c.execute("select * from foo order by x").fetchall())
+        self.assertRaises(OverflowError, c.executemany_columns, "insert into foo values(?,?,?)",
+                          (array.array("Q", [2**64 - 1]), [1], [2]))
+        # not batchable falls back to executemany with rows
+        self.assertEqual([(1, 4.5), (2, 5.5)], c.executemany_columns("select ?, ?", (array.array("l", [1, 2]), array.array("d", [4.5, 5.5]))).fetchall())
+        seen = []
+        c.setexectrace(lambda cur, sql, bindings: seen.append(bindings) or True)
+        c.executemany_columns("insert into foo values(?,?,?)", ([7, 8], array.array("d", [1, 2]), "ab"))
+        self.assertEqual([(7, 1.0, "a"), (8, 2.0, "b")], seen)
+        c.setexectrace(None)
+        # empty
+        c.executemany_columns("insert into foo values(?,?,?)", ([], [], []))
+        # errors part way
+        c.execute("delete from foo")
+        self.assertRaises(TypeError, c.executemany_columns, "insert into foo values(?,?,?)",
+                          (range(500), range(500), [1] * 400 + [self] * 100))
+        self.assertEqual(400, c.execute("select count(*) from foo").fetchall()[0][0])
+
+    def testCursorStaticBindings(self):
+        "Check binding without copies"
+        db = apsw.Connection(":memory:")
+        c = db.cursor()
+        self.assertEqual(False, c.static_bindings)
+        self.assertRaises(TypeError, delattr, c, "static_bindings")
+        c.static_bindings = 1
+        self.assertEqual(True, c.static_bindings)
+        big = "x" * 100000 + "\N{BLACK STAR}"
+        vals = (None, 3, 4.5, "abc", big, b"def", bytearray(b"ghi"), memoryview(b"jkl"), array.array("i", [1]), apsw.zeroblob(3))
+        self.assertEqual([tuple(v if not isinstance(v, (bytearray, memoryview, array.array, apsw.zeroblob)) else
+                                bytes(v) if not isinstance(v, apsw.zeroblob) else b"\0\0\0" for v in vals)],
+                         c.execute("select " + ",".join("?" * len(vals)), vals).fetchall())
+        # buffers stay exported until the statement is reset
+        ba = bytearray(b"abc")
+        c.execute("select ?; select ?", (ba, 7))
+        self.assertRaises(BufferError, ba.append, 1)
+        self.assertEqual([(b"abc", ), (7, )], [next(c), next(c)])
+        ba.append(1)
+        for i in range(3):
+            self.assertEqual([(bytes(ba), )], c.execute("select ?", (ba, )).fetchall())
+            ba.append(1)
+        c.execute("select ?", (ba, ))
+        self.assertRaises(BufferError, ba.append, 1)
+        c.close()
+        ba.append(1)
+        c = db.cursor()
+        c.static_bindings = True
+        self.assertRaises(BufferError, c.execute, "select ?", (memoryview(b"abcd")[::2], ))
+        c.execute("create table foo(x)")
+        c.setexectrace(lambda *args: True)
+        c.executemany("insert into foo values(?)", [("row%d" % i, ) for i in range(10)] + [(ba, )])
+        self.assertEqual(11, c.execute("select count(*) from foo").fetchall()[0][0])
+        ba.append(1)
+        c.close()
+        self.assertRaises(apsw.CursorClosedError, getattr, c, "static_bindings")
+
     def testCursor(self):
         "Check functionality of the cursor"
         c = self.db.cursor()
@@ -731,6 +874,246 @@ class APSW(unittest.TestCase):
         self.assertEqual(c.fetchall(), [])
         self.assertEqual(c.execute("select 3; select 4").fetchall(), [(3, ), (4, )])
 
+    def testCursorFetchmany(self):
+        "Check batched fetching of rows"
+        c = self.db.cursor()
+        self.assertRaises(TypeError, c.fetchmany, "3")
+        self.assertRaises(ValueError, c.fetchmany, -1)
+        self.assertEqual([], c.fetchmany())
+        c.execute("create table foo(x,y)")
+        vals = test_types_vals
+        rows = [(i, vals[i % len(vals)]) for i in range(300)]
+        c.executemany("insert into foo values(?,?)", rows)
+        c.execute("select * from foo order by x")
+        got = []
+        while True:
+            batch = c.fetchmany(size=71)
+            if not batch:
+                break
+            self.assertTrue(len(batch) == 71 or len(got) + len(batch) == len(rows))
+            got.extend(batch)
+        self.assertEqual(rows, got)
+        self.assertEqual([], c.fetchmany(10))
+        # fetchall uses same mechanism
+        self.assertEqual(rows, c.execute("select * from foo order by x").fetchall())
+        self.assertEqual(rows[2:], c.execute("select * from foo order by x").fetchmany(2) and c.fetchall())
+        # spans statements and mixes with other fetching
+        c.execute("select 1 union all select 2; create table bar(x); select 3, 4; select 5 union all select 6")
+        self.assertEqual((1, ), c.fetchone())
+        self.assertEqual([(2, ), (3, 4), (5, )], c.fetchmany(3))
+        self.assertTableExists("bar")
+        self.assertEqual([(6, )], c.fetchmany(3))
+        self.assertEqual([], c.fetchmany(3))
+        # executemany
+        c.executemany("select ?", [(i, ) for i in range(10)])
+        self.assertEqual([(i, ) for i in range(10)], c.fetchmany(100))
+        # row tracer is honoured, including skipping rows
+        c.setrowtrace(lambda cur, row: None if row[0] % 2 else (row[0] * 10, cur.getdescription()[0][0]))
+        self.assertEqual([(0, "x"), (20, "x"), (40, "x")], c.execute("select x from foo order by x").fetchmany(3))
+        self.assertEqual((60, "x"), c.fetchone())
+        c.setrowtrace(None)
+        # errors part way through
+        def func(x):
+            if x == 200:
+                1 / 0
+            return x
+
+        self.db.createscalarfunction("func", func)
+        c.execute("select func(x) from foo")
+        self.assertEqual([(i, ) for i in range(100)], c.fetchmany(100))
+        self.assertRaises(ZeroDivisionError, c.fetchmany, 1000)
+        self.assertEqual([], c.fetchmany())
+        self.assertRaises(ZeroDivisionError, c.execute("select func(x) from foo").fetchall)
+        c.close()
+        self.assertRaises(apsw.CursorClosedError, c.fetchmany)
+
+    def testCursorFetchmanyColumns(self):
+        "Check columnar batch fetching"
+        c = self.db.cursor()
+        self.assertRaises(TypeError, c.fetchmany_columns, "3")
+        self.assertRaises(ValueError, c.fetchmany_columns, 0)
+        self.assertIsNone(c.fetchmany_columns())
+        c.execute("create table foo(i,f,t,b,n)")
+        rows = [(i if i % 3 else None, i / 2 if i % 5 else None, "\u1234" * (i % 7) if i % 4 else None,
+                 b"\xfe" * (i % 11) if i % 6 else None, None) for i in range(5000)]
+        c.executemany("insert into foo values(?,?,?,?,?)", rows)
+
+        def bits(nulls, count):
+            return [bool(nulls[r // 8] & (1 << (r % 8))) for r in range(count)]
+
+        def unpack(col, count):
+            kind, values, offsets, nulls = col
+            isnull = bits(nulls, count)
+            if kind is None:
+                self.assertTrue(all(isnull))
+                self.assertIsNone(values)
+                return [None] * count
+            if kind in (str, bytes):
+                self.assertEqual(offsets.typecode, "q")
+                self.assertEqual(len(offsets), count + 1)
+                vals = [values[offsets[r]:offsets[r + 1]] for r in range(count)]
+                if kind is str:
+                    vals = [v.decode("utf8") for v in vals]
+            else:
+                self.assertIsNone(offsets)
+                self.assertEqual(values.typecode, "q" if kind is int else "d")
+                vals = list(values)
+            return [None if isnull[r] else vals[r] for r in range(count)]
+
+        got = []
+        c.setrowtrace(lambda *args: 1 / 0)  # row tracer is not called
+        c.execute("select * from foo order by rowid")
+        while True:
+            batch = c.fetchmany_columns(777)
+            if batch is None:
+                break
+            count, columns = batch
+            self.assertEqual(5, len(columns))
+            self.assertTrue(0 < count <= 777)
+            got.extend(zip(*[unpack(col, count) for col in columns]))
+        self.assertEqual(rows, got)
+        self.assertIsNone(c.fetchmany_columns())
+        c.setrowtrace(None)
+        # first non-null value determines column type
+        c.execute("select * from (values (null), (3), (4.5), ('7'), (x'38'))")
+        count, columns = c.fetchmany_columns()
+        self.assertEqual([None, 3, 4, 7, 8], unpack(columns[0], count))
+        c.execute("select * from (values (4.5), (3), ('x'))")
+        count, columns = c.fetchmany_columns()
+        self.assertEqual([4.5, 3.0, 0.0], unpack(columns[0], count))
+        c.execute("select * from (values ('a'), (3), (x'62'))")
+        count, columns = c.fetchmany_columns()
+        self.assertEqual(["a", "3", "b"], unpack(columns[0], count))
+        # batches do not span statements and mix with normal iteration
+        c.execute("select 1 union all select 2; create table bar(x); select 'x', 'y'; select 3")
+        self.assertEqual((1, ), next(c))
+        count, columns = c.fetchmany_columns(10)
+        self.assertEqual([2], unpack(columns[0], count))
+        count, columns = c.fetchmany_columns(10)
+        self.assertEqual([["x"], ["y"]], [unpack(col, count) for col in columns])
+        self.assertEqual([(3, )], c.fetchall())
+        self.assertTableExists("bar")
+        # errors part way through
+        def func(x):
+            if x == 50:
+                1 / 0
+            return x
+
+        self.db.createscalarfunction("func", func)
+        c.execute("select func(rowid) from foo")
+        count, columns = c.fetchmany_columns(10)
+        self.assertEqual(list(range(1, 11)), unpack(columns[0], count))
+        # rows 11 to 49 are lost with the batch
+        self.assertRaises(ZeroDivisionError, c.fetchmany_columns, 100)
+        self.assertIsNone(c.fetchmany_columns())
+        c.close()
+        self.assertRaises(apsw.CursorClosedError, c.fetchmany_columns)
+
+    def testCursorWriteTo(self):
+        "Check native writing of rows"
+        import base64
+        import csv
+        import json
+        import struct
+        c = self.db.cursor()
+        self.assertRaises(TypeError, c.write_to)
+        self.assertRaises(AttributeError, c.write_to, 3)
+        self.assertRaises(ValueError, c.write_to, io.BytesIO(), format="xml")
+        self.assertEqual(0, c.write_to(io.BytesIO()))
+        c.execute("create table foo(i,f,t,b)")
+        rows = [(1, 2.5, "a,b", b"\x00\xff"), (None, -0.1, 'say "hi"\n', b""), (2**63 - 1, 1e400, "", None),
+                (-3, 1e-300, "ሴ\x01\\/", b"abcd")]
+        c.executemany("insert into foo values(?,?,?,?)", rows)
+
+        def write(format, **kwargs):
+            f = io.BytesIO()
+            n = c.execute("select * from foo order by rowid").write_to(f, format=format, **kwargs)
+            self.assertEqual(len(rows), n)
+            return f.getvalue()
+
+        # csv and tsv match the csv module apart from blobs which are raw bytes
+        for format, dialect in (("csv", "excel"), ("tsv", "excel-tab")):
+            s = io.StringIO()
+            w = csv.writer(s, dialect=dialect, lineterminator="\n")
+            w.writerow(("i", "f", "t", "b"))
+            for row in rows:
+                w.writerow(["NULL" if v is None else "" if isinstance(v, bytes) else v for v in row])
+            out = write(format, header=True, nullvalue="NULL").replace(b"\x00\xff", b"").replace(b"abcd", b"")
+            self.assertEqual(s.getvalue().encode("utf8"), out)
+        # jsonl
+        lines = write("jsonl").decode("utf8").split("\n")
+        self.assertEqual("", lines[-1])
+        for row, line in zip(rows, lines):
+            expected = dict(zip(("i", "f", "t", "b"), row))
+            expected["b"] = None if row[3] is None else base64.b64encode(row[3]).decode("ascii")
+            self.assertEqual(expected, json.loads(line))
+        # sql matches apsw.format_sql_value other than infinity
+        expected = "".join("INSERT INTO [x y] VALUES(%s);\n" % ",".join(
+            "1e999" if v == 1e400 else apsw.format_sql_value(v) for v in row) for row in rows)
+        self.assertEqual(expected.encode("utf8"), write("sql", table="[x y]"))
+        # floats are the same as repr
+        rng = random.Random(11)
+        doubles = [6.156563468186638e+113, 5e-324, 2.2250738585072014e-308, 1.7976931348623157e+308, 0.1, 1e16, 123456789012345.6]
+        while len(doubles) < 20000:
+            v = struct.unpack("<d", struct.pack("<Q", rng.getrandbits(64)))[0]
+            if not math.isinf(v) and not math.isnan(v):
+                doubles.append(v)
+            doubles.append(round(rng.uniform(-1000, 1000), rng.randint(0, 8)))
+        c.execute("create temp table doubles(v)")
+        c.executemany("insert into doubles values(?)", ((v, ) for v in doubles))
+        s = io.StringIO()
+        c.execute("select v from doubles order by rowid").write_to(s)
+        self.assertEqual("".join(repr(v) + "\n" for v in doubles), s.getvalue())
+        # text files get str
+        s = io.StringIO()
+        c.execute("select 'é' as x, 1 as y").write_to(s, header=True)
+        self.assertEqual("x,y\né,1\n", s.getvalue())
+        # single empty values are quoted so the line isn't blank
+        s = io.StringIO()
+        c.execute("select ''").write_to(s)
+        self.assertEqual('""\n', s.getvalue())
+        # multiple statements each get a header, but only if they have rows
+        s = io.StringIO()
+        c.execute("select 1 as a; select 2 as b where 0; create table bar(x); select 3 as c, 4 as d")
+        self.assertEqual((1, ), next(c))
+        self.assertEqual(1, c.write_to(s, header=True))
+        self.assertEqual("c,d\n3,4\n", s.getvalue())
+        self.assertTableExists("bar")
+        # row tracer is not called
+        c.setrowtrace(lambda *args: 1 / 0)
+        f = io.BytesIO()
+        c.execute("select 1").write_to(f)
+        self.assertEqual(b"1\n", f.getvalue())
+        c.setrowtrace(None)
+        # errors part way through still write the rows already done
+        def func(x):
+            if x == 1000:
+                1 / 0
+            return x
+
+        self.db.createscalarfunction("func", func)
+        f = io.BytesIO()
+        self.assertRaises(ZeroDivisionError, c.execute("with r(x) as (select 1 union all select x+1 from r where x<2000) select func(x) from r").write_to, f)
+        self.assertEqual(b"".join(b"%d\n" % i for i in range(1, 1000)), f.getvalue())
+
+        class badfile:
+            calls = 0
+
+            def write(self, data):
+                self.calls += 1
+                1 / 0
+
+        f = badfile()
+        self.assertRaises(ZeroDivisionError, c.execute("select 1").write_to, f)
+        # the failed chunk is not given to write again
+        self.assertEqual(1, f.calls)
+        f = badfile()
+        self.assertRaises(ZeroDivisionError,
+                          c.execute("with r(x) as (select 1 union all select x+1 from r where x<200000) select x from r").write_to, f)
+        self.assertEqual(1, f.calls)
+        c.close()
+        self.assertRaises(apsw.CursorClosedError, c.write_to, io.BytesIO())
+
     def testTypes(self):
         "Check type information is maintained"
         c = self.db.cursor()
@@ -1458,6 +1841,53 @@ class APSW(unittest.TestCase):
         self.db.createcollation("collbadtype", collerror)
         self.assertRaises(TypeError, c.execute, "select x from foo order by x collate collbadtype")
 
+        # key collations
+        self.assertRaises(TypeError, self.db.create_key_collation, "strnumkey", 12)
+        self.assertRaises(ValueError, self.db.create_key_collation, "strnumkey", str.encode, 0)
+        keycalls = []
+
+        def strnumkey(s):
+            keycalls.append(s)
+            head = s.rstrip("0123456789")
+            return head.encode("utf8") + b"\0" + s[len(head):].rjust(20, "0").encode("ascii")
+
+        for cache_size in (1, 3, 100):
+            self.db.create_key_collation("strnumkey", strnumkey, cache_size)
+            del keycalls[:]
+            self.assertEqual(list(vals), [row[0] for row in c.execute("select x from foo order by x collate strnumkey")])
+            # each distinct string only needs its key once with a big enough cache
+            if cache_size == 100:
+                self.assertEqual(len(vals), len(keycalls))
+        words = ["%s%d" % (random.choice("abc"), random.randrange(1000)) for _ in range(2000)]
+        self.db.create_key_collation("strnumkey", strnumkey, 64)
+        self.assertEqual(sorted(words, key=strnumkey),
+                         [row[0] for row in c.execute("select column1 from (values %s) order by 1 collate strnumkey" % ",".join("('%s')" % w for w in words))])
+        self.assertEqual([(1, )], c.execute("select ? = ? collate strnumkey", (uni + "file07", uni + "file7")).fetchall())
+        self.db.create_key_collation("keyerror", lambda s: 1 / 0)
+        self.assertRaises(ZeroDivisionError, c.execute, "select x from foo order by x collate keyerror")
+        self.db.create_key_collation("keybadtype", lambda s: s)
+        self.assertRaises(TypeError, c.execute, "select x from foo order by x collate keybadtype")
+
+        # native collations
+        self.assertRaises(ValueError, self.db.create_native_collation, "nat", "unknown")
+        for name in ("natural", "casefold", "noaccent"):
+            self.db.create_native_collation("n" + name, name)
+        self.assertEqual(list(vals), [row[0] for row in c.execute("select x from foo order by x collate nnatural")])
+        words = ["file10", "file9", "file09", "file1", "File2", "2", "10", "a", "a0", ""]
+        self.assertEqual(["", "2", "10", "File2", "a", "a0", "file1", "file09", "file9", "file10"],
+                         [row[0] for row in c.execute("select column1 from (values %s) order by 1 collate nnatural" % ",".join("('%s')" % w for w in words))])
+        for one, two, casefold, noaccent in (
+            ("Straße", "STRASSE", 0, 0),
+            ("Élan", "elan", 1, 0),
+            ("E\u0301lan", "élan", -1, 0),
+            ("ABCDEFGHIJKLMNOPqrstu", "abcdefghijklmnopQRSTU", 0, 0),
+            ("abcdefghij[", "ABCDEFGHIJ{", -1, -1),
+            ("ΣΊΣΥΦΟΣ", "σίσυφος", 0, 0),
+            ("\uac00", "\uac01", -1, -1),
+        ):
+            for name, expected in (("ncasefold", casefold), ("nnoaccent", noaccent)):
+                self.assertEqual([(expected == 0, expected < 0)], c.execute("select ? = ? collate %s, ? < ? collate %s" % (name, name), (one, two, one, two)).fetchall())
+
         # get error when registering
         c.execute("select x from foo order by x collate strnum")  # nb we don't read so cursor is still active
         self.assertRaises(apsw.BusyError, self.db.createcollation, "strnum", strnumcollate)
@@ -1900,6 +2330,294 @@ class APSW(unittest.TestCase):
         c.execute("insert into foo values(1000,1000)")
         self.assertEqual(1, next(c.execute("select count(*) from foo where x=1000"))[0])
 
+    def testChangesHook(self):
+        "Verify change capture"
+        c = self.db.cursor()
+        c.execute("create table foo(x integer primary key, y); create table bar(z)")
+        self.assertRaises(TypeError, self.db.set_changes_hook, 12)
+        calls = []
+
+        def changes(committed, changes):
+            calls.append((committed, changes))
+
+        self.db.set_changes_hook(changes)
+        c.execute("insert into foo values(3,4)")
+        self.assertEqual([(True, [(apsw.SQLITE_INSERT, "main", "foo", 3)])], calls)
+        del calls[:]
+        c.execute("begin; insert into foo values(5,6); update foo set y=7 where x=3; insert into bar values(1)")
+        self.assertEqual([], calls)
+        c.execute("delete from foo where x>0; commit")
+        self.assertEqual([(True, [(apsw.SQLITE_INSERT, "main", "foo", 5), (apsw.SQLITE_UPDATE, "main", "foo", 3),
+                                  (apsw.SQLITE_INSERT, "main", "bar", 1), (apsw.SQLITE_DELETE, "main", "foo", 3),
+                                  (apsw.SQLITE_DELETE, "main", "foo", 5)])], calls)
+        del calls[:]
+        self.db.set_changes_hook(changes, by_table=True)
+        c.execute("begin; insert into foo values(5,6); insert into bar values(2); insert into foo values(6,6); rollback")
+        self.assertEqual([(False, {("main", "foo"): [(apsw.SQLITE_INSERT, 5), (apsw.SQLITE_INSERT, 6)], ("main", "bar"): [(apsw.SQLITE_INSERT, 2)]})], calls)
+        del calls[:]
+        c.execute("begin; commit; select * from foo")
+        self.assertEqual([], calls)
+        # rows undone by rolling back to a savepoint are removed
+        c.execute("begin; insert into foo values(1,1); savepoint s; insert into foo values(2,2); rollback to s; commit")
+        self.assertEqual([(True, {("main", "foo"): [(apsw.SQLITE_INSERT, 1)]})], calls)
+        del calls[:]
+        c.execute("""savepoint "A b"; insert into foo values(3,3); savepoint [c]; insert into foo values(4,4);
+                     /* comment */ release savepoint C; insert into foo values(5,5); savepoint d;
+                     insert into foo values(6,6); rollback transaction to savepoint 'a B'; insert into foo values(7,7);
+                     release "A b" """)
+        self.assertEqual([(True, {("main", "foo"): [(apsw.SQLITE_INSERT, 7)]})], calls)
+        del calls[:]
+        try:
+            with self.db:
+                c.execute("insert into foo values(8,8)")
+                with self.db:
+                    c.execute("insert into foo values(9,9)")
+                    1 / 0
+        except ZeroDivisionError:
+            pass
+        self.assertEqual([], calls)
+        del calls[:]
+        c.execute("delete from foo")
+        del calls[:]
+        # a failed statement may have undone its rows
+        c.execute("create table uniq(x unique)")
+        c.execute("begin; insert into uniq values(1)")
+        self.assertRaises(apsw.ConstraintError, c.execute, "insert into uniq values(2), (1)")
+        c.execute("commit")
+        self.assertEqual(None, calls[0][0])
+        self.assertEqual([(1, )], c.execute("select x from uniq").fetchall())
+        del calls[:]
+        c.execute("begin; insert into uniq values(3)")
+        self.assertRaises(apsw.ConstraintError, c.execute, "insert into uniq values(1)")
+        c.execute("commit")
+        self.assertEqual(True, calls[0][0])
+        del calls[:]
+        # but statements that succeed without counting their changes are fine
+        c.execute("create view uniqview as select x from uniq; create trigger uniqtrig instead of insert on uniqview "
+                  "begin insert into uniq values(new.x); end")
+        c.execute("begin; insert into uniqview values(5)")
+        c2 = self.db.cursor()
+        self.assertEqual((6, ), next(c2.execute("insert into uniq values(6), (7) returning x")))
+        c2.close()
+        c.execute("insert into uniqview values(8); commit")
+        self.assertEqual(True, calls[0][0])
+        self.assertEqual([(5, ), (6, ), (7, ), (8, )], c.execute("select x from uniq where x > 4").fetchall())
+        del calls[:]
+        # and failures are noticed however the statement is run
+        c.execute("begin")
+        self.assertRaises(apsw.ConstraintError, c.executemany, "insert into uniq values(?)", ((9, ), (10, ), (10, )))
+        c.execute("commit")
+        self.assertEqual(True, calls[0][0])
+        c.execute("begin")
+        self.assertRaises(apsw.ConstraintError, c.executemany, "insert into uniqview values(?), (?)", ((11, 12), (13, 1)))
+        c.execute("commit")
+        self.assertEqual(None, calls[1][0])
+        c.execute("begin")
+        self.assertRaises(apsw.ConstraintError, c.execute, "insert into uniq values(14), (1) returning x")
+        c.execute("commit")
+        self.assertEqual(None, calls[2][0])
+        del calls[:]
+        # setprofile keeps working
+        profiled = []
+        self.db.setprofile(lambda sql, t: profiled.append(sql))
+        self.db.set_changes_hook(changes)
+        self.db.set_changes_hook(None)
+        c.execute("select 3").fetchall()
+        self.db.set_changes_hook(changes, by_table=True)
+        c.execute("select 4").fetchall()
+        self.db.setprofile(None)
+        self.assertEqual(["select 3", "select 4"], profiled)
+        # a bulk change is one call
+        with self.db:
+            c.executemany("insert into foo values(?,?)", ((i, i) for i in range(10000)))
+        self.assertEqual(1, len(calls))
+        del calls[:]
+        c.execute("delete from foo where x>=0")
+        self.assertEqual(1, len(calls))
+        self.assertEqual(10000, len(calls[0][1][("main", "foo")]))
+
+        # works with the other hooks which are called first
+        hooks = []
+        self.db.setupdatehook(lambda *args: hooks.append("update"))
+        self.db.setcommithook(lambda: hooks.append("commit"))
+        self.db.setrollbackhook(lambda: hooks.append("rollback"))
+        self.db.set_changes_hook(lambda *args: hooks.append("changes"))
+        c.execute("insert into bar values(3)")
+        c.execute("begin; insert into bar values(3); rollback")
+        self.assertEqual(["update", "commit", "changes", "update", "rollback", "changes"], hooks)
+        del hooks[:]
+        self.db.setcommithook(lambda: True)
+        self.assertRaises(apsw.ConstraintError, c.execute, "insert into bar values(4)")
+        self.assertEqual(["update", "rollback", "changes"], hooks)
+        for hook in self.db.setupdatehook, self.db.setcommithook, self.db.setrollbackhook:
+            hook(None)
+        del hooks[:]
+        c.execute("insert into bar values(5)")
+        self.assertEqual(["changes"], hooks)
+        self.db.set_changes_hook(None)
+        c.execute("insert into bar values(5)")
+        self.assertEqual(["changes"], hooks)
+
+        # an exception at commit turns it into a rollback
+        def changes(committed, changes):
+            if committed:
+                1 / 0
+            calls.append((committed, changes))
+
+        del calls[:]
+        self.db.set_changes_hook(changes)
+        self.assertRaises(ZeroDivisionError, c.execute, "insert into bar values(6)")
+        self.assertEqual([], calls)
+        self.assertEqual(0, c.execute("select count(*) from bar where z=6").fetchall()[0][0])
+        self.db.set_changes_hook(None)
+
+    def testSession(self):
+        "Verify sessions and changesets"
+        if not hasattr(apsw, "Session"):
+            # setup.py says it must be present if it was enabled
+            self.assertNotIn("APSW_TEST_SESSION", os.environ)
+            return
+        schema = "create table foo(x integer primary key, y); create table bar(z primary key); create table nokey(a)"
+        c = self.db.cursor()
+        c.execute(schema)
+        c.execute("insert into foo values(1, 'one'), (2, 'two'); insert into bar values(1)")
+        replica = apsw.Connection(":memory:")
+        replica.cursor().execute(schema)
+        replica.cursor().execute("insert into foo values(1, 'one'), (2, 'two'); insert into bar values(1)")
+
+        session = self.db.session()
+        self.assertTrue(session.is_empty)
+        self.assertTrue(session.enabled)
+        self.assertFalse(session.indirect)
+        session.attach("foo")
+        c.execute("update foo set y='uno' where x=1; delete from foo where x=2; insert into foo values(3, 'three')")
+        c.execute("insert into bar values(2); insert into nokey values(1)")
+        self.assertFalse(session.is_empty)
+        changeset = session.changeset()
+        self.assertTrue(isinstance(changeset, bytes))
+        self.assertTrue(len(session.patchset()) < len(changeset))
+        replica.apply_changeset(changeset)
+        self.assertEqual([(1, 'uno'), (3, 'three')], replica.cursor().execute("select * from foo order by x").fetchall())
+        self.assertEqual([(1, )], replica.cursor().execute("select * from bar").fetchall())
+        # applying again conflicts which aborts by default
+        self.assertRaises(apsw.AbortError, replica.apply_changeset, changeset)
+        self.assertRaises(TypeError, replica.apply_changeset, 3)
+        self.assertRaises(TypeError, replica.apply_changeset, changeset, conflict=3)
+
+        conflicts = []
+
+        def conflict(*args):
+            conflicts.append(args)
+            return apsw.SQLITE_CHANGESET_OMIT
+
+        replica.apply_changeset(changeset, conflict=conflict)
+        self.assertEqual([(apsw.SQLITE_CHANGESET_DATA, "foo", apsw.SQLITE_UPDATE, (1, 'one'), (None, 'uno'), (1, 'uno')),
+                          (apsw.SQLITE_CHANGESET_NOTFOUND, "foo", apsw.SQLITE_DELETE, (2, 'two'), None, None),
+                          (apsw.SQLITE_CHANGESET_CONFLICT, "foo", apsw.SQLITE_INSERT, None, (3, 'three'), (3, 'three'))],
+                         sorted(conflicts, key=lambda c: c[0]))
+        self.assertEqual("SQLITE_CHANGESET_DATA", apsw.mapping_session_conflict[conflicts[0][0]])
+
+        # replace
+        replica.cursor().execute("update foo set y='other' where x=3")
+        session.close()
+        session = self.db.session()
+        session.attach()
+        c.execute("update foo set y='drei' where x=3")
+        changeset = session.changeset()
+        self.assertRaises(apsw.AbortError, replica.apply_changeset, changeset)
+        replica.apply_changeset(changeset, conflict=lambda *args: apsw.SQLITE_CHANGESET_REPLACE)
+        self.assertEqual("drei", replica.cursor().execute("select y from foo where x=3").fetchall()[0][0])
+
+        # bad conflict return values and exceptions abort without changes
+        replica.cursor().execute("update foo set y='other' where x=3")
+        for retval, exc in (("omit", TypeError), (99, ValueError)):
+            self.assertRaises(exc, replica.apply_changeset, changeset, conflict=lambda *args: retval)
+        self.assertRaises(ZeroDivisionError, replica.apply_changeset, changeset, conflict=lambda *args: 1 / 0)
+        self.assertEqual("other", replica.cursor().execute("select y from foo where x=3").fetchall()[0][0])
+
+        # filter and invert
+        c.execute("insert into bar values(3); insert into foo values(4, 'four')")
+        changeset = session.changeset()
+        before = replica.cursor().execute("select * from foo union all select z, null from bar").fetchall()
+        tables = []
+        replica.apply_changeset(changeset, conflict=lambda *args: apsw.SQLITE_CHANGESET_REPLACE,
+                                filter=lambda table: tables.append(table) or table == "bar")
+        self.assertEqual({"foo", "bar"}, set(tables))
+        self.assertEqual([(3, )], replica.cursor().execute("select * from bar where z>1").fetchall())
+        self.assertEqual([], replica.cursor().execute("select * from foo where x=4").fetchall())
+        replica.apply_changeset(changeset, filter=lambda table: table == "bar", flags=apsw.SQLITE_CHANGESETAPPLY_INVERT)
+        self.assertEqual(before, replica.cursor().execute("select * from foo union all select z, null from bar").fetchall())
+
+        # an exception in the filter undoes changes to earlier tables
+        def filter(table):
+            tables.append(table)
+            if len(tables) > 1:
+                1 / 0
+            return True
+
+        del tables[:]
+        self.assertRaises(ZeroDivisionError, replica.apply_changeset, changeset,
+                          conflict=lambda *args: apsw.SQLITE_CHANGESET_REPLACE, filter=filter)
+        self.assertEqual(2, len(tables))
+        self.assertEqual(before, replica.cursor().execute("select * from foo union all select z, null from bar").fetchall())
+
+        # enabled and indirect
+        session.close()
+        session = self.db.session()
+        session.attach("bar")
+        session.enabled = False
+        c.execute("insert into bar values(4)")
+        self.assertTrue(session.is_empty)
+        session.enabled = True
+        session.indirect = True
+        self.assertTrue(session.indirect)
+        c.execute("insert into bar values(5)")
+        self.assertFalse(session.is_empty)
+
+        # streaming
+        for i in range(100):
+            c.execute("insert into bar values(?)", ("x" * 1000 + str(i), ))
+        pieces = []
+        session.changeset_stream(pieces.append)
+        self.assertTrue(len(pieces) > 1)
+        self.assertEqual(session.changeset(), b"".join(pieces))
+        pieces = []
+        session.patchset_stream(pieces.append)
+        self.assertEqual(session.patchset(), b"".join(pieces))
+        self.assertRaises(TypeError, session.changeset_stream, 3)
+
+        def output(data):
+            1 / 0
+
+        self.assertRaises(ZeroDivisionError, session.changeset_stream, output)
+
+        stream = io.BytesIO(session.changeset())
+        requested = []
+
+        def read(n):
+            requested.append(n)
+            return stream.read(n)
+
+        replica.apply_changeset(read)
+        self.assertTrue(len(requested) > 1)
+        self.assertEqual(102, replica.cursor().execute("select count(*) from bar").fetchall()[0][0])
+        replica.cursor().execute("delete from bar where z>4")
+        stream.seek(0)
+        self.assertRaises(ValueError, replica.apply_changeset, lambda n: stream.read(n + 1))
+        self.assertRaises(ZeroDivisionError, replica.apply_changeset, lambda n: 1 / 0)
+        self.assertEqual(1, replica.cursor().execute("select count(*) from bar").fetchall()[0][0])
+
+        # closing
+        with self.db.session() as other:
+            other.attach()
+        self.assertRaises(apsw.ConnectionClosedError, other.changeset)
+        self.assertRaises(apsw.ConnectionClosedError, lambda: other.enabled)
+        other.close()
+        self.db.close()
+        self.assertRaises(apsw.ConnectionClosedError, session.changeset)
+        session.close()
+        replica.close()
+
     def testProfile(self):
         "Verify profiling"
         # we do the test by looking for the maximum of PROFILESTEPS random
@@ -2943,6 +3661,278 @@ class APSW(unittest.TestCase):
         cur.execute("drop table foo")
         self.db.close()
 
+    def testVTableNextRows(self):
+        "Verify virtual table cursors returning batches of rows"
+        ncols = 20
+        data = [(i * 3, ) + tuple(i * c if c % 3 else "%d-%d" % (i, c) for c in range(ncols)) for i in range(1000)]
+        calls = {"NextRows": 0}
+        mode = {"batch": 64, "fail": None}
+
+        class Source:
+
+            def Create(self, *args):
+                return "create table x(%s)" % ",".join("c%d" % c for c in range(ncols)), Table()
+
+            Connect = Create
+
+        class Table:
+
+            def BestIndex(self, *args):
+                return None
+
+            def Open(self):
+                return Cursor()
+
+            def Disconnect(self):
+                pass
+
+            Destroy = Disconnect
+
+        class Cursor:
+
+            def Filter(self, *args):
+                self.pos = 0
+
+            def NextRows(self):
+                calls["NextRows"] += 1
+                fail = mode["fail"]
+                if fail and self.pos:
+                    if fail == "exception":
+                        1 / 0
+                    return {"notseq": 3, "rownotseq": [3], "norowid": [()], "short": [(1, 2)]}[fail]
+                batch = data[self.pos:self.pos + mode["batch"]]
+                self.pos += len(batch)
+                return batch if batch or self.pos % 2 else None
+
+            def Close(self):
+                pass
+
+        self.db.createmodule("nextrows", Source())
+        cur = self.db.cursor()
+        cur.execute("create virtual table t using nextrows()")
+        cols = ",".join("c%d" % c for c in range(ncols))
+        for batch in (1, 7, 64, 5000):
+            mode["batch"] = batch
+            calls["NextRows"] = 0
+            self.assertEqual(data, cur.execute("select rowid, %s from t" % cols).fetchall())
+            self.assertEqual(calls["NextRows"], 1 + (len(data) + batch - 1) // batch)
+        self.assertEqual([(999 * 3, 999)],
+                         cur.execute("select rowid, c1 from t where c1>? and c19 is not null", (998, )).fetchall())
+        self.assertEqual(len(data), cur.execute("select count(*) from t").fetchall()[0][0])
+
+        mode["batch"] = 10
+        for fail, exc in (("exception", ZeroDivisionError), ("notseq", TypeError), ("rownotseq", TypeError),
+                          ("norowid", ValueError), ("short", IndexError)):
+            mode["fail"] = fail
+            self.assertRaises(exc, cur.execute("select %s from t" % cols).fetchall)
+        mode["fail"] = None
+        self.assertEqual(len(data), len(cur.execute("select c5 from t").fetchall()))
+
+    def testDataTable(self):
+        "Verify native data tables"
+        import array
+        c = self.db.cursor()
+        self.assertRaises(TypeError, self.db.create_data_table, "dt")
+        self.assertRaises(TypeError, self.db.create_data_table, "dt", 3)
+        self.assertRaises(ValueError, self.db.create_data_table, "dt", [])
+        self.assertRaises(ValueError, self.db.create_data_table, "dt", [], [])
+        self.assertRaises(ValueError, self.db.create_data_table, "dt", [(1, 2), (1, )])
+        self.assertRaises(ValueError, self.db.create_data_table, "dt", [(1, 2)], ["a"])
+        self.assertRaises(TypeError, self.db.create_data_table, "dt", [(1, 2)], ["a", 3])
+        self.assertRaises(TypeError, self.db.create_data_table, "dt", [1, 2])
+        self.assertRaises(TypeError, self.db.create_data_table, "dt", [(1, object())])
+        self.assertRaises(OverflowError, self.db.create_data_table, "dt", [(1, 2**64)])
+        self.assertRaises(ValueError, self.db.create_data_table, "dt", {"a": [1, 2], "b": [3]})
+        self.assertRaises(ValueError, self.db.create_data_table, "dt", {"a": array.array("d", [1]), "b": [3, 4]})
+        self.assertRaises(ValueError, self.db.create_data_table, "dt", {"a": [1]}, ["a"])
+        self.assertRaises(TypeError, self.db.create_data_table, "dt", {"a": 3})
+        self.assertRaises(TypeError, self.db.create_data_table, "dt", {"a": [{}]})
+        self.assertRaises(ValueError, self.db.create_data_table, "dt", {"a": memoryview(b"abcd").cast("B", [2, 2])})
+        self.assertRaises(ValueError, self.db.create_data_table, "dt", {})
+        self.assertRaises(apsw.SQLError, c.execute, "select * from dt")
+
+        # compare against a real table
+        vals = [None, 0, 1, -1, 2.5, 3.0, 1e20, "a", "b", "", b"x", b"", 2**62, -2**63, 9007199254740993]
+        rng = random.Random(7)
+        rows = [tuple(rng.choice(vals) for _ in range(3)) for _ in range(200)]
+        self.db.create_data_table("dt", rows, ["a", "b", "c c"])
+        c.execute('create table real(rid integer primary key, a, b, "c c")')
+        c.executemany("insert into real values(?,?,?,?)", [(i, ) + r for i, r in enumerate(rows)])
+        for _ in range(500):
+            where, params = [], []
+            for _ in range(rng.randint(0, 3)):
+                where.append("%s %s ?" % (rng.choice(["rowid", "a", "b", '"c c"']), rng.choice(["=", "<", "<=", ">", ">=", "!="])))
+                params.append(rng.choice(vals + [5, 150, 400, 3.5]))
+            tail = ""
+            if rng.random() < .6:
+                # the data table can only apply limit and offset itself when rows come out already ordered
+                order = rng.choice(["rowid", "rowid desc", "%s %s, rowid" % (rng.choice(["a", "b", '"c c"']), rng.choice(["", "desc"]))])
+                tail = " order by %s limit %d offset %d" % (order, rng.randint(-1, 20), rng.randint(0, 5))
+            query = 'select rowid, a, b, "c c" from %s where ' + (" and ".join(where) or "1") + tail
+            self.assertEqual(c.execute(query.replace("rowid", "rid") % "real", params).fetchall(),
+                             c.execute(query % "dt", params).fetchall())
+        self.assertEqual(
+            c.execute("select count(*) from real r join real on r.a = real.b").fetchall(),
+            c.execute("select count(*) from dt join real on dt.a = real.b").fetchall())
+        self.assertRaises(apsw.SQLError, c.execute, "insert into dt values(1,2,3)")
+
+        # columns default, and buffers are used in place
+        self.db.create_data_table("dt", iter([(1, "one"), (2, "two")]))
+        self.assertEqual([(1, "one"), (2, "two")], c.execute("select c0, c1 from dt").fetchall())
+        ints = array.array("i", range(1000))
+        floats = array.array("d", (i / 2 for i in range(1000)))
+        self.db.create_data_table("dt", {"i": ints, "f": floats, "b": bytearray(1000), "s": [str(i) for i in range(1000)]})
+        self.assertEqual([(10, 5.0, 0, "10")], c.execute("select * from dt where i = 10").fetchall())
+        self.assertRaises(BufferError, ints.append, 3)
+        ints[10] = -3
+        self.assertEqual([(-3, 5.0)], c.execute("select i, f from dt where rowid = 10").fetchall())
+        self.assertEqual(sum(floats), c.execute("select sum(f) from dt").fetchall()[0][0])
+
+        # replacing, with the old data released once nothing uses it
+        cur2 = self.db.cursor()
+        cur2.execute("select * from dt")
+        self.db.create_data_table("dt", [(1, )])
+        self.assertEqual([(1, )], c.execute("select * from dt").fetchall())
+        self.assertEqual(1000, len(cur2.fetchall()))
+        self.db.close()
+        ints.append(3)
+
+    def testTableFunction(self):
+        "Verify table valued functions"
+        self.assertRaises(TypeError, self.db.create_table_function, "split", 3, ["part"], [])
+        self.assertRaises(ValueError, self.db.create_table_function, "split", str.split, [], ["text"])
+        self.assertRaises(TypeError, self.db.create_table_function, "split", str.split, ["part", 3], [])
+        self.assertRaises(TypeError, self.db.create_table_function, "split", str.split, ["part"], 3)
+        self.assertRaises(ValueError, self.db.create_table_function, "split", str.split, ["part"],
+                          ["a%d" % i for i in range(31)])
+
+        def split(text, sep=","):
+            return text.split(sep)
+
+        self.db.create_table_function("split", split, ["part"], ["text", "sep"])
+        c = self.db.cursor()
+        self.assertEqual([("a", ), ("b", ), ("c", )], c.execute("select part from split('a,b,c')").fetchall())
+        self.assertEqual([(0, "a", "a;b", ";"), (1, "b", "a;b", ";")],
+                         c.execute("select rowid, *, text, sep from split('a;b', ';')").fetchall())
+        self.assertEqual([("x", ), ("y", )], c.execute("select part from split where text='x,y' and sep=','").fetchall())
+        self.assertEqual([("x y", None)], c.execute("select part, sep from split where text='x y'").fetchall())
+        self.assertRaises(TypeError, c.execute, "select * from split")
+        self.assertRaises(AttributeError, c.execute, "select * from split(3)")
+        c.execute("create table items(id, tags); insert into items values(1, 'a;b'), (2, 'c'), (3, '')")
+        expected = [(1, "a"), (1, "b"), (2, "c"), (3, "")]
+        self.assertEqual(expected, c.execute("select id, part from items, split(items.tags, ';')").fetchall())
+        self.assertEqual(expected, c.execute("select id, part from split(items.tags, ';'), items").fetchall())
+
+        mode = {"fail": None}
+
+        def squares(n):
+            for i in range(n):
+                if i == 500 and mode["fail"]:
+                    if mode["fail"] == "raise":
+                        1 / 0
+                    yield mode["fail"]
+                yield i, i * i
+
+        self.db.create_table_function("squares", squares, ["i", "sq"], ["n"])
+        self.assertEqual([(sum(i * i for i in range(1000)), 1000)], c.execute("select sum(sq), count(*) from squares(1000)").fetchall())
+        self.assertEqual([(0, 0), (1, 1)], c.execute("select * from squares(1000) limit 2").fetchall())
+        for fail, exc in ((3, TypeError), ((1, 2, 3), ValueError), ((1, {}), TypeError), ("raise", ZeroDivisionError)):
+            mode["fail"] = fail
+            self.assertRaises(exc, c.execute("select * from squares(1000)").fetchall)
+        self.db.create_table_function("squares", lambda n: 3, ["i", "sq"], ["n"])
+        self.assertRaises(TypeError, c.execute, "select * from squares(1000)")
+
+    def testWindowFunction(self):
+        "Verify window functions"
+        self.assertRaises(TypeError, self.db.create_window_function, "msum", 12)
+        counts = {"step": 0, "inverse": 0}
+
+        def msum():
+            def step(ctx, x):
+                counts["step"] += 1
+                ctx[0] += x
+
+            def inverse(ctx, x):
+                counts["inverse"] += 1
+                ctx[0] -= x
+
+            def value(ctx):
+                return ctx[0]
+
+            return [0], step, value, value, inverse
+
+        self.db.create_window_function("msum", msum, 1)
+        c = self.db.cursor()
+        c.execute("create table t(x)")
+        c.executemany("insert into t values(?)", [(i, ) for i in range(1000)])
+        self.assertEqual([(sum(range(1000)), )], c.execute("select msum(x) from t").fetchall())
+        counts["step"] = 0
+        frame = "over (order by x rows between 9 preceding and current row)"
+        self.assertEqual(
+            c.execute("select x, sum(x) %s from t" % frame).fetchall(),
+            c.execute("select x, msum(x) %s from t" % frame).fetchall())
+        # each row added and removed once, not once per frame
+        self.assertEqual(1000, counts["step"])
+        self.assertEqual(990, counts["inverse"])
+        self.assertEqual(
+            c.execute("select x, sum(x) over (partition by x % 3 order by x) from t").fetchall(),
+            c.execute("select x, msum(x) over (partition by x % 3 order by x) from t").fetchall())
+
+        for factory, exc in (
+            (lambda: ([0], lambda *args: None, lambda ctx: 0), TypeError),
+            (lambda: ([0], lambda *args: None, lambda ctx: 0, lambda ctx: 0, 3), TypeError),
+            (lambda: ([0], lambda ctx, x: 1 / 0, lambda ctx: 0, lambda ctx: 0, lambda ctx, x: None), ZeroDivisionError),
+            (lambda: ([0], lambda ctx, x: None, lambda ctx: 0, lambda ctx: 1 / 0, lambda ctx, x: None), ZeroDivisionError),
+            (lambda: ([0], lambda ctx, x: None, lambda ctx: 0, lambda ctx: {}, lambda ctx, x: None), TypeError),
+            (lambda: ([0], lambda ctx, x: None, lambda ctx: 0, lambda ctx: 0, lambda ctx, x: 1 / 0), ZeroDivisionError),
+        ):
+            self.db.create_window_function("bad", factory, 1)
+            self.assertRaises(exc, lambda: c.execute("select bad(x) %s from t" % frame).fetchall())
+        self.db.create_window_function("bad", None, 1)
+        self.assertRaises(apsw.SQLError, c.execute, "select bad(x) %s from t" % frame)
+
+    def testBatchFunction(self):
+        "Verify batch functions"
+        self.assertRaises(TypeError, self.db.create_batch_function, "twice", 3)
+        self.assertRaises(ValueError, self.db.create_batch_function, "twice", lambda x: x, 1, 0)
+        calls = []
+
+        def add(xs, ys):
+            calls.append(len(xs))
+            return [None if y is None else x + y for x, y in zip(xs, ys)]
+
+        c = self.db.cursor()
+        c.execute("create table t(p, x, y)")
+        c.executemany("insert into t values(?,?,?)", [(i % 3, i, i * 0.5 if i % 7 else None) for i in range(3000)])
+        frame = " window w as (%s rows between current row and unbounded following)"
+        expected = c.execute("select p, x, x + y from t order by p, x").fetchall()
+        for batch_size in (1, 7, 1000, 5000):
+            self.db.create_batch_function("plus", add, 2, batch_size)
+            del calls[:]
+            self.assertEqual(expected, c.execute("select p, x, plus(x, y) over w from t" + frame % "order by p, x").fetchall())
+            self.assertEqual(3000, sum(calls))
+            self.assertTrue(max(calls) <= batch_size)
+            self.assertEqual(expected, c.execute("select p, x, plus(x, y) over w from t" + frame % "partition by p order by x").fetchall())
+        self.assertEqual([], c.execute("select plus(x, y) over w from t where x<0" + frame % "").fetchall())
+
+        self.db.create_batch_function("double", lambda xs: array.array("d", [x * 2.0 for x in xs]), 1)
+        self.db.create_batch_function("nargs", lambda *args: array.array("q", [len(args)] * len(args[0])))
+        self.assertEqual([(0, 0.0, 3), (1, 2.0, 3)], c.execute("select x, double(x) over w, nargs(1, 2, x) over w from t where x<2" + frame % "").fetchall())
+
+        for sql in ("select plus(x, y) from t",
+                    "select plus(x, y) over () from t",
+                    "select plus(x, y) over (order by x) from t",
+                    "select plus(x, y) over (rows between 1 preceding and current row) from t"):
+            self.assertRaises(ValueError, lambda: c.execute(sql).fetchall())
+        self.db.create_batch_function("plus", lambda xs, ys: xs[1:], 2)
+        self.assertRaises(ValueError, lambda: c.execute("select plus(x, y) over w from t" + frame % "").fetchall())
+        self.db.create_batch_function("plus", lambda xs, ys: 3, 2)
+        self.assertRaises(TypeError, lambda: c.execute("select plus(x, y) over w from t" + frame % "").fetchall())
+        self.db.create_batch_function("plus", lambda xs, ys: 1 / 0, 2)
+        self.assertRaises(ZeroDivisionError, lambda: c.execute("select plus(x, y) over w from t" + frame % "").fetchall())
+        self.db.create_batch_function("plus", lambda xs, ys: [{}] * len(xs), 2)
+        self.assertRaises(TypeError, lambda: c.execute("select plus(x, y) over w from t" + frame % "").fetchall())
+
     def testVTableExample(self):
         "Tests vtable example code"
 
@@ -3711,6 +4701,134 @@ class APSW(unittest.TestCase):
                 for row in cur.execute(query):
                     self.fail("Query is empty")
 
+    def testStatementCacheLarge(self):
+        "Verify statement cache lookups with many entries"
+        self.db = apsw.Connection(TESTFILEPREFIX + "testdb", statementcachesize=5000)
+        cur = self.db.cursor()
+        cur.execute("create table foo(x)")
+        cur.executemany("insert into foo values(?)", [(i, ) for i in range(10)])
+        queries = ["select x+%d from foo order by x" % i for i in range(4000)]
+        for _ in range(3):
+            for i, q in enumerate(queries):
+                self.assertEqual([i + j for j in range(10)], [row[0] for row in self.db.cursor().execute(q)])
+        # same query outstanding in overlapped usage, repeatedly
+        for _ in range(10):
+            l = [self.db.cursor().execute(queries[7]) for i in range(50)]
+            for c in l:
+                self.assertEqual(7, c.fetchall()[0][0])
+        # wrap around evicting everything several times
+        for i in range(12000):
+            self.assertEqual(i, self.db.cursor().execute("select %d" % i).fetchall()[0][0])
+        for i, q in enumerate(queries):
+            self.assertEqual(i, self.db.cursor().execute(q).fetchall()[0][0])
+        cur.execute("drop table foo")
+        self.testStatementCache(5000)
+
+    def testCacheStats(self):
+        "Verify statement cache statistics"
+        db = apsw.Connection(":memory:", statementcachesize=3)
+        self.assertRaises(TypeError, db.cache_stats, "yes")
+        stats = db.cache_stats()
+        self.assertNotIn("entries", stats)
+        self.assertEqual(3, stats["size"])
+        for k in "count", "hits", "misses", "evictions", "too_big", "no_vdbe", "no_cache", "bytes":
+            self.assertEqual(0, stats[k])
+        for _ in range(4):
+            db.cursor().execute("select 1; select 2").fetchall()
+        stats = db.cache_stats(include_entries=True)
+        self.assertEqual(2, stats["count"])
+        self.assertEqual(2, stats["misses"])
+        self.assertEqual(6, stats["hits"])
+        self.assertGreater(stats["bytes"], 0)
+        self.assertEqual([(" select 2", False, 3), ("select 1; select 2", True, 3)],
+                         sorted((e["query"], e["has_more"], e["uses"]) for e in stats["entries"]))
+        for i in range(10):
+            db.cursor().execute("select %d" % (i + 10)).fetchall()
+        stats = db.cache_stats()
+        self.assertEqual(3, stats["count"])
+        self.assertEqual(9, stats["evictions"])
+        db.cursor().execute("-- comment")
+        db.cursor().execute("select '" + "x" * 20000 + "'")
+        stats = db.cache_stats()
+        self.assertEqual(1, stats["no_vdbe"])
+        self.assertEqual(1, stats["too_big"])
+        db.close()
+        self.assertRaises(apsw.ConnectionClosedError, db.cache_stats)
+        db = apsw.Connection(":memory:", statementcachesize=0)
+        db.cursor().execute("select 3")
+        stats = db.cache_stats(True)
+        self.assertEqual(1, stats["no_cache"])
+        self.assertEqual(0, stats["hits"] + stats["misses"] + stats["count"])
+        self.assertEqual([], stats["entries"])
+
+    def testImportCSV(self):
+        "Check Connection.import_csv"
+        db = apsw.Connection(":memory:")
+        c = db.cursor()
+        c.execute("create table foo(x,y,z)")
+        data = '\ufeff1,"a,b",3\r\n"q""uote",,-7.5e3\n\n007,+5,"multi\nline"\r4,5,"unterm""inated'
+        expected = [("1", "a,b", "3"), ('q"uote', "", "-7.5e3"), ("007", "+5", "multi\nline"), ("4", "5", 'unterm"inated')]
+        for source in (io.StringIO(data), io.BytesIO(data.encode("utf8"))):
+            self.assertEqual(4, db.import_csv(source, "foo"))
+            self.assertEqual(expected, c.execute("select * from foo; delete from foo").fetchall())
+        write_whole_file(TESTFILEPREFIX + "testfile", "wt", data, encoding="utf8")
+        self.assertEqual(3, db.import_csv(TESTFILEPREFIX + "testfile", "foo", header=True))
+        self.assertEqual(expected[1:], c.execute("select * from foo; delete from foo").fetchall())
+        # types
+        self.assertEqual(4, db.import_csv(io.StringIO(data), "foo", infer=True))
+        self.assertEqual([(1, "a,b", 3), ('q"uote', None, -7500.0), ("007", "+5", "multi\nline"), (4, 5, 'unterm"inated')],
+                         c.execute("select * from foo; delete from foo").fetchall())
+        self.assertEqual(1, db.import_csv(io.StringIO("-9223372036854775808,9223372036854775808,1e400"), "foo", infer=True))
+        self.assertEqual([(-9223372036854775808, "9223372036854775808", float("inf"))],
+                         c.execute("select * from foo; delete from foo").fetchall())
+        # dialect
+        self.assertEqual(2, db.import_csv(io.StringIO('"a\t"b\tc\n1\t2\t3'), "foo", delimiter="\t", quote=None))
+        self.assertEqual([('"a', '"b', "c"), ("1", "2", "3")], c.execute("select * from foo; delete from foo").fetchall())
+        self.assertEqual(1, db.import_csv(io.StringIO("'a|b'|c|d"), "foo", delimiter="|", quote="'"))
+        self.assertEqual([("a|b", "c", "d")], c.execute("select * from foo; delete from foo").fetchall())
+        for kwargs in ({"delimiter": ""}, {"delimiter": "ab"}, {"delimiter": "\n"}, {"quote": ","}, {"quote": "ab"}, {"commit_rows": -1}):
+            self.assertRaises(ValueError, db.import_csv, io.StringIO(data), "foo", **kwargs)
+        # errors
+        self.assertRaises(apsw.SQLError, db.import_csv, io.StringIO(data), "nosuchtable")
+        self.assertRaises(OSError, db.import_csv, TESTFILEPREFIX + "nosuchfile", "foo")
+        self.assertRaises(TypeError, db.import_csv, 3, "foo")
+        self.assertRaises(TypeError, db.import_csv, io.StringIO(data), "foo", progress=3)
+        self.assertRaises(ValueError, db.import_csv, io.StringIO("1,2,3\n1,2,3\n4,5"), "foo")
+        self.assertEqual(0, c.execute("select count(*) from foo").fetchall()[0][0])
+
+        class reader:
+            def read(self, n):
+                return 3
+
+        self.assertRaises(TypeError, db.import_csv, reader(), "foo")
+        c.execute("create table bar(x primary key, y)")
+        self.assertRaises(apsw.ConstraintError, db.import_csv, io.StringIO("1,2\n1,2"), "bar")
+        # transactions and progress
+        n = 100000
+        text = "".join("%d,%d\n" % (i, i) for i in range(n))
+        seen = []
+        self.assertEqual(n, db.import_csv(io.StringIO(text), "bar", commit_rows=1000, progress=lambda *args: seen.append(args)))
+        self.assertTrue(len(seen) > 1)
+        self.assertEqual((n, len(text)), seen[-1])
+        self.assertTrue(db.getautocommit())
+        c.execute("delete from bar")
+
+        def progress(rows, bytes):
+            1 / 0
+
+        self.assertRaises(ZeroDivisionError, db.import_csv, io.StringIO(text), "bar", progress=progress)
+        self.assertEqual(0, c.execute("select count(*) from bar").fetchall()[0][0])
+        self.assertRaises(apsw.ConstraintError, db.import_csv, io.StringIO(text + "1,1\n"), "bar", commit_rows=30000)
+        self.assertEqual(90000, c.execute("select count(*) from bar").fetchall()[0][0])
+        c.execute("delete from bar")
+        self.assertRaises(apsw.ThreadingViolationError, db.import_csv, io.StringIO(text), "bar", progress=lambda *args: db.cache_stats())
+        # existing transaction is left alone
+        c.execute("begin")
+        self.assertEqual(n, db.import_csv(io.StringIO(text), "bar", commit_rows=7))
+        self.assertFalse(db.getautocommit())
+        c.execute("rollback")
+        self.assertEqual(0, c.execute("select count(*) from bar").fetchall()[0][0])
+
     def testStatementCacheZeroSize(self):
         "Rerun statement cache tests with a zero sized/disabled cache"
         self.db = apsw.Connection(TESTFILEPREFIX + "testdb", statementcachesize=-1)
@@ -3743,7 +4861,7 @@ class APSW(unittest.TestCase):
         'sqlite3api': { # items of interest - sqlite3 calls
                         'match': re.compile(r"(sqlite3_[A-Za-z0-9_]+)\s*\("),
                         # what must also be on same or preceding line
-                        'needs': re.compile("PYSQLITE(_|_BLOB_|_CON_|_CUR_|_SC_|_VOID_|_BACKUP_)CALL"),
+                        'needs': re.compile("PYSQLITE(_|_BLOB_|_CON_|_CUR_|_SC_|_VOID_|_BACKUP_|_SESSION_)CALL"),
 
            # except if match.group(1) matches this - these don't
            # acquire db mutex so no need to wrap (determined by
@@ -3754,7 +4872,10 @@ class APSW(unittest.TestCase):
            # is already held by enclosing sqlite3_step and the
            # methods will only be called from that same thread so it
            # isn't a problem.
-                        'skipcalls': re.compile("^sqlite3_(blob_bytes|column_count|bind_parameter_count|data_count|vfs_.+|changes64|total_changes64|get_autocommit|last_insert_rowid|complete|interrupt|limit|malloc64|free|threadsafe|value_.+|libversion|enable_shared_cache|initialize|shutdown|config|memory_.+|soft_heap_limit(64)?|randomness|db_readonly|db_filename|release_memory|status64|result_.+|user_data|mprintf|aggregate_context|declare_vtab|backup_remaining|backup_pagecount|sourceid|uri_.+)$"),
+                        'skipcalls': re.compile("^sqlite3_(blob_bytes|column_count|bind_parameter_count|data_count|vfs_.+|changes64|total_changes64|get_autocommit|last_insert_rowid|complete|interrupt|limit|malloc64|realloc64|free|threadsafe|value_.+|libversion|enable_shared_cache|initialize|shutdown|config|memory_.+|soft_heap_limit(64)?|randomness|db_readonly|db_filename|release_memory|status64|result_.+|user_data|mprintf|stricmp|str_.+|aggregate_context|declare_vtab|backup_remaining|backup_pagecount|sourceid|uri_.+|mutex_(alloc|free|enter|leave))$"),
+                        # functions only called with the db mutex already held, or
+                        # that run in their own thread without the GIL
+                        'skipfuncs': re.compile("^(rowbatch_(add_row|fill)|bindbatch_run|csvimport_(prepare|bind|run)|datatable_.+|backup_page_size|APSWBackup_worker|statementcache_bytes|changes_sethook)$"),
                         # error message
                         'desc': "sqlite3_ calls must wrap with PYSQLITE_CALL",
                         },
@@ -3774,6 +4895,8 @@ class APSW(unittest.TestCase):
             for k, v in self.calls.items():
                 if v.get('skipfiles', None) and v['skipfiles'].match(filename):
                     continue
+                if v.get('skipfuncs', None) and v['skipfuncs'].match(name):
+                    continue
                 mo = v['match'].search(line)
                 if mo:
                     func = mo.group(1)
@@ -3785,14 +4908,15 @@ class APSW(unittest.TestCase):
 
     def sourceCheckFunction(self, filename, name, lines):
         # not further checked
-        if name.split("_")[0] in ("ZeroBlobBind", "APSWVFS", "APSWVFSFile", "APSWBuffer", "FunctionCBInfo",
-                                  "apswurifilename"):
+        if name.split("_")[0] in ("ZeroBlobBind", "APSWVFS", "APSWVFSFile", "APSWVFSShim", "APSWVFSCompressed", "APSWVFSArchive", "APSWBuffer",
+                                  "FunctionCBInfo", "apswurifilename"):
             return
 
         checks = {
             "APSWCursor": {
-                "skip": ("dealloc", "init", "dobinding", "dobindings", "doexectrace", "dorowtrace", "step", "close",
-                         "close_internal", "tp_traverse"),
+                "skip": ("dealloc", "init", "dobinding", "dobindings", "doexectrace", "dorowtrace", "step", "dostep",
+                         "fillbatch", "fetchrows", "runbindbatch", "holdstatic", "write_names",
+                         "bindbatch_add_row", "executemany_batched", "close", "close_internal", "tp_traverse"),
                 "req": {
                     "use": "CHECK_USE",
                     "closed": "CHECK_CURSOR_CLOSED",
@@ -3818,13 +4942,21 @@ class APSW(unittest.TestCase):
                 "order": ("use", "closed")
             },
             "APSWBackup": {
-                "skip": ("dealloc", "init", "close_internal", "get_remaining", "get_pagecount"),
+                "skip": ("dealloc", "init", "close_internal", "get_remaining", "get_pagecount", "wait_worker", "worker", "start"),
                 "req": {
                     "use": "CHECK_USE",
                     "closed": "CHECK_BACKUP_CLOSED"
                 },
                 "order": ("use", "closed")
             },
+            "APSWSession": {
+                "skip": ("dealloc", "init", "close", "close_internal", "output", "exit"),
+                "req": {
+                    "use": "CHECK_USE",
+                    "closed": "CHECK_SESSION_CLOSED"
+                },
+                "order": ("use", "closed")
+            },
             "apswvfs": {
                 "req": {
                     "preamble": "VFSPREAMBLE",
@@ -3852,6 +4984,13 @@ class APSW(unittest.TestCase):
                 },
                 "order": ("preamble", "postamble")
             },
+            "apswvfsfilepy_xReadInto": {
+                "req": {
+                    "check": "CHECKVFSFILEPY",
+                    "notimpl": "VFSFILENOTIMPLEMENTED(xRead,"
+                },
+                "order": ("check", "notimpl"),
+            },
             "apswvfsfilepy": {
                 "skip": ("xClose", ),
                 "req": {
@@ -4434,6 +5573,568 @@ class APSW(unittest.TestCase):
                           flags=apsw.SQLITE_OPEN_READWRITE | apsw.SQLITE_OPEN_CREATE | apsw.SQLITE_OPEN_URI,
                           vfs="uritest")
 
+    def testVFSShim(self):
+        "Verify native VFS shims"
+        self.assertRaises(TypeError, apsw.VFSShim)
+        self.assertRaises(TypeError, apsw.VFSShim, "shim", 3)
+        self.assertRaises(ValueError, apsw.VFSShim, "shim", "klgfkljdfsljgklfjdsglkdfs")
+        self.assertRaises(ValueError, apsw.VFSShim, "shim", readahead=-1)
+        self.assertTrue("shim" not in apsw.vfsnames())
+
+        counting = apsw.VFSShim("shimcounting")
+        fast = apsw.VFSShim("shimfast", "shimcounting", readahead=65536, cache_pages=100, coalesce=65536)
+        self.assertTrue("shimcounting" in apsw.vfsnames() and "shimfast" in apsw.vfsnames())
+
+        # python vfs stacked on top, only overriding xRead
+        reads = []
+
+        class File(apsw.VFSFile):
+
+            def xRead(self, amount, offset):
+                reads.append(amount)
+                return super().xRead(amount, offset)
+
+        class VFS(apsw.VFS):
+
+            def __init__(self):
+                super().__init__("shimpy", "shimfast")
+
+            def xOpen(self, name, flags):
+                return File("shimfast", name, flags)
+
+        pyvfs = VFS()
+
+        for journal_mode in ("delete", "wal"):
+            self.deltempfiles()
+            dbs = [apsw.Connection(TESTFILEPREFIX + "testdb", vfs=vfs) for vfs in ("shimfast", "shimpy", "shimfast")]
+            dbs[0].cursor().execute("pragma journal_mode=" + journal_mode)
+            dbs[0].cursor().execute("create table foo(x primary key, y)")
+            expected = {}
+            for i in range(300):
+                db = dbs[i % len(dbs)]
+                with db:
+                    db.cursor().execute("insert or replace into foo values(?,?)", (i % 97, "a" * i))
+                expected[i % 97] = "a" * i
+                if i % 7 == 0:
+                    for db in dbs:
+                        self.assertEqual(expected, dict(db.cursor().execute("select * from foo")))
+            # changes made outside of the shims are seen
+            plain = apsw.Connection(TESTFILEPREFIX + "testdb")
+            self.assertEqual(expected, dict(plain.cursor().execute("select * from foo")))
+            plain.cursor().execute("update foo set y='plain'")
+            for db in dbs:
+                self.assertEqual(set(["plain"]), set(y for (y, ) in db.cursor().execute("select y from foo")))
+                self.assertEqual([("ok", )], db.cursor().execute("pragma integrity_check").fetchall())
+            for db in dbs + [plain]:
+                db.close()
+
+        self.assertTrue(reads)
+        stats = fast.stats()
+        for k in ("reads", "writes", "syncs", "read_bytes", "write_bytes", "read_time", "write_time", "sync_time",
+                  "read_max", "write_max", "sync_max", "opens", "cache_hits", "cache_misses", "readahead_hits",
+                  "base_reads", "base_writes"):
+            self.assertTrue(stats[k] > 0, k)
+        self.assertTrue(stats["base_writes"] < stats["writes"])
+        self.assertEqual(stats["base_reads"], counting.stats()["reads"])
+        self.assertEqual(stats["base_writes"], counting.stats()["writes"])
+        self.assertEqual(counting.stats()["cache_hits"], 0)
+
+        fast.reset_stats()
+        self.assertTrue(all(v == 0 for v in fast.stats().values()))
+
+        # methods changed on the class after opening are used
+        db = apsw.Connection(TESTFILEPREFIX + "testdb", vfs="shimpy")
+        writes = []
+
+        def xWrite(self, data, offset):
+            writes.append(len(data))
+            return super(File, self).xWrite(data, offset)
+
+        File.xWrite = xWrite
+        db.cursor().execute("insert into foo values(1000, 1000)")
+        self.assertTrue(writes)
+        db.close()
+
+        # open databases keep working after the shim is gone
+        db = apsw.Connection(TESTFILEPREFIX + "testdb", vfs="shimfast")
+        pyvfs.unregister()
+        fast.unregister()
+        fast.unregister()
+        self.assertTrue("shimfast" not in apsw.vfsnames())
+        del fast
+        gc.collect()
+        self.assertEqual(98, db.cursor().execute("select count(*) from foo").fetchall()[0][0])
+        db.close()
+        counting.unregister()
+
+    def testVFSShimWriteBehind(self):
+        "Verify VFSShim write behind and combined syncs"
+        self.assertRaises(ValueError, apsw.VFSShim, "shimwb", write_behind=-1)
+        self.assertRaises(ValueError, apsw.VFSShim, "shimwb", write_behind=1000, sync_delay=-1)
+        self.assertRaises(ValueError, apsw.VFSShim, "shimwb", sync_delay=0.1)
+        self.assertTrue("shimwb" not in apsw.vfsnames())
+        # nothing to wait for
+        apsw.VFSShim("shimwb").flush()
+
+        for sync_delay in (0, 0.05):
+            shim = apsw.VFSShim("shimwb", write_behind=65536, sync_delay=sync_delay)
+            for journal_mode in ("wal", "delete", "persist"):
+                self.deltempfiles()
+                db = apsw.Connection(TESTFILEPREFIX + "testdb", vfs="shimwb")
+                db.cursor().execute("pragma journal_mode=" + journal_mode).fetchall()
+                db.cursor().execute("create table foo(x, y, z)")
+
+                def worker(n):
+                    con = apsw.Connection(TESTFILEPREFIX + "testdb", vfs="shimwb")
+                    con.setbusytimeout(30000)
+                    con.cursor().execute("pragma synchronous=full")
+                    for i in range(40):
+                        con.cursor().execute("begin immediate")
+                        count = con.cursor().execute("select count(*) from foo").fetchall()[0][0]
+                        con.cursor().execute("insert into foo values(?,?,?)", (n, "a" * (i * 97), count))
+                        con.cursor().execute("commit")
+                    con.close()
+
+                threads = [ThreadRunner(worker, n) for n in range(4)]
+                for t in threads:
+                    t.start()
+                for t in threads:
+                    t.go()
+                # each transaction saw all the ones before
+                plain = apsw.Connection(TESTFILEPREFIX + "testdb")
+                self.assertEqual(list(range(160)), [z for (z, ) in plain.cursor().execute("select z from foo order by z")])
+                self.assertEqual([("ok", )], plain.cursor().execute("pragma integrity_check").fetchall())
+                plain.close()
+                db.close()
+
+            shim.flush()
+            stats = shim.stats()
+            for k in ("queued_writes", "queue_max", "sync_requests", "sync_batches", "sync_batch_max", "sync_latency"):
+                self.assertTrue(stats[k] > 0, k)
+            self.assertEqual(stats["base_writes"], stats["queued_writes"])
+            self.assertTrue(stats["sync_batches"] <= stats["sync_requests"])
+            self.assertEqual(stats["background_errors"], 0)
+            shim.unregister()
+
+        # syncs of the same wal file within the delay are combined
+        self.deltempfiles()
+        shim = apsw.VFSShim("shimwb", write_behind=65536, sync_delay=10)
+        db = apsw.Connection(TESTFILEPREFIX + "testdb", vfs="shimwb")
+        db.cursor().execute("pragma journal_mode=wal").fetchall()
+        db.cursor().execute("pragma synchronous=full; create table foo(x)")
+        shim.flush()
+        shim.reset_stats()
+        for i in range(20):
+            db.cursor().execute("insert into foo values(?)", (i, ))
+        stats = shim.stats()
+        self.assertEqual(stats["sync_requests"], 20)
+        self.assertEqual(stats["sync_batches"], 0)
+        shim.flush()
+        stats = shim.stats()
+        self.assertEqual(stats["sync_batches"], 1)
+        self.assertEqual(stats["sync_batch_max"], 20)
+        db.close()
+        shim.unregister()
+
+        # errors from the background are returned
+        class VFS(apsw.VFS):
+
+            def __init__(self):
+                super().__init__("wbbase", "")
+
+            def xOpen(self, name, flags):
+                return File("", name, flags)
+
+        class File(apsw.VFSFile):
+
+            def xWrite(self, data, offset):
+                if fail:
+                    raise apsw.IOError()
+                return super().xWrite(data, offset)
+
+        fail = False
+        self.deltempfiles()
+        vfs = VFS()
+        shim = apsw.VFSShim("shimwb", "wbbase", write_behind=65536)
+        db = apsw.Connection(TESTFILEPREFIX + "testdb", vfs="shimwb")
+        db.cursor().execute("create table foo(x)")
+        fail = True
+        self.assertRaises(apsw.IOError, self.assertRaisesUnraisable, apsw.IOError, db.cursor().execute,
+                          "insert into foo values(randomblob(10000))")
+        fail = False
+        self.assertTrue(shim.stats()["background_errors"] > 0)
+        db.close()
+        shim.unregister()
+        vfs.unregister()
+
+    def testVFSCompressed(self):
+        "Verify the compressed VFS"
+        self.assertRaises(TypeError, apsw.VFSCompressed)
+        self.assertRaises(ValueError, apsw.VFSCompressed, "comp", "klgfkljdfsljgklfjdsglkdfs")
+        self.assertRaises(ValueError, apsw.VFSCompressed, "comp", chunk_size=1000)
+        self.assertRaises(ValueError, apsw.VFSCompressed, "comp", chunk_size=256)
+        self.assertRaises(ValueError, apsw.VFSCompressed, "comp", cache_chunks=0)
+        self.assertRaises(TypeError, apsw.VFSCompressed, "comp", compress=3)
+        self.assertTrue("comp" not in apsw.vfsnames())
+
+        import zlib
+        calls = {"compress": 0, "decompress": 0}
+
+        def compress(data):
+            calls["compress"] += 1
+            if fail == "compress":
+                1 / 0
+            return zlib.compress(data)
+
+        def decompress(data):
+            calls["decompress"] += 1
+            if fail == "decompress":
+                1 / 0
+            return zlib.decompress(data)
+
+        fail = None
+        comp = apsw.VFSCompressed("comp", compress=compress, decompress=decompress, cache_chunks=4)
+        self.assertTrue("comp" in apsw.vfsnames())
+
+        # python vfs on top
+        class VFS(apsw.VFS):
+
+            def __init__(self):
+                super().__init__("comppy", "comp")
+
+        pyvfs = VFS()
+
+        self.deltempfiles()
+        plain = apsw.Connection(TESTFILEPREFIX + "testdb2")
+        dbs = [apsw.Connection(TESTFILEPREFIX + "testdb", vfs=vfs) for vfs in ("comp", "comppy", "comp")]
+        for db in dbs + [plain]:
+            db.cursor().execute("pragma cache_size=10")
+        dbs[2].cursor().execute("pragma synchronous=off")
+        for db in (dbs[0], plain):
+            db.cursor().execute("create table foo(x primary key, y)")
+        for i in range(300):
+            for db in (dbs[i % len(dbs)], plain):
+                with db:
+                    db.cursor().execute("insert or replace into foo values(?,?)", (i % 97, "abc" * i))
+                    if i % 50 == 0:
+                        db.cursor().execute("delete from foo where x % 3 = 0")
+            if i % 7 == 0:
+                expected = plain.cursor().execute("select * from foo order by x").fetchall()
+                for db in dbs:
+                    self.assertEqual(expected, db.cursor().execute("select * from foo order by x").fetchall())
+        for db in dbs:
+            self.assertEqual([("ok", )], db.cursor().execute("pragma integrity_check").fetchall())
+        self.assertTrue(calls["compress"] and calls["decompress"])
+
+        # it is smaller, and shrinks
+        dbs[0].cursor().execute("vacuum")
+        plain.cursor().execute("vacuum")
+        size = os.path.getsize(TESTFILEPREFIX + "testdb")
+        self.assertTrue(size < os.path.getsize(TESTFILEPREFIX + "testdb2") / 2)
+        dbs[0].cursor().execute("delete from foo; vacuum").fetchall()
+        self.assertTrue(os.path.getsize(TESTFILEPREFIX + "testdb") < size)
+        for db in dbs:
+            self.assertEqual(0, db.cursor().execute("select count(*) from foo").fetchall()[0][0])
+            db.close()
+
+        # the format is as documented
+        with open(TESTFILEPREFIX + "testdb", "rb") as f:
+            header = f.read(1024)
+        self.assertTrue(b"APSW compressed\0" in (header[:16], header[512:528]))
+        self.assertEqual(header.count(b"APSW compressed\0"), 2)
+
+        # databases that aren't compressed are opened as normal
+        db = apsw.Connection(TESTFILEPREFIX + "testdb2", vfs="comp")
+        db.cursor().execute("insert into foo values(1000, 1000)")
+        self.assertEqual(plain.cursor().execute("select * from foo").fetchall(),
+                         db.cursor().execute("select * from foo").fetchall())
+        db.close()
+        plain.close()
+        with open(TESTFILEPREFIX + "testdb2", "rb") as f:
+            self.assertEqual(f.read(16), b"SQLite format 3\0")
+
+        # errors
+        db = apsw.Connection(TESTFILEPREFIX + "testdb", vfs="comp")
+        db.cursor().execute("create table bar(x)")
+        fail = "compress"
+        self.assertRaises(apsw.IOError, self.assertRaisesUnraisable, ZeroDivisionError, db.cursor().execute,
+                          "insert into bar values(randomblob(10000))")
+        fail = None
+        db.cursor().execute("insert into bar values(randomblob(10000))")
+        db.close()
+        db = apsw.Connection(TESTFILEPREFIX + "testdb", vfs="comp")
+        fail = "decompress"
+        self.assertRaises(apsw.IOError, self.assertRaisesUnraisable, ZeroDivisionError, db.cursor().execute,
+                          "select * from bar")
+        fail = None
+        self.assertEqual(1, db.cursor().execute("select count(*) from bar").fetchall()[0][0])
+
+        # open databases keep working after the vfs is gone
+        pyvfs.unregister()
+        comp.unregister()
+        comp.unregister()
+        self.assertTrue("comp" not in apsw.vfsnames())
+        del comp
+        gc.collect()
+        self.assertEqual(1, db.cursor().execute("select count(*) from bar").fetchall()[0][0])
+        db.close()
+
+    def testVFSArchive(self):
+        "Verify the archive VFS"
+        import zipfile
+        self.deltempfiles()
+        for n, count in (("testdb", 3000), ("testdb2", 50)):
+            db = apsw.Connection(TESTFILEPREFIX + n)
+            db.cursor().execute("create table foo(x, y); create index fooy on foo(y)")
+            with db:
+                for i in range(count):
+                    db.cursor().execute("insert into foo values(?,?)", (i, "abc" * (i % 100)))
+            db.close()
+        archive = TESTFILEPREFIX + "testdb3"
+        with zipfile.ZipFile(archive, "w", zipfile.ZIP_STORED) as zf:
+            zf.write(TESTFILEPREFIX + "testdb", "one.db")
+            zf.write(TESTFILEPREFIX + "testdb2", "dir/two.db")
+
+        self.assertRaises(TypeError, apsw.VFSArchive, "arch")
+        self.assertRaises(ValueError, apsw.VFSArchive, "arch", archive, "klgfkljdfsljgklfjdsglkdfs")
+        self.assertRaises(ValueError, apsw.VFSArchive, "arch", archive, prefetch_threads=0)
+        self.assertRaises(apsw.CantOpenError, apsw.VFSArchive, "arch", TESTFILEPREFIX + "testdb-nonexistent")
+        self.assertRaises(TypeError, apsw.VFSArchive, "arch", archive, prefetch=3)
+        self.assertRaises(TypeError, apsw.VFSArchive, "arch", archive, prefetch=[("one.db", "a", 3)])
+        self.assertTrue("arch" not in apsw.vfsnames())
+
+        arch = apsw.VFSArchive("arch", archive)
+        self.assertTrue("arch" in apsw.vfsnames())
+        self.assertEqual(arch.hints(), [])
+        arch.prefetch_wait()
+
+        # python vfs on top
+        class VFS(apsw.VFS):
+
+            def __init__(self):
+                super().__init__("archpy", "arch")
+
+        pyvfs = VFS()
+
+        plain = apsw.Connection(TESTFILEPREFIX + "testdb")
+        expected = plain.cursor().execute("select * from foo where y>'abcabc' order by y").fetchall()
+        for vfs in ("arch", "archpy"):
+            db = apsw.Connection("one.db", vfs=vfs, flags=apsw.SQLITE_OPEN_READONLY)
+            self.assertEqual(expected, db.cursor().execute("select * from foo where y>'abcabc' order by y").fetchall())
+            self.assertEqual([("ok", )], db.cursor().execute("pragma integrity_check").fetchall())
+            db.close()
+        db = apsw.Connection("dir/two.db", vfs="arch")
+        self.assertEqual(50, db.cursor().execute("select count(*) from foo").fetchall()[0][0])
+        self.assertRaises(apsw.ReadOnlyError, db.cursor().execute, "insert into foo values(1,2)")
+        # temporary files come from the base
+        db.cursor().execute("create temp table bar(x); insert into bar values(3)")
+        self.assertRaises(apsw.CantOpenError, apsw.Connection, "three.db", vfs="arch")
+
+        hints = arch.hints()
+        self.assertEqual({"one.db", "dir/two.db"}, set(h[0] for h in hints))
+        self.assertEqual(os.path.getsize(TESTFILEPREFIX + "testdb"), sum(h[2] for h in hints if h[0] == "one.db"))
+        pyvfs.unregister()
+        arch.unregister()
+        arch.unregister()
+        self.assertTrue("arch" not in apsw.vfsnames())
+        del arch
+        gc.collect()
+        # open databases keep working after the vfs is gone
+        self.assertEqual(50, db.cursor().execute("select count(*) from foo").fetchall()[0][0])
+        db.close()
+
+        # prefetch, ignoring what doesn't apply
+        arch = apsw.VFSArchive("arch",
+                               archive,
+                               prefetch=hints + [["zzz", 0, 10], ("one.db", 1 << 40, 10), ("one.db", 0, 1 << 40)],
+                               prefetch_threads=3)
+        arch.prefetch_wait()
+        db = apsw.Connection("one.db", vfs="arch")
+        self.assertEqual(expected, db.cursor().execute("select * from foo where y>'abcabc' order by y").fetchall())
+        db.close()
+        del arch
+        # collected while prefetching
+        arch = apsw.VFSArchive("arch", archive, prefetch=hints * 20)
+        del arch
+
+        # files that aren't zip are one database
+        arch = apsw.VFSArchive("arch", TESTFILEPREFIX + "testdb2")
+        db = apsw.Connection(os.path.basename(TESTFILEPREFIX + "testdb2"), vfs="arch")
+        self.assertEqual(50, db.cursor().execute("select count(*) from foo").fetchall()[0][0])
+        db.close()
+        del arch
+
+        # compressed members can't be used
+        with zipfile.ZipFile(archive, "w", zipfile.ZIP_DEFLATED) as zf:
+            zf.write(TESTFILEPREFIX + "testdb2", "two.db")
+        self.assertRaises(ValueError, apsw.VFSArchive, "arch", archive)
+        plain.close()
+
+    def testVFSReadInto(self):
+        "Verify VFSFile.xReadInto"
+        calls = []
+
+        class File(apsw.VFSFile):
+
+            def xReadInto(self, buffer, offset):
+                calls.append(len(buffer))
+                if mode == "badtype":
+                    return "three"
+                if mode == "badcount":
+                    return len(buffer) + 1
+                n = super().xReadInto(buffer, offset)
+                vfs.held = buffer
+                return n
+
+            def xRead(self, amount, offset):
+                1 / 0
+
+        class VFS(apsw.VFS):
+
+            def __init__(self):
+                super().__init__("readinto", "")
+
+            def xOpen(self, name, flags):
+                return File("", name, flags)
+
+        vfs = VFS()
+        mode = "ok"
+        db = apsw.Connection(TESTFILEPREFIX + "testdb", vfs="readinto")
+        db.cursor().execute("create table foo(x); insert into foo values(randomblob(20000))")
+        db.close()
+        calls = []
+        db = apsw.Connection(TESTFILEPREFIX + "testdb", vfs="readinto")
+        self.assertEqual(20000, db.cursor().execute("select length(x) from foo").fetchall()[0][0])
+        self.assertTrue(calls)
+        # the memoryview over SQLite's memory is released on return
+        self.assertRaises(ValueError, len, vfs.held)
+        db.close()
+        for m in ("badtype", "badcount"):
+            db = apsw.Connection(TESTFILEPREFIX + "testdb", vfs="readinto")
+            mode = m
+            self.assertRaises(apsw.SQLError, self.assertRaisesUnraisable, ValueError if mode == "badcount" else TypeError,
+                              db.cursor().execute, "select * from foo")
+            mode = "ok"
+            db.close()
+
+        # direct calls
+        mode = "ok"
+        t = apsw.VFSFile("", os.path.abspath(TESTFILEPREFIX + "testdb"), [apsw.SQLITE_OPEN_MAIN_DB | apsw.SQLITE_OPEN_READONLY, 0])
+        self.assertRaises(BufferError, t.xReadInto, b"immutable", 0)
+        self.assertRaises(TypeError, t.xReadInto, bytearray(10), "0")
+        b = bytearray(100)
+        self.assertEqual(100, t.xReadInto(b, 0))
+        self.assertEqual(b[:16], b"SQLite format 3\0")
+        b = bytearray(100)
+        self.assertEqual(0, t.xReadInto(b, t.xFileSize() + 1000))
+        self.assertEqual(b, bytearray(100))
+        t.xClose()
+        self.assertRaises(apsw.VFSFileClosedError, t.xReadInto, b, 0)
+
+    def testVFSFetch(self):
+        "Verify VFSFile.xFetch and xUnfetch"
+        import mmap
+        calls = []
+
+        class ReadFile(apsw.VFSFile):
+
+            def xRead(self, amount, offset):
+                calls.append("xRead")
+                return super().xRead(amount, offset)
+
+        class MapFile(apsw.VFSFile):
+
+            def __init__(self, vfs, name, flags):
+                super().__init__(vfs, name, flags)
+                self.name = name.filename()
+
+            def xFetch(self, offset, amount):
+                calls.append("xFetch")
+                if mode == "badtype":
+                    return 3
+                if mode == "short":
+                    return b"x" * (amount - 1)
+                with open(self.name, "rb") as f:
+                    if offset + amount > os.fstat(f.fileno()).st_size:
+                        return None
+                    m = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+                return memoryview(m)[offset:offset + amount]
+
+            def xUnfetch(self, offset, buffer):
+                calls.append("xUnfetch")
+                if buffer is not None:
+                    assert isinstance(buffer, memoryview)
+
+        class VFS(apsw.VFS):
+
+            def __init__(self):
+                super().__init__("fetchvfs", "")
+
+            def xOpen(self, name, flags):
+                if not isinstance(name, apsw.URIFilename):
+                    return apsw.VFSFile("", name, flags)
+                return filecls("", name, flags)
+
+        vfs = VFS()
+        mode = "ok"
+
+        def check(mmap_size=10000000):
+            # returns how many pages had to be read into the cache
+            db = apsw.Connection(TESTFILEPREFIX + "testdb", vfs="fetchvfs")
+            db.cursor().execute("pragma mmap_size=%d" % mmap_size)
+            calls[:] = []
+            self.assertEqual(expected, db.cursor().execute("select * from foo order by x").fetchall())
+            misses = db.status(apsw.SQLITE_DBSTATUS_CACHE_MISS)[0]
+            db.close()
+            return misses
+
+        filecls = apsw.VFSFile
+        # asking the default vfs so a file missing xFetch isn't mistaken for this
+        db = apsw.Connection(TESTFILEPREFIX + "testdb")
+        if db.cursor().execute("pragma mmap_size=10000000").fetchall()[0][0] == 0:
+            return  # mmap not compiled in
+        db.close()
+        db = apsw.Connection(TESTFILEPREFIX + "testdb", vfs="fetchvfs")
+        db.cursor().execute("create table foo(x,y); insert into foo values(1, randomblob(20000))")
+        for i in range(100):
+            db.cursor().execute("insert into foo values(?,?)", (i + 2, "a" * i))
+        expected = db.cursor().execute("select * from foo order by x").fetchall()
+        db.close()
+
+        # all inherited goes directly to the base file's mapping, so
+        # pages don't have to be read into the cache
+        self.assertLess(check(), check(0))
+        self.assertEqual(calls, [])
+
+        # overriding xRead means the base file's mapping can't be used
+        filecls = ReadFile
+        check()
+        self.assertIn("xRead", calls)
+
+        # our own mapping
+        filecls = MapFile
+        check()
+        self.assertIn("xFetch", calls)
+        self.assertEqual(calls.count("xFetch"), calls.count("xUnfetch"))
+
+        for mode, exc in (("badtype", TypeError), ("short", ValueError)):
+            db = apsw.Connection(TESTFILEPREFIX + "testdb", vfs="fetchvfs")
+            db.cursor().execute("pragma mmap_size=10000000")
+            self.assertRaises(apsw.SQLError, self.assertRaisesUnraisable, exc, db.cursor().execute, "select * from foo")
+            db.close()
+        mode = "ok"
+
+        # direct calls
+        t = apsw.VFSFile("", os.path.abspath(TESTFILEPREFIX + "testdb"), [apsw.SQLITE_OPEN_MAIN_DB | apsw.SQLITE_OPEN_READONLY, 0])
+        self.assertRaises(TypeError, t.xFetch, "0", 10)
+        self.assertRaises(TypeError, t.xUnfetch, 0, 3)
+        # nothing is mapped until the mmap size file control
+        self.assertIsNone(t.xFetch(0, 4096))
+        t.xUnfetch(0, None)
+        t.xClose()
+        self.assertRaises(apsw.VFSFileClosedError, t.xFetch, 0, 10)
+        self.assertRaises(apsw.VFSFileClosedError, t.xUnfetch, 0, None)
+
     def testVFSWithWAL(self):
         "Verify VFS using WAL"
         apsw.connection_hooks.append(
@@ -5934,6 +7635,105 @@ class APSW(unittest.TestCase):
         self.assertRaises(apsw.BusyError, b.__exit__, None, None, None)
         b.__exit__(None, None, None)
 
+    def testBackupAsync(self):
+        "Verify background backup"
+        c = self.db.cursor()
+        c.execute("create table foo(x); insert into foo with recursive r(x) as "
+                  "(select 1 union all select x+1 from r where x<5000) select randomblob(500) from r")
+        pagesize, pagecount = c.execute("pragma page_size").fetchall()[0][0], c.execute("pragma page_count").fetchall()[0][0]
+        db2 = apsw.Connection(":memory:")
+        self.assertRaises(TypeError, db2.backup_async, "main", self.db, "main", progress=3)
+        self.assertRaises(ValueError, db2.backup_async, "main", self.db, "main", pages_per_step=0)
+        self.assertRaises(ValueError, db2.backup_async, "main", self.db, "main", max_bytes_per_sec=-1)
+        self.assertRaises(apsw.SQLError, db2.backup_async, "main", self.db, "nosuchdb")
+
+        progress = []
+        # rate limited to take about a quarter of a second
+        b = db2.backup_async("main",
+                             self.db,
+                             "main",
+                             pages_per_step=pagecount // 10,
+                             max_bytes_per_sec=pagecount * pagesize * 4,
+                             progress=lambda *args: progress.append(args))
+        start = time.time()
+        # the source can be used while copying, the destination can't
+        self.assertEqual(5000, c.execute("select count(*) from foo").fetchall()[0][0])
+        self.assertRaises(apsw.ThreadingViolationError, db2.cursor)
+        self.assertRaises(apsw.ThreadingViolationError, b.step)
+        self.assertRaises(ValueError, b.wait, -1)
+        self.assertTrue(b.wait(30))
+        self.assertGreater(time.time() - start, 0.15)
+        self.assertTrue(b.done)
+        self.assertEqual((0, pagecount), progress[-1])
+        self.assertTrue(all(r1 > r2 for (r1, _), (r2, _) in zip(progress, progress[1:])))
+        b.finish()
+        self.assertEqual(5000, db2.cursor().execute("select count(*) from foo").fetchall()[0][0])
+
+        # exception in progress stops the copy
+        db2 = apsw.Connection(":memory:")
+
+        def progress(remaining, pagecount):
+            1 / 0
+
+        b = db2.backup_async("main", self.db, "main", pages_per_step=1, progress=progress)
+        self.assertRaises(ZeroDivisionError, b.wait)
+        self.assertRaises(ZeroDivisionError, b.wait)
+        self.assertFalse(b.done)
+        self.assertRaises(ZeroDivisionError, b.finish)
+        self.assertRaises(apsw.SQLError, db2.cursor().execute, "select * from foo")
+
+        def f():
+            b = db2.backup_async("main", self.db, "main", progress=progress)
+            time.sleep(0.1)
+            b.close()
+            del b
+            gc.collect()
+
+        self.assertRaises(ZeroDivisionError, f)
+
+        # finishing early stops
+        b = db2.backup_async("main", self.db, "main", pages_per_step=1, max_bytes_per_sec=pagesize * 10)
+        self.assertFalse(b.wait(0.05))
+        b.finish()
+        self.assertFalse(b.done)
+        self.assertRaises(apsw.SQLError, db2.cursor().execute, "select * from foo")
+        # without waiting out a long throttle delay
+        b = db2.backup_async("main", self.db, "main", pages_per_step=64, max_bytes_per_sec=pagesize * 2)
+        self.assertFalse(b.wait(0.1))
+        start = time.time()
+        b.finish()
+        self.assertLess(time.time() - start, 2)
+
+        # waits while the source is locked
+        db3 = apsw.Connection(TESTFILEPREFIX + "testdb2")
+        db3.cursor().execute("create table foo(x); insert into foo values(1)")
+        db4 = apsw.Connection(TESTFILEPREFIX + "testdb2")
+        db4.cursor().execute("begin exclusive; insert into foo values(2)")
+        b = db2.backup_async("main", db3, "main")
+        self.assertFalse(b.wait(0.2))
+        db4.cursor().execute("commit")
+        self.assertTrue(b.wait(30))
+        b.finish()
+        self.assertEqual([(1, ), (2, )], db2.cursor().execute("select * from foo").fetchall())
+
+        # keeps going when no longer referenced
+        db2 = apsw.Connection(":memory:")
+        db2.backup_async("main", self.db, "main")
+        for i in range(300):
+            try:
+                self.assertEqual(5000, db2.cursor().execute("select count(*) from foo").fetchall()[0][0])
+                break
+            except (apsw.ThreadingViolationError, apsw.SQLError):
+                time.sleep(0.01)
+        else:
+            self.fail("Background backup did not complete")
+
+        # closing the source stops it
+        b = db2.backup_async("main", self.db, "main", pages_per_step=1, max_bytes_per_sec=pagesize * 10)
+        self.db.close()
+        self.assertRaises(apsw.ConnectionClosedError, b.wait)
+        b.finish()
+
     def testLog(self):
         "Verifies logging functions"
         self.assertRaises(TypeError, apsw.log)
@@ -6907,6 +8707,31 @@ insert into xxblah values(3);
         s.cmdloop()
         isempty(fh[1])
         isempty(fh[2])
+        # parallel dump gives identical output
+        for c in (".dump --jobs=0", ".dump --jobs=x", ".dump --fast"):
+            reset()
+            cmd(c)
+            s.cmdloop()
+            isempty(fh[1])
+            isnotempty(fh[2])
+        s2 = shellclass(args=[TESTFILEPREFIX + "testdb2"], **kwargs)
+        reset()
+        cmd(v + "\ncreate table big(x,y); insert into big with recursive r(x) as (select 1 union all select x+1 from r where x<20000) "
+            "select x, randomblob(x%100) from r;\n"
+            "pragma journal_mode=wal;")
+        s2.cmdloop()
+        isempty(fh[2])
+        dumps = []
+        for c in (".dump", ".dump --jobs=3", ".dump --jobs=50 % big"):
+            reset()
+            cmd(c)
+            s2.cmdloop()
+            isempty(fh[2])
+            dumps.append(re.sub("-- (Date|Tables like):.*", "", get(fh[1])))
+        self.assertIn("INSERT INTO big VALUES(20000,", dumps[0])
+        self.assertEqual(dumps[0], dumps[1])
+        self.assertEqual(dumps[0], dumps[2])
+        s2.db.close()
 
         ###
         ### Command - echo
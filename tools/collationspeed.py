@@ -0,0 +1,100 @@
+#!/usr/bin/env python3
+#
+# See the accompanying LICENSE file.
+#
+# Compares the speed of sorting with the native collations against
+# Python equivalents registered with createcollation and
+# create_key_collation.
+
+import sys
+import re
+import time
+import random
+import optparse
+import unicodedata
+
+import apsw
+
+
+def python_natural(s):
+    return [int(p) if i % 2 else p for i, p in enumerate(re.split("([0-9]+)", s))]
+
+
+def python_casefold(s):
+    return s.casefold()
+
+
+def python_noaccent(s):
+    return "".join(c for c in unicodedata.normalize("NFD", s.casefold()) if not unicodedata.combining(c))
+
+
+def cmp_collation(key):
+
+    def collation(one, two):
+        one, two = key(one), key(two)
+        return -1 if one < two else (1 if one > two else 0)
+
+    return collation
+
+
+def bytes_key(key):
+    return lambda s: key(s).encode("utf8")
+
+
+def makewords(count, unicode_percent):
+    random.seed(0)
+    letters = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ"
+    accented = "àáâäçèéêëìíîïñòóôöùúûüÀÉÎÕÜßæø"
+    words = []
+    for _ in range(count):
+        word = []
+        for _ in range(random.randrange(4, 30)):
+            if random.random() < unicode_percent / 100:
+                word.append(random.choice(accented))
+            elif random.random() < 0.1:
+                word.append(str(random.randrange(1000)))
+            else:
+                word.append(random.choice(letters))
+        words.append("".join(word))
+    return words
+
+
+def run(con, words, name):
+    cursor = con.cursor()
+    cursor.execute("drop table if exists words; create table words(word)")
+    cursor.executemany("insert into words values(?)", ((w, ) for w in words))
+    start = time.perf_counter()
+    for _ in cursor.execute('select word from words order by word collate "%s"' % name):
+        pass
+    return time.perf_counter() - start
+
+
+def main(options):
+    words = makewords(options.rows, options.unicode)
+    con = apsw.Connection(":memory:")
+
+    print("%10s %12s %12s %12s" % ("", "native", "key", "callback"))
+    for name, key in (("natural", python_natural), ("casefold", python_casefold), ("noaccent", python_noaccent)):
+        con.create_native_collation("native_" + name, name)
+        if name != "natural":
+            # natural keys are lists so can't be made into bytes
+            con.create_key_collation("key_" + name, bytes_key(key))
+        con.createcollation("callback_" + name, cmp_collation(key))
+
+        native = run(con, words, "native_" + name)
+        keyed = run(con, words, "key_" + name) if name != "natural" else None
+        callback = run(con, words, "callback_" + name)
+        print("%10s %11.3fs %12s %11.3fs" % (name, native, ("%11.3fs" % keyed) if keyed else "-", callback))
+
+
+if __name__ == '__main__':
+    parser = optparse.OptionParser()
+    parser.add_option("--rows", type="int", default=100000, help="How many rows to sort [Default %default]")
+    parser.add_option("--unicode",
+                      type="int",
+                      default=5,
+                      help="Percentage of characters that are accented letters [Default %default]")
+    options, args = parser.parse_args()
+    if args:
+        parser.error("Unexpected arguments " + str(args))
+    main(options)
@@ -5,7 +5,7 @@
 # Find things that haven't been documented and should be or have been
 # but don't exist.
 
-import glob, sys
+import glob, sys, os, tempfile
 
 import apsw
 
@@ -36,15 +36,21 @@ cur = con.cursor()
 cur.execute("create table x(y); insert into x values(x'abcdef1012');select * from x")
 blob = con.blobopen("main", "x", "y", con.last_insert_rowid(), 0)
 vfs = apsw.VFS("aname", "")
-vfsfile = apsw.VFSFile("", ":memory:",
+# the file is opened directly by the vfs so :memory: would be a real
+# file with that name
+tmpdir = tempfile.TemporaryDirectory()
+vfsfile = apsw.VFSFile("", os.path.join(tmpdir.name, "vfsfile"),
                        [apsw.SQLITE_OPEN_MAIN_DB | apsw.SQLITE_OPEN_CREATE | apsw.SQLITE_OPEN_READWRITE, 0])
+vfsshim = apsw.VFSShim("ashim")
+vfscompressed = apsw.VFSCompressed("acompressed")
+vfsarchive = apsw.VFSArchive("anarchive", __file__)
 
 # virtual tables aren't real - just check their size hasn't changed
 assert len(classes['VTModule']) == 2
 del classes['VTModule']
 assert len(classes['VTTable']) == 13
 del classes['VTTable']
-assert len(classes['VTCursor']) == 6
+assert len(classes['VTCursor']) == 7
 del classes['VTCursor']
 
 for name, obj in (
@@ -53,6 +59,9 @@ for name, obj in (
     ('Blob', blob),
     ('VFS', vfs),
     ('VFSFile', vfsfile),
+    ('VFSShim', vfsshim),
+    ('VFSCompressed', vfscompressed),
+    ('VFSArchive', vfsarchive),
     ('apsw', apsw),
 ):
     if name not in classes:
@@ -81,7 +90,7 @@ for name, obj in (
             if isinstance(getattr(apsw, c), type) and issubclass(getattr(apsw, c), Exception):
                 continue
             # ignore classes !!!
-            if c in ("Connection", "VFS", "VFSFile", "zeroblob", "Shell", "URIFilename", "Cursor", "Blob", "Backup"):
+            if c in ("Connection", "VFS", "VFSFile", "VFSShim", "VFSCompressed", "VFSArchive", "zeroblob", "Shell", "URIFilename", "Cursor", "Blob", "Backup"):
                 continue
             # ignore mappings !!!
             if c.startswith("mapping_"):
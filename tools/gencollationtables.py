@@ -0,0 +1,78 @@
+#!/usr/bin/env python3
+#
+# See the accompanying LICENSE file.
+#
+# Generates the Unicode tables used by the native collations in
+# src/collations.c from the unicodedata module.  Run it again with a
+# newer Python to pick up a newer Unicode version.
+
+import sys
+import unicodedata
+
+
+def casefold(c):
+    return c.casefold()
+
+
+def noaccent(c):
+    # decompose and drop the combining marks, which removes accents
+    # and also removes combining characters that are on their own.
+    # Characters without marks such as Hangul syllables are left as is
+    f = c.casefold()
+    d = unicodedata.normalize("NFD", f)
+    s = "".join(ch for ch in d if not unicodedata.combining(ch))
+    if s == d:
+        return f
+    return unicodedata.normalize("NFC", s).casefold()
+
+
+def generate(out):
+    entries = []
+    mappings = []
+    offsets = {}
+
+    def offset(s):
+        if s not in offsets:
+            offsets[s] = len(mappings)
+            mappings.extend(ord(ch) for ch in s)
+        return offsets[s]
+
+    maxlen = 0
+    for cp in range(0x80, sys.maxunicode + 1):
+        if 0xd800 <= cp <= 0xdfff:
+            continue
+        c = chr(cp)
+        f, n = casefold(c), noaccent(c)
+        if f == c and n == c:
+            continue
+        maxlen = max(maxlen, len(f), len(n))
+        entries.append((cp, offset(f), len(f), offset(n), len(n)))
+
+    assert len(mappings) < 65536
+
+    print("/* Generated by tools/gencollationtables.py from Unicode %s - do not edit */" % unicodedata.unidata_version,
+          file=out)
+    print(file=out)
+    print("/* most code points a code point maps to */", file=out)
+    print("#define APSW_COLLATION_MAXMAPPING %d" % maxlen, file=out)
+    print(file=out)
+    print("static const unsigned int collation_mappings[] = {", file=out)
+    for i in range(0, len(mappings), 8):
+        print("    " + ", ".join("0x%x" % m for m in mappings[i:i + 8]) + ",", file=out)
+    print("};", file=out)
+    print(file=out)
+    print("/* code points above 0x7f that casefold or noaccent change, in order */", file=out)
+    print("static const struct", file=out)
+    print("{", file=out)
+    print("  unsigned int codepoint;", file=out)
+    print("  unsigned short casefold, noaccent; /* offset in collation_mappings */", file=out)
+    print("  unsigned char casefoldlen, noaccentlen;", file=out)
+    print("} collation_entries[] = {", file=out)
+    for cp, foff, flen, noff, nlen in entries:
+        print("    {0x%x, %d, %d, %d, %d}," % (cp, foff, noff, flen, nlen), file=out)
+    print("};", file=out)
+
+
+if __name__ == '__main__':
+    with open(sys.argv[1] if len(sys.argv) > 1 else "src/collationtables.h", "wt") as f:
+        generate(f)
@@ -23,6 +23,7 @@ import io
 import textwrap
 import glob
 import re
+import ast
 
 from typing import Union, List
 
@@ -180,6 +181,8 @@ def analyze_signature(s: str) -> List[dict]:
     name = ""
     after_name = ""
     skip_to_next = False
+    # string defaults can contain commas
+    quote = None
 
     def add_param():
         nonlocal name, after_name
@@ -196,6 +199,15 @@ def analyze_signature(s: str) -> List[dict]:
 
     for pos in range(1, len(s) - 1):
         c = s[pos]
+        if quote:
+            after_name += c
+            if c == quote:
+                quote = None
+            continue
+        if skip_to_next and c in "'\"":
+            after_name += c
+            quote = c
+            continue
         if c in nest_start or nesting:
             after_name += c
             if c in nest_start:
@@ -282,12 +294,22 @@ type_overrides = {
     "Blob.reopen": {
         "rowid": "int64"
     },
+    "Connection.apply_changeset": {
+        "changeset": "PyObject",
+        "conflict": "Optional[Callable]"
+    },
     "Connection.blobopen": {
         "rowid": "int64"
     },
+    "Connection.backup_async": {
+        "max_bytes_per_sec": "int64"
+    },
     "Connection.filecontrol": {
         "pointer": "pointer"
     },
+    "Connection.set_changes_hook": {
+        "callable": "Optional[Callable]"
+    },
     "Connection.set_last_insert_rowid": {
         "rowid": "int64"
     },
@@ -298,6 +320,10 @@ type_overrides = {
         "statements": "strtype",
         "sequenceofbindings": "Sequence"
     },
+    "Cursor.executemany_columns": {
+        "statements": "strtype",
+        "columns": "Sequence"
+    },
     "URIFilename.uri_int": {
         "default": "int64",
     },
@@ -311,6 +337,17 @@ type_overrides = {
     "VFSFile.xRead": {
         "offset": "int64"
     },
+    "VFSFile.xFetch": {
+        "offset": "int64"
+    },
+    "VFSFile.xUnfetch": {
+        "offset": "int64",
+        "buffer": "PyObject"
+    },
+    "VFSFile.xReadInto": {
+        "buffer": "PyObject",
+        "offset": "int64"
+    },
     "VFSFile.xTruncate": {
         "newsize": "int64"
     },
@@ -332,6 +369,13 @@ type_overrides = {
 }
 
 
+def c_string(default: str) -> str:
+    "Python string literal default as a C string literal"
+    val = ast.literal_eval(default)
+    assert isinstance(val, str) and val.isascii()
+    return '"' + "".join(c if c.isprintable() and c not in '"\\' else f"\\x{ ord(c):02x}" for c in val) + '"'
+
+
 def callable_erasure(f):
     if "Callable" not in f:
         return f
@@ -371,8 +415,7 @@ def do_argparse(item):
                 if param["default"] == "None":
                     default_check = f"{ pname } == 0"
                 else:
-                    breakpoint()
-                    pass
+                    default_check = f"0 == strcmp({ pname }, { c_string(param['default']) })"
         elif param["type"] == "Optional[str]":
             type = "const char *"
             kind = "z"
@@ -380,8 +423,7 @@ def do_argparse(item):
                 if param["default"] == "None":
                     default_check = f"{ pname } == 0"
                 else:
-                    breakpoint()
-                    pass
+                    default_check = f"0 == strcmp({ pname }, { c_string(param['default']) })"
         elif param["type"] == "bool":
             type = "int"
             kind = "O&"
@@ -399,6 +441,11 @@ def do_argparse(item):
                 except ValueError:
                     val = param['default'].replace("apsw.", "")
                 default_check = f"{ pname } == ({ val })"
+        elif param["type"] == "float":
+            type = "double"
+            kind = "d"
+            if param["default"]:
+                default_check = f"{ pname } == { float(param['default']) }"
         elif param["type"] == "int64":
             type = "long long"
             kind = "L"
@@ -417,6 +464,15 @@ def do_argparse(item):
             if param["default"]:
                 breakpoint()
                 pass
+        elif param["type"] == "Optional[float]":
+            type = "PyObject *"
+            kind = "O"
+            if param["default"]:
+                if param["default"] == "None":
+                    default_check = f"{ pname } == Py_None"
+                else:
+                    breakpoint()
+                pass
         elif param["type"] == "bytes":
             type = "Py_buffer"
             kind = "y*"
@@ -428,8 +484,11 @@ def do_argparse(item):
             kind = "O&"
             args = ["argcheck_Optional_Callable"] + args
             if param["default"]:
-                breakpoint()
-                pass
+                if param["default"] == "None":
+                    default_check = f"{ pname } == NULL"
+                else:
+                    breakpoint()
+                    pass
         elif param["type"] == "Optional[Union[str,URIFilename]]":
             type = "PyObject *"
             kind = "O&"
@@ -454,7 +513,7 @@ def do_argparse(item):
             if param["default"]:
                 breakpoint()
                 pass
-        elif param["type"] == "Sequence":
+        elif param["type"] == "Sequence" or param["type"].startswith("Sequence["):
             # note that we can't check for sequence because anything
             # that PySequence_Fast accepts is ok which includes sets,
             # iterators, generators etc and I can't test for all of
@@ -464,6 +523,16 @@ def do_argparse(item):
             if param["default"]:
                 breakpoint()
                 pass
+        elif param["type"].startswith(("Optional[Iterable[", "Optional[Sequence[")):
+            # like Sequence the contents are checked when iterated
+            type = "PyObject *"
+            kind = "O"
+            if param["default"]:
+                if param["default"] == "None":
+                    default_check = f"{ pname } == NULL"
+                else:
+                    breakpoint()
+                pass
         elif param["type"] == "Connection":
             type = "Connection *"
             kind = "O!"
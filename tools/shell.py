@@ -839,20 +839,28 @@ Enter SQL statements terminated with a ";"
             return True
 
         cur.setexectrace(et)
+        # insert mode output can be done natively which is a lot quicker
+        # for dumping large tables
+        native = self.output == self.output_insert and not summary and self.colour is self._colours["off"]
+
         # processing loop
         try:
-            for row in cur.execute(sql, bindings):
-                if state['newsql']:
-                    # summary line?
-                    if summary:
-                        self._output_summary(summary[0])
-                    # output a header always
-                    cols = [h for h, d in cur.getdescription()]
-                    self.output(True, cols)
-                    state['newsql'] = False
-                self.output(False, row)
-            if not state['newsql'] and summary:
-                self._output_summary(summary[1])
+            if native:
+                cur.execute(sql, bindings)
+                cur.write_to(self._write_adaptor(), format="sql", table=self._output_table)
+            else:
+                for row in cur.execute(sql, bindings):
+                    if state['newsql']:
+                        # summary line?
+                        if summary:
+                            self._output_summary(summary[0])
+                        # output a header always
+                        cols = [h for h, d in cur.getdescription()]
+                        self.output(True, cols)
+                        state['newsql'] = False
+                    self.output(False, row)
+                if not state['newsql'] and summary:
+                    self._output_summary(summary[1])
         except:
             # If echo is on and the sql to execute is a syntax error
             # then the exec tracer won't have seen it so it won't be
@@ -971,7 +979,7 @@ Enter SQL statements terminated with a ";"
             self.pop_output()
 
     def command_dump(self, cmd):
-        """dump ?TABLE? [TABLE...]: Dumps all or specified tables in SQL text format
+        """dump ?OPTIONS? ?TABLES?: Dumps all or specified tables in SQL text format
 
         The table name is treated as like pattern so you can use % as
         a wildcard.  You can use dump to make a text based backup of
@@ -993,9 +1001,26 @@ Enter SQL statements terminated with a ";"
 
         If the database is empty or no tables/views match then there
         is no output.
+
+        Options are: --jobs=N which reads the contents of up to N
+        tables at the same time, each using a separate read only
+        connection.  The output is identical to a regular dump.  This
+        only applies to databases in files.
         """
         # Simple tables are easy to dump.  More complicated is dealing
         # with virtual tables, foreign keys etc.
+        jobs = 1
+        while cmd and cmd[0].startswith("--"):
+            p = cmd.pop(0)
+            if p.startswith("--jobs="):
+                try:
+                    jobs = int(p[len("--jobs="):])
+                except ValueError:
+                    jobs = 0
+                if jobs < 1:
+                    raise self.Error("--jobs needs a positive number not " + p[len("--jobs="):])
+                continue
+            raise self.Error("Unknown dump param: " + p)
 
         # Lock the database while doing the dump so nothing changes
         # under our feet
@@ -1134,7 +1159,10 @@ Enter SQL statements terminated with a ";"
 
             # do the table dumping loops
             oldtable = self._output_table
+            pending = {}
             try:
+                if jobs > 1 and self.db.filename and self.colour is self._colours["off"]:
+                    pending = self._dump_table_data(jobs, tables)
                 self.push_output()
                 self.output = self.output_insert
                 # Dump the table
@@ -1158,8 +1186,11 @@ Enter SQL statements terminated with a ";"
                         else:
                             self.write(self.stdout, "DROP TABLE IF EXISTS " + self._fmt_sql_identifier(table) + ";\n")
                             self.write(self.stdout, sqldef(sql[0]))
-                            self._output_table = self._fmt_sql_identifier(table)
-                            self.process_sql("select * from " + self._fmt_sql_identifier(table), internal=True)
+                            if table in pending:
+                                self._dump_copy(pending.pop(table).result())
+                            else:
+                                self._output_table = self._fmt_sql_identifier(table)
+                                self.process_sql("select * from " + self._fmt_sql_identifier(table), internal=True)
                         # Now any indices or triggers
                         first = True
                         for name, sql in self.db.cursor().execute(
@@ -1210,6 +1241,10 @@ Enter SQL statements terminated with a ";"
                     if not first:
                         blank()
             finally:
+                for future in pending.values():
+                    future.cancel()
+                    if not future.cancelled() and not future.exception():
+                        future.result().close()
                 self.pop_output()
                 self._output_table = oldtable
 
@@ -1251,6 +1286,61 @@ Enter SQL statements terminated with a ";"
         finally:
             self.process_sql("END", internal=True)
 
+    def _dump_table_data(self, jobs, tables):
+        """Starts getting the rows of each of the regular tables as SQL
+        inserts using up to jobs threads.  Returns a dict of table name
+        to a future whose result is a file positioned at the start of
+        the SQL.
+
+        Each thread uses its own read only connection.  Our connection
+        holds the write lock for the duration of the dump so all the
+        connections see the same database contents."""
+        import concurrent.futures
+        import tempfile
+
+        filename, vfs = self.db.filename, self.db.open_vfs
+
+        def dump(table):
+            ident = self._fmt_sql_identifier(table)
+            out = tempfile.TemporaryFile()
+            db = apsw.Connection(filename, flags=apsw.SQLITE_OPEN_READONLY, vfs=vfs)
+            try:
+                db.cursor().execute("select * from " + ident).write_to(out, format="sql", table=ident)
+            except:
+                out.close()
+                raise
+            finally:
+                db.close()
+            out.seek(0)
+            return out
+
+        regular = []
+        for table in tables:
+            for sql, in self.db.cursor().execute("SELECT sql FROM sqlite_master WHERE name=?1 AND type='table'",
+                                                 (table, )):
+                if sql.lower().split()[:3] != ["create", "virtual", "table"]:
+                    regular.append(table)
+
+        pending = {}
+        executor = concurrent.futures.ThreadPoolExecutor(max_workers=jobs)
+        try:
+            for table in regular:
+                pending[table] = executor.submit(dump, table)
+        finally:
+            # already submitted work still runs
+            executor.shutdown(wait=False)
+        return pending
+
+    def _dump_copy(self, f):
+        "Copies the SQL from a file made by :meth:`_dump_table_data` to the output and closes it"
+        decoder = codecs.getincrementaldecoder("utf8")("replace")
+        try:
+            for chunk in iter(lambda: f.read(256 * 1024), b""):
+                self.write(self.stdout, decoder.decode(chunk))
+            self.write(self.stdout, decoder.decode(b"", True))
+        finally:
+            f.close()
+
     def command_echo(self, cmd):
         """echo ON|OFF: If ON then each SQL statement or command is printed before execution (default OFF)
 
@@ -1563,48 +1653,23 @@ Enter SQL statements terminated with a ";"
         if len(cmd) != 2:
             raise self.Error("import takes two parameters")
 
+        # UTF-8 is read directly, while other encodings are decoded
+        # by Python first
+        if codecs.lookup(self.encoding[0]).name == "utf-8":
+            source = cmd[0]
+        else:
+            source = codecs.open(cmd[0], "r", self.encoding[0])
         try:
-            final = None
-            # start transaction so database can't be changed
-            # underneath us
-            self.db.cursor().execute("BEGIN IMMEDIATE")
-            final = "ROLLBACK"
-
-            # how many columns?
-            ncols = len(self.db.cursor().execute("pragma table_info(" + self._fmt_sql_identifier(cmd[1]) +
-                                                 ")").fetchall())
-            if ncols < 1:
-                raise self.Error("No such table '%s'" % (cmd[1], ))
-
-            cur = self.db.cursor()
-            sql = "insert into %s values(%s)" % (self._fmt_sql_identifier(cmd[1]), ",".join("?" * ncols))
-
-            kwargs = {}
-            if self.separator == ",":
-                kwargs["dialect"] = "excel"
-            elif self.separator == "\t":
-                kwargs["dialect"] = "excel-tab"
-            else:
-                kwargs["quoting"] = csv.QUOTE_NONE
-                kwargs["delimiter"] = self.separator
-                kwargs["doublequote"] = False
-                kwargs["quotechar"] = "\x00"
-            row = 1
-            for line in self._csvin_wrapper(cmd[0], kwargs):
-                if len(line) != ncols:
-                    raise self.Error("row %d has %d columns but should have %d" % (row, len(line), ncols))
-                try:
-                    cur.execute(sql, line)
-                except:
-                    self.write(self.stderr, "Error inserting row %d" % (row, ))
-                    raise
-                row += 1
-            self.db.cursor().execute("COMMIT")
-
-        except:
-            if final:
-                self.db.cursor().execute(final)
-            raise
+            # the import is done in one transaction so the database
+            # can't be changed underneath us, and is rolled back on
+            # error
+            self.db.import_csv(source,
+                               cmd[1],
+                               delimiter=self.separator,
+                               quote='"' if self.separator in (",", "\t") else None)
+        finally:
+            if source is not cmd[0]:
+                source.close()
 
     def _csvin_wrapper(self, filename, dialect):
         # Returns a csv reader that works around python bugs and uses
@@ -2427,6 +2492,18 @@ Enter SQL statements terminated with a ";"
         "Writes text to dest.  dest will typically be one of self.stdout or self.stderr."
         dest.write(text)
 
+    def _write_adaptor(self):
+        "Returns an object whose write method sends text to :meth:`write` for stdout"
+
+        class adaptor:
+
+            def write(_, text):
+                if not isinstance(text, str):
+                    raise TypeError("text is needed")
+                self.write(self.stdout, text)
+
+        return adaptor()
+
     _raw_input = input
 
     def getline(self, prompt=""):
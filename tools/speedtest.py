@@ -44,8 +44,14 @@ def doit():
         print("        SQLite lib version ", apsw.sqlitelibversion())
         print("    SQLite headers version ", apsw.SQLITE_VERSION_NUMBER, end="\n\n")
 
+        if options.vfs == "compressed" and "compressed" not in apsw.vfsnames():
+            # unregistered when garbage collected
+            compressed = apsw.VFSCompressed("compressed")
+        if options.vfs:
+            print("                  APSW vfs ", options.vfs, end="\n\n")
+
         def apsw_setup(dbfile):
-            con = apsw.Connection(dbfile, statementcachesize=options.scsize)
+            con = apsw.Connection(dbfile, statementcachesize=options.scsize, vfs=options.vfs)
             con.createscalarfunction("number_name", number_name, 1)
             return con
 
@@ -435,6 +441,10 @@ parser.add_option(
     "How many statements to execute.  Each unit takes about 2 seconds per test on memory only databases. [Default %default]"
 )
 parser.add_option("--database", dest="database", default=":memory:", help="The database file to use [Default %default]")
+parser.add_option("--vfs",
+                  dest="vfs",
+                  default=None,
+                  help="Name of the vfs APSW uses.  compressed uses VFSCompressed [Default the default vfs]")
 parser.add_option("--tests",
                   dest="tests",
                   default="bigstmt,statements,statements_nobindings",